@@ -181,6 +181,8 @@ use constant CFGOPT_ARCHIVE_TIMEOUT                                 => 'archive-
     push @EXPORT, qw(CFGOPT_ARCHIVE_TIMEOUT);
 use constant CFGOPT_BUFFER_SIZE                                     => 'buffer-size';
     push @EXPORT, qw(CFGOPT_BUFFER_SIZE);
+use constant CFGOPT_CIPHER_THREAD                                   => 'cipher-thread';
+    push @EXPORT, qw(CFGOPT_CIPHER_THREAD);
 use constant CFGOPT_DB_TIMEOUT                                      => 'db-timeout';
     push @EXPORT, qw(CFGOPT_DB_TIMEOUT);
 use constant CFGOPT_COMPRESS                                        => 'compress';
@@ -189,8 +191,16 @@ use constant CFGOPT_COMPRESS_LEVEL                                  => 'compress
     push @EXPORT, qw(CFGOPT_COMPRESS_LEVEL);
 use constant CFGOPT_COMPRESS_LEVEL_NETWORK                          => 'compress-level-network';
     push @EXPORT, qw(CFGOPT_COMPRESS_LEVEL_NETWORK);
+use constant CFGOPT_COMPRESS_THREAD                                 => 'compress-thread';
+    push @EXPORT, qw(CFGOPT_COMPRESS_THREAD);
+use constant CFGOPT_COMPRESS_TYPE                                   => 'compress-type';
+    push @EXPORT, qw(CFGOPT_COMPRESS_TYPE);
+use constant CFGOPT_FILTER_THREAD                                   => 'filter-thread';
+    push @EXPORT, qw(CFGOPT_FILTER_THREAD);
 use constant CFGOPT_NEUTRAL_UMASK                                   => 'neutral-umask';
     push @EXPORT, qw(CFGOPT_NEUTRAL_UMASK);
+use constant CFGOPT_PROTOCOL_PIPELINE                               => 'protocol-pipeline';
+    push @EXPORT, qw(CFGOPT_PROTOCOL_PIPELINE);
 use constant CFGOPT_PROTOCOL_TIMEOUT                                => 'protocol-timeout';
     push @EXPORT, qw(CFGOPT_PROTOCOL_TIMEOUT);
 use constant CFGOPT_PROCESS_MAX                                     => 'process-max';
@@ -283,6 +293,8 @@ use constant CFGOPT_REPO_S3_CA_FILE                                 => CFGDEF_RE
     push @EXPORT, qw(CFGOPT_REPO_S3_CA_FILE);
 use constant CFGOPT_REPO_S3_CA_PATH                                 => CFGDEF_REPO_S3 . '-ca-path';
     push @EXPORT, qw(CFGOPT_REPO_S3_CA_PATH);
+use constant CFGOPT_REPO_S3_DOWNLOAD_MAX                            => CFGDEF_REPO_S3 . '-download-max';
+    push @EXPORT, qw(CFGOPT_REPO_S3_DOWNLOAD_MAX);
 use constant CFGOPT_REPO_S3_ENDPOINT                                => CFGDEF_REPO_S3 . '-endpoint';
     push @EXPORT, qw(CFGOPT_REPO_S3_ENDPOINT);
 use constant CFGOPT_REPO_S3_HOST                                    => CFGDEF_REPO_S3 . '-host';
@@ -293,6 +305,8 @@ use constant CFGOPT_REPO_S3_REGION                                  => CFGDEF_RE
     push @EXPORT, qw(CFGOPT_REPO_S3_REGION);
 use constant CFGOPT_REPO_S3_TOKEN                                   => CFGDEF_REPO_S3 . '-token';
     push @EXPORT, qw(CFGOPT_REPO_S3_TOKEN);
+use constant CFGOPT_REPO_S3_UPLOAD_MAX                              => CFGDEF_REPO_S3 . '-upload-max';
+    push @EXPORT, qw(CFGOPT_REPO_S3_UPLOAD_MAX);
 use constant CFGOPT_REPO_S3_VERIFY_TLS                              => CFGDEF_REPO_S3 . '-verify-tls';
     push @EXPORT, qw(CFGOPT_REPO_S3_VERIFY_TLS);
 
@@ -302,8 +316,12 @@ use constant CFGOPT_ARCHIVE_ASYNC                                   => 'archive-
     push @EXPORT, qw(CFGOPT_ARCHIVE_ASYNC);
 use constant CFGOPT_ARCHIVE_GET_QUEUE_MAX                           => 'archive-get-queue-max';
     push @EXPORT, qw(CFGOPT_ARCHIVE_GET_QUEUE_MAX);
+use constant CFGOPT_ARCHIVE_GET_STREAM                              => 'archive-get-stream';
+    push @EXPORT, qw(CFGOPT_ARCHIVE_GET_STREAM);
 use constant CFGOPT_ARCHIVE_PUSH_QUEUE_MAX                          => 'archive-push-queue-max';
     push @EXPORT, qw(CFGOPT_ARCHIVE_PUSH_QUEUE_MAX);
+use constant CFGOPT_ARCHIVE_PUSH_STREAM                             => 'archive-push-stream';
+    push @EXPORT, qw(CFGOPT_ARCHIVE_PUSH_STREAM);
 
 # Backup options
 #-----------------------------------------------------------------------------------------------------------------------------------
@@ -319,6 +337,8 @@ use constant CFGOPT_EXCLUDE                                         => 'exclude'
     push @EXPORT, qw(CFGOPT_EXCLUDE);
 use constant CFGOPT_MANIFEST_SAVE_THRESHOLD                         => 'manifest-save-threshold';
     push @EXPORT, qw(CFGOPT_MANIFEST_SAVE_THRESHOLD);
+use constant CFGOPT_PAGE_DELTA                                      => 'page-delta';
+    push @EXPORT, qw(CFGOPT_PAGE_DELTA);
 use constant CFGOPT_RESUME                                          => 'resume';
     push @EXPORT, qw(CFGOPT_RESUME);
 use constant CFGOPT_START_FAST                                      => 'start-fast';
@@ -388,6 +408,15 @@ use constant CFGOPTVAL_REMOTE_TYPE_DB                               => CFGOPTVAL
 use constant CFGOPTVAL_REMOTE_TYPE_BACKUP                           => CFGOPTVAL_LOCAL_TYPE_BACKUP;
     push @EXPORT, qw(CFGOPTVAL_REMOTE_TYPE_BACKUP);
 
+# Compress type
+#-----------------------------------------------------------------------------------------------------------------------------------
+use constant CFGOPTVAL_COMPRESS_TYPE_GZ                             => 'gz';
+    push @EXPORT, qw(CFGOPTVAL_COMPRESS_TYPE_GZ);
+use constant CFGOPTVAL_COMPRESS_TYPE_LZ4                            => 'lz4';
+    push @EXPORT, qw(CFGOPTVAL_COMPRESS_TYPE_LZ4);
+use constant CFGOPTVAL_COMPRESS_TYPE_ZST                            => 'zst';
+    push @EXPORT, qw(CFGOPTVAL_COMPRESS_TYPE_ZST);
+
 # Backup type
 #-----------------------------------------------------------------------------------------------------------------------------------
 use constant CFGOPTVAL_BACKUP_TYPE_FULL                             => 'full';
@@ -412,6 +441,8 @@ use constant CFGOPTVAL_REPO_CIPHER_TYPE_NONE                        => 'none';
     push @EXPORT, qw(CFGOPTVAL_REPO_CIPHER_TYPE_NONE);
 use constant CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_CBC                 => 'aes-256-cbc';
     push @EXPORT, qw(CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_CBC);
+use constant CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_GCM                 => 'aes-256-gcm';
+    push @EXPORT, qw(CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_GCM);
 
 # Info output
 #-----------------------------------------------------------------------------------------------------------------------------------
@@ -1148,7 +1179,9 @@ my %hConfigDefine =
         &CFGDEF_COMMAND =>
         {
             &CFGCMD_ARCHIVE_GET => {},
+            &CFGCMD_ARCHIVE_GET_ASYNC => {},
             &CFGCMD_ARCHIVE_PUSH => {},
+            &CFGCMD_ARCHIVE_PUSH_ASYNC => {},
             &CFGCMD_BACKUP => {},
             &CFGCMD_CHECK => {},
         },
@@ -1228,6 +1261,20 @@ my %hConfigDefine =
         },
     },
 
+    &CFGOPT_CIPHER_THREAD =>
+    {
+        &CFGDEF_SECTION => CFGDEF_SECTION_GLOBAL,
+        &CFGDEF_TYPE => CFGDEF_TYPE_INTEGER,
+        &CFGDEF_DEFAULT => 1,
+        &CFGDEF_ALLOW_RANGE => [1, 64],
+        &CFGDEF_COMMAND =>
+        {
+            &CFGCMD_BACKUP => {},
+            &CFGCMD_LOCAL => {},
+            &CFGCMD_RESTORE => {},
+        }
+    },
+
     &CFGOPT_COMPRESS =>
     {
         &CFGDEF_SECTION => CFGDEF_SECTION_GLOBAL,
@@ -1249,7 +1296,7 @@ my %hConfigDefine =
         &CFGDEF_SECTION => CFGDEF_SECTION_GLOBAL,
         &CFGDEF_TYPE => CFGDEF_TYPE_INTEGER,
         &CFGDEF_DEFAULT => 6,
-        &CFGDEF_ALLOW_RANGE => [CFGDEF_DEFAULT_COMPRESS_LEVEL_MIN, CFGDEF_DEFAULT_COMPRESS_LEVEL_MAX],
+        &CFGDEF_ALLOW_RANGE => [-5, 22],
         &CFGDEF_COMMAND =>
         {
             &CFGCMD_ARCHIVE_GET => {},
@@ -1293,6 +1340,38 @@ my %hConfigDefine =
         }
     },
 
+    &CFGOPT_COMPRESS_THREAD =>
+    {
+        &CFGDEF_SECTION => CFGDEF_SECTION_GLOBAL,
+        &CFGDEF_TYPE => CFGDEF_TYPE_INTEGER,
+        &CFGDEF_DEFAULT => 1,
+        &CFGDEF_ALLOW_RANGE => [1, 64],
+        &CFGDEF_COMMAND =>
+        {
+            &CFGCMD_BACKUP => {},
+            &CFGCMD_LOCAL => {},
+        }
+    },
+
+    &CFGOPT_COMPRESS_TYPE =>
+    {
+        &CFGDEF_SECTION => CFGDEF_SECTION_GLOBAL,
+        &CFGDEF_TYPE => CFGDEF_TYPE_STRING,
+        &CFGDEF_DEFAULT => CFGOPTVAL_COMPRESS_TYPE_GZ,
+        &CFGDEF_ALLOW_LIST =>
+        [
+            &CFGOPTVAL_COMPRESS_TYPE_GZ,
+            &CFGOPTVAL_COMPRESS_TYPE_LZ4,
+            &CFGOPTVAL_COMPRESS_TYPE_ZST,
+        ],
+        &CFGDEF_COMMAND =>
+        {
+            &CFGCMD_ARCHIVE_PUSH => {},
+            &CFGCMD_ARCHIVE_PUSH_ASYNC => {},
+            &CFGCMD_BACKUP => {},
+        }
+    },
+
     &CFGOPT_NEUTRAL_UMASK =>
     {
         &CFGDEF_SECTION => CFGDEF_SECTION_GLOBAL,
@@ -1423,6 +1502,34 @@ my %hConfigDefine =
         },
     },
 
+    &CFGOPT_FILTER_THREAD =>
+    {
+        &CFGDEF_SECTION => CFGDEF_SECTION_GLOBAL,
+        &CFGDEF_TYPE => CFGDEF_TYPE_BOOLEAN,
+        &CFGDEF_DEFAULT => false,
+        &CFGDEF_COMMAND =>
+        {
+            &CFGCMD_BACKUP => {},
+            &CFGCMD_LOCAL => {},
+            &CFGCMD_RESTORE => {},
+        }
+    },
+
+    &CFGOPT_PROTOCOL_PIPELINE =>
+    {
+        &CFGDEF_SECTION => CFGDEF_SECTION_GLOBAL,
+        &CFGDEF_TYPE => CFGDEF_TYPE_INTEGER,
+        &CFGDEF_DEFAULT => 2,
+        &CFGDEF_ALLOW_RANGE => [1, 32],
+        &CFGDEF_COMMAND =>
+        {
+            &CFGCMD_ARCHIVE_GET => {},
+            &CFGCMD_ARCHIVE_GET_ASYNC => {},
+            &CFGCMD_ARCHIVE_PUSH => {},
+            &CFGCMD_ARCHIVE_PUSH_ASYNC => {},
+        }
+    },
+
     &CFGOPT_PROTOCOL_TIMEOUT =>
     {
         &CFGDEF_SECTION => CFGDEF_SECTION_GLOBAL,
@@ -1461,7 +1568,7 @@ my %hConfigDefine =
         &CFGDEF_DEPEND =>
         {
             &CFGDEF_DEPEND_OPTION => CFGOPT_REPO_CIPHER_TYPE,
-            &CFGDEF_DEPEND_LIST => [CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_CBC],
+            &CFGDEF_DEPEND_LIST => [CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_CBC, CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_GCM],
         },
         &CFGDEF_NAME_ALT =>
         {
@@ -1481,6 +1588,7 @@ my %hConfigDefine =
         [
             &CFGOPTVAL_REPO_CIPHER_TYPE_NONE,
             &CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_CBC,
+            &CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_GCM,
         ],
         &CFGDEF_NAME_ALT =>
         {
@@ -1786,6 +1894,18 @@ my %hConfigDefine =
         },
     },
 
+    &CFGOPT_REPO_S3_DOWNLOAD_MAX =>
+    {
+        &CFGDEF_SECTION => CFGDEF_SECTION_GLOBAL,
+        &CFGDEF_TYPE => CFGDEF_TYPE_INTEGER,
+        &CFGDEF_PREFIX => CFGDEF_PREFIX_REPO,
+        &CFGDEF_INDEX_TOTAL => CFGDEF_INDEX_REPO,
+        &CFGDEF_DEFAULT => 4,
+        &CFGDEF_ALLOW_RANGE => [1, 32],
+        &CFGDEF_DEPEND => CFGOPT_REPO_S3_BUCKET,
+        &CFGDEF_COMMAND => CFGOPT_REPO_TYPE,
+    },
+
     &CFGOPT_REPO_S3_KEY =>
     {
         &CFGDEF_SECTION => CFGDEF_SECTION_GLOBAL,
@@ -1892,6 +2012,18 @@ my %hConfigDefine =
         &CFGDEF_COMMAND => CFGOPT_REPO_TYPE,
     },
 
+    &CFGOPT_REPO_S3_UPLOAD_MAX =>
+    {
+        &CFGDEF_SECTION => CFGDEF_SECTION_GLOBAL,
+        &CFGDEF_TYPE => CFGDEF_TYPE_INTEGER,
+        &CFGDEF_PREFIX => CFGDEF_PREFIX_REPO,
+        &CFGDEF_INDEX_TOTAL => CFGDEF_INDEX_REPO,
+        &CFGDEF_DEFAULT => 4,
+        &CFGDEF_ALLOW_RANGE => [1, 32],
+        &CFGDEF_DEPEND => CFGOPT_REPO_S3_BUCKET,
+        &CFGDEF_COMMAND => CFGOPT_REPO_TYPE,
+    },
+
     &CFGOPT_REPO_S3_VERIFY_TLS =>
     {
         &CFGDEF_SECTION => CFGDEF_SECTION_GLOBAL,
@@ -2158,6 +2290,18 @@ my %hConfigDefine =
         },
     },
 
+    &CFGOPT_ARCHIVE_PUSH_STREAM =>
+    {
+        &CFGDEF_SECTION => CFGDEF_SECTION_GLOBAL,
+        &CFGDEF_TYPE => CFGDEF_TYPE_BOOLEAN,
+        &CFGDEF_DEFAULT => false,
+        &CFGDEF_COMMAND =>
+        {
+            &CFGCMD_ARCHIVE_PUSH => {},
+            &CFGCMD_ARCHIVE_PUSH_ASYNC => {},
+        },
+    },
+
     &CFGOPT_ARCHIVE_GET_QUEUE_MAX =>
     {
         &CFGDEF_SECTION => CFGDEF_SECTION_GLOBAL,
@@ -2171,6 +2315,18 @@ my %hConfigDefine =
         },
     },
 
+    &CFGOPT_ARCHIVE_GET_STREAM =>
+    {
+        &CFGDEF_SECTION => CFGDEF_SECTION_GLOBAL,
+        &CFGDEF_TYPE => CFGDEF_TYPE_BOOLEAN,
+        &CFGDEF_DEFAULT => false,
+        &CFGDEF_COMMAND =>
+        {
+            &CFGCMD_ARCHIVE_GET => {},
+            &CFGCMD_ARCHIVE_GET_ASYNC => {},
+        },
+    },
+
     # Backup options
     #-------------------------------------------------------------------------------------------------------------------------------
     &CFGOPT_ARCHIVE_CHECK =>
@@ -2258,6 +2414,17 @@ my %hConfigDefine =
         }
     },
 
+    &CFGOPT_PAGE_DELTA =>
+    {
+        &CFGDEF_SECTION => CFGDEF_SECTION_GLOBAL,
+        &CFGDEF_TYPE => CFGDEF_TYPE_BOOLEAN,
+        &CFGDEF_DEFAULT => false,
+        &CFGDEF_COMMAND =>
+        {
+            &CFGCMD_BACKUP => {},
+        }
+    },
+
     &CFGOPT_RESUME =>
     {
         &CFGDEF_SECTION => CFGDEF_SECTION_GLOBAL,
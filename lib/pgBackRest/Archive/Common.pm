@@ -194,7 +194,7 @@ sub walSegmentFind
             STORAGE_REPO_ARCHIVE . "/${strArchiveId}/" . substr($strWalSegment, 0, 16),
             {strExpression =>
                 '^' . substr($strWalSegment, 0, 24) . (walIsPartial($strWalSegment) ? "\\.partial" : '') .
-                "-[0-f]{40}(\\." . COMPRESS_EXT . "){0,1}\$",
+                "-[0-f]{40}" . COMPRESS_EXT_REGEXP . "\$",
                 bIgnoreMissing => true}));
     }
     while (@stryWalFileName == 0 && waitMore($oWait));
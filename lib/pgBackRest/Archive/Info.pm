@@ -391,7 +391,7 @@ sub reconstruct
         # ??? Should probably make a function in ArchiveCommon
         my $strArchiveFile = (storageRepo()->list(
             $self->{strArchiveClusterPath} . "/${strVersionDir}/${strArchiveDir}",
-            {strExpression => "^[0-F]{24}(\\.partial){0,1}(-[0-f]+){0,1}(\\." . COMPRESS_EXT . "){0,1}\$",
+            {strExpression => "^[0-F]{24}(\\.partial){0,1}(-[0-f]+){0,1}" . COMPRESS_EXT_REGEXP . "\$",
                 bIgnoreMissing => true}))[0];
 
         # Continue if any file structure or missing files info
@@ -415,11 +415,14 @@ sub reconstruct
                 "\nHINT: Is or was the repo encrypted?", ERROR_CRYPTO);
         }
 
+        # Get compression type from the file extension (undefined if not compressed)
+        my $strCompressType = compressTypeFromName($strArchiveFile);
+
         # If the file is encrypted, then the passprase from the info file is required, else getEncryptionKeySub returns undefined
         my $oFileIo = storageRepo()->openRead(
             $strArchiveFilePath,
-            {rhyFilter => $strArchiveFile =~ ('\.' . COMPRESS_EXT . '$') ?
-                [{strClass => STORAGE_FILTER_GZIP, rxyParam => [STORAGE_DECOMPRESS, false]}] : undef,
+            {rhyFilter => defined($strCompressType) ?
+                [{strClass => STORAGE_FILTER_COMPRESS, rxyParam => [STORAGE_DECOMPRESS, $strCompressType]}] : undef,
             strCipherPass => $self->cipherPassSub()});
         $oFileIo->open();
 
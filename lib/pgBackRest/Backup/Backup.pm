@@ -93,8 +93,8 @@ sub resumeClean
     # Build manifest for aborted backup path
     my $hFile = $oStorageRepo->manifest(STORAGE_REPO_BACKUP . "/${strBackupLabel}");
 
-    # Get compress flag
-    my $bCompressed = $oAbortedManifest->boolGet(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_COMPRESS);
+    # Get compress type (undefined if not compressed)
+    my $strCompressType = $oAbortedManifest->compressType();
 
     if (!$bDelta)
     {
@@ -122,9 +122,9 @@ sub resumeClean
                     # If the original backup was compressed then remove the extension before checking the manifest
                     my $strFile = $strName;
 
-                    if ($bCompressed)
+                    if (defined($strCompressType))
                     {
-                        $strFile = substr($strFile, 0, length($strFile) - 3);
+                        $strFile = substr($strFile, 0, length($strFile) - length($strCompressType) - 1);
                     }
 
                     # To be preserved the file must exist in the new manifest and not be a reference to a previous backup and must
@@ -175,9 +175,9 @@ sub resumeClean
             # If the original backup was compressed then remove the extension before checking the manifest
             my $strFile = $strName;
 
-            if ($bCompressed)
+            if (defined($strCompressType))
             {
-                $strFile = substr($strFile, 0, length($strFile) - 3);
+                $strFile = substr($strFile, 0, length($strFile) - length($strCompressType) - 1);
             }
 
             # To be preserved the file must exist in the new manifest and not be a reference to a previous backup
@@ -269,11 +269,13 @@ sub processManifest
         $strDbCopyPath,
         $strType,
         $strDbVersion,
-        $bCompress,
+        $strCompressType,
+        $iCompressLevel,
         $bHardLink,
         $oBackupManifest,
         $strBackupLabel,
         $strLsnStart,
+        $oFullManifest,
     ) =
         logDebugParam
     (
@@ -282,11 +284,13 @@ sub processManifest
         {name => 'strDbCopyPath'},
         {name => 'strType'},
         {name => 'strDbVersion'},
-        {name => 'bCompress'},
+        {name => 'strCompressType', required => false},
+        {name => 'iCompressLevel'},
         {name => 'bHardLink'},
         {name => 'oBackupManifest'},
         {name => 'strBackupLabel'},
         {name => 'strLsnStart', required => false},
+        {name => 'oFullManifest', required => false},
     );
 
     # Start backup test point
@@ -391,6 +395,18 @@ sub processManifest
         $lFileTotal++;
         $lSizeTotal += $lSize;
 
+        # Store only the pages changed since the full backup when the relation exists in the full backup.  The full backup is
+        # always the base so restore never needs to merge more than one delta.
+        my $strLsnPageDelta;
+        my $lPageDeltaBaseSize = 0;
+
+        if (defined($oFullManifest) && $lSize > 0 && isChecksumPage($strRepoFile) &&
+            $oFullManifest->numericGet(MANIFEST_SECTION_TARGET_FILE, $strRepoFile, MANIFEST_SUBKEY_SIZE, false, 0) > 0)
+        {
+            $strLsnPageDelta = $oFullManifest->get(MANIFEST_SECTION_BACKUP, MANIFEST_KEY_LSN_START);
+            $lPageDeltaBaseSize = $oFullManifest->numericGet(MANIFEST_SECTION_TARGET_FILE, $strRepoFile, MANIFEST_SUBKEY_SIZE);
+        }
+
         # Queue for parallel backup
         $oBackupProcess->queueJob(
             $iHostConfigIdx, $strQueueKey, $strRepoFile, OP_BACKUP_FILE,
@@ -399,8 +415,11 @@ sub processManifest
                 cfgOption(CFGOPT_CHECKSUM_PAGE) ? isChecksumPage($strRepoFile) : false,
                 defined($strLsnStart) ? hex((split('/', $strLsnStart))[0]) : 0xFFFFFFFF,
                 defined($strLsnStart) ? hex((split('/', $strLsnStart))[1]) : 0xFFFFFFFF,
-                $strRepoFile, defined($strReference) ? true : false, $bCompress, cfgOption(CFGOPT_COMPRESS_LEVEL),
-                $strBackupLabel, cfgOption(CFGOPT_DELTA)],
+                $strRepoFile, defined($strReference) ? true : false,
+                defined($strCompressType) ? $strCompressType : COMPRESS_TYPE_NONE, $iCompressLevel,
+                $strBackupLabel, cfgOption(CFGOPT_DELTA),
+                defined($strLsnPageDelta) ? hex((split('/', $strLsnPageDelta))[0]) : 0,
+                defined($strLsnPageDelta) ? hex((split('/', $strLsnPageDelta))[1]) : 0, $lPageDeltaBaseSize],
             {rParamSecure => $oBackupManifest->cipherPassSub() ? [$oBackupManifest->cipherPassSub()] : undef});
 
         # Size and checksum will be removed and then verified later as a sanity check
@@ -445,6 +464,18 @@ sub processManifest
                 $hJob->{iProcessId}, @{$hJob->{rParam}}[0], @{$hJob->{rParam}}[7], @{$hJob->{rParam}}[2], @{$hJob->{rParam}}[3],
                 @{$hJob->{rParam}}[4], @{$hJob->{rResult}}, $lSizeTotal, $lSizeCurrent, $lManifestSaveSize,
                 $lManifestSaveCurrent);
+
+            # If the file was copied as a page delta then store the base it must be merged with on restore
+            if ((@{$hJob->{rResult}}[0] == BACKUP_FILE_COPY || @{$hJob->{rResult}}[0] == BACKUP_FILE_RECOPY) &&
+                @{$hJob->{rParam}}[15] > 0)
+            {
+                $oBackupManifest->set(
+                    MANIFEST_SECTION_TARGET_FILE, @{$hJob->{rParam}}[7], MANIFEST_SUBKEY_PAGE_DELTA_BASE,
+                    $oFullManifest->get(MANIFEST_SECTION_BACKUP, MANIFEST_KEY_LABEL));
+                $oBackupManifest->set(
+                    MANIFEST_SECTION_TARGET_FILE, @{$hJob->{rParam}}[7], MANIFEST_SUBKEY_PAGE_DELTA_BASE_COMPRESS_TYPE,
+                    defined($oFullManifest->compressType()) ? $oFullManifest->compressType() : COMPRESS_TYPE_NONE);
+            }
         }
 
         # A keep-alive is required here because if there are a large number of resumed files that need to be checksummed
@@ -466,8 +497,8 @@ sub processManifest
                 &log(DETAIL, "hardlink ${strFile} to ${strReference}");
 
                 storageRepo()->linkCreate(
-                    STORAGE_REPO_BACKUP . "/${strReference}/${strFile}" . ($bCompress ? qw{.} . COMPRESS_EXT : ''),
-                    STORAGE_REPO_BACKUP . "/${strBackupLabel}/${strFile}" . ($bCompress ? qw{.} . COMPRESS_EXT : ''),
+                    STORAGE_REPO_BACKUP . "/${strReference}/${strFile}" . compressExt($strCompressType),
+                    STORAGE_REPO_BACKUP . "/${strBackupLabel}/${strFile}" . compressExt($strCompressType),
                     {bHard => true});
             }
             # Else log the reference. With delta, it is possible that references may have been removed if a file needed to be
@@ -511,6 +542,8 @@ sub process
     # Store local type, compress, and hardlink options since they can be modified by the process
     my $strType = cfgOption(CFGOPT_TYPE);
     my $bCompress = cfgOption(CFGOPT_COMPRESS);
+    my $strCompressType = cfgOption(CFGOPT_COMPRESS_TYPE);
+    my $iCompressLevel = cfgOption(CFGOPT_COMPRESS_LEVEL);
     my $bHardLink = cfgOption(CFGOPT_REPO_HARDLINK);
 
     # Load the backup.info
@@ -594,6 +627,26 @@ sub process
                 $bCompress = $oLastManifest->boolGet(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_COMPRESS);
             }
 
+            # Warn if compress-type option changed
+            if ($bCompress && $oLastManifest->compressType() ne $strCompressType)
+            {
+                &log(WARN, "${strType} backup cannot alter compress-type option to '${strCompressType}'" .
+                           ", reset to value in ${strBackupLastPath}");
+                $strCompressType = $oLastManifest->compressType();
+
+                # The compress level was defaulted or validated for the configured compress type so it must be checked again
+                if (cfgOptionSource(CFGOPT_COMPRESS_LEVEL) eq CFGDEF_SOURCE_DEFAULT)
+                {
+                    $iCompressLevel = compressLevelDefault($strCompressType);
+                }
+                elsif (!compressLevelValid($strCompressType, $iCompressLevel))
+                {
+                    &log(WARN, "compress-level option '${iCompressLevel}' is not valid for compress-type '${strCompressType}'" .
+                               ", reset to default '" . compressLevelDefault($strCompressType) . "'");
+                    $iCompressLevel = compressLevelDefault($strCompressType);
+                }
+            }
+
             # Warn if hardlink option changed
             if (!$oLastManifest->boolTest(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_HARDLINK, undef, $bHardLink))
             {
@@ -682,6 +735,13 @@ sub process
                         $strValueNew = cfgOption(CFGOPT_COMPRESS);
                         $strValueAborted = $oAbortedManifest->boolGet(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_COMPRESS);
                     }
+                    # Check compression type
+                    elsif (cfgOption(CFGOPT_COMPRESS) && $oAbortedManifest->compressType() ne cfgOption(CFGOPT_COMPRESS_TYPE))
+                    {
+                        $strKey = MANIFEST_KEY_COMPRESS_TYPE;
+                        $strValueNew = cfgOption(CFGOPT_COMPRESS_TYPE);
+                        $strValueAborted = $oAbortedManifest->compressType();
+                    }
                     # Check hardlink
                     elsif ($oAbortedManifest->boolGet(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_HARDLINK) !=
                            cfgOption(CFGOPT_REPO_HARDLINK))
@@ -772,8 +832,19 @@ sub process
     $oBackupManifest->boolSet(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_BACKUP_STANDBY, undef, cfgOption(CFGOPT_BACKUP_STANDBY));
     $oBackupManifest->numericSet(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_BUFFER_SIZE, undef, cfgOption(CFGOPT_BUFFER_SIZE));
     $oBackupManifest->boolSet(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_COMPRESS, undef, $bCompress);
+
+    # The compress type is only stored when it is not the default so older versions can still read the manifest
+    if (!$bCompress)
+    {
+        $strCompressType = undef;
+    }
+    elsif ($strCompressType ne CFGOPTVAL_COMPRESS_TYPE_GZ)
+    {
+        $oBackupManifest->set(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_COMPRESS_TYPE, undef, $strCompressType);
+    }
+
     $oBackupManifest->numericSet(
-        MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_COMPRESS_LEVEL, undef, cfgOption(CFGOPT_COMPRESS_LEVEL));
+        MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_COMPRESS_LEVEL, undef, $iCompressLevel);
     $oBackupManifest->numericSet(
         MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_COMPRESS_LEVEL_NETWORK, undef, cfgOption(CFGOPT_COMPRESS_LEVEL_NETWORK));
     $oBackupManifest->boolSet(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_HARDLINK, undef, $bHardLink);
@@ -904,6 +975,28 @@ sub process
         }
     }
 
+    # Page deltas are always generated against the full backup so load its manifest.  The full backup must have been online so there
+    # is a start lsn to compare page lsns against.
+    my $oFullManifest;
+
+    if (cfgOption(CFGOPT_PAGE_DELTA) && $strType ne CFGOPTVAL_BACKUP_TYPE_FULL && defined($strBackupLastPath))
+    {
+        my $strBackupFullPath = (split('_', $strBackupLastPath))[0];
+
+        $oFullManifest = $strBackupFullPath eq $strBackupLastPath ? $oLastManifest : new pgBackRest::Manifest(
+            $oStorageRepo->pathGet(STORAGE_REPO_BACKUP . "/${strBackupFullPath}/" . FILE_MANIFEST),
+            {strCipherPass => $strCipherPassManifest});
+
+        if (!$oFullManifest->test(MANIFEST_SECTION_BACKUP, MANIFEST_KEY_LSN_START))
+        {
+            &log(WARN,
+                "${strType} backup cannot use '" . cfgOptionName(CFGOPT_PAGE_DELTA) . "' option since full backup" .
+                    " ${strBackupFullPath} has no start lsn, reset to 'n'");
+            cfgOptionSet(CFGOPT_PAGE_DELTA, false);
+            undef($oFullManifest);
+        }
+    }
+
     # Record checksum-page option in the manifest
     $oBackupManifest->boolSet(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_CHECKSUM_PAGE, undef, cfgOption(CFGOPT_CHECKSUM_PAGE));
 
@@ -941,8 +1034,8 @@ sub process
     # Perform the backup
     my $lBackupSizeTotal =
         $self->processManifest(
-            $strDbMasterPath, $strDbCopyPath, $strType, $strDbVersion, $bCompress, $bHardLink, $oBackupManifest, $strBackupLabel,
-            $strLsnStart);
+            $strDbMasterPath, $strDbCopyPath, $strType, $strDbVersion, $strCompressType, $iCompressLevel, $bHardLink,
+            $oBackupManifest, $strBackupLabel, $strLsnStart, $oFullManifest);
     &log(INFO, "${strType} backup size = " . fileSizeFormat($lBackupSizeTotal));
 
     # Master file object no longer needed
@@ -969,17 +1062,18 @@ sub process
                 my $rhyFilter = [{strClass => STORAGE_FILTER_SHA}];
 
                 # Add compression filter
-                if ($bCompress)
+                if (defined($strCompressType))
                 {
                     push(
                         @{$rhyFilter},
-                        {strClass => STORAGE_FILTER_GZIP, rxyParam => [STORAGE_COMPRESS, false, cfgOption(CFGOPT_COMPRESS_LEVEL)]});
+                        {strClass => STORAGE_FILTER_COMPRESS,
+                            rxyParam => [STORAGE_COMPRESS, $strCompressType, $iCompressLevel]});
                 }
 
                 # If the backups are encrypted, then the passphrase for the backup set from the manifest file is required to access
                 # the file in the repo
                 my $oDestinationFileIo = $oStorageRepo->openWrite(
-                    STORAGE_REPO_BACKUP . "/${strBackupLabel}/${strFile}" . ($bCompress ? qw{.} . COMPRESS_EXT : ''),
+                    STORAGE_REPO_BACKUP . "/${strBackupLabel}/${strFile}" . compressExt($strCompressType),
                     {rhyFilter => $rhyFilter,
                     strCipherPass => defined($strCipherPassBackupSet) ? $strCipherPassBackupSet : undef});
 
@@ -1030,14 +1124,37 @@ sub process
             {
                 logDebugMisc($strOperation, "archive: ${strArchive} (${strArchiveFile})");
 
-                # Copy the log file from the archive repo to the backup
-                my $bArchiveCompressed = $strArchiveFile =~ ('^.*\.' . COMPRESS_EXT . '\$');
+                # Copy the log file from the archive repo to the backup.  If the segment was compressed with a different type than
+                # the backup then recompress it.
+                my $strArchiveCompressType = compressTypeFromName($strArchiveFile);
+                my $rhyFilter;
+
+                if ((defined($strArchiveCompressType) ? $strArchiveCompressType : '') ne
+                    (defined($strCompressType) ? $strCompressType : ''))
+                {
+                    $rhyFilter = [];
+
+                    if (defined($strArchiveCompressType))
+                    {
+                        push(
+                            @{$rhyFilter},
+                            {strClass => STORAGE_FILTER_COMPRESS, rxyParam => [STORAGE_DECOMPRESS, $strArchiveCompressType]});
+                    }
+
+                    if (defined($strCompressType))
+                    {
+                        push(
+                            @{$rhyFilter},
+                            {strClass => STORAGE_FILTER_COMPRESS,
+                                rxyParam => [STORAGE_COMPRESS, $strCompressType, $iCompressLevel]});
+                    }
+                }
 
                 $oStorageRepo->copy(
                     $oStorageRepo->openRead(STORAGE_REPO_ARCHIVE . "/${strArchiveId}/${strArchiveFile}",
-                        {strCipherPass => $oArchiveInfo->cipherPassSub()}),
+                        {rhyFilter => $rhyFilter, strCipherPass => $oArchiveInfo->cipherPassSub()}),
                     $oStorageRepo->openWrite(STORAGE_REPO_BACKUP . "/${strBackupLabel}/" . MANIFEST_TARGET_PGDATA . qw{/} .
-                        $oBackupManifest->walPath() . "/${strArchive}" . ($bCompress ? qw{.} . COMPRESS_EXT : ''),
+                        $oBackupManifest->walPath() . "/${strArchive}" . compressExt($strCompressType),
                         {bPathCreate => true, strCipherPass => $strCipherPassBackupSet})
                     );
 
@@ -145,10 +145,13 @@ sub backupManifestUpdate
                 $oManifest->set(MANIFEST_SECTION_TARGET_FILE, $strRepoFile, MANIFEST_SUBKEY_CHECKSUM, $strChecksumCopy);
             }
 
-            # If the file was copied, then remove any reference to the file's existence in a prior backup.
+            # If the file was copied, then remove any reference to the file's existence in a prior backup and the page delta base
+            # that came with it.
             if ($iCopyResult == BACKUP_FILE_COPY || $iCopyResult == BACKUP_FILE_RECOPY)
             {
                 $oManifest->remove(MANIFEST_SECTION_TARGET_FILE, $strRepoFile, MANIFEST_SUBKEY_REFERENCE);
+                $oManifest->remove(MANIFEST_SECTION_TARGET_FILE, $strRepoFile, MANIFEST_SUBKEY_PAGE_DELTA_BASE);
+                $oManifest->remove(MANIFEST_SECTION_TARGET_FILE, $strRepoFile, MANIFEST_SUBKEY_PAGE_DELTA_BASE_COMPRESS_TYPE);
             }
 
             # If the file had page checksums calculated during the copy
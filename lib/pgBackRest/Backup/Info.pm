@@ -478,6 +478,15 @@ sub add
             $lBackupSizeDelta += $lFileSize;
             $lBackupRepoSizeDelta += $lRepoSize;
         }
+
+        # A page delta also requires the backup that contains its base
+        my $strFilePageDeltaBase =
+            $oBackupManifest->get(MANIFEST_SECTION_TARGET_FILE, $strFileKey, MANIFEST_SUBKEY_PAGE_DELTA_BASE, false);
+
+        if (defined($strFilePageDeltaBase))
+        {
+            $$oReferenceHash{$strFilePageDeltaBase} = true;
+        }
     }
 
     # Set backup size info
@@ -11,11 +11,16 @@ sub libcAutoConstant
 {
     return
     {
+        CFGOPTVAL_COMPRESS_TYPE_GZ                                       => 'gz',
+        CFGOPTVAL_COMPRESS_TYPE_LZ4                                      => 'lz4',
+        CFGOPTVAL_COMPRESS_TYPE_ZST                                      => 'zst',
+
         CFGOPTVAL_INFO_OUTPUT_TEXT                                       => 'text',
         CFGOPTVAL_INFO_OUTPUT_JSON                                       => 'json',
 
         CFGOPTVAL_REPO_CIPHER_TYPE_NONE                                  => 'none',
         CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_CBC                           => 'aes-256-cbc',
+        CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_GCM                           => 'aes-256-gcm',
 
         CFGOPTVAL_REPO_RETENTION_ARCHIVE_TYPE_FULL                       => 'full',
         CFGOPTVAL_REPO_RETENTION_ARCHIVE_TYPE_DIFF                       => 'diff',
@@ -78,10 +83,14 @@ sub libcAutoExportTag
 
         config =>
         [
+            'CFGOPTVAL_COMPRESS_TYPE_GZ',
+            'CFGOPTVAL_COMPRESS_TYPE_LZ4',
+            'CFGOPTVAL_COMPRESS_TYPE_ZST',
             'CFGOPTVAL_INFO_OUTPUT_TEXT',
             'CFGOPTVAL_INFO_OUTPUT_JSON',
             'CFGOPTVAL_REPO_CIPHER_TYPE_NONE',
             'CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_CBC',
+            'CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_GCM',
             'CFGOPTVAL_REPO_RETENTION_ARCHIVE_TYPE_FULL',
             'CFGOPTVAL_REPO_RETENTION_ARCHIVE_TYPE_DIFF',
             'CFGOPTVAL_REPO_RETENTION_ARCHIVE_TYPE_INCR',
@@ -130,17 +139,22 @@ sub libcAutoExportTag
             'CFGOPT_ARCHIVE_CHECK',
             'CFGOPT_ARCHIVE_COPY',
             'CFGOPT_ARCHIVE_GET_QUEUE_MAX',
+            'CFGOPT_ARCHIVE_GET_STREAM',
             'CFGOPT_ARCHIVE_PUSH_QUEUE_MAX',
+            'CFGOPT_ARCHIVE_PUSH_STREAM',
             'CFGOPT_ARCHIVE_TIMEOUT',
             'CFGOPT_BACKUP_STANDBY',
             'CFGOPT_BUFFER_SIZE',
             'CFGOPT_C',
             'CFGOPT_CHECKSUM_PAGE',
+            'CFGOPT_CIPHER_THREAD',
             'CFGOPT_CMD_SSH',
             'CFGOPT_COMMAND',
             'CFGOPT_COMPRESS',
             'CFGOPT_COMPRESS_LEVEL',
             'CFGOPT_COMPRESS_LEVEL_NETWORK',
+            'CFGOPT_COMPRESS_THREAD',
+            'CFGOPT_COMPRESS_TYPE',
             'CFGOPT_CONFIG',
             'CFGOPT_CONFIG_INCLUDE_PATH',
             'CFGOPT_CONFIG_PATH',
@@ -149,6 +163,7 @@ sub libcAutoExportTag
             'CFGOPT_DELTA',
             'CFGOPT_EXCLUDE',
             'CFGOPT_FILTER',
+            'CFGOPT_FILTER_THREAD',
             'CFGOPT_FORCE',
             'CFGOPT_HOST_ID',
             'CFGOPT_LINK_ALL',
@@ -164,6 +179,7 @@ sub libcAutoExportTag
             'CFGOPT_NEUTRAL_UMASK',
             'CFGOPT_ONLINE',
             'CFGOPT_OUTPUT',
+            'CFGOPT_PAGE_DELTA',
             'CFGOPT_PERL_OPTION',
             'CFGOPT_PG_HOST',
             'CFGOPT_PG_HOST2',
@@ -247,6 +263,7 @@ sub libcAutoExportTag
             'CFGOPT_PG_SOCKET_PATH8',
             'CFGOPT_PROCESS',
             'CFGOPT_PROCESS_MAX',
+            'CFGOPT_PROTOCOL_PIPELINE',
             'CFGOPT_PROTOCOL_TIMEOUT',
             'CFGOPT_RECOVERY_OPTION',
             'CFGOPT_REPO_CIPHER_PASS',
@@ -267,6 +284,7 @@ sub libcAutoExportTag
             'CFGOPT_REPO_S3_BUCKET',
             'CFGOPT_REPO_S3_CA_FILE',
             'CFGOPT_REPO_S3_CA_PATH',
+            'CFGOPT_REPO_S3_DOWNLOAD_MAX',
             'CFGOPT_REPO_S3_ENDPOINT',
             'CFGOPT_REPO_S3_HOST',
             'CFGOPT_REPO_S3_KEY',
@@ -274,6 +292,7 @@ sub libcAutoExportTag
             'CFGOPT_REPO_S3_PORT',
             'CFGOPT_REPO_S3_REGION',
             'CFGOPT_REPO_S3_TOKEN',
+            'CFGOPT_REPO_S3_UPLOAD_MAX',
             'CFGOPT_REPO_S3_VERIFY_TLS',
             'CFGOPT_REPO_TYPE',
             'CFGOPT_RESUME',
@@ -113,6 +113,8 @@ use constant MANIFEST_KEY_COMPRESS_LEVEL                            => 'option-'
     push @EXPORT, qw(MANIFEST_KEY_COMPRESS_LEVEL);
 use constant MANIFEST_KEY_COMPRESS_LEVEL_NETWORK                    => 'option-' . cfgOptionName(CFGOPT_COMPRESS_LEVEL_NETWORK);
     push @EXPORT, qw(MANIFEST_KEY_COMPRESS_LEVEL_NETWORK);
+use constant MANIFEST_KEY_COMPRESS_TYPE                             => 'option-' . cfgOptionName(CFGOPT_COMPRESS_TYPE);
+    push @EXPORT, qw(MANIFEST_KEY_COMPRESS_TYPE);
 use constant MANIFEST_KEY_ONLINE                                    => 'option-' . cfgOptionName(CFGOPT_ONLINE);
     push @EXPORT, qw(MANIFEST_KEY_ONLINE);
 use constant MANIFEST_KEY_DELTA                                     => 'option-' . cfgOptionName(CFGOPT_DELTA);
@@ -153,6 +155,10 @@ use constant MANIFEST_SUBKEY_MASTER                                 => 'master';
     push @EXPORT, qw(MANIFEST_SUBKEY_MASTER);
 use constant MANIFEST_SUBKEY_MODE                                   => 'mode';
     push @EXPORT, qw(MANIFEST_SUBKEY_MODE);
+use constant MANIFEST_SUBKEY_PAGE_DELTA_BASE                        => 'page-delta-base';
+    push @EXPORT, qw(MANIFEST_SUBKEY_PAGE_DELTA_BASE);
+use constant MANIFEST_SUBKEY_PAGE_DELTA_BASE_COMPRESS_TYPE          => 'page-delta-base-compress-type';
+    push @EXPORT, qw(MANIFEST_SUBKEY_PAGE_DELTA_BASE_COMPRESS_TYPE);
 use constant MANIFEST_SUBKEY_TIMESTAMP                              => 'timestamp';
     push @EXPORT, qw(MANIFEST_SUBKEY_TIMESTAMP);
 use constant MANIFEST_SUBKEY_TYPE                                   => 'type';
@@ -815,8 +821,10 @@ sub build
         $strPath = $oStorageDbMaster->pathAbsolute($strParentPath, $strPath);
     }
 
-    # Get the manifest for this level
-    my $hManifest = $oStorageDbMaster->manifest($strPath, {strFilter => $strFilter});
+    # Get the manifest for this level.  Paths are scanned in parallel with as many threads as there are backup processes.
+    my $hManifest = $oStorageDbMaster->manifest(
+        $strPath,
+        {strFilter => $strFilter, iThreadMax => cfgOptionValid(CFGOPT_PROCESS_MAX) ? cfgOption(CFGOPT_PROCESS_MAX) : 1});
     my $strManifestType = MANIFEST_VALUE_LINK;
 
     # Loop though all paths/files/links in the manifest
@@ -1189,6 +1197,18 @@ sub build
                         $oLastManifest->get(MANIFEST_SECTION_TARGET_FILE, $strName, MANIFEST_SUBKEY_MASTER));
                 }
 
+                # Copy page delta base from the previous manifest (if it exists) since the referenced file is a page delta
+                if ($oLastManifest->test(MANIFEST_SECTION_TARGET_FILE, $strName, MANIFEST_SUBKEY_PAGE_DELTA_BASE))
+                {
+                    $self->set(
+                        MANIFEST_SECTION_TARGET_FILE, $strName, MANIFEST_SUBKEY_PAGE_DELTA_BASE,
+                        $oLastManifest->get(MANIFEST_SECTION_TARGET_FILE, $strName, MANIFEST_SUBKEY_PAGE_DELTA_BASE));
+                    $self->set(
+                        MANIFEST_SECTION_TARGET_FILE, $strName, MANIFEST_SUBKEY_PAGE_DELTA_BASE_COMPRESS_TYPE,
+                        $oLastManifest->get(
+                            MANIFEST_SECTION_TARGET_FILE, $strName, MANIFEST_SUBKEY_PAGE_DELTA_BASE_COMPRESS_TYPE));
+                }
+
                 # Copy checksum page from the previous manifest (if it exists)
                 my $bChecksumPage = $oLastManifest->get(
                     MANIFEST_SECTION_TARGET_FILE, $strName, MANIFEST_SUBKEY_CHECKSUM_PAGE, false);
@@ -1462,6 +1482,20 @@ sub dbVersion
     return $self->get(MANIFEST_SECTION_BACKUP_DB, MANIFEST_KEY_DB_VERSION);
 }
 
+####################################################################################################################################
+# compressType
+#
+# Type used to compress files in the backup or undef when files are not compressed.  The type is only stored when it is not gz so
+# manifests written before other types were supported are read correctly.
+####################################################################################################################################
+sub compressType
+{
+    my $self = shift;
+
+    return $self->boolGet(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_COMPRESS) ?
+        $self->get(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_COMPRESS_TYPE, undef, false, CFGOPTVAL_COMPRESS_TYPE_GZ) : undef;
+}
+
 ####################################################################################################################################
 # xactPath - return the transaction directory based on the PostgreSQL version
 ####################################################################################################################################
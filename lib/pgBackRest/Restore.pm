@@ -1297,7 +1297,12 @@ sub process
                 $oManifest->get(MANIFEST_SECTION_TARGET_FILE, $strRepoFile, MANIFEST_SUBKEY_USER),
                 $oManifest->get(MANIFEST_SECTION_TARGET_FILE, $strRepoFile, MANIFEST_SUBKEY_GROUP),
                 $oManifest->numericGet(MANIFEST_SECTION_BACKUP, MANIFEST_KEY_TIMESTAMP_COPY_START),  cfgOption(CFGOPT_DELTA),
-                $self->{strBackupSet}, $oManifest->boolGet(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_COMPRESS)],
+                $self->{strBackupSet},
+                defined($oManifest->compressType()) ? $oManifest->compressType() : COMPRESS_TYPE_NONE,
+                $oManifest->get(MANIFEST_SECTION_TARGET_FILE, $strRepoFile, MANIFEST_SUBKEY_PAGE_DELTA_BASE, false),
+                $oManifest->get(
+                    MANIFEST_SECTION_TARGET_FILE, $strRepoFile, MANIFEST_SUBKEY_PAGE_DELTA_BASE_COMPRESS_TYPE, false,
+                    COMPRESS_TYPE_NONE)],
             {rParamSecure => $oManifest->cipherPassSub() ? [$oManifest->cipherPassSub()] : undef});
     }
 
@@ -44,12 +44,16 @@ use constant STORAGE_DECRYPT                                        => 'decrypt'
     push @EXPORT, qw(STORAGE_DECRYPT);
 use constant CIPHER_MAGIC                                           => 'Salted__';
     push @EXPORT, qw(CIPHER_MAGIC);
+use constant CIPHER_CHUNK_MAGIC                                     => 'PGBRCHK1';
+    push @EXPORT, qw(CIPHER_CHUNK_MAGIC);
 
 ####################################################################################################################################
 # Filter constants
 ####################################################################################################################################
 use constant STORAGE_FILTER_CIPHER_BLOCK                            => 'pgBackRest::Storage::Filter::CipherBlock';
     push @EXPORT, qw(STORAGE_FILTER_CIPHER_BLOCK);
+use constant STORAGE_FILTER_COMPRESS                                => 'pgBackRest::Storage::Filter::Compress';
+    push @EXPORT, qw(STORAGE_FILTER_COMPRESS);
 use constant STORAGE_FILTER_GZIP                                    => 'pgBackRest::Storage::Filter::Gzip';
     push @EXPORT, qw(STORAGE_FILTER_GZIP);
 use constant STORAGE_FILTER_SHA                                     => 'pgBackRest::Storage::Filter::Sha';
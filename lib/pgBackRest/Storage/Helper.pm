@@ -23,6 +23,14 @@ use pgBackRest::Version;
 use constant COMPRESS_EXT                                           => 'gz';
     push @EXPORT, qw(COMPRESS_EXT);
 
+# Regular expression that matches the extension of any compression type
+use constant COMPRESS_EXT_REGEXP                                    => '(\\.(gz|lz4|zst)){0,1}';
+    push @EXPORT, qw(COMPRESS_EXT_REGEXP);
+
+# Compression type passed to C functions when a file is not compressed
+use constant COMPRESS_TYPE_NONE                                     => 'none';
+    push @EXPORT, qw(COMPRESS_TYPE_NONE);
+
 ####################################################################################################################################
 # Temp file extension
 ####################################################################################################################################
@@ -50,4 +58,59 @@ sub storageLocal
 
 push @EXPORT, qw(storageLocal);
 
+####################################################################################################################################
+# compressExt - get the file extension for a compression type, or an empty string when the type is undefined (not compressed)
+####################################################################################################################################
+sub compressExt
+{
+    my $strCompressType = shift;
+
+    return defined($strCompressType) ? ".${strCompressType}" : '';
+}
+
+push @EXPORT, qw(compressExt);
+
+####################################################################################################################################
+# compressTypeFromName - get the compression type from a file extension, or undef when the file is not compressed
+####################################################################################################################################
+sub compressTypeFromName
+{
+    my $strFile = shift;
+
+    return $strFile =~ /\.(gz|lz4|zst)$/ ? $1 : undef;
+}
+
+push @EXPORT, qw(compressTypeFromName);
+
+####################################################################################################################################
+# compressLevelDefault/compressLevelValid - default and allowed compression levels for each type (must match src/common/compress)
+####################################################################################################################################
+my $rhCompressLevel =
+{
+    gz => {iMin => 0, iMax => 9, iDefault => 6},
+    lz4 => {iMin => -5, iMax => 12, iDefault => 1},
+    zst => {iMin => -5, iMax => 22, iDefault => 3},
+};
+
+sub compressLevelDefault
+{
+    my $strCompressType = shift;
+
+    return $rhCompressLevel->{$strCompressType}{iDefault};
+}
+
+push @EXPORT, qw(compressLevelDefault);
+
+sub compressLevelValid
+{
+    my $strCompressType = shift;
+    my $iCompressLevel = shift;
+
+    return
+        $iCompressLevel >= $rhCompressLevel->{$strCompressType}{iMin} &&
+        $iCompressLevel <= $rhCompressLevel->{$strCompressType}{iMax} ? true : false;
+}
+
+push @EXPORT, qw(compressLevelValid);
+
 1;
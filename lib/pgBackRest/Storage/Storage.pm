@@ -392,15 +392,17 @@ sub manifest
         $strOperation,
         $strPathExp,
         $strFilter,
+        $iThreadMax,
     ) =
         logDebugParam
         (
             __PACKAGE__ . '->manifest', \@_,
             {name => 'strPathExp'},
             {name => 'strFilter', optional => true, trace => true},
+            {name => 'iThreadMax', optional => true, default => 1, trace => true},
         );
 
-    my $hManifest = $self->{oJSON}->decode($self->{oStorageC}->manifest($strPathExp, $strFilter));
+    my $hManifest = $self->{oJSON}->decode($self->{oStorageC}->manifest($strPathExp, $strFilter, $iThreadMax));
 
     # Return from function and log return values if any
     return logDebugReturn
@@ -971,12 +973,13 @@ sub encrypted
     }
     else
     {
-        # If the file does exist, then read the magic signature
+        # If the file does exist, then read the magic signature, which depends on the cipher used to encrypt the file
         my $tMagicSignature = '';
         my $lSizeRead = $oFileIo->read(\$tMagicSignature, length(CIPHER_MAGIC));
         $oFileIo->close();
 
-        if (substr($tMagicSignature, 0, length(CIPHER_MAGIC)) eq CIPHER_MAGIC)
+        if (substr($tMagicSignature, 0, length(CIPHER_MAGIC)) eq CIPHER_MAGIC ||
+            substr($tMagicSignature, 0, length(CIPHER_CHUNK_MAGIC)) eq CIPHER_CHUNK_MAGIC)
         {
             $bEncrypted = true;
         }
@@ -57,7 +57,7 @@ INPUT:
     pgBackRest::LibC::Storage self
 CODE:
     if (strEq(storageType(self), STORAGE_S3_TYPE_STR))
-        storageS3Request((StorageS3 *)storageDriver(self), HTTP_VERB_PUT_STR, FSLASH_STR, NULL, NULL, true, false);
+        storageS3Request((StorageS3 *)storageDriver(self), HTTP_VERB_PUT_STR, FSLASH_STR, NULL, NULL, NULL, true, false);
     else
         THROW_FMT(AssertError, "unable to create bucket on '%s' storage", strPtr(storageType(self)));
 CLEANUP:
@@ -177,7 +177,7 @@ CLEANUP:
 
 ####################################################################################################################################
 SV *
-manifest(self, pathExp, filter=NULL)
+manifest(self, pathExp, filter=NULL, threadMax=1)
 PREINIT:
     MEM_CONTEXT_XS_TEMP_BEGIN()
     {
@@ -185,13 +185,22 @@ INPUT:
     pgBackRest::LibC::Storage self
     const String *pathExp = STR_NEW_SV($arg);
     const String *filter = STR_NEW_SV($arg);
+    U32 threadMax
 CODE:
     StorageManifestXsCallbackData data = {.storage = self, .json = strNew("{"), .pathRoot = pathExp, .filter = filter};
 
     // If a path is specified
     StorageInfo info = storageInfoP(self, pathExp, .ignoreMissing = true);
 
-    if (!info.exists || info.type == storageTypePath)
+    // Walk posix storage in parallel
+    if (strEq(storageType(self), STORAGE_POSIX_TYPE_STR) && (!info.exists || info.type == storageTypePath))
+    {
+        const String *path = storagePath(self, pathExp);
+
+        if (!storagePosixWalk(path, filter, threadMax, storageManifestXsWalkCallback, &data))
+            THROW_FMT(PathMissingError, STORAGE_ERROR_LIST_INFO_MISSING, strPtr(path));
+    }
+    else if (!info.exists || info.type == storageTypePath)
     {
         storageInfoListP(
             self, data.pathRoot, storageManifestXsCallback, &data,
@@ -12,6 +12,7 @@ Archive Common
 #include "common/log.h"
 #include "common/memContext.h"
 #include "common/regExp.h"
+#include "common/type/list.h"
 #include "common/wait.h"
 #include "config/config.h"
 #include "postgres/version.h"
@@ -26,6 +27,10 @@ STRING_EXTERN(WAL_SEGMENT_PARTIAL_REGEXP_STR,                       WAL_SEGMENT_
 STRING_EXTERN(WAL_SEGMENT_DIR_REGEXP_STR,                           WAL_SEGMENT_DIR_REGEXP);
 STRING_EXTERN(WAL_SEGMENT_FILE_REGEXP_STR,                          WAL_SEGMENT_FILE_REGEXP);
 
+// Match on any WAL segment file with checksum appended (including partials) that can be stored in the WAL segment index
+#define WAL_SEGMENT_INDEX_FILE_REGEXP                               "^[0-F]{24}(\\.partial){0,1}-[0-f]{40}" COMPRESS_EXT_REGEXP "$"
+    STRING_STATIC(WAL_SEGMENT_INDEX_FILE_REGEXP_STR,                WAL_SEGMENT_INDEX_FILE_REGEXP);
+
 /***********************************************************************************************************************************
 Global error file constant
 ***********************************************************************************************************************************/
@@ -291,11 +296,290 @@ walIsSegment(const String *walSegment)
     FUNCTION_LOG_RETURN(BOOL, regExpMatch(regExpSegment, walSegment));
 }
 
+/***********************************************************************************************************************************
+WAL segment index
+
+Caches the WAL segments in each archive/<archive id>/<16 char prefix> path so a batch of lookups (e.g. by a local process serving
+async archive-push/get jobs) requires one list per path rather than one list per segment.
+
+Segments found in the index are trusted in both modes.  For archive-get a segment that is not found causes the path to be reloaded
+since the segment may have been pushed after the path was loaded.  For archive-push a segment that is not found is expected (it is
+about to be pushed) so the path is not reloaded -- segments pushed by other processes after the path was loaded will not be seen, so
+in push mode the index must be disabled with walSegmentIndexDisable() at the start of each batch.
+***********************************************************************************************************************************/
+typedef struct WalSegmentIndexPath
+{
+    String *path;                                                   // Archive id and 16 character segment prefix
+    StringList *fileList;                                           // Sorted list of WAL segment files in the path
+} WalSegmentIndexPath;
+
+static struct
+{
+    MemContext *memContext;                                         // Mem context for the index
+    ArchiveMode archiveMode;                                        // Determines if the path is reloaded when a segment is missing
+    List *pathList;                                                 // Paths loaded into the index
+} walSegmentIndex;
+
+/***********************************************************************************************************************************
+Enable the WAL segment index
+***********************************************************************************************************************************/
+void
+walSegmentIndexEnable(ArchiveMode archiveMode)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(ENUM, archiveMode);
+    FUNCTION_TEST_END();
+
+    if (walSegmentIndex.memContext == NULL)
+    {
+        MEM_CONTEXT_BEGIN(memContextTop())
+        {
+            MEM_CONTEXT_NEW_BEGIN("WalSegmentIndex")
+            {
+                walSegmentIndex.memContext = MEM_CONTEXT_NEW();
+                walSegmentIndex.pathList = lstNew(sizeof(WalSegmentIndexPath));
+            }
+            MEM_CONTEXT_NEW_END();
+        }
+        MEM_CONTEXT_END();
+    }
+
+    walSegmentIndex.archiveMode = archiveMode;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Disable the WAL segment index and free all cached paths
+***********************************************************************************************************************************/
+void
+walSegmentIndexDisable(void)
+{
+    FUNCTION_TEST_VOID();
+
+    if (walSegmentIndex.memContext != NULL)
+    {
+        memContextFree(walSegmentIndex.memContext);
+        walSegmentIndex.memContext = NULL;
+        walSegmentIndex.pathList = NULL;
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Get a path from the index, or NULL if the path has not been loaded
+***********************************************************************************************************************************/
+static WalSegmentIndexPath *
+walSegmentIndexPathGet(const String *path)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, path);
+    FUNCTION_TEST_END();
+
+    ASSERT(walSegmentIndex.memContext != NULL);
+    ASSERT(path != NULL);
+
+    WalSegmentIndexPath *result = NULL;
+
+    for (unsigned int pathIdx = 0; pathIdx < lstSize(walSegmentIndex.pathList); pathIdx++)
+    {
+        WalSegmentIndexPath *indexPath = lstGet(walSegmentIndex.pathList, pathIdx);
+
+        if (strEq(indexPath->path, path))
+        {
+            result = indexPath;
+            break;
+        }
+    }
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Load (or reload) the file list for a path into the index
+***********************************************************************************************************************************/
+static WalSegmentIndexPath *
+walSegmentIndexPathLoad(const Storage *storage, const String *path)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE, storage);
+        FUNCTION_TEST_PARAM(STRING, path);
+    FUNCTION_TEST_END();
+
+    ASSERT(walSegmentIndex.memContext != NULL);
+    ASSERT(storage != NULL);
+    ASSERT(path != NULL);
+
+    WalSegmentIndexPath *result = walSegmentIndexPathGet(path);
+
+    MEM_CONTEXT_BEGIN(lstMemContext(walSegmentIndex.pathList))
+    {
+        // Add the path if it has not been loaded before
+        if (result == NULL)
+        {
+            lstAdd(walSegmentIndex.pathList, &(WalSegmentIndexPath){.path = strDup(path)});
+            result = lstGet(walSegmentIndex.pathList, lstSize(walSegmentIndex.pathList) - 1);
+        }
+        // Else free the old file list
+        else
+            strLstFree(result->fileList);
+
+        result->fileList = storageListP(
+            storage, strNewFmt(STORAGE_REPO_ARCHIVE "/%s", strPtr(path)), .expression = WAL_SEGMENT_INDEX_FILE_REGEXP_STR,
+            .nullOnMissing = true);
+
+        // A missing path is stored as an empty list so it is not listed again
+        if (result->fileList == NULL)
+            result->fileList = strLstNew();
+
+        strLstSort(result->fileList, sortOrderAsc);
+    }
+    MEM_CONTEXT_END();
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Find the index of the first file in a sorted list that is >= the search string
+***********************************************************************************************************************************/
+static unsigned int
+walSegmentIndexLowerBound(const StringList *fileList, const String *search)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING_LIST, fileList);
+        FUNCTION_TEST_PARAM(STRING, search);
+    FUNCTION_TEST_END();
+
+    unsigned int low = 0;
+    unsigned int high = strLstSize(fileList);
+
+    while (low < high)
+    {
+        unsigned int middle = low + (high - low) / 2;
+
+        if (strCmp(strLstGet(fileList, middle), search) < 0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    FUNCTION_TEST_RETURN(low);
+}
+
+/***********************************************************************************************************************************
+Add all files in a sorted list that begin with the prefix to the result list
+***********************************************************************************************************************************/
+static void
+walSegmentIndexMatch(const StringList *fileList, const String *prefix, StringList *result)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING_LIST, fileList);
+        FUNCTION_TEST_PARAM(STRING, prefix);
+        FUNCTION_TEST_PARAM(STRING_LIST, result);
+    FUNCTION_TEST_END();
+
+    for (unsigned int fileIdx = walSegmentIndexLowerBound(fileList, prefix); fileIdx < strLstSize(fileList); fileIdx++)
+    {
+        const String *file = strLstGet(fileList, fileIdx);
+
+        if (!strBeginsWith(file, prefix))
+            break;
+
+        strLstAdd(result, file);
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Find all files in the index that match a WAL segment, loading the path from storage when required
+***********************************************************************************************************************************/
+static StringList *
+walSegmentIndexFind(const Storage *storage, const String *archiveId, const String *walSegment)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE, storage);
+        FUNCTION_TEST_PARAM(STRING, archiveId);
+        FUNCTION_TEST_PARAM(STRING, walSegment);
+    FUNCTION_TEST_END();
+
+    ASSERT(walSegmentIndex.memContext != NULL);
+
+    StringList *result = strLstNew();
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        String *path = strNewFmt("%s/%s", strPtr(archiveId), strPtr(strSubN(walSegment, 0, 16)));
+        WalSegmentIndexPath *indexPath = walSegmentIndexPathGet(path);
+        bool loaded = false;
+
+        // Load the path if it is not already in the index
+        if (indexPath == NULL)
+        {
+            indexPath = walSegmentIndexPathLoad(storage, path);
+            loaded = true;
+        }
+
+        // Matching files are sorted together since they all begin with the segment (and partial extension, if any) followed by -
+        String *prefix = strNewFmt(
+            "%s%s-", strPtr(strSubN(walSegment, 0, 24)), walIsPartial(walSegment) ? WAL_SEGMENT_PARTIAL_EXT : "");
+
+        walSegmentIndexMatch(indexPath->fileList, prefix, result);
+
+        // For archive-get reload the path and search again if the segment was not found in a previously loaded path
+        if (strLstSize(result) == 0 && !loaded && walSegmentIndex.archiveMode == archiveModeGet)
+            walSegmentIndexMatch(walSegmentIndexPathLoad(storage, path)->fileList, prefix, result);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Add a WAL segment file to the index after it has been written to the repository
+
+Only paths that have already been loaded are updated since the file will be found when an unloaded path is listed.
+***********************************************************************************************************************************/
+void
+walSegmentIndexAdd(const String *archiveId, const String *walSegmentFile)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STRING, archiveId);
+        FUNCTION_LOG_PARAM(STRING, walSegmentFile);
+    FUNCTION_LOG_END();
+
+    ASSERT(archiveId != NULL);
+    ASSERT(walSegmentFile != NULL);
+
+    if (walSegmentIndex.memContext != NULL)
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            WalSegmentIndexPath *indexPath = walSegmentIndexPathGet(
+                strNewFmt("%s/%s", strPtr(archiveId), strPtr(strSubN(walSegmentFile, 0, 16))));
+
+            if (indexPath != NULL)
+            {
+                unsigned int fileIdx = walSegmentIndexLowerBound(indexPath->fileList, walSegmentFile);
+
+                if (fileIdx == strLstSize(indexPath->fileList) || !strEq(strLstGet(indexPath->fileList, fileIdx), walSegmentFile))
+                    strLstInsert(indexPath->fileList, fileIdx, walSegmentFile);
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Find a WAL segment in the repository
 
 The file name can have several things appended such as a hash, compression extension, and partial extension so it is possible to
 have multiple files that match the segment, though more than one match is not a good thing.
+
+If the WAL segment index is enabled and there is no timeout then the index is used instead of listing the repository.
 ***********************************************************************************************************************************/
 String *
 walSegmentFind(const Storage *storage, const String *archiveId, const String *walSegment, TimeMSec timeout)
@@ -320,11 +604,21 @@ walSegmentFind(const Storage *storage, const String *archiveId, const String *wa
 
         do
         {
-            // Get a list of all WAL segments that match
-            StringList *list = storageListP(
-                storage, strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strPtr(archiveId), strPtr(strSubN(walSegment, 0, 16))),
-                .expression = strNewFmt("^%s%s-[0-f]{40}(\\.gz){0,1}$", strPtr(strSubN(walSegment, 0, 24)),
-                    walIsPartial(walSegment) ? WAL_SEGMENT_PARTIAL_EXT : ""), .nullOnMissing = true);
+            StringList *list = NULL;
+
+            // Find matching WAL segments in the index when it is enabled
+            if (walSegmentIndex.memContext != NULL && timeout == 0)
+            {
+                list = walSegmentIndexFind(storage, archiveId, walSegment);
+            }
+            // Else get a list of all WAL segments that match
+            else
+            {
+                list = storageListP(
+                    storage, strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strPtr(archiveId), strPtr(strSubN(walSegment, 0, 16))),
+                    .expression = strNewFmt("^%s%s-[0-f]{40}" COMPRESS_EXT_REGEXP "$", strPtr(strSubN(walSegment, 0, 24)),
+                        walIsPartial(walSegment) ? WAL_SEGMENT_PARTIAL_EXT : ""), .nullOnMissing = true);
+            }
 
             // If there are results
             if (list != NULL && strLstSize(list) > 0)
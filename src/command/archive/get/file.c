@@ -6,9 +6,8 @@ Archive Get File
 #include "command/archive/get/file.h"
 #include "command/archive/common.h"
 #include "command/control/common.h"
-#include "common/compress/gzip/common.h"
-#include "common/compress/gzip/decompress.h"
-#include "common/crypto/cipherBlock.h"
+#include "common/compress/helper.h"
+#include "common/crypto/helper.h"
 #include "common/debug.h"
 #include "common/io/filter/group.h"
 #include "common/log.h"
@@ -17,6 +16,173 @@ Archive Get File
 #include "postgres/interface.h"
 #include "storage/helper.h"
 
+/***********************************************************************************************************************************
+Archive get cache
+
+Caches pg_control and archive.info so a local process serving a batch of async archive-get jobs does not reload them for every
+segment.  The cache is only used when it was loaded with the same cipher settings.  Since the stanza may have been upgraded after
+the cache was loaded, a cluster mismatch causes the cache to be reloaded before an error is thrown, and a file that is not found
+causes the cache to be reloaded and the search repeated if the archive history has changed.
+***********************************************************************************************************************************/
+static struct
+{
+    MemContext *memContext;                                         // Mem context for the cache
+    CipherType cipherType;                                          // Cipher type used to load archive.info
+    String *cipherPass;                                             // Cipher passphrase used to load archive.info
+    PgControl controlInfo;                                          // Cached pg_control info
+    InfoArchive *info;                                              // Cached archive info (NULL if not loaded)
+} archiveGetCache;
+
+/***********************************************************************************************************************************
+Enable the archive get cache
+***********************************************************************************************************************************/
+void
+archiveGetCacheEnable(void)
+{
+    FUNCTION_TEST_VOID();
+
+    if (archiveGetCache.memContext == NULL)
+    {
+        MEM_CONTEXT_BEGIN(memContextTop())
+        {
+            MEM_CONTEXT_NEW_BEGIN("ArchiveGetCache")
+            {
+                archiveGetCache.memContext = MEM_CONTEXT_NEW();
+            }
+            MEM_CONTEXT_NEW_END();
+        }
+        MEM_CONTEXT_END();
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Disable the archive get cache and free the cached info
+***********************************************************************************************************************************/
+void
+archiveGetCacheDisable(void)
+{
+    FUNCTION_TEST_VOID();
+
+    if (archiveGetCache.memContext != NULL)
+    {
+        memContextFree(archiveGetCache.memContext);
+        archiveGetCache.memContext = NULL;
+        archiveGetCache.cipherPass = NULL;
+        archiveGetCache.info = NULL;
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Is the cache loaded with the specified cipher settings?
+***********************************************************************************************************************************/
+static bool
+archiveGetCacheValid(CipherType cipherType, const String *cipherPass)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(ENUM, cipherType);
+        FUNCTION_TEST_PARAM(STRING, cipherPass);
+    FUNCTION_TEST_END();
+
+    FUNCTION_TEST_RETURN(
+        archiveGetCache.info != NULL && archiveGetCache.cipherType == cipherType &&
+        (archiveGetCache.cipherPass == NULL ?
+            cipherPass == NULL : cipherPass != NULL && strEq(archiveGetCache.cipherPass, cipherPass)));
+}
+
+/***********************************************************************************************************************************
+Load (or reload) pg_control and archive.info into the cache
+***********************************************************************************************************************************/
+static void
+archiveGetCacheLoad(CipherType cipherType, const String *cipherPass)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(ENUM, cipherType);
+        FUNCTION_TEST_PARAM(STRING, cipherPass);
+    FUNCTION_TEST_END();
+
+    ASSERT(archiveGetCache.memContext != NULL);
+
+    // Free the prior info first so the cache is not left half loaded if the load fails
+    if (archiveGetCache.info != NULL)
+    {
+        infoArchiveFree(archiveGetCache.info);
+        archiveGetCache.info = NULL;
+    }
+
+    strFree(archiveGetCache.cipherPass);
+    archiveGetCache.cipherPass = NULL;
+
+    MEM_CONTEXT_BEGIN(archiveGetCache.memContext)
+    {
+        archiveGetCache.controlInfo = pgControlFromFile(storagePg(), cfgOptionStr(cfgOptPgPath));
+        archiveGetCache.info = infoArchiveNewLoad(storageRepo(), INFO_ARCHIVE_PATH_FILE_STR, cipherType, cipherPass);
+        archiveGetCache.cipherType = cipherType;
+        archiveGetCache.cipherPass = strDup(cipherPass);
+    }
+    MEM_CONTEXT_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Find a WAL file in the archive ids that match the cluster
+***********************************************************************************************************************************/
+static const String *
+archiveGetFind(const String *archiveFile, PgControl controlInfo, const InfoArchive *info, String **archiveId)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, archiveFile);
+        FUNCTION_TEST_PARAM(PG_CONTROL, controlInfo);
+        FUNCTION_TEST_PARAM(INFO_ARCHIVE, info);
+        FUNCTION_TEST_PARAM_PP(VOID, archiveId);
+    FUNCTION_TEST_END();
+
+    ASSERT(archiveFile != NULL);
+    ASSERT(info != NULL);
+    ASSERT(archiveId != NULL);
+
+    const String *result = NULL;
+    *archiveId = NULL;
+
+    // Loop through the pg history in case the WAL we need is not in the most recent archive id
+    for (unsigned int pgIdx = 0; pgIdx < infoPgDataTotal(infoArchivePg(info)); pgIdx++)
+    {
+        InfoPgData pgData = infoPgData(infoArchivePg(info), pgIdx);
+
+        // Only use the archive id if it matches the current cluster
+        if (pgData.systemId == controlInfo.systemId && pgData.version == controlInfo.version)
+        {
+            *archiveId = infoPgArchiveId(infoArchivePg(info), pgIdx);
+
+            // If a WAL segment search among the possible file names
+            if (walIsSegment(archiveFile))
+            {
+                String *walSegmentFile = walSegmentFind(storageRepo(), *archiveId, archiveFile, 0);
+
+                if (walSegmentFile != NULL)
+                {
+                    result = strNewFmt("%s/%s", strPtr(strSubN(archiveFile, 0, 16)), strPtr(walSegmentFile));
+                    break;
+                }
+            }
+            // Else if not a WAL segment, see if it exists in the archive dir
+            else if (
+                storageExistsNP(
+                    storageRepo(), strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strPtr(*archiveId), strPtr(archiveFile))))
+            {
+                result = archiveFile;
+                break;
+            }
+        }
+    }
+
+    FUNCTION_TEST_RETURN(result);
+}
+
 /***********************************************************************************************************************************
 Check if a WAL file exists in the repository
 ***********************************************************************************************************************************/
@@ -46,44 +212,46 @@ archiveGetCheck(const String *archiveFile, CipherType cipherType, const String *
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        // Get pg control info
-        PgControl controlInfo = pgControlFromFile(storagePg(), cfgOptionStr(cfgOptPgPath));
+        PgControl controlInfo = {0};
+        const InfoArchive *info = NULL;
+        bool cached = false;
 
-        // Attempt to load the archive info file
-        InfoArchive *info = infoArchiveNewLoad(storageRepo(), INFO_ARCHIVE_PATH_FILE_STR, cipherType, cipherPass);
+        // Use the cache when enabled, loading it if it is empty or was loaded with different cipher settings
+        if (archiveGetCache.memContext != NULL)
+        {
+            cached = archiveGetCacheValid(cipherType, cipherPass);
 
-        // Loop through the pg history in case the WAL we need is not in the most recent archive id
-        String *archiveId = NULL;
-        const String *archiveFileActual = NULL;
+            if (!cached)
+                archiveGetCacheLoad(cipherType, cipherPass);
 
-        for (unsigned int pgIdx = 0; pgIdx < infoPgDataTotal(infoArchivePg(info)); pgIdx++)
+            controlInfo = archiveGetCache.controlInfo;
+            info = archiveGetCache.info;
+        }
+        // Else load pg_control and archive info
+        else
         {
-            InfoPgData pgData = infoPgData(infoArchivePg(info), pgIdx);
+            controlInfo = pgControlFromFile(storagePg(), cfgOptionStr(cfgOptPgPath));
+            info = infoArchiveNewLoad(storageRepo(), INFO_ARCHIVE_PATH_FILE_STR, cipherType, cipherPass);
+        }
 
-            // Only use the archive id if it matches the current cluster
-            if (pgData.systemId == controlInfo.systemId && pgData.version == controlInfo.version)
-            {
-                archiveId = infoPgArchiveId(infoArchivePg(info), pgIdx);
+        String *archiveId = NULL;
+        const String *archiveFileActual = archiveGetFind(archiveFile, controlInfo, info, &archiveId);
 
-                // If a WAL segment search among the possible file names
-                if (walIsSegment(archiveFile))
-                {
-                    String *walSegmentFile = walSegmentFind(storageRepo(), archiveId, archiveFile, 0);
+        // If the cached info did not produce a result then it may be stale, so reload it.  Search again on a mismatch or if the
+        // archive history or cluster has changed -- otherwise the result would be the same.
+        if (cached && archiveFileActual == NULL)
+        {
+            unsigned int pgDataTotal = infoPgDataTotal(infoArchivePg(info));
 
-                    if (walSegmentFile != NULL)
-                    {
-                        archiveFileActual = strNewFmt("%s/%s", strPtr(strSubN(archiveFile, 0, 16)), strPtr(walSegmentFile));
-                        break;
-                    }
-                }
-                // Else if not a WAL segment, see if it exists in the archive dir
-                else if (
-                    storageExistsNP(
-                        storageRepo(), strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strPtr(archiveId), strPtr(archiveFile))))
-                {
-                    archiveFileActual = archiveFile;
-                    break;
-                }
+            archiveGetCacheLoad(cipherType, cipherPass);
+
+            if (archiveId == NULL || infoPgDataTotal(infoArchivePg(archiveGetCache.info)) != pgDataTotal ||
+                archiveGetCache.controlInfo.systemId != controlInfo.systemId ||
+                archiveGetCache.controlInfo.version != controlInfo.version)
+            {
+                controlInfo = archiveGetCache.controlInfo;
+                info = archiveGetCache.info;
+                archiveFileActual = archiveGetFind(archiveFile, controlInfo, info, &archiveId);
             }
         }
 
@@ -137,7 +305,7 @@ archiveGetFile(
     // Test for stop file
     lockStopTest();
 
-    MEM_CONTEXT_TEMP_BEGIN()
+    MEM_CONTEXT_TEMP_ARENA_BEGIN()
     {
         // Make sure the file exists and other checks pass
         ArchiveGetCheckResult archiveGetCheckResult = archiveGetCheck(archiveFile, cipherType, cipherPass);
@@ -152,15 +320,17 @@ archiveGetFile(
             if (cipherType != cipherTypeNone)
             {
                 ioFilterGroupAdd(
-                    ioWriteFilterGroup(storageWriteIo(destination)), cipherBlockNew(cipherModeDecrypt, cipherType,
-                        BUFSTR(archiveGetCheckResult.cipherPass), NULL));
+                    ioWriteFilterGroup(storageWriteIo(destination)), cipherFilter(cipherModeDecrypt, cipherType,
+                        BUFSTR(archiveGetCheckResult.cipherPass), 1));
                 compressible = false;
             }
 
             // If file is compressed then add the decompression filter
-            if (strEndsWithZ(archiveGetCheckResult.archiveFileActual, "." GZIP_EXT))
+            CompressType compressType = compressTypeFromName(archiveGetCheckResult.archiveFileActual);
+
+            if (compressType != compressTypeNone)
             {
-                ioFilterGroupAdd(ioWriteFilterGroup(storageWriteIo(destination)), gzipDecompressNew(false));
+                ioFilterGroupAdd(ioWriteFilterGroup(storageWriteIo(destination)), decompressFilter(compressType));
                 compressible = false;
             }
 
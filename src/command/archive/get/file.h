@@ -15,4 +15,7 @@ int archiveGetFile(
     const Storage *storage, const String *archiveFile, const String *walDestination, bool durable, CipherType cipherType,
     const String *cipherPass);
 
+void archiveGetCacheDisable(void);
+void archiveGetCacheEnable(void);
+
 #endif
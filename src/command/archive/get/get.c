@@ -18,6 +18,7 @@ Archive Get Command
 #include "common/log.h"
 #include "common/memContext.h"
 #include "common/regExp.h"
+#include "common/time.h"
 #include "common/wait.h"
 #include "config/config.h"
 #include "config/exec.h"
@@ -99,6 +100,130 @@ queueNeed(const String *walSegment, bool found, uint64_t queueSize, size_t walSe
     FUNCTION_LOG_RETURN(STRING_LIST, result);
 }
 
+/***********************************************************************************************************************************
+Size the queue when streaming
+
+The queue should hold the WAL segments that PostgreSQL will replay while the queue is being refilled.  Since the queue is refilled
+when it is half empty that number is doubled.  Until the replay time is known the maximum queue size is used.
+***********************************************************************************************************************************/
+static unsigned int
+queueWindow(unsigned int windowMax, TimeMSec replayTime, TimeMSec fetchTime)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(UINT, windowMax);
+        FUNCTION_TEST_PARAM(TIME_MSEC, replayTime);
+        FUNCTION_TEST_PARAM(TIME_MSEC, fetchTime);
+    FUNCTION_TEST_END();
+
+    ASSERT(windowMax >= 2);
+
+    unsigned int result = windowMax;
+
+    if (replayTime > 0 && (fetchTime / replayTime + 1) * 2 < windowMax)
+        result = (unsigned int)((fetchTime / replayTime + 1) * 2);
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Wait for PostgreSQL to replay WAL segments from the queue and return the WAL segments needed to refill it
+
+An empty list is returned if no WAL segment was replayed from the queue for half of archive-timeout, e.g. replay is paused or
+PostgreSQL is requesting WAL that does not follow the queue.  Exiting allows archive-get to start a new async process when needed.
+***********************************************************************************************************************************/
+#define ARCHIVE_GET_STREAM_SLEEP_MSEC                               100
+
+typedef struct ArchiveGetStream
+{
+    size_t walSegmentSize;                                          // WAL segment size
+    unsigned int pgVersion;                                         // PostgreSQL version
+    unsigned int windowMax;                                         // Maximum WAL segments in the queue
+    StringList *queueList;                                          // WAL segments in the queue that have not been replayed
+    String *walSegmentLast;                                         // Last WAL segment requested
+    TimeMSec replayTime;                                            // Average time to replay a WAL segment (0 when unknown)
+    TimeMSec replayLast;                                            // Time the last WAL segment was replayed
+    TimeMSec fetchTime;                                             // Time taken by the last fetch
+} ArchiveGetStream;
+
+static StringList *
+queueStreamNext(ArchiveGetStream *stream)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM_P(VOID, stream);
+    FUNCTION_LOG_END();
+
+    ASSERT(stream != NULL);
+    ASSERT(stream->queueList != NULL);
+    ASSERT(stream->walSegmentLast != NULL);
+
+    StringList *result = strLstNew();
+    TimeMSec idleBegin = timeMSec();
+    TimeMSec idleMax = (TimeMSec)(cfgOptionDbl(cfgOptArchiveTimeout) * MSEC_PER_SEC) / 2;
+
+    do
+    {
+        bool done = false;
+
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            StringList *actualQueue = storageListP(
+                storageSpool(), STORAGE_SPOOL_ARCHIVE_IN_STR, .expression = WAL_SEGMENT_REGEXP_STR, .errorOnMissing = true);
+
+            // WAL segments that are no longer in the queue have been replayed
+            StringList *queueList = strLstNew();
+
+            for (unsigned int queueIdx = 0; queueIdx < strLstSize(stream->queueList); queueIdx++)
+            {
+                if (strLstExists(actualQueue, strLstGet(stream->queueList, queueIdx)))
+                    strLstAdd(queueList, strLstGet(stream->queueList, queueIdx));
+            }
+
+            unsigned int replayTotal = strLstSize(stream->queueList) - strLstSize(queueList);
+            TimeMSec timeNow = timeMSec();
+
+            // Update the average replay time
+            if (replayTotal > 0)
+            {
+                TimeMSec replayTime = (timeNow - stream->replayLast) / replayTotal;
+
+                stream->replayTime = stream->replayTime == 0 ? replayTime : (stream->replayTime * 3 + replayTime) / 4;
+                stream->replayLast = timeNow;
+                idleBegin = timeNow;
+            }
+
+            strLstFree(stream->queueList);
+            stream->queueList = strLstMove(queueList, MEM_CONTEXT_OLD());
+
+            // Refill the queue when it is half empty
+            unsigned int window = queueWindow(stream->windowMax, stream->replayTime, stream->fetchTime);
+
+            if (strLstSize(actualQueue) <= window / 2)
+            {
+                StringList *walSegmentList = walSegmentRange(
+                    walSegmentNext(stream->walSegmentLast, stream->walSegmentSize, stream->pgVersion), stream->walSegmentSize,
+                    stream->pgVersion, window - strLstSize(actualQueue));
+
+                for (unsigned int walSegmentIdx = 0; walSegmentIdx < strLstSize(walSegmentList); walSegmentIdx++)
+                    strLstAdd(result, strLstGet(walSegmentList, walSegmentIdx));
+
+                done = true;
+            }
+            // Else stop when replay has stalled
+            else if (timeNow - idleBegin >= idleMax)
+                done = true;
+        }
+        MEM_CONTEXT_TEMP_END();
+
+        if (done)
+            break;
+
+        sleepMSec(ARCHIVE_GET_STREAM_SLEEP_MSEC);
+    }
+    while (true);
+
+    FUNCTION_LOG_RETURN(STRING_LIST, result);
+}
+
 /***********************************************************************************************************************************
 Get an archive file from the repository (WAL segment, history file, etc.)
 ***********************************************************************************************************************************/
@@ -296,75 +421,129 @@ cmdArchiveGetAsync(void)
         TRY_BEGIN()
         {
             // Check the parameters
-            const StringList *walSegmentList = cfgCommandParam();
+            StringList *walSegmentList = strLstDup(cfgCommandParam());
 
             if (strLstSize(walSegmentList) < 1)
                 THROW(ParamInvalidError, "at least one wal segment is required");
 
-            LOG_INFO(
-                "get %u WAL file(s) from archive: %s%s", strLstSize(walSegmentList), strPtr(strLstGet(walSegmentList, 0)),
-                strLstSize(walSegmentList) == 1 ?
-                    "" : strPtr(strNewFmt("...%s", strPtr(strLstGet(walSegmentList, strLstSize(walSegmentList) - 1)))));
-
-            // Create the parallel executor
-            ProtocolParallel *parallelExec = protocolParallelNew(
-                (TimeMSec)(cfgOptionDbl(cfgOptProtocolTimeout) * MSEC_PER_SEC) / 2);
-
-            for (unsigned int processIdx = 1; processIdx <= cfgOptionUInt(cfgOptProcessMax); processIdx++)
-                protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypeRepo, processIdx));
+            // When streaming, WAL segments are fetched into the queue as PostgreSQL replays them
+            ArchiveGetStream stream = {0};
 
-            // Queue jobs in executor
-            for (unsigned int walSegmentIdx = 0; walSegmentIdx < strLstSize(walSegmentList); walSegmentIdx++)
+            if (cfgOptionBool(cfgOptArchiveGetStream))
             {
-                const String *walSegment = strLstGet(walSegmentList, walSegmentIdx);
+                PgControl pgControl = pgControlFromFile(storagePg(), cfgOptionStr(cfgOptPgPath));
 
-                ProtocolCommand *command = protocolCommandNew(PROTOCOL_COMMAND_ARCHIVE_GET_STR);
-                protocolCommandParamAdd(command, VARSTR(walSegment));
+                stream.walSegmentSize = pgControl.walSegmentSize;
+                stream.pgVersion = pgControl.version;
+                stream.windowMax = (unsigned int)(cfgOptionUInt64(cfgOptArchiveGetQueueMax) / pgControl.walSegmentSize);
+                stream.queueList = strLstNew();
+                stream.replayLast = timeMSec();
 
-                protocolParallelJobAdd(parallelExec, protocolParallelJobNew(VARSTR(walSegment), command));
+                // The queue total must be at least 2 (see queueNeed())
+                if (stream.windowMax < 2)
+                    stream.windowMax = 2;
             }
 
-            // Process jobs
+            // Local processes use the batch id to reset cached repo state when a new batch starts
+            unsigned int batchId = 0;
+
             do
             {
-                unsigned int completed = protocolParallelProcess(parallelExec);
+                // Stop after this batch unless streaming and all WAL segments were found
+                bool done = !cfgOptionBool(cfgOptArchiveGetStream);
+                batchId++;
+                TimeMSec fetchBegin = timeMSec();
 
-                for (unsigned int jobIdx = 0; jobIdx < completed; jobIdx++)
+                MEM_CONTEXT_TEMP_BEGIN()
                 {
-                    // Get the job and job key
-                    ProtocolParallelJob *job = protocolParallelResult(parallelExec);
-                    unsigned int processId = protocolParallelJobProcessId(job);
-                    const String *walSegment = varStr(protocolParallelJobKey(job));
+                    LOG_INFO(
+                        "get %u WAL file(s) from archive: %s%s", strLstSize(walSegmentList), strPtr(strLstGet(walSegmentList, 0)),
+                        strLstSize(walSegmentList) == 1 ?
+                            "" : strPtr(strNewFmt("...%s", strPtr(strLstGet(walSegmentList, strLstSize(walSegmentList) - 1)))));
+
+                    // Create the parallel executor.  Local processes are reused by each batch.
+                    ProtocolParallel *parallelExec = protocolParallelNew(
+                        (TimeMSec)(cfgOptionDbl(cfgOptProtocolTimeout) * MSEC_PER_SEC) / 2, cfgOptionUInt(cfgOptProtocolPipeline));
+
+                    for (unsigned int processIdx = 1; processIdx <= cfgOptionUInt(cfgOptProcessMax); processIdx++)
+                        protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypeRepo, processIdx));
 
-                    // The job was successful
-                    if (protocolParallelJobErrorCode(job) == 0)
+                    // Queue jobs in executor
+                    for (unsigned int walSegmentIdx = 0; walSegmentIdx < strLstSize(walSegmentList); walSegmentIdx++)
                     {
-                        // Get the archive file
-                        if (varIntForce(protocolParallelJobResult(job)) == 0)
-                        {
-                            LOG_DETAIL_PID(processId, "found %s in the archive", strPtr(walSegment));
-                        }
-                        // If it does not exist write an ok file to indicate that it was checked
-                        else
-                        {
-                            LOG_DETAIL_PID(processId, "unable to find %s in the archive", strPtr(walSegment));
-                            archiveAsyncStatusOkWrite(archiveModeGet, walSegment, NULL);
-                        }
+                        const String *walSegment = strLstGet(walSegmentList, walSegmentIdx);
+
+                        ProtocolCommand *command = protocolCommandNew(PROTOCOL_COMMAND_ARCHIVE_GET_STR);
+                        protocolCommandParamAdd(command, VARSTR(walSegment));
+                        protocolCommandParamAdd(command, VARUINT(batchId));
+
+                        protocolParallelJobAdd(parallelExec, protocolParallelJobNew(VARSTR(walSegment), command));
                     }
-                    // Else the job errored
-                    else
+
+                    // Process jobs
+                    do
                     {
-                        LOG_WARN_PID(
-                            processId,
-                            "could not get %s from the archive (will be retried): [%d] %s", strPtr(walSegment),
-                            protocolParallelJobErrorCode(job), strPtr(protocolParallelJobErrorMessage(job)));
+                        unsigned int completed = protocolParallelProcess(parallelExec);
 
-                        archiveAsyncStatusErrorWrite(
-                            archiveModeGet, walSegment, protocolParallelJobErrorCode(job), protocolParallelJobErrorMessage(job));
+                        for (unsigned int jobIdx = 0; jobIdx < completed; jobIdx++)
+                        {
+                            // Get the job and job key
+                            ProtocolParallelJob *job = protocolParallelResult(parallelExec);
+                            unsigned int processId = protocolParallelJobProcessId(job);
+                            const String *walSegment = varStr(protocolParallelJobKey(job));
+
+                            // The job was successful
+                            if (protocolParallelJobErrorCode(job) == 0)
+                            {
+                                // Get the archive file
+                                if (varIntForce(protocolParallelJobResult(job)) == 0)
+                                {
+                                    LOG_DETAIL_PID(processId, "found %s in the archive", strPtr(walSegment));
+
+                                    if (stream.queueList != NULL)
+                                        strLstAdd(stream.queueList, walSegment);
+                                }
+                                // If it does not exist write an ok file to indicate that it was checked
+                                else
+                                {
+                                    LOG_DETAIL_PID(processId, "unable to find %s in the archive", strPtr(walSegment));
+                                    archiveAsyncStatusOkWrite(archiveModeGet, walSegment, NULL);
+                                    done = true;
+                                }
+                            }
+                            // Else the job errored
+                            else
+                            {
+                                LOG_WARN_PID(
+                                    processId,
+                                    "could not get %s from the archive (will be retried): [%d] %s", strPtr(walSegment),
+                                    protocolParallelJobErrorCode(job), strPtr(protocolParallelJobErrorMessage(job)));
+
+                                archiveAsyncStatusErrorWrite(
+                                    archiveModeGet, walSegment, protocolParallelJobErrorCode(job),
+                                    protocolParallelJobErrorMessage(job));
+                                done = true;
+                            }
+                        }
                     }
+                    while (!protocolParallelDone(parallelExec));
+
+                    protocolParallelFree(parallelExec);
                 }
+                MEM_CONTEXT_TEMP_END();
+
+                if (done)
+                    break;
+
+                // Wait for PostgreSQL to replay WAL from the queue and get the WAL segments needed to refill it
+                stream.fetchTime = timeMSec() - fetchBegin;
+                strFree(stream.walSegmentLast);
+                stream.walSegmentLast = strDup(strLstGet(walSegmentList, strLstSize(walSegmentList) - 1));
+
+                strLstFree(walSegmentList);
+                walSegmentList = queueStreamNext(&stream);
             }
-            while (!protocolParallelDone(parallelExec));
+            while (strLstSize(walSegmentList) > 0);
         }
         // On any global error write a single error file to cover all unprocessed files
         CATCH_ANY()
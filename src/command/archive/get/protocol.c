@@ -3,6 +3,7 @@ Archive Get Protocol Handler
 ***********************************************************************************************************************************/
 #include "build.auto.h"
 
+#include "command/archive/common.h"
 #include "command/archive/get/file.h"
 #include "command/archive/get/protocol.h"
 #include "common/debug.h"
@@ -17,6 +18,14 @@ Constants
 ***********************************************************************************************************************************/
 STRING_EXTERN(PROTOCOL_COMMAND_ARCHIVE_GET_STR,                     PROTOCOL_COMMAND_ARCHIVE_GET);
 
+/***********************************************************************************************************************************
+Local variables
+***********************************************************************************************************************************/
+static struct
+{
+    unsigned int batchId;                                           // Async batch currently being served
+} archiveGetProtocolLocal;
+
 /***********************************************************************************************************************************
 Process protocol requests
 ***********************************************************************************************************************************/
@@ -41,7 +50,22 @@ archiveGetProtocol(const String *command, const VariantList *paramList, Protocol
     {
         if (strEq(command, PROTOCOL_COMMAND_ARCHIVE_GET_STR))
         {
+            // The WAL segment index avoids a repo list per segment and pg_control/archive.info are cached rather than loaded per
+            // segment.  When streaming, the local process is reused by each batch of the async process so the cached state is reset
+            // when a new batch starts rather than being kept for the life of the process.
             const String *walSegment = varStr(varLstGet(paramList, 0));
+            unsigned int batchId = varUIntForce(varLstGet(paramList, 1));
+
+            if (batchId != archiveGetProtocolLocal.batchId)
+            {
+                walSegmentIndexDisable();
+                archiveGetCacheDisable();
+
+                archiveGetProtocolLocal.batchId = batchId;
+            }
+
+            walSegmentIndexEnable(archiveModeGet);
+            archiveGetCacheEnable();
 
             protocolServerResponse(
                 server,
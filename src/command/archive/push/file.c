@@ -6,10 +6,8 @@ Archive Push File
 #include "command/archive/push/file.h"
 #include "command/archive/common.h"
 #include "command/control/common.h"
-#include "common/compress/gzip/common.h"
-#include "common/compress/gzip/compress.h"
-#include "common/crypto/cipherBlock.h"
 #include "common/crypto/hash.h"
+#include "common/crypto/helper.h"
 #include "common/debug.h"
 #include "common/io/filter/group.h"
 #include "common/io/io.h"
@@ -17,6 +15,7 @@ Archive Push File
 #include "config/config.h"
 #include "postgres/interface.h"
 #include "storage/helper.h"
+#include "storage/write.h"
 
 /***********************************************************************************************************************************
 Copy a file from the source to the archive
@@ -24,7 +23,7 @@ Copy a file from the source to the archive
 String *
 archivePushFile(
     const String *walSource, const String *archiveId, unsigned int pgVersion, uint64_t pgSystemId, const String *archiveFile,
-    CipherType cipherType, const String *cipherPass, bool compress, int compressLevel)
+    CipherType cipherType, const String *cipherPass, CompressType compressType, int compressLevel)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, walSource);
@@ -34,7 +33,7 @@ archivePushFile(
         FUNCTION_LOG_PARAM(STRING, archiveFile);
         FUNCTION_LOG_PARAM(ENUM, cipherType);
         FUNCTION_TEST_PARAM(STRING, cipherPass);
-        FUNCTION_LOG_PARAM(BOOL, compress);
+        FUNCTION_LOG_PARAM(ENUM, compressType);
         FUNCTION_LOG_PARAM(INT, compressLevel);
     FUNCTION_LOG_END();
 
@@ -44,7 +43,7 @@ archivePushFile(
 
     String *result = NULL;
 
-    MEM_CONTEXT_TEMP_BEGIN()
+    MEM_CONTEXT_TEMP_ARENA_BEGIN()
     {
         // Is this a WAL segment?
         bool isSegment = walIsSegment(archiveFile);
@@ -67,21 +66,29 @@ archivePushFile(
         // Set archive destination initially to the archive file, this will be updated later for wal segments
         String *archiveDestination = strDup(archiveFile);
 
-        // Get wal segment checksum and compare it to what exists in the repo, if any
+        // Check if the wal segment already exists in the repo.  This is done before reading the source so the source only needs to
+        // be read once when it already exists -- to compare checksums with the existing segment.
         String *walSegmentFile = NULL;
 
         if (isSegment)
+            walSegmentFile = walSegmentFind(storageRepo(), archiveId, archiveFile, 0);
+
+        // The destination name of a wal segment depends on the checksum of the source.  If the repo can move files then the source
+        // is read once and streamed to a temp file that is moved to the final name when the checksum is known.  Otherwise the
+        // checksum is calculated before the copy so the copy can be streamed directly to the final name.
+        bool repoMove = storageFeature(storageRepoWrite(), storageFeatureMove);
+        const String *walSegmentChecksum = NULL;
+
+        if (isSegment && (walSegmentFile != NULL || !repoMove))
         {
-            // Generate a sha1 checksum for the wal segment
-            IoRead *read = storageReadIo(storageNewReadNP(storageLocal(), walSource));
-            ioFilterGroupAdd(ioReadFilterGroup(read), cryptoHashNew(HASH_TYPE_SHA1_STR));
-            ioReadDrain(read);
+            StorageRead *source = storageNewReadNP(storageLocal(), walSource);
+            IoFilterGroup *filterGroup = ioReadFilterGroup(storageReadIo(source));
+            ioFilterGroupAdd(filterGroup, cryptoHashNew(HASH_TYPE_SHA1_STR));
+            ioReadDrain(storageReadIo(source));
 
-            const String *walSegmentChecksum = varStr(ioFilterGroupResult(ioReadFilterGroup(read), CRYPTO_HASH_FILTER_TYPE_STR));
+            walSegmentChecksum = varStr(ioFilterGroupResult(filterGroup, CRYPTO_HASH_FILTER_TYPE_STR));
 
             // If the wal segment already exists in the repo then compare checksums
-            walSegmentFile = walSegmentFind(storageRepo(), archiveId, archiveFile, 0);
-
             if (walSegmentFile != NULL)
             {
                 String *walSegmentRepoChecksum = strSubN(walSegmentFile, strSize(archiveFile) + 1, HASH_TYPE_SHA1_SIZE_HEX);
@@ -98,42 +105,76 @@ archivePushFile(
                 else
                     THROW_FMT(ArchiveDuplicateError, "WAL file '%s' already exists in the archive", strPtr(archiveFile));
             }
-
-            // Append the checksum to the archive destination
-            strCatFmt(archiveDestination, "-%s", strPtr(walSegmentChecksum));
         }
 
         // Only copy if the file was not found in the archive
         if (walSegmentFile == NULL)
         {
             StorageRead *source = storageNewReadNP(storageLocal(), walSource);
+            IoFilterGroup *filterGroup = ioReadFilterGroup(storageReadIo(source));
+
+            // Calculate the checksum during the copy if it was not calculated already
+            if (isSegment && walSegmentChecksum == NULL)
+                ioFilterGroupAdd(filterGroup, cryptoHashNew(HASH_TYPE_SHA1_STR));
 
             // Is the file compressible during the copy?
             bool compressible = true;
 
             // If the file will be compressed then add compression filter
-            if (isSegment && compress)
+            if (isSegment && compressType != compressTypeNone)
             {
-                strCat(archiveDestination, "." GZIP_EXT);
-                ioFilterGroupAdd(ioReadFilterGroup(storageReadIo(source)), gzipCompressNew(compressLevel, false));
+                ioFilterGroupAdd(filterGroup, compressFilter(compressType, compressLevel, 1));
                 compressible = false;
             }
 
             // If there is a cipher then add the encrypt filter
             if (cipherType != cipherTypeNone)
             {
-                ioFilterGroupAdd(
-                    ioReadFilterGroup(storageReadIo(source)),
-                    cipherBlockNew(cipherModeEncrypt, cipherType, BUFSTR(cipherPass), NULL));
+                ioFilterGroupAdd(filterGroup, cipherFilter(cipherModeEncrypt, cipherType, BUFSTR(cipherPass), 1));
                 compressible = false;
             }
 
-            // Copy the file
+            // Append the checksum and compression extension to the archive destination if the checksum is known
+            if (isSegment && walSegmentChecksum != NULL)
+            {
+                strCatFmt(archiveDestination, "-%s", strPtr(walSegmentChecksum));
+                compressExtCat(archiveDestination, compressType);
+            }
+
+            // Copy to a temp file if the checksum is not known yet
+            const String *archiveCopy = archiveDestination;
+            bool archiveTemp = isSegment && walSegmentChecksum == NULL;
+
+            if (archiveTemp)
+                archiveCopy = strNewFmt("%s." STORAGE_FILE_TEMP_EXT, strPtr(archiveDestination));
+
+            // The temp file is not written atomically and its path is not synced since it will be moved
             storageCopyNP(
                 source,
                 storageNewWriteP(
-                    storageRepoWrite(), strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strPtr(archiveId), strPtr(archiveDestination)),
-                .compressible = compressible));
+                    storageRepoWrite(), strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strPtr(archiveId), strPtr(archiveCopy)),
+                    .compressible = compressible, .noAtomic = archiveTemp, .noSyncPath = archiveTemp));
+
+            // Move the temp file to the final name now that the checksum is known
+            if (archiveTemp)
+            {
+                walSegmentChecksum = varStr(ioFilterGroupResult(filterGroup, CRYPTO_HASH_FILTER_TYPE_STR));
+
+                strCatFmt(archiveDestination, "-%s", strPtr(walSegmentChecksum));
+                compressExtCat(archiveDestination, compressType);
+
+                storageMoveNP(
+                    storageRepoWrite(),
+                    storageNewReadNP(
+                        storageRepoWrite(), strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strPtr(archiveId), strPtr(archiveCopy))),
+                    storageNewWriteNP(
+                        storageRepoWrite(),
+                        strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strPtr(archiveId), strPtr(archiveDestination))));
+            }
+
+            // Add the segment to the index so later lookups in this process will find it
+            if (isSegment)
+                walSegmentIndexAdd(archiveId, archiveDestination);
         }
     }
     MEM_CONTEXT_TEMP_END();
@@ -3,6 +3,7 @@ Archive Push Protocol Handler
 ***********************************************************************************************************************************/
 #include "build.auto.h"
 
+#include "command/archive/common.h"
 #include "command/archive/push/file.h"
 #include "command/archive/push/protocol.h"
 #include "common/debug.h"
@@ -17,6 +18,14 @@ Constants
 ***********************************************************************************************************************************/
 STRING_EXTERN(PROTOCOL_COMMAND_ARCHIVE_PUSH_STR,                     PROTOCOL_COMMAND_ARCHIVE_PUSH);
 
+/***********************************************************************************************************************************
+Local variables
+***********************************************************************************************************************************/
+static struct
+{
+    unsigned int batchId;                                           // Async batch currently being served
+} archivePushProtocolLocal;
+
 /***********************************************************************************************************************************
 Process protocol requests
 ***********************************************************************************************************************************/
@@ -41,6 +50,19 @@ archivePushProtocol(const String *command, const VariantList *paramList, Protoco
     {
         if (strEq(command, PROTOCOL_COMMAND_ARCHIVE_PUSH_STR))
         {
+            // The WAL segment index avoids a repo list per segment.  In push mode the index does not see segments pushed by other
+            // processes after a path is loaded, so it is reset when a new batch starts since the local process is reused by each
+            // batch of the async process when streaming.
+            unsigned int batchId = varUIntForce(varLstGet(paramList, 9));
+
+            if (batchId != archivePushProtocolLocal.batchId)
+            {
+                walSegmentIndexDisable();
+                archivePushProtocolLocal.batchId = batchId;
+            }
+
+            walSegmentIndexEnable(archiveModePush);
+
             protocolServerResponse(
                 server,
                 VARSTR(
@@ -48,7 +70,7 @@ archivePushProtocol(const String *command, const VariantList *paramList, Protoco
                         varStr(varLstGet(paramList, 0)), varStr(varLstGet(paramList, 1)),
                         varUIntForce(varLstGet(paramList, 2)), varUInt64(varLstGet(paramList, 3)), varStr(varLstGet(paramList, 4)),
                         (CipherType)varUIntForce(varLstGet(paramList, 5)), varStr(varLstGet(paramList, 6)),
-                        varBool(varLstGet(paramList, 7)), varIntForce(varLstGet(paramList, 8)))));
+                        (CompressType)varUIntForce(varLstGet(paramList, 7)), varIntForce(varLstGet(paramList, 8)))));
         }
         else
             found = false;
@@ -3,9 +3,15 @@ Archive Push Command
 ***********************************************************************************************************************************/
 #include "build.auto.h"
 
+#include <errno.h>
+#include <poll.h>
 #include <string.h>
 #include <unistd.h>
 
+#ifdef __linux__
+    #include <sys/inotify.h>
+#endif
+
 #include "command/archive/common.h"
 #include "command/archive/push/file.h"
 #include "command/archive/push/protocol.h"
@@ -15,6 +21,7 @@ Archive Push Command
 #include "common/fork.h"
 #include "common/log.h"
 #include "common/memContext.h"
+#include "common/time.h"
 #include "common/wait.h"
 #include "config/config.h"
 #include "config/exec.h"
@@ -30,6 +37,18 @@ Ready file extension constants
 #define STATUS_EXT_READY                                            ".ready"
 #define STATUS_EXT_READY_SIZE                                       (sizeof(STATUS_EXT_READY) - 1)
 
+/***********************************************************************************************************************************
+Get the compression type for pushed files from the compress options
+***********************************************************************************************************************************/
+static CompressType
+archivePushCompressType(void)
+{
+    FUNCTION_TEST_VOID();
+
+    FUNCTION_TEST_RETURN(
+        cfgOptionBool(cfgOptCompress) ? compressType(cfgOptionStr(cfgOptCompressType)) : compressTypeNone);
+}
+
 /***********************************************************************************************************************************
 Format the warning when a file is dropped
 ***********************************************************************************************************************************/
@@ -246,6 +265,169 @@ archivePushCheck(CipherType cipherType, const String *cipherPass)
     FUNCTION_LOG_RETURN(ARCHIVE_PUSH_CHECK_RESULT, result);
 }
 
+/***********************************************************************************************************************************
+Watch archive_status for new ready files when streaming
+
+On Linux inotify is used so WAL can be pushed as soon as it is ready.  If inotify is not available then -1 is returned and the wait
+just sleeps, so archive_status is listed at a regular interval instead.
+***********************************************************************************************************************************/
+#define ARCHIVE_PUSH_STREAM_POLL_MSEC                               1000
+
+static int
+archivePushWatchNew(const String *walPath)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STRING, walPath);
+    FUNCTION_LOG_END();
+
+    ASSERT(walPath != NULL);
+
+    int result = -1;
+
+#ifdef __linux__
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        result = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+        // Ready files are created by PostgreSQL so watch for new and closed files
+        if (result != -1 &&
+            inotify_add_watch(
+                result, strPtr(storagePathNP(storagePg(), strNewFmt("%s/" PG_PATH_ARCHIVE_STATUS, strPtr(walPath)))),
+                IN_CREATE | IN_CLOSE_WRITE | IN_MOVED_TO) == -1)
+        {
+            close(result);
+            result = -1;
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+#endif
+
+    FUNCTION_LOG_RETURN(INT, result);
+}
+
+static void
+archivePushWatchWait(int watchHandle, TimeMSec timeout)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(INT, watchHandle);
+        FUNCTION_LOG_PARAM(TIME_MSEC, timeout);
+    FUNCTION_LOG_END();
+
+    if (watchHandle == -1)
+        sleepMSec(timeout);
+    else
+    {
+        struct pollfd watchPoll = {.fd = watchHandle, .events = POLLIN};
+
+        THROW_ON_SYS_ERROR(
+            poll(&watchPoll, 1, (int)timeout) == -1 && errno != EINTR, FileReadError, "unable to wait for archive_status changes");
+
+        // Discard the events since archive_status is listed after every wait anyway
+        char buffer[4096];
+
+        while (read(watchHandle, buffer, sizeof(buffer)) > 0);
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Push a batch of WAL files in parallel and write their status files
+
+Returns false if any WAL file could not be pushed.
+***********************************************************************************************************************************/
+static bool
+archivePushAsyncBatch(
+    const String *walPath, const StringList *walFileList, const ArchivePushCheckResult *archiveInfo, unsigned int batchId)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STRING, walPath);
+        FUNCTION_LOG_PARAM(STRING_LIST, walFileList);
+        FUNCTION_LOG_PARAM_P(VOID, archiveInfo);
+        FUNCTION_LOG_PARAM(UINT, batchId);
+    FUNCTION_LOG_END();
+
+    ASSERT(walPath != NULL);
+    ASSERT(walFileList != NULL);
+    ASSERT(archiveInfo != NULL);
+
+    bool result = true;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Create the parallel executor.  Local processes are reused by each batch.
+        ProtocolParallel *parallelExec = protocolParallelNew(
+            (TimeMSec)(cfgOptionDbl(cfgOptProtocolTimeout) * MSEC_PER_SEC) / 2, cfgOptionUInt(cfgOptProtocolPipeline));
+
+        for (unsigned int processIdx = 1; processIdx <= cfgOptionUInt(cfgOptProcessMax); processIdx++)
+            protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypeRepo, processIdx));
+
+        // Queue jobs in executor
+        for (unsigned int walFileIdx = 0; walFileIdx < strLstSize(walFileList); walFileIdx++)
+        {
+            protocolKeepAlive();
+
+            const String *walFile = strLstGet(walFileList, walFileIdx);
+
+            ProtocolCommand *command = protocolCommandNew(PROTOCOL_COMMAND_ARCHIVE_PUSH_STR);
+            protocolCommandParamAdd(command, VARSTR(strNewFmt("%s/%s", strPtr(walPath), strPtr(walFile))));
+            protocolCommandParamAdd(command, VARSTR(archiveInfo->archiveId));
+            protocolCommandParamAdd(command, VARUINT(archiveInfo->pgVersion));
+            protocolCommandParamAdd(command, VARUINT64(archiveInfo->pgSystemId));
+            protocolCommandParamAdd(command, VARSTR(walFile));
+            protocolCommandParamAdd(command, VARUINT(cipherType(cfgOptionStr(cfgOptRepoCipherType))));
+            protocolCommandParamAdd(command, VARSTR(archiveInfo->archiveCipherPass));
+            protocolCommandParamAdd(command, VARUINT(archivePushCompressType()));
+            protocolCommandParamAdd(command, VARINT(cfgOptionInt(cfgOptCompressLevel)));
+            protocolCommandParamAdd(command, VARUINT(batchId));
+
+            protocolParallelJobAdd(parallelExec, protocolParallelJobNew(VARSTR(walFile), command));
+        }
+
+        // Process jobs
+        do
+        {
+            unsigned int completed = protocolParallelProcess(parallelExec);
+
+            for (unsigned int jobIdx = 0; jobIdx < completed; jobIdx++)
+            {
+                protocolKeepAlive();
+
+                // Get the job and job key
+                ProtocolParallelJob *job = protocolParallelResult(parallelExec);
+                unsigned int processId = protocolParallelJobProcessId(job);
+                const String *walFile = varStr(protocolParallelJobKey(job));
+
+                // The job was successful
+                if (protocolParallelJobErrorCode(job) == 0)
+                {
+                    LOG_DETAIL_PID(processId, "pushed WAL file '%s' to the archive", strPtr(walFile));
+                    archiveAsyncStatusOkWrite(archiveModePush, walFile, varStr(protocolParallelJobResult(job)));
+                }
+                // Else the job errored
+                else
+                {
+                    LOG_WARN_PID(
+                        processId,
+                        "could not push WAL file '%s' to the archive (will be retried): [%d] %s", strPtr(walFile),
+                        protocolParallelJobErrorCode(job), strPtr(protocolParallelJobErrorMessage(job)));
+
+                    archiveAsyncStatusErrorWrite(
+                        archiveModePush, walFile, protocolParallelJobErrorCode(job), protocolParallelJobErrorMessage(job));
+
+                    result = false;
+                }
+            }
+        }
+        while (!protocolParallelDone(parallelExec));
+
+        protocolParallelFree(parallelExec);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(BOOL, result);
+}
+
 /***********************************************************************************************************************************
 Push a WAL segment to the repository
 ***********************************************************************************************************************************/
@@ -364,7 +546,7 @@ cmdArchivePush(void)
                 String *warning = archivePushFile(
                     walFile, archiveInfo.archiveId, archiveInfo.pgVersion, archiveInfo.pgSystemId, archiveFile,
                     cipherType(cfgOptionStr(cfgOptRepoCipherType)), archiveInfo.archiveCipherPass,
-                    cfgOptionBool(cfgOptCompress), cfgOptionInt(cfgOptCompressLevel));
+                    archivePushCompressType(), cfgOptionInt(cfgOptCompressLevel));
 
                 // If a warning was returned then log it
                 if (warning != NULL)
@@ -402,106 +584,115 @@ cmdArchivePushAsync(void)
 
         TRY_BEGIN()
         {
-            // Test for stop file
-            lockStopTest();
-
-            // Get a list of WAL files that are ready for processing
-            StringList *walFileList = archivePushProcessList(walPath);
-
-            // The archive-push-async command should not have been called unless there are WAL files to process
-            if (strLstSize(walFileList) == 0)
-                THROW(AssertError, "no WAL files to process");
-
-            LOG_INFO(
-                "push %u WAL file(s) to archive: %s%s", strLstSize(walFileList), strPtr(strLstGet(walFileList, 0)),
-                strLstSize(walFileList) == 1 ?
-                    "" : strPtr(strNewFmt("...%s", strPtr(strLstGet(walFileList, strLstSize(walFileList) - 1)))));
-
-            // Drop files if queue max has been exceeded
-            if (cfgOptionTest(cfgOptArchivePushQueueMax) && archivePushDrop(walPath, walFileList))
-            {
-                for (unsigned int walFileIdx = 0; walFileIdx < strLstSize(walFileList); walFileIdx++)
-                {
-                    const String *walFile = strLstGet(walFileList, walFileIdx);
-                    const String *warning = archivePushDropWarning(walFile, cfgOptionUInt64(cfgOptArchivePushQueueMax));
+            // When streaming, start watching archive_status before it is listed so no ready file is missed
+            bool stream = cfgOptionBool(cfgOptArchivePushStream);
+            int watchHandle = stream ? archivePushWatchNew(walPath) : -1;
 
-                    archiveAsyncStatusOkWrite(archiveModePush, walFile, warning);
-                    LOG_WARN(strPtr(warning));
-                }
-            }
-            // Else continue processing
-            else
+            TRY_BEGIN()
             {
-                // Get the repo storage in case it is remote and encryption settings need to be pulled down
-                storageRepo();
+                // Archive info is loaded for the first push and kept unless a push fails, since the failure may be caused by a
+                // stanza upgrade
+                ArchivePushCheckResult archiveInfo = {0};
+                bool pushError = false;
+                bool first = true;
+                TimeMSec idleBegin = timeMSec();
 
-                // Get archive info
-                ArchivePushCheckResult archiveInfo = archivePushCheck(
-                    cipherType(cfgOptionStr(cfgOptRepoCipherType)), cfgOptionStr(cfgOptRepoCipherPass));
+                // Local processes use the batch id to reset cached repo state when a new batch starts
+                unsigned int batchId = 0;
 
-                // Create the parallel executor
-                ProtocolParallel *parallelExec = protocolParallelNew(
-                    (TimeMSec)(cfgOptionDbl(cfgOptProtocolTimeout) * MSEC_PER_SEC) / 2);
-
-                for (unsigned int processIdx = 1; processIdx <= cfgOptionUInt(cfgOptProcessMax); processIdx++)
-                    protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypeRepo, processIdx));
-
-                // Queue jobs in executor
-                for (unsigned int walFileIdx = 0; walFileIdx < strLstSize(walFileList); walFileIdx++)
-                {
-                    protocolKeepAlive();
-
-                    const String *walFile = strLstGet(walFileList, walFileIdx);
-
-                    ProtocolCommand *command = protocolCommandNew(PROTOCOL_COMMAND_ARCHIVE_PUSH_STR);
-                    protocolCommandParamAdd(command, VARSTR(strNewFmt("%s/%s", strPtr(walPath), strPtr(walFile))));
-                    protocolCommandParamAdd(command, VARSTR(archiveInfo.archiveId));
-                    protocolCommandParamAdd(command, VARUINT(archiveInfo.pgVersion));
-                    protocolCommandParamAdd(command, VARUINT64(archiveInfo.pgSystemId));
-                    protocolCommandParamAdd(command, VARSTR(walFile));
-                    protocolCommandParamAdd(command, VARUINT(cipherType(cfgOptionStr(cfgOptRepoCipherType))));
-                    protocolCommandParamAdd(command, VARSTR(archiveInfo.archiveCipherPass));
-                    protocolCommandParamAdd(command, VARBOOL(cfgOptionBool(cfgOptCompress)));
-                    protocolCommandParamAdd(command, VARINT(cfgOptionInt(cfgOptCompressLevel)));
-
-                    protocolParallelJobAdd(parallelExec, protocolParallelJobNew(VARSTR(walFile), command));
-                }
-
-                // Process jobs
                 do
                 {
-                    unsigned int completed = protocolParallelProcess(parallelExec);
+                    // Test for stop file
+                    lockStopTest();
 
-                    for (unsigned int jobIdx = 0; jobIdx < completed; jobIdx++)
+                    MEM_CONTEXT_TEMP_BEGIN()
                     {
-                        protocolKeepAlive();
+                        // Get a list of WAL files that are ready for processing
+                        StringList *walFileList = archivePushProcessList(walPath);
 
-                        // Get the job and job key
-                        ProtocolParallelJob *job = protocolParallelResult(parallelExec);
-                        unsigned int processId = protocolParallelJobProcessId(job);
-                        const String *walFile = varStr(protocolParallelJobKey(job));
+                        // The archive-push-async command should not have been called unless there are WAL files to process
+                        if (first && strLstSize(walFileList) == 0)
+                            THROW(AssertError, "no WAL files to process");
 
-                        // The job was successful
-                        if (protocolParallelJobErrorCode(job) == 0)
+                        if (strLstSize(walFileList) > 0)
                         {
-                            LOG_DETAIL_PID(processId, "pushed WAL file '%s' to the archive", strPtr(walFile));
-                            archiveAsyncStatusOkWrite(archiveModePush, walFile, varStr(protocolParallelJobResult(job)));
-                        }
-                        // Else the job errored
-                        else
-                        {
-                            LOG_WARN_PID(
-                                processId,
-                                "could not push WAL file '%s' to the archive (will be retried): [%d] %s", strPtr(walFile),
-                                protocolParallelJobErrorCode(job), strPtr(protocolParallelJobErrorMessage(job)));
-
-                            archiveAsyncStatusErrorWrite(
-                                archiveModePush, walFile, protocolParallelJobErrorCode(job), protocolParallelJobErrorMessage(job));
+                            LOG_INFO(
+                                "push %u WAL file(s) to archive: %s%s", strLstSize(walFileList), strPtr(strLstGet(walFileList, 0)),
+                                strLstSize(walFileList) == 1 ?
+                                    "" :
+                                    strPtr(strNewFmt("...%s", strPtr(strLstGet(walFileList, strLstSize(walFileList) - 1)))));
+
+                            // Drop files if queue max has been exceeded
+                            if (cfgOptionTest(cfgOptArchivePushQueueMax) && archivePushDrop(walPath, walFileList))
+                            {
+                                for (unsigned int walFileIdx = 0; walFileIdx < strLstSize(walFileList); walFileIdx++)
+                                {
+                                    const String *walFile = strLstGet(walFileList, walFileIdx);
+                                    const String *warning = archivePushDropWarning(
+                                        walFile, cfgOptionUInt64(cfgOptArchivePushQueueMax));
+
+                                    archiveAsyncStatusOkWrite(archiveModePush, walFile, warning);
+                                    LOG_WARN(strPtr(warning));
+                                }
+
+                                pushError = false;
+                            }
+                            // Else continue processing
+                            else
+                            {
+                                // Get the repo storage in case it is remote and encryption settings need to be pulled down
+                                storageRepo();
+
+                                // Get archive info
+                                if (archiveInfo.archiveId == NULL || pushError)
+                                {
+                                    strFree(archiveInfo.archiveId);
+                                    strFree(archiveInfo.archiveCipherPass);
+
+                                    memContextSwitch(MEM_CONTEXT_OLD());
+                                    archiveInfo = archivePushCheck(
+                                        cipherType(cfgOptionStr(cfgOptRepoCipherType)), cfgOptionStr(cfgOptRepoCipherPass));
+                                    memContextSwitch(MEM_CONTEXT_TEMP());
+                                }
+
+                                // Push the WAL files
+                                batchId++;
+                                pushError = !archivePushAsyncBatch(walPath, walFileList, &archiveInfo, batchId);
+                            }
+
+                            // WAL files that keep failing do not keep the process running
+                            if (!pushError)
+                                idleBegin = timeMSec();
                         }
                     }
+                    MEM_CONTEXT_TEMP_END();
+
+                    first = false;
+
+                    // Stop when not streaming or no WAL has been pushed (or dropped) for archive-timeout
+                    TimeMSec idleMax = (TimeMSec)(cfgOptionDbl(cfgOptArchiveTimeout) * MSEC_PER_SEC);
+                    TimeMSec timeNow = timeMSec();
+
+                    if (!stream || timeNow - idleBegin >= idleMax)
+                        break;
+
+                    // Wait for new ready files.  Errored files are retried at the poll interval since no new ready file will be
+                    // created for them.
+                    TimeMSec timeout = idleBegin + idleMax - timeNow;
+
+                    if ((watchHandle == -1 || pushError) && timeout > ARCHIVE_PUSH_STREAM_POLL_MSEC)
+                        timeout = ARCHIVE_PUSH_STREAM_POLL_MSEC;
+
+                    archivePushWatchWait(watchHandle, timeout);
                 }
-                while (!protocolParallelDone(parallelExec));
+                while (true);
+            }
+            FINALLY()
+            {
+                if (watchHandle != -1)
+                    close(watchHandle);
             }
+            TRY_END();
         }
         // On any global error write a single error file to cover all unprocessed files
         CATCH_ANY()
@@ -7,11 +7,9 @@ Backup File
 
 #include "command/backup/file.h"
 #include "command/backup/pageChecksum.h"
-#include "common/compress/gzip/common.h"
-#include "common/compress/gzip/compress.h"
-#include "common/compress/gzip/decompress.h"
-#include "common/crypto/cipherBlock.h"
+#include "command/backup/pageDelta.h"
 #include "common/crypto/hash.h"
+#include "common/crypto/helper.h"
 #include "common/debug.h"
 #include "common/io/filter/group.h"
 #include "common/io/filter/size.h"
@@ -42,8 +40,9 @@ Copy a file from the PostgreSQL data directory to the repository
 BackupFileResult
 backupFile(
     const String *pgFile, bool pgFileIgnoreMissing, uint64_t pgFileSize, const String *pgFileChecksum, bool pgFileChecksumPage,
-    uint64_t pgFileChecksumPageLsnLimit, const String *repoFile, bool repoFileHasReference, bool repoFileCompress,
-    unsigned int repoFileCompressLevel, const String *backupLabel, bool delta, CipherType cipherType, const String *cipherPass)
+    uint64_t pgFileChecksumPageLsnLimit, uint64_t pgFilePageDeltaLsn, uint64_t pgFilePageDeltaBaseSize, const String *repoFile,
+    bool repoFileHasReference, CompressType repoFileCompressType, int repoFileCompressLevel, unsigned int compressThreadTotal,
+    const String *backupLabel, bool delta, CipherType cipherType, const String *cipherPass, unsigned int cipherThreadTotal)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, pgFile);                         // Database file to copy to the repo
@@ -52,14 +51,18 @@ backupFile(
         FUNCTION_LOG_PARAM(STRING, pgFileChecksum);                 // Checksum to verify the database file
         FUNCTION_LOG_PARAM(BOOL, pgFileChecksumPage);               // Should page checksums be validated
         FUNCTION_LOG_PARAM(UINT64, pgFileChecksumPageLsnLimit);     // Upper LSN limit to which page checksums must be valid
+        FUNCTION_LOG_PARAM(UINT64, pgFilePageDeltaLsn);             // Store only pages changed since this LSN (0 to store all)
+        FUNCTION_LOG_PARAM(UINT64, pgFilePageDeltaBaseSize);        // Size of the base the page delta will be applied to
         FUNCTION_LOG_PARAM(STRING, repoFile);                       // Destination in the repo to copy the pg file
         FUNCTION_LOG_PARAM(BOOL, repoFileHasReference);             // Does the repo file exists in a prior backup in the set?
-        FUNCTION_LOG_PARAM(BOOL, repoFileCompress);                 // Compress destination file
-        FUNCTION_LOG_PARAM(UINT, repoFileCompressLevel);            // Compression level for destination file
+        FUNCTION_LOG_PARAM(ENUM, repoFileCompressType);             // Compress type for destination file
+        FUNCTION_LOG_PARAM(INT, repoFileCompressLevel);             // Compression level for destination file
+        FUNCTION_LOG_PARAM(UINT, compressThreadTotal);              // Compression threads for large files
         FUNCTION_LOG_PARAM(STRING, backupLabel);                    // Label of current backup
         FUNCTION_LOG_PARAM(BOOL, delta);                            // Is the delta option on?
         FUNCTION_LOG_PARAM(ENUM, cipherType);                       // Encryption type
         FUNCTION_TEST_PARAM(STRING, cipherPass);                    // Password to access the repo file if encrypted
+        FUNCTION_LOG_PARAM(UINT, cipherThreadTotal);                // Cipher threads for large files
     FUNCTION_LOG_END();
 
     ASSERT(pgFile != NULL);
@@ -70,11 +73,11 @@ backupFile(
     // Backup file results
     BackupFileResult result = {.backupCopyResult = backupCopyResultCopy};
 
-    MEM_CONTEXT_TEMP_BEGIN()
+    MEM_CONTEXT_TEMP_ARENA_BEGIN()
     {
         // Generate complete repo path and add compression extension if needed
-        const String *repoPathFile = strNewFmt(
-            STORAGE_REPO_BACKUP "/%s/%s%s", strPtr(backupLabel), strPtr(repoFile), repoFileCompress ? "." GZIP_EXT : "");
+        String *repoPathFile = strNewFmt(STORAGE_REPO_BACKUP "/%s/%s", strPtr(backupLabel), strPtr(repoFile));
+        compressExtCat(repoPathFile, repoFileCompressType);
 
         // If checksum is defined then the file needs to be checked. If delta option then check the DB and possibly the repo, else
         // just check the repo.
@@ -139,11 +142,14 @@ backupFile(
                     if (cipherType != cipherTypeNone)
                     {
                         ioFilterGroupAdd(
-                            ioReadFilterGroup(read), cipherBlockNew(cipherModeDecrypt, cipherType, BUFSTR(cipherPass), NULL));
+                            ioReadFilterGroup(read),
+                            cipherFilter(
+                                cipherModeDecrypt, cipherType, BUFSTR(cipherPass),
+                                pgFileSize > CIPHER_THREAD_SIZE_MIN ? cipherThreadTotal : 1));
                     }
 
-                    if (repoFileCompress)
-                        ioFilterGroupAdd(ioReadFilterGroup(read), gzipDecompressNew(false));
+                    if (repoFileCompressType != compressTypeNone)
+                        ioFilterGroupAdd(ioReadFilterGroup(read), decompressFilter(repoFileCompressType));
 
                     ioFilterGroupAdd(ioReadFilterGroup(read), cryptoHashNew(HASH_TYPE_SHA1_STR));
                     ioFilterGroupAdd(ioReadFilterGroup(read), ioSizeNew());
@@ -175,7 +181,7 @@ backupFile(
         if (result.backupCopyResult == backupCopyResultCopy || result.backupCopyResult == backupCopyResultReCopy)
         {
             // Is the file compressible during the copy?
-            bool compressible = !repoFileCompress && cipherType == cipherTypeNone;
+            bool compressible = repoFileCompressType == compressTypeNone && cipherType == cipherTypeNone;
 
             // Setup pg file for read
             StorageRead *read = storageNewReadP(
@@ -191,18 +197,38 @@ backupFile(
                     PG_PAGE_SIZE_DEFAULT, pgFileChecksumPageLsnLimit));
             }
 
-            // Add compression
-            if (repoFileCompress)
-                ioFilterGroupAdd(ioReadFilterGroup(storageReadIo(read)), gzipCompressNew((int)repoFileCompressLevel, false));
+            // Add page delta filter
+            if (pgFilePageDeltaLsn != 0)
+            {
+                ioFilterGroupAdd(
+                    ioReadFilterGroup(storageReadIo(read)),
+                    pageDeltaNew(PG_PAGE_SIZE_DEFAULT, pgFilePageDeltaLsn, pgFilePageDeltaBaseSize));
+            }
+
+            // Add compression.  Compress large files in threads when enabled.
+            if (repoFileCompressType != compressTypeNone)
+            {
+                ioFilterGroupAdd(
+                    ioReadFilterGroup(storageReadIo(read)),
+                    compressFilter(
+                        repoFileCompressType, repoFileCompressLevel,
+                        pgFileSize > COMPRESS_THREAD_SIZE_MIN ? compressThreadTotal : 1));
+            }
 
             // If there is a cipher then add the encrypt filter
             if (cipherType != cipherTypeNone)
             {
                 ioFilterGroupAdd(
-                    ioReadFilterGroup(
-                        storageReadIo(read)), cipherBlockNew(cipherModeEncrypt, cipherType, BUFSTR(cipherPass), NULL));
+                    ioReadFilterGroup(storageReadIo(read)),
+                    cipherFilter(
+                        cipherModeEncrypt, cipherType, BUFSTR(cipherPass),
+                        pgFileSize > CIPHER_THREAD_SIZE_MIN ? cipherThreadTotal : 1));
             }
 
+            // Run filters in threads for large files when enabled.  This has no effect when the pg file is remote since the filters
+            // are run on the remote.
+            ioFilterGroupThreadSet(ioReadFilterGroup(storageReadIo(read)), ioFilterThread() && pgFileSize > ioBufferSize());
+
             // Setup the repo file for write
             StorageWrite *write = storageNewWriteP(storageRepoWrite(), repoPathFile, .compressible = compressible);
             ioFilterGroupAdd(ioWriteFilterGroup(storageWriteIo(write)), ioSizeNew());
@@ -0,0 +1,362 @@
+/***********************************************************************************************************************************
+Page Delta Filter
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+#include "command/backup/pageDelta.h"
+#include "common/debug.h"
+#include "common/io/filter/filter.intern.h"
+#include "common/log.h"
+#include "common/memContext.h"
+#include "common/object.h"
+#include "postgres/pageChecksum.h"
+
+/***********************************************************************************************************************************
+Filter type constant
+***********************************************************************************************************************************/
+STRING_EXTERN(PAGE_DELTA_FILTER_TYPE_STR,                           PAGE_DELTA_FILTER_TYPE);
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+typedef struct PageDelta
+{
+    MemContext *memContext;                                         // Mem context of filter
+
+    size_t pageSize;                                                // Page size
+    uint64_t lsnLimit;                                              // Pages at or above this lsn are stored
+    uint64_t baseSize;                                              // Pages at or past this offset are stored
+    uint64_t offset;                                                // Offset of the next page in the relation
+    unsigned int pageStoreTotal;                                    // Total pages stored
+
+    Buffer *page;                                                   // Partial page when input is not page aligned
+    size_t inputOffset;                                             // Offset into input when a map was ready before input was used
+
+    Buffer *map;                                                    // Map being built or output
+    unsigned int mapPageTotal;                                      // Pages in the map
+    size_t mapSize;                                                 // Size of the range covered by the map
+    size_t mapOutputOffset;                                         // Offset of map data not yet output
+    bool mapReady;                                                  // Is the map ready to be output?
+
+    bool inputSame;                                                 // Is the same input required on the next process call?
+    bool flush;                                                     // Is input complete and flushing in progress?
+    bool done;                                                      // Is the delta done?
+} PageDelta;
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+static String *
+pageDeltaToLog(const PageDelta *this)
+{
+    return strNewFmt(
+        "{offset: %" PRIu64 ", pageStoreTotal: %u, inputSame: %s, done: %s}", this->offset, this->pageStoreTotal,
+        cvtBoolToConstZ(this->inputSame), cvtBoolToConstZ(this->done));
+}
+
+#define FUNCTION_LOG_PAGE_DELTA_TYPE                                                                                               \
+    PageDelta *
+#define FUNCTION_LOG_PAGE_DELTA_FORMAT(value, buffer, bufferSize)                                                                  \
+    FUNCTION_LOG_STRING_OBJECT_FORMAT(value, pageDeltaToLog, buffer, bufferSize)
+
+/***********************************************************************************************************************************
+Finish the map so it can be output
+***********************************************************************************************************************************/
+static void
+pageDeltaMapEnd(PageDelta *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PAGE_DELTA, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(!this->mapReady);
+
+    if (this->mapPageTotal > 0)
+    {
+        unsigned char *map = bufPtr(this->map);
+
+        // Space was reserved for a full bitmap so move the pages down when the map is not full
+        size_t bitmapSize = PAGE_DELTA_MAP_BITMAP_SIZE(this->mapPageTotal);
+        size_t bitmapSizeMax = PAGE_DELTA_MAP_BITMAP_SIZE(PAGE_DELTA_MAP_PAGE_MAX);
+
+        if (bitmapSize < bitmapSizeMax)
+        {
+            size_t pageDataSize = bufUsed(this->map) - PAGE_DELTA_MAP_HEADER_SIZE - bitmapSizeMax;
+
+            memmove(
+                map + PAGE_DELTA_MAP_HEADER_SIZE + bitmapSize, map + PAGE_DELTA_MAP_HEADER_SIZE + bitmapSizeMax, pageDataSize);
+            bufUsedSet(this->map, PAGE_DELTA_MAP_HEADER_SIZE + bitmapSize + pageDataSize);
+        }
+
+        // Write the size of the range covered by the map
+        map[0] = (unsigned char)(this->mapSize >> 24);
+        map[1] = (unsigned char)(this->mapSize >> 16);
+        map[2] = (unsigned char)(this->mapSize >> 8);
+        map[3] = (unsigned char)this->mapSize;
+    }
+
+    // When flushing add the end of delta marker
+    if (this->flush)
+    {
+        if (this->mapPageTotal == 0)
+            bufUsedZero(this->map);
+
+        bufCat(this->map, BUFSTRDEF("\0\0\0\0"));
+    }
+
+    this->mapReady = true;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Add a page to the map
+***********************************************************************************************************************************/
+static void
+pageDeltaPage(PageDelta *this, const unsigned char *page, size_t pageSize)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PAGE_DELTA, this);
+        FUNCTION_TEST_PARAM_P(UCHARDATA, page);
+        FUNCTION_TEST_PARAM(SIZE, pageSize);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(page != NULL);
+    ASSERT(!this->mapReady);
+
+    // Start a new map by reserving space for the header and a full bitmap
+    if (this->mapPageTotal == 0)
+    {
+        bufUsedSet(this->map, PAGE_DELTA_MAP_HEADER_SIZE + PAGE_DELTA_MAP_BITMAP_SIZE(PAGE_DELTA_MAP_PAGE_MAX));
+        memset(bufPtr(this->map), 0, bufUsed(this->map));
+    }
+
+    // Store the page if it is partial, past the end of the base, new, or changed since the base backup started
+    if (pageSize != this->pageSize || this->offset >= this->baseSize || pageNew(page) || pageLsn(page) >= this->lsnLimit)
+    {
+        bufPtr(this->map)[PAGE_DELTA_MAP_HEADER_SIZE + this->mapPageTotal / 8] |= (unsigned char)(0x80 >> (this->mapPageTotal % 8));
+        bufCatC(this->map, page, 0, pageSize);
+        this->pageStoreTotal++;
+    }
+
+    this->mapPageTotal++;
+    this->mapSize += pageSize;
+    this->offset += pageSize;
+
+    if (this->mapPageTotal == PAGE_DELTA_MAP_PAGE_MAX)
+        pageDeltaMapEnd(this);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Process pages and output maps as they are completed
+***********************************************************************************************************************************/
+static void
+pageDeltaProcess(THIS_VOID, const Buffer *input, Buffer *output)
+{
+    THIS(PageDelta);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(PAGE_DELTA, this);
+        FUNCTION_LOG_PARAM(BUFFER, input);
+        FUNCTION_LOG_PARAM(BUFFER, output);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(!this->done);
+    ASSERT(output != NULL);
+    ASSERT(!this->flush || input == NULL);
+
+    do
+    {
+        // Add pages from the input until the input is used or a map is ready
+        if (input != NULL)
+        {
+            while (!this->mapReady && this->inputOffset < bufUsed(input))
+            {
+                size_t inputRemains = bufUsed(input) - this->inputOffset;
+
+                // Process the page directly from the input when possible
+                if (bufUsed(this->page) == 0 && inputRemains >= this->pageSize)
+                {
+                    pageDeltaPage(this, bufPtr(input) + this->inputOffset, this->pageSize);
+                    this->inputOffset += this->pageSize;
+                }
+                // Else accumulate the page
+                else
+                {
+                    size_t copySize = bufRemains(this->page) < inputRemains ? bufRemains(this->page) : inputRemains;
+
+                    bufCatSub(this->page, input, this->inputOffset, copySize);
+                    this->inputOffset += copySize;
+
+                    if (bufFull(this->page))
+                    {
+                        pageDeltaPage(this, bufPtr(this->page), this->pageSize);
+                        bufUsedZero(this->page);
+                    }
+                }
+            }
+        }
+        // Else flush the partial last page, if any, and finish the last map once any ready map has been output
+        else if (!this->flush && !this->mapReady)
+        {
+            if (bufUsed(this->page) > 0)
+                pageDeltaPage(this, bufPtr(this->page), bufUsed(this->page));
+
+            // If the last page completed a map then the end of delta marker will be added once that map has been output
+            if (!this->mapReady)
+            {
+                this->flush = true;
+                pageDeltaMapEnd(this);
+            }
+        }
+
+        // Output as much of the map as possible
+        if (this->mapReady)
+        {
+            size_t mapRemains = bufUsed(this->map) - this->mapOutputOffset;
+            size_t copySize = bufRemains(output) < mapRemains ? bufRemains(output) : mapRemains;
+
+            bufCatSub(output, this->map, this->mapOutputOffset, copySize);
+            this->mapOutputOffset += copySize;
+
+            // Start a new map when this one has been output
+            if (this->mapOutputOffset == bufUsed(this->map))
+            {
+                this->mapReady = false;
+                this->mapOutputOffset = 0;
+                this->mapPageTotal = 0;
+                this->mapSize = 0;
+                bufUsedZero(this->map);
+
+                if (this->flush)
+                    this->done = true;
+            }
+        }
+    }
+    while (!bufFull(output) && !this->done && (input == NULL || this->inputOffset < bufUsed(input)));
+
+    // The same input is required if it was not all used, or when flushing if there is more to output
+    if (input != NULL)
+    {
+        this->inputSame = this->inputOffset < bufUsed(input);
+
+        if (!this->inputSame)
+            this->inputOffset = 0;
+    }
+    else
+        this->inputSame = !this->done;
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Is the delta done?
+***********************************************************************************************************************************/
+static bool
+pageDeltaDone(const THIS_VOID)
+{
+    THIS(const PageDelta);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PAGE_DELTA, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->done);
+}
+
+/***********************************************************************************************************************************
+Is the same input required on the next process call?
+***********************************************************************************************************************************/
+static bool
+pageDeltaInputSame(const THIS_VOID)
+{
+    THIS(const PageDelta);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PAGE_DELTA, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->inputSame);
+}
+
+/***********************************************************************************************************************************
+Return the total pages stored
+***********************************************************************************************************************************/
+static Variant *
+pageDeltaResult(THIS_VOID)
+{
+    THIS(PageDelta);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(PAGE_DELTA, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_LOG_RETURN(VARIANT, varNewUInt(this->pageStoreTotal));
+}
+
+/***********************************************************************************************************************************
+New object
+***********************************************************************************************************************************/
+IoFilter *
+pageDeltaNew(size_t pageSize, uint64_t lsnLimit, uint64_t baseSize)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(SIZE, pageSize);
+        FUNCTION_LOG_PARAM(UINT64, lsnLimit);
+        FUNCTION_LOG_PARAM(UINT64, baseSize);
+    FUNCTION_LOG_END();
+
+    ASSERT(pageSize > 0);
+
+    IoFilter *this = NULL;
+
+    MEM_CONTEXT_NEW_BEGIN("PageDelta")
+    {
+        PageDelta *driver = memNew(sizeof(PageDelta));
+        driver->memContext = memContextCurrent();
+
+        driver->pageSize = pageSize;
+        driver->lsnLimit = lsnLimit;
+        driver->baseSize = baseSize;
+
+        driver->page = bufNew(pageSize);
+        driver->map = bufNew(
+            PAGE_DELTA_MAP_HEADER_SIZE + PAGE_DELTA_MAP_BITMAP_SIZE(PAGE_DELTA_MAP_PAGE_MAX) + PAGE_DELTA_MAP_PAGE_MAX * pageSize +
+            PAGE_DELTA_MAP_HEADER_SIZE);
+
+        // Create param list
+        VariantList *paramList = varLstNew();
+        varLstAdd(paramList, varNewUInt64(pageSize));
+        varLstAdd(paramList, varNewUInt64(lsnLimit));
+        varLstAdd(paramList, varNewUInt64(baseSize));
+
+        this = ioFilterNewP(
+            PAGE_DELTA_FILTER_TYPE_STR, driver, paramList, .done = pageDeltaDone, .inOut = pageDeltaProcess,
+            .inputSame = pageDeltaInputSame, .result = pageDeltaResult);
+    }
+    MEM_CONTEXT_NEW_END();
+
+    FUNCTION_LOG_RETURN(IO_FILTER, this);
+}
+
+IoFilter *
+pageDeltaNewVar(const VariantList *paramList)
+{
+    return pageDeltaNew(
+        (size_t)varUInt64Force(varLstGet(paramList, 0)), varUInt64Force(varLstGet(paramList, 1)),
+        varUInt64Force(varLstGet(paramList, 2)));
+}
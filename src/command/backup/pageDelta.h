@@ -0,0 +1,46 @@
+/***********************************************************************************************************************************
+Page Delta Filter
+
+Store only the pages of a PostgreSQL relation that have changed since a full copy of the relation (the base) was backed up.  A page
+is stored when its LSN is at or above the LSN where the backup of the base started, when it is a new (zeroed) page, or when it is
+past the end of the base.  All other pages are identical to the pages in the base since any change would have advanced the LSN.
+
+The delta is a sequence of maps, each covering up to PAGE_DELTA_MAP_PAGE_MAX consecutive pages of the relation:
+
+size    - four byte big-endian size in bytes of the range covered by the map (only the last page of the relation may be partial)
+bitmap  - one bit per page in the range (most significant bit first) that is set when the page is stored in the map
+pages   - the stored pages in order
+
+A map with a size of zero marks the end of the delta.  The size of the relation is the sum of the map sizes so a relation that has
+been truncated since the base was backed up is restored at the correct size.
+***********************************************************************************************************************************/
+#ifndef COMMAND_BACKUP_PAGE_DELTA_H
+#define COMMAND_BACKUP_PAGE_DELTA_H
+
+#include "common/io/filter/filter.h"
+
+/***********************************************************************************************************************************
+Filter type constant
+***********************************************************************************************************************************/
+#define PAGE_DELTA_FILTER_TYPE                                      "pageDelta"
+    STRING_DECLARE(PAGE_DELTA_FILTER_TYPE_STR);
+
+/***********************************************************************************************************************************
+Map constants
+***********************************************************************************************************************************/
+// Maximum pages covered by a map
+#define PAGE_DELTA_MAP_PAGE_MAX                                     128
+
+// Size of the map header that stores the size of the range covered by the map
+#define PAGE_DELTA_MAP_HEADER_SIZE                                  4
+
+// Size of the map bitmap for the pages covered by the map
+#define PAGE_DELTA_MAP_BITMAP_SIZE(pageTotal)                       (((pageTotal) + 7) / 8)
+
+/***********************************************************************************************************************************
+Constructor
+***********************************************************************************************************************************/
+IoFilter *pageDeltaNew(size_t pageSize, uint64_t lsnLimit, uint64_t baseSize);
+IoFilter *pageDeltaNewVar(const VariantList *paramList);
+
+#endif
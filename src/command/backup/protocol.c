@@ -42,11 +42,13 @@ backupProtocol(const String *command, const VariantList *paramList, ProtocolServ
             BackupFileResult result = backupFile(
                 varStr(varLstGet(paramList, 0)), varBoolForce(varLstGet(paramList, 1)), varUInt64(varLstGet(paramList, 2)),
                 varStr(varLstGet(paramList, 3)), varBoolForce(varLstGet(paramList, 4)),
-                varUInt64(varLstGet(paramList, 5)) << 32 | varUInt64(varLstGet(paramList, 6)), varStr(varLstGet(paramList, 7)),
-                varBoolForce(varLstGet(paramList, 8)), varBoolForce(varLstGet(paramList, 9)),
-                varUIntForce(varLstGet(paramList, 10)), varStr(varLstGet(paramList, 11)), varBoolForce(varLstGet(paramList, 12)),
-                varLstSize(paramList) == 14 ? cipherTypeAes256Cbc : cipherTypeNone,
-                varLstSize(paramList) == 14 ? varStr(varLstGet(paramList, 13)) : NULL);
+                varUInt64(varLstGet(paramList, 5)) << 32 | varUInt64(varLstGet(paramList, 6)),
+                varUInt64(varLstGet(paramList, 13)) << 32 | varUInt64(varLstGet(paramList, 14)), varUInt64(varLstGet(paramList, 15)),
+                varStr(varLstGet(paramList, 7)), varBoolForce(varLstGet(paramList, 8)),
+                compressType(varStr(varLstGet(paramList, 9))), varIntForce(varLstGet(paramList, 10)),
+                cfgOptionUInt(cfgOptCompressThread), varStr(varLstGet(paramList, 11)), varBoolForce(varLstGet(paramList, 12)),
+                varLstSize(paramList) == 17 ? cipherType(cfgOptionStr(cfgOptRepoCipherType)) : cipherTypeNone,
+                varLstSize(paramList) == 17 ? varStr(varLstGet(paramList, 16)) : NULL, cfgOptionUInt(cfgOptCipherThread));
 
             // Return backup result
             VariantList *resultList = varLstNew();
@@ -77,12 +77,67 @@ sortArchiveId(StringList *sortString, SortOrder sortOrder)
     FUNCTION_LOG_RETURN(STRING_LIST, sortString);
 }
 
+/***********************************************************************************************************************************
+WAL positions and ranges used to determine which archive to retain
+
+Positions are numeric so ranges can be sorted, merged, and compared without creating strings for each WAL segment.  The path is the
+timeline and log, i.e. the WAL path, and the segment is the last eight hex digits of the WAL segment name.
+***********************************************************************************************************************************/
+typedef struct ArchiveWalPos
+{
+    uint64_t path;                                                  // Timeline and log
+    uint32_t segment;                                               // Segment in the log
+} ArchiveWalPos;
+
+// Stop position for the range of the retention backup, which preserves all archive after its start
+#define ARCHIVE_WAL_POS_MAX                                         ((ArchiveWalPos){.path = UINT64_MAX, .segment = UINT32_MAX})
+
 typedef struct ArchiveRange
 {
-    const String *start;
-    const String *stop;
+    ArchiveWalPos start;
+    ArchiveWalPos stop;
 } ArchiveRange;
 
+// Convert hex digits to a number.  The digits have already been validated by the expression used to list the archive.
+static uint64_t
+archiveWalHex(const char *hex, unsigned int size)
+{
+    uint64_t result = 0;
+
+    for (unsigned int hexIdx = 0; hexIdx < size; hexIdx++)
+        result = (result << 4) + (uint64_t)(hex[hexIdx] <= '9' ? hex[hexIdx] - '0' : hex[hexIdx] - 'A' + 10);
+
+    return result;
+}
+
+static ArchiveWalPos
+archiveWalPos(const String *walSegment)
+{
+    return (ArchiveWalPos)
+    {
+        .path = archiveWalHex(strPtr(walSegment), 16),
+        .segment = (uint32_t)archiveWalHex(strPtr(walSegment) + 16, 8),
+    };
+}
+
+static int
+archiveWalPosCmp(ArchiveWalPos pos1, ArchiveWalPos pos2)
+{
+    if (pos1.path != pos2.path)
+        return pos1.path < pos2.path ? -1 : 1;
+
+    if (pos1.segment != pos2.segment)
+        return pos1.segment < pos2.segment ? -1 : 1;
+
+    return 0;
+}
+
+static int
+archiveRangeComparator(const void *item1, const void *item2)
+{
+    return archiveWalPosCmp(((const ArchiveRange *)item1)->start, ((const ArchiveRange *)item2)->start);
+}
+
 /***********************************************************************************************************************************
 Common function for expiring any backup
 ***********************************************************************************************************************************/
@@ -468,14 +523,11 @@ removeExpiredArchive(InfoBackup *infoBackup)
 
                         // Only expire if the selected backup has archive data - backups performed with --no-online will
                         // not have archive data and cannot be used for expiration.
-                        bool removeArchive = false;
-
                         if (archiveRetentionBackup.backupArchiveStart != NULL)
                         {
                             // Get archive ranges to preserve.  Because archive retention can be less than total retention it is
                             // important to preserve archive that is required to make the older backups consistent even though they
                             // cannot be played any further forward with PITR.
-                            String *archiveExpireMax = NULL;
                             List *archiveRangeList = lstNew(sizeof(ArchiveRange));
 
                             // From the full list of backups, loop through those associated with this archiveId
@@ -490,28 +542,53 @@ removeExpiredArchive(InfoBackup *infoBackup)
                                 {
                                     ArchiveRange archiveRange =
                                     {
-                                        .start = strDup(backupData->backupArchiveStart),
-                                        .stop = NULL,
+                                        .start = archiveWalPos(backupData->backupArchiveStart),
+                                        .stop = ARCHIVE_WAL_POS_MAX,
                                     };
 
-                                    // If this is not the retention backup, then set the stop, otherwise set the expire max to
-                                    // the archive start of the archive to retain
-                                    if (strCmp(backupData->backupLabel, archiveRetentionBackup.backupLabel) != 0)
-                                        archiveRange.stop = strDup(backupData->backupArchiveStop);
-                                    else
-                                        archiveExpireMax = strDup(archiveRange.start);
+                                    // If this is not the retention backup, then set the stop, otherwise all archive after the start
+                                    // of the retention backup is preserved
+                                    const String *archiveStop = NULL;
+
+                                    if (strCmp(backupData->backupLabel, archiveRetentionBackup.backupLabel) != 0 &&
+                                        backupData->backupArchiveStop != NULL)
+                                    {
+                                        archiveStop = backupData->backupArchiveStop;
+                                        archiveRange.stop = archiveWalPos(archiveStop);
+                                    }
 
                                     LOG_DETAIL(
                                         "archive retention on backup %s, archiveId = %s, start = %s%s",
-                                        strPtr(backupData->backupLabel),  strPtr(archiveId), strPtr(archiveRange.start),
-                                        archiveRange.stop != NULL ?
-                                            strPtr(strNewFmt(", stop = %s", strPtr(archiveRange.stop))) : "");
+                                        strPtr(backupData->backupLabel),  strPtr(archiveId), strPtr(backupData->backupArchiveStart),
+                                        archiveStop != NULL ? strPtr(strNewFmt(", stop = %s", strPtr(archiveStop))) : "");
 
                                     // Add the archive range to the list
                                     lstAdd(archiveRangeList, &archiveRange);
                                 }
                             }
 
+                            // Sort the ranges and merge those that overlap so the ranges can be walked in order along with the
+                            // sorted archive and each WAL segment is compared with at most one range
+                            lstSort(archiveRangeList, archiveRangeComparator);
+
+                            List *archiveRangeMergeList = lstNew(sizeof(ArchiveRange));
+
+                            for (unsigned int rangeIdx = 0; rangeIdx < lstSize(archiveRangeList); rangeIdx++)
+                            {
+                                ArchiveRange *archiveRange = lstGet(archiveRangeList, rangeIdx);
+                                ArchiveRange *archiveRangeLast =
+                                    lstSize(archiveRangeMergeList) == 0 ?
+                                        NULL : lstGet(archiveRangeMergeList, lstSize(archiveRangeMergeList) - 1);
+
+                                if (archiveRangeLast != NULL && archiveWalPosCmp(archiveRange->start, archiveRangeLast->stop) <= 0)
+                                {
+                                    if (archiveWalPosCmp(archiveRange->stop, archiveRangeLast->stop) > 0)
+                                        archiveRangeLast->stop = archiveRange->stop;
+                                }
+                                else
+                                    lstAdd(archiveRangeMergeList, archiveRange);
+                            }
+
                             // Get all major archive paths (timeline and first 32 bits of LSN)
                             StringList *walPathList =
                                 strLstSort(
@@ -520,26 +597,28 @@ removeExpiredArchive(InfoBackup *infoBackup)
                                         .expression = STRDEF(WAL_SEGMENT_DIR_REGEXP)),
                                     sortOrderAsc);
 
+                            unsigned int rangeIdx = 0;
+
                             for (unsigned int walIdx = 0; walIdx < strLstSize(walPathList); walIdx++)
                             {
                                 String *walPath = strLstGet(walPathList, walIdx);
-                                removeArchive = true;
-
-                                // Keep the path if it falls in the range of any backup in retention
-                                for (unsigned int rangeIdx = 0; rangeIdx < lstSize(archiveRangeList); rangeIdx++)
+                                ArchiveWalPos walPathStart = {.path = archiveWalHex(strPtr(walPath), 16), .segment = 0};
+                                ArchiveWalPos walPathStop = {.path = walPathStart.path, .segment = UINT32_MAX};
+
+                                // Skip ranges that stop before this path.  Paths are sorted so these ranges cannot include any of
+                                // the remaining paths either.
+                                while (rangeIdx < lstSize(archiveRangeMergeList) &&
+                                       archiveWalPosCmp(
+                                           ((ArchiveRange *)lstGet(archiveRangeMergeList, rangeIdx))->stop, walPathStart) < 0)
                                 {
-                                    ArchiveRange *archiveRange = lstGet(archiveRangeList, rangeIdx);
-
-                                    if (strCmp(walPath, strSubN(archiveRange->start, 0, 16)) >= 0 &&
-                                        (archiveRange->stop == NULL || strCmp(walPath, strSubN(archiveRange->stop, 0, 16)) <= 0))
-                                    {
-                                        removeArchive = false;
-                                        break;
-                                    }
+                                    rangeIdx++;
                                 }
 
+                                ArchiveRange *archiveRange =
+                                    rangeIdx < lstSize(archiveRangeMergeList) ? lstGet(archiveRangeMergeList, rangeIdx) : NULL;
+
                                 // Remove the entire directory if all archive is expired
-                                if (removeArchive)
+                                if (archiveRange == NULL || archiveWalPosCmp(archiveRange->start, walPathStop) > 0)
                                 {
                                     storagePathRemoveP(
                                         storageRepoWrite(), strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s", strPtr(archiveId),
@@ -549,10 +628,15 @@ removeExpiredArchive(InfoBackup *infoBackup)
                                     archiveExpire.start = strDup(walPath);
                                     archiveExpire.stop = strDup(walPath);
                                 }
-                                // Else delete individual files instead if the major path is less than or equal to the most recent
-                                // retention backup.  This optimization prevents scanning though major paths that could not possibly
-                                // have anything to expire.
-                                else if (strCmp(walPath, strSubN(archiveExpireMax, 0, 16)) <= 0)
+                                // Else keep the entire directory without scanning it if a range includes all of it.  This includes
+                                // every major path after the start of the retention backup.
+                                else if (archiveWalPosCmp(archiveRange->start, walPathStart) <= 0 &&
+                                         archiveWalPosCmp(archiveRange->stop, walPathStop) >= 0)
+                                {
+                                    logExpire(&archiveExpire, archiveId);
+                                }
+                                // Else delete individual files that are not included in any range
+                                else
                                 {
                                     // Look for files in the archive directory
                                     StringList *walSubPathList =
@@ -563,42 +647,45 @@ removeExpiredArchive(InfoBackup *infoBackup)
                                                 .expression = STRDEF("^[0-F]{24}.*$")),
                                             sortOrderAsc);
 
+                                    // Build the list of archive logs to remove so they can be removed in batches
+                                    StringList *walRemoveList = strLstNew();
+                                    unsigned int subRangeIdx = rangeIdx;
+
                                     for (unsigned int subIdx = 0; subIdx < strLstSize(walSubPathList); subIdx++)
                                     {
-                                        removeArchive = true;
                                         String *walSubPath = strLstGet(walSubPathList, subIdx);
+                                        ArchiveWalPos walPos = archiveWalPos(walSubPath);
 
-                                        // Determine if the individual archive log is used in a backup
-                                        for (unsigned int rangeIdx = 0; rangeIdx < lstSize(archiveRangeList); rangeIdx++)
+                                        // Skip ranges that stop before this archive log
+                                        while (subRangeIdx < lstSize(archiveRangeMergeList) &&
+                                               archiveWalPosCmp(
+                                                   ((ArchiveRange *)lstGet(archiveRangeMergeList, subRangeIdx))->stop, walPos) < 0)
                                         {
-                                            ArchiveRange *archiveRange = lstGet(archiveRangeList, rangeIdx);
-
-                                            if (strCmp(strSubN(walSubPath, 0, 24), archiveRange->start) >= 0 &&
-                                                (archiveRange->stop == NULL ||
-                                                    strCmp(strSubN(walSubPath, 0, 24), archiveRange->stop) <= 0))
-                                            {
-                                                removeArchive = false;
-                                                break;
-                                            }
+                                            subRangeIdx++;
                                         }
 
                                         // Remove archive log if it is not used in a backup
-                                        if (removeArchive)
+                                        if (subRangeIdx == lstSize(archiveRangeMergeList) ||
+                                            archiveWalPosCmp(
+                                                ((ArchiveRange *)lstGet(archiveRangeMergeList, subRangeIdx))->start, walPos) > 0)
                                         {
-                                            storageRemoveNP(
-                                                storageRepoWrite(),
+                                            strLstAdd(
+                                                walRemoveList,
                                                 strNewFmt(STORAGE_REPO_ARCHIVE "/%s/%s/%s",
                                                     strPtr(archiveId), strPtr(walPath), strPtr(walSubPath)));
 
                                             // Track that this archive was removed
                                             archiveExpire.total++;
-                                            archiveExpire.stop = strDup(strSubN(walSubPath, 0, 24));
+                                            archiveExpire.stop = strSubN(walSubPath, 0, WAL_SEGMENT_NAME_SIZE);
+
                                             if (archiveExpire.start == NULL)
-                                                archiveExpire.start = strDup(strSubN(walSubPath, 0, 24));
+                                                archiveExpire.start = archiveExpire.stop;
                                         }
                                         else
                                             logExpire(&archiveExpire, archiveId);
                                     }
+
+                                    storageRemoveListNP(storageRepoWrite(), walRemoveList);
                                 }
                             }
 
@@ -333,12 +333,17 @@ stanzaInfoList(const String *stanza, StringList *stanzaList)
         // If the backup.info file exists, get the database history information (newest to oldest) and corresponding archive
         if (info != NULL)
         {
-            // Determine if encryption is enabled by checking for a cipher passphrase.  This is not ideal since it does not tell us
-            // what type of encryption is in use, but to figure that out we need a way to query the (possibly) remote repo to find
-            // out.  No such mechanism exists so this will have to do for now.  Probably the easiest thing to do is store the
-            // cipher type in the info file.
+            // Determine if encryption is enabled by checking for a cipher passphrase.  The info file was decrypted with the
+            // configured cipher type so that must be the type in use, unless no type is configured in which case report the
+            // original type as was done before the type could be configured.
             if (infoPgCipherPass(infoBackupPg(info)) != NULL)
-                kvPut(varKv(stanzaInfo), STANZA_KEY_CIPHER_VAR, VARSTR(CIPHER_TYPE_AES_256_CBC_STR));
+            {
+                kvPut(
+                    varKv(stanzaInfo), STANZA_KEY_CIPHER_VAR,
+                    VARSTR(
+                        cipherType(cfgOptionStr(cfgOptRepoCipherType)) == cipherTypeNone ?
+                            CIPHER_TYPE_AES_256_CBC_STR : cfgOptionStr(cfgOptRepoCipherType)));
+            }
 
             for (unsigned int pgIdx = infoPgDataTotal(infoBackupPg(info)) - 1; (int)pgIdx >= 0; pgIdx--)
             {
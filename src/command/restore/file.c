@@ -8,16 +8,16 @@ Restore File
 #include <utime.h>
 
 #include "command/restore/file.h"
-#include "common/compress/gzip/common.h"
-#include "common/compress/gzip/decompress.h"
-#include "common/crypto/cipherBlock.h"
+#include "command/restore/pageDelta.h"
+#include "common/compress/helper.h"
+#include "common/crypto/helper.h"
 #include "common/crypto/hash.h"
 #include "common/debug.h"
 #include "common/io/filter/group.h"
 #include "common/io/filter/size.h"
 #include "common/io/io.h"
 #include "common/log.h"
-#include "config/config.h"
+#include "postgres/interface.h"
 #include "storage/helper.h"
 
 /***********************************************************************************************************************************
@@ -25,15 +25,18 @@ Copy a file from the backup to the specified destination
 ***********************************************************************************************************************************/
 bool
 restoreFile(
-    const String *repoFile, const String *repoFileReference, bool repoFileCompressed, const String *pgFile,
-    const String *pgFileChecksum, bool pgFileZero, uint64_t pgFileSize, time_t pgFileModified, mode_t pgFileMode,
-    const String *pgFileUser, const String *pgFileGroup, time_t copyTimeBegin, bool delta, bool deltaForce,
-    const String *cipherPass)
+    const String *repoFile, const String *repoFileReference, CompressType repoFileCompressType, const String *repoFilePageDeltaBase,
+    CompressType repoFilePageDeltaBaseCompressType, const String *pgFile, const String *pgFileChecksum, bool pgFileZero,
+    uint64_t pgFileSize, time_t pgFileModified, mode_t pgFileMode, const String *pgFileUser, const String *pgFileGroup,
+    time_t copyTimeBegin, bool delta, bool deltaForce, CipherType cipherType, const String *cipherPass,
+    unsigned int cipherThreadTotal)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, repoFile);
         FUNCTION_LOG_PARAM(STRING, repoFileReference);
-        FUNCTION_LOG_PARAM(BOOL, repoFileCompressed);
+        FUNCTION_LOG_PARAM(ENUM, repoFileCompressType);
+        FUNCTION_LOG_PARAM(STRING, repoFilePageDeltaBase);
+        FUNCTION_LOG_PARAM(ENUM, repoFilePageDeltaBaseCompressType);
         FUNCTION_LOG_PARAM(STRING, pgFile);
         FUNCTION_LOG_PARAM(STRING, pgFileChecksum);
         FUNCTION_LOG_PARAM(BOOL, pgFileZero);
@@ -45,12 +48,15 @@ restoreFile(
         FUNCTION_LOG_PARAM(INT64, copyTimeBegin);
         FUNCTION_LOG_PARAM(BOOL, delta);
         FUNCTION_LOG_PARAM(BOOL, deltaForce);
+        FUNCTION_LOG_PARAM(ENUM, cipherType);
         FUNCTION_TEST_PARAM(STRING, cipherPass);
+        FUNCTION_LOG_PARAM(UINT, cipherThreadTotal);
     FUNCTION_LOG_END();
 
     ASSERT(repoFile != NULL);
     ASSERT(repoFileReference != NULL);
     ASSERT(pgFile != NULL);
+    ASSERT((cipherType == cipherTypeNone && cipherPass == NULL) || (cipherType != cipherTypeNone && cipherPass != NULL));
 
     // Was the file copied?
     bool result = true;
@@ -58,7 +64,7 @@ restoreFile(
     // Is the file compressible during the copy?
     bool compressible = true;
 
-    MEM_CONTEXT_TEMP_BEGIN()
+    MEM_CONTEXT_TEMP_ARENA_BEGIN()
     {
         // Perform delta if requested.  Delta zero-length files to avoid overwriting the file if the timestamp is correct.
         if (delta && !pgFileZero)
@@ -146,16 +152,46 @@ restoreFile(
                 IoFilterGroup *filterGroup = ioWriteFilterGroup(storageWriteIo(pgFileWrite));
 
                 // Add decryption filter
-                if (cipherPass != NULL)
+                if (cipherType != cipherTypeNone)
                 {
-                    ioFilterGroupAdd(filterGroup, cipherBlockNew(cipherModeDecrypt, cipherTypeAes256Cbc, BUFSTR(cipherPass), NULL));
+                    ioFilterGroupAdd(
+                        filterGroup,
+                        cipherFilter(
+                            cipherModeDecrypt, cipherType, BUFSTR(cipherPass),
+                            pgFileSize > CIPHER_THREAD_SIZE_MIN ? cipherThreadTotal : 1));
                     compressible = false;
                 }
 
                 // Add decompression filter
-                if (repoFileCompressed)
+                if (repoFileCompressType != compressTypeNone)
                 {
-                    ioFilterGroupAdd(filterGroup, gzipDecompressNew(false));
+                    ioFilterGroupAdd(filterGroup, decompressFilter(repoFileCompressType));
+                    compressible = false;
+                }
+
+                // If the repo file is a page delta then merge it with the base
+                if (repoFilePageDeltaBase != NULL)
+                {
+                    IoRead *baseRead = storageReadIo(
+                        storageNewReadNP(
+                            storageRepo(),
+                            strNewFmt(
+                                STORAGE_REPO_BACKUP "/%s/%s%s", strPtr(repoFilePageDeltaBase), strPtr(repoFile),
+                                strPtr(compressExtStr(repoFilePageDeltaBaseCompressType)))));
+
+                    if (cipherType != cipherTypeNone)
+                    {
+                        ioFilterGroupAdd(
+                            ioReadFilterGroup(baseRead),
+                            cipherFilter(cipherModeDecrypt, cipherType, BUFSTR(cipherPass), 1));
+                    }
+
+                    if (repoFilePageDeltaBaseCompressType != compressTypeNone)
+                        ioFilterGroupAdd(ioReadFilterGroup(baseRead), decompressFilter(repoFilePageDeltaBaseCompressType));
+
+                    ioReadOpen(baseRead);
+
+                    ioFilterGroupAdd(filterGroup, pageDeltaMergeNew(baseRead, PG_PAGE_SIZE_DEFAULT));
                     compressible = false;
                 }
 
@@ -165,13 +201,18 @@ restoreFile(
                 // Add size filter
                 ioFilterGroupAdd(filterGroup, ioSizeNew());
 
+                // Run filters in threads for large files when enabled, except when merging a page delta since the base would be
+                // read from the repo in a thread while the repo file is read in the main thread.
+                ioFilterGroupThreadSet(
+                    filterGroup, ioFilterThread() && pgFileSize > ioBufferSize() && repoFilePageDeltaBase == NULL);
+
                 // Copy file
                 storageCopyNP(
                     storageNewReadP(
                         storageRepo(),
                         strNewFmt(
                             STORAGE_REPO_BACKUP "/%s/%s%s", strPtr(repoFileReference), strPtr(repoFile),
-                            repoFileCompressed ? "." GZIP_EXT : ""),
+                            strPtr(compressExtStr(repoFileCompressType))),
                         .compressible = compressible),
                     pgFileWrite);
 
@@ -0,0 +1,317 @@
+/***********************************************************************************************************************************
+Page Delta Merge Filter
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#include "command/backup/pageDelta.h"
+#include "command/restore/pageDelta.h"
+#include "common/debug.h"
+#include "common/io/filter/filter.intern.h"
+#include "common/log.h"
+#include "common/memContext.h"
+#include "common/object.h"
+
+/***********************************************************************************************************************************
+Filter type constant
+***********************************************************************************************************************************/
+STRING_EXTERN(PAGE_DELTA_MERGE_FILTER_TYPE_STR,                     PAGE_DELTA_MERGE_FILTER_TYPE);
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+typedef struct PageDeltaMerge
+{
+    MemContext *memContext;                                         // Mem context of filter
+
+    IoRead *base;                                                   // Base the delta is merged with
+    size_t pageSize;                                                // Page size
+    unsigned int pageNo;                                            // Current page in the relation
+
+    Buffer *map;                                                    // Map size and bitmap, which may be split across inputs
+    size_t mapSize;                                                 // Size of the range covered by the current map
+    unsigned int mapPageTotal;                                      // Pages in the current map (0 when the map has not been read)
+    unsigned int mapPageIdx;                                        // Current page in the map
+
+    Buffer *basePage;                                               // Current page read from the base
+    bool basePageRead;                                              // Has the current page been read from the base?
+    size_t pageOffset;                                              // Bytes of the current page that have been output
+
+    size_t inputOffset;                                             // Offset into input when output was full before input was used
+    bool inputSame;                                                 // Is the same input required on the next process call?
+    bool done;                                                      // Has the end of the delta been reached?
+} PageDeltaMerge;
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+static String *
+pageDeltaMergeToLog(const PageDeltaMerge *this)
+{
+    return strNewFmt(
+        "{pageNo: %u, inputSame: %s, done: %s}", this->pageNo, cvtBoolToConstZ(this->inputSame), cvtBoolToConstZ(this->done));
+}
+
+#define FUNCTION_LOG_PAGE_DELTA_MERGE_TYPE                                                                                         \
+    PageDeltaMerge *
+#define FUNCTION_LOG_PAGE_DELTA_MERGE_FORMAT(value, buffer, bufferSize)                                                            \
+    FUNCTION_LOG_STRING_OBJECT_FORMAT(value, pageDeltaMergeToLog, buffer, bufferSize)
+
+/***********************************************************************************************************************************
+Read the map header from the input
+
+Return false if more input is required.
+***********************************************************************************************************************************/
+static bool
+pageDeltaMergeMap(PageDeltaMerge *this, const Buffer *input)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PAGE_DELTA_MERGE, this);
+        FUNCTION_TEST_PARAM(BUFFER, input);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->mapPageTotal == 0);
+
+    bool result = false;
+
+    do
+    {
+        // The size is required first and then the bitmap, which depends on the size
+        size_t mapHeaderSize = PAGE_DELTA_MAP_HEADER_SIZE;
+
+        if (bufUsed(this->map) >= PAGE_DELTA_MAP_HEADER_SIZE)
+        {
+            // Get the size of the range covered by the map
+            if (this->mapSize == 0)
+            {
+                const unsigned char *map = bufPtr(this->map);
+                this->mapSize = (size_t)map[0] << 24 | (size_t)map[1] << 16 | (size_t)map[2] << 8 | (size_t)map[3];
+
+                // A size of zero marks the end of the delta
+                if (this->mapSize == 0)
+                {
+                    this->done = true;
+                    break;
+                }
+
+                if ((this->mapSize + this->pageSize - 1) / this->pageSize > PAGE_DELTA_MAP_PAGE_MAX)
+                {
+                    THROW_FMT(
+                        FormatError, "page delta map at page %u covers more than %u pages", this->pageNo, PAGE_DELTA_MAP_PAGE_MAX);
+                }
+            }
+
+            unsigned int mapPageTotal = (unsigned int)((this->mapSize + this->pageSize - 1) / this->pageSize);
+            mapHeaderSize += PAGE_DELTA_MAP_BITMAP_SIZE(mapPageTotal);
+
+            // The map header is complete
+            if (bufUsed(this->map) == mapHeaderSize)
+            {
+                this->mapPageTotal = mapPageTotal;
+                this->mapPageIdx = 0;
+                result = true;
+                break;
+            }
+        }
+
+        // Need more input to complete the header
+        if (input == NULL || this->inputOffset == bufUsed(input))
+            break;
+
+        size_t inputRemains = bufUsed(input) - this->inputOffset;
+        size_t copySize = mapHeaderSize - bufUsed(this->map);
+
+        if (copySize > inputRemains)
+            copySize = inputRemains;
+
+        bufCatSub(this->map, input, this->inputOffset, copySize);
+        this->inputOffset += copySize;
+    }
+    while (true);
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Merge the delta with the base
+***********************************************************************************************************************************/
+static void
+pageDeltaMergeProcess(THIS_VOID, const Buffer *input, Buffer *output)
+{
+    THIS(PageDeltaMerge);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(PAGE_DELTA_MERGE, this);
+        FUNCTION_LOG_PARAM(BUFFER, input);
+        FUNCTION_LOG_PARAM(BUFFER, output);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(output != NULL);
+
+    while (!bufFull(output))
+    {
+        // Read the map header if there is no current map
+        if (this->mapPageTotal == 0 && !pageDeltaMergeMap(this, input))
+        {
+            // Stop when the end of the delta has been reached
+            if (this->done)
+            {
+                if (input != NULL && this->inputOffset < bufUsed(input))
+                    THROW(FormatError, "unexpected data after end of page delta");
+
+                break;
+            }
+
+            // Else more input is required
+            if (input == NULL)
+                THROW(FormatError, "unexpected end of page delta");
+
+            break;
+        }
+
+        size_t pageSize = this->mapSize - this->mapPageIdx * this->pageSize;
+
+        if (pageSize > this->pageSize)
+            pageSize = this->pageSize;
+
+        bool pageStored = bufPtr(this->map)[PAGE_DELTA_MAP_HEADER_SIZE + this->mapPageIdx / 8] & (0x80 >> (this->mapPageIdx % 8));
+
+        // Read the page from the base, even if it is stored in the delta, so the base stays aligned with the delta
+        if (!this->basePageRead)
+        {
+            bufUsedZero(this->basePage);
+            bufLimitSet(this->basePage, pageSize);
+            ioRead(this->base, this->basePage);
+            bufLimitClear(this->basePage);
+
+            if (!pageStored && bufUsed(this->basePage) != pageSize)
+                THROW_FMT(FormatError, "page %u is not stored in page delta and is missing from base", this->pageNo);
+
+            this->basePageRead = true;
+        }
+
+        // Copy the page from the delta or the base
+        size_t copySize = pageSize - this->pageOffset;
+
+        if (copySize > bufRemains(output))
+            copySize = bufRemains(output);
+
+        if (pageStored)
+        {
+            // More input is required
+            if (input == NULL || this->inputOffset == bufUsed(input))
+            {
+                if (input == NULL)
+                    THROW(FormatError, "unexpected end of page delta");
+
+                break;
+            }
+
+            if (copySize > bufUsed(input) - this->inputOffset)
+                copySize = bufUsed(input) - this->inputOffset;
+
+            bufCatSub(output, input, this->inputOffset, copySize);
+            this->inputOffset += copySize;
+        }
+        else
+            bufCatSub(output, this->basePage, this->pageOffset, copySize);
+
+        this->pageOffset += copySize;
+
+        // Move to the next page when this one is complete
+        if (this->pageOffset == pageSize)
+        {
+            this->pageNo++;
+            this->pageOffset = 0;
+            this->basePageRead = false;
+            this->mapPageIdx++;
+
+            // Move to the next map when this one is complete
+            if (this->mapPageIdx == this->mapPageTotal)
+            {
+                this->mapPageTotal = 0;
+                this->mapSize = 0;
+                bufUsedZero(this->map);
+            }
+        }
+    }
+
+    // The same input is required if it was not all used
+    this->inputSame = input != NULL && this->inputOffset < bufUsed(input);
+
+    if (!this->inputSame)
+        this->inputOffset = 0;
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Is the merge done?
+***********************************************************************************************************************************/
+static bool
+pageDeltaMergeDone(const THIS_VOID)
+{
+    THIS(const PageDeltaMerge);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PAGE_DELTA_MERGE, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->done);
+}
+
+/***********************************************************************************************************************************
+Is the same input required on the next process call?
+***********************************************************************************************************************************/
+static bool
+pageDeltaMergeInputSame(const THIS_VOID)
+{
+    THIS(const PageDeltaMerge);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PAGE_DELTA_MERGE, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->inputSame);
+}
+
+/***********************************************************************************************************************************
+New object
+***********************************************************************************************************************************/
+IoFilter *
+pageDeltaMergeNew(IoRead *base, size_t pageSize)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(IO_READ, base);
+        FUNCTION_LOG_PARAM(SIZE, pageSize);
+    FUNCTION_LOG_END();
+
+    ASSERT(base != NULL);
+    ASSERT(pageSize > 0);
+
+    IoFilter *this = NULL;
+
+    MEM_CONTEXT_NEW_BEGIN("PageDeltaMerge")
+    {
+        PageDeltaMerge *driver = memNew(sizeof(PageDeltaMerge));
+        driver->memContext = memContextCurrent();
+
+        driver->base = base;
+        driver->pageSize = pageSize;
+
+        driver->map = bufNew(PAGE_DELTA_MAP_HEADER_SIZE + PAGE_DELTA_MAP_BITMAP_SIZE(PAGE_DELTA_MAP_PAGE_MAX));
+        driver->basePage = bufNew(pageSize);
+
+        this = ioFilterNewP(
+            PAGE_DELTA_MERGE_FILTER_TYPE_STR, driver, NULL, .done = pageDeltaMergeDone, .inOut = pageDeltaMergeProcess,
+            .inputSame = pageDeltaMergeInputSame);
+    }
+    MEM_CONTEXT_NEW_END();
+
+    FUNCTION_LOG_RETURN(IO_FILTER, this);
+}
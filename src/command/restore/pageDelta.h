@@ -0,0 +1,27 @@
+/***********************************************************************************************************************************
+Page Delta Merge Filter
+
+Merge a page delta (see command/backup/pageDelta.h) with the base copy of the relation it was generated against.  The delta is the
+filter input and the base is read sequentially from the IoRead passed to the constructor, which must already be open.  The output is
+the complete relation.
+
+The filter cannot be sent to a remote since the base read is local, so it should be added to the filter group of the destination.
+***********************************************************************************************************************************/
+#ifndef COMMAND_RESTORE_PAGE_DELTA_H
+#define COMMAND_RESTORE_PAGE_DELTA_H
+
+#include "common/io/filter/filter.h"
+#include "common/io/read.h"
+
+/***********************************************************************************************************************************
+Filter type constant
+***********************************************************************************************************************************/
+#define PAGE_DELTA_MERGE_FILTER_TYPE                                "pageDeltaMerge"
+    STRING_DECLARE(PAGE_DELTA_MERGE_FILTER_TYPE_STR);
+
+/***********************************************************************************************************************************
+Constructor
+***********************************************************************************************************************************/
+IoFilter *pageDeltaMergeNew(IoRead *base, size_t pageSize);
+
+#endif
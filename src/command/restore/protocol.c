@@ -41,18 +41,24 @@ restoreProtocol(const String *command, const VariantList *paramList, ProtocolSer
     {
         if (strEq(command, PROTOCOL_COMMAND_RESTORE_FILE_STR))
         {
+            // The cipher pass is only sent when the repo is encrypted
+            const String *cipherPass = varLstSize(paramList) == 18 ? varStr(varLstGet(paramList, 17)) : NULL;
+
             protocolServerResponse(
                 server,
                 VARBOOL(
                     restoreFile(varStr(varLstGet(paramList, 6)),
                         varLstGet(paramList, 7) ? varStr(varLstGet(paramList, 7)) : varStr(varLstGet(paramList, 13)),
-                        varBoolForce(varLstGet(paramList, 14)), varStr(varLstGet(paramList, 0)), varStr(varLstGet(paramList, 3)),
+                        compressType(varStr(varLstGet(paramList, 14))), varStr(varLstGet(paramList, 15)),
+                        compressType(varStr(varLstGet(paramList, 16))), varStr(varLstGet(paramList, 0)),
+                        varStr(varLstGet(paramList, 3)),
                         varBoolForce(varLstGet(paramList, 4)), varUInt64(varLstGet(paramList, 1)),
                         (time_t)varInt64Force(varLstGet(paramList, 2)), cvtZToUIntBase(strPtr(varStr(varLstGet(paramList, 8))), 8),
                         varStr(varLstGet(paramList, 9)), varStr(varLstGet(paramList, 10)),
                         (time_t)varInt64Force(varLstGet(paramList, 11)), varBoolForce(varLstGet(paramList, 12)),
                         varBoolForce(varLstGet(paramList, 5)),
-                        varLstSize(paramList) == 16 ? varStr(varLstGet(paramList, 15)) : NULL)));
+                        cipherPass != NULL ? cipherType(cfgOptionStr(cfgOptRepoCipherType)) : cipherTypeNone, cipherPass,
+                        cfgOptionUInt(cfgOptCipherThread))));
         }
         else
             found = false;
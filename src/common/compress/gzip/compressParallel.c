@@ -0,0 +1,578 @@
+/***********************************************************************************************************************************
+Gzip Parallel Compress
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <zlib.h>
+
+#include "common/compress/gzip/common.h"
+#include "common/compress/gzip/compressParallel.h"
+#include "common/debug.h"
+#include "common/io/filter/filter.intern.h"
+#include "common/log.h"
+#include "common/memContext.h"
+#include "common/object.h"
+
+/***********************************************************************************************************************************
+Filter type constant
+***********************************************************************************************************************************/
+STRING_EXTERN(GZIP_COMPRESS_PARALLEL_FILTER_TYPE_STR,               GZIP_COMPRESS_PARALLEL_FILTER_TYPE);
+
+/***********************************************************************************************************************************
+Compression constants
+***********************************************************************************************************************************/
+#define MEM_LEVEL                                                   9
+
+// Size of the dictionary passed from a block to the next block (the size of the deflate window)
+#define DICTIONARY_SIZE                                             ((size_t)32 * 1024)
+
+// Size of the gzip header and trailer
+#define HEADER_SIZE                                                 10
+#define TRAILER_SIZE                                                8
+
+// Extra space for the output of a block in addition to deflateBound() for the flush at the end of the block
+#define OUTPUT_EXTRA                                                64
+
+// Maximum size of an error message from a thread
+#define ERROR_MESSAGE_SIZE                                          4096
+
+/***********************************************************************************************************************************
+Block of input to be compressed
+
+Jobs are a ring that is filled with input by gzipCompressParallelProcess(), compressed by any thread, and then written to the output
+in order by gzipCompressParallelProcess().  The counters that track the jobs only ever increase so a job is free when it has been
+written to the output.
+***********************************************************************************************************************************/
+typedef struct GzipCompressParallelJob
+{
+    unsigned char *input;                                           // Block of uncompressed input
+    size_t inputSize;                                               // Size of input
+    unsigned char *dictionary;                                      // End of the prior block
+    size_t dictionarySize;                                          // Size of dictionary
+    unsigned char *output;                                          // Compressed output
+    size_t outputSize;                                              // Size of output
+    bool last;                                                      // Is this the last block?
+    bool done;                                                      // Has the block been compressed?
+    uLong crc;                                                      // Crc32 of the input
+} GzipCompressParallelJob;
+
+/***********************************************************************************************************************************
+Thread that compresses jobs
+***********************************************************************************************************************************/
+typedef struct GzipCompressParallelThread
+{
+    struct GzipCompressParallel *parallel;                          // Filter that the thread compresses jobs for
+    z_stream *stream;                                               // Raw compression stream used by the thread
+    pthread_t thread;                                               // Thread
+} GzipCompressParallelThread;
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+#define GZIP_COMPRESS_PARALLEL_TYPE                                 GzipCompressParallel
+#define GZIP_COMPRESS_PARALLEL_PREFIX                               gzipCompressParallel
+
+typedef struct GzipCompressParallel
+{
+    MemContext *memContext;                                         // Context to store data
+    int level;                                                      // Compression level
+
+    pthread_mutex_t mutex;                                          // Mutex for all job and thread state
+    pthread_cond_t cond;                                            // Signaled whenever job or thread state changes
+    GzipCompressParallelThread *threadList;                         // Threads
+    unsigned int threadTotal;                                       // Total threads
+    unsigned int threadStarted;                                     // Threads started
+
+    GzipCompressParallelJob *jobList;                               // Ring of jobs
+    unsigned int jobTotal;                                          // Total jobs in the ring
+    size_t jobOutputMax;                                            // Size of job output excluding the gzip trailer
+    uint64_t jobPut;                                                // Jobs filled with input
+    uint64_t jobGet;                                                // Jobs taken by threads
+    uint64_t jobOutput;                                             // Jobs written to output
+    size_t inputSize;                                               // Size of input in the job being filled
+    size_t outputOffset;                                            // Offset into the output of the job being written
+
+    uLong crc;                                                      // Crc32 of all jobs written to output
+    uint64_t size;                                                  // Size of input for all jobs written to output
+
+    bool abort;                                                     // Should the threads stop?
+    const ErrorType *errorType;                                     // Type of error thrown in a thread
+    char errorMessage[ERROR_MESSAGE_SIZE];                          // Message of error thrown in a thread
+
+    size_t inputOffset;                                             // Offset into input when a job was not available
+    bool inputSame;                                                 // Is the same input required on the next process call?
+    bool flush;                                                     // Is input complete and flushing in progress?
+    bool lastPut;                                                   // Has the last job been filled?
+    bool done;                                                      // Is compression done?
+} GzipCompressParallel;
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+static String *
+gzipCompressParallelToLog(const GzipCompressParallel *this)
+{
+    return strNewFmt(
+        "{inputSame: %s, done: %s, flushing: %s, jobPut: %" PRIu64 ", jobOutput: %" PRIu64 "}", cvtBoolToConstZ(this->inputSame),
+        cvtBoolToConstZ(this->done), cvtBoolToConstZ(this->flush), this->jobPut, this->jobOutput);
+}
+
+#define FUNCTION_LOG_GZIP_COMPRESS_PARALLEL_TYPE                                                                                   \
+    GzipCompressParallel *
+#define FUNCTION_LOG_GZIP_COMPRESS_PARALLEL_FORMAT(value, buffer, bufferSize)                                                      \
+    FUNCTION_LOG_STRING_OBJECT_FORMAT(value, gzipCompressParallelToLog, buffer, bufferSize)
+
+/***********************************************************************************************************************************
+Stop threads and free deflate streams
+***********************************************************************************************************************************/
+OBJECT_DEFINE_FREE_RESOURCE_BEGIN(GZIP_COMPRESS_PARALLEL, LOG, logLevelTrace)
+{
+    pthread_mutex_lock(&this->mutex);
+    this->abort = true;
+    pthread_cond_broadcast(&this->cond);
+    pthread_mutex_unlock(&this->mutex);
+
+    for (unsigned int threadIdx = 0; threadIdx < this->threadStarted; threadIdx++)
+        pthread_join(this->threadList[threadIdx].thread, NULL);
+
+    for (unsigned int threadIdx = 0; threadIdx < this->threadTotal; threadIdx++)
+        deflateEnd(this->threadList[threadIdx].stream);
+
+    pthread_cond_destroy(&this->cond);
+    pthread_mutex_destroy(&this->mutex);
+}
+OBJECT_DEFINE_FREE_RESOURCE_END(LOG);
+
+/***********************************************************************************************************************************
+Compress a job
+***********************************************************************************************************************************/
+static void
+gzipCompressParallelJob(GzipCompressParallel *this, z_stream *stream, GzipCompressParallelJob *job)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(GZIP_COMPRESS_PARALLEL, this);
+        FUNCTION_LOG_PARAM_P(VOID, stream);
+        FUNCTION_LOG_PARAM_P(VOID, job);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(stream != NULL);
+    ASSERT(job != NULL);
+
+    gzipError(deflateReset(stream));
+
+    // Prime the stream with the end of the prior block so matches can reference it
+    if (job->dictionarySize > 0)
+        gzipError(deflateSetDictionary(stream, job->dictionary, (uInt)job->dictionarySize));
+
+    stream->next_in = job->input;
+    stream->avail_in = (uInt)job->inputSize;
+    stream->next_out = job->output + job->outputSize;
+    stream->avail_out = (uInt)(this->jobOutputMax - job->outputSize);
+
+    // Finish the last block.  Flush all other blocks so they end on a byte boundary and can be concatenated.
+    int result = gzipError(deflate(stream, job->last ? Z_FINISH : Z_SYNC_FLUSH));
+    CHECK(stream->avail_in == 0 && (!job->last || result == Z_STREAM_END));
+
+    job->outputSize = (size_t)(stream->next_out - job->output);
+    job->crc = crc32(0L, job->input, (uInt)job->inputSize);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Thread that compresses jobs until stopped
+***********************************************************************************************************************************/
+static void *
+gzipCompressParallelThread(void *threadVoid)
+{
+    GzipCompressParallelThread *thread = threadVoid;
+    GzipCompressParallel *this = thread->parallel;
+
+    TRY_BEGIN()
+    {
+        pthread_mutex_lock(&this->mutex);
+
+        while (true)
+        {
+            // Wait for a job
+            while (!this->abort && this->jobGet == this->jobPut)
+                pthread_cond_wait(&this->cond, &this->mutex);
+
+            if (this->abort)
+                break;
+
+            GzipCompressParallelJob *job = &this->jobList[this->jobGet % this->jobTotal];
+            this->jobGet++;
+
+            pthread_mutex_unlock(&this->mutex);
+            gzipCompressParallelJob(this, thread->stream, job);
+            pthread_mutex_lock(&this->mutex);
+
+            job->done = true;
+            pthread_cond_broadcast(&this->cond);
+        }
+
+        pthread_mutex_unlock(&this->mutex);
+    }
+    CATCH_ANY()
+    {
+        // Store the first error so it can be thrown by gzipCompressParallelProcess() and stop the other threads
+        pthread_mutex_lock(&this->mutex);
+
+        if (this->errorType == NULL)
+        {
+            this->errorType = errorType();
+            strncpy(this->errorMessage, errorMessage(), sizeof(this->errorMessage) - 1);
+        }
+
+        this->abort = true;
+        pthread_cond_broadcast(&this->cond);
+        pthread_mutex_unlock(&this->mutex);
+    }
+    TRY_END();
+
+    return NULL;
+}
+
+/***********************************************************************************************************************************
+Start threads
+
+Threads are started on the first process call so no threads are started for a filter that is only created to be passed to a remote.
+***********************************************************************************************************************************/
+static void
+gzipCompressParallelThreadStart(GzipCompressParallel *this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(GZIP_COMPRESS_PARALLEL, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    for (unsigned int threadIdx = 0; threadIdx < this->threadTotal; threadIdx++)
+    {
+        int result = pthread_create(
+            &this->threadList[threadIdx].thread, NULL, gzipCompressParallelThread, &this->threadList[threadIdx]);
+
+        if (result != 0)
+        {
+            errno = result;
+            THROW_SYS_ERROR(KernelError, "unable to create compress thread");
+        }
+
+        this->threadStarted++;
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Queue the job being filled to be compressed
+
+Must be called with the mutex locked.
+***********************************************************************************************************************************/
+static void
+gzipCompressParallelJobPut(GzipCompressParallel *this, bool last)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(GZIP_COMPRESS_PARALLEL, this);
+        FUNCTION_TEST_PARAM(BOOL, last);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    GzipCompressParallelJob *job = &this->jobList[this->jobPut % this->jobTotal];
+    job->inputSize = this->inputSize;
+    job->dictionarySize = 0;
+    job->outputSize = 0;
+    job->last = last;
+
+    // The first job starts with the gzip header
+    if (this->jobPut == 0)
+    {
+        job->output[0] = 0x1f;                                      // Magic
+        job->output[1] = 0x8b;
+        job->output[2] = Z_DEFLATED;                                // Compression method
+        job->output[3] = 0;                                         // Flags
+        memset(job->output + 4, 0, 4);                              // Modification time
+        job->output[8] = (unsigned char)(this->level == 9 ? 2 : (this->level == 1 ? 4 : 0));
+        job->output[9] = 3;                                         // OS (unix)
+
+        job->outputSize = HEADER_SIZE;
+    }
+    // Else copy the end of the prior block as the dictionary.  The prior job cannot be reused until this job has been put so the
+    // input is still available even if the prior job has already been written.
+    else
+    {
+        const GzipCompressParallelJob *jobPrior = &this->jobList[(this->jobPut - 1) % this->jobTotal];
+
+        job->dictionarySize = jobPrior->inputSize > DICTIONARY_SIZE ? DICTIONARY_SIZE : jobPrior->inputSize;
+        memcpy(job->dictionary, jobPrior->input + jobPrior->inputSize - job->dictionarySize, job->dictionarySize);
+    }
+
+    this->inputSize = 0;
+    this->jobPut++;
+    this->lastPut = last;
+    pthread_cond_broadcast(&this->cond);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Compress data
+***********************************************************************************************************************************/
+static void
+gzipCompressParallelProcess(THIS_VOID, const Buffer *uncompressed, Buffer *compressed)
+{
+    THIS(GzipCompressParallel);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(GZIP_COMPRESS_PARALLEL, this);
+        FUNCTION_LOG_PARAM(BUFFER, uncompressed);
+        FUNCTION_LOG_PARAM(BUFFER, compressed);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(!this->done);
+    ASSERT(compressed != NULL);
+    ASSERT(!this->flush || uncompressed == NULL);
+
+    // Flushing
+    if (uncompressed == NULL)
+        this->flush = true;
+
+    // Start threads
+    if (this->threadStarted == 0)
+        gzipCompressParallelThreadStart(this);
+
+    bool abort = false;
+
+    pthread_mutex_lock(&this->mutex);
+
+    while (!(abort = this->abort) && !this->done)
+    {
+        bool outputFull = bufFull(compressed);
+        GzipCompressParallelJob *job = &this->jobList[this->jobOutput % this->jobTotal];
+
+        // Write the oldest job to the output when it has been compressed
+        if (!outputFull && this->jobOutput < this->jobPut && job->done)
+        {
+            // Add the gzip trailer to the last job before it is written
+            if (job->last && this->outputOffset == 0)
+            {
+                this->crc = crc32_combine(this->crc, job->crc, (z_off_t)job->inputSize);
+                this->size += job->inputSize;
+
+                for (unsigned int byteIdx = 0; byteIdx < 4; byteIdx++)
+                {
+                    job->output[job->outputSize + byteIdx] = (unsigned char)(this->crc >> (byteIdx * 8));
+                    job->output[job->outputSize + 4 + byteIdx] = (unsigned char)(this->size >> (byteIdx * 8));
+                }
+
+                job->outputSize += TRAILER_SIZE;
+            }
+
+            size_t outputSize = job->outputSize - this->outputOffset;
+
+            if (outputSize > bufRemains(compressed))
+                outputSize = bufRemains(compressed);
+
+            bufCatC(compressed, job->output, this->outputOffset, outputSize);
+            this->outputOffset += outputSize;
+
+            // Free the job when it has been written
+            if (this->outputOffset == job->outputSize)
+            {
+                if (job->last)
+                    this->done = true;
+                else
+                {
+                    this->crc = crc32_combine(this->crc, job->crc, (z_off_t)job->inputSize);
+                    this->size += job->inputSize;
+                }
+
+                job->done = false;
+                this->outputOffset = 0;
+                this->jobOutput++;
+            }
+
+            continue;
+        }
+
+        bool jobFree = this->jobPut - this->jobOutput < this->jobTotal;
+
+        // Fill a job with input
+        if (uncompressed != NULL && this->inputOffset < bufUsed(uncompressed))
+        {
+            if (jobFree)
+            {
+                job = &this->jobList[this->jobPut % this->jobTotal];
+
+                size_t inputSize = bufUsed(uncompressed) - this->inputOffset;
+
+                if (inputSize > GZIP_COMPRESS_PARALLEL_BLOCK_SIZE - this->inputSize)
+                    inputSize = GZIP_COMPRESS_PARALLEL_BLOCK_SIZE - this->inputSize;
+
+                memcpy(job->input + this->inputSize, bufPtr(uncompressed) + this->inputOffset, inputSize);
+                this->inputSize += inputSize;
+                this->inputOffset += inputSize;
+
+                if (this->inputSize == GZIP_COMPRESS_PARALLEL_BLOCK_SIZE)
+                    gzipCompressParallelJobPut(this, false);
+
+                continue;
+            }
+        }
+        // Put the last job, even if it is empty, to end the stream
+        else if (this->flush)
+        {
+            if (!this->lastPut && jobFree)
+            {
+                gzipCompressParallelJobPut(this, true);
+                continue;
+            }
+        }
+        // Else all the input has been used
+        else
+            break;
+
+        // No progress can be made until there is space in the output
+        if (outputFull)
+            break;
+
+        // Wait for a job to be compressed
+        pthread_cond_wait(&this->cond, &this->mutex);
+    }
+
+    pthread_mutex_unlock(&this->mutex);
+
+    // Throw the error from the thread that failed
+    if (abort)
+        THROWP(this->errorType, this->errorMessage);
+
+    // Can more input be provided on the next call?
+    this->inputSame = this->flush ? !this->done : this->inputOffset < bufUsed(uncompressed);
+
+    if (!this->inputSame)
+        this->inputOffset = 0;
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Is compress done?
+***********************************************************************************************************************************/
+static bool
+gzipCompressParallelDone(const THIS_VOID)
+{
+    THIS(const GzipCompressParallel);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(GZIP_COMPRESS_PARALLEL, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->done);
+}
+
+/***********************************************************************************************************************************
+Is the same input required on the next process call?
+***********************************************************************************************************************************/
+static bool
+gzipCompressParallelInputSame(const THIS_VOID)
+{
+    THIS(const GzipCompressParallel);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(GZIP_COMPRESS_PARALLEL, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->inputSame);
+}
+
+/***********************************************************************************************************************************
+New object
+***********************************************************************************************************************************/
+IoFilter *
+gzipCompressParallelNew(int level, unsigned int threadTotal)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(INT, level);
+        FUNCTION_LOG_PARAM(UINT, threadTotal);
+    FUNCTION_LOG_END();
+
+    ASSERT(level >= -1 && level <= 9);
+    ASSERT(threadTotal > 0);
+
+    IoFilter *this = NULL;
+
+    MEM_CONTEXT_NEW_BEGIN("GzipCompressParallel")
+    {
+        GzipCompressParallel *driver = memNew(sizeof(GzipCompressParallel));
+        driver->memContext = MEM_CONTEXT_NEW();
+        driver->level = level;
+
+        // Create a raw compression stream for each thread
+        driver->threadTotal = threadTotal;
+        driver->threadList = memNew(sizeof(GzipCompressParallelThread) * threadTotal);
+
+        pthread_mutex_init(&driver->mutex, NULL);
+        pthread_cond_init(&driver->cond, NULL);
+        memContextCallbackSet(driver->memContext, gzipCompressParallelFreeResource, driver);
+
+        for (unsigned int threadIdx = 0; threadIdx < threadTotal; threadIdx++)
+        {
+            GzipCompressParallelThread *thread = &driver->threadList[threadIdx];
+            thread->parallel = driver;
+            thread->stream = memNew(sizeof(z_stream));
+
+            gzipError(deflateInit2(thread->stream, level, Z_DEFLATED, gzipWindowBits(true), MEM_LEVEL, Z_DEFAULT_STRATEGY));
+        }
+
+        // Create enough jobs to keep all threads busy while output is being written.  Memory is allocated directly rather than in
+        // Buffer objects since the threads must be stopped before the memory is freed and child contexts are freed first.
+        driver->jobOutputMax =
+            HEADER_SIZE + deflateBound(driver->threadList[0].stream, GZIP_COMPRESS_PARALLEL_BLOCK_SIZE) + OUTPUT_EXTRA;
+
+        driver->jobTotal = threadTotal * 2;
+        driver->jobList = memNew(sizeof(GzipCompressParallelJob) * driver->jobTotal);
+
+        for (unsigned int jobIdx = 0; jobIdx < driver->jobTotal; jobIdx++)
+        {
+            GzipCompressParallelJob *job = &driver->jobList[jobIdx];
+
+            *job = (GzipCompressParallelJob)
+            {
+                .input = memNew(GZIP_COMPRESS_PARALLEL_BLOCK_SIZE),
+                .dictionary = memNew(DICTIONARY_SIZE),
+                .output = memNew(driver->jobOutputMax + TRAILER_SIZE),
+            };
+        }
+
+        // Create param list
+        VariantList *paramList = varLstNew();
+        varLstAdd(paramList, varNewInt(level));
+        varLstAdd(paramList, varNewUInt(threadTotal));
+
+        // Create filter interface
+        this = ioFilterNewP(
+            GZIP_COMPRESS_PARALLEL_FILTER_TYPE_STR, driver, paramList, .done = gzipCompressParallelDone,
+            .inOut = gzipCompressParallelProcess, .inputSame = gzipCompressParallelInputSame);
+    }
+    MEM_CONTEXT_NEW_END();
+
+    FUNCTION_LOG_RETURN(IO_FILTER, this);
+}
+
+IoFilter *
+gzipCompressParallelNewVar(const VariantList *paramList)
+{
+    return gzipCompressParallelNew(varIntForce(varLstGet(paramList, 0)), varUIntForce(varLstGet(paramList, 1)));
+}
@@ -0,0 +1,33 @@
+/***********************************************************************************************************************************
+Gzip Parallel Compress
+
+Compress IO using the gzip format with blocks of input compressed at the same time in threads.  Each block is compressed as an
+independent raw deflate stream primed with the end of the prior block as a dictionary, so compression is nearly as good as a single
+stream.  Blocks other than the last end on a byte boundary so they can be concatenated into a single deflate stream and the output
+is a standard gzip stream that can be read by gzipDecompressNew() or gunzip.
+***********************************************************************************************************************************/
+#ifndef COMMON_COMPRESS_GZIP_COMPRESS_PARALLEL_H
+#define COMMON_COMPRESS_GZIP_COMPRESS_PARALLEL_H
+
+#include "common/io/filter/filter.h"
+
+/***********************************************************************************************************************************
+Filter type constant
+***********************************************************************************************************************************/
+#define GZIP_COMPRESS_PARALLEL_FILTER_TYPE                          "gzipCompressParallel"
+    STRING_DECLARE(GZIP_COMPRESS_PARALLEL_FILTER_TYPE_STR);
+
+/***********************************************************************************************************************************
+Block size
+
+Large enough that the cost of the dictionary and flushing the end of each block is small.
+***********************************************************************************************************************************/
+#define GZIP_COMPRESS_PARALLEL_BLOCK_SIZE                           ((size_t)128 * 1024)
+
+/***********************************************************************************************************************************
+Constructor
+***********************************************************************************************************************************/
+IoFilter *gzipCompressParallelNew(int level, unsigned int threadTotal);
+IoFilter *gzipCompressParallelNewVar(const VariantList *paramList);
+
+#endif
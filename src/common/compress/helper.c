@@ -0,0 +1,345 @@
+/***********************************************************************************************************************************
+Compression Helper
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#include <string.h>
+
+#include "common/compress/gzip/common.h"
+#include "common/compress/gzip/compress.h"
+#include "common/compress/gzip/compressParallel.h"
+#include "common/compress/gzip/decompress.h"
+#include "common/compress/helper.h"
+#include "common/compress/lz4/common.h"
+#include "common/compress/lz4/compress.h"
+#include "common/compress/lz4/decompress.h"
+#include "common/compress/zst/common.h"
+#include "common/compress/zst/compress.h"
+#include "common/compress/zst/decompress.h"
+#include "common/debug.h"
+#include "common/log.h"
+#include "version.h"
+
+/***********************************************************************************************************************************
+Constants
+***********************************************************************************************************************************/
+STRING_EXTERN(COMPRESS_TYPE_NONE_STR,                               COMPRESS_TYPE_NONE);
+
+/***********************************************************************************************************************************
+Compression type data
+***********************************************************************************************************************************/
+static IoFilter *compressGzipNew(int level, unsigned int threadTotal);
+static IoFilter *decompressGzipNew(void);
+
+#ifdef HAVE_LIBLZ4
+static IoFilter *compressLz4New(int level, unsigned int threadTotal);
+#endif
+
+static const struct CompressHelperLocal
+{
+    const char *name;                                               // Type name, which is also the extension without the period
+    const char *ext;                                                // Extension with the period
+    IoFilter *(*compressNew)(int, unsigned int);                    // Compress filter constructor (NULL when not in this build)
+    IoFilter *(*decompressNew)(void);                               // Decompress filter constructor (NULL when not in this build)
+    int levelMin;                                                   // Minimum level
+    int levelMax;                                                   // Maximum level
+    int levelDefault;                                               // Level used when compress-level is not set
+} compressHelperLocal[] =
+{
+    {
+        .name = COMPRESS_TYPE_NONE,
+        .ext = "",
+    },
+    {
+        .name = GZIP_EXT,
+        .ext = "." GZIP_EXT,
+        .compressNew = compressGzipNew,
+        .decompressNew = decompressGzipNew,
+        .levelMin = 0,
+        .levelMax = 9,
+        .levelDefault = 6,
+    },
+    {
+        .name = LZ4_EXT,
+        .ext = "." LZ4_EXT,
+#ifdef HAVE_LIBLZ4
+        .compressNew = compressLz4New,
+        .decompressNew = lz4DecompressNew,
+#endif
+        .levelMin = LZ4_LEVEL_MIN,
+        .levelMax = LZ4_LEVEL_MAX,
+        .levelDefault = LZ4_LEVEL_DEFAULT,
+    },
+    {
+        .name = ZST_EXT,
+        .ext = "." ZST_EXT,
+#ifdef HAVE_LIBZSTD
+        .compressNew = zstCompressNew,
+        .decompressNew = zstDecompressNew,
+#endif
+        .levelMin = ZST_LEVEL_MIN,
+        .levelMax = ZST_LEVEL_MAX,
+        .levelDefault = ZST_LEVEL_DEFAULT,
+    },
+};
+
+#define COMPRESS_HELPER_TOTAL                                                                                                      \
+    (sizeof(compressHelperLocal) / sizeof(struct CompressHelperLocal))
+
+/***********************************************************************************************************************************
+Constructors with the same signature for all compression types
+***********************************************************************************************************************************/
+static IoFilter *
+compressGzipNew(int level, unsigned int threadTotal)
+{
+    return threadTotal > 1 ? gzipCompressParallelNew(level, threadTotal) : gzipCompressNew(level, false);
+}
+
+static IoFilter *
+decompressGzipNew(void)
+{
+    return gzipDecompressNew(false);
+}
+
+#ifdef HAVE_LIBLZ4
+
+// LZ4 is fast enough that compressing in threads is not required
+static IoFilter *
+compressLz4New(int level, unsigned int threadTotal)
+{
+    (void)threadTotal;
+
+    return lz4CompressNew(level);
+}
+
+#endif
+
+/***********************************************************************************************************************************
+Get compression type from name
+***********************************************************************************************************************************/
+CompressType
+compressType(const String *name)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, name);
+    FUNCTION_TEST_END();
+
+    ASSERT(name != NULL);
+
+    CompressType result = compressTypeNone;
+
+    for (; result < COMPRESS_HELPER_TOTAL; result++)
+    {
+        if (strEqZ(name, compressHelperLocal[result].name))
+            break;
+    }
+
+    if (result == COMPRESS_HELPER_TOTAL)
+        THROW_FMT(AssertError, "invalid compression type '%s'", strPtr(name));
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Get name from compression type
+***********************************************************************************************************************************/
+const String *
+compressTypeName(CompressType type)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(ENUM, type);
+    FUNCTION_TEST_END();
+
+    ASSERT(type < COMPRESS_HELPER_TOTAL);
+
+    FUNCTION_TEST_RETURN(strNew(compressHelperLocal[type].name));
+}
+
+/***********************************************************************************************************************************
+Error if the compression type is not available in this build
+***********************************************************************************************************************************/
+void
+compressTypePresent(CompressType type)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(ENUM, type);
+    FUNCTION_TEST_END();
+
+    ASSERT(type < COMPRESS_HELPER_TOTAL);
+
+    if (type != compressTypeNone && compressHelperLocal[type].compressNew == NULL)
+    {
+        THROW_FMT(
+            OptionInvalidValueError, PROJECT_NAME " not compiled with %s support", compressHelperLocal[type].name);
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Get compression type from the file extension
+***********************************************************************************************************************************/
+CompressType
+compressTypeFromName(const String *file)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, file);
+    FUNCTION_TEST_END();
+
+    ASSERT(file != NULL);
+
+    CompressType result = compressTypeNone + 1;
+
+    for (; result < COMPRESS_HELPER_TOTAL; result++)
+    {
+        if (strEndsWithZ(file, compressHelperLocal[result].ext))
+            break;
+    }
+
+    if (result == COMPRESS_HELPER_TOTAL)
+        result = compressTypeNone;
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Get the file extension for the compression type
+***********************************************************************************************************************************/
+const String *
+compressExtStr(CompressType type)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(ENUM, type);
+    FUNCTION_TEST_END();
+
+    ASSERT(type < COMPRESS_HELPER_TOTAL);
+
+    FUNCTION_TEST_RETURN(strNew(compressHelperLocal[type].ext));
+}
+
+/***********************************************************************************************************************************
+Add the extension for the compression type to a file name
+***********************************************************************************************************************************/
+void
+compressExtCat(String *file, CompressType type)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, file);
+        FUNCTION_TEST_PARAM(ENUM, type);
+    FUNCTION_TEST_END();
+
+    ASSERT(file != NULL);
+    ASSERT(type < COMPRESS_HELPER_TOTAL);
+
+    strCat(file, compressHelperLocal[type].ext);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Remove the extension for the compression type from a file name
+***********************************************************************************************************************************/
+String *
+compressExtStrip(const String *file, CompressType type)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, file);
+        FUNCTION_TEST_PARAM(ENUM, type);
+    FUNCTION_TEST_END();
+
+    ASSERT(file != NULL);
+    ASSERT(type < COMPRESS_HELPER_TOTAL);
+
+    const char *ext = compressHelperLocal[type].ext;
+
+    if (!strEndsWithZ(file, ext))
+        THROW_FMT(FormatError, "'%s' must have '%s' extension", strPtr(file), ext);
+
+    FUNCTION_TEST_RETURN(strSubN(file, 0, strSize(file) - strlen(ext)));
+}
+
+/***********************************************************************************************************************************
+Allowed levels for the compression type
+***********************************************************************************************************************************/
+int
+compressLevelMin(CompressType type)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(ENUM, type);
+    FUNCTION_TEST_END();
+
+    ASSERT(type < COMPRESS_HELPER_TOTAL);
+
+    FUNCTION_TEST_RETURN(compressHelperLocal[type].levelMin);
+}
+
+int
+compressLevelMax(CompressType type)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(ENUM, type);
+    FUNCTION_TEST_END();
+
+    ASSERT(type < COMPRESS_HELPER_TOTAL);
+
+    FUNCTION_TEST_RETURN(compressHelperLocal[type].levelMax);
+}
+
+/***********************************************************************************************************************************
+Default level for the compression type
+***********************************************************************************************************************************/
+int
+compressLevelDefault(CompressType type)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(ENUM, type);
+    FUNCTION_TEST_END();
+
+    ASSERT(type < COMPRESS_HELPER_TOTAL);
+
+    FUNCTION_TEST_RETURN(compressHelperLocal[type].levelDefault);
+}
+
+/***********************************************************************************************************************************
+Compress filter for the compression type
+***********************************************************************************************************************************/
+IoFilter *
+compressFilter(CompressType type, int level, unsigned int threadTotal)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(ENUM, type);
+        FUNCTION_LOG_PARAM(INT, level);
+        FUNCTION_LOG_PARAM(UINT, threadTotal);
+    FUNCTION_LOG_END();
+
+    ASSERT(type != compressTypeNone && type < COMPRESS_HELPER_TOTAL);
+    ASSERT(threadTotal > 0);
+
+    compressTypePresent(type);
+
+    if (level < compressHelperLocal[type].levelMin || level > compressHelperLocal[type].levelMax)
+    {
+        THROW_FMT(
+            OptionInvalidValueError, "compress level %d is not valid for %s compression (valid levels are %d-%d)", level,
+            compressHelperLocal[type].name, compressHelperLocal[type].levelMin, compressHelperLocal[type].levelMax);
+    }
+
+    FUNCTION_LOG_RETURN(IO_FILTER, compressHelperLocal[type].compressNew(level, threadTotal));
+}
+
+/***********************************************************************************************************************************
+Decompress filter for the compression type
+***********************************************************************************************************************************/
+IoFilter *
+decompressFilter(CompressType type)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(ENUM, type);
+    FUNCTION_LOG_END();
+
+    ASSERT(type != compressTypeNone && type < COMPRESS_HELPER_TOTAL);
+
+    compressTypePresent(type);
+
+    FUNCTION_LOG_RETURN(IO_FILTER, compressHelperLocal[type].decompressNew());
+}
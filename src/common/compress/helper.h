@@ -0,0 +1,71 @@
+/***********************************************************************************************************************************
+Compression Helper
+
+Select compress and decompress filters by compression type so the commands do not need to know which formats are available.  The
+type name is also the file extension, e.g. a gzip file has the gz extension.  Types other than gzip are optional and are only
+available when the library was found by configure.
+***********************************************************************************************************************************/
+#ifndef COMMON_COMPRESS_HELPER_H
+#define COMMON_COMPRESS_HELPER_H
+
+#include "common/io/filter/filter.h"
+#include "common/type/string.h"
+
+/***********************************************************************************************************************************
+Compression types
+***********************************************************************************************************************************/
+typedef enum
+{
+    compressTypeNone,                                               // No compression
+    compressTypeGzip,                                               // gzip
+    compressTypeLz4,                                                // lz4
+    compressTypeZst,                                                // zstandard
+} CompressType;
+
+#define COMPRESS_TYPE_NONE                                          "none"
+    STRING_DECLARE(COMPRESS_TYPE_NONE_STR);
+
+/***********************************************************************************************************************************
+Regular expression that matches the extension of any compression type, e.g. to find files in the archive
+***********************************************************************************************************************************/
+#define COMPRESS_EXT_REGEXP                                         "(\\.(gz|lz4|zst)){0,1}"
+
+/***********************************************************************************************************************************
+Files smaller than this are compressed in a single thread since there is not enough data to keep multiple threads busy
+***********************************************************************************************************************************/
+#define COMPRESS_THREAD_SIZE_MIN                                    ((uint64_t)1024 * 1024)
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+// Get compression type from name and name from compression type
+CompressType compressType(const String *name);
+const String *compressTypeName(CompressType type);
+
+// Error if the compression type is not available in this build
+void compressTypePresent(CompressType type);
+
+// Get compression type from the file extension.  Files without a known extension are not compressed.
+CompressType compressTypeFromName(const String *file);
+
+// Get the file extension for the compression type (e.g. .gz) or an empty string when there is no compression
+const String *compressExtStr(CompressType type);
+
+// Add the extension for the compression type to a file name
+void compressExtCat(String *file, CompressType type);
+
+// Remove the extension for the compression type from a file name
+String *compressExtStrip(const String *file, CompressType type);
+
+// Allowed levels for the compression type
+int compressLevelMin(CompressType type);
+int compressLevelMax(CompressType type);
+
+// Level used for the compression type when compress-level is not set
+int compressLevelDefault(CompressType type);
+
+// Compress and decompress filters.  The thread total is ignored when the compression type cannot compress in threads.
+IoFilter *compressFilter(CompressType type, int level, unsigned int threadTotal);
+IoFilter *decompressFilter(CompressType type);
+
+#endif
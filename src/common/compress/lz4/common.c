@@ -0,0 +1,25 @@
+/***********************************************************************************************************************************
+LZ4 Common
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#ifdef HAVE_LIBLZ4
+
+#include <lz4frame.h>
+
+#include "common/compress/lz4/common.h"
+#include "common/debug.h"
+
+/***********************************************************************************************************************************
+Process lz4 errors
+***********************************************************************************************************************************/
+size_t
+lz4Error(size_t error)
+{
+    if (LZ4F_isError(error))
+        THROW_FMT(FormatError, "lz4 error: %s", LZ4F_getErrorName(error));
+
+    return error;
+}
+
+#endif // HAVE_LIBLZ4
@@ -0,0 +1,31 @@
+/***********************************************************************************************************************************
+LZ4 Common
+***********************************************************************************************************************************/
+#ifndef COMMON_COMPRESS_LZ4_COMMON_H
+#define COMMON_COMPRESS_LZ4_COMMON_H
+
+#include <stddef.h>
+
+/***********************************************************************************************************************************
+LZ4 extension
+***********************************************************************************************************************************/
+#define LZ4_EXT                                                     "lz4"
+
+/***********************************************************************************************************************************
+Allowed levels.  Negative levels trade compression for speed and levels above 2 use the high compression mode, so the default is the
+fast mode.
+***********************************************************************************************************************************/
+#define LZ4_LEVEL_MIN                                               -5
+#define LZ4_LEVEL_MAX                                               12
+#define LZ4_LEVEL_DEFAULT                                           1
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+#ifdef HAVE_LIBLZ4
+
+size_t lz4Error(size_t error);
+
+#endif
+
+#endif
@@ -0,0 +1,281 @@
+/***********************************************************************************************************************************
+LZ4 Compress
+
+LZ4F_compressUpdate() requires an output buffer large enough for the worst case compression of the input, which is generally larger
+than the space left in the output buffer.  So data is compressed into an internal buffer that is copied to the output as space
+allows.  The input is compressed in chunks no larger than the buffer size so the internal buffer size is fixed.
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#ifdef HAVE_LIBLZ4
+
+#include <lz4frame.h>
+#include <stdio.h>
+
+#include "common/compress/lz4/common.h"
+#include "common/compress/lz4/compress.h"
+#include "common/debug.h"
+#include "common/io/filter/filter.intern.h"
+#include "common/io/io.h"
+#include "common/log.h"
+#include "common/memContext.h"
+#include "common/object.h"
+
+/***********************************************************************************************************************************
+Filter type constant
+***********************************************************************************************************************************/
+STRING_EXTERN(LZ4_COMPRESS_FILTER_TYPE_STR,                         LZ4_COMPRESS_FILTER_TYPE);
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+#define LZ4_COMPRESS_TYPE                                           Lz4Compress
+#define LZ4_COMPRESS_PREFIX                                         lz4Compress
+
+typedef struct Lz4Compress
+{
+    MemContext *memContext;                                         // Context to store data
+    LZ4F_cctx *context;                                             // Compression context
+    LZ4F_preferences_t prefs;                                       // Preferences -- only compression level is set
+    size_t inputMax;                                                // Maximum input to compress in one call
+    Buffer *buffer;                                                 // Compressed data that has not been output yet
+    size_t bufferOffset;                                            // Offset of data in the buffer that has not been output
+
+    size_t inputOffset;                                             // Offset into input when output was full before input was used
+    bool begin;                                                     // Has the frame header been written?
+    bool end;                                                       // Has the frame footer been written?
+    bool inputSame;                                                 // Is the same input required on the next process call?
+    bool flush;                                                     // Is input complete and flushing in progress?
+    bool done;                                                      // Is compression done?
+} Lz4Compress;
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+static String *
+lz4CompressToLog(const Lz4Compress *this)
+{
+    return strNewFmt(
+        "{inputSame: %s, done: %s, flushing: %s, buffered: %zu}", cvtBoolToConstZ(this->inputSame), cvtBoolToConstZ(this->done),
+        cvtBoolToConstZ(this->flush), bufUsed(this->buffer) - this->bufferOffset);
+}
+
+#define FUNCTION_LOG_LZ4_COMPRESS_TYPE                                                                                             \
+    Lz4Compress *
+#define FUNCTION_LOG_LZ4_COMPRESS_FORMAT(value, buffer, bufferSize)                                                                \
+    FUNCTION_LOG_STRING_OBJECT_FORMAT(value, lz4CompressToLog, buffer, bufferSize)
+
+/***********************************************************************************************************************************
+Free compression context
+***********************************************************************************************************************************/
+OBJECT_DEFINE_FREE_RESOURCE_BEGIN(LZ4_COMPRESS, LOG, logLevelTrace)
+{
+    LZ4F_freeCompressionContext(this->context);
+}
+OBJECT_DEFINE_FREE_RESOURCE_END(LOG);
+
+/***********************************************************************************************************************************
+Copy compressed data from the internal buffer to the output
+
+Return true when the internal buffer is empty.
+***********************************************************************************************************************************/
+static bool
+lz4CompressBufferOutput(Lz4Compress *this, Buffer *compressed)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(LZ4_COMPRESS, this);
+        FUNCTION_TEST_PARAM(BUFFER, compressed);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(compressed != NULL);
+
+    size_t outputSize = bufUsed(this->buffer) - this->bufferOffset;
+
+    if (outputSize > 0)
+    {
+        if (outputSize > bufRemains(compressed))
+            outputSize = bufRemains(compressed);
+
+        bufCatSub(compressed, this->buffer, this->bufferOffset, outputSize);
+        this->bufferOffset += outputSize;
+
+        if (this->bufferOffset == bufUsed(this->buffer))
+        {
+            bufUsedZero(this->buffer);
+            this->bufferOffset = 0;
+        }
+    }
+
+    FUNCTION_TEST_RETURN(bufUsed(this->buffer) == 0);
+}
+
+/***********************************************************************************************************************************
+Compress data
+***********************************************************************************************************************************/
+static void
+lz4CompressProcess(THIS_VOID, const Buffer *uncompressed, Buffer *compressed)
+{
+    THIS(Lz4Compress);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(LZ4_COMPRESS, this);
+        FUNCTION_LOG_PARAM(BUFFER, uncompressed);
+        FUNCTION_LOG_PARAM(BUFFER, compressed);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(!this->done);
+    ASSERT(compressed != NULL);
+    ASSERT(!this->flush || uncompressed == NULL);
+
+    // Flushing
+    if (uncompressed == NULL)
+        this->flush = true;
+
+    // Output buffered data and then compress more data into the buffer until the output is full or there is nothing left to do
+    while (lz4CompressBufferOutput(this, compressed))
+    {
+        size_t result;
+
+        // Write the frame header
+        if (!this->begin)
+        {
+            result = lz4Error(LZ4F_compressBegin(this->context, bufPtr(this->buffer), bufSize(this->buffer), &this->prefs));
+            this->begin = true;
+        }
+        // Compress input
+        else if (!this->flush)
+        {
+            if (this->inputOffset == bufUsed(uncompressed))
+                break;
+
+            size_t inputSize = bufUsed(uncompressed) - this->inputOffset;
+
+            if (inputSize > this->inputMax)
+                inputSize = this->inputMax;
+
+            result = lz4Error(
+                LZ4F_compressUpdate(
+                    this->context, bufPtr(this->buffer), bufSize(this->buffer), bufPtr(uncompressed) + this->inputOffset,
+                    inputSize, NULL));
+
+            this->inputOffset += inputSize;
+        }
+        // Write the frame footer
+        else if (!this->end)
+        {
+            result = lz4Error(LZ4F_compressEnd(this->context, bufPtr(this->buffer), bufSize(this->buffer), NULL));
+            this->end = true;
+        }
+        // Else all compressed data has been output
+        else
+        {
+            this->done = true;
+            break;
+        }
+
+        bufUsedSet(this->buffer, result);
+    }
+
+    // The same input is required if it was not all used.  When flushing the same (NULL) input is required until done.
+    this->inputSame = this->flush ? !this->done : this->inputOffset < bufUsed(uncompressed);
+
+    if (!this->inputSame)
+        this->inputOffset = 0;
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Is compress done?
+***********************************************************************************************************************************/
+static bool
+lz4CompressDone(const THIS_VOID)
+{
+    THIS(const Lz4Compress);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(LZ4_COMPRESS, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->done);
+}
+
+/***********************************************************************************************************************************
+Is the same input required on the next process call?
+***********************************************************************************************************************************/
+static bool
+lz4CompressInputSame(const THIS_VOID)
+{
+    THIS(const Lz4Compress);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(LZ4_COMPRESS, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->inputSame);
+}
+
+/***********************************************************************************************************************************
+New object
+***********************************************************************************************************************************/
+IoFilter *
+lz4CompressNew(int level)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(INT, level);
+    FUNCTION_LOG_END();
+
+    ASSERT(level >= LZ4_LEVEL_MIN && level <= LZ4_LEVEL_MAX);
+
+    IoFilter *this = NULL;
+
+    MEM_CONTEXT_NEW_BEGIN("Lz4Compress")
+    {
+        Lz4Compress *driver = memNew(sizeof(Lz4Compress));
+        driver->memContext = MEM_CONTEXT_NEW();
+
+        // Create compression context
+        lz4Error(LZ4F_createCompressionContext(&driver->context, LZ4F_VERSION));
+
+        // Set free callback to ensure the compression context is freed
+        memContextCallbackSet(driver->memContext, lz4CompressFreeResource, driver);
+
+        // Set level and enable the content checksum so corruption is detected on decompress
+        driver->prefs = (LZ4F_preferences_t)
+        {
+            .compressionLevel = level,
+            .frameInfo = {.contentChecksumFlag = LZ4F_contentChecksumEnabled},
+        };
+
+        // Size the internal buffer for the worst case compression of the largest input chunk, which is also larger than the header
+        // and footer
+        driver->inputMax = ioBufferSize();
+        driver->buffer = bufNew(LZ4F_compressBound(driver->inputMax, &driver->prefs));
+
+        // Create param list
+        VariantList *paramList = varLstNew();
+        varLstAdd(paramList, varNewInt(level));
+
+        // Create filter interface
+        this = ioFilterNewP(
+            LZ4_COMPRESS_FILTER_TYPE_STR, driver, paramList, .done = lz4CompressDone, .inOut = lz4CompressProcess,
+            .inputSame = lz4CompressInputSame);
+    }
+    MEM_CONTEXT_NEW_END();
+
+    FUNCTION_LOG_RETURN(IO_FILTER, this);
+}
+
+IoFilter *
+lz4CompressNewVar(const VariantList *paramList)
+{
+    return lz4CompressNew(varIntForce(varLstGet(paramList, 0)));
+}
+
+#endif // HAVE_LIBLZ4
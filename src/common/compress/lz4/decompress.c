@@ -0,0 +1,183 @@
+/***********************************************************************************************************************************
+LZ4 Decompress
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#ifdef HAVE_LIBLZ4
+
+#include <lz4frame.h>
+#include <stdio.h>
+
+#include "common/compress/lz4/common.h"
+#include "common/compress/lz4/decompress.h"
+#include "common/debug.h"
+#include "common/io/filter/filter.intern.h"
+#include "common/log.h"
+#include "common/memContext.h"
+#include "common/object.h"
+
+/***********************************************************************************************************************************
+Filter type constant
+***********************************************************************************************************************************/
+STRING_EXTERN(LZ4_DECOMPRESS_FILTER_TYPE_STR,                       LZ4_DECOMPRESS_FILTER_TYPE);
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+#define LZ4_DECOMPRESS_TYPE                                         Lz4Decompress
+#define LZ4_DECOMPRESS_PREFIX                                       lz4Decompress
+
+typedef struct Lz4Decompress
+{
+    MemContext *memContext;                                         // Context to store data
+    LZ4F_dctx *context;                                             // Decompression context
+
+    size_t inputOffset;                                             // Offset into input when output was full before input was used
+    bool inputSame;                                                 // Is the same input required on the next process call?
+    bool done;                                                      // Is decompression done?
+} Lz4Decompress;
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+static String *
+lz4DecompressToLog(const Lz4Decompress *this)
+{
+    return strNewFmt("{inputSame: %s, done: %s}", cvtBoolToConstZ(this->inputSame), cvtBoolToConstZ(this->done));
+}
+
+#define FUNCTION_LOG_LZ4_DECOMPRESS_TYPE                                                                                           \
+    Lz4Decompress *
+#define FUNCTION_LOG_LZ4_DECOMPRESS_FORMAT(value, buffer, bufferSize)                                                              \
+    FUNCTION_LOG_STRING_OBJECT_FORMAT(value, lz4DecompressToLog, buffer, bufferSize)
+
+/***********************************************************************************************************************************
+Free decompression context
+***********************************************************************************************************************************/
+OBJECT_DEFINE_FREE_RESOURCE_BEGIN(LZ4_DECOMPRESS, LOG, logLevelTrace)
+{
+    LZ4F_freeDecompressionContext(this->context);
+}
+OBJECT_DEFINE_FREE_RESOURCE_END(LOG);
+
+/***********************************************************************************************************************************
+Decompress data
+***********************************************************************************************************************************/
+static void
+lz4DecompressProcess(THIS_VOID, const Buffer *compressed, Buffer *uncompressed)
+{
+    THIS(Lz4Decompress);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(LZ4_DECOMPRESS, this);
+        FUNCTION_LOG_PARAM(BUFFER, compressed);
+        FUNCTION_LOG_PARAM(BUFFER, uncompressed);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(uncompressed != NULL);
+
+    // When there is no more input the decompressed data buffered in the context must still be output
+    size_t inputSize = compressed == NULL ? 0 : bufUsed(compressed) - this->inputOffset;
+    size_t outputSize = bufRemains(uncompressed);
+
+    // Perform decompression.  The result is zero when the frame has been completely decompressed and output.
+    size_t result = lz4Error(
+        LZ4F_decompress(
+            this->context, bufRemainsPtr(uncompressed), &outputSize,
+            compressed == NULL ? NULL : bufPtr(compressed) + this->inputOffset, &inputSize, NULL));
+
+    // Error if there is no more input, no output was produced, and the frame is not complete
+    if (compressed == NULL && result != 0 && outputSize == 0)
+        THROW(FormatError, "unexpected eof in compressed data");
+
+    bufUsedInc(uncompressed, outputSize);
+    this->inputOffset += inputSize;
+
+    // Is decompression done?
+    this->done = result == 0;
+
+    // The same input is required when it was not all used or when the output is full since there may be buffered output
+    this->inputSame = this->done || compressed == NULL ?
+        false : this->inputOffset < bufUsed(compressed) || bufFull(uncompressed);
+
+    if (!this->inputSame)
+        this->inputOffset = 0;
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Is decompress done?
+***********************************************************************************************************************************/
+static bool
+lz4DecompressDone(const THIS_VOID)
+{
+    THIS(const Lz4Decompress);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(LZ4_DECOMPRESS, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->done);
+}
+
+/***********************************************************************************************************************************
+Is the same input required on the next process call?
+***********************************************************************************************************************************/
+static bool
+lz4DecompressInputSame(const THIS_VOID)
+{
+    THIS(const Lz4Decompress);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(LZ4_DECOMPRESS, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->inputSame);
+}
+
+/***********************************************************************************************************************************
+New object
+***********************************************************************************************************************************/
+IoFilter *
+lz4DecompressNew(void)
+{
+    FUNCTION_LOG_VOID(logLevelTrace);
+
+    IoFilter *this = NULL;
+
+    MEM_CONTEXT_NEW_BEGIN("Lz4Decompress")
+    {
+        Lz4Decompress *driver = memNew(sizeof(Lz4Decompress));
+        driver->memContext = MEM_CONTEXT_NEW();
+
+        // Create decompression context
+        lz4Error(LZ4F_createDecompressionContext(&driver->context, LZ4F_VERSION));
+
+        // Set free callback to ensure the decompression context is freed
+        memContextCallbackSet(driver->memContext, lz4DecompressFreeResource, driver);
+
+        // Create filter interface
+        this = ioFilterNewP(
+            LZ4_DECOMPRESS_FILTER_TYPE_STR, driver, NULL, .done = lz4DecompressDone, .inOut = lz4DecompressProcess,
+            .inputSame = lz4DecompressInputSame);
+    }
+    MEM_CONTEXT_NEW_END();
+
+    FUNCTION_LOG_RETURN(IO_FILTER, this);
+}
+
+IoFilter *
+lz4DecompressNewVar(const VariantList *paramList)
+{
+    (void)paramList;
+
+    return lz4DecompressNew();
+}
+
+#endif // HAVE_LIBLZ4
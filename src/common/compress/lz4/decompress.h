@@ -0,0 +1,27 @@
+/***********************************************************************************************************************************
+LZ4 Decompress
+
+Decompress IO from the lz4 format.
+***********************************************************************************************************************************/
+#ifndef COMMON_COMPRESS_LZ4_DECOMPRESS_H
+#define COMMON_COMPRESS_LZ4_DECOMPRESS_H
+
+#include "common/io/filter/filter.h"
+
+/***********************************************************************************************************************************
+Filter type constant
+***********************************************************************************************************************************/
+#define LZ4_DECOMPRESS_FILTER_TYPE                                  "lz4Decompress"
+    STRING_DECLARE(LZ4_DECOMPRESS_FILTER_TYPE_STR);
+
+/***********************************************************************************************************************************
+Constructor
+***********************************************************************************************************************************/
+#ifdef HAVE_LIBLZ4
+
+IoFilter *lz4DecompressNew(void);
+IoFilter *lz4DecompressNewVar(const VariantList *paramList);
+
+#endif
+
+#endif
@@ -0,0 +1,31 @@
+/***********************************************************************************************************************************
+Zstandard Common
+***********************************************************************************************************************************/
+#ifndef COMMON_COMPRESS_ZST_COMMON_H
+#define COMMON_COMPRESS_ZST_COMMON_H
+
+#include <stddef.h>
+
+/***********************************************************************************************************************************
+Zstandard extension
+***********************************************************************************************************************************/
+#define ZST_EXT                                                     "zst"
+
+/***********************************************************************************************************************************
+Allowed levels.  Negative levels trade compression for speed and levels above 19 require much more memory.  The default is the same
+as the zstd library default.
+***********************************************************************************************************************************/
+#define ZST_LEVEL_MIN                                               -5
+#define ZST_LEVEL_MAX                                               22
+#define ZST_LEVEL_DEFAULT                                           3
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+#ifdef HAVE_LIBZSTD
+
+size_t zstError(size_t error);
+
+#endif
+
+#endif
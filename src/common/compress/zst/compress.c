@@ -0,0 +1,203 @@
+/***********************************************************************************************************************************
+Zstandard Compress
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#ifdef HAVE_LIBZSTD
+
+#include <stdio.h>
+#include <zstd.h>
+
+#include "common/compress/zst/common.h"
+#include "common/compress/zst/compress.h"
+#include "common/debug.h"
+#include "common/io/filter/filter.intern.h"
+#include "common/log.h"
+#include "common/memContext.h"
+#include "common/object.h"
+
+/***********************************************************************************************************************************
+Filter type constant
+***********************************************************************************************************************************/
+STRING_EXTERN(ZST_COMPRESS_FILTER_TYPE_STR,                         ZST_COMPRESS_FILTER_TYPE);
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+#define ZST_COMPRESS_TYPE                                           ZstCompress
+#define ZST_COMPRESS_PREFIX                                         zstCompress
+
+typedef struct ZstCompress
+{
+    MemContext *memContext;                                         // Context to store data
+    ZSTD_CCtx *context;                                             // Compression context
+    ZSTD_inBuffer input;                                            // Input that may not have been fully used on the last call
+
+    bool inputSame;                                                 // Is the same input required on the next process call?
+    bool flush;                                                     // Is input complete and flushing in progress?
+    bool done;                                                      // Is compression done?
+} ZstCompress;
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+static String *
+zstCompressToLog(const ZstCompress *this)
+{
+    return strNewFmt(
+        "{inputSame: %s, done: %s, flushing: %s}", cvtBoolToConstZ(this->inputSame), cvtBoolToConstZ(this->done),
+        cvtBoolToConstZ(this->flush));
+}
+
+#define FUNCTION_LOG_ZST_COMPRESS_TYPE                                                                                             \
+    ZstCompress *
+#define FUNCTION_LOG_ZST_COMPRESS_FORMAT(value, buffer, bufferSize)                                                                \
+    FUNCTION_LOG_STRING_OBJECT_FORMAT(value, zstCompressToLog, buffer, bufferSize)
+
+/***********************************************************************************************************************************
+Free compression context
+***********************************************************************************************************************************/
+OBJECT_DEFINE_FREE_RESOURCE_BEGIN(ZST_COMPRESS, LOG, logLevelTrace)
+{
+    ZSTD_freeCCtx(this->context);
+}
+OBJECT_DEFINE_FREE_RESOURCE_END(LOG);
+
+/***********************************************************************************************************************************
+Compress data
+***********************************************************************************************************************************/
+static void
+zstCompressProcess(THIS_VOID, const Buffer *uncompressed, Buffer *compressed)
+{
+    THIS(ZstCompress);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(ZST_COMPRESS, this);
+        FUNCTION_LOG_PARAM(BUFFER, uncompressed);
+        FUNCTION_LOG_PARAM(BUFFER, compressed);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(!this->done);
+    ASSERT(compressed != NULL);
+    ASSERT(!this->flush || uncompressed == NULL);
+
+    // Flushing
+    if (uncompressed == NULL)
+    {
+        this->input = (ZSTD_inBuffer){0};
+        this->flush = true;
+    }
+    // Else new input is allowed
+    else if (!this->inputSame)
+        this->input = (ZSTD_inBuffer){.src = bufPtr(uncompressed), .size = bufUsed(uncompressed)};
+
+    ZSTD_outBuffer output = {.dst = bufPtr(compressed), .size = bufSize(compressed), .pos = bufUsed(compressed)};
+
+    // Perform compression.  When flushing the result is the amount of compressed data that has not yet been output.
+    size_t result = zstError(
+        ZSTD_compressStream2(this->context, &output, &this->input, this->flush ? ZSTD_e_end : ZSTD_e_continue));
+
+    bufUsedSet(compressed, output.pos);
+
+    // Is compression done?
+    if (this->flush && result == 0)
+        this->done = true;
+
+    // Can more input be provided on the next call?
+    this->inputSame = this->flush ? !this->done : this->input.pos < this->input.size;
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Is compress done?
+***********************************************************************************************************************************/
+static bool
+zstCompressDone(const THIS_VOID)
+{
+    THIS(const ZstCompress);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(ZST_COMPRESS, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->done);
+}
+
+/***********************************************************************************************************************************
+Is the same input required on the next process call?
+***********************************************************************************************************************************/
+static bool
+zstCompressInputSame(const THIS_VOID)
+{
+    THIS(const ZstCompress);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(ZST_COMPRESS, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->inputSame);
+}
+
+/***********************************************************************************************************************************
+New object
+***********************************************************************************************************************************/
+IoFilter *
+zstCompressNew(int level, unsigned int threadTotal)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(INT, level);
+        FUNCTION_LOG_PARAM(UINT, threadTotal);
+    FUNCTION_LOG_END();
+
+    ASSERT(level >= ZST_LEVEL_MIN && level <= ZST_LEVEL_MAX);
+    ASSERT(threadTotal > 0);
+
+    IoFilter *this = NULL;
+
+    MEM_CONTEXT_NEW_BEGIN("ZstCompress")
+    {
+        ZstCompress *driver = memNew(sizeof(ZstCompress));
+        driver->memContext = MEM_CONTEXT_NEW();
+
+        // Create compression context
+        driver->context = ZSTD_createCCtx();
+
+        // Set free callback to ensure the compression context is freed
+        memContextCallbackSet(driver->memContext, zstCompressFreeResource, driver);
+
+        // Set level and enable the checksum so corruption is detected on decompress
+        zstError(ZSTD_CCtx_setParameter(driver->context, ZSTD_c_compressionLevel, level));
+        zstError(ZSTD_CCtx_setParameter(driver->context, ZSTD_c_checksumFlag, 1));
+
+        // Compress in worker threads when requested
+        if (threadTotal > 1)
+            zstError(ZSTD_CCtx_setParameter(driver->context, ZSTD_c_nbWorkers, (int)threadTotal));
+
+        // Create param list
+        VariantList *paramList = varLstNew();
+        varLstAdd(paramList, varNewInt(level));
+        varLstAdd(paramList, varNewUInt(threadTotal));
+
+        // Create filter interface
+        this = ioFilterNewP(
+            ZST_COMPRESS_FILTER_TYPE_STR, driver, paramList, .done = zstCompressDone, .inOut = zstCompressProcess,
+            .inputSame = zstCompressInputSame);
+    }
+    MEM_CONTEXT_NEW_END();
+
+    FUNCTION_LOG_RETURN(IO_FILTER, this);
+}
+
+IoFilter *
+zstCompressNewVar(const VariantList *paramList)
+{
+    return zstCompressNew(varIntForce(varLstGet(paramList, 0)), varUIntForce(varLstGet(paramList, 1)));
+}
+
+#endif // HAVE_LIBZSTD
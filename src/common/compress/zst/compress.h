@@ -0,0 +1,27 @@
+/***********************************************************************************************************************************
+Zstandard Compress
+
+Compress IO using the zstandard format.  When more than one thread is requested the library compresses in worker threads.
+***********************************************************************************************************************************/
+#ifndef COMMON_COMPRESS_ZST_COMPRESS_H
+#define COMMON_COMPRESS_ZST_COMPRESS_H
+
+#include "common/io/filter/filter.h"
+
+/***********************************************************************************************************************************
+Filter type constant
+***********************************************************************************************************************************/
+#define ZST_COMPRESS_FILTER_TYPE                                    "zstCompress"
+    STRING_DECLARE(ZST_COMPRESS_FILTER_TYPE_STR);
+
+/***********************************************************************************************************************************
+Constructor
+***********************************************************************************************************************************/
+#ifdef HAVE_LIBZSTD
+
+IoFilter *zstCompressNew(int level, unsigned int threadTotal);
+IoFilter *zstCompressNewVar(const VariantList *paramList);
+
+#endif
+
+#endif
@@ -0,0 +1,181 @@
+/***********************************************************************************************************************************
+Zstandard Decompress
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#ifdef HAVE_LIBZSTD
+
+#include <stdio.h>
+#include <zstd.h>
+
+#include "common/compress/zst/common.h"
+#include "common/compress/zst/decompress.h"
+#include "common/debug.h"
+#include "common/io/filter/filter.intern.h"
+#include "common/log.h"
+#include "common/memContext.h"
+#include "common/object.h"
+
+/***********************************************************************************************************************************
+Filter type constant
+***********************************************************************************************************************************/
+STRING_EXTERN(ZST_DECOMPRESS_FILTER_TYPE_STR,                       ZST_DECOMPRESS_FILTER_TYPE);
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+#define ZST_DECOMPRESS_TYPE                                         ZstDecompress
+#define ZST_DECOMPRESS_PREFIX                                       zstDecompress
+
+typedef struct ZstDecompress
+{
+    MemContext *memContext;                                         // Context to store data
+    ZSTD_DStream *context;                                          // Decompression context
+    ZSTD_inBuffer input;                                            // Input that may not have been fully used on the last call
+
+    bool inputSame;                                                 // Is the same input required on the next process call?
+    bool done;                                                      // Is decompression done?
+} ZstDecompress;
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+static String *
+zstDecompressToLog(const ZstDecompress *this)
+{
+    return strNewFmt("{inputSame: %s, done: %s}", cvtBoolToConstZ(this->inputSame), cvtBoolToConstZ(this->done));
+}
+
+#define FUNCTION_LOG_ZST_DECOMPRESS_TYPE                                                                                           \
+    ZstDecompress *
+#define FUNCTION_LOG_ZST_DECOMPRESS_FORMAT(value, buffer, bufferSize)                                                              \
+    FUNCTION_LOG_STRING_OBJECT_FORMAT(value, zstDecompressToLog, buffer, bufferSize)
+
+/***********************************************************************************************************************************
+Free decompression context
+***********************************************************************************************************************************/
+OBJECT_DEFINE_FREE_RESOURCE_BEGIN(ZST_DECOMPRESS, LOG, logLevelTrace)
+{
+    ZSTD_freeDCtx(this->context);
+}
+OBJECT_DEFINE_FREE_RESOURCE_END(LOG);
+
+/***********************************************************************************************************************************
+Decompress data
+***********************************************************************************************************************************/
+static void
+zstDecompressProcess(THIS_VOID, const Buffer *compressed, Buffer *uncompressed)
+{
+    THIS(ZstDecompress);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(ZST_DECOMPRESS, this);
+        FUNCTION_LOG_PARAM(BUFFER, compressed);
+        FUNCTION_LOG_PARAM(BUFFER, uncompressed);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(uncompressed != NULL);
+
+    // When there is no more input the decompressed data buffered in the context must still be output
+    if (compressed == NULL)
+        this->input = (ZSTD_inBuffer){0};
+    else if (!this->inputSame)
+        this->input = (ZSTD_inBuffer){.src = bufPtr(compressed), .size = bufUsed(compressed)};
+
+    ZSTD_outBuffer output = {.dst = bufPtr(uncompressed), .size = bufSize(uncompressed), .pos = bufUsed(uncompressed)};
+
+    // Perform decompression.  The result is zero when the frame has been completely decompressed and output.
+    size_t result = zstError(ZSTD_decompressStream(this->context, &output, &this->input));
+
+    // Error if there is no more input, no output was produced, and the frame is not complete
+    if (compressed == NULL && result != 0 && output.pos == bufUsed(uncompressed))
+        THROW(FormatError, "unexpected eof in compressed data");
+
+    bufUsedSet(uncompressed, output.pos);
+
+    // Is decompression done?
+    this->done = result == 0;
+
+    // The same input is required when it was not all used or when the output is full since there may be buffered output
+    this->inputSame = this->done ? false : this->input.pos < this->input.size || bufFull(uncompressed);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Is decompress done?
+***********************************************************************************************************************************/
+static bool
+zstDecompressDone(const THIS_VOID)
+{
+    THIS(const ZstDecompress);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(ZST_DECOMPRESS, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->done);
+}
+
+/***********************************************************************************************************************************
+Is the same input required on the next process call?
+***********************************************************************************************************************************/
+static bool
+zstDecompressInputSame(const THIS_VOID)
+{
+    THIS(const ZstDecompress);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(ZST_DECOMPRESS, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->inputSame);
+}
+
+/***********************************************************************************************************************************
+New object
+***********************************************************************************************************************************/
+IoFilter *
+zstDecompressNew(void)
+{
+    FUNCTION_LOG_VOID(logLevelTrace);
+
+    IoFilter *this = NULL;
+
+    MEM_CONTEXT_NEW_BEGIN("ZstDecompress")
+    {
+        ZstDecompress *driver = memNew(sizeof(ZstDecompress));
+        driver->memContext = MEM_CONTEXT_NEW();
+
+        // Create decompression context
+        driver->context = ZSTD_createDCtx();
+
+        // Set free callback to ensure the decompression context is freed
+        memContextCallbackSet(driver->memContext, zstDecompressFreeResource, driver);
+
+        zstError(ZSTD_initDStream(driver->context));
+
+        // Create filter interface
+        this = ioFilterNewP(
+            ZST_DECOMPRESS_FILTER_TYPE_STR, driver, NULL, .done = zstDecompressDone, .inOut = zstDecompressProcess,
+            .inputSame = zstDecompressInputSame);
+    }
+    MEM_CONTEXT_NEW_END();
+
+    FUNCTION_LOG_RETURN(IO_FILTER, this);
+}
+
+IoFilter *
+zstDecompressNewVar(const VariantList *paramList)
+{
+    (void)paramList;
+
+    return zstDecompressNew();
+}
+
+#endif // HAVE_LIBZSTD
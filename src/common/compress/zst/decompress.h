@@ -0,0 +1,27 @@
+/***********************************************************************************************************************************
+Zstandard Decompress
+
+Decompress IO from the zstandard format.
+***********************************************************************************************************************************/
+#ifndef COMMON_COMPRESS_ZST_DECOMPRESS_H
+#define COMMON_COMPRESS_ZST_DECOMPRESS_H
+
+#include "common/io/filter/filter.h"
+
+/***********************************************************************************************************************************
+Filter type constant
+***********************************************************************************************************************************/
+#define ZST_DECOMPRESS_FILTER_TYPE                                  "zstDecompress"
+    STRING_DECLARE(ZST_DECOMPRESS_FILTER_TYPE_STR);
+
+/***********************************************************************************************************************************
+Constructor
+***********************************************************************************************************************************/
+#ifdef HAVE_LIBZSTD
+
+IoFilter *zstDecompressNew(void);
+IoFilter *zstDecompressNewVar(const VariantList *paramList);
+
+#endif
+
+#endif
@@ -0,0 +1,847 @@
+/***********************************************************************************************************************************
+Chunk Cipher
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <string.h>
+
+#include <openssl/evp.h>
+#include <openssl/err.h>
+
+#include "common/crypto/cipherChunk.h"
+#include "common/debug.h"
+#include "common/io/filter/filter.intern.h"
+#include "common/log.h"
+#include "common/memContext.h"
+#include "common/object.h"
+
+/***********************************************************************************************************************************
+Filter type constant
+***********************************************************************************************************************************/
+STRING_EXTERN(CIPHER_CHUNK_FILTER_TYPE_STR,                         CIPHER_CHUNK_FILTER_TYPE);
+
+/***********************************************************************************************************************************
+Header constants and sizes
+***********************************************************************************************************************************/
+// Size of the salt that follows the magic and the chunk size that follows the salt
+#define CIPHER_CHUNK_SALT_SIZE                                      16
+#define CIPHER_CHUNK_SIZE_SIZE                                      4
+
+// Size of the key and the nonce.  The nonce is the chunk number in the last 8 bytes.
+#define CIPHER_CHUNK_KEY_SIZE                                       32
+#define CIPHER_CHUNK_NONCE_SIZE                                     12
+
+// Iterations to derive the key.  The passphrase is random except for info files, which matches the single digest round used by the
+// block cipher, and the key is derived for every file so more iterations would be costly for a backup with many small files.
+#define CIPHER_CHUNK_KEY_ITERATION                                  1
+
+// Maximum size of an error message from a thread
+#define ERROR_MESSAGE_SIZE                                          4096
+
+/***********************************************************************************************************************************
+Chunk to be encrypted/decrypted
+
+Jobs are a ring that is filled with input by cipherChunkProcess(), encrypted/decrypted by any thread, and then written to the output
+in order by cipherChunkProcess().  The counters that track the jobs only ever increase so a job is free when it has been written to
+the output.
+***********************************************************************************************************************************/
+typedef struct CipherChunkJob
+{
+    unsigned char *input;                                           // Chunk of input
+    size_t inputSize;                                               // Size of input
+    unsigned char *output;                                          // Encrypted/decrypted output
+    size_t outputSize;                                              // Size of output
+    uint64_t chunkNo;                                               // Chunk number
+    bool last;                                                      // Is this the last chunk?
+    bool done;                                                      // Has the chunk been encrypted/decrypted?
+} CipherChunkJob;
+
+/***********************************************************************************************************************************
+Thread that encrypts/decrypts jobs
+***********************************************************************************************************************************/
+typedef struct CipherChunkThread
+{
+    struct CipherChunk *cipher;                                     // Filter that the thread processes jobs for
+    EVP_CIPHER_CTX *context;                                        // Cipher context used by the thread
+    pthread_t thread;                                               // Thread
+} CipherChunkThread;
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+#define CIPHER_CHUNK_TYPE                                           CipherChunk
+#define CIPHER_CHUNK_PREFIX                                         cipherChunk
+
+typedef struct CipherChunk
+{
+    MemContext *memContext;                                         // Context to store data
+    CipherMode mode;                                                // Mode encrypt/decrypt
+    size_t passSize;                                                // Size of passphrase in bytes
+    unsigned char *pass;                                            // Passphrase used to generate encryption key
+    unsigned char header[CIPHER_CHUNK_HEADER_SIZE];                 // Header written on encrypt or read on decrypt
+    size_t headerSize;                                              // Size of header written/read so far
+    bool keyDone;                                                   // Has the key been derived and the contexts initialized?
+    size_t chunkSize;                                               // Size of chunks (excluding the tag)
+    size_t jobInputMax;                                             // Size of job input (includes the tag on decrypt)
+
+    pthread_mutex_t mutex;                                          // Mutex for all job and thread state
+    pthread_cond_t cond;                                            // Signaled whenever job or thread state changes
+    CipherChunkThread *threadList;                                  // Threads (the first context is used directly with one thread)
+    unsigned int threadTotal;                                       // Total threads
+    unsigned int threadStarted;                                     // Threads started
+
+    CipherChunkJob *jobList;                                        // Ring of jobs
+    unsigned int jobTotal;                                          // Total jobs in the ring
+    uint64_t jobPut;                                                // Jobs filled with input
+    uint64_t jobGet;                                                // Jobs taken by threads
+    uint64_t jobOutput;                                             // Jobs written to output
+    size_t inputSize;                                               // Size of input in the job being filled
+    size_t outputOffset;                                            // Offset into the output of the job being written
+
+    bool abort;                                                     // Should the threads stop?
+    const ErrorType *errorType;                                     // Type of error thrown in a thread
+    char errorMessage[ERROR_MESSAGE_SIZE];                          // Message of error thrown in a thread
+
+    size_t inputOffset;                                             // Offset into input when a job was not available
+    bool inputSame;                                                 // Is the same input required on the next process call?
+    bool flush;                                                     // Is input complete and flushing in progress?
+    bool lastPut;                                                   // Has the last job been filled?
+    bool done;                                                      // Is processing done?
+} CipherChunk;
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+static String *
+cipherChunkToLog(const CipherChunk *this)
+{
+    return strNewFmt(
+        "{inputSame: %s, done: %s, flushing: %s, jobPut: %" PRIu64 ", jobOutput: %" PRIu64 "}", cvtBoolToConstZ(this->inputSame),
+        cvtBoolToConstZ(this->done), cvtBoolToConstZ(this->flush), this->jobPut, this->jobOutput);
+}
+
+#define FUNCTION_LOG_CIPHER_CHUNK_TYPE                                                                                             \
+    CipherChunk *
+#define FUNCTION_LOG_CIPHER_CHUNK_FORMAT(value, buffer, bufferSize)                                                                \
+    FUNCTION_LOG_STRING_OBJECT_FORMAT(value, cipherChunkToLog, buffer, bufferSize)
+
+/***********************************************************************************************************************************
+Stop threads and free cipher contexts
+***********************************************************************************************************************************/
+OBJECT_DEFINE_FREE_RESOURCE_BEGIN(CIPHER_CHUNK, LOG, logLevelTrace)
+{
+    pthread_mutex_lock(&this->mutex);
+    this->abort = true;
+    pthread_cond_broadcast(&this->cond);
+    pthread_mutex_unlock(&this->mutex);
+
+    for (unsigned int threadIdx = 0; threadIdx < this->threadStarted; threadIdx++)
+        pthread_join(this->threadList[threadIdx].thread, NULL);
+
+    for (unsigned int threadIdx = 0; threadIdx < this->threadTotal; threadIdx++)
+        EVP_CIPHER_CTX_free(this->threadList[threadIdx].context);
+
+    pthread_cond_destroy(&this->cond);
+    pthread_mutex_destroy(&this->mutex);
+}
+OBJECT_DEFINE_FREE_RESOURCE_END(LOG);
+
+/***********************************************************************************************************************************
+Create a cipher context with the key derived from the passphrase and the salt in the header
+***********************************************************************************************************************************/
+static EVP_CIPHER_CTX *
+cipherChunkContextNew(CipherMode mode, const unsigned char *pass, size_t passSize, const unsigned char *header)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(ENUM, mode);
+        FUNCTION_LOG_PARAM_P(UCHARDATA, pass);
+        FUNCTION_LOG_PARAM(SIZE, passSize);
+        FUNCTION_LOG_PARAM_P(UCHARDATA, header);
+    FUNCTION_LOG_END();
+
+    ASSERT(pass != NULL);
+    ASSERT(header != NULL);
+
+    unsigned char key[CIPHER_CHUNK_KEY_SIZE];
+
+    cryptoError(
+        !PKCS5_PBKDF2_HMAC(
+            (const char *)pass, (int)passSize, header + CIPHER_CHUNK_MAGIC_SIZE, CIPHER_CHUNK_SALT_SIZE, CIPHER_CHUNK_KEY_ITERATION,
+            EVP_sha256(), CIPHER_CHUNK_KEY_SIZE, key),
+        "unable to derive key");
+
+    EVP_CIPHER_CTX *result = NULL;
+    cryptoError(!(result = EVP_CIPHER_CTX_new()), "unable to create context");
+
+    // The key is set once and only the nonce is set for each chunk
+    if (!EVP_CipherInit_ex(result, EVP_aes_256_gcm(), NULL, key, NULL, mode == cipherModeEncrypt))
+    {
+        EVP_CIPHER_CTX_free(result);
+        cryptoError(true, "unable to initialize cipher");
+    }
+
+    FUNCTION_LOG_RETURN_P(VOID, result);
+}
+
+/***********************************************************************************************************************************
+Encrypt/decrypt a chunk
+***********************************************************************************************************************************/
+static void
+cipherChunkJob(CipherMode mode, const unsigned char *header, EVP_CIPHER_CTX *context, CipherChunkJob *job)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(ENUM, mode);
+        FUNCTION_LOG_PARAM_P(UCHARDATA, header);
+        FUNCTION_LOG_PARAM_P(VOID, context);
+        FUNCTION_LOG_PARAM_P(VOID, job);
+    FUNCTION_LOG_END();
+
+    ASSERT(header != NULL);
+    ASSERT(context != NULL);
+    ASSERT(job != NULL);
+
+    if (mode == cipherModeDecrypt && job->inputSize < CIPHER_CHUNK_TAG_SIZE)
+        THROW(CryptoError, "unexpected eof in encrypted data");
+
+    size_t dataSize = mode == cipherModeEncrypt ? job->inputSize : job->inputSize - CIPHER_CHUNK_TAG_SIZE;
+
+    // The chunk number is the nonce so each chunk has a unique nonce and chunks cannot be reordered
+    unsigned char nonce[CIPHER_CHUNK_NONCE_SIZE] = {0};
+
+    for (unsigned int byteIdx = 0; byteIdx < sizeof(uint64_t); byteIdx++)
+        nonce[CIPHER_CHUNK_NONCE_SIZE - 1 - byteIdx] = (unsigned char)(job->chunkNo >> (byteIdx * 8));
+
+    cryptoError(!EVP_CipherInit_ex(context, NULL, NULL, NULL, nonce, -1), "unable to initialize cipher");
+
+    // Authenticate the header and whether this is the last chunk
+    unsigned char last = job->last;
+    int updateSize = 0;
+
+    cryptoError(
+        !EVP_CipherUpdate(context, NULL, &updateSize, header, CIPHER_CHUNK_HEADER_SIZE) ||
+            !EVP_CipherUpdate(context, NULL, &updateSize, &last, sizeof(last)),
+        "unable to process cipher");
+
+    // On decrypt the tag follows the data
+    if (mode == cipherModeDecrypt)
+    {
+        cryptoError(
+            !EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_GCM_SET_TAG, CIPHER_CHUNK_TAG_SIZE, job->input + dataSize),
+            "unable to set tag");
+    }
+
+    // Process the chunk in a single update
+    cryptoError(
+        !EVP_CipherUpdate(context, job->output, &updateSize, job->input, (int)dataSize), "unable to process cipher");
+
+    int finalSize = 0;
+
+    if (!EVP_CipherFinal_ex(context, job->output + updateSize, &finalSize))
+    {
+        // Clear the error queue since the failure is reported with a better message
+        ERR_clear_error();
+
+        THROW_FMT(CryptoError, "unable to authenticate chunk %" PRIu64 " of encrypted data", job->chunkNo);
+    }
+
+    ASSERT((size_t)(updateSize + finalSize) == dataSize);
+    job->outputSize = dataSize;
+
+    // On encrypt the tag follows the data
+    if (mode == cipherModeEncrypt)
+    {
+        cryptoError(
+            !EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_GCM_GET_TAG, CIPHER_CHUNK_TAG_SIZE, job->output + dataSize),
+            "unable to get tag");
+
+        job->outputSize += CIPHER_CHUNK_TAG_SIZE;
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Store the first error and stop the threads
+
+Must be called with the mutex locked.
+***********************************************************************************************************************************/
+static void
+cipherChunkErrorSet(CipherChunk *this)
+{
+    if (this->errorType == NULL)
+    {
+        this->errorType = errorType();
+        strncpy(this->errorMessage, errorMessage(), sizeof(this->errorMessage) - 1);
+    }
+
+    this->abort = true;
+    pthread_cond_broadcast(&this->cond);
+}
+
+/***********************************************************************************************************************************
+Thread that encrypts/decrypts jobs until stopped
+***********************************************************************************************************************************/
+static void *
+cipherChunkThread(void *threadVoid)
+{
+    CipherChunkThread *thread = threadVoid;
+    CipherChunk *this = thread->cipher;
+
+    TRY_BEGIN()
+    {
+        pthread_mutex_lock(&this->mutex);
+
+        while (true)
+        {
+            // Wait for a job
+            while (!this->abort && this->jobGet == this->jobPut)
+                pthread_cond_wait(&this->cond, &this->mutex);
+
+            if (this->abort)
+                break;
+
+            CipherChunkJob *job = &this->jobList[this->jobGet % this->jobTotal];
+            this->jobGet++;
+
+            pthread_mutex_unlock(&this->mutex);
+            cipherChunkJob(this->mode, this->header, thread->context, job);
+            pthread_mutex_lock(&this->mutex);
+
+            job->done = true;
+            pthread_cond_broadcast(&this->cond);
+        }
+
+        pthread_mutex_unlock(&this->mutex);
+    }
+    CATCH_ANY()
+    {
+        // Store the error so it can be thrown by cipherChunkProcess()
+        pthread_mutex_lock(&this->mutex);
+        cipherChunkErrorSet(this);
+        pthread_mutex_unlock(&this->mutex);
+    }
+    TRY_END();
+
+    return NULL;
+}
+
+/***********************************************************************************************************************************
+Derive the key and allocate jobs once the header has been generated/read
+***********************************************************************************************************************************/
+static void
+cipherChunkInit(CipherChunk *this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(CIPHER_CHUNK, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(!this->keyDone);
+
+    MEM_CONTEXT_BEGIN(this->memContext)
+    {
+        for (unsigned int threadIdx = 0; threadIdx < this->threadTotal; threadIdx++)
+        {
+            this->threadList[threadIdx].context = cipherChunkContextNew(this->mode, this->pass, this->passSize, this->header);
+        }
+
+        // Create enough jobs to keep all threads busy while output is being written.  Memory is allocated directly rather than in
+        // Buffer objects since the threads must be stopped before the memory is freed and child contexts are freed first.
+        this->jobInputMax = this->chunkSize + (this->mode == cipherModeDecrypt ? CIPHER_CHUNK_TAG_SIZE : 0);
+        this->jobTotal = this->threadTotal * 2;
+        this->jobList = memNew(sizeof(CipherChunkJob) * this->jobTotal);
+
+        for (unsigned int jobIdx = 0; jobIdx < this->jobTotal; jobIdx++)
+        {
+            this->jobList[jobIdx] = (CipherChunkJob)
+            {
+                .input = memNew(this->jobInputMax),
+                .output = memNew(this->chunkSize + CIPHER_CHUNK_TAG_SIZE),
+            };
+        }
+    }
+    MEM_CONTEXT_END();
+
+    this->keyDone = true;
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Start threads
+
+Threads are only started when there is more than one thread.  With one thread jobs are processed by cipherChunkJobPut().
+***********************************************************************************************************************************/
+static void
+cipherChunkThreadStart(CipherChunk *this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(CIPHER_CHUNK, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    for (unsigned int threadIdx = 0; threadIdx < this->threadTotal; threadIdx++)
+    {
+        int result = pthread_create(&this->threadList[threadIdx].thread, NULL, cipherChunkThread, &this->threadList[threadIdx]);
+
+        if (result != 0)
+        {
+            errno = result;
+            THROW_SYS_ERROR(KernelError, "unable to create cipher thread");
+        }
+
+        this->threadStarted++;
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Queue the job being filled to be encrypted/decrypted
+
+Must be called with the mutex locked.
+***********************************************************************************************************************************/
+static void
+cipherChunkJobPut(CipherChunk *this, bool last)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(CIPHER_CHUNK, this);
+        FUNCTION_TEST_PARAM(BOOL, last);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    CipherChunkJob *job = &this->jobList[this->jobPut % this->jobTotal];
+    job->inputSize = this->inputSize;
+    job->outputSize = 0;
+    job->chunkNo = this->jobPut;
+    job->last = last;
+
+    this->inputSize = 0;
+    this->jobPut++;
+    this->lastPut = last;
+
+    // With one thread process the job now.  The error is stored like an error from a thread so it is thrown once the mutex has been
+    // unlocked.
+    if (this->threadTotal == 1)
+    {
+        TRY_BEGIN()
+        {
+            cipherChunkJob(this->mode, this->header, this->threadList[0].context, job);
+            job->done = true;
+            this->jobGet++;
+        }
+        CATCH_ANY()
+        {
+            cipherChunkErrorSet(this);
+        }
+        TRY_END();
+    }
+    else
+        pthread_cond_broadcast(&this->cond);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Write the header on encrypt or read the header on decrypt
+***********************************************************************************************************************************/
+static void
+cipherChunkHeader(CipherChunk *this, const Buffer *input, Buffer *output)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(CIPHER_CHUNK, this);
+        FUNCTION_LOG_PARAM(BUFFER, input);
+        FUNCTION_LOG_PARAM(BUFFER, output);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(output != NULL);
+
+    if (this->mode == cipherModeEncrypt)
+    {
+        // Generate the header
+        if (!this->keyDone)
+        {
+            memcpy(this->header, CIPHER_CHUNK_MAGIC, CIPHER_CHUNK_MAGIC_SIZE);
+            cryptoRandomBytes(this->header + CIPHER_CHUNK_MAGIC_SIZE, CIPHER_CHUNK_SALT_SIZE);
+
+            for (unsigned int byteIdx = 0; byteIdx < CIPHER_CHUNK_SIZE_SIZE; byteIdx++)
+            {
+                this->header[CIPHER_CHUNK_HEADER_SIZE - 1 - byteIdx] = (unsigned char)(this->chunkSize >> (byteIdx * 8));
+            }
+
+            cipherChunkInit(this);
+        }
+
+        // Write as much of the header as will fit
+        size_t headerSize = CIPHER_CHUNK_HEADER_SIZE - this->headerSize;
+
+        if (headerSize > bufRemains(output))
+            headerSize = bufRemains(output);
+
+        bufCatC(output, this->header, this->headerSize, headerSize);
+        this->headerSize += headerSize;
+    }
+    else
+    {
+        // If there is no more input then the header is missing
+        if (input == NULL)
+            THROW(CryptoError, "cipher header missing");
+
+        // Read as much of the header as is available
+        size_t headerSize = CIPHER_CHUNK_HEADER_SIZE - this->headerSize;
+
+        if (headerSize > bufUsed(input) - this->inputOffset)
+            headerSize = bufUsed(input) - this->inputOffset;
+
+        memcpy(this->header + this->headerSize, bufPtr(input) + this->inputOffset, headerSize);
+        this->headerSize += headerSize;
+        this->inputOffset += headerSize;
+
+        // When the header is complete check it and get the chunk size
+        if (this->headerSize == CIPHER_CHUNK_HEADER_SIZE)
+        {
+            this->chunkSize = cipherChunkSize(BUF(this->header, CIPHER_CHUNK_HEADER_SIZE));
+            cipherChunkInit(this);
+        }
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Encrypt/decrypt data
+***********************************************************************************************************************************/
+static void
+cipherChunkProcess(THIS_VOID, const Buffer *input, Buffer *output)
+{
+    THIS(CipherChunk);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(CIPHER_CHUNK, this);
+        FUNCTION_LOG_PARAM(BUFFER, input);
+        FUNCTION_LOG_PARAM(BUFFER, output);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(!this->done);
+    ASSERT(output != NULL);
+    ASSERT(!this->flush || input == NULL);
+
+    // Flushing
+    if (input == NULL)
+        this->flush = true;
+
+    // Write/read the header
+    if (this->headerSize < CIPHER_CHUNK_HEADER_SIZE)
+        cipherChunkHeader(this, input, output);
+
+    if (this->headerSize == CIPHER_CHUNK_HEADER_SIZE)
+    {
+        // Start threads
+        if (this->threadTotal > 1 && this->threadStarted == 0)
+            cipherChunkThreadStart(this);
+
+        bool abort = false;
+
+        pthread_mutex_lock(&this->mutex);
+
+        while (!(abort = this->abort) && !this->done)
+        {
+            bool outputFull = bufFull(output);
+            CipherChunkJob *job = &this->jobList[this->jobOutput % this->jobTotal];
+
+            // Write the oldest job to the output when it has been processed
+            if (!outputFull && this->jobOutput < this->jobPut && job->done)
+            {
+                size_t outputSize = job->outputSize - this->outputOffset;
+
+                if (outputSize > bufRemains(output))
+                    outputSize = bufRemains(output);
+
+                bufCatC(output, job->output, this->outputOffset, outputSize);
+                this->outputOffset += outputSize;
+
+                // Free the job when it has been written
+                if (this->outputOffset == job->outputSize)
+                {
+                    if (job->last)
+                        this->done = true;
+
+                    job->done = false;
+                    this->outputOffset = 0;
+                    this->jobOutput++;
+                }
+
+                continue;
+            }
+
+            bool jobFree = this->jobPut - this->jobOutput < this->jobTotal;
+
+            // Fill a job with input
+            if (input != NULL && this->inputOffset < bufUsed(input))
+            {
+                if (jobFree)
+                {
+                    // A full job is queued only when there is more input since the last chunk must be known when it is queued
+                    if (this->inputSize == this->jobInputMax)
+                    {
+                        cipherChunkJobPut(this, false);
+                        continue;
+                    }
+
+                    job = &this->jobList[this->jobPut % this->jobTotal];
+
+                    size_t inputSize = bufUsed(input) - this->inputOffset;
+
+                    if (inputSize > this->jobInputMax - this->inputSize)
+                        inputSize = this->jobInputMax - this->inputSize;
+
+                    memcpy(job->input + this->inputSize, bufPtr(input) + this->inputOffset, inputSize);
+                    this->inputSize += inputSize;
+                    this->inputOffset += inputSize;
+
+                    continue;
+                }
+            }
+            // Put the last job, even if it is empty, to end the file
+            else if (this->flush)
+            {
+                if (!this->lastPut && jobFree)
+                {
+                    cipherChunkJobPut(this, true);
+                    continue;
+                }
+            }
+            // Else all the input has been used
+            else
+                break;
+
+            // No progress can be made until there is space in the output
+            if (outputFull)
+                break;
+
+            // Wait for a job to be processed.  This is never reached with one thread since jobs are processed when they are queued.
+            pthread_cond_wait(&this->cond, &this->mutex);
+        }
+
+        pthread_mutex_unlock(&this->mutex);
+
+        // Throw the error from the job that failed
+        if (abort)
+            THROWP(this->errorType, this->errorMessage);
+    }
+
+    // Can more input be provided on the next call?
+    this->inputSame = this->flush ? !this->done : this->inputOffset < bufUsed(input);
+
+    if (!this->inputSame)
+        this->inputOffset = 0;
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Is cipher done?
+***********************************************************************************************************************************/
+static bool
+cipherChunkDone(const THIS_VOID)
+{
+    THIS(const CipherChunk);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(CIPHER_CHUNK, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->done);
+}
+
+/***********************************************************************************************************************************
+Should the same input be provided again?
+***********************************************************************************************************************************/
+static bool
+cipherChunkInputSame(const THIS_VOID)
+{
+    THIS(const CipherChunk);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(CIPHER_CHUNK, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->inputSame);
+}
+
+/***********************************************************************************************************************************
+New chunk encrypt/decrypt object
+***********************************************************************************************************************************/
+IoFilter *
+cipherChunkNew(CipherMode mode, const Buffer *pass, unsigned int threadTotal)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(ENUM, mode);
+        FUNCTION_LOG_PARAM(BUFFER, pass);
+        FUNCTION_LOG_PARAM(UINT, threadTotal);
+    FUNCTION_LOG_END();
+
+    ASSERT(pass != NULL);
+    ASSERT(bufSize(pass) > 0);
+    ASSERT(threadTotal > 0);
+
+    // Init crypto subsystem
+    cryptoInit();
+
+    // Allocate memory to hold process state
+    IoFilter *this = NULL;
+
+    MEM_CONTEXT_NEW_BEGIN("CipherChunk")
+    {
+        CipherChunk *driver = memNew(sizeof(CipherChunk));
+        driver->memContext = MEM_CONTEXT_NEW();
+
+        // Set mode, encrypt or decrypt.  The chunk size is read from the header on decrypt.
+        driver->mode = mode;
+        driver->chunkSize = CIPHER_CHUNK_SIZE_DEFAULT;
+
+        // Store the passphrase
+        driver->passSize = bufUsed(pass);
+        driver->pass = memNewRaw(driver->passSize);
+        memcpy(driver->pass, bufPtr(pass), driver->passSize);
+
+        // Threads are created when the header has been written/read
+        driver->threadTotal = threadTotal;
+        driver->threadList = memNew(sizeof(CipherChunkThread) * threadTotal);
+
+        for (unsigned int threadIdx = 0; threadIdx < threadTotal; threadIdx++)
+            driver->threadList[threadIdx].cipher = driver;
+
+        pthread_mutex_init(&driver->mutex, NULL);
+        pthread_cond_init(&driver->cond, NULL);
+        memContextCallbackSet(driver->memContext, cipherChunkFreeResource, driver);
+
+        // Create param list
+        VariantList *paramList = varLstNew();
+        varLstAdd(paramList, varNewUInt(mode));
+        // ??? Using a string here is not correct since the passphrase is being passed as a buffer so may contain null characters.
+        // However, since strings are used to hold the passphrase in the rest of the code this is currently valid.
+        varLstAdd(paramList, varNewStr(strNewBuf(pass)));
+        varLstAdd(paramList, varNewUInt(threadTotal));
+
+        // Create filter interface
+        this = ioFilterNewP(
+            CIPHER_CHUNK_FILTER_TYPE_STR, driver, paramList, .done = cipherChunkDone, .inOut = cipherChunkProcess,
+            .inputSame = cipherChunkInputSame);
+    }
+    MEM_CONTEXT_NEW_END();
+
+    FUNCTION_LOG_RETURN(IO_FILTER, this);
+}
+
+IoFilter *
+cipherChunkNewVar(const VariantList *paramList)
+{
+    return cipherChunkNew(
+        (CipherMode)varUIntForce(varLstGet(paramList, 0)), BUFSTR(varStr(varLstGet(paramList, 1))),
+        varUIntForce(varLstGet(paramList, 2)));
+}
+
+/***********************************************************************************************************************************
+Get the chunk size from a header
+***********************************************************************************************************************************/
+size_t
+cipherChunkSize(const Buffer *header)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BUFFER, header);
+    FUNCTION_TEST_END();
+
+    ASSERT(header != NULL);
+
+    size_t result = 0;
+
+    if (bufUsed(header) == CIPHER_CHUNK_HEADER_SIZE && memcmp(bufPtr(header), CIPHER_CHUNK_MAGIC, CIPHER_CHUNK_MAGIC_SIZE) == 0)
+    {
+        for (unsigned int byteIdx = 0; byteIdx < CIPHER_CHUNK_SIZE_SIZE; byteIdx++)
+            result = result << 8 | bufPtr(header)[CIPHER_CHUNK_HEADER_SIZE - CIPHER_CHUNK_SIZE_SIZE + byteIdx];
+    }
+
+    // The first bytes of the file to decrypt should be equal to the magic.  If not then this is not an encrypted file, or at least
+    // not in a format we recognize.
+    if (result == 0 || result > CIPHER_CHUNK_SIZE_MAX)
+        THROW(CryptoError, "cipher header invalid");
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Offset of a chunk in the encrypted file
+***********************************************************************************************************************************/
+uint64_t
+cipherChunkOffset(size_t chunkSize, uint64_t chunkNo)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(SIZE, chunkSize);
+        FUNCTION_TEST_PARAM(UINT64, chunkNo);
+    FUNCTION_TEST_END();
+
+    ASSERT(chunkSize > 0);
+
+    FUNCTION_TEST_RETURN(CIPHER_CHUNK_HEADER_SIZE + chunkNo * (chunkSize + CIPHER_CHUNK_TAG_SIZE));
+}
+
+/***********************************************************************************************************************************
+Decrypt a single chunk
+***********************************************************************************************************************************/
+Buffer *
+cipherChunkDecrypt(const Buffer *pass, const Buffer *header, uint64_t chunkNo, bool last, const Buffer *chunk)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(BUFFER, pass);
+        FUNCTION_LOG_PARAM(BUFFER, header);
+        FUNCTION_LOG_PARAM(UINT64, chunkNo);
+        FUNCTION_LOG_PARAM(BOOL, last);
+        FUNCTION_LOG_PARAM(BUFFER, chunk);
+    FUNCTION_LOG_END();
+
+    ASSERT(pass != NULL);
+    ASSERT(header != NULL);
+    ASSERT(chunk != NULL);
+
+    // Init crypto subsystem
+    cryptoInit();
+
+    if (bufUsed(chunk) > cipherChunkSize(header) + CIPHER_CHUNK_TAG_SIZE)
+        THROW(CryptoError, "chunk is larger than the chunk size");
+
+    Buffer *result = bufNew(bufUsed(chunk));
+    EVP_CIPHER_CTX *context = cipherChunkContextNew(cipherModeDecrypt, bufPtr(pass), bufUsed(pass), bufPtr(header));
+
+    TRY_BEGIN()
+    {
+        CipherChunkJob job =
+        {
+            .input = bufPtr(chunk),
+            .inputSize = bufUsed(chunk),
+            .output = bufPtr(result),
+            .chunkNo = chunkNo,
+            .last = last,
+        };
+
+        cipherChunkJob(cipherModeDecrypt, bufPtr(header), context, &job);
+        bufUsedSet(result, job.outputSize);
+    }
+    FINALLY()
+    {
+        EVP_CIPHER_CTX_free(context);
+    }
+    TRY_END();
+
+    FUNCTION_LOG_RETURN(BUFFER, result);
+}
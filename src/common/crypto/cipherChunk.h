@@ -0,0 +1,66 @@
+/***********************************************************************************************************************************
+Chunk Cipher
+
+Encrypt/decrypt IO with aes-256-gcm in fixed size chunks that are each authenticated, so a file can be encrypted or decrypted in
+threads and a single chunk can be decrypted without reading the rest of the file.
+
+The file starts with a header that contains a magic, a random salt, and the chunk size.  The key is derived from the passphrase and
+salt.  Each chunk is followed by a tag and is encrypted with a nonce made from the chunk number, so chunks cannot be reordered.  The
+header and a flag marking the last chunk are authenticated with every chunk, so the header cannot be altered and the file cannot be
+truncated on a chunk boundary.  The last chunk may be shorter than the chunk size, and is empty when the file is empty.
+***********************************************************************************************************************************/
+#ifndef COMMON_CRYPTO_CIPHERCHUNK_H
+#define COMMON_CRYPTO_CIPHERCHUNK_H
+
+#include <stdint.h>
+
+#include "common/crypto/common.h"
+#include "common/io/filter/filter.h"
+
+/***********************************************************************************************************************************
+Filter type constant
+***********************************************************************************************************************************/
+#define CIPHER_CHUNK_FILTER_TYPE                                    "cipherChunk"
+    STRING_DECLARE(CIPHER_CHUNK_FILTER_TYPE_STR);
+
+/***********************************************************************************************************************************
+Format constants
+***********************************************************************************************************************************/
+// Magic constant at the beginning of the file to identify the format
+#define CIPHER_CHUNK_MAGIC                                          "PGBRCHK1"
+#define CIPHER_CHUNK_MAGIC_SIZE                                     (sizeof(CIPHER_CHUNK_MAGIC) - 1)
+
+// Size of the header at the beginning of the file
+#define CIPHER_CHUNK_HEADER_SIZE                                    28
+
+// Size of the tag that follows each chunk
+#define CIPHER_CHUNK_TAG_SIZE                                       16
+
+// Size of chunks written on encrypt.  Large enough that each chunk is a single large cipher update and the tag is a small overhead.
+#define CIPHER_CHUNK_SIZE_DEFAULT                                   ((size_t)64 * 1024)
+
+// Maximum chunk size accepted on decrypt
+#define CIPHER_CHUNK_SIZE_MAX                                       ((size_t)16 * 1024 * 1024)
+
+/***********************************************************************************************************************************
+Constructor
+***********************************************************************************************************************************/
+IoFilter *cipherChunkNew(CipherMode mode, const Buffer *pass, unsigned int threadTotal);
+IoFilter *cipherChunkNewVar(const VariantList *paramList);
+
+/***********************************************************************************************************************************
+Random access functions
+
+The header is read first to get the chunk size, then the chunk that contains a plaintext offset can be read and decrypted by itself.
+The size of the last chunk is determined by the size of the file.
+***********************************************************************************************************************************/
+// Get the chunk size from a header (also validates the header)
+size_t cipherChunkSize(const Buffer *header);
+
+// Offset of the chunk in the encrypted file
+uint64_t cipherChunkOffset(size_t chunkSize, uint64_t chunkNo);
+
+// Decrypt a single chunk (including the tag)
+Buffer *cipherChunkDecrypt(const Buffer *pass, const Buffer *header, uint64_t chunkNo, bool last, const Buffer *chunk);
+
+#endif
@@ -0,0 +1,207 @@
+/***********************************************************************************************************************************
+Detect Cipher
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#include <string.h>
+
+#include "common/crypto/cipherBlock.h"
+#include "common/crypto/cipherChunk.h"
+#include "common/crypto/cipherDetect.h"
+#include "common/debug.h"
+#include "common/io/filter/filter.intern.h"
+#include "common/log.h"
+#include "common/memContext.h"
+#include "common/object.h"
+
+/***********************************************************************************************************************************
+Filter type constant
+***********************************************************************************************************************************/
+STRING_EXTERN(CIPHER_DETECT_FILTER_TYPE_STR,                        CIPHER_DETECT_FILTER_TYPE);
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+typedef struct CipherDetect
+{
+    MemContext *memContext;                                         // Context to store data
+    Buffer *pass;                                                   // Passphrase used to generate encryption key
+    unsigned int threadTotal;                                       // Threads used by ciphers that can be processed in threads
+    unsigned char header[CIPHER_CHUNK_MAGIC_SIZE];                  // Magic read so far
+    size_t headerSize;                                              // Size of magic read so far
+    Buffer *pending;                                                // Input read before the cipher was detected
+    IoFilter *cipher;                                               // Cipher detected from the magic
+} CipherDetect;
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+static String *
+cipherDetectToLog(const CipherDetect *this)
+{
+    return strNewFmt(
+        "{headerSize: %zu, cipher: %s}", this->headerSize, this->cipher == NULL ? "null" : strPtr(ioFilterType(this->cipher)));
+}
+
+#define FUNCTION_LOG_CIPHER_DETECT_TYPE                                                                                            \
+    CipherDetect *
+#define FUNCTION_LOG_CIPHER_DETECT_FORMAT(value, buffer, bufferSize)                                                               \
+    FUNCTION_LOG_STRING_OBJECT_FORMAT(value, cipherDetectToLog, buffer, bufferSize)
+
+/***********************************************************************************************************************************
+Detect the cipher and pass input to it
+***********************************************************************************************************************************/
+static void
+cipherDetectProcess(THIS_VOID, const Buffer *input, Buffer *output)
+{
+    THIS(CipherDetect);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(CIPHER_DETECT, this);
+        FUNCTION_LOG_PARAM(BUFFER, input);
+        FUNCTION_LOG_PARAM(BUFFER, output);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(output != NULL);
+
+    if (this->cipher == NULL)
+    {
+        MEM_CONTEXT_BEGIN(this->memContext)
+        {
+            // Read the magic, which may be split across inputs
+            if (input != NULL)
+            {
+                size_t headerSize = CIPHER_CHUNK_MAGIC_SIZE - this->headerSize;
+
+                if (headerSize > bufUsed(input))
+                    headerSize = bufUsed(input);
+
+                memcpy(this->header + this->headerSize, bufPtr(input), headerSize);
+                this->headerSize += headerSize;
+
+                // Once the magic is complete the cipher will need to process it along with the rest of the input
+                if (this->headerSize == CIPHER_CHUNK_MAGIC_SIZE)
+                {
+                    this->pending = bufNew(CIPHER_CHUNK_MAGIC_SIZE + bufUsed(input) - headerSize);
+                    bufCatC(this->pending, this->header, 0, CIPHER_CHUNK_MAGIC_SIZE);
+                    bufCatSub(this->pending, input, headerSize, bufUsed(input) - headerSize);
+                }
+            }
+            // Else the input ended before the magic was complete so let the cipher report the error
+            else if (this->headerSize > 0)
+                this->pending = bufNewC(this->header, this->headerSize);
+
+            // Anything that does not start with the chunk magic is left for the block cipher to validate
+            if (this->pending != NULL || input == NULL)
+            {
+                if (this->headerSize == CIPHER_CHUNK_MAGIC_SIZE &&
+                    memcmp(this->header, CIPHER_CHUNK_MAGIC, CIPHER_CHUNK_MAGIC_SIZE) == 0)
+                {
+                    this->cipher = cipherChunkNew(cipherModeDecrypt, this->pass, this->threadTotal);
+                }
+                else
+                    this->cipher = cipherBlockNew(cipherModeDecrypt, cipherTypeAes256Cbc, this->pass, NULL);
+            }
+        }
+        MEM_CONTEXT_END();
+    }
+
+    if (this->cipher != NULL)
+    {
+        // Process input read before the cipher was detected.  The input passed again while it is pending has already been read.
+        if (this->pending != NULL)
+        {
+            ioFilterProcessInOut(this->cipher, this->pending, output);
+
+            if (!ioFilterInputSame(this->cipher))
+            {
+                bufFree(this->pending);
+                this->pending = NULL;
+            }
+        }
+        else
+            ioFilterProcessInOut(this->cipher, input, output);
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Is cipher done?
+***********************************************************************************************************************************/
+static bool
+cipherDetectDone(const THIS_VOID)
+{
+    THIS(const CipherDetect);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(CIPHER_DETECT, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->cipher != NULL && ioFilterDone(this->cipher));
+}
+
+/***********************************************************************************************************************************
+Should the same input be provided again?
+***********************************************************************************************************************************/
+static bool
+cipherDetectInputSame(const THIS_VOID)
+{
+    THIS(const CipherDetect);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(CIPHER_DETECT, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->cipher != NULL && ioFilterInputSame(this->cipher));
+}
+
+/***********************************************************************************************************************************
+New object
+***********************************************************************************************************************************/
+IoFilter *
+cipherDetectNew(const Buffer *pass, unsigned int threadTotal)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(BUFFER, pass);
+        FUNCTION_LOG_PARAM(UINT, threadTotal);
+    FUNCTION_LOG_END();
+
+    ASSERT(pass != NULL);
+    ASSERT(bufSize(pass) > 0);
+    ASSERT(threadTotal > 0);
+
+    IoFilter *this = NULL;
+
+    MEM_CONTEXT_NEW_BEGIN("CipherDetect")
+    {
+        CipherDetect *driver = memNew(sizeof(CipherDetect));
+        driver->memContext = MEM_CONTEXT_NEW();
+        driver->pass = bufDup(pass);
+        driver->threadTotal = threadTotal;
+
+        // Create param list
+        VariantList *paramList = varLstNew();
+        varLstAdd(paramList, varNewStr(strNewBuf(pass)));
+        varLstAdd(paramList, varNewUInt(threadTotal));
+
+        // Create filter interface
+        this = ioFilterNewP(
+            CIPHER_DETECT_FILTER_TYPE_STR, driver, paramList, .done = cipherDetectDone, .inOut = cipherDetectProcess,
+            .inputSame = cipherDetectInputSame);
+    }
+    MEM_CONTEXT_NEW_END();
+
+    FUNCTION_LOG_RETURN(IO_FILTER, this);
+}
+
+IoFilter *
+cipherDetectNewVar(const VariantList *paramList)
+{
+    return cipherDetectNew(BUFSTR(varStr(varLstGet(paramList, 0))), varUIntForce(varLstGet(paramList, 1)));
+}
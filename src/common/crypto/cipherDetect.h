@@ -0,0 +1,26 @@
+/***********************************************************************************************************************************
+Detect Cipher
+
+Decrypt IO with the cipher that encrypted it, which is detected from the magic at the beginning of the file.  Files encrypted with a
+cipher type that is no longer configured can still be read, so the cipher type of a repository can be changed without making the
+existing files unreadable.
+***********************************************************************************************************************************/
+#ifndef COMMON_CRYPTO_CIPHERDETECT_H
+#define COMMON_CRYPTO_CIPHERDETECT_H
+
+#include "common/crypto/common.h"
+#include "common/io/filter/filter.h"
+
+/***********************************************************************************************************************************
+Filter type constant
+***********************************************************************************************************************************/
+#define CIPHER_DETECT_FILTER_TYPE                                   "cipherDetect"
+    STRING_DECLARE(CIPHER_DETECT_FILTER_TYPE_STR);
+
+/***********************************************************************************************************************************
+Constructor
+***********************************************************************************************************************************/
+IoFilter *cipherDetectNew(const Buffer *pass, unsigned int threadTotal);
+IoFilter *cipherDetectNewVar(const VariantList *paramList);
+
+#endif
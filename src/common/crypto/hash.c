@@ -49,6 +49,21 @@ typedef struct CryptoHash
     Buffer *hash;                                                   // Hash in binary form
 } CryptoHash;
 
+/***********************************************************************************************************************************
+Multiple hashes are calculated over the same message one chunk at a time so the chunk stays in the CPU cache while each hash
+processes it, rather than each hash reading the entire message from memory
+***********************************************************************************************************************************/
+#define CRYPTO_HASH_MANY_CHUNK_SIZE                                 (16 * 1024)
+
+struct CryptoHashMany
+{
+    MemContext *memContext;                                         // Context to store data
+    unsigned int hashTotal;                                         // Total hashes
+    IoFilter **hashList;                                            // Hash filters
+};
+
+OBJECT_DEFINE_FREE(CRYPTO_HASH_MANY);
+
 /***********************************************************************************************************************************
 Macros for function logging
 ***********************************************************************************************************************************/
@@ -187,6 +202,87 @@ cryptoHashNewVar(const VariantList *paramList)
     return cryptoHashNew(varStr(varLstGet(paramList, 0)));
 }
 
+/***********************************************************************************************************************************
+New multiple hash object
+
+Hashes are referenced by their index in the type list.
+***********************************************************************************************************************************/
+CryptoHashMany *
+cryptoHashManyNew(const StringList *typeList)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STRING_LIST, typeList);
+    FUNCTION_LOG_END();
+
+    ASSERT(typeList != NULL);
+    ASSERT(strLstSize(typeList) > 0);
+
+    CryptoHashMany *this = NULL;
+
+    MEM_CONTEXT_NEW_BEGIN("CryptoHashMany")
+    {
+        this = memNew(sizeof(CryptoHashMany));
+        this->memContext = MEM_CONTEXT_NEW();
+        this->hashTotal = strLstSize(typeList);
+        this->hashList = memNew(sizeof(IoFilter *) * this->hashTotal);
+
+        for (unsigned int hashIdx = 0; hashIdx < this->hashTotal; hashIdx++)
+            this->hashList[hashIdx] = cryptoHashNew(strLstGet(typeList, hashIdx));
+    }
+    MEM_CONTEXT_NEW_END();
+
+    FUNCTION_LOG_RETURN(CRYPTO_HASH_MANY, this);
+}
+
+/***********************************************************************************************************************************
+Add message data to all hashes
+
+This may be called multiple times, e.g. as a buffer is filled, as long as no results have been requested.
+***********************************************************************************************************************************/
+void
+cryptoHashManyProcess(CryptoHashMany *this, const Buffer *message)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(CRYPTO_HASH_MANY, this);
+        FUNCTION_LOG_PARAM(BUFFER, message);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(message != NULL);
+
+    for (size_t chunkOffset = 0; chunkOffset < bufUsed(message); chunkOffset += CRYPTO_HASH_MANY_CHUNK_SIZE)
+    {
+        size_t chunkSize = bufUsed(message) - chunkOffset;
+
+        if (chunkSize > CRYPTO_HASH_MANY_CHUNK_SIZE)
+            chunkSize = CRYPTO_HASH_MANY_CHUNK_SIZE;
+
+        for (unsigned int hashIdx = 0; hashIdx < this->hashTotal; hashIdx++)
+            cryptoHashProcess(ioFilterDriver(this->hashList[hashIdx]), BUF(bufPtr(message) + chunkOffset, chunkSize));
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Get binary representation of a hash
+
+No more message data can be processed once a result has been requested.
+***********************************************************************************************************************************/
+const Buffer *
+cryptoHashManyResult(CryptoHashMany *this, unsigned int hashIdx)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(CRYPTO_HASH_MANY, this);
+        FUNCTION_LOG_PARAM(UINT, hashIdx);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(hashIdx < this->hashTotal);
+
+    FUNCTION_LOG_RETURN_CONST(BUFFER, cryptoHash(ioFilterDriver(this->hashList[hashIdx])));
+}
+
 /***********************************************************************************************************************************
 Get hash for one C buffer
 ***********************************************************************************************************************************/
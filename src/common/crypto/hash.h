@@ -8,6 +8,15 @@ Generate a hash (sha1, md5, etc.) from a string, Buffer, or using an IoFilter.
 
 #include "common/io/filter/filter.h"
 #include "common/type/string.h"
+#include "common/type/stringList.h"
+
+/***********************************************************************************************************************************
+Multiple hash object
+***********************************************************************************************************************************/
+#define CRYPTO_HASH_MANY_TYPE                                       CryptoHashMany
+#define CRYPTO_HASH_MANY_PREFIX                                     cryptoHashMany
+
+typedef struct CryptoHashMany CryptoHashMany;
 
 /***********************************************************************************************************************************
 Filter type constant
@@ -53,10 +62,35 @@ Constructor
 IoFilter *cryptoHashNew(const String *type);
 IoFilter *cryptoHashNewVar(const VariantList *paramList);
 
+CryptoHashMany *cryptoHashManyNew(const StringList *typeList);
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+void cryptoHashManyProcess(CryptoHashMany *this, const Buffer *message);
+
+/***********************************************************************************************************************************
+Getters
+***********************************************************************************************************************************/
+const Buffer *cryptoHashManyResult(CryptoHashMany *this, unsigned int hashIdx);
+
+/***********************************************************************************************************************************
+Destructor
+***********************************************************************************************************************************/
+void cryptoHashManyFree(CryptoHashMany *this);
+
 /***********************************************************************************************************************************
 Helper functions
 ***********************************************************************************************************************************/
 Buffer *cryptoHashOne(const String *type, const Buffer *message);
 Buffer *cryptoHmacOne(const String *type, const Buffer *key, const Buffer *message);
 
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+#define FUNCTION_LOG_CRYPTO_HASH_MANY_TYPE                                                                                         \
+    CryptoHashMany *
+#define FUNCTION_LOG_CRYPTO_HASH_MANY_FORMAT(value, buffer, bufferSize)                                                            \
+    objToLog(value, "CryptoHashMany", buffer, bufferSize)
+
 #endif
@@ -0,0 +1,45 @@
+/***********************************************************************************************************************************
+Cipher Helper
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#include "common/crypto/cipherBlock.h"
+#include "common/crypto/cipherChunk.h"
+#include "common/crypto/cipherDetect.h"
+#include "common/crypto/helper.h"
+#include "common/debug.h"
+#include "common/log.h"
+
+/***********************************************************************************************************************************
+Cipher filter for the cipher type
+***********************************************************************************************************************************/
+IoFilter *
+cipherFilter(CipherMode mode, CipherType type, const Buffer *pass, unsigned int threadTotal)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(ENUM, mode);
+        FUNCTION_LOG_PARAM(ENUM, type);
+        FUNCTION_LOG_PARAM(BUFFER, pass);
+        FUNCTION_LOG_PARAM(UINT, threadTotal);
+    FUNCTION_LOG_END();
+
+    ASSERT(type != cipherTypeNone);
+    ASSERT(pass != NULL);
+    ASSERT(threadTotal > 0);
+
+    IoFilter *result = NULL;
+
+    // Decrypt with the cipher that encrypted the file, which may not be the current type if the type has been changed
+    if (mode == cipherModeDecrypt)
+        result = cipherDetectNew(pass, threadTotal);
+    // The block cipher is a single stream so it cannot be processed in threads
+    else if (type == cipherTypeAes256Cbc)
+        result = cipherBlockNew(mode, type, pass, NULL);
+    else
+    {
+        ASSERT(type == cipherTypeAes256Gcm);
+        result = cipherChunkNew(mode, pass, threadTotal);
+    }
+
+    FUNCTION_LOG_RETURN(IO_FILTER, result);
+}
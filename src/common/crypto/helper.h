@@ -0,0 +1,26 @@
+/***********************************************************************************************************************************
+Cipher Helper
+
+Create the cipher filter for a cipher type so callers do not need to know which filter implements the type.
+***********************************************************************************************************************************/
+#ifndef COMMON_CRYPTO_HELPER_H
+#define COMMON_CRYPTO_HELPER_H
+
+#include "common/crypto/common.h"
+#include "common/io/filter/filter.h"
+
+/***********************************************************************************************************************************
+Minimum file size to encrypt/decrypt in threads
+
+Smaller files are only a few chunks so the cost of starting threads is not recovered.
+***********************************************************************************************************************************/
+#define CIPHER_THREAD_SIZE_MIN                                      ((uint64_t)1024 * 1024)
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+// Cipher filter for the cipher type.  The thread total is ignored by cipher types that cannot be processed in threads.  On decrypt
+// the cipher is detected from the file so files encrypted with a previous cipher type can still be read.
+IoFilter *cipherFilter(CipherMode mode, CipherType type, const Buffer *pass, unsigned int threadTotal);
+
+#endif
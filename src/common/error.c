@@ -39,9 +39,9 @@ States for each try
 typedef enum {errorStateBegin, errorStateTry, errorStateCatch, errorStateFinal, errorStateEnd} ErrorState;
 
 /***********************************************************************************************************************************
-Track error handling
+Track error handling (for each thread)
 ***********************************************************************************************************************************/
-static struct
+static __thread struct
 {
     // Array of jump buffers
     jmp_buf jumpList[ERROR_TRY_MAX];
@@ -78,9 +78,9 @@ The temp buffer is required because the error message being passed might be the
 ***********************************************************************************************************************************/
 #define ERROR_MESSAGE_BUFFER_SIZE                                   8192
 
-static char messageBuffer[ERROR_MESSAGE_BUFFER_SIZE];
-static char messageBufferTemp[ERROR_MESSAGE_BUFFER_SIZE];
-static char stackTraceBuffer[ERROR_MESSAGE_BUFFER_SIZE];
+static __thread char messageBuffer[ERROR_MESSAGE_BUFFER_SIZE];
+static __thread char messageBufferTemp[ERROR_MESSAGE_BUFFER_SIZE];
+static __thread char stackTraceBuffer[ERROR_MESSAGE_BUFFER_SIZE];
 
 /***********************************************************************************************************************************
 Error type code
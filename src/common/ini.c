@@ -8,6 +8,8 @@ Ini Handler
 #include <string.h>
 
 #include "common/debug.h"
+#include "common/io/bufferRead.h"
+#include "common/io/io.h"
 #include "common/memContext.h"
 #include "common/ini.h"
 #include "common/type/keyValue.h"
@@ -231,80 +233,250 @@ iniSectionList(const Ini *this)
 }
 
 /***********************************************************************************************************************************
-Parse ini from a string
+Trim whitespace from both ends of a buffer and zero-terminate it.  Returns the beginning of the trimmed buffer.
+***********************************************************************************************************************************/
+static char *
+iniTrim(char *begin, char *end)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(CHARDATA, begin);
+        FUNCTION_TEST_PARAM_P(CHARDATA, end);
+    FUNCTION_TEST_END();
+
+    ASSERT(begin != NULL);
+    ASSERT(end != NULL);
+    ASSERT(begin <= end);
+
+    while (begin < end && (*begin == ' ' || *begin == '\t' || *begin == '\r' || *begin == '\n'))
+        begin++;
+
+    while (end > begin && (*(end - 1) == ' ' || *(end - 1) == '\t' || *(end - 1) == '\r' || *(end - 1) == '\n'))
+        end--;
+
+    *end = '\0';
+
+    FUNCTION_TEST_RETURN(begin);
+}
+
+/***********************************************************************************************************************************
+Parse a single line and call the callback if it is a key/value.  The line must be zero-terminated and is modified in place.
+***********************************************************************************************************************************/
+static void
+iniLoadLine(char *line, size_t lineSize, unsigned int lineNo, String **section, IniLoadCallback callback, void *callbackData)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(CHARDATA, line);
+        FUNCTION_TEST_PARAM(SIZE, lineSize);
+        FUNCTION_TEST_PARAM(UINT, lineNo);
+        FUNCTION_TEST_PARAM_P(VOID, section);
+        FUNCTION_TEST_PARAM(FUNCTIONP, callback);
+        FUNCTION_TEST_PARAM_P(VOID, callbackData);
+    FUNCTION_TEST_END();
+
+    ASSERT(line != NULL);
+    ASSERT(section != NULL);
+    ASSERT(callback != NULL);
+
+    const char *linePtr = iniTrim(line, line + lineSize);
+    size_t linePtrSize = strlen(linePtr);
+
+    // Only interested in lines that are not blank or comments
+    if (linePtrSize > 0 && linePtr[0] != '#')
+    {
+        // Looks like this line is a section
+        if (linePtr[0] == '[')
+        {
+            // Make sure the section ends with ]
+            if (linePtr[linePtrSize - 1] != ']')
+                THROW_FMT(FormatError, "ini section should end with ] at line %u: %s", lineNo, linePtr);
+
+            // Assign section.  The section is copied since it is used by all the key/values that follow.
+            strFree(*section);
+            *section = strNewN(linePtr + 1, linePtrSize - 2);
+        }
+        // Else it should be a key/value
+        else
+        {
+            if (*section == NULL)
+                THROW_FMT(FormatError, "key/value found outside of section at line %u: %s", lineNo, linePtr);
+
+            // Find the =
+            char *lineEqual = strchr(linePtr, '=');
+
+            if (lineEqual == NULL)
+                THROW_FMT(FormatError, "missing '=' in key/value at line %u: %s", lineNo, linePtr);
+
+            // Error if the key is zero-length (the line has been trimmed so only the end of the key needs to be checked)
+            if (lineEqual == linePtr)
+                THROW_FMT(FormatError, "key is zero-length at line %u: %s", lineNo, linePtr);
+
+            // Extract the value and then the key, which overwrites the =
+            const char *value = iniTrim(lineEqual + 1, (char *)linePtr + linePtrSize);
+            const char *key = iniTrim((char *)linePtr, lineEqual);
+
+            // Pass the key/value as constant strings that point into the line
+            callback(callbackData, *section, STR(key), STR(value));
+        }
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Load ini from an IoRead incrementally
+
+Lines are parsed as they are read so the content is never held in memory all at once.  A line longer than the buffer causes the
+buffer to grow.
 ***********************************************************************************************************************************/
 void
-iniParse(Ini *this, const String *content)
+iniLoad(IoRead *read, IniLoadCallback callback, void *callbackData)
 {
     FUNCTION_TEST_BEGIN();
-        FUNCTION_TEST_PARAM(INI, this);
-        FUNCTION_TEST_PARAM(STRING, content);
+        FUNCTION_TEST_PARAM(IO_READ, read);
+        FUNCTION_TEST_PARAM(FUNCTIONP, callback);
+        FUNCTION_TEST_PARAM_P(VOID, callbackData);
     FUNCTION_TEST_END();
 
-    ASSERT(this != NULL);
+    ASSERT(read != NULL);
+    ASSERT(callback != NULL);
 
-    MEM_CONTEXT_BEGIN(this->memContext)
+    MEM_CONTEXT_TEMP_BEGIN()
     {
-        kvFree(this->store);
-        this->store = kvNew();
+        // Track the current section
+        String *section = NULL;
+        unsigned int lineNo = 0;
 
-        if (content != NULL)
+        // Open the read and load if it exists
+        if (ioReadOpen(read))
         {
-            MEM_CONTEXT_TEMP_BEGIN()
+            Buffer *buffer = bufNew(ioBufferSize());
+
+            do
             {
-                // Track the current section
-                String *section = NULL;
+                // Fill the buffer after any partial line left over from the last read
+                ioRead(read, buffer);
 
-                // Split the content into lines and loop
-                StringList *lines = strLstNewSplitZ(content, "\n");
+                char *bufferPtr = (char *)bufPtr(buffer);
+                size_t bufferUsed = bufUsed(buffer);
+                size_t lineBegin = 0;
+                bool eof = ioReadEof(read);
 
-                for (unsigned int lineIdx = 0; lineIdx < strLstSize(lines); lineIdx++)
+                while (lineBegin < bufferUsed)
                 {
-                    // Get next line
-                    const String *line = strTrim(strLstGet(lines, lineIdx));
-                    const char *linePtr = strPtr(line);
+                    char *lineEnd = memchr(bufferPtr + lineBegin, '\n', bufferUsed - lineBegin);
 
-                    // Only interested in lines that are not blank or comments
-                    if (strSize(line) > 0 && linePtr[0] != '#')
+                    // If there is no linefeed then the line is partial unless this is the end of the content
+                    if (lineEnd == NULL)
                     {
-                        // Looks like this line is a section
-                        if (linePtr[0] == '[')
-                        {
-                            // Make sure the section ends with ]
-                            if (linePtr[strSize(line) - 1] != ']')
-                                THROW_FMT(FormatError, "ini section should end with ] at line %u: %s", lineIdx + 1, linePtr);
+                        if (!eof)
+                            break;
 
-                            // Assign section
-                            section = strNewN(linePtr + 1, strSize(line) - 2);
-                        }
-                        // Else it should be a key/value
-                        else
+                        // Make room to zero-terminate the last line
+                        if (bufRemains(buffer) == 0)
                         {
-                            if (section == NULL)
-                                THROW_FMT(FormatError, "key/value found outside of section at line %u: %s", lineIdx + 1, linePtr);
+                            bufResize(buffer, bufSize(buffer) + 1);
+                            bufferPtr = (char *)bufPtr(buffer);
+                        }
 
-                            // Find the =
-                            const char *lineEqual = strstr(linePtr, "=");
+                        lineEnd = bufferPtr + bufferUsed;
+                    }
 
-                            if (lineEqual == NULL)
-                                THROW_FMT(FormatError, "missing '=' in key/value at line %u: %s", lineIdx + 1, linePtr);
+                    // Parse the line
+                    lineNo++;
+                    iniLoadLine(
+                        bufferPtr + lineBegin, (size_t)(lineEnd - (bufferPtr + lineBegin)), lineNo, &section, callback,
+                        callbackData);
 
-                            // Extract the key
-                            String *key = strTrim(strNewN(linePtr, (size_t)(lineEqual - linePtr)));
+                    lineBegin = (size_t)(lineEnd - bufferPtr) + 1;
+                }
 
-                            if (strSize(key) == 0)
-                                THROW_FMT(FormatError, "key is zero-length at line %u: %s", lineIdx++, linePtr);
+                // Move the partial line to the beginning of the buffer
+                if (lineBegin < bufferUsed)
+                {
+                    memmove(bufferPtr, bufferPtr + lineBegin, bufferUsed - lineBegin);
+                    bufUsedSet(buffer, bufferUsed - lineBegin);
 
-                            // Store the section/key/value
-                            iniSet(this, section, key, strTrim(strNew(lineEqual + 1)));
-                        }
-                    }
+                    // If the partial line fills the buffer then grow it
+                    if (bufFull(buffer))
+                        bufResize(buffer, bufSize(buffer) * 2);
                 }
+                else
+                    bufUsedZero(buffer);
             }
-            MEM_CONTEXT_TEMP_END();
+            while (!ioReadEof(read));
+
+            ioReadClose(read);
         }
     }
-    MEM_CONTEXT_END()
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Store a key/value loaded by iniLoad()
+***********************************************************************************************************************************/
+static void
+iniParseCallback(void *data, const String *section, const String *key, const String *value)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM(STRING, section);
+        FUNCTION_TEST_PARAM(STRING, key);
+        FUNCTION_TEST_PARAM(STRING, value);
+    FUNCTION_TEST_END();
+
+    ASSERT(data != NULL);
+
+    iniSet((Ini *)data, section, key, value);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Parse ini from an IoRead
+***********************************************************************************************************************************/
+void
+iniParseIo(Ini *this, IoRead *read)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INI, this);
+        FUNCTION_TEST_PARAM(IO_READ, read);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(read != NULL);
+
+    MEM_CONTEXT_BEGIN(this->memContext)
+    {
+        kvFree(this->store);
+        this->store = kvNew();
+    }
+    MEM_CONTEXT_END();
+
+    iniLoad(read, iniParseCallback, this);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Parse ini from a string
+***********************************************************************************************************************************/
+void
+iniParse(Ini *this, const String *content)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INI, this);
+        FUNCTION_TEST_PARAM(STRING, content);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        iniParseIo(this, ioBufferReadNew(content == NULL ? BUFSTRDEF("") : BUFSTR(content)));
+    }
+    MEM_CONTEXT_TEMP_END();
 
     FUNCTION_TEST_RETURN_VOID();
 }
@@ -327,17 +499,14 @@ iniSet(Ini *this, const String *section, const String *key, const String *value)
     ASSERT(key != NULL);
     ASSERT(value != NULL);
 
-    MEM_CONTEXT_TEMP_BEGIN()
-    {
-        const Variant *sectionKey = VARSTR(section);
-        KeyValue *sectionKv = varKv(kvGet(this->store, sectionKey));
+    // The key/value store copies the section, key, and value so no temp context is needed
+    const Variant *sectionKey = VARSTR(section);
+    KeyValue *sectionKv = varKv(kvGet(this->store, sectionKey));
 
-        if (sectionKv == NULL)
-            sectionKv = kvPutKv(this->store, sectionKey);
+    if (sectionKv == NULL)
+        sectionKv = kvPutKv(this->store, sectionKey);
 
-        kvAdd(sectionKv, VARSTR(key), VARSTR(value));
-    }
-    MEM_CONTEXT_TEMP_END();
+    kvAdd(sectionKv, VARSTR(key), VARSTR(value));
 
     FUNCTION_TEST_RETURN_VOID();
 }
@@ -12,6 +12,7 @@ Ini object
 
 typedef struct Ini Ini;
 
+#include "common/io/read.h"
 #include "common/io/write.h"
 #include "common/type/variant.h"
 
@@ -25,6 +26,7 @@ Functions
 ***********************************************************************************************************************************/
 Ini *iniMove(Ini *this, MemContext *parentNew);
 void iniParse(Ini *this, const String *content);
+void iniParseIo(Ini *this, IoRead *read);
 void iniSave(Ini *this, IoWrite *write);
 void iniSet(Ini *this, const String *section, const String *key, const String *value);
 
@@ -40,6 +42,16 @@ StringList *iniSectionList(const Ini *this);
 String *iniFileName(const Ini *this);
 bool iniFileExists(const Ini *this);
 
+/***********************************************************************************************************************************
+Load ini content incrementally without creating an Ini object
+
+The callback is called for each key/value as the content is read.  The section, key, and value point into the read buffer so they
+are only valid during the callback and must be copied if they are needed later.
+***********************************************************************************************************************************/
+typedef void (*IniLoadCallback)(void *data, const String *section, const String *key, const String *value);
+
+void iniLoad(IoRead *read, IniLoadCallback callback, void *callbackData);
+
 /***********************************************************************************************************************************
 Destructor
 ***********************************************************************************************************************************/
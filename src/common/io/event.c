@@ -0,0 +1,278 @@
+/***********************************************************************************************************************************
+IO Event
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#ifdef HAVE_EPOLL
+    #include <sys/epoll.h>
+    #include <unistd.h>
+#else
+    #include <poll.h>
+#endif
+
+#include "common/debug.h"
+#include "common/io/event.h"
+#include "common/log.h"
+#include "common/memContext.h"
+#include "common/object.h"
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+struct IoEvent
+{
+    MemContext *memContext;                                         // Mem context
+    unsigned int handleTotal;                                       // Total handles registered
+    unsigned int eventTotal;                                        // Total events returned by the last wait
+
+#ifdef HAVE_EPOLL
+    int handle;                                                     // Event handle
+    struct epoll_event *eventList;                                  // Events returned by the last wait
+    unsigned int eventSize;                                         // Size of event list
+#else
+    // When epoll is not available (e.g. macOS) poll() is used.  The cost of each wait depends on the number of handles registered
+    // but the handles waited on by the parallel executor are few enough that this does not matter.
+    struct pollfd *pollList;                                        // Handles registered
+    void **dataList;                                                // Data associated with each registered handle
+    void **readyList;                                               // Data of handles that were ready after the last wait
+    unsigned int pollSize;                                          // Size of poll, data, and ready lists
+#endif
+};
+
+OBJECT_DEFINE_FREE(IO_EVENT);
+
+#ifdef HAVE_EPOLL
+
+/***********************************************************************************************************************************
+Close event handle
+***********************************************************************************************************************************/
+OBJECT_DEFINE_FREE_RESOURCE_BEGIN(IO_EVENT, LOG, logLevelTrace)
+{
+    close(this->handle);
+}
+OBJECT_DEFINE_FREE_RESOURCE_END(LOG);
+
+#endif
+
+/***********************************************************************************************************************************
+New object
+***********************************************************************************************************************************/
+IoEvent *
+ioEventNew(void)
+{
+    FUNCTION_LOG_VOID(logLevelTrace);
+
+    IoEvent *this = NULL;
+
+    MEM_CONTEXT_NEW_BEGIN("IoEvent")
+    {
+        this = memNew(sizeof(IoEvent));
+        this->memContext = MEM_CONTEXT_NEW();
+
+#ifdef HAVE_EPOLL
+        THROW_ON_SYS_ERROR((this->handle = epoll_create1(EPOLL_CLOEXEC)) == -1, KernelError, "unable to create event handle");
+        memContextCallbackSet(this->memContext, ioEventFreeResource, this);
+#endif
+    }
+    MEM_CONTEXT_NEW_END();
+
+    FUNCTION_LOG_RETURN(IO_EVENT, this);
+}
+
+/***********************************************************************************************************************************
+Add a handle to wait on
+***********************************************************************************************************************************/
+void
+ioEventAdd(IoEvent *this, int handle, void *data)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(IO_EVENT, this);
+        FUNCTION_LOG_PARAM(INT, handle);
+        FUNCTION_LOG_PARAM_P(VOID, data);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(handle >= 0);
+
+#ifdef HAVE_EPOLL
+    struct epoll_event event = {.events = EPOLLIN, .data = {.ptr = data}};
+
+    THROW_ON_SYS_ERROR_FMT(
+        epoll_ctl(this->handle, EPOLL_CTL_ADD, handle, &event) == -1, KernelError, "unable to add handle %d to event", handle);
+#else
+    // Make sure the lists are large enough for the new handle
+    if (this->pollSize == this->handleTotal)
+    {
+        MEM_CONTEXT_BEGIN(this->memContext)
+        {
+            this->pollSize = this->pollSize == 0 ? 8 : this->pollSize * 2;
+
+            if (this->pollList == NULL)
+            {
+                this->pollList = memNewRaw(sizeof(struct pollfd) * this->pollSize);
+                this->dataList = memNewRaw(sizeof(void *) * this->pollSize);
+                this->readyList = memNewRaw(sizeof(void *) * this->pollSize);
+            }
+            else
+            {
+                this->pollList = memGrowRaw(this->pollList, sizeof(struct pollfd) * this->pollSize);
+                this->dataList = memGrowRaw(this->dataList, sizeof(void *) * this->pollSize);
+                this->readyList = memGrowRaw(this->readyList, sizeof(void *) * this->pollSize);
+            }
+        }
+        MEM_CONTEXT_END();
+    }
+
+    for (unsigned int handleIdx = 0; handleIdx < this->handleTotal; handleIdx++)
+    {
+        if (this->pollList[handleIdx].fd == handle)
+            THROW_FMT(KernelError, "unable to add handle %d to event: [17] File exists", handle);
+    }
+
+    this->pollList[this->handleTotal] = (struct pollfd){.fd = handle, .events = POLLIN};
+    this->dataList[this->handleTotal] = data;
+#endif
+
+    this->handleTotal++;
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Remove a handle so it is no longer waited on
+***********************************************************************************************************************************/
+void
+ioEventRemove(IoEvent *this, int handle)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(IO_EVENT, this);
+        FUNCTION_LOG_PARAM(INT, handle);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(handle >= 0);
+
+#ifdef HAVE_EPOLL
+    THROW_ON_SYS_ERROR_FMT(
+        epoll_ctl(this->handle, EPOLL_CTL_DEL, handle, NULL) == -1, KernelError, "unable to remove handle %d from event", handle);
+#else
+    // Find the handle and replace it with the last handle since order does not matter
+    unsigned int handleIdx = 0;
+
+    while (handleIdx < this->handleTotal && this->pollList[handleIdx].fd != handle)
+        handleIdx++;
+
+    if (handleIdx == this->handleTotal)
+        THROW_FMT(KernelError, "unable to remove handle %d from event: [2] No such file or directory", handle);
+
+    this->pollList[handleIdx] = this->pollList[this->handleTotal - 1];
+    this->dataList[handleIdx] = this->dataList[this->handleTotal - 1];
+#endif
+
+    this->handleTotal--;
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Wait for handles to be ready for reading
+
+Returns the number of ready handles.  Use ioEventReady() to get the data associated with each ready handle.  Zero is returned if the
+timeout expires before any handles are ready.
+***********************************************************************************************************************************/
+unsigned int
+ioEventWait(IoEvent *this, TimeMSec timeout)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(IO_EVENT, this);
+        FUNCTION_LOG_PARAM(TIME_MSEC, timeout);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->handleTotal > 0);
+
+#ifdef HAVE_EPOLL
+    // Make sure the event list is large enough to return all handles at once
+    if (this->eventSize < this->handleTotal)
+    {
+        MEM_CONTEXT_BEGIN(this->memContext)
+        {
+            if (this->eventList == NULL)
+                this->eventList = memNewRaw(sizeof(struct epoll_event) * this->handleTotal);
+            else
+                this->eventList = memGrowRaw(this->eventList, sizeof(struct epoll_event) * this->handleTotal);
+        }
+        MEM_CONTEXT_END();
+
+        this->eventSize = this->handleTotal;
+    }
+
+    int result = epoll_wait(this->handle, this->eventList, (int)this->eventSize, (int)timeout);
+    THROW_ON_SYS_ERROR(result == -1, KernelError, "unable to wait for events");
+
+    this->eventTotal = (unsigned int)result;
+#else
+    int result = poll(this->pollList, this->handleTotal, (int)timeout);
+    THROW_ON_SYS_ERROR(result == -1, KernelError, "unable to wait for events");
+
+    // Collect the data for ready handles.  Hangups and errors are returned as ready (as epoll does) so the read reports them.
+    this->eventTotal = 0;
+
+    for (unsigned int handleIdx = 0; handleIdx < this->handleTotal && result > 0; handleIdx++)
+    {
+        if (this->pollList[handleIdx].revents != 0)
+        {
+            this->readyList[this->eventTotal] = this->dataList[handleIdx];
+            this->eventTotal++;
+            result--;
+        }
+    }
+#endif
+
+    FUNCTION_LOG_RETURN(UINT, this->eventTotal);
+}
+
+/***********************************************************************************************************************************
+Get the data associated with a ready handle
+***********************************************************************************************************************************/
+void *
+ioEventReady(const IoEvent *this, unsigned int readyIdx)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(IO_EVENT, this);
+        FUNCTION_TEST_PARAM(UINT, readyIdx);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(readyIdx < this->eventTotal);
+
+#ifdef HAVE_EPOLL
+    FUNCTION_TEST_RETURN(this->eventList[readyIdx].data.ptr);
+#else
+    FUNCTION_TEST_RETURN(this->readyList[readyIdx]);
+#endif
+}
+
+/***********************************************************************************************************************************
+Total handles registered
+***********************************************************************************************************************************/
+unsigned int
+ioEventSize(const IoEvent *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(IO_EVENT, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->handleTotal);
+}
+
+/***********************************************************************************************************************************
+Render as string for logging
+***********************************************************************************************************************************/
+String *
+ioEventToLog(const IoEvent *this)
+{
+    return strNewFmt("{handleTotal: %u}", this->handleTotal);
+}
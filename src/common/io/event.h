@@ -0,0 +1,59 @@
+/***********************************************************************************************************************************
+IO Event
+
+Wait for any of a set of handles (file descriptors) to be ready for reading.  Handles are registered once with ioEventAdd() and remain
+registered until removed.  When epoll is available the cost of each wait depends on the number of handles that are ready rather than
+the number of handles registered, otherwise poll() is used and the cost depends on the number of handles registered.  In either case
+there is no limit on the value of a handle as there is with select().
+
+Data is associated with each handle when it is added and is returned for each ready handle after ioEventWait() so the caller does not
+need to search for the object that owns the handle.
+***********************************************************************************************************************************/
+#ifndef COMMON_IO_EVENT_H
+#define COMMON_IO_EVENT_H
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+#define IO_EVENT_TYPE                                               IoEvent
+#define IO_EVENT_PREFIX                                             ioEvent
+
+typedef struct IoEvent IoEvent;
+
+#include "common/time.h"
+#include "common/type/string.h"
+
+/***********************************************************************************************************************************
+Constructor
+***********************************************************************************************************************************/
+IoEvent *ioEventNew(void);
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+void ioEventAdd(IoEvent *this, int handle, void *data);
+void ioEventRemove(IoEvent *this, int handle);
+unsigned int ioEventWait(IoEvent *this, TimeMSec timeout);
+
+/***********************************************************************************************************************************
+Getters
+***********************************************************************************************************************************/
+void *ioEventReady(const IoEvent *this, unsigned int readyIdx);
+unsigned int ioEventSize(const IoEvent *this);
+
+/***********************************************************************************************************************************
+Destructor
+***********************************************************************************************************************************/
+void ioEventFree(IoEvent *this);
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+String *ioEventToLog(const IoEvent *this);
+
+#define FUNCTION_LOG_IO_EVENT_TYPE                                                                                                 \
+    IoEvent *
+#define FUNCTION_LOG_IO_EVENT_FORMAT(value, buffer, bufferSize)                                                                    \
+    FUNCTION_LOG_STRING_OBJECT_FORMAT(value, ioEventToLog, buffer, bufferSize)
+
+#endif
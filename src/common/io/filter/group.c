@@ -3,7 +3,10 @@ IO Filter Group
 ***********************************************************************************************************************************/
 #include "build.auto.h"
 
+#include <errno.h>
+#include <pthread.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "common/debug.h"
 #include "common/io/filter/buffer.h"
@@ -15,6 +18,24 @@ IO Filter Group
 #include "common/object.h"
 #include "common/type/list.h"
 
+/***********************************************************************************************************************************
+Link between filters when filters run in threads
+
+A link is a ring of buffers filled by a filter that produces output (or by ioFilterGroupProcess() with the input for the first link)
+and emptied by the next filter that produces output (or by ioFilterGroupProcess() into the output for the last link).  Filters that
+do not produce output read the buffers in between and pass them on without copying.  The number of buffers put into and taken from
+the link only ever increase so a buffer is free when it has been taken by the last reader.
+***********************************************************************************************************************************/
+#define IO_FILTER_GROUP_LINK_SIZE                                   2
+
+typedef struct IoFilterGroupLink
+{
+    Buffer *buffer[IO_FILTER_GROUP_LINK_SIZE];                      // Buffers in the ring
+    bool end[IO_FILTER_GROUP_LINK_SIZE];                            // Does the buffer mark the end of the data?
+    uint64_t put;                                                   // Total buffers put into the link
+    const uint64_t *getLast;                                        // Total buffers taken by the last reader
+} IoFilterGroupLink;
+
 /***********************************************************************************************************************************
 Filter and buffer structure
 
@@ -26,8 +47,42 @@ typedef struct IoFilterData
     Buffer *inputLocal;                                             // Non-null if a locally created buffer that can be cleared
     IoFilter *filter;                                               // Filter to apply
     Buffer *output;                                                 // Output buffer for filter
+
+    struct IoFilterGroupThread *threadData;                         // Thread data when the filter runs in a thread
+    MemContext *threadContext;                                      // Context used by the thread for allocations
+    pthread_t thread;                                               // Thread the filter runs in
+    IoFilterGroupLink *linkIn;                                      // Link the filter reads from
+    IoFilterGroupLink *linkOut;                                     // Link the filter writes to (NULL if no output)
+    uint64_t get;                                                   // Total buffers taken from the input link
+    const uint64_t *getPrior;                                       // Total buffers available to take from the input link
 } IoFilterData;
 
+/***********************************************************************************************************************************
+Thread data
+
+Threads share a single mutex/condition since the work done for each buffer is large compared to the cost of waking all threads.
+***********************************************************************************************************************************/
+#define IO_FILTER_GROUP_THREAD_ERROR_SIZE                           4096
+
+typedef struct IoFilterGroupThread
+{
+    MemContext *memContext;                                         // Mem context of thread data
+    List *filterList;                                               // Filters running in threads
+    pthread_mutex_t mutex;                                          // Mutex for all link and thread state
+    pthread_cond_t cond;                                            // Signaled whenever link or thread state changes
+    unsigned int threadTotal;                                       // Threads started
+
+    IoFilterGroupLink *linkFirst;                                   // Link filled with input
+    IoFilterGroupLink *linkLast;                                    // Link emptied into output
+    uint64_t get;                                                   // Total buffers taken from the last link
+    size_t getOffset;                                               // Offset into the current buffer of the last link
+    bool inputEnd;                                                  // Has the end of input been put into the first link?
+
+    bool abort;                                                     // Should the threads stop?
+    const ErrorType *errorType;                                     // Type of error thrown in a thread
+    char errorMessage[IO_FILTER_GROUP_THREAD_ERROR_SIZE];           // Message of error thrown in a thread
+} IoFilterGroupThread;
+
 // Macros for logging
 #define FUNCTION_LOG_IO_FILTER_DATA_TYPE                                                                                           \
     IoFilterData *
@@ -45,6 +100,8 @@ struct IoFilterGroup
     KeyValue *filterResult;                                         // Filter results (if any)
     bool inputSame;                                                 // Same input required again?
     bool done;                                                      // Is processing done?
+    bool thread;                                                    // Run each filter in a thread?
+    IoFilterGroupThread *threadData;                                // Thread data when filters are running in threads
 
 #ifdef DEBUG
     bool opened;                                                    // Has the filter set been opened?
@@ -143,6 +200,29 @@ ioFilterGroupGet(const IoFilterGroup *this, unsigned int filterIdx)
     FUNCTION_TEST_RETURN((IoFilterData *)lstGet(this->filterList, filterIdx));
 }
 
+/***********************************************************************************************************************************
+Run each filter in a thread
+
+Filters run in parallel so the throughput of the group is limited by the slowest filter rather than the sum of all filters.  This
+only makes sense for large amounts of data since starting the threads and passing buffers between them has a cost.  There is no
+effect when the group has only one filter.
+***********************************************************************************************************************************/
+void
+ioFilterGroupThreadSet(IoFilterGroup *this, bool thread)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(IO_FILTER_GROUP, this);
+        FUNCTION_LOG_PARAM(BOOL, thread);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(!this->opened);
+
+    this->thread = thread;
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Clear filters
 ***********************************************************************************************************************************/
@@ -164,6 +244,338 @@ ioFilterGroupClear(IoFilterGroup *this)
     FUNCTION_LOG_RETURN(IO_FILTER_GROUP, this);
 }
 
+/***********************************************************************************************************************************
+Stop and join threads
+
+Threads are stopped when abort is set, otherwise they are expected to exit after passing on the end of the data.
+***********************************************************************************************************************************/
+static void
+ioFilterGroupThreadJoin(IoFilterGroupThread *this, bool abort)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, this);
+        FUNCTION_TEST_PARAM(BOOL, abort);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    if (abort)
+    {
+        pthread_mutex_lock(&this->mutex);
+        this->abort = true;
+        pthread_cond_broadcast(&this->cond);
+        pthread_mutex_unlock(&this->mutex);
+    }
+
+    for (unsigned int threadIdx = 0; threadIdx < this->threadTotal; threadIdx++)
+        pthread_join(((IoFilterData *)lstGet(this->filterList, threadIdx))->thread, NULL);
+
+    this->threadTotal = 0;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Free thread data
+***********************************************************************************************************************************/
+static void
+ioFilterGroupThreadFree(void *thisVoid)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, thisVoid);
+    FUNCTION_TEST_END();
+
+    IoFilterGroupThread *this = thisVoid;
+
+    ioFilterGroupThreadJoin(this, true);
+
+    pthread_cond_destroy(&this->cond);
+    pthread_mutex_destroy(&this->mutex);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Wait for a thread state change
+
+Must be called with the mutex locked.  Return false if the threads should stop.
+***********************************************************************************************************************************/
+static bool
+ioFilterGroupThreadWait(IoFilterGroupThread *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    if (!this->abort)
+        pthread_cond_wait(&this->cond, &this->mutex);
+
+    FUNCTION_TEST_RETURN(!this->abort);
+}
+
+/***********************************************************************************************************************************
+Get a free buffer in a link to fill
+
+Must be called with the mutex locked.  Return NULL if the threads should stop.
+***********************************************************************************************************************************/
+static Buffer *
+ioFilterGroupThreadLinkFree(IoFilterGroupThread *this, IoFilterGroupLink *link)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, this);
+        FUNCTION_TEST_PARAM_P(VOID, link);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(link != NULL);
+
+    Buffer *result = NULL;
+
+    while (link->put - *link->getLast == IO_FILTER_GROUP_LINK_SIZE)
+    {
+        if (!ioFilterGroupThreadWait(this))
+            FUNCTION_TEST_RETURN(NULL);
+    }
+
+    if (!this->abort)
+    {
+        result = link->buffer[link->put % IO_FILTER_GROUP_LINK_SIZE];
+        bufUsedZero(result);
+    }
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Put a filled buffer into a link
+
+Must be called with the mutex locked.
+***********************************************************************************************************************************/
+static void
+ioFilterGroupThreadLinkPut(IoFilterGroupThread *this, IoFilterGroupLink *link, bool end)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, this);
+        FUNCTION_TEST_PARAM_P(VOID, link);
+        FUNCTION_TEST_PARAM(BOOL, end);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(link != NULL);
+
+    link->end[link->put % IO_FILTER_GROUP_LINK_SIZE] = end;
+    link->put++;
+    pthread_cond_broadcast(&this->cond);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Run a filter in a thread
+
+Take buffers from the input link and process them until the end of the data, putting output into the output link as buffers are
+filled.  Output buffers are only passed on when full (or at the end of the data) since some filters require full buffers.
+***********************************************************************************************************************************/
+static void *
+ioFilterGroupThreadMain(void *filterDataVoid)
+{
+    IoFilterData *filterData = filterDataVoid;
+    IoFilterGroupThread *this = filterData->threadData;
+
+    // Use a context that only this thread allocates from
+    memContextSwitch(filterData->threadContext);
+
+    TRY_BEGIN()
+    {
+        bool end = false;
+        Buffer *output = NULL;
+
+        pthread_mutex_lock(&this->mutex);
+
+        do
+        {
+            // Wait for input
+            while (*filterData->getPrior == filterData->get)
+            {
+                if (!ioFilterGroupThreadWait(this))
+                    break;
+            }
+
+            if (this->abort)
+                break;
+
+            unsigned int inputIdx = (unsigned int)(filterData->get % IO_FILTER_GROUP_LINK_SIZE);
+            const Buffer *input = filterData->linkIn->end[inputIdx] ? NULL : filterData->linkIn->buffer[inputIdx];
+            end = input == NULL;
+
+            // Filters that do not produce output just read the input
+            if (filterData->linkOut == NULL)
+            {
+                pthread_mutex_unlock(&this->mutex);
+                ioFilterProcessIn(filterData->filter, input);
+                pthread_mutex_lock(&this->mutex);
+            }
+            // Else process until the input has been used or the filter is done
+            else
+            {
+                do
+                {
+                    // Get a buffer for output
+                    if (output == NULL && (output = ioFilterGroupThreadLinkFree(this, filterData->linkOut)) == NULL)
+                        break;
+
+                    // Process the filter if it is not done
+                    if (!ioFilterDone(filterData->filter))
+                    {
+                        pthread_mutex_unlock(&this->mutex);
+                        ioFilterProcessInOut(filterData->filter, input, output);
+                        pthread_mutex_lock(&this->mutex);
+                    }
+
+                    // Pass output on when full or when the filter is done
+                    if (bufFull(output) || (ioFilterDone(filterData->filter) && bufUsed(output) > 0))
+                    {
+                        ioFilterGroupThreadLinkPut(this, filterData->linkOut, false);
+                        output = NULL;
+                    }
+                }
+                while (!ioFilterDone(filterData->filter) && (ioFilterInputSame(filterData->filter) || end));
+
+                // Pass on the end of the data
+                if (end && !this->abort)
+                {
+                    if (ioFilterGroupThreadLinkFree(this, filterData->linkOut) == NULL)
+                        break;
+
+                    ioFilterGroupThreadLinkPut(this, filterData->linkOut, true);
+                }
+
+                if (this->abort)
+                    break;
+            }
+
+            // Done with the input
+            filterData->get++;
+            pthread_cond_broadcast(&this->cond);
+        }
+        while (!end);
+
+        pthread_mutex_unlock(&this->mutex);
+    }
+    CATCH_ANY()
+    {
+        // Store the first error so it can be thrown by ioFilterGroupProcess() and stop the other threads
+        pthread_mutex_lock(&this->mutex);
+
+        if (this->errorType == NULL)
+        {
+            this->errorType = errorType();
+            strncpy(this->errorMessage, errorMessage(), sizeof(this->errorMessage) - 1);
+        }
+
+        this->abort = true;
+        pthread_cond_broadcast(&this->cond);
+        pthread_mutex_unlock(&this->mutex);
+    }
+    TRY_END();
+
+    return NULL;
+}
+
+/***********************************************************************************************************************************
+Start a thread for each filter
+***********************************************************************************************************************************/
+static void
+ioFilterGroupThreadOpen(IoFilterGroup *this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(IO_FILTER_GROUP, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->threadData == NULL);
+
+    // The thread data context must be freed before the filters since the threads must be stopped before the filters are freed.
+    // Contexts are freed in the order they were created so create it first.
+    MEM_CONTEXT_NEW_BEGIN("IoFilterGroupThread")
+    {
+        this->threadData = memNew(sizeof(IoFilterGroupThread));
+        *this->threadData = (IoFilterGroupThread){.memContext = MEM_CONTEXT_NEW(), .filterList = this->filterList};
+
+        pthread_mutex_init(&this->threadData->mutex, NULL);
+        pthread_cond_init(&this->threadData->cond, NULL);
+        memContextCallbackSet(this->threadData->memContext, ioFilterGroupThreadFree, this->threadData);
+    }
+    MEM_CONTEXT_NEW_END();
+
+    IoFilterGroupThread *threadData = this->threadData;
+
+    // Filters, links, and thread contexts are freed after the threads have been stopped
+    MEM_CONTEXT_NEW_BEGIN("IoFilterGroupFilter")
+    {
+        lstMove(this->filterList, MEM_CONTEXT_NEW());
+
+        // Create a link and make it the current link
+        IoFilterGroupLink *link = memNew(sizeof(IoFilterGroupLink));
+
+        for (unsigned int bufferIdx = 0; bufferIdx < IO_FILTER_GROUP_LINK_SIZE; bufferIdx++)
+            link->buffer[bufferIdx] = bufNew(ioBufferSize());
+
+        threadData->linkFirst = link;
+        const uint64_t *getPrior = &link->put;
+
+        for (unsigned int filterIdx = 0; filterIdx < ioFilterGroupSize(this); filterIdx++)
+        {
+            IoFilterData *filterData = ioFilterGroupGet(this, filterIdx);
+
+            ioFilterMove(filterData->filter, MEM_CONTEXT_NEW());
+            filterData->threadData = threadData;
+            filterData->threadContext = memContextNew("IoFilterGroupFilterThread");
+            filterData->linkIn = link;
+            filterData->getPrior = getPrior;
+            getPrior = &filterData->get;
+
+            // If the filter produces output then it is the last reader of the current link and the writer of a new link
+            if (ioFilterOutput(filterData->filter))
+            {
+                link->getLast = &filterData->get;
+
+                link = memNew(sizeof(IoFilterGroupLink));
+
+                for (unsigned int bufferIdx = 0; bufferIdx < IO_FILTER_GROUP_LINK_SIZE; bufferIdx++)
+                    link->buffer[bufferIdx] = bufNew(ioBufferSize());
+
+                filterData->linkOut = link;
+                getPrior = &link->put;
+            }
+        }
+
+        // The last link is emptied into the output by ioFilterGroupProcess()
+        link->getLast = &threadData->get;
+        threadData->linkLast = link;
+
+        // Start threads
+        for (unsigned int filterIdx = 0; filterIdx < ioFilterGroupSize(this); filterIdx++)
+        {
+            IoFilterData *filterData = ioFilterGroupGet(this, filterIdx);
+            int result = pthread_create(&filterData->thread, NULL, ioFilterGroupThreadMain, filterData);
+
+            if (result != 0)
+            {
+                errno = result;
+                THROW_SYS_ERROR(KernelError, "unable to create filter thread");
+            }
+
+            threadData->threadTotal++;
+        }
+    }
+    MEM_CONTEXT_NEW_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Open filter group
 
@@ -218,6 +630,10 @@ ioFilterGroupOpen(IoFilterGroup *this)
                 lastOutputBuffer = &filterData->output;
             }
         }
+
+        // Run filters in threads when requested and there is more than one filter
+        if (this->thread && ioFilterGroupSize(this) > 1)
+            ioFilterGroupThreadOpen(this);
     }
     MEM_CONTEXT_END();
 
@@ -229,6 +645,106 @@ ioFilterGroupOpen(IoFilterGroup *this)
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Process filters running in threads
+
+Put the input into the first link and take as much output from the last link as is available without waiting.  Only wait when the
+input cannot be put yet or, when flushing, until the output is full or the filters are done.
+***********************************************************************************************************************************/
+static void
+ioFilterGroupThreadProcess(IoFilterGroup *this, const Buffer *input, Buffer *output)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(IO_FILTER_GROUP, this);
+        FUNCTION_LOG_PARAM(BUFFER, input);
+        FUNCTION_LOG_PARAM(BUFFER, output);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->threadData != NULL);
+    ASSERT(output != NULL);
+
+    IoFilterGroupThread *threadData = this->threadData;
+    IoFilterGroupLink *linkFirst = threadData->linkFirst;
+    IoFilterGroupLink *linkLast = threadData->linkLast;
+    bool inputPut = input == NULL && threadData->inputEnd;
+
+    bool abort = false;
+
+    pthread_mutex_lock(&threadData->mutex);
+
+    while (!(abort = threadData->abort))
+    {
+        // Put the input into the first link when there is a free buffer
+        if (!inputPut && linkFirst->put - *linkFirst->getLast < IO_FILTER_GROUP_LINK_SIZE)
+        {
+            Buffer *buffer = linkFirst->buffer[linkFirst->put % IO_FILTER_GROUP_LINK_SIZE];
+            bufUsedZero(buffer);
+
+            if (input != NULL)
+            {
+                pthread_mutex_unlock(&threadData->mutex);
+                bufCat(buffer, input);
+                pthread_mutex_lock(&threadData->mutex);
+            }
+            else
+                threadData->inputEnd = true;
+
+            ioFilterGroupThreadLinkPut(threadData, linkFirst, input == NULL);
+            inputPut = true;
+        }
+
+        // Take output from the last link when available
+        if (!this->done && !bufFull(output) && threadData->get < linkLast->put)
+        {
+            unsigned int bufferIdx = (unsigned int)(threadData->get % IO_FILTER_GROUP_LINK_SIZE);
+
+            if (linkLast->end[bufferIdx])
+                this->done = true;
+            else
+            {
+                const Buffer *buffer = linkLast->buffer[bufferIdx];
+                size_t copySize = bufUsed(buffer) - threadData->getOffset;
+
+                if (copySize > bufRemains(output))
+                    copySize = bufRemains(output);
+
+                pthread_mutex_unlock(&threadData->mutex);
+                bufCatSub(output, buffer, threadData->getOffset, copySize);
+                pthread_mutex_lock(&threadData->mutex);
+
+                threadData->getOffset += copySize;
+            }
+
+            // Free the buffer when it has been copied
+            if (this->done || threadData->getOffset == bufUsed(linkLast->buffer[bufferIdx]))
+            {
+                threadData->get++;
+                threadData->getOffset = 0;
+                pthread_cond_broadcast(&threadData->cond);
+            }
+
+            continue;
+        }
+
+        // Return when the output is full, the filters are done, or the input has been put and more input is needed
+        if (bufFull(output) || this->done || (input != NULL && inputPut))
+            break;
+
+        pthread_cond_wait(&threadData->cond, &threadData->mutex);
+    }
+
+    pthread_mutex_unlock(&threadData->mutex);
+
+    // Throw the error from the thread that failed
+    if (abort)
+        THROWP(threadData->errorType, threadData->errorMessage);
+
+    this->inputSame = input != NULL && !inputPut;
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Process filters
 ***********************************************************************************************************************************/
@@ -254,104 +770,111 @@ ioFilterGroupProcess(IoFilterGroup *this, const Buffer *input, Buffer *output)
         this->flushing = true;
 #endif
 
-    // Assign input and output buffers
-    this->input = input;
-    (ioFilterGroupGet(this, ioFilterGroupSize(this) - 1))->output = output;
-
-    //
-    do
+    // Process filters running in threads
+    if (this->threadData != NULL)
+        ioFilterGroupThreadProcess(this, input, output);
+    // Else process filters in this thread
+    else
     {
-        // Start from the first filter by default
-        unsigned int filterIdx = 0;
+        // Assign input and output buffers
+        this->input = input;
+        (ioFilterGroupGet(this, ioFilterGroupSize(this) - 1))->output = output;
 
-        // Search from the end of the list for a filter that needs the same input.  This indicates that the filter was not able to
-        // empty the input buffer on the last call.  Maybe it won't this time either -- we can but try.
-        if (this->inputSame)
+        //
+        do
         {
-            this->inputSame = false;
-            filterIdx = ioFilterGroupSize(this);
+            // Start from the first filter by default
+            unsigned int filterIdx = 0;
 
-            do
+            // Search from the end of the list for a filter that needs the same input.  This indicates that the filter was not able
+            // to empty the input buffer on the last call.  Maybe it won't this time either -- we can but try.
+            if (this->inputSame)
             {
-                filterIdx--;
+                this->inputSame = false;
+                filterIdx = ioFilterGroupSize(this);
 
-                if (ioFilterInputSame((ioFilterGroupGet(this, filterIdx))->filter))
+                do
                 {
-                    this->inputSame = true;
-                    break;
-                }
-            }
-            while (filterIdx != 0);
+                    filterIdx--;
 
-            // If no filter is found that needs the same input that means we are done with the current input.  So end the loop and
-            // get some more input.
-            if (!this->inputSame)
-                break;
-        }
+                    if (ioFilterInputSame((ioFilterGroupGet(this, filterIdx))->filter))
+                    {
+                        this->inputSame = true;
+                        break;
+                    }
+                }
+                while (filterIdx != 0);
 
-        // Process forward from the filter that has input to process.  This may be a filter that needs the same input or it may be
-        // new input for the first filter.
-        for (; filterIdx < ioFilterGroupSize(this); filterIdx++)
-        {
-            IoFilterData *filterData = ioFilterGroupGet(this, filterIdx);
+                // If no filter is found that needs the same input that means we are done with the current input.  So end the loop
+                // and get some more input.
+                if (!this->inputSame)
+                    break;
+            }
 
-            // Process the filter if it is not done
-            if (!ioFilterDone(filterData->filter))
+            // Process forward from the filter that has input to process.  This may be a filter that needs the same input or it may
+            // be new input for the first filter.
+            for (; filterIdx < ioFilterGroupSize(this); filterIdx++)
             {
-                // If the filter produces output
-                if (ioFilterOutput(filterData->filter))
-                {
-                    ioFilterProcessInOut(filterData->filter, *filterData->input, filterData->output);
+                IoFilterData *filterData = ioFilterGroupGet(this, filterIdx);
 
-                    // If inputSame is set then the output buffer for this filter is full and it will need to be re-processed with
-                    // the same input once the output buffer is cleared
-                    if (ioFilterInputSame(filterData->filter))
+                // Process the filter if it is not done
+                if (!ioFilterDone(filterData->filter))
+                {
+                    // If the filter produces output
+                    if (ioFilterOutput(filterData->filter))
                     {
-                        this->inputSame = true;
+                        ioFilterProcessInOut(filterData->filter, *filterData->input, filterData->output);
+
+                        // If inputSame is set then the output buffer for this filter is full and it will need to be re-processed
+                        // with the same input once the output buffer is cleared
+                        if (ioFilterInputSame(filterData->filter))
+                        {
+                            this->inputSame = true;
+                        }
+                        // Else clear the buffer if it was locally allocated.  If the input buffer was passed in then the caller is
+                        // responsible for clearing it.
+                        else if (filterData->inputLocal != NULL)
+                            bufUsedZero(filterData->inputLocal);
+
+                        // If the output buffer is not full and the filter is not done then more data is required
+                        if (!bufFull(filterData->output) && !ioFilterDone(filterData->filter))
+                            break;
                     }
-                    // Else clear the buffer if it was locally allocated.  If the input buffer was passed in then the caller is
-                    // responsible for clearing it.
-                    else if (filterData->inputLocal != NULL)
-                        bufUsedZero(filterData->inputLocal);
-
-                    // If the output buffer is not full and the filter is not done then more data is required
-                    if (!bufFull(filterData->output) && !ioFilterDone(filterData->filter))
-                        break;
+                    // Else the filter does not produce output
+                    else
+                        ioFilterProcessIn(filterData->filter, *filterData->input);
                 }
-                // Else the filter does not produce output
-                else
-                    ioFilterProcessIn(filterData->filter, *filterData->input);
-            }
 
-            // If the filter is done and has no more output then null the output buffer.  Downstream filters have a pointer to this
-            // buffer so their inputs will also change to null and they'll flush.
-            if (filterData->output != NULL && ioFilterDone(filterData->filter) && bufUsed(filterData->output) == 0)
-                filterData->output = NULL;
+                // If the filter is done and has no more output then null the output buffer.  Downstream filters have a pointer to
+                // this buffer so their inputs will also change to null and they'll flush.
+                if (filterData->output != NULL && ioFilterDone(filterData->filter) && bufUsed(filterData->output) == 0)
+                    filterData->output = NULL;
+            }
         }
-    }
-    while (!bufFull(output) && this->inputSame);
+        while (!bufFull(output) && this->inputSame);
 
-    // Scan the filter list to determine if inputSame is set or done is not set for any filter.  We can't trust this->inputSame
-    // when it is true without going through the loop above again.  We need to scan to set this->done anyway so set this->inputSame
-    // in the same loop.
-    this->done = true;
-    this->inputSame = false;
+        // Scan the filter list to determine if inputSame is set or done is not set for any filter.  We can't trust this->inputSame
+        // when it is true without going through the loop above again.  We need to scan to set this->done anyway so set
+        // this->inputSame in the same loop.
+        this->done = true;
+        this->inputSame = false;
 
-    for (unsigned int filterIdx = 0; filterIdx < ioFilterGroupSize(this); filterIdx++)
-    {
-        IoFilterData *filterData = ioFilterGroupGet(this, filterIdx);
-
-        // When inputSame then this->done = false and we can exit the loop immediately
-        if (ioFilterInputSame(filterData->filter))
+        for (unsigned int filterIdx = 0; filterIdx < ioFilterGroupSize(this); filterIdx++)
         {
-            this->done = false;
-            this->inputSame = true;
-            break;
-        }
+            IoFilterData *filterData = ioFilterGroupGet(this, filterIdx);
+
+            // When inputSame then this->done = false and we can exit the loop immediately
+            if (ioFilterInputSame(filterData->filter))
+            {
+                this->done = false;
+                this->inputSame = true;
+                break;
+            }
 
-        // Set this->done = false if any filter is not done
-        if (!ioFilterDone(filterData->filter))
-            this->done = false;
+            // Set this->done = false if any filter is not done
+            if (!ioFilterDone(filterData->filter))
+                this->done = false;
+        }
     }
 
     FUNCTION_LOG_RETURN_VOID();
@@ -370,6 +893,10 @@ ioFilterGroupClose(IoFilterGroup *this)
     ASSERT(this != NULL);
     ASSERT(this->opened && !this->closed);
 
+    // Wait for threads to exit so the filter results are complete
+    if (this->threadData != NULL)
+        ioFilterGroupThreadJoin(this->threadData, false);
+
     for (unsigned int filterIdx = 0; filterIdx < ioFilterGroupSize(this); filterIdx++)
     {
         IoFilterData *filterData = ioFilterGroupGet(this, filterIdx);
@@ -47,6 +47,11 @@ const Variant *ioFilterGroupResultAll(const IoFilterGroup *this);
 void ioFilterGroupResultAllSet(IoFilterGroup *this, const Variant *filterResult);
 unsigned int ioFilterGroupSize(const IoFilterGroup *this);
 
+/***********************************************************************************************************************************
+Setters
+***********************************************************************************************************************************/
+void ioFilterGroupThreadSet(IoFilterGroup *this, bool thread);
+
 /***********************************************************************************************************************************
 Destructor
 ***********************************************************************************************************************************/
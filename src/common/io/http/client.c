@@ -3,6 +3,10 @@ Http Client
 ***********************************************************************************************************************************/
 #include "build.auto.h"
 
+#include <errno.h>
+#include <pthread.h>
+#include <string.h>
+
 #include "common/debug.h"
 #include "common/io/http/client.h"
 #include "common/io/http/common.h"
@@ -29,9 +33,12 @@ STRING_EXTERN(HTTP_VERB_PUT_STR,                                    HTTP_VERB_PU
     STRING_STATIC(HTTP_HEADER_CONNECTION_STR,                       HTTP_HEADER_CONNECTION);
 STRING_EXTERN(HTTP_HEADER_CONTENT_LENGTH_STR,                       HTTP_HEADER_CONTENT_LENGTH);
 STRING_EXTERN(HTTP_HEADER_CONTENT_MD5_STR,                          HTTP_HEADER_CONTENT_MD5);
+STRING_EXTERN(HTTP_HEADER_CONTENT_RANGE_STR,                        HTTP_HEADER_CONTENT_RANGE);
 #define HTTP_HEADER_TRANSFER_ENCODING                               "transfer-encoding"
     STRING_STATIC(HTTP_HEADER_TRANSFER_ENCODING_STR,                HTTP_HEADER_TRANSFER_ENCODING);
 STRING_EXTERN(HTTP_HEADER_ETAG_STR,                                 HTTP_HEADER_ETAG);
+STRING_EXTERN(HTTP_HEADER_IF_MATCH_STR,                             HTTP_HEADER_IF_MATCH);
+STRING_EXTERN(HTTP_HEADER_RANGE_STR,                                HTTP_HEADER_RANGE);
 
 #define HTTP_VALUE_CONNECTION_CLOSE                                 "close"
     STRING_STATIC(HTTP_VALUE_CONNECTION_CLOSE_STR,                  HTTP_VALUE_CONNECTION_CLOSE);
@@ -41,6 +48,9 @@ STRING_EXTERN(HTTP_HEADER_ETAG_STR,                                 HTTP_HEADER_
 // 5xx errors that should always be retried
 #define HTTP_RESPONSE_CODE_RETRY_CLASS                              5
 
+// Maximum size of an error message from the send thread
+#define HTTP_CLIENT_SEND_ERROR_SIZE                                 4096
+
 /***********************************************************************************************************************************
 Statistics
 ***********************************************************************************************************************************/
@@ -66,6 +76,17 @@ struct HttpClient
     uint64_t contentRemaining;                                      // Content remaining (per chunk if chunked)
     bool closeOnContentEof;                                         // Will server close after content is sent?
     bool contentEof;                                                // Has all content been read?
+
+    bool responsePending;                                           // Has a request been sent without reading the response?
+    bool responseHead;                                              // Was the pending request a HEAD?
+
+    MemContext *sendContext;                                        // Context used by the send thread for allocations
+    pthread_t sendThread;                                           // Thread writing a request sent with httpClientRequestSend()
+    bool sendThreadRunning;                                         // Has the send thread been started but not joined?
+    String *sendRequest;                                            // Request line and headers written by the send thread
+    const Buffer *sendBody;                                         // Body written by the send thread
+    const ErrorType *sendErrorType;                                 // Type of error thrown in the send thread
+    char sendErrorMessage[HTTP_CLIENT_SEND_ERROR_SIZE];             // Message of error thrown in the send thread
 };
 
 OBJECT_DEFINE_FREE(HTTP_CLIENT);
@@ -171,6 +192,84 @@ httpClientEof(THIS_VOID)
     FUNCTION_LOG_RETURN(BOOL, this->contentEof);
 }
 
+/***********************************************************************************************************************************
+Wait for the send thread to finish writing the request
+
+Any error thrown in the thread is kept in sendErrorType/sendErrorMessage for the caller to check.
+***********************************************************************************************************************************/
+static void
+httpClientSendJoin(HttpClient *this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(HTTP_CLIENT, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    if (this->sendThreadRunning)
+    {
+        pthread_join(this->sendThread, NULL);
+        this->sendThreadRunning = false;
+
+        // Free the request and anything allocated by the thread
+        memContextReset(this->sendContext);
+        this->sendRequest = NULL;
+        this->sendBody = NULL;
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Join the send thread before the tls client and send context are freed
+***********************************************************************************************************************************/
+static void
+httpClientSendFreeResource(void *thisVoid)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM_P(VOID, thisVoid);
+    FUNCTION_LOG_END();
+
+    ASSERT(thisVoid != NULL);
+
+    httpClientSendJoin(thisVoid);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Write a request sent with httpClientRequestSend()
+
+The thread only uses the tls session, which the main thread does not touch until the thread has been joined.
+***********************************************************************************************************************************/
+static void *
+httpClientSendThread(void *thisVoid)
+{
+    HttpClient *this = thisVoid;
+
+    // Use a context that only this thread allocates from
+    memContextSwitch(this->sendContext);
+
+    TRY_BEGIN()
+    {
+        ioWriteStr(tlsClientIoWrite(this->tls), this->sendRequest);
+
+        if (this->sendBody != NULL)
+            ioWrite(tlsClientIoWrite(this->tls), this->sendBody);
+
+        ioWriteFlush(tlsClientIoWrite(this->tls));
+    }
+    CATCH_ANY()
+    {
+        // Store the error so it can be thrown by httpClientResponse()
+        this->sendErrorType = errorType();
+        strncpy(this->sendErrorMessage, errorMessage(), sizeof(this->sendErrorMessage) - 1);
+    }
+    TRY_END();
+
+    return NULL;
+}
+
 /***********************************************************************************************************************************
 New object
 ***********************************************************************************************************************************/
@@ -198,6 +297,12 @@ httpClientNew(
         this->memContext = MEM_CONTEXT_NEW();
 
         this->timeout = timeout;
+
+        // The send thread is joined when this context is freed.  It must be created before the send context and tls client so the
+        // thread is stopped before the child contexts it uses are freed.
+        memContextCallbackSet(memContextNew("HttpClientSendGuard"), httpClientSendFreeResource, this);
+
+        this->sendContext = memContextNew("HttpClientSend");
         this->tls = tlsClientNew(host, port, timeout, verifyPeer, caFile, caPath);
 
         httpClientStatLocal.object++;
@@ -208,218 +313,319 @@ httpClientNew(
 }
 
 /***********************************************************************************************************************************
-Perform a request
+Prepare to write a request
+
+Reset the state left over from the last request and open the connection if it is not already open.
 ***********************************************************************************************************************************/
-Buffer *
-httpClientRequest(
+static void
+httpClientRequestOpen(HttpClient *this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace)
+        FUNCTION_LOG_PARAM(HTTP_CLIENT, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    // Free the read interface
+    httpClientDone(this);
+
+    // Free response status left over from the last request
+    httpHeaderFree(this->responseHeader);
+    this->responseHeader = NULL;
+    strFree(this->responseMessage);
+    this->responseMessage = NULL;
+
+    // Reset all content info
+    this->contentChunked = false;
+    this->contentSize = 0;
+    this->contentRemaining = 0;
+    this->closeOnContentEof = false;
+    this->contentEof = true;
+
+    if (tlsClientOpen(this->tls))
+        httpClientStatLocal.session++;
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Render the request line and headers
+***********************************************************************************************************************************/
+static String *
+httpClientRequestRender(const String *verb, const String *uri, const HttpQuery *query, const HttpHeader *requestHeader)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace)
+        FUNCTION_LOG_PARAM(STRING, verb);
+        FUNCTION_LOG_PARAM(STRING, uri);
+        FUNCTION_LOG_PARAM(HTTP_QUERY, query);
+        FUNCTION_LOG_PARAM(HTTP_HEADER, requestHeader);
+    FUNCTION_LOG_END();
+
+    ASSERT(verb != NULL);
+    ASSERT(uri != NULL);
+
+    String *result = strNew("");
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Request line
+        String *queryStr = httpQueryRender(query);
+
+        strCatFmt(
+            result, "%s %s%s%s " HTTP_VERSION "\r\n", strPtr(verb), strPtr(httpUriEncode(uri, true)), queryStr == NULL ? "" : "?",
+            queryStr == NULL ? "" : strPtr(queryStr));
+
+        // Headers
+        if (requestHeader != NULL)
+        {
+            const StringList *headerList = httpHeaderList(requestHeader);
+
+            for (unsigned int headerIdx = 0; headerIdx < strLstSize(headerList); headerIdx++)
+            {
+                const String *headerKey = strLstGet(headerList, headerIdx);
+                strCatFmt(result, "%s:%s\r\n", strPtr(headerKey), strPtr(httpHeaderGet(requestHeader, headerKey)));
+            }
+        }
+
+        // Blank line to end the headers
+        strCat(result, "\r\n");
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(STRING, result);
+}
+
+/***********************************************************************************************************************************
+Write a request
+***********************************************************************************************************************************/
+static void
+httpClientRequestWrite(
     HttpClient *this, const String *verb, const String *uri, const HttpQuery *query, const HttpHeader *requestHeader,
-    const Buffer *body, bool returnContent)
+    const Buffer *body)
 {
-    FUNCTION_LOG_BEGIN(logLevelDebug)
+    FUNCTION_LOG_BEGIN(logLevelTrace)
         FUNCTION_LOG_PARAM(HTTP_CLIENT, this);
         FUNCTION_LOG_PARAM(STRING, verb);
         FUNCTION_LOG_PARAM(STRING, uri);
         FUNCTION_LOG_PARAM(HTTP_QUERY, query);
         FUNCTION_LOG_PARAM(HTTP_HEADER, requestHeader);
         FUNCTION_LOG_PARAM(BUFFER, body);
-        FUNCTION_LOG_PARAM(BOOL, returnContent);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
     ASSERT(verb != NULL);
     ASSERT(uri != NULL);
 
-    // Buffer for returned content
-    Buffer *result = NULL;
+    httpClientRequestOpen(this);
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        bool complete = false;
-        bool retry;
-        Wait *wait = this->timeout > 0 ? waitNew(this->timeout) : NULL;
+        // Write the request and headers
+        ioWriteStr(tlsClientIoWrite(this->tls), httpClientRequestRender(verb, uri, query, requestHeader));
 
-        do
-        {
-            // Assume there will be no retry
-            retry = false;
+        // Write out body if any
+        if (body != NULL)
+            ioWrite(tlsClientIoWrite(this->tls), body);
 
-            // Free the read interface
-            httpClientDone(this);
+        // Flush all writes
+        ioWriteFlush(tlsClientIoWrite(this->tls));
+    }
+    MEM_CONTEXT_TEMP_END();
 
-            // Free response status left over from the last request
-            httpHeaderFree(this->responseHeader);
-            this->responseHeader = NULL;
-            strFree(this->responseMessage);
-            this->responseMessage = NULL;
+    FUNCTION_LOG_RETURN_VOID();
+}
 
-            // Reset all content info
-            this->contentChunked = false;
-            this->contentSize = 0;
-            this->contentRemaining = 0;
-            this->closeOnContentEof = false;
-            this->contentEof = true;
+/***********************************************************************************************************************************
+Read the response to a request
+***********************************************************************************************************************************/
+static Buffer *
+httpClientResponseRead(HttpClient *this, bool head, bool returnContent)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace)
+        FUNCTION_LOG_PARAM(HTTP_CLIENT, this);
+        FUNCTION_LOG_PARAM(BOOL, head);
+        FUNCTION_LOG_PARAM(BOOL, returnContent);
+    FUNCTION_LOG_END();
 
-            TRY_BEGIN()
-            {
-                if (tlsClientOpen(this->tls))
-                    httpClientStatLocal.session++;
+    ASSERT(this != NULL);
 
-                // Write the request
-                String *queryStr = httpQueryRender(query);
+    // Buffer for returned content
+    Buffer *result = NULL;
 
-                ioWriteStrLine(
-                    tlsClientIoWrite(this->tls),
-                    strNewFmt(
-                        "%s %s%s%s " HTTP_VERSION "\r", strPtr(verb), strPtr(httpUriEncode(uri, true)), queryStr == NULL ? "" : "?",
-                        queryStr == NULL ? "" : strPtr(queryStr)));
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Read status and make sure it starts with the correct http version
+        String *status = strTrim(ioReadLine(tlsClientIoRead(this->tls)));
 
-                // Write headers
-                if (requestHeader != NULL)
-                {
-                    const StringList *headerList = httpHeaderList(requestHeader);
-
-                    for (unsigned int headerIdx = 0; headerIdx < strLstSize(headerList); headerIdx++)
-                    {
-                        const String *headerKey = strLstGet(headerList, headerIdx);
-                        ioWriteStrLine(
-                            tlsClientIoWrite(this->tls),
-                            strNewFmt("%s:%s\r", strPtr(headerKey), strPtr(httpHeaderGet(requestHeader, headerKey))));
-                    }
-                }
+        if (!strBeginsWith(status, HTTP_VERSION_STR))
+            THROW_FMT(FormatError, "http version of response '%s' must be " HTTP_VERSION, strPtr(status));
 
-                // Write out blank line to end the headers
-                ioWriteLine(tlsClientIoWrite(this->tls), CR_BUF);
+        // Now read the response code and message
+        status = strSub(status, sizeof(HTTP_VERSION));
 
-                // Write out body if any
-                if (body != NULL)
-                    ioWrite(tlsClientIoWrite(this->tls), body);
+        int spacePos = strChr(status, ' ');
 
-                // Flush all writes
-                ioWriteFlush(tlsClientIoWrite(this->tls));
+        if (spacePos < 0)
+            THROW_FMT(FormatError, "response status '%s' must have a space", strPtr(status));
 
-                // Read status and make sure it starts with the correct http version
-                String *status = strTrim(ioReadLine(tlsClientIoRead(this->tls)));
+        this->responseCode = cvtZToUInt(strPtr(strTrim(strSubN(status, 0, (size_t)spacePos))));
 
-                if (!strBeginsWith(status, HTTP_VERSION_STR))
-                    THROW_FMT(FormatError, "http version of response '%s' must be " HTTP_VERSION, strPtr(status));
+        MEM_CONTEXT_BEGIN(this->memContext)
+        {
+            this->responseMessage = strSub(status, (size_t)spacePos + 1);
+        }
+        MEM_CONTEXT_END();
 
-                // Now read the response code and message
-                status = strSub(status, sizeof(HTTP_VERSION));
+        // Read headers
+        MEM_CONTEXT_BEGIN(this->memContext)
+        {
+            this->responseHeader = httpHeaderNew(NULL);
+        }
+        MEM_CONTEXT_END();
 
-                int spacePos = strChr(status, ' ');
+        do
+        {
+            // Read the next header
+            String *header = strTrim(ioReadLine(tlsClientIoRead(this->tls)));
 
-                if (spacePos < 0)
-                    THROW_FMT(FormatError, "response status '%s' must have a space", strPtr(status));
+            // If the header is empty then we have reached the end of the headers
+            if (strSize(header) == 0)
+                break;
 
-                this->responseCode = cvtZToUInt(strPtr(strTrim(strSubN(status, 0, (size_t)spacePos))));
+            // Split the header and store it
+            int colonPos = strChr(header, ':');
 
-                MEM_CONTEXT_BEGIN(this->memContext)
-                {
-                    this->responseMessage = strSub(status, (size_t)spacePos + 1);
-                }
-                MEM_CONTEXT_END();
+            if (colonPos < 0)
+                THROW_FMT(FormatError, "header '%s' missing colon", strPtr(strTrim(header)));
 
-                // Read headers
-                MEM_CONTEXT_BEGIN(this->memContext)
-                {
-                    this->responseHeader = httpHeaderNew(NULL);
-                }
-                MEM_CONTEXT_END();
+            String *headerKey = strLower(strTrim(strSubN(header, 0, (size_t)colonPos)));
+            String *headerValue = strTrim(strSub(header, (size_t)colonPos + 1));
 
-                do
-                {
-                    // Read the next header
-                    String *header = strTrim(ioReadLine(tlsClientIoRead(this->tls)));
-
-                    // If the header is empty then we have reached the end of the headers
-                    if (strSize(header) == 0)
-                        break;
-
-                    // Split the header and store it
-                    int colonPos = strChr(header, ':');
-
-                    if (colonPos < 0)
-                        THROW_FMT(FormatError, "header '%s' missing colon", strPtr(strTrim(header)));
-
-                    String *headerKey = strLower(strTrim(strSubN(header, 0, (size_t)colonPos)));
-                    String *headerValue = strTrim(strSub(header, (size_t)colonPos + 1));
-
-                    httpHeaderAdd(this->responseHeader, headerKey, headerValue);
-
-                    // Read transfer encoding (only chunked is supported)
-                    if (strEq(headerKey, HTTP_HEADER_TRANSFER_ENCODING_STR))
-                    {
-                        // Error if transfer encoding is not chunked
-                        if (!strEq(headerValue, HTTP_VALUE_TRANSFER_ENCODING_CHUNKED_STR))
-                        {
-                            THROW_FMT(
-                                FormatError, "only '%s' is supported for '%s' header", HTTP_VALUE_TRANSFER_ENCODING_CHUNKED,
-                                HTTP_HEADER_TRANSFER_ENCODING);
-                        }
-
-                        this->contentChunked = true;
-                    }
-
-                    // Read content size
-                    if (strEq(headerKey, HTTP_HEADER_CONTENT_LENGTH_STR))
-                    {
-                        this->contentSize = cvtZToUInt64(strPtr(headerValue));
-                        this->contentRemaining = this->contentSize;
-                    }
-
-                    // If the server notified of a closed connection then close the client connection after reading content.  This
-                    // prevents doing a retry on the next request when using the closed connection.
-                    if (strEq(headerKey, HTTP_HEADER_CONNECTION_STR) && strEq(headerValue, HTTP_VALUE_CONNECTION_CLOSE_STR))
-                    {
-                        this->closeOnContentEof = true;
-                        httpClientStatLocal.close++;
-                    }
-                }
-                while (1);
+            httpHeaderAdd(this->responseHeader, headerKey, headerValue);
 
-                // Error if transfer encoding and content length are both set
-                if (this->contentChunked && this->contentSize > 0)
+            // Read transfer encoding (only chunked is supported)
+            if (strEq(headerKey, HTTP_HEADER_TRANSFER_ENCODING_STR))
+            {
+                // Error if transfer encoding is not chunked
+                if (!strEq(headerValue, HTTP_VALUE_TRANSFER_ENCODING_CHUNKED_STR))
                 {
                     THROW_FMT(
-                        FormatError,  "'%s' and '%s' headers are both set", HTTP_HEADER_TRANSFER_ENCODING,
-                        HTTP_HEADER_CONTENT_LENGTH);
+                        FormatError, "only '%s' is supported for '%s' header", HTTP_VALUE_TRANSFER_ENCODING_CHUNKED,
+                        HTTP_HEADER_TRANSFER_ENCODING);
                 }
 
-                // Was content returned in the response?  HEAD will report content but not actually return any.
-                bool contentExists = (this->contentChunked || this->contentSize > 0) && !strEq(verb, HTTP_VERB_HEAD_STR);
-                this->contentEof = !contentExists;
+                this->contentChunked = true;
+            }
 
-                // If all content should be returned from this function then read the buffer.  Also read the reponse if there has
-                // been an error.
-                if (returnContent || !httpClientResponseCodeOk(this))
-                {
-                    if (contentExists)
-                    {
-                        result = bufNew(0);
-
-                        do
-                        {
-                            bufResize(result, bufSize(result) + ioBufferSize());
-                            httpClientRead(this, result, true);
-                        }
-                        while (!httpClientEof(this));
-                    }
-                }
-                // Else create an io object, even if there is no content.  This makes the logic for readers easier -- they can just
-                // check eof rather than also checking if the io object exists.
-                else
+            // Read content size
+            if (strEq(headerKey, HTTP_HEADER_CONTENT_LENGTH_STR))
+            {
+                this->contentSize = cvtZToUInt64(strPtr(headerValue));
+                this->contentRemaining = this->contentSize;
+            }
+
+            // If the server notified of a closed connection then close the client connection after reading content.  This
+            // prevents doing a retry on the next request when using the closed connection.
+            if (strEq(headerKey, HTTP_HEADER_CONNECTION_STR) && strEq(headerValue, HTTP_VALUE_CONNECTION_CLOSE_STR))
+            {
+                this->closeOnContentEof = true;
+                httpClientStatLocal.close++;
+            }
+        }
+        while (1);
+
+        // Error if transfer encoding and content length are both set
+        if (this->contentChunked && this->contentSize > 0)
+        {
+            THROW_FMT(
+                FormatError,  "'%s' and '%s' headers are both set", HTTP_HEADER_TRANSFER_ENCODING,
+                HTTP_HEADER_CONTENT_LENGTH);
+        }
+
+        // Was content returned in the response?  HEAD will report content but not actually return any.
+        bool contentExists = (this->contentChunked || this->contentSize > 0) && !head;
+        this->contentEof = !contentExists;
+
+        // If all content should be returned from this function then read the buffer.  Also read the reponse if there has been an
+        // error.
+        if (returnContent || !httpClientResponseCodeOk(this))
+        {
+            if (contentExists)
+            {
+                result = bufNew(0);
+
+                do
                 {
-                    MEM_CONTEXT_BEGIN(this->memContext)
-                    {
-                        this->ioRead = ioReadNewP(this, .eof = httpClientEof, .read = httpClientRead);
-                        ioReadOpen(this->ioRead);
-                    }
-                    MEM_CONTEXT_END();
+                    bufResize(result, bufSize(result) + ioBufferSize());
+                    httpClientRead(this, result, true);
                 }
+                while (!httpClientEof(this));
+            }
+        }
+        // Else create an io object, even if there is no content.  This makes the logic for readers easier -- they can just check
+        // eof rather than also checking if the io object exists.
+        else
+        {
+            MEM_CONTEXT_BEGIN(this->memContext)
+            {
+                this->ioRead = ioReadNewP(this, .eof = httpClientEof, .read = httpClientRead);
+                ioReadOpen(this->ioRead);
+            }
+            MEM_CONTEXT_END();
+        }
+
+        // If the server notified that it would close the connection and there is no content then close the client side
+        if (this->closeOnContentEof && !contentExists)
+            tlsClientClose(this->tls);
+
+        // Move the result buffer (if any) to the parent context
+        bufMove(result, MEM_CONTEXT_OLD());
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(BUFFER, result);
+}
+
+/***********************************************************************************************************************************
+Perform a request
+***********************************************************************************************************************************/
+Buffer *
+httpClientRequest(
+    HttpClient *this, const String *verb, const String *uri, const HttpQuery *query, const HttpHeader *requestHeader,
+    const Buffer *body, bool returnContent)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug)
+        FUNCTION_LOG_PARAM(HTTP_CLIENT, this);
+        FUNCTION_LOG_PARAM(STRING, verb);
+        FUNCTION_LOG_PARAM(STRING, uri);
+        FUNCTION_LOG_PARAM(HTTP_QUERY, query);
+        FUNCTION_LOG_PARAM(HTTP_HEADER, requestHeader);
+        FUNCTION_LOG_PARAM(BUFFER, body);
+        FUNCTION_LOG_PARAM(BOOL, returnContent);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(verb != NULL);
+    ASSERT(uri != NULL);
+
+    // Buffer for returned content
+    Buffer *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        bool complete = false;
+        bool retry;
+        Wait *wait = this->timeout > 0 ? waitNew(this->timeout) : NULL;
+
+        do
+        {
+            // Assume there will be no retry
+            retry = false;
 
-                // If the server notified that it would close the connection and there is no content then close the client side
-                if (this->closeOnContentEof && !contentExists)
-                    tlsClientClose(this->tls);
+            TRY_BEGIN()
+            {
+                httpClientRequestWrite(this, verb, uri, query, requestHeader, body);
+                result = httpClientResponseRead(this, strEq(verb, HTTP_VERB_HEAD_STR), returnContent);
 
                 // Retry when response code is 5xx.  These errors generally represent a server error for a request that looks valid.
                 // There are a few errors that might be permanently fatal but they are rare and it seems best not to try and pick
@@ -460,6 +666,117 @@ httpClientRequest(
     FUNCTION_LOG_RETURN(BUFFER, result);
 }
 
+/***********************************************************************************************************************************
+Send a request without waiting for the response
+
+The request is written by a thread so requests on multiple clients, including their bodies, are transferred at the same time.  The
+body must not be modified or freed until httpClientResponse() or httpClientDone() is called.  The client is busy until the response
+is read with httpClientResponse().  No retries are done since the request would need to be sent again, so the caller should be
+prepared to retry with httpClientRequest() if the request or response fails.  An error writing the request is thrown by
+httpClientResponse().
+***********************************************************************************************************************************/
+void
+httpClientRequestSend(
+    HttpClient *this, const String *verb, const String *uri, const HttpQuery *query, const HttpHeader *requestHeader,
+    const Buffer *body)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug)
+        FUNCTION_LOG_PARAM(HTTP_CLIENT, this);
+        FUNCTION_LOG_PARAM(STRING, verb);
+        FUNCTION_LOG_PARAM(STRING, uri);
+        FUNCTION_LOG_PARAM(HTTP_QUERY, query);
+        FUNCTION_LOG_PARAM(HTTP_HEADER, requestHeader);
+        FUNCTION_LOG_PARAM(BUFFER, body);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(verb != NULL);
+    ASSERT(uri != NULL);
+    ASSERT(!httpClientBusy(this));
+    ASSERT(!this->sendThreadRunning);
+
+    TRY_BEGIN()
+    {
+        httpClientRequestOpen(this);
+
+        // Render the request here since the query and headers may be freed before the thread is done
+        MEM_CONTEXT_BEGIN(this->sendContext)
+        {
+            this->sendRequest = httpClientRequestRender(verb, uri, query, requestHeader);
+        }
+        MEM_CONTEXT_END();
+
+        this->sendBody = body;
+        this->sendErrorType = NULL;
+
+        // Start the thread that writes the request
+        int result = pthread_create(&this->sendThread, NULL, httpClientSendThread, this);
+
+        if (result != 0)
+        {
+            errno = result;
+            THROW_SYS_ERROR(KernelError, "unable to create http send thread");
+        }
+
+        this->sendThreadRunning = true;
+    }
+    CATCH_ANY()
+    {
+        memContextReset(this->sendContext);
+        tlsClientClose(this->tls);
+        RETHROW();
+    }
+    TRY_END();
+
+    this->responsePending = true;
+    this->responseHead = strEq(verb, HTTP_VERB_HEAD_STR);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Read the response to a request sent with httpClientRequestSend()
+
+Unlike httpClientRequest() a 5xx response is not an error so the caller must check the response code.
+***********************************************************************************************************************************/
+Buffer *
+httpClientResponse(HttpClient *this, bool returnContent)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug)
+        FUNCTION_LOG_PARAM(HTTP_CLIENT, this);
+        FUNCTION_LOG_PARAM(BOOL, returnContent);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->responsePending);
+
+    Buffer *result = NULL;
+
+    // The response is no longer pending even if it cannot be read
+    this->responsePending = false;
+
+    TRY_BEGIN()
+    {
+        // Wait for the request to be written and throw the error from the send thread if there was one
+        httpClientSendJoin(this);
+
+        if (this->sendErrorType != NULL)
+            THROWP(this->sendErrorType, this->sendErrorMessage);
+
+        result = httpClientResponseRead(this, this->responseHead, returnContent);
+    }
+    CATCH_ANY()
+    {
+        tlsClientClose(this->tls);
+        RETHROW();
+    }
+    TRY_END();
+
+    httpClientStatLocal.request++;
+
+    FUNCTION_LOG_RETURN(BUFFER, result);
+}
+
 /***********************************************************************************************************************************
 Format statistics to a string
 ***********************************************************************************************************************************/
@@ -503,6 +820,14 @@ httpClientDone(HttpClient *this)
         this->ioRead = NULL;
     }
 
+    // If the response to a request was never read then the connection cannot be reused
+    if (this->responsePending)
+    {
+        httpClientSendJoin(this);
+        tlsClientClose(this->tls);
+        this->responsePending = false;
+    }
+
     FUNCTION_LOG_RETURN_VOID();
 }
 
@@ -518,7 +843,7 @@ httpClientBusy(const HttpClient *this)
 
     ASSERT(this != NULL);
 
-    FUNCTION_TEST_RETURN(this->ioRead);
+    FUNCTION_TEST_RETURN(this->ioRead != NULL || this->responsePending);
 }
 
 /***********************************************************************************************************************************
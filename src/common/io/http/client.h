@@ -43,11 +43,19 @@ HTTP Constants
     STRING_DECLARE(HTTP_HEADER_CONTENT_LENGTH_STR);
 #define HTTP_HEADER_CONTENT_MD5                                     "content-md5"
     STRING_DECLARE(HTTP_HEADER_CONTENT_MD5_STR);
+#define HTTP_HEADER_CONTENT_RANGE                                   "content-range"
+    STRING_DECLARE(HTTP_HEADER_CONTENT_RANGE_STR);
 #define HTTP_HEADER_ETAG                                            "etag"
     STRING_DECLARE(HTTP_HEADER_ETAG_STR);
+#define HTTP_HEADER_IF_MATCH                                        "if-match"
+    STRING_DECLARE(HTTP_HEADER_IF_MATCH_STR);
+#define HTTP_HEADER_RANGE                                           "range"
+    STRING_DECLARE(HTTP_HEADER_RANGE_STR);
 
+#define HTTP_RESPONSE_CODE_PARTIAL_CONTENT                          206
 #define HTTP_RESPONSE_CODE_FORBIDDEN                                403
 #define HTTP_RESPONSE_CODE_NOT_FOUND                                404
+#define HTTP_RESPONSE_CODE_PRECONDITION_FAILED                      412
 
 /***********************************************************************************************************************************
 Statistics
@@ -74,6 +82,10 @@ void httpClientDone(HttpClient *this);
 Buffer *httpClientRequest(
     HttpClient *this, const String *verb, const String *uri, const HttpQuery *query, const HttpHeader *requestHeader,
     const Buffer *body, bool returnContent);
+void httpClientRequestSend(
+    HttpClient *this, const String *verb, const String *uri, const HttpQuery *query, const HttpHeader *requestHeader,
+    const Buffer *body);
+Buffer *httpClientResponse(HttpClient *this, bool returnContent);
 String *httpClientStatStr(void);
 
 /***********************************************************************************************************************************
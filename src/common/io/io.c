@@ -41,6 +41,36 @@ ioBufferSizeSet(size_t bufferSizeParam)
     FUNCTION_TEST_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Filter threads
+
+Callers copying large amounts of data should run filters in threads (see ioFilterGroupThreadSet()) when this is enabled.  It is
+disabled by default with the expectation that it will be changed to a new value after options have been loaded.
+***********************************************************************************************************************************/
+static bool filterThread = false;
+
+/***********************************************************************************************************************************
+Get/set filter threads
+***********************************************************************************************************************************/
+bool
+ioFilterThread(void)
+{
+    FUNCTION_TEST_VOID();
+    FUNCTION_TEST_RETURN(filterThread);
+}
+
+void
+ioFilterThreadSet(bool filterThreadParam)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BOOL, filterThreadParam);
+    FUNCTION_TEST_END();
+
+    filterThread = filterThreadParam;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Read all IO into a buffer
 ***********************************************************************************************************************************/
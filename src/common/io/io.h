@@ -21,5 +21,7 @@ Getters/Setters
 ***********************************************************************************************************************************/
 size_t ioBufferSize(void);
 void ioBufferSizeSet(size_t bufferSize);
+bool ioFilterThread(void);
+void ioFilterThreadSet(bool filterThread);
 
 #endif
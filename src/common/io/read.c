@@ -354,6 +354,25 @@ ioReadEof(const IoRead *this)
     FUNCTION_LOG_RETURN(BOOL, this->eofAll);
 }
 
+/***********************************************************************************************************************************
+Is a complete line already buffered?
+
+If so the next ioReadLine() will not read from the driver, so callers waiting on the handle (e.g. with select()) must check this
+first or they may wait for data that has already been read.
+***********************************************************************************************************************************/
+bool
+ioReadLineReady(const IoRead *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(IO_READ, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(
+        this->output != NULL && bufUsed(this->output) > 0 && memchr(bufPtr(this->output), '\n', bufUsed(this->output)) != NULL);
+}
+
 /***********************************************************************************************************************************
 Get filter group if filters need to be added
 ***********************************************************************************************************************************/
@@ -35,6 +35,7 @@ bool ioReadBlock(const IoRead *this);
 bool ioReadEof(const IoRead *this);
 IoFilterGroup *ioReadFilterGroup(const IoRead *this);
 int ioReadHandle(const IoRead *this);
+bool ioReadLineReady(const IoRead *this);
 
 /***********************************************************************************************************************************
 Destructor
@@ -47,9 +47,9 @@ Test Asserts
     ASSERT(logLevel >= LOG_LEVEL_MIN && logLevel <= LOG_LEVEL_MAX)
 
 /***********************************************************************************************************************************
-Log buffer -- used to format log header and message
+Log buffer -- used to format log header and message (for each thread)
 ***********************************************************************************************************************************/
-static char logBuffer[LOG_BUFFER_SIZE];
+static __thread char logBuffer[LOG_BUFFER_SIZE];
 
 /***********************************************************************************************************************************
 Convert log level to string and vice versa
@@ -3,6 +3,7 @@ Memory Context Manager
 ***********************************************************************************************************************************/
 #include "build.auto.h"
 
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -17,14 +18,60 @@ typedef enum {memContextStateFree = 0, memContextStateFreeing, memContextStateAc
 
 /***********************************************************************************************************************************
 Contains information about a memory allocation
+
+Allocations that are not active form a stack of free allocations linked by freeNext so a free allocation can be found without a
+search.  The end of the stack is marked with MEM_CONTEXT_ALLOC_FREE_END, which is larger than any valid allocation index.
 ***********************************************************************************************************************************/
+#define MEM_CONTEXT_ALLOC_FREE_END                                  0x7FFFFFFF
+
 typedef struct MemContextAlloc
 {
     bool active:1;                                                  // Is the allocation active?
+    unsigned int freeNext:31;                                       // Next allocation on the free stack when not active
     unsigned int size:32;                                           // Allocation size (4GB max)
-    void *buffer;                                                   // Allocated buffer
+    void *buffer;                                                   // Allocated buffer (follows the header)
 } MemContextAlloc;
 
+/***********************************************************************************************************************************
+Header stored in front of each allocated buffer
+
+The header contains the index of the allocation in the alloc list so the allocation can be found without a search when the buffer is
+freed or resized.  Allocations from an arena are not in the alloc list so the header contains the size instead.  The union pads the
+header to the largest alignment of the basic types so the buffer has the same alignment that malloc() would provide.
+***********************************************************************************************************************************/
+#define MEM_CONTEXT_ALLOC_ARENA                                     UINT_MAX
+
+typedef union MemContextAllocHeader
+{
+    struct
+    {
+        unsigned int allocIdx;                                      // Index in the alloc list (MEM_CONTEXT_ALLOC_ARENA for arena)
+        unsigned int size;                                          // Allocation size when allocated from an arena
+    } info;
+
+    long double alignLongDouble;                                    // Padding for alignment
+    long long alignLongLong;                                        // Padding for alignment
+    void *alignPointer;                                             // Padding for alignment
+} MemContextAllocHeader;
+
+// Round a size up so the next buffer will be aligned
+#define MEM_CONTEXT_ALIGN(size)                                                                                                    \
+    (((size) + sizeof(MemContextAllocHeader) - 1) / sizeof(MemContextAllocHeader) * sizeof(MemContextAllocHeader))
+
+/***********************************************************************************************************************************
+Arena chunk
+
+Chunks are allocated with a fixed size and small allocations are carved off the end of the newest chunk.  The chunks are linked from
+newest to oldest and freed together when the context is freed or reset.
+***********************************************************************************************************************************/
+typedef struct MemContextArenaChunk
+{
+    struct MemContextArenaChunk *next;                              // Next older chunk
+    size_t used;                                                    // Bytes used in the chunk (including this header)
+} MemContextArenaChunk;
+
+#define MEM_CONTEXT_ARENA_CHUNK_HEADER_SIZE                         MEM_CONTEXT_ALIGN(sizeof(MemContextArenaChunk))
+
 /***********************************************************************************************************************************
 Contains information about the memory context
 ***********************************************************************************************************************************/
@@ -42,7 +89,10 @@ struct MemContext
 
     MemContextAlloc *allocList;                                     // List of memory allocations created in this context
     unsigned int allocListSize;                                     // Size of alloc list (not the actual count of allocations)
-    unsigned int allocFreeIdx;                                      // Index of first free space in the alloc list
+    unsigned int allocFreeIdx;                                      // Index of the top of the free stack (>= size when empty)
+
+    bool arena;                                                     // Are small allocations made from an arena?
+    MemContextArenaChunk *arenaChunk;                               // Newest arena chunk
 
     void (*callbackFunction)(void *);                               // Function to call before the context is freed
     void *callbackArgument;                                         // Argument to pass to callback function
@@ -60,8 +110,11 @@ MemContext contextTop = {.state = memContextStateActive, .name = "TOP"};
 Current context
 
 All memory allocations will be done from the current context.  Initialized to top context at execution start.
+
+The current context is kept for each thread.  A thread other than the main thread must switch to a context that it alone uses before
+allocating since the top context is shared.
 ***********************************************************************************************************************************/
-MemContext *contextCurrent = &contextTop;
+__thread MemContext *contextCurrent = &contextTop;
 
 /***********************************************************************************************************************************
 Wrapper around malloc()
@@ -136,6 +189,34 @@ memFreeInternal(void *buffer)
     FUNCTION_TEST_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Push new allocations in the alloc list onto the free stack
+
+The free stack must be empty.  Allocations are pushed so that lower indexes are used first.
+***********************************************************************************************************************************/
+static void
+memContextAllocFreeInit(MemContext *memContext, unsigned int allocIdxBegin)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(MEM_CONTEXT, memContext);
+        FUNCTION_TEST_PARAM(UINT, allocIdxBegin);
+    FUNCTION_TEST_END();
+
+    ASSERT(memContext != NULL);
+    ASSERT(memContext->allocFreeIdx >= allocIdxBegin);
+    ASSERT(memContext->allocListSize < MEM_CONTEXT_ALLOC_FREE_END);
+
+    for (unsigned int allocIdx = allocIdxBegin; allocIdx < memContext->allocListSize; allocIdx++)
+    {
+        memContext->allocList[allocIdx].freeNext =
+            (allocIdx + 1 == memContext->allocListSize ? MEM_CONTEXT_ALLOC_FREE_END : allocIdx + 1) & MEM_CONTEXT_ALLOC_FREE_END;
+    }
+
+    memContext->allocFreeIdx = allocIdxBegin;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Find space for a new mem context
 ***********************************************************************************************************************************/
@@ -218,6 +299,7 @@ memContextNew(const char *name)
     // Create initial space for allocations
     this->allocList = memAllocInternal(sizeof(MemContextAlloc) * MEM_CONTEXT_ALLOC_INITIAL_SIZE, true);
     this->allocListSize = MEM_CONTEXT_ALLOC_INITIAL_SIZE;
+    memContextAllocFreeInit(this, 0);
 
     // Set the context name
     this->name = name;
@@ -236,6 +318,22 @@ memContextNew(const char *name)
     FUNCTION_TEST_RETURN(this);
 }
 
+/***********************************************************************************************************************************
+Create a new memory context that makes small allocations from an arena
+***********************************************************************************************************************************/
+MemContext *
+memContextNewArena(const char *name)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRINGZ, name);
+    FUNCTION_TEST_END();
+
+    MemContext *this = memContextNew(name);
+    this->arena = true;
+
+    FUNCTION_TEST_RETURN(this);
+}
+
 /***********************************************************************************************************************************
 Register a callback to be called just before the context is freed
 ***********************************************************************************************************************************/
@@ -296,6 +394,66 @@ memContextCallbackClear(MemContext *this)
     FUNCTION_TEST_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Allocate memory from the arena of the current context and optionally zero it
+***********************************************************************************************************************************/
+static void *
+memContextAllocArena(size_t size, bool zero)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(SIZE, size);
+        FUNCTION_TEST_PARAM(BOOL, zero);
+    FUNCTION_TEST_END();
+
+    ASSERT(contextCurrent->arena);
+    ASSERT(size <= MEM_CONTEXT_ARENA_ALLOC_MAX);
+
+    size_t sizeAlloc = sizeof(MemContextAllocHeader) + MEM_CONTEXT_ALIGN(size);
+
+    // If there is no chunk or the allocation will not fit in the newest chunk then add a chunk
+    MemContextArenaChunk *chunk = contextCurrent->arenaChunk;
+
+    if (chunk == NULL || chunk->used + sizeAlloc > MEM_CONTEXT_ARENA_CHUNK_SIZE)
+    {
+        chunk = memAllocInternal(MEM_CONTEXT_ARENA_CHUNK_SIZE, false);
+        chunk->next = contextCurrent->arenaChunk;
+        chunk->used = MEM_CONTEXT_ARENA_CHUNK_HEADER_SIZE;
+
+        contextCurrent->arenaChunk = chunk;
+    }
+
+    // Carve the allocation off the end of the chunk
+    MemContextAllocHeader *header = (MemContextAllocHeader *)((unsigned char *)chunk + chunk->used);
+    header->info.allocIdx = MEM_CONTEXT_ALLOC_ARENA;
+    header->info.size = (unsigned int)size;
+
+    chunk->used += sizeAlloc;
+
+    if (zero)
+        memset(header + 1, 0, size);
+
+    FUNCTION_TEST_RETURN(header + 1);
+}
+
+/***********************************************************************************************************************************
+Is the arena allocation the last one made from the newest chunk?  Only the last allocation can be freed or resized in place.
+***********************************************************************************************************************************/
+static bool
+memArenaLast(const MemContextAllocHeader *header)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, header);
+    FUNCTION_TEST_END();
+
+    ASSERT(header != NULL);
+
+    MemContextArenaChunk *chunk = contextCurrent->arenaChunk;
+
+    FUNCTION_TEST_RETURN(
+        chunk != NULL &&
+        (const unsigned char *)(header + 1) + MEM_CONTEXT_ALIGN(header->info.size) == (unsigned char *)chunk + chunk->used);
+}
+
 /***********************************************************************************************************************************
 Allocate memory in the memory context and optionally zero it.
 ***********************************************************************************************************************************/
@@ -307,14 +465,15 @@ memContextAlloc(size_t size, bool zero)
         FUNCTION_TEST_PARAM(BOOL, zero);
     FUNCTION_TEST_END();
 
-    // Find space for the new allocation
-    for (; contextCurrent->allocFreeIdx < contextCurrent->allocListSize; contextCurrent->allocFreeIdx++)
-        if (!contextCurrent->allocList[contextCurrent->allocFreeIdx].active)
-            break;
+    // Small allocations in an arena context are made from the arena
+    if (contextCurrent->arena && size <= MEM_CONTEXT_ARENA_ALLOC_MAX)
+        FUNCTION_TEST_RETURN(memContextAllocArena(size, zero));
 
-    // If no space was found then allocate more
-    if (contextCurrent->allocFreeIdx == contextCurrent->allocListSize)
+    // If the free stack is empty then allocate more space
+    if (contextCurrent->allocFreeIdx >= contextCurrent->allocListSize)
     {
+        unsigned int allocListSizeOld = contextCurrent->allocListSize;
+
         // Only the top context will not have initial space for allocations
         if (contextCurrent->allocListSize == 0)
         {
@@ -338,20 +497,35 @@ memContextAlloc(size_t size, bool zero)
             // Set new size
             contextCurrent->allocListSize = allocListSizeNew;
         }
+
+        memContextAllocFreeInit(contextCurrent, allocListSizeOld);
     }
 
-    // Allocate the memory
-    contextCurrent->allocList[contextCurrent->allocFreeIdx].active = true;
-    contextCurrent->allocList[contextCurrent->allocFreeIdx].size = (unsigned int)size;
-    contextCurrent->allocList[contextCurrent->allocFreeIdx].buffer = memAllocInternal(size, zero);
-    contextCurrent->allocFreeIdx++;
+    // Allocate the memory and the header before modifying anything else in case there is an error
+    unsigned int allocIdx = contextCurrent->allocFreeIdx;
+    MemContextAllocHeader *header = memAllocInternal(sizeof(MemContextAllocHeader) + size, false);
+    header->info.allocIdx = allocIdx;
+
+    if (zero)
+        memset(header + 1, 0, size);
+
+    // Pop the allocation off the free stack
+    MemContextAlloc *alloc = &contextCurrent->allocList[allocIdx];
+    contextCurrent->allocFreeIdx = alloc->freeNext;
+
+    alloc->active = true;
+    alloc->size = (unsigned int)size;
+    alloc->buffer = header + 1;
 
     // Return buffer
-    FUNCTION_TEST_RETURN(contextCurrent->allocList[contextCurrent->allocFreeIdx - 1].buffer);
+    FUNCTION_TEST_RETURN(alloc->buffer);
 }
 
 /***********************************************************************************************************************************
 Find a memory allocation
+
+Returns MEM_CONTEXT_ALLOC_ARENA for allocations from the arena.  Arena allocations are not tracked so they can only be checked
+against the arena chunks of the current context in debug builds.
 ***********************************************************************************************************************************/
 static unsigned int
 memFind(const void *buffer)
@@ -362,16 +536,36 @@ memFind(const void *buffer)
 
     ASSERT(buffer != NULL);
 
-    // Find memory allocation
-    unsigned int allocIdx;
+    // Get the allocation index from the header
+    unsigned int allocIdx = ((const MemContextAllocHeader *)buffer - 1)->info.allocIdx;
 
-    for (allocIdx = 0; allocIdx < contextCurrent->allocListSize; allocIdx++)
-        if (contextCurrent->allocList[allocIdx].buffer == buffer && contextCurrent->allocList[allocIdx].active)
-            break;
+    if (allocIdx == MEM_CONTEXT_ALLOC_ARENA)
+    {
+        // Error if the current context is not an arena
+        if (!contextCurrent->arena)
+            THROW(AssertError, "unable to find allocation");
+
+#ifndef NDEBUG
+        // Error if the allocation is not in one of the chunks
+        MemContextArenaChunk *chunk = contextCurrent->arenaChunk;
+
+        while (chunk != NULL &&
+               ((const unsigned char *)buffer < (unsigned char *)chunk + MEM_CONTEXT_ARENA_CHUNK_HEADER_SIZE ||
+                (const unsigned char *)buffer >= (unsigned char *)chunk + chunk->used))
+        {
+            chunk = chunk->next;
+        }
 
-    // Error if the buffer was not found
-    if (allocIdx == contextCurrent->allocListSize)
+        if (chunk == NULL)
+            THROW(AssertError, "unable to find allocation");
+#endif
+    }
+    // Else error if the allocation does not belong to the current context
+    else if (allocIdx >= contextCurrent->allocListSize || !contextCurrent->allocList[allocIdx].active ||
+        contextCurrent->allocList[allocIdx].buffer != buffer)
+    {
         THROW(AssertError, "unable to find allocation");
+    }
 
     FUNCTION_TEST_RETURN(allocIdx);
 }
@@ -403,13 +597,44 @@ memGrowRaw(const void *buffer, size_t size)
     ASSERT(buffer != NULL);
 
     // Find the allocation
-    MemContextAlloc *alloc = &(contextCurrent->allocList[memFind(buffer)]);
+    unsigned int allocIdx = memFind(buffer);
+    void *result = NULL;
 
-    // Grow the buffer
-    alloc->buffer = memReAllocInternal(alloc->buffer, alloc->size, size, false);
-    alloc->size = (unsigned int)size;
+    if (allocIdx == MEM_CONTEXT_ALLOC_ARENA)
+    {
+        MemContextAllocHeader *header = (MemContextAllocHeader *)buffer - 1;
 
-    FUNCTION_TEST_RETURN(alloc->buffer);
+        // Resize in place when this is the last allocation in the newest chunk and there is room
+        if (size <= MEM_CONTEXT_ARENA_ALLOC_MAX && memArenaLast(header) &&
+            contextCurrent->arenaChunk->used - MEM_CONTEXT_ALIGN(header->info.size) + MEM_CONTEXT_ALIGN(size) <=
+                MEM_CONTEXT_ARENA_CHUNK_SIZE)
+        {
+            contextCurrent->arenaChunk->used += MEM_CONTEXT_ALIGN(size) - MEM_CONTEXT_ALIGN(header->info.size);
+            header->info.size = (unsigned int)size;
+            result = header + 1;
+        }
+        // Else make a new allocation and copy the buffer.  The old allocation is released when the context is freed or reset.
+        else
+        {
+            result = memContextAlloc(size, false);
+            memcpy(result, buffer, header->info.size < size ? header->info.size : size);
+        }
+    }
+    else
+    {
+        MemContextAlloc *alloc = &(contextCurrent->allocList[allocIdx]);
+
+        // Grow the buffer.  The header is moved with the buffer.
+        MemContextAllocHeader *header = memReAllocInternal(
+            (MemContextAllocHeader *)alloc->buffer - 1, sizeof(MemContextAllocHeader) + alloc->size,
+            sizeof(MemContextAllocHeader) + size, false);
+
+        alloc->buffer = header + 1;
+        alloc->size = (unsigned int)size;
+        result = alloc->buffer;
+    }
+
+    FUNCTION_TEST_RETURN(result);
 }
 
 /***********************************************************************************************************************************
@@ -439,15 +664,29 @@ memFree(void *buffer)
 
     // Find the allocation
     unsigned int allocIdx = memFind(buffer);
-    MemContextAlloc *alloc = &(contextCurrent->allocList[allocIdx]);
 
-    // Free the buffer
-    memFreeInternal(alloc->buffer);
-    alloc->active = false;
+    // Only the last allocation in the newest chunk can be returned to the arena.  Others are released when the context is freed or
+    // reset.
+    if (allocIdx == MEM_CONTEXT_ALLOC_ARENA)
+    {
+        MemContextAllocHeader *header = (MemContextAllocHeader *)buffer - 1;
 
-    // If this allocation is before the current free allocation then make it the current free allocation
-    if (allocIdx < contextCurrent->allocFreeIdx)
+        if (memArenaLast(header))
+            contextCurrent->arenaChunk->used -= sizeof(MemContextAllocHeader) + MEM_CONTEXT_ALIGN(header->info.size);
+    }
+    // Else free the buffer and the header
+    else
+    {
+        MemContextAlloc *alloc = &(contextCurrent->allocList[allocIdx]);
+
+        memFreeInternal((MemContextAllocHeader *)alloc->buffer - 1);
+        alloc->active = false;
+        alloc->buffer = NULL;
+
+        // Push the allocation onto the free stack
+        alloc->freeNext = contextCurrent->allocFreeIdx & MEM_CONTEXT_ALLOC_FREE_END;
         contextCurrent->allocFreeIdx = allocIdx;
+    }
 
     FUNCTION_TEST_RETURN_VOID();
 }
@@ -561,6 +800,100 @@ memContextName(MemContext *this)
     FUNCTION_TEST_RETURN(this->name);
 }
 
+/***********************************************************************************************************************************
+Free all memory allocations in the context
+
+When reset is true the alloc list and the newest arena chunk are kept so the context can be reused without allocating them again.
+***********************************************************************************************************************************/
+static void
+memContextFreeAlloc(MemContext *this, bool reset)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(MEM_CONTEXT, this);
+        FUNCTION_TEST_PARAM(BOOL, reset);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    // Free allocations in the alloc list
+    if (this->allocListSize > 0)
+    {
+        for (unsigned int allocIdx = 0; allocIdx < this->allocListSize; allocIdx++)
+        {
+            MemContextAlloc *alloc = &(this->allocList[allocIdx]);
+
+            if (alloc->active)
+            {
+                memFreeInternal((MemContextAllocHeader *)alloc->buffer - 1);
+                alloc->active = false;
+                alloc->buffer = NULL;
+            }
+        }
+
+        if (reset)
+            memContextAllocFreeInit(this, 0);
+        else
+        {
+            memFreeInternal(this->allocList);
+            this->allocListSize = 0;
+        }
+    }
+
+    // Free arena chunks
+    MemContextArenaChunk *chunk = this->arenaChunk;
+
+    if (reset && chunk != NULL)
+    {
+        chunk->used = MEM_CONTEXT_ARENA_CHUNK_HEADER_SIZE;
+        chunk = chunk->next;
+        this->arenaChunk->next = NULL;
+    }
+    else
+        this->arenaChunk = NULL;
+
+    while (chunk != NULL)
+    {
+        MemContextArenaChunk *chunkNext = chunk->next;
+        memFreeInternal(chunk);
+        chunk = chunkNext;
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Free all memory used by the context and all child contexts but leave the context active so it can be reused
+
+This is cheaper than freeing the context and creating a new one, especially for arena contexts since the newest chunk is kept.
+***********************************************************************************************************************************/
+void
+memContextReset(MemContext *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(MEM_CONTEXT, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    // Error if context is not active
+    if (this->state != memContextStateActive)
+        THROW(AssertError, "cannot reset inactive context");
+
+    // Contexts with a callback belong to an object and should be freed instead
+    if (this->callbackFunction)
+        THROW_FMT(AssertError, "cannot reset context '%s' with callback", this->name);
+
+    // Free child contexts.  The child contexts are kept in the list so they can be reused.
+    for (unsigned int contextIdx = 0; contextIdx < this->contextChildListSize; contextIdx++)
+        if (this->contextChildList[contextIdx] && this->contextChildList[contextIdx]->state == memContextStateActive)
+            memContextFree(this->contextChildList[contextIdx]);
+
+    // Free memory allocations
+    memContextFreeAlloc(this, true);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 memContextFree - free all memory used by the context and all child contexts
 ***********************************************************************************************************************************/
@@ -622,19 +955,7 @@ memContextFree(MemContext *this)
         }
 
         // Free memory allocations
-        if (this->allocListSize > 0)
-        {
-            for (unsigned int allocIdx = 0; allocIdx < this->allocListSize; allocIdx++)
-            {
-                MemContextAlloc *alloc = &(this->allocList[allocIdx]);
-
-                if (alloc->active)
-                    memFreeInternal(alloc->buffer);
-            }
-
-            memFreeInternal(this->allocList);
-            this->allocListSize = 0;
-        }
+        memContextFreeAlloc(this, false);
 
         // If the context index is lower than the current free index in the parent then replace it
         if (this->contextParent != NULL && this->contextParentIdx < this->contextParent->contextChildFreeIdx)
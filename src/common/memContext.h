@@ -28,6 +28,14 @@ Space is reserved for this many allocations when a context is created.  When mor
 ***********************************************************************************************************************************/
 #define MEM_CONTEXT_ALLOC_INITIAL_SIZE                              4
 
+/***********************************************************************************************************************************
+Define arena chunk size and the largest allocation made from an arena
+
+Arena contexts make allocations up to the max size from chunks of the chunk size.  Larger allocations are made individually.
+***********************************************************************************************************************************/
+#define MEM_CONTEXT_ARENA_CHUNK_SIZE                                ((size_t)32 * 1024)
+#define MEM_CONTEXT_ARENA_ALLOC_MAX                                 ((size_t)4 * 1024)
+
 /***********************************************************************************************************************************
 Memory context management functions
 
@@ -52,12 +60,18 @@ FINALLY
 TRY_END();
 
 Use the MEM_CONTEXT*() macros when possible rather than implement error-handling for every memory context block.
+
+An arena context makes small allocations by carving them out of large chunks rather than calling malloc() for each one, and frees
+the chunks all at once when the context is freed or reset.  memFree() only returns memory to the arena when the buffer is the last
+one allocated, so arena contexts are best for temporary contexts that are freed or reset often.
 ***********************************************************************************************************************************/
 MemContext *memContextNew(const char *name);
+MemContext *memContextNewArena(const char *name);
 void memContextMove(MemContext *this, MemContext *parentNew);
 void memContextCallbackSet(MemContext *this, void (*callbackFunction)(void *), void *);
 void memContextCallbackClear(MemContext *this);
 MemContext *memContextSwitch(MemContext *this);
+void memContextReset(MemContext *this);
 void memContextFree(MemContext *this);
 
 /***********************************************************************************************************************************
@@ -160,6 +174,8 @@ MEM_CONTEXT_TEMP_END();
 
 <Old memory context is restored>
 <Temp memory context is freed>
+
+MEM_CONTEXT_TEMP_ARENA_BEGIN() and MEM_CONTEXT_TEMP_RESET_ARENA_BEGIN() create the temp context with memContextNewArena().
 ***********************************************************************************************************************************/
 #define MEM_CONTEXT_TEMP()                                                                                                         \
     MEM_CONTEXT_TEMP_memContext
@@ -170,6 +186,12 @@ MEM_CONTEXT_TEMP_END();
                                                                                                                                    \
     MEM_CONTEXT_BEGIN(MEM_CONTEXT_TEMP())
 
+#define MEM_CONTEXT_TEMP_ARENA_BEGIN()                                                                                             \
+{                                                                                                                                  \
+    MemContext *MEM_CONTEXT_TEMP() = memContextNewArena("temporary");                                                              \
+                                                                                                                                   \
+    MEM_CONTEXT_BEGIN(MEM_CONTEXT_TEMP())
+
 #define MEM_CONTEXT_TEMP_RESET_BEGIN()                                                                                             \
 {                                                                                                                                  \
     MemContext *MEM_CONTEXT_TEMP() = memContextNew("temporary");                                                                   \
@@ -177,6 +199,13 @@ MEM_CONTEXT_TEMP_END();
                                                                                                                                    \
     MEM_CONTEXT_BEGIN(MEM_CONTEXT_TEMP())
 
+#define MEM_CONTEXT_TEMP_RESET_ARENA_BEGIN()                                                                                       \
+{                                                                                                                                  \
+    MemContext *MEM_CONTEXT_TEMP() = memContextNewArena("temporary");                                                              \
+    unsigned int MEM_CONTEXT_TEMP_loopTotal = 0;                                                                                   \
+                                                                                                                                   \
+    MEM_CONTEXT_BEGIN(MEM_CONTEXT_TEMP())
+
 #define MEM_CONTEXT_TEMP_RESET(resetTotal)                                                                                         \
     do                                                                                                                             \
     {                                                                                                                              \
@@ -184,10 +213,7 @@ MEM_CONTEXT_TEMP_END();
                                                                                                                                    \
         if (MEM_CONTEXT_TEMP_loopTotal >= resetTotal)                                                                              \
         {                                                                                                                          \
-            memContextSwitch(MEM_CONTEXT_OLD());                                                                                   \
-            memContextFree(MEM_CONTEXT_TEMP());                                                                                    \
-            MEM_CONTEXT_TEMP() = memContextNew("temporary");                                                                       \
-            memContextSwitch(MEM_CONTEXT_TEMP());                                                                                  \
+            memContextReset(MEM_CONTEXT_TEMP());                                                                                   \
             MEM_CONTEXT_TEMP_loopTotal = 0;                                                                                        \
         }                                                                                                                          \
     }                                                                                                                              \
@@ -22,9 +22,9 @@ Max call stack depth
 #define STACK_TRACE_MAX                                             128
 
 /***********************************************************************************************************************************
-Track stack trace
+Track stack trace (for each thread)
 ***********************************************************************************************************************************/
-static int stackSize = 0;
+static __thread int stackSize = 0;
 
 typedef struct StackTraceData
 {
@@ -40,12 +40,12 @@ typedef struct StackTraceData
     bool paramLog;
 } StackTraceData;
 
-static StackTraceData stackTrace[STACK_TRACE_MAX];
+static __thread StackTraceData stackTrace[STACK_TRACE_MAX];
 
 /***********************************************************************************************************************************
 Buffer to hold function parameters
 ***********************************************************************************************************************************/
-static char functionParamBuffer[32 * 1024];
+static __thread char functionParamBuffer[32 * 1024];
 
 struct backtrace_state *backTraceState = NULL;
 
@@ -90,7 +90,7 @@ Flag to enable/disable test function logging
 ***********************************************************************************************************************************/
 #ifndef NDEBUG
 
-bool stackTraceTestFlag = true;
+static __thread bool stackTraceTestFlag = true;
 
 void
 stackTraceTestStart(void)
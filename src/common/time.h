@@ -10,6 +10,7 @@ Time Management
 Time types
 ***********************************************************************************************************************************/
 typedef uint64_t TimeMSec;
+typedef uint64_t TimeUSec;
 
 /***********************************************************************************************************************************
 Constants describing number of sub-units in an interval
@@ -21,6 +22,7 @@ Functions
 ***********************************************************************************************************************************/
 void sleepMSec(TimeMSec sleepMSec);
 TimeMSec timeMSec(void);
+TimeUSec timeUSec(void);
 
 /***********************************************************************************************************************************
 Macros for function logging
@@ -17,6 +17,16 @@ Constant to indicate key not found
 ***********************************************************************************************************************************/
 #define KEY_NOT_FOUND                                               UINT_MAX
 
+/***********************************************************************************************************************************
+Hash index constants
+
+Keys are searched in the list until there are enough keys to make the search slow, then a hash index is built.  The index is open
+addressing with linear probing and is kept at most half full.  Slots contain the list index plus one so that zero is an empty slot.
+The list is not reordered so keys are still returned in the order they were added.
+***********************************************************************************************************************************/
+#define KEY_VALUE_HASH_THRESHOLD                                    16
+#define KEY_VALUE_HASH_SIZE_MIN                                     64
+
 /***********************************************************************************************************************************
 Contains information about the key value store
 ***********************************************************************************************************************************/
@@ -25,6 +35,8 @@ struct KeyValue
     MemContext *memContext;                                         // Mem context for the store
     List *list;                                                     // List of keys/values
     VariantList *keyList;                                           // List of keys
+    unsigned int *hashList;                                         // Hash index of the list (NULL until the threshold is reached)
+    unsigned int hashSize;                                          // Size of the hash index (always a power of two)
 };
 
 OBJECT_DEFINE_FREE(KEY_VALUE);
@@ -38,6 +50,150 @@ typedef struct KeyValuePair
     Variant *value;                                                 // The value (this may be NULL)
 } KeyValuePair;
 
+/***********************************************************************************************************************************
+Hash a key
+
+Only string and integer keys are hashed.  Keys of other types are never added to the index so they are found by searching the list,
+which is correct since keys of different types are never equal.
+***********************************************************************************************************************************/
+static bool
+kvHash(const Variant *key, uint64_t *hash)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(VARIANT, key);
+        FUNCTION_TEST_PARAM_P(UINT64, hash);
+    FUNCTION_TEST_END();
+
+    ASSERT(key != NULL);
+    ASSERT(hash != NULL);
+
+    bool result = true;
+    uint64_t value = 0;
+
+    switch (varType(key))
+    {
+        // FNV-1a hash of the string
+        case varTypeString:
+        {
+            const String *keyStr = varStr(key);
+
+            if (keyStr == NULL)
+            {
+                result = false;
+                break;
+            }
+
+            value = 14695981039346656037ULL;
+
+            for (size_t keyIdx = 0; keyIdx < strSize(keyStr); keyIdx++)
+                value = (value ^ (unsigned char)strPtr(keyStr)[keyIdx]) * 1099511628211ULL;
+
+            break;
+        }
+
+        case varTypeInt:
+        {
+            value = (uint64_t)varInt(key);
+            break;
+        }
+
+        case varTypeInt64:
+        {
+            value = (uint64_t)varInt64(key);
+            break;
+        }
+
+        case varTypeUInt:
+        {
+            value = varUInt(key);
+            break;
+        }
+
+        case varTypeUInt64:
+        {
+            value = varUInt64(key);
+            break;
+        }
+
+        default:
+            result = false;
+    }
+
+    // Mix the high bits into the low bits since only the low bits are used to find a slot
+    if (result)
+    {
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdULL;
+        value ^= value >> 33;
+
+        *hash = value;
+    }
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Add a key in the list to the hash index
+***********************************************************************************************************************************/
+static void
+kvHashAdd(KeyValue *this, unsigned int listIdx)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(KEY_VALUE, this);
+        FUNCTION_TEST_PARAM(UINT, listIdx);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->hashList != NULL);
+
+    uint64_t hash;
+
+    if (kvHash(((const KeyValuePair *)lstGet(this->list, listIdx))->key, &hash))
+    {
+        unsigned int hashIdx = (unsigned int)hash & (this->hashSize - 1);
+
+        while (this->hashList[hashIdx] != 0)
+            hashIdx = (hashIdx + 1) & (this->hashSize - 1);
+
+        this->hashList[hashIdx] = listIdx + 1;
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Build the hash index large enough to hold all the keys in the list and allow for growth
+***********************************************************************************************************************************/
+static void
+kvHashBuild(KeyValue *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(KEY_VALUE, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    unsigned int hashSize = KEY_VALUE_HASH_SIZE_MIN;
+
+    while (hashSize < lstSize(this->list) * 4)
+        hashSize *= 2;
+
+    MEM_CONTEXT_BEGIN(this->memContext)
+    {
+        if (this->hashList != NULL)
+            memFree(this->hashList);
+
+        this->hashList = memNew(sizeof(unsigned int) * hashSize);
+        this->hashSize = hashSize;
+    }
+    MEM_CONTEXT_END();
+
+    for (unsigned int listIdx = 0; listIdx < lstSize(this->list); listIdx++)
+        kvHashAdd(this, listIdx);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Create a new key/value store
 ***********************************************************************************************************************************/
@@ -93,6 +249,10 @@ kvDup(const KeyValue *source)
 
     this->keyList = varLstDup(source->keyList);
 
+    // Build the hash index if the source store was large enough to have one
+    if (source->hashList != NULL)
+        kvHashBuild(this);
+
     FUNCTION_TEST_RETURN(this);
 }
 
@@ -110,18 +270,38 @@ kvGetIdx(const KeyValue *this, const Variant *key)
     ASSERT(this != NULL);
     ASSERT(key != NULL);
 
-    // Search for the key
     unsigned int result = KEY_NOT_FOUND;
+    uint64_t hash;
 
-    for (unsigned int listIdx = 0; listIdx < lstSize(this->list); listIdx++)
+    // Search the hash index when there is one and the key can be hashed
+    if (this->hashList != NULL && kvHash(key, &hash))
     {
-        const KeyValuePair *pair = (const KeyValuePair *)lstGet(this->list, listIdx);
+        for (unsigned int hashIdx = (unsigned int)hash & (this->hashSize - 1); this->hashList[hashIdx] != 0;
+             hashIdx = (hashIdx + 1) & (this->hashSize - 1))
+        {
+            unsigned int listIdx = this->hashList[hashIdx] - 1;
 
-        // Break if the key matches
-        if (varEq(key, pair->key))
+            // Break if the key matches
+            if (varEq(key, ((const KeyValuePair *)lstGet(this->list, listIdx))->key))
+            {
+                result = listIdx;
+                break;
+            }
+        }
+    }
+    // Else search the list
+    else
+    {
+        for (unsigned int listIdx = 0; listIdx < lstSize(this->list); listIdx++)
         {
-            result = listIdx;
-            break;
+            const KeyValuePair *pair = (const KeyValuePair *)lstGet(this->list, listIdx);
+
+            // Break if the key matches
+            if (varEq(key, pair->key))
+            {
+                result = listIdx;
+                break;
+            }
         }
     }
 
@@ -190,6 +370,15 @@ kvPutInternal(KeyValue *this, const Variant *key, Variant *value)
 
         // Add to the key list
         varLstAdd(this->keyList, varDup(key));
+
+        // Index the key once there are enough keys that searching the list is slow.  Rebuild the index when it is half full.
+        if (lstSize(this->list) >= KEY_VALUE_HASH_THRESHOLD)
+        {
+            if (this->hashList == NULL || lstSize(this->list) * 2 > this->hashSize)
+                kvHashBuild(this);
+            else
+                kvHashAdd(this, lstSize(this->list) - 1);
+        }
     }
     // Else update it
     else
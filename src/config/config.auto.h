@@ -61,8 +61,12 @@ Option constants
     STRING_DECLARE(CFGOPT_ARCHIVE_COPY_STR);
 #define CFGOPT_ARCHIVE_GET_QUEUE_MAX                                "archive-get-queue-max"
     STRING_DECLARE(CFGOPT_ARCHIVE_GET_QUEUE_MAX_STR);
+#define CFGOPT_ARCHIVE_GET_STREAM                                   "archive-get-stream"
+    STRING_DECLARE(CFGOPT_ARCHIVE_GET_STREAM_STR);
 #define CFGOPT_ARCHIVE_PUSH_QUEUE_MAX                               "archive-push-queue-max"
     STRING_DECLARE(CFGOPT_ARCHIVE_PUSH_QUEUE_MAX_STR);
+#define CFGOPT_ARCHIVE_PUSH_STREAM                                  "archive-push-stream"
+    STRING_DECLARE(CFGOPT_ARCHIVE_PUSH_STREAM_STR);
 #define CFGOPT_ARCHIVE_TIMEOUT                                      "archive-timeout"
     STRING_DECLARE(CFGOPT_ARCHIVE_TIMEOUT_STR);
 #define CFGOPT_BACKUP_STANDBY                                       "backup-standby"
@@ -73,6 +77,8 @@ Option constants
     STRING_DECLARE(CFGOPT_C_STR);
 #define CFGOPT_CHECKSUM_PAGE                                        "checksum-page"
     STRING_DECLARE(CFGOPT_CHECKSUM_PAGE_STR);
+#define CFGOPT_CIPHER_THREAD                                        "cipher-thread"
+    STRING_DECLARE(CFGOPT_CIPHER_THREAD_STR);
 #define CFGOPT_CMD_SSH                                              "cmd-ssh"
     STRING_DECLARE(CFGOPT_CMD_SSH_STR);
 #define CFGOPT_COMMAND                                              "command"
@@ -83,6 +89,10 @@ Option constants
     STRING_DECLARE(CFGOPT_COMPRESS_LEVEL_STR);
 #define CFGOPT_COMPRESS_LEVEL_NETWORK                               "compress-level-network"
     STRING_DECLARE(CFGOPT_COMPRESS_LEVEL_NETWORK_STR);
+#define CFGOPT_COMPRESS_THREAD                                      "compress-thread"
+    STRING_DECLARE(CFGOPT_COMPRESS_THREAD_STR);
+#define CFGOPT_COMPRESS_TYPE                                        "compress-type"
+    STRING_DECLARE(CFGOPT_COMPRESS_TYPE_STR);
 #define CFGOPT_CONFIG                                               "config"
     STRING_DECLARE(CFGOPT_CONFIG_STR);
 #define CFGOPT_CONFIG_INCLUDE_PATH                                  "config-include-path"
@@ -99,6 +109,8 @@ Option constants
     STRING_DECLARE(CFGOPT_EXCLUDE_STR);
 #define CFGOPT_FILTER                                               "filter"
     STRING_DECLARE(CFGOPT_FILTER_STR);
+#define CFGOPT_FILTER_THREAD                                        "filter-thread"
+    STRING_DECLARE(CFGOPT_FILTER_THREAD_STR);
 #define CFGOPT_FORCE                                                "force"
     STRING_DECLARE(CFGOPT_FORCE_STR);
 #define CFGOPT_HOST_ID                                              "host-id"
@@ -129,6 +141,8 @@ Option constants
     STRING_DECLARE(CFGOPT_ONLINE_STR);
 #define CFGOPT_OUTPUT                                               "output"
     STRING_DECLARE(CFGOPT_OUTPUT_STR);
+#define CFGOPT_PAGE_DELTA                                           "page-delta"
+    STRING_DECLARE(CFGOPT_PAGE_DELTA_STR);
 #define CFGOPT_PERL_OPTION                                          "perl-option"
     STRING_DECLARE(CFGOPT_PERL_OPTION_STR);
 #define CFGOPT_PG1_HOST                                             "pg1-host"
@@ -295,6 +309,8 @@ Option constants
     STRING_DECLARE(CFGOPT_PROCESS_STR);
 #define CFGOPT_PROCESS_MAX                                          "process-max"
     STRING_DECLARE(CFGOPT_PROCESS_MAX_STR);
+#define CFGOPT_PROTOCOL_PIPELINE                                    "protocol-pipeline"
+    STRING_DECLARE(CFGOPT_PROTOCOL_PIPELINE_STR);
 #define CFGOPT_PROTOCOL_TIMEOUT                                     "protocol-timeout"
     STRING_DECLARE(CFGOPT_PROTOCOL_TIMEOUT_STR);
 #define CFGOPT_RECOVERY_OPTION                                      "recovery-option"
@@ -335,6 +351,8 @@ Option constants
     STRING_DECLARE(CFGOPT_REPO1_S3_CA_FILE_STR);
 #define CFGOPT_REPO1_S3_CA_PATH                                     "repo1-s3-ca-path"
     STRING_DECLARE(CFGOPT_REPO1_S3_CA_PATH_STR);
+#define CFGOPT_REPO1_S3_DOWNLOAD_MAX                                "repo1-s3-download-max"
+    STRING_DECLARE(CFGOPT_REPO1_S3_DOWNLOAD_MAX_STR);
 #define CFGOPT_REPO1_S3_ENDPOINT                                    "repo1-s3-endpoint"
     STRING_DECLARE(CFGOPT_REPO1_S3_ENDPOINT_STR);
 #define CFGOPT_REPO1_S3_HOST                                        "repo1-s3-host"
@@ -349,6 +367,8 @@ Option constants
     STRING_DECLARE(CFGOPT_REPO1_S3_REGION_STR);
 #define CFGOPT_REPO1_S3_TOKEN                                       "repo1-s3-token"
     STRING_DECLARE(CFGOPT_REPO1_S3_TOKEN_STR);
+#define CFGOPT_REPO1_S3_UPLOAD_MAX                                  "repo1-s3-upload-max"
+    STRING_DECLARE(CFGOPT_REPO1_S3_UPLOAD_MAX_STR);
 #define CFGOPT_REPO1_S3_VERIFY_TLS                                  "repo1-s3-verify-tls"
     STRING_DECLARE(CFGOPT_REPO1_S3_VERIFY_TLS_STR);
 #define CFGOPT_REPO1_TYPE                                           "repo1-type"
@@ -388,7 +408,7 @@ Option constants
 #define CFGOPT_TYPE                                                 "type"
     STRING_DECLARE(CFGOPT_TYPE_STR);
 
-#define CFG_OPTION_TOTAL                                            167
+#define CFG_OPTION_TOTAL                                            177
 
 /***********************************************************************************************************************************
 Command enum
@@ -426,17 +446,22 @@ typedef enum
     cfgOptArchiveCheck,
     cfgOptArchiveCopy,
     cfgOptArchiveGetQueueMax,
+    cfgOptArchiveGetStream,
     cfgOptArchivePushQueueMax,
+    cfgOptArchivePushStream,
     cfgOptArchiveTimeout,
     cfgOptBackupStandby,
     cfgOptBufferSize,
     cfgOptC,
     cfgOptChecksumPage,
+    cfgOptCipherThread,
     cfgOptCmdSsh,
     cfgOptCommand,
     cfgOptCompress,
     cfgOptCompressLevel,
     cfgOptCompressLevelNetwork,
+    cfgOptCompressThread,
+    cfgOptCompressType,
     cfgOptConfig,
     cfgOptConfigIncludePath,
     cfgOptConfigPath,
@@ -445,6 +470,7 @@ typedef enum
     cfgOptDelta,
     cfgOptExclude,
     cfgOptFilter,
+    cfgOptFilterThread,
     cfgOptForce,
     cfgOptHostId,
     cfgOptLinkAll,
@@ -460,6 +486,7 @@ typedef enum
     cfgOptNeutralUmask,
     cfgOptOnline,
     cfgOptOutput,
+    cfgOptPageDelta,
     cfgOptPerlOption,
     cfgOptPgHost,
     cfgOptPgHost2,
@@ -543,6 +570,7 @@ typedef enum
     cfgOptPgSocketPath8,
     cfgOptProcess,
     cfgOptProcessMax,
+    cfgOptProtocolPipeline,
     cfgOptProtocolTimeout,
     cfgOptRecoveryOption,
     cfgOptRepoCipherPass,
@@ -563,6 +591,7 @@ typedef enum
     cfgOptRepoS3Bucket,
     cfgOptRepoS3CaFile,
     cfgOptRepoS3CaPath,
+    cfgOptRepoS3DownloadMax,
     cfgOptRepoS3Endpoint,
     cfgOptRepoS3Host,
     cfgOptRepoS3Key,
@@ -570,6 +599,7 @@ typedef enum
     cfgOptRepoS3Port,
     cfgOptRepoS3Region,
     cfgOptRepoS3Token,
+    cfgOptRepoS3UploadMax,
     cfgOptRepoS3VerifyTls,
     cfgOptRepoType,
     cfgOptResume,
@@ -56,17 +56,22 @@ typedef enum
     cfgDefOptArchiveCheck,
     cfgDefOptArchiveCopy,
     cfgDefOptArchiveGetQueueMax,
+    cfgDefOptArchiveGetStream,
     cfgDefOptArchivePushQueueMax,
+    cfgDefOptArchivePushStream,
     cfgDefOptArchiveTimeout,
     cfgDefOptBackupStandby,
     cfgDefOptBufferSize,
     cfgDefOptC,
     cfgDefOptChecksumPage,
+    cfgDefOptCipherThread,
     cfgDefOptCmdSsh,
     cfgDefOptCommand,
     cfgDefOptCompress,
     cfgDefOptCompressLevel,
     cfgDefOptCompressLevelNetwork,
+    cfgDefOptCompressThread,
+    cfgDefOptCompressType,
     cfgDefOptConfig,
     cfgDefOptConfigIncludePath,
     cfgDefOptConfigPath,
@@ -75,6 +80,7 @@ typedef enum
     cfgDefOptDelta,
     cfgDefOptExclude,
     cfgDefOptFilter,
+    cfgDefOptFilterThread,
     cfgDefOptForce,
     cfgDefOptHostId,
     cfgDefOptLinkAll,
@@ -90,6 +96,7 @@ typedef enum
     cfgDefOptNeutralUmask,
     cfgDefOptOnline,
     cfgDefOptOutput,
+    cfgDefOptPageDelta,
     cfgDefOptPerlOption,
     cfgDefOptPgHost,
     cfgDefOptPgHostCmd,
@@ -103,6 +110,7 @@ typedef enum
     cfgDefOptPgSocketPath,
     cfgDefOptProcess,
     cfgDefOptProcessMax,
+    cfgDefOptProtocolPipeline,
     cfgDefOptProtocolTimeout,
     cfgDefOptRecoveryOption,
     cfgDefOptRepoCipherPass,
@@ -123,6 +131,7 @@ typedef enum
     cfgDefOptRepoS3Bucket,
     cfgDefOptRepoS3CaFile,
     cfgDefOptRepoS3CaPath,
+    cfgDefOptRepoS3DownloadMax,
     cfgDefOptRepoS3Endpoint,
     cfgDefOptRepoS3Host,
     cfgDefOptRepoS3Key,
@@ -130,6 +139,7 @@ typedef enum
     cfgDefOptRepoS3Port,
     cfgDefOptRepoS3Region,
     cfgDefOptRepoS3Token,
+    cfgDefOptRepoS3UploadMax,
     cfgDefOptRepoS3VerifyTls,
     cfgDefOptRepoType,
     cfgDefOptResume,
@@ -7,6 +7,7 @@ Configuration Load
 #include <sys/stat.h>
 
 #include "command/command.h"
+#include "common/compress/helper.h"
 #include "common/memContext.h"
 #include "common/debug.h"
 #include "common/io/io.h"
@@ -219,6 +220,28 @@ cfgLoadUpdateOption(void)
         }
     }
 
+    // Error if the compress type is not available in this build or the compress level is not valid for the compress type
+    if (cfgOptionValid(cfgOptCompressType) && cfgOptionBool(cfgOptCompress))
+    {
+        CompressType type = compressType(cfgOptionStr(cfgOptCompressType));
+        compressTypePresent(type);
+
+        // The default level is only right for gz so use the default for the compress type when the level was not set
+        if (cfgOptionSource(cfgOptCompressLevel) == cfgSourceDefault)
+            cfgOptionSet(cfgOptCompressLevel, cfgSourceDefault, VARINT(compressLevelDefault(type)));
+
+        if (cfgOptionInt(cfgOptCompressLevel) < compressLevelMin(type) ||
+            cfgOptionInt(cfgOptCompressLevel) > compressLevelMax(type))
+        {
+            THROW_FMT(
+                OptionInvalidValueError,
+                "'%d' is not valid for '" CFGOPT_COMPRESS_LEVEL "' option\n"
+                    "HINT: '" CFGOPT_COMPRESS_TYPE "=%s' allows levels %d-%d.",
+                cfgOptionInt(cfgOptCompressLevel), strPtr(cfgOptionStr(cfgOptCompressType)), compressLevelMin(type),
+                compressLevelMax(type));
+        }
+    }
+
     // Error if an S3 bucket name contains dots
     if (cfgOptionTest(cfgOptRepoS3Bucket) && cfgOptionBool(cfgOptRepoS3VerifyTls) &&
         strChr(cfgOptionStr(cfgOptRepoS3Bucket), '.') != -1)
@@ -299,6 +322,10 @@ cfgLoad(unsigned int argListSize, const char *argList[])
             if (cfgOptionValid(cfgOptBufferSize))
                 ioBufferSizeSet(cfgOptionUInt(cfgOptBufferSize));
 
+            // Set filter threads
+            if (cfgOptionValid(cfgOptFilterThread))
+                ioFilterThreadSet(cfgOptionBool(cfgOptFilterThread));
+
             // Open the log file if this command logs to a file
             cfgLoadLogFile();
 
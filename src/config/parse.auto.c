@@ -66,6 +66,21 @@ static const struct option optionList[] =
         .val = PARSE_OPTION_FLAG | PARSE_RESET_FLAG | cfgOptArchiveGetQueueMax,
     },
 
+    // archive-get-stream option
+    // -----------------------------------------------------------------------------------------------------------------------------
+    {
+        .name = CFGOPT_ARCHIVE_GET_STREAM,
+        .val = PARSE_OPTION_FLAG | cfgOptArchiveGetStream,
+    },
+    {
+        .name = "no-" CFGOPT_ARCHIVE_GET_STREAM,
+        .val = PARSE_OPTION_FLAG | PARSE_NEGATE_FLAG | cfgOptArchiveGetStream,
+    },
+    {
+        .name = "reset-" CFGOPT_ARCHIVE_GET_STREAM,
+        .val = PARSE_OPTION_FLAG | PARSE_RESET_FLAG | cfgOptArchiveGetStream,
+    },
+
     // archive-push-queue-max option and deprecations
     // -----------------------------------------------------------------------------------------------------------------------------
     {
@@ -87,6 +102,21 @@ static const struct option optionList[] =
         .val = PARSE_OPTION_FLAG | PARSE_DEPRECATE_FLAG | PARSE_RESET_FLAG | cfgOptArchivePushQueueMax,
     },
 
+    // archive-push-stream option
+    // -----------------------------------------------------------------------------------------------------------------------------
+    {
+        .name = CFGOPT_ARCHIVE_PUSH_STREAM,
+        .val = PARSE_OPTION_FLAG | cfgOptArchivePushStream,
+    },
+    {
+        .name = "no-" CFGOPT_ARCHIVE_PUSH_STREAM,
+        .val = PARSE_OPTION_FLAG | PARSE_NEGATE_FLAG | cfgOptArchivePushStream,
+    },
+    {
+        .name = "reset-" CFGOPT_ARCHIVE_PUSH_STREAM,
+        .val = PARSE_OPTION_FLAG | PARSE_RESET_FLAG | cfgOptArchivePushStream,
+    },
+
     // archive-timeout option
     // -----------------------------------------------------------------------------------------------------------------------------
     {
@@ -148,6 +178,18 @@ static const struct option optionList[] =
         .val = PARSE_OPTION_FLAG | PARSE_RESET_FLAG | cfgOptChecksumPage,
     },
 
+    // cipher-thread option
+    // -----------------------------------------------------------------------------------------------------------------------------
+    {
+        .name = CFGOPT_CIPHER_THREAD,
+        .has_arg = required_argument,
+        .val = PARSE_OPTION_FLAG | cfgOptCipherThread,
+    },
+    {
+        .name = "reset-" CFGOPT_CIPHER_THREAD,
+        .val = PARSE_OPTION_FLAG | PARSE_RESET_FLAG | cfgOptCipherThread,
+    },
+
     // cmd-ssh option
     // -----------------------------------------------------------------------------------------------------------------------------
     {
@@ -207,6 +249,30 @@ static const struct option optionList[] =
         .val = PARSE_OPTION_FLAG | PARSE_RESET_FLAG | cfgOptCompressLevelNetwork,
     },
 
+    // compress-thread option
+    // -----------------------------------------------------------------------------------------------------------------------------
+    {
+        .name = CFGOPT_COMPRESS_THREAD,
+        .has_arg = required_argument,
+        .val = PARSE_OPTION_FLAG | cfgOptCompressThread,
+    },
+    {
+        .name = "reset-" CFGOPT_COMPRESS_THREAD,
+        .val = PARSE_OPTION_FLAG | PARSE_RESET_FLAG | cfgOptCompressThread,
+    },
+
+    // compress-type option
+    // -----------------------------------------------------------------------------------------------------------------------------
+    {
+        .name = CFGOPT_COMPRESS_TYPE,
+        .has_arg = required_argument,
+        .val = PARSE_OPTION_FLAG | cfgOptCompressType,
+    },
+    {
+        .name = "reset-" CFGOPT_COMPRESS_TYPE,
+        .val = PARSE_OPTION_FLAG | PARSE_RESET_FLAG | cfgOptCompressType,
+    },
+
     // config option
     // -----------------------------------------------------------------------------------------------------------------------------
     {
@@ -294,6 +360,21 @@ static const struct option optionList[] =
         .val = PARSE_OPTION_FLAG | cfgOptFilter,
     },
 
+    // filter-thread option
+    // -----------------------------------------------------------------------------------------------------------------------------
+    {
+        .name = CFGOPT_FILTER_THREAD,
+        .val = PARSE_OPTION_FLAG | cfgOptFilterThread,
+    },
+    {
+        .name = "no-" CFGOPT_FILTER_THREAD,
+        .val = PARSE_OPTION_FLAG | PARSE_NEGATE_FLAG | cfgOptFilterThread,
+    },
+    {
+        .name = "reset-" CFGOPT_FILTER_THREAD,
+        .val = PARSE_OPTION_FLAG | PARSE_RESET_FLAG | cfgOptFilterThread,
+    },
+
     // force option
     // -----------------------------------------------------------------------------------------------------------------------------
     {
@@ -472,6 +553,21 @@ static const struct option optionList[] =
         .val = PARSE_OPTION_FLAG | cfgOptOutput,
     },
 
+    // page-delta option
+    // -----------------------------------------------------------------------------------------------------------------------------
+    {
+        .name = CFGOPT_PAGE_DELTA,
+        .val = PARSE_OPTION_FLAG | cfgOptPageDelta,
+    },
+    {
+        .name = "no-" CFGOPT_PAGE_DELTA,
+        .val = PARSE_OPTION_FLAG | PARSE_NEGATE_FLAG | cfgOptPageDelta,
+    },
+    {
+        .name = "reset-" CFGOPT_PAGE_DELTA,
+        .val = PARSE_OPTION_FLAG | PARSE_RESET_FLAG | cfgOptPageDelta,
+    },
+
     // perl-option option
     // -----------------------------------------------------------------------------------------------------------------------------
     {
@@ -1614,6 +1710,18 @@ static const struct option optionList[] =
         .val = PARSE_OPTION_FLAG | PARSE_RESET_FLAG | cfgOptProcessMax,
     },
 
+    // protocol-pipeline option
+    // -----------------------------------------------------------------------------------------------------------------------------
+    {
+        .name = CFGOPT_PROTOCOL_PIPELINE,
+        .has_arg = required_argument,
+        .val = PARSE_OPTION_FLAG | cfgOptProtocolPipeline,
+    },
+    {
+        .name = "reset-" CFGOPT_PROTOCOL_PIPELINE,
+        .val = PARSE_OPTION_FLAG | PARSE_RESET_FLAG | cfgOptProtocolPipeline,
+    },
+
     // protocol-timeout option
     // -----------------------------------------------------------------------------------------------------------------------------
     {
@@ -1940,6 +2048,18 @@ static const struct option optionList[] =
         .val = PARSE_OPTION_FLAG | PARSE_DEPRECATE_FLAG | cfgOptRepoS3CaPath,
     },
 
+    // repo-s3-download-max option
+    // -----------------------------------------------------------------------------------------------------------------------------
+    {
+        .name = CFGOPT_REPO1_S3_DOWNLOAD_MAX,
+        .has_arg = required_argument,
+        .val = PARSE_OPTION_FLAG | cfgOptRepoS3DownloadMax,
+    },
+    {
+        .name = "reset-" CFGOPT_REPO1_S3_DOWNLOAD_MAX,
+        .val = PARSE_OPTION_FLAG | PARSE_RESET_FLAG | cfgOptRepoS3DownloadMax,
+    },
+
     // repo-s3-endpoint option and deprecations
     // -----------------------------------------------------------------------------------------------------------------------------
     {
@@ -2049,6 +2169,18 @@ static const struct option optionList[] =
         .val = PARSE_OPTION_FLAG | PARSE_RESET_FLAG | cfgOptRepoS3Token,
     },
 
+    // repo-s3-upload-max option
+    // -----------------------------------------------------------------------------------------------------------------------------
+    {
+        .name = CFGOPT_REPO1_S3_UPLOAD_MAX,
+        .has_arg = required_argument,
+        .val = PARSE_OPTION_FLAG | cfgOptRepoS3UploadMax,
+    },
+    {
+        .name = "reset-" CFGOPT_REPO1_S3_UPLOAD_MAX,
+        .val = PARSE_OPTION_FLAG | PARSE_RESET_FLAG | cfgOptRepoS3UploadMax,
+    },
+
     // repo-s3-verify-tls option and deprecations
     // -----------------------------------------------------------------------------------------------------------------------------
     {
@@ -2277,17 +2409,22 @@ static const ConfigOption optionResolveOrder[] =
     cfgOptStanza,
     cfgOptArchiveAsync,
     cfgOptArchiveGetQueueMax,
+    cfgOptArchiveGetStream,
     cfgOptArchivePushQueueMax,
+    cfgOptArchivePushStream,
     cfgOptArchiveTimeout,
     cfgOptBackupStandby,
     cfgOptBufferSize,
     cfgOptC,
     cfgOptChecksumPage,
+    cfgOptCipherThread,
     cfgOptCmdSsh,
     cfgOptCommand,
     cfgOptCompress,
     cfgOptCompressLevel,
     cfgOptCompressLevelNetwork,
+    cfgOptCompressThread,
+    cfgOptCompressType,
     cfgOptConfig,
     cfgOptConfigIncludePath,
     cfgOptConfigPath,
@@ -2296,6 +2433,7 @@ static const ConfigOption optionResolveOrder[] =
     cfgOptDelta,
     cfgOptExclude,
     cfgOptFilter,
+    cfgOptFilterThread,
     cfgOptHostId,
     cfgOptLinkAll,
     cfgOptLinkMap,
@@ -2310,6 +2448,7 @@ static const ConfigOption optionResolveOrder[] =
     cfgOptNeutralUmask,
     cfgOptOnline,
     cfgOptOutput,
+    cfgOptPageDelta,
     cfgOptPerlOption,
     cfgOptPgHost,
     cfgOptPgHost + 1,
@@ -2393,6 +2532,7 @@ static const ConfigOption optionResolveOrder[] =
     cfgOptPgSocketPath + 7,
     cfgOptProcess,
     cfgOptProcessMax,
+    cfgOptProtocolPipeline,
     cfgOptProtocolTimeout,
     cfgOptRepoCipherType,
     cfgOptRepoHardlink,
@@ -2429,6 +2569,7 @@ static const ConfigOption optionResolveOrder[] =
     cfgOptRepoS3Bucket,
     cfgOptRepoS3CaFile,
     cfgOptRepoS3CaPath,
+    cfgOptRepoS3DownloadMax,
     cfgOptRepoS3Endpoint,
     cfgOptRepoS3Host,
     cfgOptRepoS3Key,
@@ -2436,6 +2577,7 @@ static const ConfigOption optionResolveOrder[] =
     cfgOptRepoS3Port,
     cfgOptRepoS3Region,
     cfgOptRepoS3Token,
+    cfgOptRepoS3UploadMax,
     cfgOptRepoS3VerifyTls,
     cfgOptTarget,
     cfgOptTargetAction,
@@ -7,11 +7,12 @@ Info Handler
 #include <stdlib.h>
 #include <string.h>
 
-#include "common/crypto/cipherBlock.h"
 #include "common/crypto/hash.h"
+#include "common/crypto/helper.h"
 #include "common/debug.h"
 #include "common/encode.h"
 #include "common/io/filter/filter.intern.h"
+#include "common/io/io.h"
 #include "common/ini.h"
 #include "common/log.h"
 #include "common/memContext.h"
@@ -89,6 +90,189 @@ infoNew(CipherType cipherType, const String *cipherPassSub)
     FUNCTION_LOG_RETURN(INFO, this);
 }
 
+/***********************************************************************************************************************************
+Info checksum
+
+The checksum is a sha1 hash of the ini content rendered as canonical JSON, i.e. sections and keys are sorted and the checksum key
+itself is omitted.  The JSON is accumulated in a buffer and hashed in large chunks rather than passing each token to the hash
+separately.  When the ini is loaded in sorted order (which is how it is saved) the checksum is calculated while the file is parsed.
+***********************************************************************************************************************************/
+typedef struct InfoHash
+{
+    IoFilter *hash;                                                 // Hash filter
+    Buffer *buffer;                                                 // JSON accumulated since the last hash update
+    Buffer *sectionLast;                                            // Last section added (zero-terminated)
+    Buffer *keyLast;                                                // Last key added in the current section (zero-terminated)
+    bool keyPending;                                                // Was a key added that must be followed by a comma?
+    bool sorted;                                                    // Have sections/keys been added in sorted order?
+} InfoHash;
+
+// Create the hash and open the JSON
+static InfoHash *
+infoHashNew(void)
+{
+    FUNCTION_TEST_VOID();
+
+    InfoHash *this = memNew(sizeof(InfoHash));
+
+    *this = (InfoHash)
+    {
+        .hash = cryptoHashNew(HASH_TYPE_SHA1_STR),
+        .buffer = bufNew(ioBufferSize()),
+        .sectionLast = bufNew(0),
+        .keyLast = bufNew(0),
+        .sorted = true,
+    };
+
+    bufCatC(this->buffer, (const unsigned char *)"{", 0, 1);
+
+    FUNCTION_TEST_RETURN(this);
+}
+
+// Add content to the JSON and hash the buffer when it is full
+static void
+infoHashCat(InfoHash *this, const char *content, size_t contentSize)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, this);
+        FUNCTION_TEST_PARAM_P(CHARDATA, content);
+        FUNCTION_TEST_PARAM(SIZE, contentSize);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(content != NULL);
+
+    // Hash the buffer when the content will not fit
+    if (contentSize > bufRemains(this->buffer))
+    {
+        ioFilterProcessIn(this->hash, this->buffer);
+        bufUsedZero(this->buffer);
+    }
+
+    // Content too large for the buffer is hashed directly
+    if (contentSize > bufRemains(this->buffer))
+        ioFilterProcessIn(this->hash, BUF(content, contentSize));
+    else
+        bufCatC(this->buffer, (const unsigned char *)content, 0, contentSize);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+// Store a zero-terminated copy of a string for comparison
+static void
+infoHashLastSet(Buffer *last, const String *value)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BUFFER, last);
+        FUNCTION_TEST_PARAM(STRING, value);
+    FUNCTION_TEST_END();
+
+    bufUsedZero(last);
+    bufCatC(last, (const unsigned char *)strPtr(value), 0, strSize(value) + 1);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+// Add a key/value.  A new section is started when the section changes.  If sections/keys are not added in sorted order then the
+// result will not be valid, which can be checked with infoHashSorted().
+static void
+infoHashAdd(InfoHash *this, const String *section, const String *key, const String *value)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, this);
+        FUNCTION_TEST_PARAM(STRING, section);
+        FUNCTION_TEST_PARAM(STRING, key);
+        FUNCTION_TEST_PARAM(STRING, value);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(section != NULL);
+    ASSERT(key != NULL);
+    ASSERT(value != NULL);
+
+    if (this->sorted)
+    {
+        // Start a new section
+        if (bufUsed(this->sectionLast) == 0 || !strEqZ(section, (const char *)bufPtr(this->sectionLast)))
+        {
+            if (bufUsed(this->sectionLast) != 0)
+            {
+                if (strCmpZ(section, (const char *)bufPtr(this->sectionLast)) < 0)
+                    this->sorted = false;
+
+                infoHashCat(this, "},", 2);
+            }
+
+            infoHashLastSet(this->sectionLast, section);
+            bufUsedZero(this->keyLast);
+            this->keyPending = false;
+
+            infoHashCat(this, "\"", 1);
+            infoHashCat(this, strPtr(section), strSize(section));
+            infoHashCat(this, "\":{", 3);
+        }
+        // Else make sure the key sorts after the last key
+        else if (strCmpZ(key, (const char *)bufPtr(this->keyLast)) <= 0)
+            this->sorted = false;
+
+        infoHashLastSet(this->keyLast, key);
+
+        // A comma follows each key that is not the last in the section
+        if (this->keyPending)
+        {
+            infoHashCat(this, ",", 1);
+            this->keyPending = false;
+        }
+
+        // Skip the backrest checksum in the file
+        if (!strEq(section, INFO_SECTION_BACKREST_STR) || !strEq(key, INFO_KEY_CHECKSUM_STR))
+        {
+            infoHashCat(this, "\"", 1);
+            infoHashCat(this, strPtr(key), strSize(key));
+            infoHashCat(this, "\":", 2);
+            infoHashCat(this, strPtr(value), strSize(value));
+
+            this->keyPending = true;
+        }
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+// Were sections/keys added in sorted order?
+static bool
+infoHashSorted(const InfoHash *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->sorted);
+}
+
+// Close the JSON and return the hash
+static String *
+infoHashResult(InfoHash *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->sorted);
+
+    // Close the last section and the JSON
+    if (bufUsed(this->sectionLast) != 0)
+        infoHashCat(this, "}", 1);
+
+    infoHashCat(this, "}", 1);
+    ioFilterProcessIn(this->hash, this->buffer);
+
+    FUNCTION_TEST_RETURN(strDup(varStr(ioFilterResult(this->hash))));
+}
+
 /***********************************************************************************************************************************
 Generate hash for the contents of an ini file
 ***********************************************************************************************************************************/
@@ -105,58 +289,24 @@ infoHash(const Ini *ini)
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        IoFilter *hash = cryptoHashNew(HASH_TYPE_SHA1_STR);
+        InfoHash *hash = infoHashNew();
         StringList *sectionList = strLstSort(iniSectionList(ini), sortOrderAsc);
 
-        // Initial JSON opening bracket
-        ioFilterProcessIn(hash, BUFSTRDEF("{"));
-
-        // Loop through sections and create hash for checking checksum
+        // Loop through sections and keys in sorted order
         for (unsigned int sectionIdx = 0; sectionIdx < strLstSize(sectionList); sectionIdx++)
         {
-            String *section = strLstGet(sectionList, sectionIdx);
-
-            // Add a comma before additional sections
-            if (sectionIdx != 0)
-                ioFilterProcessIn(hash, BUFSTRDEF(","));
-
-            // Create the section header
-            ioFilterProcessIn(hash, BUFSTRDEF("\""));
-            ioFilterProcessIn(hash, BUFSTR(section));
-            ioFilterProcessIn(hash, BUFSTRDEF("\":{"));
-
+            const String *section = strLstGet(sectionList, sectionIdx);
             StringList *keyList = strLstSort(iniSectionKeyList(ini, section), sortOrderAsc);
-            unsigned int keyListSize = strLstSize(keyList);
 
-            // Loop through values and build the section
-            for (unsigned int keyIdx = 0; keyIdx < keyListSize; keyIdx++)
+            for (unsigned int keyIdx = 0; keyIdx < strLstSize(keyList); keyIdx++)
             {
-                String *key = strLstGet(keyList, keyIdx);
-
-                // Skip the backrest checksum in the file
-                if (!strEq(section, INFO_SECTION_BACKREST_STR) || !strEq(key, INFO_KEY_CHECKSUM_STR))
-                {
-                    ioFilterProcessIn(hash, BUFSTRDEF("\""));
-                    ioFilterProcessIn(hash, BUFSTR(key));
-                    ioFilterProcessIn(hash, BUFSTRDEF("\":"));
-                    ioFilterProcessIn(hash, BUFSTR(iniGet(ini, section, strLstGet(keyList, keyIdx))));
-
-                    if ((keyListSize > 1) && (keyIdx < keyListSize - 1))
-                        ioFilterProcessIn(hash, BUFSTRDEF(","));
-                }
+                const String *key = strLstGet(keyList, keyIdx);
+                infoHashAdd(hash, section, key, iniGet(ini, section, key));
             }
-
-            // Close the key/value list
-            ioFilterProcessIn(hash, BUFSTRDEF("}"));
         }
 
-        // JSON closing bracket
-        ioFilterProcessIn(hash, BUFSTRDEF("}"));
-
-        Variant *resultVar = ioFilterResult(hash);
-
         memContextSwitch(MEM_CONTEXT_OLD());
-        result = strDup(varStr(resultVar));
+        result = infoHashResult(hash);
         memContextSwitch(MEM_CONTEXT_TEMP());
     }
     MEM_CONTEXT_TEMP_END();
@@ -164,6 +314,35 @@ infoHash(const Ini *ini)
     FUNCTION_TEST_RETURN(result);
 }
 
+/***********************************************************************************************************************************
+Store a key/value loaded by iniLoad() and add it to the checksum
+***********************************************************************************************************************************/
+typedef struct InfoLoadData
+{
+    Ini *ini;                                                       // Ini to store key/values in
+    InfoHash *hash;                                                 // Checksum calculated while loading
+} InfoLoadData;
+
+static void
+infoLoadCallback(void *data, const String *section, const String *key, const String *value)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM(STRING, section);
+        FUNCTION_TEST_PARAM(STRING, key);
+        FUNCTION_TEST_PARAM(STRING, value);
+    FUNCTION_TEST_END();
+
+    ASSERT(data != NULL);
+
+    InfoLoadData *loadData = (InfoLoadData *)data;
+
+    iniSet(loadData->ini, section, key, value);
+    infoHashAdd(loadData->hash, section, key, value);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Load and validate the info file (or copy)
 ***********************************************************************************************************************************/
@@ -195,15 +374,16 @@ infoLoad(Info *this, const Storage *storage, const String *fileName, bool copyFi
         {
             ioFilterGroupAdd(
                 ioReadFilterGroup(storageReadIo(infoRead)),
-                cipherBlockNew(cipherModeDecrypt, cipherType, BUFSTR(cipherPass), NULL));
+                cipherFilter(cipherModeDecrypt, cipherType, BUFSTR(cipherPass), 1));
         }
 
-        // Load and parse the info file
-        Buffer *buffer = NULL;
+        // Load and parse the info file as it is read, calculating the checksum in the same pass
+        result = iniNew();
+        InfoLoadData loadData = {.ini = result, .hash = infoHashNew()};
 
         TRY_BEGIN()
         {
-            buffer = storageGetNP(infoRead);
+            iniLoad(storageReadIo(infoRead), infoLoadCallback, &loadData);
         }
         CATCH(CryptoError)
         {
@@ -213,12 +393,11 @@ infoLoad(Info *this, const Storage *storage, const String *fileName, bool copyFi
         }
         TRY_END();
 
-        result = iniNew();
-        iniParse(result, strNewBuf(buffer));
-
         // Make sure the ini is valid by testing the checksum
         const String *infoChecksumJson = iniGet(result, INFO_SECTION_BACKREST_STR, INFO_KEY_CHECKSUM_STR);
-        const String *checksum = infoHash(result);
+
+        // If the file was not saved in sorted order then the checksum calculated during the load is not valid so recalculate it
+        const String *checksum = infoHashSorted(loadData.hash) ? infoHashResult(loadData.hash) : infoHash(result);
 
         if (strSize(infoChecksumJson) == 0)
         {
@@ -368,7 +547,7 @@ infoSave(
         if (cipherType != cipherTypeNone)
         {
             ioFilterGroupAdd(
-                ioWriteFilterGroup(infoWrite), cipherBlockNew(cipherModeEncrypt, cipherType, BUFSTR(cipherPass), NULL));
+                ioWriteFilterGroup(infoWrite), cipherFilter(cipherModeEncrypt, cipherType, BUFSTR(cipherPass), 1));
         }
 
         iniSave(ini, infoWrite);
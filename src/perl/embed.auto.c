@@ -173,7 +173,7 @@ static const EmbeddedModule embeddedModule[] =
             "STORAGE_REPO_ARCHIVE . \"/${strArchiveId}/\" . substr($strWalSegment, 0, 16),\n"
             "{strExpression =>\n"
             "'^' . substr($strWalSegment, 0, 24) . (walIsPartial($strWalSegment) ? \"\\\\.partial\" : '') .\n"
-            "\"-[0-f]{40}(\\\\.\" . COMPRESS_EXT . \"){0,1}\\$\",\n"
+            "\"-[0-f]{40}\" . COMPRESS_EXT_REGEXP . \"\\$\",\n"
             "bIgnoreMissing => true}));\n"
             "}\n"
             "while (@stryWalFileName == 0 && waitMore($oWait));\n"
@@ -690,7 +690,7 @@ static const EmbeddedModule embeddedModule[] =
             "\n\n"
             "my $strArchiveFile = (storageRepo()->list(\n"
             "$self->{strArchiveClusterPath} . \"/${strVersionDir}/${strArchiveDir}\",\n"
-            "{strExpression => \"^[0-F]{24}(\\\\.partial){0,1}(-[0-f]+){0,1}(\\\\.\" . COMPRESS_EXT . \"){0,1}\\$\",\n"
+            "{strExpression => \"^[0-F]{24}(\\\\.partial){0,1}(-[0-f]+){0,1}\" . COMPRESS_EXT_REGEXP . \"\\$\",\n"
             "bIgnoreMissing => true}))[0];\n"
             "\n\n"
             "if (!defined($strArchiveFile))\n"
@@ -710,10 +710,12 @@ static const EmbeddedModule embeddedModule[] =
             "\"\\nHINT: Is or was the repo encrypted?\", ERROR_CRYPTO);\n"
             "}\n"
             "\n\n"
+            "my $strCompressType = compressTypeFromName($strArchiveFile);\n"
+            "\n\n"
             "my $oFileIo = storageRepo()->openRead(\n"
             "$strArchiveFilePath,\n"
-            "{rhyFilter => $strArchiveFile =~ ('\\.' . COMPRESS_EXT . '$') ?\n"
-            "[{strClass => STORAGE_FILTER_GZIP, rxyParam => [STORAGE_DECOMPRESS, false]}] : undef,\n"
+            "{rhyFilter => defined($strCompressType) ?\n"
+            "[{strClass => STORAGE_FILTER_COMPRESS, rxyParam => [STORAGE_DECOMPRESS, $strCompressType]}] : undef,\n"
             "strCipherPass => $self->cipherPassSub()});\n"
             "$oFileIo->open();\n"
             "\n"
@@ -951,7 +953,7 @@ static const EmbeddedModule embeddedModule[] =
             "\n\n"
             "my $hFile = $oStorageRepo->manifest(STORAGE_REPO_BACKUP . \"/${strBackupLabel}\");\n"
             "\n\n"
-            "my $bCompressed = $oAbortedManifest->boolGet(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_COMPRESS);\n"
+            "my $strCompressType = $oAbortedManifest->compressType();\n"
             "\n"
             "if (!$bDelta)\n"
             "{\n"
@@ -978,9 +980,9 @@ static const EmbeddedModule embeddedModule[] =
             "\n"
             "my $strFile = $strName;\n"
             "\n"
-            "if ($bCompressed)\n"
+            "if (defined($strCompressType))\n"
             "{\n"
-            "$strFile = substr($strFile, 0, length($strFile) - 3);\n"
+            "$strFile = substr($strFile, 0, length($strFile) - length($strCompressType) - 1);\n"
             "}\n"
             "\n\n\n"
             "if ($oManifest->test(MANIFEST_SECTION_TARGET_FILE, $strFile) &&\n"
@@ -1025,9 +1027,9 @@ static const EmbeddedModule embeddedModule[] =
             "\n"
             "my $strFile = $strName;\n"
             "\n"
-            "if ($bCompressed)\n"
+            "if (defined($strCompressType))\n"
             "{\n"
-            "$strFile = substr($strFile, 0, length($strFile) - 3);\n"
+            "$strFile = substr($strFile, 0, length($strFile) - length($strCompressType) - 1);\n"
             "}\n"
             "\n\n"
             "if ($oManifest->test(MANIFEST_SECTION_TARGET_FILE, $strFile) &&\n"
@@ -1103,11 +1105,13 @@ static const EmbeddedModule embeddedModule[] =
             "$strDbCopyPath,\n"
             "$strType,\n"
             "$strDbVersion,\n"
-            "$bCompress,\n"
+            "$strCompressType,\n"
+            "$iCompressLevel,\n"
             "$bHardLink,\n"
             "$oBackupManifest,\n"
             "$strBackupLabel,\n"
             "$strLsnStart,\n"
+            "$oFullManifest,\n"
             ") =\n"
             "logDebugParam\n"
             "(\n"
@@ -1116,11 +1120,13 @@ static const EmbeddedModule embeddedModule[] =
             "{name => 'strDbCopyPath'},\n"
             "{name => 'strType'},\n"
             "{name => 'strDbVersion'},\n"
-            "{name => 'bCompress'},\n"
+            "{name => 'strCompressType', required => false},\n"
+            "{name => 'iCompressLevel'},\n"
             "{name => 'bHardLink'},\n"
             "{name => 'oBackupManifest'},\n"
             "{name => 'strBackupLabel'},\n"
             "{name => 'strLsnStart', required => false},\n"
+            "{name => 'oFullManifest', required => false},\n"
             ");\n"
             "\n\n"
             "&log(TEST, TEST_BACKUP_START);\n"
@@ -1210,6 +1216,16 @@ static const EmbeddedModule embeddedModule[] =
             "\n"
             "$lFileTotal++;\n"
             "$lSizeTotal += $lSize;\n"
+            "\n\n\n"
+            "my $strLsnPageDelta;\n"
+            "my $lPageDeltaBaseSize = 0;\n"
+            "\n"
+            "if (defined($oFullManifest) && $lSize > 0 && isChecksumPage($strRepoFile) &&\n"
+            "$oFullManifest->numericGet(MANIFEST_SECTION_TARGET_FILE, $strRepoFile, MANIFEST_SUBKEY_SIZE, false, 0) > 0)\n"
+            "{\n"
+            "$strLsnPageDelta = $oFullManifest->get(MANIFEST_SECTION_BACKUP, MANIFEST_KEY_LSN_START);\n"
+            "$lPageDeltaBaseSize = $oFullManifest->numericGet(MANIFEST_SECTION_TARGET_FILE, $strRepoFile, MANIFEST_SUBKEY_SIZE);\n"
+            "}\n"
             "\n\n"
             "$oBackupProcess->queueJob(\n"
             "$iHostConfigIdx, $strQueueKey, $strRepoFile, OP_BACKUP_FILE,\n"
@@ -1218,8 +1234,11 @@ static const EmbeddedModule embeddedModule[] =
             "cfgOption(CFGOPT_CHECKSUM_PAGE) ? isChecksumPage($strRepoFile) : false,\n"
             "defined($strLsnStart) ? hex((split('/', $strLsnStart))[0]) : 0xFFFFFFFF,\n"
             "defined($strLsnStart) ? hex((split('/', $strLsnStart))[1]) : 0xFFFFFFFF,\n"
-            "$strRepoFile, defined($strReference) ? true : false, $bCompress, cfgOption(CFGOPT_COMPRESS_LEVEL),\n"
-            "$strBackupLabel, cfgOption(CFGOPT_DELTA)],\n"
+            "$strRepoFile, defined($strReference) ? true : false,\n"
+            "defined($strCompressType) ? $strCompressType : COMPRESS_TYPE_NONE, $iCompressLevel,\n"
+            "$strBackupLabel, cfgOption(CFGOPT_DELTA),\n"
+            "defined($strLsnPageDelta) ? hex((split('/', $strLsnPageDelta))[0]) : 0,\n"
+            "defined($strLsnPageDelta) ? hex((split('/', $strLsnPageDelta))[1]) : 0, $lPageDeltaBaseSize],\n"
             "{rParamSecure => $oBackupManifest->cipherPassSub() ? [$oBackupManifest->cipherPassSub()] : undef});\n"
             "\n\n"
             "$oBackupManifest->remove(MANIFEST_SECTION_TARGET_FILE, $strRepoFile, MANIFEST_SUBKEY_SIZE);\n"
@@ -1257,6 +1276,17 @@ static const EmbeddedModule embeddedModule[] =
             "$hJob->{iProcessId}, @{$hJob->{rParam}}[0], @{$hJob->{rParam}}[7], @{$hJob->{rParam}}[2], @{$hJob->{rParam}}[3],\n"
             "@{$hJob->{rParam}}[4], @{$hJob->{rResult}}, $lSizeTotal, $lSizeCurrent, $lManifestSaveSize,\n"
             "$lManifestSaveCurrent);\n"
+            "\n\n"
+            "if ((@{$hJob->{rResult}}[0] == BACKUP_FILE_COPY || @{$hJob->{rResult}}[0] == BACKUP_FILE_RECOPY) &&\n"
+            "@{$hJob->{rParam}}[15] > 0)\n"
+            "{\n"
+            "$oBackupManifest->set(\n"
+            "MANIFEST_SECTION_TARGET_FILE, @{$hJob->{rParam}}[7], MANIFEST_SUBKEY_PAGE_DELTA_BASE,\n"
+            "$oFullManifest->get(MANIFEST_SECTION_BACKUP, MANIFEST_KEY_LABEL));\n"
+            "$oBackupManifest->set(\n"
+            "MANIFEST_SECTION_TARGET_FILE, @{$hJob->{rParam}}[7], MANIFEST_SUBKEY_PAGE_DELTA_BASE_COMPRESS_TYPE,\n"
+            "defined($oFullManifest->compressType()) ? $oFullManifest->compressType() : COMPRESS_TYPE_NONE);\n"
+            "}\n"
             "}\n"
             "\n\n\n"
             "protocolKeepAlive();\n"
@@ -1275,8 +1305,8 @@ static const EmbeddedModule embeddedModule[] =
             "&log(DETAIL, \"hardlink ${strFile} to ${strReference}\");\n"
             "\n"
             "storageRepo()->linkCreate(\n"
-            "STORAGE_REPO_BACKUP . \"/${strReference}/${strFile}\" . ($bCompress ? qw{.} . COMPRESS_EXT : ''),\n"
-            "STORAGE_REPO_BACKUP . \"/${strBackupLabel}/${strFile}\" . ($bCompress ? qw{.} . COMPRESS_EXT : ''),\n"
+            "STORAGE_REPO_BACKUP . \"/${strReference}/${strFile}\" . compressExt($strCompressType),\n"
+            "STORAGE_REPO_BACKUP . \"/${strBackupLabel}/${strFile}\" . compressExt($strCompressType),\n"
             "{bHard => true});\n"
             "}\n"
             "\n\n"
@@ -1308,6 +1338,8 @@ static const EmbeddedModule embeddedModule[] =
             "\n\n"
             "my $strType = cfgOption(CFGOPT_TYPE);\n"
             "my $bCompress = cfgOption(CFGOPT_COMPRESS);\n"
+            "my $strCompressType = cfgOption(CFGOPT_COMPRESS_TYPE);\n"
+            "my $iCompressLevel = cfgOption(CFGOPT_COMPRESS_LEVEL);\n"
             "my $bHardLink = cfgOption(CFGOPT_REPO_HARDLINK);\n"
             "\n\n"
             "my $oBackupInfo = new pgBackRest::Backup::Info($oStorageRepo->pathGet(STORAGE_REPO_BACKUP));\n"
@@ -1375,6 +1407,24 @@ static const EmbeddedModule embeddedModule[] =
             "$bCompress = $oLastManifest->boolGet(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_COMPRESS);\n"
             "}\n"
             "\n\n"
+            "if ($bCompress && $oLastManifest->compressType() ne $strCompressType)\n"
+            "{\n"
+            "&log(WARN, \"${strType} backup cannot alter compress-type option to '${strCompressType}'\" .\n"
+            "\", reset to value in ${strBackupLastPath}\");\n"
+            "$strCompressType = $oLastManifest->compressType();\n"
+            "\n\n"
+            "if (cfgOptionSource(CFGOPT_COMPRESS_LEVEL) eq CFGDEF_SOURCE_DEFAULT)\n"
+            "{\n"
+            "$iCompressLevel = compressLevelDefault($strCompressType);\n"
+            "}\n"
+            "elsif (!compressLevelValid($strCompressType, $iCompressLevel))\n"
+            "{\n"
+            "&log(WARN, \"compress-level option '${iCompressLevel}' is not valid for compress-type '${strCompressType}'\" .\n"
+            "\", reset to default '\" . compressLevelDefault($strCompressType) . \"'\");\n"
+            "$iCompressLevel = compressLevelDefault($strCompressType);\n"
+            "}\n"
+            "}\n"
+            "\n\n"
             "if (!$oLastManifest->boolTest(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_HARDLINK, undef, $bHardLink))\n"
             "{\n"
             "&log(WARN, \"${strType} backup cannot alter hardlink option to '\" . boolFormat($bHardLink) .\n"
@@ -1458,6 +1508,13 @@ static const EmbeddedModule embeddedModule[] =
             "$strValueAborted = $oAbortedManifest->boolGet(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_COMPRESS);\n"
             "}\n"
             "\n"
+            "elsif (cfgOption(CFGOPT_COMPRESS) && $oAbortedManifest->compressType() ne cfgOption(CFGOPT_COMPRESS_TYPE))\n"
+            "{\n"
+            "$strKey = MANIFEST_KEY_COMPRESS_TYPE;\n"
+            "$strValueNew = cfgOption(CFGOPT_COMPRESS_TYPE);\n"
+            "$strValueAborted = $oAbortedManifest->compressType();\n"
+            "}\n"
+            "\n"
             "elsif ($oAbortedManifest->boolGet(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_HARDLINK) !=\n"
             "cfgOption(CFGOPT_REPO_HARDLINK))\n"
             "{\n"
@@ -1536,8 +1593,18 @@ static const EmbeddedModule embeddedModule[] =
             "$oBackupManifest->boolSet(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_BACKUP_STANDBY, undef, cfgOption(CFGOPT_BACKUP_STANDBY));\n"
             "$oBackupManifest->numericSet(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_BUFFER_SIZE, undef, cfgOption(CFGOPT_BUFFER_SIZE));\n"
             "$oBackupManifest->boolSet(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_COMPRESS, undef, $bCompress);\n"
+            "\n\n"
+            "if (!$bCompress)\n"
+            "{\n"
+            "$strCompressType = undef;\n"
+            "}\n"
+            "elsif ($strCompressType ne CFGOPTVAL_COMPRESS_TYPE_GZ)\n"
+            "{\n"
+            "$oBackupManifest->set(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_COMPRESS_TYPE, undef, $strCompressType);\n"
+            "}\n"
+            "\n"
             "$oBackupManifest->numericSet(\n"
-            "MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_COMPRESS_LEVEL, undef, cfgOption(CFGOPT_COMPRESS_LEVEL));\n"
+            "MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_COMPRESS_LEVEL, undef, $iCompressLevel);\n"
             "$oBackupManifest->numericSet(\n"
             "MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_COMPRESS_LEVEL_NETWORK, undef, cfgOption(CFGOPT_COMPRESS_LEVEL_NETWORK));\n"
             "$oBackupManifest->boolSet(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_HARDLINK, undef, $bHardLink);\n"
@@ -1651,6 +1718,26 @@ static const EmbeddedModule embeddedModule[] =
             "}\n"
             "}\n"
             "}\n"
+            "\n\n\n"
+            "my $oFullManifest;\n"
+            "\n"
+            "if (cfgOption(CFGOPT_PAGE_DELTA) && $strType ne CFGOPTVAL_BACKUP_TYPE_FULL && defined($strBackupLastPath))\n"
+            "{\n"
+            "my $strBackupFullPath = (split('_', $strBackupLastPath))[0];\n"
+            "\n"
+            "$oFullManifest = $strBackupFullPath eq $strBackupLastPath ? $oLastManifest : new pgBackRest::Manifest(\n"
+            "$oStorageRepo->pathGet(STORAGE_REPO_BACKUP . \"/${strBackupFullPath}/\" . FILE_MANIFEST),\n"
+            "{strCipherPass => $strCipherPassManifest});\n"
+            "\n"
+            "if (!$oFullManifest->test(MANIFEST_SECTION_BACKUP, MANIFEST_KEY_LSN_START))\n"
+            "{\n"
+            "&log(WARN,\n"
+            "\"${strType} backup cannot use '\" . cfgOptionName(CFGOPT_PAGE_DELTA) . \"' option since full backup\" .\n"
+            "\" ${strBackupFullPath} has no start lsn, reset to 'n'\");\n"
+            "cfgOptionSet(CFGOPT_PAGE_DELTA, false);\n"
+            "undef($oFullManifest);\n"
+            "}\n"
+            "}\n"
             "\n\n"
             "$oBackupManifest->boolSet(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_CHECKSUM_PAGE, undef, cfgOption(CFGOPT_CHECKSUM_PAGE));\n"
             "\n\n"
@@ -1681,8 +1768,8 @@ static const EmbeddedModule embeddedModule[] =
             "\n\n"
             "my $lBackupSizeTotal =\n"
             "$self->processManifest(\n"
-            "$strDbMasterPath, $strDbCopyPath, $strType, $strDbVersion, $bCompress, $bHardLink, $oBackupManifest, $strBackupLabel,\n"
-            "$strLsnStart);\n"
+            "$strDbMasterPath, $strDbCopyPath, $strType, $strDbVersion, $strCompressType, $iCompressLevel, $bHardLink,\n"
+            "$oBackupManifest, $strBackupLabel, $strLsnStart, $oFullManifest);\n"
             "&log(INFO, \"${strType} backup size = \" . fileSizeFormat($lBackupSizeTotal));\n"
             "\n\n"
             "undef($oStorageDbMaster);\n"
@@ -1705,15 +1792,16 @@ static const EmbeddedModule embeddedModule[] =
             "{\n"
             "my $rhyFilter = [{strClass => STORAGE_FILTER_SHA}];\n"
             "\n\n"
-            "if ($bCompress)\n"
+            "if (defined($strCompressType))\n"
             "{\n"
             "push(\n"
             "@{$rhyFilter},\n"
-            "{strClass => STORAGE_FILTER_GZIP, rxyParam => [STORAGE_COMPRESS, false, cfgOption(CFGOPT_COMPRESS_LEVEL)]});\n"
+            "{strClass => STORAGE_FILTER_COMPRESS,\n"
+            "rxyParam => [STORAGE_COMPRESS, $strCompressType, $iCompressLevel]});\n"
             "}\n"
             "\n\n\n"
             "my $oDestinationFileIo = $oStorageRepo->openWrite(\n"
-            "STORAGE_REPO_BACKUP . \"/${strBackupLabel}/${strFile}\" . ($bCompress ? qw{.} . COMPRESS_EXT : ''),\n"
+            "STORAGE_REPO_BACKUP . \"/${strBackupLabel}/${strFile}\" . compressExt($strCompressType),\n"
             "{rhyFilter => $rhyFilter,\n"
             "strCipherPass => defined($strCipherPassBackupSet) ? $strCipherPassBackupSet : undef});\n"
             "\n\n"
@@ -1755,14 +1843,36 @@ static const EmbeddedModule embeddedModule[] =
             "if (cfgOption(CFGOPT_ARCHIVE_COPY))\n"
             "{\n"
             "logDebugMisc($strOperation, \"archive: ${strArchive} (${strArchiveFile})\");\n"
-            "\n\n"
-            "my $bArchiveCompressed = $strArchiveFile =~ ('^.*\\.' . COMPRESS_EXT . '\\$');\n"
+            "\n\n\n"
+            "my $strArchiveCompressType = compressTypeFromName($strArchiveFile);\n"
+            "my $rhyFilter;\n"
+            "\n"
+            "if ((defined($strArchiveCompressType) ? $strArchiveCompressType : '') ne\n"
+            "(defined($strCompressType) ? $strCompressType : ''))\n"
+            "{\n"
+            "$rhyFilter = [];\n"
+            "\n"
+            "if (defined($strArchiveCompressType))\n"
+            "{\n"
+            "push(\n"
+            "@{$rhyFilter},\n"
+            "{strClass => STORAGE_FILTER_COMPRESS, rxyParam => [STORAGE_DECOMPRESS, $strArchiveCompressType]});\n"
+            "}\n"
+            "\n"
+            "if (defined($strCompressType))\n"
+            "{\n"
+            "push(\n"
+            "@{$rhyFilter},\n"
+            "{strClass => STORAGE_FILTER_COMPRESS,\n"
+            "rxyParam => [STORAGE_COMPRESS, $strCompressType, $iCompressLevel]});\n"
+            "}\n"
+            "}\n"
             "\n"
             "$oStorageRepo->copy(\n"
             "$oStorageRepo->openRead(STORAGE_REPO_ARCHIVE . \"/${strArchiveId}/${strArchiveFile}\",\n"
-            "{strCipherPass => $oArchiveInfo->cipherPassSub()}),\n"
+            "{rhyFilter => $rhyFilter, strCipherPass => $oArchiveInfo->cipherPassSub()}),\n"
             "$oStorageRepo->openWrite(STORAGE_REPO_BACKUP . \"/${strBackupLabel}/\" . MANIFEST_TARGET_PGDATA . qw{/} .\n"
-            "$oBackupManifest->walPath() . \"/${strArchive}\" . ($bCompress ? qw{.} . COMPRESS_EXT : ''),\n"
+            "$oBackupManifest->walPath() . \"/${strArchive}\" . compressExt($strCompressType),\n"
             "{bPathCreate => true, strCipherPass => $strCipherPassBackupSet})\n"
             ");\n"
             "\n\n"
@@ -2185,10 +2295,12 @@ static const EmbeddedModule embeddedModule[] =
             "{\n"
             "$oManifest->set(MANIFEST_SECTION_TARGET_FILE, $strRepoFile, MANIFEST_SUBKEY_CHECKSUM, $strChecksumCopy);\n"
             "}\n"
-            "\n\n"
+            "\n\n\n"
             "if ($iCopyResult == BACKUP_FILE_COPY || $iCopyResult == BACKUP_FILE_RECOPY)\n"
             "{\n"
             "$oManifest->remove(MANIFEST_SECTION_TARGET_FILE, $strRepoFile, MANIFEST_SUBKEY_REFERENCE);\n"
+            "$oManifest->remove(MANIFEST_SECTION_TARGET_FILE, $strRepoFile, MANIFEST_SUBKEY_PAGE_DELTA_BASE);\n"
+            "$oManifest->remove(MANIFEST_SECTION_TARGET_FILE, $strRepoFile, MANIFEST_SUBKEY_PAGE_DELTA_BASE_COMPRESS_TYPE);\n"
             "}\n"
             "\n\n"
             "if ($bChecksumPage)\n"
@@ -2713,6 +2825,14 @@ static const EmbeddedModule embeddedModule[] =
             "$lBackupSizeDelta += $lFileSize;\n"
             "$lBackupRepoSizeDelta += $lRepoSize;\n"
             "}\n"
+            "\n\n"
+            "my $strFilePageDeltaBase =\n"
+            "$oBackupManifest->get(MANIFEST_SECTION_TARGET_FILE, $strFileKey, MANIFEST_SUBKEY_PAGE_DELTA_BASE, false);\n"
+            "\n"
+            "if (defined($strFilePageDeltaBase))\n"
+            "{\n"
+            "$$oReferenceHash{$strFilePageDeltaBase} = true;\n"
+            "}\n"
             "}\n"
             "\n\n"
             "$self->numericSet(INFO_BACKUP_SECTION_BACKUP_CURRENT, $strBackupLabel, INFO_BACKUP_KEY_BACKUP_SIZE, $lBackupSize);\n"
@@ -7819,11 +7939,16 @@ static const EmbeddedModule embeddedModule[] =
             "{\n"
             "return\n"
             "{\n"
+            "CFGOPTVAL_COMPRESS_TYPE_GZ                                       => 'gz',\n"
+            "CFGOPTVAL_COMPRESS_TYPE_LZ4                                      => 'lz4',\n"
+            "CFGOPTVAL_COMPRESS_TYPE_ZST                                      => 'zst',\n"
+            "\n"
             "CFGOPTVAL_INFO_OUTPUT_TEXT                                       => 'text',\n"
             "CFGOPTVAL_INFO_OUTPUT_JSON                                       => 'json',\n"
             "\n"
             "CFGOPTVAL_REPO_CIPHER_TYPE_NONE                                  => 'none',\n"
             "CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_CBC                           => 'aes-256-cbc',\n"
+            "CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_GCM                           => 'aes-256-gcm',\n"
             "\n"
             "CFGOPTVAL_REPO_RETENTION_ARCHIVE_TYPE_FULL                       => 'full',\n"
             "CFGOPTVAL_REPO_RETENTION_ARCHIVE_TYPE_DIFF                       => 'diff',\n"
@@ -7885,10 +8010,14 @@ static const EmbeddedModule embeddedModule[] =
             "\n"
             "config =>\n"
             "[\n"
+            "'CFGOPTVAL_COMPRESS_TYPE_GZ',\n"
+            "'CFGOPTVAL_COMPRESS_TYPE_LZ4',\n"
+            "'CFGOPTVAL_COMPRESS_TYPE_ZST',\n"
             "'CFGOPTVAL_INFO_OUTPUT_TEXT',\n"
             "'CFGOPTVAL_INFO_OUTPUT_JSON',\n"
             "'CFGOPTVAL_REPO_CIPHER_TYPE_NONE',\n"
             "'CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_CBC',\n"
+            "'CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_GCM',\n"
             "'CFGOPTVAL_REPO_RETENTION_ARCHIVE_TYPE_FULL',\n"
             "'CFGOPTVAL_REPO_RETENTION_ARCHIVE_TYPE_DIFF',\n"
             "'CFGOPTVAL_REPO_RETENTION_ARCHIVE_TYPE_INCR',\n"
@@ -7937,17 +8066,22 @@ static const EmbeddedModule embeddedModule[] =
             "'CFGOPT_ARCHIVE_CHECK',\n"
             "'CFGOPT_ARCHIVE_COPY',\n"
             "'CFGOPT_ARCHIVE_GET_QUEUE_MAX',\n"
+            "'CFGOPT_ARCHIVE_GET_STREAM',\n"
             "'CFGOPT_ARCHIVE_PUSH_QUEUE_MAX',\n"
+            "'CFGOPT_ARCHIVE_PUSH_STREAM',\n"
             "'CFGOPT_ARCHIVE_TIMEOUT',\n"
             "'CFGOPT_BACKUP_STANDBY',\n"
             "'CFGOPT_BUFFER_SIZE',\n"
             "'CFGOPT_C',\n"
             "'CFGOPT_CHECKSUM_PAGE',\n"
+            "'CFGOPT_CIPHER_THREAD',\n"
             "'CFGOPT_CMD_SSH',\n"
             "'CFGOPT_COMMAND',\n"
             "'CFGOPT_COMPRESS',\n"
             "'CFGOPT_COMPRESS_LEVEL',\n"
             "'CFGOPT_COMPRESS_LEVEL_NETWORK',\n"
+            "'CFGOPT_COMPRESS_THREAD',\n"
+            "'CFGOPT_COMPRESS_TYPE',\n"
             "'CFGOPT_CONFIG',\n"
             "'CFGOPT_CONFIG_INCLUDE_PATH',\n"
             "'CFGOPT_CONFIG_PATH',\n"
@@ -7956,6 +8090,7 @@ static const EmbeddedModule embeddedModule[] =
             "'CFGOPT_DELTA',\n"
             "'CFGOPT_EXCLUDE',\n"
             "'CFGOPT_FILTER',\n"
+            "'CFGOPT_FILTER_THREAD',\n"
             "'CFGOPT_FORCE',\n"
             "'CFGOPT_HOST_ID',\n"
             "'CFGOPT_LINK_ALL',\n"
@@ -7971,6 +8106,7 @@ static const EmbeddedModule embeddedModule[] =
             "'CFGOPT_NEUTRAL_UMASK',\n"
             "'CFGOPT_ONLINE',\n"
             "'CFGOPT_OUTPUT',\n"
+            "'CFGOPT_PAGE_DELTA',\n"
             "'CFGOPT_PERL_OPTION',\n"
             "'CFGOPT_PG_HOST',\n"
             "'CFGOPT_PG_HOST2',\n"
@@ -8054,6 +8190,7 @@ static const EmbeddedModule embeddedModule[] =
             "'CFGOPT_PG_SOCKET_PATH8',\n"
             "'CFGOPT_PROCESS',\n"
             "'CFGOPT_PROCESS_MAX',\n"
+            "'CFGOPT_PROTOCOL_PIPELINE',\n"
             "'CFGOPT_PROTOCOL_TIMEOUT',\n"
             "'CFGOPT_RECOVERY_OPTION',\n"
             "'CFGOPT_REPO_CIPHER_PASS',\n"
@@ -8074,6 +8211,7 @@ static const EmbeddedModule embeddedModule[] =
             "'CFGOPT_REPO_S3_BUCKET',\n"
             "'CFGOPT_REPO_S3_CA_FILE',\n"
             "'CFGOPT_REPO_S3_CA_PATH',\n"
+            "'CFGOPT_REPO_S3_DOWNLOAD_MAX',\n"
             "'CFGOPT_REPO_S3_ENDPOINT',\n"
             "'CFGOPT_REPO_S3_HOST',\n"
             "'CFGOPT_REPO_S3_KEY',\n"
@@ -8081,6 +8219,7 @@ static const EmbeddedModule embeddedModule[] =
             "'CFGOPT_REPO_S3_PORT',\n"
             "'CFGOPT_REPO_S3_REGION',\n"
             "'CFGOPT_REPO_S3_TOKEN',\n"
+            "'CFGOPT_REPO_S3_UPLOAD_MAX',\n"
             "'CFGOPT_REPO_S3_VERIFY_TLS',\n"
             "'CFGOPT_REPO_TYPE',\n"
             "'CFGOPT_RESUME',\n"
@@ -8500,6 +8639,8 @@ static const EmbeddedModule embeddedModule[] =
             "push @EXPORT, qw(MANIFEST_KEY_COMPRESS_LEVEL);\n"
             "use constant MANIFEST_KEY_COMPRESS_LEVEL_NETWORK => 'option-' . cfgOptionName(CFGOPT_COMPRESS_LEVEL_NETWORK);\n"
             "push @EXPORT, qw(MANIFEST_KEY_COMPRESS_LEVEL_NETWORK);\n"
+            "use constant MANIFEST_KEY_COMPRESS_TYPE => 'option-' . cfgOptionName(CFGOPT_COMPRESS_TYPE);\n"
+            "push @EXPORT, qw(MANIFEST_KEY_COMPRESS_TYPE);\n"
             "use constant MANIFEST_KEY_ONLINE => 'option-' . cfgOptionName(CFGOPT_ONLINE);\n"
             "push @EXPORT, qw(MANIFEST_KEY_ONLINE);\n"
             "use constant MANIFEST_KEY_DELTA => 'option-' . cfgOptionName(CFGOPT_DELTA);\n"
@@ -8538,6 +8679,10 @@ static const EmbeddedModule embeddedModule[] =
             "push @EXPORT, qw(MANIFEST_SUBKEY_MASTER);\n"
             "use constant MANIFEST_SUBKEY_MODE => 'mode';\n"
             "push @EXPORT, qw(MANIFEST_SUBKEY_MODE);\n"
+            "use constant MANIFEST_SUBKEY_PAGE_DELTA_BASE => 'page-delta-base';\n"
+            "push @EXPORT, qw(MANIFEST_SUBKEY_PAGE_DELTA_BASE);\n"
+            "use constant MANIFEST_SUBKEY_PAGE_DELTA_BASE_COMPRESS_TYPE => 'page-delta-base-compress-type';\n"
+            "push @EXPORT, qw(MANIFEST_SUBKEY_PAGE_DELTA_BASE_COMPRESS_TYPE);\n"
             "use constant MANIFEST_SUBKEY_TIMESTAMP => 'timestamp';\n"
             "push @EXPORT, qw(MANIFEST_SUBKEY_TIMESTAMP);\n"
             "use constant MANIFEST_SUBKEY_TYPE => 'type';\n"
@@ -9094,7 +9239,9 @@ static const EmbeddedModule embeddedModule[] =
             "$strPath = $oStorageDbMaster->pathAbsolute($strParentPath, $strPath);\n"
             "}\n"
             "\n\n"
-            "my $hManifest = $oStorageDbMaster->manifest($strPath, {strFilter => $strFilter});\n"
+            "my $hManifest = $oStorageDbMaster->manifest(\n"
+            "$strPath,\n"
+            "{strFilter => $strFilter, iThreadMax => cfgOptionValid(CFGOPT_PROCESS_MAX) ? cfgOption(CFGOPT_PROCESS_MAX) : 1});\n"
             "my $strManifestType = MANIFEST_VALUE_LINK;\n"
             "\n\n"
             "foreach my $strName (sort(CORE::keys(%{$hManifest})))\n"
@@ -9412,6 +9559,17 @@ static const EmbeddedModule embeddedModule[] =
             "$oLastManifest->get(MANIFEST_SECTION_TARGET_FILE, $strName, MANIFEST_SUBKEY_MASTER));\n"
             "}\n"
             "\n\n"
+            "if ($oLastManifest->test(MANIFEST_SECTION_TARGET_FILE, $strName, MANIFEST_SUBKEY_PAGE_DELTA_BASE))\n"
+            "{\n"
+            "$self->set(\n"
+            "MANIFEST_SECTION_TARGET_FILE, $strName, MANIFEST_SUBKEY_PAGE_DELTA_BASE,\n"
+            "$oLastManifest->get(MANIFEST_SECTION_TARGET_FILE, $strName, MANIFEST_SUBKEY_PAGE_DELTA_BASE));\n"
+            "$self->set(\n"
+            "MANIFEST_SECTION_TARGET_FILE, $strName, MANIFEST_SUBKEY_PAGE_DELTA_BASE_COMPRESS_TYPE,\n"
+            "$oLastManifest->get(\n"
+            "MANIFEST_SECTION_TARGET_FILE, $strName, MANIFEST_SUBKEY_PAGE_DELTA_BASE_COMPRESS_TYPE));\n"
+            "}\n"
+            "\n\n"
             "my $bChecksumPage = $oLastManifest->get(\n"
             "MANIFEST_SECTION_TARGET_FILE, $strName, MANIFEST_SUBKEY_CHECKSUM_PAGE, false);\n"
             "\n"
@@ -9641,6 +9799,14 @@ static const EmbeddedModule embeddedModule[] =
             "\n"
             "return $self->get(MANIFEST_SECTION_BACKUP_DB, MANIFEST_KEY_DB_VERSION);\n"
             "}\n"
+            "\n\n\n\n\n\n\n"
+            "sub compressType\n"
+            "{\n"
+            "my $self = shift;\n"
+            "\n"
+            "return $self->boolGet(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_COMPRESS) ?\n"
+            "$self->get(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_COMPRESS_TYPE, undef, false, CFGOPTVAL_COMPRESS_TYPE_GZ) : undef;\n"
+            "}\n"
             "\n\n\n\n"
             "sub xactPath\n"
             "{\n"
@@ -13216,7 +13382,12 @@ static const EmbeddedModule embeddedModule[] =
             "$oManifest->get(MANIFEST_SECTION_TARGET_FILE, $strRepoFile, MANIFEST_SUBKEY_USER),\n"
             "$oManifest->get(MANIFEST_SECTION_TARGET_FILE, $strRepoFile, MANIFEST_SUBKEY_GROUP),\n"
             "$oManifest->numericGet(MANIFEST_SECTION_BACKUP, MANIFEST_KEY_TIMESTAMP_COPY_START),  cfgOption(CFGOPT_DELTA),\n"
-            "$self->{strBackupSet}, $oManifest->boolGet(MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_COMPRESS)],\n"
+            "$self->{strBackupSet},\n"
+            "defined($oManifest->compressType()) ? $oManifest->compressType() : COMPRESS_TYPE_NONE,\n"
+            "$oManifest->get(MANIFEST_SECTION_TARGET_FILE, $strRepoFile, MANIFEST_SUBKEY_PAGE_DELTA_BASE, false),\n"
+            "$oManifest->get(\n"
+            "MANIFEST_SECTION_TARGET_FILE, $strRepoFile, MANIFEST_SUBKEY_PAGE_DELTA_BASE_COMPRESS_TYPE, false,\n"
+            "COMPRESS_TYPE_NONE)],\n"
             "{rParamSecure => $oManifest->cipherPassSub() ? [$oManifest->cipherPassSub()] : undef});\n"
             "}\n"
             "\n\n"
@@ -13400,9 +13571,13 @@ static const EmbeddedModule embeddedModule[] =
             "push @EXPORT, qw(STORAGE_DECRYPT);\n"
             "use constant CIPHER_MAGIC => 'Salted__';\n"
             "push @EXPORT, qw(CIPHER_MAGIC);\n"
+            "use constant CIPHER_CHUNK_MAGIC => 'PGBRCHK1';\n"
+            "push @EXPORT, qw(CIPHER_CHUNK_MAGIC);\n"
             "\n\n\n\n"
             "use constant STORAGE_FILTER_CIPHER_BLOCK => 'pgBackRest::Storage::Filter::CipherBlock';\n"
             "push @EXPORT, qw(STORAGE_FILTER_CIPHER_BLOCK);\n"
+            "use constant STORAGE_FILTER_COMPRESS => 'pgBackRest::Storage::Filter::Compress';\n"
+            "push @EXPORT, qw(STORAGE_FILTER_COMPRESS);\n"
             "use constant STORAGE_FILTER_GZIP => 'pgBackRest::Storage::Filter::Gzip';\n"
             "push @EXPORT, qw(STORAGE_FILTER_GZIP);\n"
             "use constant STORAGE_FILTER_SHA => 'pgBackRest::Storage::Filter::Sha';\n"
@@ -13682,6 +13857,12 @@ static const EmbeddedModule embeddedModule[] =
             "\n\n\n\n"
             "use constant COMPRESS_EXT => 'gz';\n"
             "push @EXPORT, qw(COMPRESS_EXT);\n"
+            "\n\n"
+            "use constant COMPRESS_EXT_REGEXP => '(\\\\.(gz|lz4|zst)){0,1}';\n"
+            "push @EXPORT, qw(COMPRESS_EXT_REGEXP);\n"
+            "\n\n"
+            "use constant COMPRESS_TYPE_NONE => 'none';\n"
+            "push @EXPORT, qw(COMPRESS_TYPE_NONE);\n"
             "\n\n\n\n"
             "use constant STORAGE_TEMP_EXT => PROJECT_EXE . '.tmp';\n"
             "push @EXPORT, qw(STORAGE_TEMP_EXT);\n"
@@ -13699,6 +13880,52 @@ static const EmbeddedModule embeddedModule[] =
             "}\n"
             "\n"
             "push @EXPORT, qw(storageLocal);\n"
+            "\n\n\n\n"
+            "sub compressExt\n"
+            "{\n"
+            "my $strCompressType = shift;\n"
+            "\n"
+            "return defined($strCompressType) ? \".${strCompressType}\" : '';\n"
+            "}\n"
+            "\n"
+            "push @EXPORT, qw(compressExt);\n"
+            "\n\n\n\n"
+            "sub compressTypeFromName\n"
+            "{\n"
+            "my $strFile = shift;\n"
+            "\n"
+            "return $strFile =~ /\\.(gz|lz4|zst)$/ ? $1 : undef;\n"
+            "}\n"
+            "\n"
+            "push @EXPORT, qw(compressTypeFromName);\n"
+            "\n\n\n\n"
+            "my $rhCompressLevel =\n"
+            "{\n"
+            "gz => {iMin => 0, iMax => 9, iDefault => 6},\n"
+            "lz4 => {iMin => -5, iMax => 12, iDefault => 1},\n"
+            "zst => {iMin => -5, iMax => 22, iDefault => 3},\n"
+            "};\n"
+            "\n"
+            "sub compressLevelDefault\n"
+            "{\n"
+            "my $strCompressType = shift;\n"
+            "\n"
+            "return $rhCompressLevel->{$strCompressType}{iDefault};\n"
+            "}\n"
+            "\n"
+            "push @EXPORT, qw(compressLevelDefault);\n"
+            "\n"
+            "sub compressLevelValid\n"
+            "{\n"
+            "my $strCompressType = shift;\n"
+            "my $iCompressLevel = shift;\n"
+            "\n"
+            "return\n"
+            "$iCompressLevel >= $rhCompressLevel->{$strCompressType}{iMin} &&\n"
+            "$iCompressLevel <= $rhCompressLevel->{$strCompressType}{iMax} ? true : false;\n"
+            "}\n"
+            "\n"
+            "push @EXPORT, qw(compressLevelValid);\n"
             "\n"
             "1;\n"
     },
@@ -14037,15 +14264,17 @@ static const EmbeddedModule embeddedModule[] =
             "$strOperation,\n"
             "$strPathExp,\n"
             "$strFilter,\n"
+            "$iThreadMax,\n"
             ") =\n"
             "logDebugParam\n"
             "(\n"
             "__PACKAGE__ . '->manifest', \\@_,\n"
             "{name => 'strPathExp'},\n"
             "{name => 'strFilter', optional => true, trace => true},\n"
+            "{name => 'iThreadMax', optional => true, default => 1, trace => true},\n"
             ");\n"
             "\n"
-            "my $hManifest = $self->{oJSON}->decode($self->{oStorageC}->manifest($strPathExp, $strFilter));\n"
+            "my $hManifest = $self->{oJSON}->decode($self->{oStorageC}->manifest($strPathExp, $strFilter, $iThreadMax));\n"
             "\n\n"
             "return logDebugReturn\n"
             "(\n"
@@ -14530,7 +14759,8 @@ static const EmbeddedModule embeddedModule[] =
             "my $lSizeRead = $oFileIo->read(\\$tMagicSignature, length(CIPHER_MAGIC));\n"
             "$oFileIo->close();\n"
             "\n"
-            "if (substr($tMagicSignature, 0, length(CIPHER_MAGIC)) eq CIPHER_MAGIC)\n"
+            "if (substr($tMagicSignature, 0, length(CIPHER_MAGIC)) eq CIPHER_MAGIC ||\n"
+            "substr($tMagicSignature, 0, length(CIPHER_CHUNK_MAGIC)) eq CIPHER_CHUNK_MAGIC)\n"
             "{\n"
             "$bEncrypted = true;\n"
             "}\n"
@@ -918,7 +918,7 @@ XS_EUPXS(XS_pgBackRest__LibC__Storage_bucketCreate)
 			"self", "pgBackRest::LibC::Storage")
 ;
     if (strEq(storageType(self), STORAGE_S3_TYPE_STR))
-        storageS3Request((StorageS3 *)storageDriver(self), HTTP_VERB_PUT_STR, FSLASH_STR, NULL, NULL, true, false);
+        storageS3Request((StorageS3 *)storageDriver(self), HTTP_VERB_PUT_STR, FSLASH_STR, NULL, NULL, NULL, true, false);
     else
         THROW_FMT(AssertError, "unable to create bucket on '%s' storage", strPtr(storageType(self)));
     }
@@ -1129,14 +1129,15 @@ XS_EUPXS(XS_pgBackRest__LibC__Storage_manifest); /* prototype to pass -Wmissing-
 XS_EUPXS(XS_pgBackRest__LibC__Storage_manifest)
 {
     dVAR; dXSARGS;
-    if (items < 2 || items > 3)
-       croak_xs_usage(cv,  "self, pathExp, filter=NULL");
+    if (items < 2 || items > 4)
+       croak_xs_usage(cv,  "self, pathExp, filter=NULL, threadMax=1");
     {
     MEM_CONTEXT_XS_TEMP_BEGIN()
     {
 	pgBackRest__LibC__Storage	self;
 	const String *	pathExp = STR_NEW_SV(ST(1));
 	const String *	filter = STR_NEW_SV(ST(2));
+	U32	threadMax;
 	SV *	RETVAL;
 
 	if (SvROK(ST(0)) && sv_derived_from(ST(0), "pgBackRest::LibC::Storage")) {
@@ -1148,12 +1149,27 @@ XS_EUPXS(XS_pgBackRest__LibC__Storage_manifest)
 			"pgBackRest::LibC::Storage::manifest",
 			"self", "pgBackRest::LibC::Storage")
 ;
+
+	if (items < 4)
+	    threadMax = 1;
+	else {
+	    threadMax = (unsigned long)SvUV(ST(3))
+;
+	}
     StorageManifestXsCallbackData data = {.storage = self, .json = strNew("{"), .pathRoot = pathExp, .filter = filter};
 
     // If a path is specified
     StorageInfo info = storageInfoP(self, pathExp, .ignoreMissing = true);
 
-    if (!info.exists || info.type == storageTypePath)
+    // Walk posix storage in parallel
+    if (strEq(storageType(self), STORAGE_POSIX_TYPE_STR) && (!info.exists || info.type == storageTypePath))
+    {
+        const String *path = storagePath(self, pathExp);
+
+        if (!storagePosixWalk(path, filter, threadMax, storageManifestXsWalkCallback, &data))
+            THROW_FMT(PathMissingError, STORAGE_ERROR_LIST_INFO_MISSING, strPtr(path));
+    }
+    else if (!info.exists || info.type == storageTypePath)
     {
         storageInfoListP(
             self, data.pathRoot, storageManifestXsCallback, &data,
@@ -218,6 +218,21 @@ pageLsn(const unsigned char *page)
     FUNCTION_TEST_RETURN((uint64_t)((PageHeader)page)->pd_lsn.walid << 32 | ((PageHeader)page)->pd_lsn.xrecoff);
 }
 
+/***********************************************************************************************************************************
+Is this a new page, i.e. allocated but never initialized?
+***********************************************************************************************************************************/
+bool
+pageNew(const unsigned char *page)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(UCHARDATA, page);
+    FUNCTION_TEST_END();
+
+    ASSERT(page != NULL);
+
+    FUNCTION_TEST_RETURN(((PageHeader)page)->pd_upper == 0);
+}
+
 /***********************************************************************************************************************************
 pageChecksumTest - test if checksum is valid for a single page
 ***********************************************************************************************************************************/
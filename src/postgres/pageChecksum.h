@@ -11,6 +11,7 @@ Functions
 ***********************************************************************************************************************************/
 uint16_t pageChecksum(const unsigned char *page, unsigned int blockNo, unsigned int pageSize);
 uint64_t pageLsn(const unsigned char *page);
+bool pageNew(const unsigned char *page);
 bool pageChecksumTest(
     const unsigned char *page, unsigned int blockNo, unsigned int pageSize, uint32_t ignoreWalId, uint32_t ignoreWalOffset);
 bool pageChecksumBufferTest(
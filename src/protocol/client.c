@@ -11,15 +11,18 @@ Protocol Client
 #include "common/type/json.h"
 #include "common/type/keyValue.h"
 #include "protocol/client.h"
+#include "protocol/frame.h"
 #include "version.h"
 
 /***********************************************************************************************************************************
 Constants
 ***********************************************************************************************************************************/
+STRING_EXTERN(PROTOCOL_GREETING_BINARY_STR,                         PROTOCOL_GREETING_BINARY);
 STRING_EXTERN(PROTOCOL_GREETING_NAME_STR,                           PROTOCOL_GREETING_NAME);
 STRING_EXTERN(PROTOCOL_GREETING_SERVICE_STR,                        PROTOCOL_GREETING_SERVICE);
 STRING_EXTERN(PROTOCOL_GREETING_VERSION_STR,                        PROTOCOL_GREETING_VERSION);
 
+STRING_EXTERN(PROTOCOL_COMMAND_BINARY_STR,                          PROTOCOL_COMMAND_BINARY);
 STRING_EXTERN(PROTOCOL_COMMAND_NOOP_STR,                            PROTOCOL_COMMAND_NOOP);
 STRING_EXTERN(PROTOCOL_COMMAND_EXIT_STR,                            PROTOCOL_COMMAND_EXIT);
 
@@ -39,6 +42,7 @@ struct ProtocolClient
     IoRead *read;
     IoWrite *write;
     TimeMSec keepAliveTime;
+    bool binary;                                                    // Are messages sent as binary frames rather than JSON?
 };
 
 OBJECT_DEFINE_FREE(PROTOCOL_CLIENT);
@@ -88,6 +92,8 @@ protocolClientNew(const String *name, const String *service, IoRead *read, IoWri
         this->keepAliveTime = timeMSec();
 
         // Read, parse, and check the protocol greeting
+        bool binaryAvailable = false;
+
         MEM_CONTEXT_TEMP_BEGIN()
         {
             String *greeting = ioReadLine(this->read);
@@ -120,12 +126,28 @@ protocolClientNew(const String *name, const String *service, IoRead *read, IoWri
                         strPtr(expectedKey), strPtr(varStr(actualValue)));
                 }
             }
+
+            // Only C servers advertise binary frames so the Perl side of the protocol will always use JSON
+            const Variant *binary = kvGet(greetingKv, VARSTR(PROTOCOL_GREETING_BINARY_STR));
+            binaryAvailable = binary != NULL && varType(binary) == varTypeBool && varBool(binary);
         }
         MEM_CONTEXT_TEMP_END();
 
         // Send one noop to catch any errors that might happen after the greeting
         protocolClientNoOp(this);
 
+        // Switch to binary frames if the server supports them.  The server acknowledges with JSON and then switches as well.
+        if (binaryAvailable)
+        {
+            MEM_CONTEXT_TEMP_BEGIN()
+            {
+                protocolClientExecute(this, protocolCommandNew(PROTOCOL_COMMAND_BINARY_STR), false);
+            }
+            MEM_CONTEXT_TEMP_END();
+
+            this->binary = true;
+        }
+
         // Set a callback to shutdown the protocol
         memContextCallbackSet(this->memContext, protocolClientFreeResource, this);
     }
@@ -149,19 +171,53 @@ protocolClientReadOutput(ProtocolClient *this, bool outputRequired)
 
     const Variant *result = NULL;
 
-    MEM_CONTEXT_TEMP_BEGIN()
+    MEM_CONTEXT_TEMP_ARENA_BEGIN()
     {
         // Read the response
-        String *response = ioReadLine(this->read);
-        KeyValue *responseKv = varKv(jsonToVar(response));
+        const Variant *error = NULL;
+        const String *message = NULL;
+        const String *stack = NULL;
+        KeyValue *responseKv = NULL;
 
-        // Process error if any
-        const Variant *error = kvGet(responseKv, VARSTR(PROTOCOL_ERROR_STR));
+        if (this->binary)
+        {
+            // The response is the error code (null if no error) followed by either the output or the error message and stack
+            Buffer *response = protocolFrameRead(this->read);
+            size_t position = 0;
 
+            error = protocolFrameGet(response, &position);
+
+            if (error != NULL)
+            {
+                message = varStr(protocolFrameGet(response, &position));
+                stack = varStr(protocolFrameGet(response, &position));
+            }
+            // Decode output directly into the calling context so it does not need to be copied
+            else
+            {
+                memContextSwitch(MEM_CONTEXT_OLD());
+                result = protocolFrameGet(response, &position);
+                memContextSwitch(MEM_CONTEXT_TEMP());
+            }
+        }
+        else
+        {
+            responseKv = varKv(jsonToVar(ioReadLine(this->read)));
+            error = kvGet(responseKv, VARSTR(PROTOCOL_ERROR_STR));
+
+            if (error != NULL)
+            {
+                message = varStr(kvGet(responseKv, VARSTR(PROTOCOL_OUTPUT_STR)));
+                stack = varStr(kvGet(responseKv, VARSTR(PROTOCOL_ERROR_STACK_STR)));
+            }
+            else
+                result = kvGet(responseKv, VARSTR(PROTOCOL_OUTPUT_STR));
+        }
+
+        // Process error if any
         if (error != NULL)
         {
             const ErrorType *type = errorTypeFromCode(varIntForce(error));
-            const String *message = varStr(kvGet(responseKv, VARSTR(PROTOCOL_OUTPUT_STR)));
 
             // Required part of the message
             String *throwMessage = strNewFmt(
@@ -170,8 +226,6 @@ protocolClientReadOutput(ProtocolClient *this, bool outputRequired)
             // Add stack trace if the error is an assertion or debug-level logging is enabled
             if (type == &AssertError || logAny(logLevelDebug))
             {
-                const String *stack = varStr(kvGet(responseKv, VARSTR(PROTOCOL_ERROR_STACK_STR)));
-
                 strCat(throwMessage, "\n");
                 strCat(throwMessage, stack == NULL ? "no stack trace available" : strPtr(stack));
             }
@@ -179,13 +233,11 @@ protocolClientReadOutput(ProtocolClient *this, bool outputRequired)
             THROWP(type, strPtr(throwMessage));
         }
 
-        // Get output
-        result = kvGet(responseKv, VARSTR(PROTOCOL_OUTPUT_STR));
-
         if (outputRequired)
         {
             // Just move the entire response kv since the output is the largest part if it
-            kvMove(responseKv, MEM_CONTEXT_OLD());
+            if (responseKv != NULL)
+                kvMove(responseKv, MEM_CONTEXT_OLD());
         }
         // Else if no output is required then there should not be any
         else if (result != NULL)
@@ -199,6 +251,25 @@ protocolClientReadOutput(ProtocolClient *this, bool outputRequired)
     FUNCTION_LOG_RETURN_CONST(VARIANT, result);
 }
 
+/***********************************************************************************************************************************
+Is the output of a command already buffered?
+
+If so the next protocolClientReadOutput() will not read from the handle, so callers waiting on the handle must check this first.
+JSON output is read a line at a time and more than one line may be buffered.  Binary frames are read using the exact size in the
+frame header so nothing past the current frame is buffered and the handle will report the next frame.
+***********************************************************************************************************************************/
+bool
+protocolClientReadReady(const ProtocolClient *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PROTOCOL_CLIENT, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->binary ? false : ioReadLineReady(this->read));
+}
+
 /***********************************************************************************************************************************
 Write the protocol command
 ***********************************************************************************************************************************/
@@ -214,8 +285,16 @@ protocolClientWriteCommand(ProtocolClient *this, const ProtocolCommand *command)
     ASSERT(command != NULL);
 
     // Write out the command
-    ioWriteStrLine(this->write, protocolCommandJson(command));
-    ioWriteFlush(this->write);
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        if (this->binary)
+            protocolFrameWrite(this->write, protocolCommandFrame(command));
+        else
+            ioWriteStrLine(this->write, protocolCommandJson(command));
+
+        ioWriteFlush(this->write);
+    }
+    MEM_CONTEXT_TEMP_END();
 
     // Reset the keep alive time
     this->keepAliveTime = timeMSec();
@@ -283,6 +362,21 @@ protocolClientNoOp(ProtocolClient *this)
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Are messages sent as binary frames?
+***********************************************************************************************************************************/
+bool
+protocolClientBinary(const ProtocolClient *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PROTOCOL_CLIENT, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->binary);
+}
+
 /***********************************************************************************************************************************
 Get read interface
 ***********************************************************************************************************************************/
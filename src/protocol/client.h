@@ -19,6 +19,8 @@ typedef struct ProtocolClient ProtocolClient;
 /***********************************************************************************************************************************
 Constants
 ***********************************************************************************************************************************/
+#define PROTOCOL_GREETING_BINARY                                    "binary"
+    STRING_DECLARE(PROTOCOL_GREETING_BINARY_STR);
 #define PROTOCOL_GREETING_NAME                                      "name"
     STRING_DECLARE(PROTOCOL_GREETING_NAME_STR);
 #define PROTOCOL_GREETING_SERVICE                                   "service"
@@ -26,6 +28,8 @@ Constants
 #define PROTOCOL_GREETING_VERSION                                   "version"
     STRING_DECLARE(PROTOCOL_GREETING_VERSION_STR);
 
+#define PROTOCOL_COMMAND_BINARY                                     "binary"
+    STRING_DECLARE(PROTOCOL_COMMAND_BINARY_STR);
 #define PROTOCOL_COMMAND_EXIT                                       "exit"
     STRING_DECLARE(PROTOCOL_COMMAND_EXIT_STR);
 #define PROTOCOL_COMMAND_NOOP                                       "noop"
@@ -51,11 +55,13 @@ const Variant *protocolClientExecute(ProtocolClient *this, const ProtocolCommand
 ProtocolClient *protocolClientMove(ProtocolClient *this, MemContext *parentNew);
 void protocolClientNoOp(ProtocolClient *this);
 const Variant *protocolClientReadOutput(ProtocolClient *this, bool outputRequired);
+bool protocolClientReadReady(const ProtocolClient *this);
 void protocolClientWriteCommand(ProtocolClient *this, const ProtocolCommand *command);
 
 /***********************************************************************************************************************************
 Getters
 ***********************************************************************************************************************************/
+bool protocolClientBinary(const ProtocolClient *this);
 IoRead *protocolClientIoRead(const ProtocolClient *this);
 IoWrite *protocolClientIoWrite(const ProtocolClient *this);
 
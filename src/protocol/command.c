@@ -10,6 +10,7 @@ Protocol Command
 #include "common/type/json.h"
 #include "common/type/keyValue.h"
 #include "protocol/command.h"
+#include "protocol/frame.h"
 
 /***********************************************************************************************************************************
 Constants
@@ -101,6 +102,27 @@ protocolCommandMove(ProtocolCommand *this, MemContext *parentNew)
     FUNCTION_TEST_RETURN(this);
 }
 
+/***********************************************************************************************************************************
+Get the command as a binary frame
+
+The command is encoded as the command name followed by the parameter list (or null when there are no parameters).
+***********************************************************************************************************************************/
+Buffer *
+protocolCommandFrame(const ProtocolCommand *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PROTOCOL_COMMAND, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    Buffer *result = protocolFrameNew();
+    protocolFramePut(result, VARSTR(this->command));
+    protocolFramePut(result, this->parameterList);
+
+    FUNCTION_TEST_RETURN(result);
+}
+
 /***********************************************************************************************************************************
 Get write interface
 ***********************************************************************************************************************************/
@@ -12,6 +12,7 @@ Object type
 
 typedef struct ProtocolCommand ProtocolCommand;
 
+#include "common/type/buffer.h"
 #include "common/type/variant.h"
 
 /***********************************************************************************************************************************
@@ -36,6 +37,7 @@ ProtocolCommand *protocolCommandParamAdd(ProtocolCommand *this, const Variant *p
 /***********************************************************************************************************************************
 Getters
 ***********************************************************************************************************************************/
+Buffer *protocolCommandFrame(const ProtocolCommand *this);
 String *protocolCommandJson(const ProtocolCommand *this);
 
 /***********************************************************************************************************************************
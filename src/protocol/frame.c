@@ -0,0 +1,484 @@
+/***********************************************************************************************************************************
+Protocol Binary Frame
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#include "common/debug.h"
+#include "common/log.h"
+#include "common/memContext.h"
+#include "common/type/keyValue.h"
+#include "common/type/variantList.h"
+#include "protocol/frame.h"
+
+/***********************************************************************************************************************************
+Frame header size and the default size of a new frame (the frame will grow as needed)
+***********************************************************************************************************************************/
+#define PROTOCOL_FRAME_HEADER_SIZE                                  4
+#define PROTOCOL_FRAME_SIZE_DEFAULT                                 256
+
+/***********************************************************************************************************************************
+Value types
+***********************************************************************************************************************************/
+typedef enum
+{
+    protocolFrameTypeNull = 0,
+    protocolFrameTypeBool = 1,
+    protocolFrameTypeInt = 2,
+    protocolFrameTypeUInt = 3,
+    protocolFrameTypeString = 4,
+    protocolFrameTypeList = 5,
+    protocolFrameTypeKeyValue = 6,
+} ProtocolFrameType;
+
+/***********************************************************************************************************************************
+Append raw data to the frame, doubling the frame size when it is full so large frames do not resize on every value
+***********************************************************************************************************************************/
+static void
+protocolFrameCat(Buffer *frame, const unsigned char *data, size_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BUFFER, frame);
+        FUNCTION_TEST_PARAM_P(UCHARDATA, data);
+        FUNCTION_TEST_PARAM(SIZE, size);
+    FUNCTION_TEST_END();
+
+    if (bufRemains(frame) < size)
+        bufResize(frame, bufSize(frame) * 2 > bufUsed(frame) + size ? bufSize(frame) * 2 : bufUsed(frame) + size);
+
+    bufCatC(frame, data, 0, size);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+static void
+protocolFrameCatU32(Buffer *frame, uint32_t value)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BUFFER, frame);
+        FUNCTION_TEST_PARAM(UINT32, value);
+    FUNCTION_TEST_END();
+
+    const unsigned char data[] =
+    {
+        (unsigned char)(value >> 24), (unsigned char)(value >> 16), (unsigned char)(value >> 8), (unsigned char)value,
+    };
+
+    protocolFrameCat(frame, data, sizeof(data));
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+static void
+protocolFrameCatU64(Buffer *frame, uint64_t value)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BUFFER, frame);
+        FUNCTION_TEST_PARAM(UINT64, value);
+    FUNCTION_TEST_END();
+
+    protocolFrameCatU32(frame, (uint32_t)(value >> 32));
+    protocolFrameCatU32(frame, (uint32_t)value);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+static void
+protocolFrameCatStr(Buffer *frame, const String *value)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BUFFER, frame);
+        FUNCTION_TEST_PARAM(STRING, value);
+    FUNCTION_TEST_END();
+
+    protocolFrameCatU32(frame, (uint32_t)strSize(value));
+    protocolFrameCat(frame, (const unsigned char *)strPtr(value), strSize(value));
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Get raw data from the frame and advance the position.  Error if the frame does not contain enough data.
+***********************************************************************************************************************************/
+static const unsigned char *
+protocolFrameData(const Buffer *frame, size_t *position, size_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BUFFER, frame);
+        FUNCTION_TEST_PARAM_P(SIZE, position);
+        FUNCTION_TEST_PARAM(SIZE, size);
+    FUNCTION_TEST_END();
+
+    if (bufUsed(frame) - *position < size)
+        THROW_FMT(ProtocolError, "frame is truncated at position %zu", *position);
+
+    const unsigned char *result = bufPtr(frame) + *position;
+    *position += size;
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+static uint32_t
+protocolFrameDataU32(const Buffer *frame, size_t *position)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BUFFER, frame);
+        FUNCTION_TEST_PARAM_P(SIZE, position);
+    FUNCTION_TEST_END();
+
+    const unsigned char *data = protocolFrameData(frame, position, 4);
+
+    FUNCTION_TEST_RETURN((uint32_t)data[0] << 24 | (uint32_t)data[1] << 16 | (uint32_t)data[2] << 8 | (uint32_t)data[3]);
+}
+
+static uint64_t
+protocolFrameDataU64(const Buffer *frame, size_t *position)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BUFFER, frame);
+        FUNCTION_TEST_PARAM_P(SIZE, position);
+    FUNCTION_TEST_END();
+
+    uint64_t result = (uint64_t)protocolFrameDataU32(frame, position) << 32;
+    result |= protocolFrameDataU32(frame, position);
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+static String *
+protocolFrameDataStr(const Buffer *frame, size_t *position)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BUFFER, frame);
+        FUNCTION_TEST_PARAM_P(SIZE, position);
+    FUNCTION_TEST_END();
+
+    size_t size = protocolFrameDataU32(frame, position);
+
+    FUNCTION_TEST_RETURN(strNewN((const char *)protocolFrameData(frame, position, size), size));
+}
+
+/***********************************************************************************************************************************
+Create a new frame
+
+Space is reserved at the beginning of the frame for the header, which is set when the frame is written.
+***********************************************************************************************************************************/
+Buffer *
+protocolFrameNew(void)
+{
+    FUNCTION_TEST_VOID();
+
+    Buffer *this = bufNew(PROTOCOL_FRAME_SIZE_DEFAULT);
+    bufUsedSet(this, PROTOCOL_FRAME_HEADER_SIZE);
+
+    FUNCTION_TEST_RETURN(this);
+}
+
+/***********************************************************************************************************************************
+Decode the value at the position and advance the position past the value
+***********************************************************************************************************************************/
+Variant *
+protocolFrameGet(const Buffer *frame, size_t *position)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BUFFER, frame);
+        FUNCTION_TEST_PARAM_P(SIZE, position);
+    FUNCTION_TEST_END();
+
+    ASSERT(frame != NULL);
+    ASSERT(position != NULL);
+
+    Variant *result = NULL;
+    unsigned char type = *protocolFrameData(frame, position, 1);
+
+    switch (type)
+    {
+        case protocolFrameTypeNull:
+            break;
+
+        case protocolFrameTypeBool:
+        {
+            result = varNewBool(*protocolFrameData(frame, position, 1) != 0);
+            break;
+        }
+
+        case protocolFrameTypeInt:
+        {
+            result = varNewInt64((int64_t)protocolFrameDataU64(frame, position));
+            break;
+        }
+
+        case protocolFrameTypeUInt:
+        {
+            result = varNewUInt64(protocolFrameDataU64(frame, position));
+            break;
+        }
+
+        case protocolFrameTypeString:
+        {
+            String *value = protocolFrameDataStr(frame, position);
+            result = varNewStr(value);
+            strFree(value);
+            break;
+        }
+
+        // Values are added directly to the list rather than creating the list first since varNewVarLst() would duplicate it
+        case protocolFrameTypeList:
+        {
+            uint32_t total = protocolFrameDataU32(frame, position);
+            result = varNewVarLst(varLstNew());
+
+            for (uint32_t valueIdx = 0; valueIdx < total; valueIdx++)
+                varLstAdd(varVarLst(result), protocolFrameGet(frame, position));
+
+            break;
+        }
+
+        case protocolFrameTypeKeyValue:
+        {
+            uint32_t total = protocolFrameDataU32(frame, position);
+            KeyValue *value = kvNew();
+
+            for (uint32_t valueIdx = 0; valueIdx < total; valueIdx++)
+            {
+                String *key = protocolFrameDataStr(frame, position);
+                kvPut(value, VARSTR(key), protocolFrameGet(frame, position));
+            }
+
+            result = varNewKv(value);
+            break;
+        }
+
+        default:
+            THROW_FMT(ProtocolError, "invalid frame value type %u at position %zu", type, *position - 1);
+    }
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Encode a value and append it to the frame
+***********************************************************************************************************************************/
+void
+protocolFramePut(Buffer *frame, const Variant *value)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BUFFER, frame);
+        FUNCTION_TEST_PARAM(VARIANT, value);
+    FUNCTION_TEST_END();
+
+    ASSERT(frame != NULL);
+
+    if (value == NULL)
+    {
+        protocolFrameCat(frame, (const unsigned char []){protocolFrameTypeNull}, 1);
+    }
+    else
+    {
+        switch (varType(value))
+        {
+            case varTypeBool:
+            {
+                protocolFrameCat(frame, (const unsigned char []){protocolFrameTypeBool, varBool(value)}, 2);
+                break;
+            }
+
+            // Integers are encoded by sign to match the types that jsonToVar() returns
+            case varTypeInt:
+            case varTypeInt64:
+            {
+                int64_t intValue = varInt64Force(value);
+
+                protocolFrameCat(
+                    frame, (const unsigned char []){intValue < 0 ? protocolFrameTypeInt : protocolFrameTypeUInt}, 1);
+                protocolFrameCatU64(frame, (uint64_t)intValue);
+                break;
+            }
+
+            case varTypeUInt:
+            case varTypeUInt64:
+            {
+                protocolFrameCat(frame, (const unsigned char []){protocolFrameTypeUInt}, 1);
+                protocolFrameCatU64(frame, varUInt64Force(value));
+                break;
+            }
+
+            // A variant with a NULL string is encoded as null, the same as JSON
+            case varTypeString:
+            {
+                if (varStr(value) == NULL)
+                {
+                    protocolFrameCat(frame, (const unsigned char []){protocolFrameTypeNull}, 1);
+                }
+                else
+                {
+                    protocolFrameCat(frame, (const unsigned char []){protocolFrameTypeString}, 1);
+                    protocolFrameCatStr(frame, varStr(value));
+                }
+
+                break;
+            }
+
+            case varTypeVariantList:
+            {
+                const VariantList *list = varVarLst(value);
+
+                // A variant with a NULL list is encoded as null, the same as JSON
+                if (list == NULL)
+                {
+                    protocolFrameCat(frame, (const unsigned char []){protocolFrameTypeNull}, 1);
+                }
+                else
+                {
+                    protocolFrameCat(frame, (const unsigned char []){protocolFrameTypeList}, 1);
+                    protocolFrameCatU32(frame, varLstSize(list));
+
+                    for (unsigned int valueIdx = 0; valueIdx < varLstSize(list); valueIdx++)
+                        protocolFramePut(frame, varLstGet(list, valueIdx));
+                }
+
+                break;
+            }
+
+            case varTypeKeyValue:
+            {
+                const KeyValue *kv = varKv(value);
+                const VariantList *keyList = kvKeyList(kv);
+
+                protocolFrameCat(frame, (const unsigned char []){protocolFrameTypeKeyValue}, 1);
+                protocolFrameCatU32(frame, varLstSize(keyList));
+
+                // Keys are always strings in the output, the same as JSON
+                MEM_CONTEXT_TEMP_BEGIN()
+                {
+                    for (unsigned int keyIdx = 0; keyIdx < varLstSize(keyList); keyIdx++)
+                    {
+                        const Variant *key = varLstGet(keyList, keyIdx);
+
+                        protocolFrameCatStr(frame, varType(key) == varTypeString ? varStr(key) : varStrForce(key));
+                        protocolFramePut(frame, kvGet(kv, key));
+                    }
+                }
+                MEM_CONTEXT_TEMP_END();
+
+                break;
+            }
+
+            default:
+                THROW(AssertError, "unable to encode double in frame");
+        }
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Read a frame
+
+The header is not included in the returned frame so values begin at position zero.
+***********************************************************************************************************************************/
+Buffer *
+protocolFrameRead(IoRead *read)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(IO_READ, read);
+    FUNCTION_LOG_END();
+
+    ASSERT(read != NULL);
+
+    Buffer *header = bufNew(PROTOCOL_FRAME_HEADER_SIZE);
+
+    if (ioRead(read, header) != PROTOCOL_FRAME_HEADER_SIZE)
+        THROW(ProtocolError, "unexpected eof while reading frame header");
+
+    size_t position = 0;
+    size_t size = protocolFrameDataU32(header, &position);
+    bufFree(header);
+
+    Buffer *result = bufNew(size);
+
+    if (size > 0 && ioRead(read, result) != size)
+        THROW_FMT(ProtocolError, "unexpected eof while reading %zu byte frame", size);
+
+    FUNCTION_LOG_RETURN(BUFFER, result);
+}
+
+/***********************************************************************************************************************************
+Write a frame
+
+The header is set in the space reserved by protocolFrameNew() so the frame can be written in a single call.  The write is not
+flushed.
+***********************************************************************************************************************************/
+void
+protocolFrameWrite(IoWrite *write, Buffer *frame)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(IO_WRITE, write);
+        FUNCTION_LOG_PARAM(BUFFER, frame);
+    FUNCTION_LOG_END();
+
+    ASSERT(write != NULL);
+    ASSERT(frame != NULL);
+    ASSERT(bufUsed(frame) >= PROTOCOL_FRAME_HEADER_SIZE);
+
+    uint32_t size = (uint32_t)(bufUsed(frame) - PROTOCOL_FRAME_HEADER_SIZE);
+    unsigned char *header = bufPtr(frame);
+
+    header[0] = (unsigned char)(size >> 24);
+    header[1] = (unsigned char)(size >> 16);
+    header[2] = (unsigned char)(size >> 8);
+    header[3] = (unsigned char)size;
+
+    ioWrite(write, frame);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Read the header of a data block
+***********************************************************************************************************************************/
+ssize_t
+protocolFrameBlockRead(IoRead *read)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(IO_READ, read);
+    FUNCTION_LOG_END();
+
+    ASSERT(read != NULL);
+
+    Buffer *header = bufNew(PROTOCOL_FRAME_HEADER_SIZE);
+
+    if (ioRead(read, header) != PROTOCOL_FRAME_HEADER_SIZE)
+        THROW(ProtocolError, "unexpected eof while reading block header");
+
+    size_t position = 0;
+    int32_t result = (int32_t)protocolFrameDataU32(header, &position);
+    bufFree(header);
+
+    if (result < -1)
+        THROW_FMT(ProtocolError, "'%d' is not a valid block size", result);
+
+    FUNCTION_LOG_RETURN(SSIZE, result);
+}
+
+/***********************************************************************************************************************************
+Write the header of a data block.  The write is not flushed.
+***********************************************************************************************************************************/
+void
+protocolFrameBlockWrite(IoWrite *write, ssize_t size)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(IO_WRITE, write);
+        FUNCTION_LOG_PARAM(SSIZE, size);
+    FUNCTION_LOG_END();
+
+    ASSERT(write != NULL);
+    ASSERT(size >= -1 && size <= INT32_MAX);
+
+    Buffer *header = bufNew(PROTOCOL_FRAME_HEADER_SIZE);
+    protocolFrameCatU32(header, (uint32_t)(int32_t)size);
+
+    ioWrite(write, header);
+    bufFree(header);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
@@ -0,0 +1,44 @@
+/***********************************************************************************************************************************
+Protocol Binary Frame
+
+Binary frames are an alternative to the line-based JSON messages used by the protocol.  They are only used when negotiated by a C
+client with a C server since the Perl side of the protocol only understands JSON.
+
+Each frame is a four byte big-endian payload size followed by the payload.  The payload is a sequence of typed values, each with a
+one byte type followed by the value:
+
+null       - no value
+bool       - one byte, 0 or 1
+int/uint   - eight byte big-endian integer
+string     - four byte big-endian size followed by the string data (no escaping or terminator)
+list       - four byte big-endian count followed by the values
+key/value  - four byte big-endian count followed by key/value pairs where keys are encoded as string data (without the type)
+
+Integers are decoded the same way as JSON, i.e. negative integers are returned as Int64 and all others as UInt64, so protocol
+handlers see the same variant types regardless of the encoding.
+
+Data blocks are preceded by a four byte big-endian signed size rather than a BRBLOCK line.  As with the text header a size of zero
+means the transfer is complete and -1 means the transfer was aborted.
+***********************************************************************************************************************************/
+#ifndef PROTOCOL_FRAME_H
+#define PROTOCOL_FRAME_H
+
+#include <sys/types.h>
+
+#include "common/io/read.h"
+#include "common/io/write.h"
+#include "common/type/buffer.h"
+#include "common/type/variant.h"
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+Buffer *protocolFrameNew(void);
+Variant *protocolFrameGet(const Buffer *frame, size_t *position);
+void protocolFramePut(Buffer *frame, const Variant *value);
+Buffer *protocolFrameRead(IoRead *read);
+void protocolFrameWrite(IoWrite *write, Buffer *frame);
+ssize_t protocolFrameBlockRead(IoRead *read);
+void protocolFrameBlockWrite(IoWrite *write, ssize_t size);
+
+#endif
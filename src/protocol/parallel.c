@@ -4,9 +4,9 @@ Protocol Parallel Executor
 #include "build.auto.h"
 
 #include <string.h>
-#include <sys/select.h>
 
 #include "common/debug.h"
+#include "common/io/event.h"
 #include "common/log.h"
 #include "common/memContext.h"
 #include "common/object.h"
@@ -16,6 +16,22 @@ Protocol Parallel Executor
 #include "protocol/command.h"
 #include "protocol/parallel.h"
 
+/***********************************************************************************************************************************
+Jobs queued on a client
+
+Commands are written to the client as soon as there is room in the pipeline.  The server processes commands in the order received so
+results are read back in the same order.
+***********************************************************************************************************************************/
+typedef struct ProtocolParallelClientJob
+{
+    ProtocolClient *client;                                         // Client processing the jobs
+    unsigned int processId;                                         // Process id reported for jobs run on the client
+    ProtocolParallelJob **jobList;                                  // Jobs sent to the client (ring buffer in command order)
+    unsigned int jobIdx;                                            // Oldest job sent to the client, i.e. the next result to read
+    unsigned int jobTotal;                                          // Total jobs sent to the client and not yet complete
+    TimeUSec pipelineTime;                                          // Time a result was read while the next job was queued
+} ProtocolParallelClientJob;
+
 /***********************************************************************************************************************************
 Object type
 ***********************************************************************************************************************************/
@@ -23,11 +39,21 @@ struct ProtocolParallel
 {
     MemContext *memContext;
     TimeMSec timeout;                                               // Max time to wait for jobs before returning
+    unsigned int pipeline;                                          // Max jobs to queue on each client
 
     List *clientList;                                               // List of clients to process jobs
     List *jobList;                                                  // List of jobs to be processed
+    unsigned int jobNextIdx;                                        // Next job in jobList to be started
+
+    ProtocolParallelClientJob *clientJobList;                       // Jobs being processed by each client
+    IoEvent *event;                                                 // Waits on clients that are processing jobs
 
-    ProtocolParallelJob **clientJobList;                            // Jobs being processing by each client
+    List *jobDoneList;                                              // Completed jobs waiting to be returned
+    unsigned int jobDoneIdx;                                        // Next completed job to be returned
+    unsigned int jobReturnTotal;                                    // Total jobs returned
+
+    unsigned int pipelineTotal;                                     // Total jobs that were queued before the prior job completed
+    TimeUSec pipelineIdleSaved;                                     // Idle time saved on clients by queuing jobs
 
     ProtocolParallelJobState state;                                 // Overall state of job processing
 };
@@ -38,12 +64,15 @@ OBJECT_DEFINE_FREE(PROTOCOL_PARALLEL);
 Create object
 ***********************************************************************************************************************************/
 ProtocolParallel *
-protocolParallelNew(TimeMSec timeout)
+protocolParallelNew(TimeMSec timeout, unsigned int pipeline)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(UINT64, timeout);
+        FUNCTION_LOG_PARAM(UINT, pipeline);
     FUNCTION_LOG_END();
 
+    ASSERT(pipeline > 0);
+
     ProtocolParallel *this = NULL;
 
     MEM_CONTEXT_NEW_BEGIN("ProtocolParallel")
@@ -51,9 +80,11 @@ protocolParallelNew(TimeMSec timeout)
         this = memNew(sizeof(ProtocolParallel));
         this->memContext = memContextCurrent();
         this->timeout = timeout;
+        this->pipeline = pipeline;
 
         this->clientList = lstNew(sizeof(ProtocolClient *));
         this->jobList = lstNew(sizeof(ProtocolParallelJob *));
+        this->jobDoneList = lstNew(sizeof(ProtocolParallelJob *));
         this->state = protocolParallelJobStatePending;
     }
     MEM_CONTEXT_NEW_END();
@@ -105,6 +136,61 @@ protocolParallelJobAdd(ProtocolParallel *this, ProtocolParallelJob *job)
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Read the result of the oldest job on a client
+***********************************************************************************************************************************/
+static void
+protocolParallelClientResult(ProtocolParallel *this, ProtocolParallelClientJob *clientJob)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PROTOCOL_PARALLEL, this);
+        FUNCTION_TEST_PARAM_P(VOID, clientJob);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(clientJob != NULL);
+    ASSERT(clientJob->jobTotal > 0);
+
+    ProtocolParallelJob *job = clientJob->jobList[clientJob->jobIdx];
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        TRY_BEGIN()
+        {
+            protocolParallelJobResultSet(job, protocolClientReadOutput(clientJob->client, true));
+        }
+        CATCH_ANY()
+        {
+            protocolParallelJobErrorSet(job, errorCode(), STR(errorMessage()));
+        }
+        TRY_END();
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    protocolParallelJobStateSet(job, protocolParallelJobStateDone);
+    lstAdd(this->jobDoneList, &job);
+
+    clientJob->jobList[clientJob->jobIdx] = NULL;
+    clientJob->jobIdx = (clientJob->jobIdx + 1) % this->pipeline;
+    clientJob->jobTotal--;
+
+    // Stop waiting on the client when it has no more jobs
+    if (clientJob->jobTotal == 0)
+        ioEventRemove(this->event, ioReadHandle(protocolClientIoRead(clientJob->client)));
+
+    // If the next job was already queued then the client did not have to wait for it.  Note the time so the wait that was avoided
+    // can be measured when the client would have been sent the next job without a pipeline.
+    if (clientJob->jobTotal > 0)
+    {
+        this->pipelineTotal++;
+
+        if (clientJob->pipelineTime == 0)
+            clientJob->pipelineTime = timeUSec();
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Process jobs
 ***********************************************************************************************************************************/
@@ -125,105 +211,100 @@ protocolParallelProcess(ProtocolParallel *this)
     {
         MEM_CONTEXT_BEGIN(this->memContext)
         {
-            this->clientJobList = (ProtocolParallelJob **)memNew(sizeof(ProtocolParallelJob *) * lstSize(this->clientList));
+            this->clientJobList = memNew(sizeof(ProtocolParallelClientJob) * lstSize(this->clientList));
+
+            for (unsigned int clientIdx = 0; clientIdx < lstSize(this->clientList); clientIdx++)
+            {
+                ProtocolParallelClientJob *clientJob = &this->clientJobList[clientIdx];
+
+                clientJob->client = *(ProtocolClient **)lstGet(this->clientList, clientIdx);
+                clientJob->processId = clientIdx + 1;
+                clientJob->jobList = memNew(sizeof(ProtocolParallelJob *) * this->pipeline);
+            }
+
+            this->event = ioEventNew();
         }
         MEM_CONTEXT_END();
 
         this->state = protocolParallelJobStateRunning;
     }
 
-    // Initialize the file descriptor set used for select
-    fd_set selectSet;
-    FD_ZERO(&selectSet);
-    int handleMax = -1;
-
-    // Find clients that are running jobs
-    unsigned int clientRunningTotal = 0;
+    // If clients are running then wait for one to finish
+    unsigned int readyTotal = 0;
 
-    for (unsigned int clientIdx = 0; clientIdx < lstSize(this->clientList); clientIdx++)
+    if (ioEventSize(this->event) > 0)
     {
-        if (this->clientJobList[clientIdx] != NULL)
-        {
-            int handle = ioReadHandle(protocolClientIoRead(*(ProtocolClient **)lstGet(this->clientList, clientIdx)));
-            FD_SET((unsigned int)handle, &selectSet);
+        readyTotal = ioEventWait(this->event, this->timeout);
 
-            // Find the max file handle needed for select()
-            MAX_ASSIGN(handleMax, handle);
+        // Get results from clients that are ready
+        for (unsigned int readyIdx = 0; readyIdx < readyTotal; readyIdx++)
+        {
+            ProtocolParallelClientJob *clientJob = ioEventReady(this->event, readyIdx);
 
-            clientRunningTotal++;
+            // Read the result that is ready and any others that were buffered along with it.  Buffered results must be read now
+            // since the event will not report them.
+            do
+            {
+                protocolParallelClientResult(this, clientJob);
+                result++;
+            }
+            while (clientJob->jobTotal > 0 && protocolClientReadReady(clientJob->client));
         }
     }
 
-    // If clients are running then wait for one to finish
-    if (clientRunningTotal > 0)
+    // Start new jobs on clients that have room in their pipeline.  Fill each level of the pipeline on all clients before moving to
+    // the next level so jobs are spread evenly across the clients.
+    //
+    // A job queued behind a running job is committed to that client since the command has already been written, so it cannot be
+    // moved to another client that becomes idle first.  This is the cost of the pipeline.  To limit it, jobs are only queued behind
+    // running jobs while there are at least as many jobs left to start as there are clients.  The last jobs wait for an idle client
+    // so a client that is slow on its current job does not hold up the end of processing.
+    for (unsigned int pipelineIdx = 0; pipelineIdx < this->pipeline && this->jobNextIdx < lstSize(this->jobList); pipelineIdx++)
     {
-        // Initialize timeout struct used for select.  Recreate this structure each time since Linux (at least) will modify it.
-        struct timeval timeoutSelect;
-        timeoutSelect.tv_sec = (time_t)(this->timeout / MSEC_PER_SEC);
-        timeoutSelect.tv_usec = (time_t)(this->timeout % MSEC_PER_SEC * 1000);
 
-        // Determine if there is data to be read
-        int completed = select(handleMax + 1, &selectSet, NULL, NULL, &timeoutSelect);
-        THROW_ON_SYS_ERROR(completed == -1, AssertError, "unable to select from parallel client(s)");
-
-        // If any jobs have completed then get the results
-        if (completed > 0)
+        for (unsigned int clientIdx = 0; clientIdx < lstSize(this->clientList) && this->jobNextIdx < lstSize(this->jobList);
+             clientIdx++)
         {
-            for (unsigned int clientIdx = 0; clientIdx < lstSize(this->clientList); clientIdx++)
+            ProtocolParallelClientJob *clientJob = &this->clientJobList[clientIdx];
+
+            if (clientJob->jobTotal == pipelineIdx &&
+                (clientJob->jobTotal == 0 || lstSize(this->jobList) - this->jobNextIdx >= lstSize(this->clientList)))
             {
-                ProtocolParallelJob *job = this->clientJobList[clientIdx];
-
-                if (job != NULL &&
-                    FD_ISSET(
-                        (unsigned int)ioReadHandle(protocolClientIoRead(*(ProtocolClient **)lstGet(this->clientList, clientIdx))),
-                        &selectSet))
-                {
-                    MEM_CONTEXT_TEMP_BEGIN()
-                    {
-                        TRY_BEGIN()
-                        {
-                            protocolParallelJobResultSet(
-                                job, protocolClientReadOutput(*(ProtocolClient **)lstGet(this->clientList, clientIdx), true));
-                        }
-                        CATCH_ANY()
-                        {
-                            protocolParallelJobErrorSet(job, errorCode(), STR(errorMessage()));
-                        }
-                        TRY_END();
-
-                        protocolParallelJobStateSet(job, protocolParallelJobStateDone);
-                        this->clientJobList[clientIdx] = NULL;
-                    }
-                    MEM_CONTEXT_TEMP_END();
-                }
-            }
+                // Remove the job from the job list since it is now tracked by the client until done
+                ProtocolParallelJob **jobNext = lstGet(this->jobList, this->jobNextIdx);
+                ProtocolParallelJob *job = *jobNext;
+                *jobNext = NULL;
+                this->jobNextIdx++;
 
-            result = (unsigned int)completed;
+                protocolClientWriteCommand(clientJob->client, protocolParallelJobCommand(job));
+
+                protocolParallelJobProcessIdSet(job, clientJob->processId);
+                protocolParallelJobStateSet(job, protocolParallelJobStateRunning);
+
+                // Start waiting on the client when it gets its first job
+                if (clientJob->jobTotal == 0)
+                    ioEventAdd(this->event, ioReadHandle(protocolClientIoRead(clientJob->client)), clientJob);
+
+                clientJob->jobList[(clientJob->jobIdx + clientJob->jobTotal) % this->pipeline] = job;
+                clientJob->jobTotal++;
+            }
         }
     }
 
-    // Find new jobs to be run
-    for (unsigned int clientIdx = 0; clientIdx < lstSize(this->clientList); clientIdx++)
-    {
-        // If nothing is running for this client
-        if (this->clientJobList[clientIdx] == NULL)
-        {
-            for (unsigned int jobIdx = 0; jobIdx < lstSize(this->jobList); jobIdx++)
-            {
-                ProtocolParallelJob *job = *(ProtocolParallelJob **)lstGet(this->jobList, jobIdx);
+    // Without a pipeline the ready clients that had a job queued would have been idle until now
+    TimeUSec timeNow = 0;
 
-                if (protocolParallelJobState(job) == protocolParallelJobStatePending)
-                {
-                    protocolClientWriteCommand(
-                        *(ProtocolClient **)lstGet(this->clientList, clientIdx), protocolParallelJobCommand(job));
+    for (unsigned int readyIdx = 0; readyIdx < readyTotal; readyIdx++)
+    {
+        ProtocolParallelClientJob *clientJob = ioEventReady(this->event, readyIdx);
 
-                    protocolParallelJobProcessIdSet(job, clientIdx + 1);
-                    protocolParallelJobStateSet(job, protocolParallelJobStateRunning);
-                    this->clientJobList[clientIdx] = job;
+        if (clientJob->pipelineTime != 0)
+        {
+            if (timeNow == 0)
+                timeNow = timeUSec();
 
-                    break;
-                }
-            }
+            this->pipelineIdleSaved += timeNow - clientJob->pipelineTime;
+            clientJob->pipelineTime = 0;
         }
     }
 
@@ -245,23 +326,34 @@ protocolParallelResult(ProtocolParallel *this)
 
     ProtocolParallelJob *result = NULL;
 
-    // Find the next completed job
-    for (unsigned int jobIdx = 0; jobIdx < lstSize(this->jobList); jobIdx++)
+    // Return the next completed job
+    if (this->jobDoneIdx < lstSize(this->jobDoneList))
     {
-        ProtocolParallelJob *job = *(ProtocolParallelJob **)lstGet(this->jobList, jobIdx);
+        result = protocolParallelJobMove(*(ProtocolParallelJob **)lstGet(this->jobDoneList, this->jobDoneIdx), memContextCurrent());
+        this->jobDoneIdx++;
+        this->jobReturnTotal++;
 
-        if (protocolParallelJobState(job) == protocolParallelJobStateDone)
+        // Reset the done list once all completed jobs have been returned so it does not grow with the total number of jobs
+        if (this->jobDoneIdx == lstSize(this->jobDoneList))
         {
-            result = protocolParallelJobMove(job, memContextCurrent());
-            lstRemove(this->jobList, jobIdx);
-            break;
+            lstClear(this->jobDoneList);
+            this->jobDoneIdx = 0;
         }
     }
 
     // If all jobs have been returned then we are done
-    if (lstSize(this->jobList) == 0)
+    if (this->jobReturnTotal == lstSize(this->jobList))
+    {
         this->state = protocolParallelJobStateDone;
 
+        if (this->pipelineTotal > 0)
+        {
+            LOG_DEBUG(
+                "pipeline saved %" PRIu64 "us of process idle time on %u of %u job(s)", this->pipelineIdleSaved, this->pipelineTotal,
+                lstSize(this->jobList));
+        }
+    }
+
     FUNCTION_LOG_RETURN(PROTOCOL_PARALLEL_JOB, result);
 }
 
@@ -286,5 +378,5 @@ protocolParallelToLog(const ProtocolParallel *this)
 {
     return strNewFmt(
         "{state: %s, clientTotal: %u, jobTotal: %u}", protocolParallelJobToConstZ(this->state), lstSize(this->clientList),
-        lstSize(this->jobList));
+        lstSize(this->jobList) - this->jobReturnTotal);
 }
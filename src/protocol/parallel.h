@@ -19,7 +19,7 @@ typedef struct ProtocolParallel ProtocolParallel;
 /***********************************************************************************************************************************
 Constructor
 ***********************************************************************************************************************************/
-ProtocolParallel *protocolParallelNew(TimeMSec timeout);
+ProtocolParallel *protocolParallelNew(TimeMSec timeout, unsigned int pipeline);
 
 /***********************************************************************************************************************************
 Functions
@@ -14,6 +14,7 @@ Protocol Server
 #include "common/type/keyValue.h"
 #include "common/type/list.h"
 #include "protocol/client.h"
+#include "protocol/frame.h"
 #include "protocol/server.h"
 #include "version.h"
 
@@ -26,6 +27,7 @@ struct ProtocolServer
     const String *name;
     IoRead *read;
     IoWrite *write;
+    bool binary;                                                    // Are messages sent as binary frames rather than JSON?
 
     List *handlerList;
 };
@@ -70,6 +72,9 @@ protocolServerNew(const String *name, const String *service, IoRead *read, IoWri
             kvPut(greetingKv, VARSTR(PROTOCOL_GREETING_SERVICE_STR), VARSTR(service));
             kvPut(greetingKv, VARSTR(PROTOCOL_GREETING_VERSION_STR), VARSTRZ(PROJECT_VERSION));
 
+            // Let C clients know that binary frames can be used.  Perl clients ignore this key and continue to use JSON.
+            kvPut(greetingKv, VARSTR(PROTOCOL_GREETING_BINARY_STR), BOOL_TRUE_VAR);
+
             ioWriteStrLine(this->write, jsonFromKv(greetingKv, 0));
             ioWriteFlush(this->write);
         }
@@ -114,13 +119,30 @@ protocolServerError(ProtocolServer *this, int code, const String *message, const
     ASSERT(message != NULL);
     ASSERT(stack != NULL);
 
-    KeyValue *error = kvNew();
-    kvPut(error, VARSTR(PROTOCOL_ERROR_STR), VARINT(code));
-    kvPut(error, VARSTR(PROTOCOL_OUTPUT_STR), VARSTR(message));
-    kvPut(error, VARSTR(PROTOCOL_ERROR_STACK_STR), VARSTR(stack));
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        if (this->binary)
+        {
+            Buffer *error = protocolFrameNew();
+            protocolFramePut(error, VARINT(code));
+            protocolFramePut(error, VARSTR(message));
+            protocolFramePut(error, VARSTR(stack));
+
+            protocolFrameWrite(this->write, error);
+        }
+        else
+        {
+            KeyValue *error = kvNew();
+            kvPut(error, VARSTR(PROTOCOL_ERROR_STR), VARINT(code));
+            kvPut(error, VARSTR(PROTOCOL_OUTPUT_STR), VARSTR(message));
+            kvPut(error, VARSTR(PROTOCOL_ERROR_STACK_STR), VARSTR(stack));
+
+            ioWriteStrLine(this->write, jsonFromKv(error, 0));
+        }
 
-    ioWriteStrLine(this->write, jsonFromKv(error, 0));
-    ioWriteFlush(this->write);
+        ioWriteFlush(this->write);
+    }
+    MEM_CONTEXT_TEMP_END();
 
     FUNCTION_LOG_RETURN_VOID();
 }
@@ -142,12 +164,26 @@ protocolServerProcess(ProtocolServer *this)
     {
         TRY_BEGIN()
         {
-            MEM_CONTEXT_TEMP_BEGIN()
+            MEM_CONTEXT_TEMP_ARENA_BEGIN()
             {
                 // Read command
-                KeyValue *commandKv = jsonToKv(ioReadLine(this->read));
-                const String *command = varStr(kvGet(commandKv, VARSTR(PROTOCOL_KEY_COMMAND_STR)));
-                VariantList *paramList = varVarLst(kvGet(commandKv, VARSTR(PROTOCOL_KEY_PARAMETER_STR)));
+                const String *command = NULL;
+                VariantList *paramList = NULL;
+
+                if (this->binary)
+                {
+                    Buffer *commandFrame = protocolFrameRead(this->read);
+                    size_t position = 0;
+
+                    command = varStr(protocolFrameGet(commandFrame, &position));
+                    paramList = varVarLst(protocolFrameGet(commandFrame, &position));
+                }
+                else
+                {
+                    KeyValue *commandKv = jsonToKv(ioReadLine(this->read));
+                    command = varStr(kvGet(commandKv, VARSTR(PROTOCOL_KEY_COMMAND_STR)));
+                    paramList = varVarLst(kvGet(commandKv, VARSTR(PROTOCOL_KEY_PARAMETER_STR)));
+                }
 
                 // Process command
                 bool found = false;
@@ -176,6 +212,12 @@ protocolServerProcess(ProtocolServer *this)
                         protocolServerResponse(this, NULL);
                     else if (strEq(command, PROTOCOL_COMMAND_EXIT_STR))
                         exit = true;
+                    // Acknowledge with JSON since that is what the client expects and then switch to binary frames
+                    else if (strEq(command, PROTOCOL_COMMAND_BINARY_STR))
+                    {
+                        protocolServerResponse(this, NULL);
+                        this->binary = true;
+                    }
                     else
                         THROW_FMT(ProtocolError, "invalid command '%s'", strPtr(command));
                 }
@@ -205,13 +247,30 @@ protocolServerResponse(ProtocolServer *this, const Variant *output)
         FUNCTION_LOG_PARAM(VARIANT, output);
     FUNCTION_LOG_END();
 
-    KeyValue *result = kvNew();
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // A null error code means there is no error so the output follows
+        if (this->binary)
+        {
+            Buffer *result = protocolFrameNew();
+            protocolFramePut(result, NULL);
+            protocolFramePut(result, output);
 
-    if (output != NULL)
-        kvAdd(result, VARSTR(PROTOCOL_OUTPUT_STR), output);
+            protocolFrameWrite(this->write, result);
+        }
+        else
+        {
+            KeyValue *result = kvNew();
 
-    ioWriteStrLine(this->write, jsonFromKv(result, 0));
-    ioWriteFlush(this->write);
+            if (output != NULL)
+                kvAdd(result, VARSTR(PROTOCOL_OUTPUT_STR), output);
+
+            ioWriteStrLine(this->write, jsonFromKv(result, 0));
+        }
+
+        ioWriteFlush(this->write);
+    }
+    MEM_CONTEXT_TEMP_END();
 
     FUNCTION_LOG_RETURN_VOID();
 }
@@ -235,6 +294,21 @@ protocolServerMove(ProtocolServer *this, MemContext *parentNew)
     FUNCTION_TEST_RETURN(this);
 }
 
+/***********************************************************************************************************************************
+Are messages sent as binary frames?
+***********************************************************************************************************************************/
+bool
+protocolServerBinary(const ProtocolServer *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PROTOCOL_SERVER, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->binary);
+}
+
 /***********************************************************************************************************************************
 Get read interface
 ***********************************************************************************************************************************/
@@ -221,7 +221,7 @@ storagePosixInfoList(THIS_VOID, const String *path, StorageInfoListCallback call
 
         TRY_BEGIN()
         {
-            MEM_CONTEXT_TEMP_RESET_BEGIN()
+            MEM_CONTEXT_TEMP_RESET_ARENA_BEGIN()
             {
                 // Read the directory entries
                 struct dirent *dirEntry = readdir(dir);
@@ -687,7 +687,7 @@ storagePosixNewInternal(
 
         driver->interface = (StorageInterface)
         {
-            .feature = (1 << storageFeaturePath | 1 << storageFeatureCompress), .exists = storagePosixExists,
+            .feature = (1 << storageFeaturePath | 1 << storageFeatureCompress | 1 << storageFeatureMove), .exists = storagePosixExists,
             .info = storagePosixInfo, .infoList = storagePosixInfoList, .list = storagePosixList, .move = storagePosixMove,
             .newRead = storagePosixNewRead, .newWrite = storagePosixNewWrite, .pathCreate = storagePosixPathCreate,
             .pathExists = storagePosixPathExists, .pathRemove = storagePosixPathRemove,
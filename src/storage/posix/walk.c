@@ -0,0 +1,464 @@
+/***********************************************************************************************************************************
+Posix Storage Walk
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <grp.h>
+#include <limits.h>
+#include <pthread.h>
+#include <pwd.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "common/debug.h"
+#include "common/log.h"
+#include "common/memContext.h"
+#include "common/type/list.h"
+#include "storage/posix/walk.h"
+#include "storage/storage.intern.h"
+
+/***********************************************************************************************************************************
+Maximum size of an error message from a thread
+***********************************************************************************************************************************/
+#define ERROR_MESSAGE_SIZE                                          4096
+
+/***********************************************************************************************************************************
+Path waiting to be scanned
+
+Paths are a stack so the tree is scanned depth first, which keeps the number of paths waiting small.
+***********************************************************************************************************************************/
+typedef struct StoragePosixWalkPath
+{
+    struct StoragePosixWalkPath *next;                              // Next path waiting to be scanned
+    const String *name;                                             // Name relative to the walk path (NULL for the walk path)
+} StoragePosixWalkPath;
+
+/***********************************************************************************************************************************
+Entry found by a thread
+
+User and group are stored as ids since getpwuid()/getgrgid() are not thread-safe.  They are converted to names after the threads are
+done.
+***********************************************************************************************************************************/
+typedef struct StoragePosixWalkEntry
+{
+    const String *name;                                             // Name relative to the walk path
+    const String *linkDestination;                                  // Destination if this is a link
+    StorageType type;                                               // Type file/path/link
+    uid_t userId;                                                   // User that owns the file
+    gid_t groupId;                                                  // Group that owns the file
+    mode_t mode;                                                    // Mode of path/file/link
+    time_t timeModified;                                            // Time file was last modified
+    uint64_t size;                                                  // Size (path/link is 0)
+} StoragePosixWalkEntry;
+
+/***********************************************************************************************************************************
+Thread that scans paths
+
+Each thread allocates only from its own context so threads never allocate from the same context.
+***********************************************************************************************************************************/
+typedef struct StoragePosixWalkThread
+{
+    struct StoragePosixWalk *walk;                                  // Walk that the thread scans paths for
+    MemContext *memContext;                                         // Context used only by this thread
+    List *entryList;                                                // Entries found by the thread
+    pthread_t thread;                                               // Thread
+} StoragePosixWalkThread;
+
+/***********************************************************************************************************************************
+Walk state shared by all threads
+***********************************************************************************************************************************/
+typedef struct StoragePosixWalk
+{
+    const String *path;                                             // Path to walk
+    const String *filter;                                           // Only include this entry in the walk path
+    bool missing;                                                   // Is the walk path missing?
+
+    pthread_mutex_t mutex;                                          // Mutex for the path stack and thread state
+    pthread_cond_t cond;                                            // Signaled when a path is queued or the walk may be done
+    StoragePosixWalkPath *pathQueue;                                // Paths waiting to be scanned
+    unsigned int pathBusy;                                          // Paths being scanned
+
+    bool abort;                                                     // Should the threads stop?
+    const ErrorType *errorType;                                     // Type of error thrown in a thread
+    char errorMessage[ERROR_MESSAGE_SIZE];                          // Message of error thrown in a thread
+} StoragePosixWalk;
+
+/***********************************************************************************************************************************
+Stat an entry relative to an open directory and store it.  Returns true if the entry is a path.
+***********************************************************************************************************************************/
+static bool
+storagePosixWalkEntry(StoragePosixWalkThread *thread, int dirFd, const char *file, const String *pathFull, const String *name)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, thread);
+        FUNCTION_TEST_PARAM(INT, dirFd);
+        FUNCTION_TEST_PARAM(STRINGZ, file);
+        FUNCTION_TEST_PARAM(STRING, pathFull);
+        FUNCTION_TEST_PARAM(STRING, name);
+    FUNCTION_TEST_END();
+
+    ASSERT(thread != NULL);
+    ASSERT(file != NULL);
+    ASSERT(name != NULL);
+
+    bool result = false;
+    struct stat statFile;
+
+    // Entries that have been removed since the directory was read are skipped
+    if (fstatat(dirFd, file, &statFile, AT_SYMLINK_NOFOLLOW) == -1)
+    {
+        if (errno != ENOENT)
+        {
+            THROW_SYS_ERROR_FMT(
+                FileOpenError, STORAGE_ERROR_INFO,
+                pathFull == NULL ? file : strPtr(strNewFmt("%s/%s", strPtr(pathFull), file)));
+        }
+    }
+    else
+    {
+        StoragePosixWalkEntry entry =
+        {
+            .name = name,
+            .userId = statFile.st_uid,
+            .groupId = statFile.st_gid,
+            .mode = statFile.st_mode & (S_IRWXU | S_IRWXG | S_IRWXO),
+            .timeModified = statFile.st_mtime,
+        };
+
+        if (S_ISREG(statFile.st_mode))
+        {
+            entry.type = storageTypeFile;
+            entry.size = (uint64_t)statFile.st_size;
+        }
+        else if (S_ISDIR(statFile.st_mode))
+            entry.type = storageTypePath;
+        else if (S_ISLNK(statFile.st_mode))
+        {
+            entry.type = storageTypeLink;
+
+            char linkDestination[PATH_MAX];
+            ssize_t linkDestinationSize = 0;
+
+            THROW_ON_SYS_ERROR_FMT(
+                (linkDestinationSize = readlinkat(dirFd, file, linkDestination, sizeof(linkDestination) - 1)) == -1,
+                FileReadError, "unable to get destination for link '%s'",
+                pathFull == NULL ? file : strPtr(strNewFmt("%s/%s", strPtr(pathFull), file)));
+
+            entry.linkDestination = strNewN(linkDestination, (size_t)linkDestinationSize);
+        }
+        else
+            entry.type = storageTypeSpecial;
+
+        lstAdd(thread->entryList, &entry);
+        result = entry.type == storageTypePath;
+    }
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Queue a path to be scanned by any thread
+***********************************************************************************************************************************/
+static void
+storagePosixWalkPathPut(StoragePosixWalk *this, const String *name)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, this);
+        FUNCTION_TEST_PARAM(STRING, name);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(name != NULL);
+
+    // Allocate before locking so the lock is held as briefly as possible
+    StoragePosixWalkPath *path = memNew(sizeof(StoragePosixWalkPath));
+    path->name = name;
+
+    pthread_mutex_lock(&this->mutex);
+    path->next = this->pathQueue;
+    this->pathQueue = path;
+    pthread_cond_signal(&this->cond);
+    pthread_mutex_unlock(&this->mutex);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Scan a path, storing the entries and queuing the subpaths
+***********************************************************************************************************************************/
+static void
+storagePosixWalkPath(StoragePosixWalkThread *thread, const StoragePosixWalkPath *path)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, thread);
+        FUNCTION_TEST_PARAM_P(VOID, path);
+    FUNCTION_TEST_END();
+
+    ASSERT(thread != NULL);
+    ASSERT(path != NULL);
+
+    StoragePosixWalk *this = thread->walk;
+    String *pathFull = path->name == NULL ? strDup(this->path) : strNewFmt("%s/%s", strPtr(this->path), strPtr(path->name));
+
+    // Open the directory for read.  Subpaths that have been removed since they were found are skipped.
+    DIR *dir = opendir(strPtr(pathFull));
+
+    if (dir == NULL)
+    {
+        if (errno != ENOENT)
+            THROW_SYS_ERROR_FMT(PathOpenError, STORAGE_ERROR_LIST_INFO, strPtr(pathFull));
+
+        if (path->name == NULL)
+            this->missing = true;
+    }
+    else
+    {
+        TRY_BEGIN()
+        {
+            int dirFd = dirfd(dir);
+
+            // The walk path itself is stored as "."
+            if (path->name == NULL)
+                storagePosixWalkEntry(thread, AT_FDCWD, strPtr(pathFull), NULL, strNew("."));
+
+            // Read the directory entries.  readdir() reads entries from the kernel in large batches.
+            struct dirent *dirEntry = readdir(dir);
+
+            while (dirEntry != NULL)
+            {
+                const char *file = dirEntry->d_name;
+
+                if (!(file[0] == '.' && (file[1] == '\0' || (file[1] == '.' && file[2] == '\0'))) &&
+                    (path->name != NULL || this->filter == NULL || strEqZ(this->filter, file)))
+                {
+                    String *name = path->name == NULL ? strNew(file) : strNewFmt("%s/%s", strPtr(path->name), file);
+
+                    if (storagePosixWalkEntry(thread, dirFd, file, pathFull, name))
+                        storagePosixWalkPathPut(this, name);
+                }
+
+                dirEntry = readdir(dir);
+            }
+        }
+        FINALLY()
+        {
+            closedir(dir);
+        }
+        TRY_END();
+    }
+
+    strFree(pathFull);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Thread that scans paths until there are no more paths to scan
+***********************************************************************************************************************************/
+static void *
+storagePosixWalkThread(void *threadVoid)
+{
+    StoragePosixWalkThread *thread = threadVoid;
+    StoragePosixWalk *this = thread->walk;
+    MemContext *contextOld = memContextSwitch(thread->memContext);
+
+    TRY_BEGIN()
+    {
+        pthread_mutex_lock(&this->mutex);
+
+        while (true)
+        {
+            // Wait for a path unless no paths are being scanned, in which case no more paths will be queued
+            while (!this->abort && this->pathQueue == NULL && this->pathBusy > 0)
+                pthread_cond_wait(&this->cond, &this->mutex);
+
+            if (this->abort || this->pathQueue == NULL)
+                break;
+
+            StoragePosixWalkPath *path = this->pathQueue;
+            this->pathQueue = path->next;
+            this->pathBusy++;
+
+            pthread_mutex_unlock(&this->mutex);
+            storagePosixWalkPath(thread, path);
+            pthread_mutex_lock(&this->mutex);
+
+            this->pathBusy--;
+
+            // Wake waiting threads when the walk is done so they can exit
+            if (this->pathBusy == 0 && this->pathQueue == NULL)
+                pthread_cond_broadcast(&this->cond);
+        }
+
+        pthread_mutex_unlock(&this->mutex);
+    }
+    CATCH_ANY()
+    {
+        // Store the first error so it can be thrown by storagePosixWalk()
+        pthread_mutex_lock(&this->mutex);
+
+        if (this->errorType == NULL)
+        {
+            this->errorType = errorType();
+            strncpy(this->errorMessage, errorMessage(), sizeof(this->errorMessage) - 1);
+        }
+
+        this->abort = true;
+        pthread_cond_broadcast(&this->cond);
+        pthread_mutex_unlock(&this->mutex);
+    }
+    TRY_END();
+
+    memContextSwitch(contextOld);
+
+    return NULL;
+}
+
+/**********************************************************************************************************************************/
+bool
+storagePosixWalk(
+    const String *path, const String *filter, unsigned int threadTotal, StorageInfoListCallback callback, void *callbackData)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STRING, path);
+        FUNCTION_LOG_PARAM(STRING, filter);
+        FUNCTION_LOG_PARAM(UINT, threadTotal);
+        FUNCTION_LOG_PARAM(FUNCTIONP, callback);
+        FUNCTION_LOG_PARAM_P(VOID, callbackData);
+    FUNCTION_LOG_END();
+
+    ASSERT(path != NULL);
+    ASSERT(threadTotal > 0);
+    ASSERT(callback != NULL);
+
+    bool result = false;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        StoragePosixWalk walk = {.path = path, .filter = filter};
+
+        // Queue the walk path
+        walk.pathQueue = memNew(sizeof(StoragePosixWalkPath));
+        *walk.pathQueue = (StoragePosixWalkPath){0};
+
+        // Create a context for each thread
+        StoragePosixWalkThread *threadList = memNew(sizeof(StoragePosixWalkThread) * threadTotal);
+
+        for (unsigned int threadIdx = 0; threadIdx < threadTotal; threadIdx++)
+        {
+            threadList[threadIdx] = (StoragePosixWalkThread){.walk = &walk};
+
+            MEM_CONTEXT_NEW_BEGIN("StoragePosixWalkThread")
+            {
+                threadList[threadIdx].memContext = MEM_CONTEXT_NEW();
+                threadList[threadIdx].entryList = lstNew(sizeof(StoragePosixWalkEntry));
+            }
+            MEM_CONTEXT_NEW_END();
+        }
+
+        pthread_mutex_init(&walk.mutex, NULL);
+        pthread_cond_init(&walk.cond, NULL);
+
+        volatile unsigned int threadStarted = 0;
+
+        TRY_BEGIN()
+        {
+            // With one thread scan in this thread
+            if (threadTotal == 1)
+                storagePosixWalkThread(&threadList[0]);
+            else
+            {
+                for (unsigned int threadIdx = 0; threadIdx < threadTotal; threadIdx++)
+                {
+                    int error = pthread_create(&threadList[threadIdx].thread, NULL, storagePosixWalkThread, &threadList[threadIdx]);
+
+                    if (error != 0)
+                    {
+                        pthread_mutex_lock(&walk.mutex);
+                        walk.abort = true;
+                        pthread_cond_broadcast(&walk.cond);
+                        pthread_mutex_unlock(&walk.mutex);
+
+                        errno = error;
+                        THROW_SYS_ERROR(KernelError, "unable to create walk thread");
+                    }
+
+                    threadStarted++;
+                }
+            }
+        }
+        FINALLY()
+        {
+            for (unsigned int threadIdx = 0; threadIdx < threadStarted; threadIdx++)
+                pthread_join(threadList[threadIdx].thread, NULL);
+
+            pthread_cond_destroy(&walk.cond);
+            pthread_mutex_destroy(&walk.mutex);
+        }
+        TRY_END();
+
+        // Throw the error from the thread that failed
+        if (walk.errorType != NULL)
+            THROWP(walk.errorType, walk.errorMessage);
+
+        result = !walk.missing;
+
+        // Perform callbacks.  User and group names are cached since most entries have the same owner.
+        bool userSet = false;
+        uid_t userId = 0;
+        const String *user = NULL;
+        bool groupSet = false;
+        gid_t groupId = 0;
+        const String *group = NULL;
+
+        for (unsigned int threadIdx = 0; threadIdx < threadTotal; threadIdx++)
+        {
+            const List *entryList = threadList[threadIdx].entryList;
+
+            for (unsigned int entryIdx = 0; entryIdx < lstSize(entryList); entryIdx++)
+            {
+                const StoragePosixWalkEntry *entry = lstGet(entryList, entryIdx);
+
+                if (!userSet || entry->userId != userId)
+                {
+                    struct passwd *userData = getpwuid(entry->userId);
+
+                    userSet = true;
+                    userId = entry->userId;
+                    user = userData == NULL ? NULL : strNew(userData->pw_name);
+                }
+
+                if (!groupSet || entry->groupId != groupId)
+                {
+                    struct group *groupData = getgrgid(entry->groupId);
+
+                    groupSet = true;
+                    groupId = entry->groupId;
+                    group = groupData == NULL ? NULL : strNew(groupData->gr_name);
+                }
+
+                StorageInfo info =
+                {
+                    .name = entry->name,
+                    .linkDestination = entry->linkDestination,
+                    .type = entry->type,
+                    .exists = true,
+                    .user = user,
+                    .group = group,
+                    .mode = entry->mode,
+                    .timeModified = entry->timeModified,
+                    .size = entry->size,
+                };
+
+                callback(callbackData, &info);
+            }
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(BOOL, result);
+}
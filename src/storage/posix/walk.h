@@ -0,0 +1,24 @@
+/***********************************************************************************************************************************
+Posix Storage Walk
+
+Recursively get info for all paths/files/links in a path using multiple threads.  Each thread scans one subpath at a time and queues
+the subpaths it finds so large trees (e.g. PGDATA) are scanned in parallel.  Entries are stat'd relative to the open directory so
+the full path does not need to be resolved for every entry.
+
+The name of each entry passed to the callback is relative to the path, with "." being the path itself.  The order of the callbacks
+is undefined.
+***********************************************************************************************************************************/
+#ifndef STORAGE_POSIX_WALK_H
+#define STORAGE_POSIX_WALK_H
+
+#include "storage/storage.h"
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+// Returns false if the path is missing.  If filter is set then only the entry in the path with that name (and everything below it)
+// is included.
+bool storagePosixWalk(
+    const String *path, const String *filter, unsigned int threadTotal, StorageInfoListCallback callback, void *callbackData);
+
+#endif
@@ -4,9 +4,17 @@ Remote Storage Protocol Handler
 #include "build.auto.h"
 
 #include "command/backup/pageChecksum.h"
+#include "command/backup/pageDelta.h"
 #include "common/compress/gzip/compress.h"
+#include "common/compress/gzip/compressParallel.h"
 #include "common/compress/gzip/decompress.h"
+#include "common/compress/lz4/compress.h"
+#include "common/compress/lz4/decompress.h"
+#include "common/compress/zst/compress.h"
+#include "common/compress/zst/decompress.h"
 #include "common/crypto/cipherBlock.h"
+#include "common/crypto/cipherChunk.h"
+#include "common/crypto/cipherDetect.h"
 #include "common/crypto/hash.h"
 #include "common/debug.h"
 #include "common/io/filter/sink.h"
@@ -16,6 +24,7 @@ Remote Storage Protocol Handler
 #include "common/memContext.h"
 #include "common/regExp.h"
 #include "config/config.h"
+#include "protocol/frame.h"
 #include "storage/remote/protocol.h"
 #include "storage/helper.h"
 #include "storage/storage.intern.h"
@@ -33,6 +42,7 @@ STRING_EXTERN(PROTOCOL_COMMAND_STORAGE_PATH_EXISTS_STR,             PROTOCOL_COM
 STRING_EXTERN(PROTOCOL_COMMAND_STORAGE_PATH_REMOVE_STR,             PROTOCOL_COMMAND_STORAGE_PATH_REMOVE);
 STRING_EXTERN(PROTOCOL_COMMAND_STORAGE_PATH_SYNC_STR,               PROTOCOL_COMMAND_STORAGE_PATH_SYNC);
 STRING_EXTERN(PROTOCOL_COMMAND_STORAGE_REMOVE_STR,                  PROTOCOL_COMMAND_STORAGE_REMOVE);
+STRING_EXTERN(PROTOCOL_COMMAND_STORAGE_REMOVE_LIST_STR,             PROTOCOL_COMMAND_STORAGE_REMOVE_LIST);
 
 /***********************************************************************************************************************************
 Regular expressions
@@ -70,14 +80,34 @@ storageRemoteFilterGroup(IoFilterGroup *filterGroup, const Variant *filterList)
 
         if (strEq(filterKey, GZIP_COMPRESS_FILTER_TYPE_STR))
             ioFilterGroupAdd(filterGroup, gzipCompressNewVar(filterParam));
+        else if (strEq(filterKey, GZIP_COMPRESS_PARALLEL_FILTER_TYPE_STR))
+            ioFilterGroupAdd(filterGroup, gzipCompressParallelNewVar(filterParam));
         else if (strEq(filterKey, GZIP_DECOMPRESS_FILTER_TYPE_STR))
             ioFilterGroupAdd(filterGroup, gzipDecompressNewVar(filterParam));
+#ifdef HAVE_LIBLZ4
+        else if (strEq(filterKey, LZ4_COMPRESS_FILTER_TYPE_STR))
+            ioFilterGroupAdd(filterGroup, lz4CompressNewVar(filterParam));
+        else if (strEq(filterKey, LZ4_DECOMPRESS_FILTER_TYPE_STR))
+            ioFilterGroupAdd(filterGroup, lz4DecompressNewVar(filterParam));
+#endif
+#ifdef HAVE_LIBZSTD
+        else if (strEq(filterKey, ZST_COMPRESS_FILTER_TYPE_STR))
+            ioFilterGroupAdd(filterGroup, zstCompressNewVar(filterParam));
+        else if (strEq(filterKey, ZST_DECOMPRESS_FILTER_TYPE_STR))
+            ioFilterGroupAdd(filterGroup, zstDecompressNewVar(filterParam));
+#endif
         else if (strEq(filterKey, CIPHER_BLOCK_FILTER_TYPE_STR))
             ioFilterGroupAdd(filterGroup, cipherBlockNewVar(filterParam));
+        else if (strEq(filterKey, CIPHER_CHUNK_FILTER_TYPE_STR))
+            ioFilterGroupAdd(filterGroup, cipherChunkNewVar(filterParam));
+        else if (strEq(filterKey, CIPHER_DETECT_FILTER_TYPE_STR))
+            ioFilterGroupAdd(filterGroup, cipherDetectNewVar(filterParam));
         else if (strEq(filterKey, CRYPTO_HASH_FILTER_TYPE_STR))
             ioFilterGroupAdd(filterGroup, cryptoHashNewVar(filterParam));
         else if (strEq(filterKey, PAGE_CHECKSUM_FILTER_TYPE_STR))
             ioFilterGroupAdd(filterGroup, pageChecksumNewVar(filterParam));
+        else if (strEq(filterKey, PAGE_DELTA_FILTER_TYPE_STR))
+            ioFilterGroupAdd(filterGroup, pageDeltaNewVar(filterParam));
         else if (strEq(filterKey, SINK_FILTER_TYPE_STR))
             ioFilterGroupAdd(filterGroup, ioSinkNew());
         else if (strEq(filterKey, SIZE_FILTER_TYPE_STR))
@@ -157,7 +187,8 @@ storageRemoteProtocol(const String *command, const VariantList *paramList, Proto
 
                     if (bufUsed(buffer) > 0)
                     {
-                        ioWriteStrLine(protocolServerIoWrite(server), strNewFmt(PROTOCOL_BLOCK_HEADER "%zu", bufUsed(buffer)));
+                        storageRemoteProtocolBlockWrite(
+                            protocolServerIoWrite(server), protocolServerBinary(server), (ssize_t)bufUsed(buffer));
                         ioWrite(protocolServerIoWrite(server), buffer);
                         ioWriteFlush(protocolServerIoWrite(server));
 
@@ -169,7 +200,7 @@ storageRemoteProtocol(const String *command, const VariantList *paramList, Proto
                 ioReadClose(fileRead);
 
                 // Write a zero block to show file is complete
-                ioWriteLine(protocolServerIoWrite(server), BUFSTRDEF(PROTOCOL_BLOCK_HEADER "0"));
+                storageRemoteProtocolBlockWrite(protocolServerIoWrite(server), protocolServerBinary(server), 0);
                 ioWriteFlush(protocolServerIoWrite(server));
 
                 // Push filter results
@@ -200,7 +231,7 @@ storageRemoteProtocol(const String *command, const VariantList *paramList, Proto
             do
             {
                 // How much data is remaining to write?
-                remaining = storageRemoteProtocolBlockSize(ioReadLine(protocolServerIoRead(server)));
+                remaining = storageRemoteProtocolBlockRead(protocolServerIoRead(server), protocolServerBinary(server));
 
                 // Write data
                 if (remaining > 0)
@@ -273,6 +304,30 @@ storageRemoteProtocol(const String *command, const VariantList *paramList, Proto
 
             protocolServerResponse(server, NULL);
         }
+        else if (strEq(command, PROTOCOL_COMMAND_STORAGE_REMOVE_LIST_STR))
+        {
+            const VariantList *fileList = varVarLst(varLstGet(paramList, 0));
+            bool errorOnMissing = varBool(varLstGet(paramList, 1));
+
+            // Build the paths
+            StringList *pathList = strLstNew();
+
+            for (unsigned int fileIdx = 0; fileIdx < varLstSize(fileList); fileIdx++)
+                strLstAdd(pathList, storagePathNP(storage, varStr(varLstGet(fileList, fileIdx))));
+
+            // Not all drivers implement removeList() so remove files individually when it is missing
+            if (interface.removeList != NULL)
+            {
+                interface.removeList(driver, pathList, errorOnMissing);
+            }
+            else
+            {
+                for (unsigned int fileIdx = 0; fileIdx < strLstSize(pathList); fileIdx++)
+                    interface.remove(driver, strLstGet(pathList, fileIdx), errorOnMissing);
+            }
+
+            protocolServerResponse(server, NULL);
+        }
         else
             found = false;
     }
@@ -314,3 +369,60 @@ storageRemoteProtocolBlockSize(const String *message)
 
     FUNCTION_LOG_RETURN(SSIZE, (ssize_t)cvtZToInt(strPtr(message) + sizeof(PROTOCOL_BLOCK_HEADER) - 1));
 }
+
+/***********************************************************************************************************************************
+Read the size of the next transfer block
+
+When binary frames have been negotiated the size is a binary header, otherwise it is a text line parsed by
+storageRemoteProtocolBlockSize().
+***********************************************************************************************************************************/
+ssize_t
+storageRemoteProtocolBlockRead(IoRead *read, bool binary)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(IO_READ, read);
+        FUNCTION_LOG_PARAM(BOOL, binary);
+    FUNCTION_LOG_END();
+
+    ASSERT(read != NULL);
+
+    ssize_t result = 0;
+
+    if (binary)
+        result = protocolFrameBlockRead(read);
+    else
+    {
+        String *message = ioReadLine(read);
+        result = storageRemoteProtocolBlockSize(message);
+        strFree(message);
+    }
+
+    FUNCTION_LOG_RETURN(SSIZE, result);
+}
+
+/***********************************************************************************************************************************
+Write the size of the next transfer block.  The write is not flushed.
+***********************************************************************************************************************************/
+void
+storageRemoteProtocolBlockWrite(IoWrite *write, bool binary, ssize_t size)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(IO_WRITE, write);
+        FUNCTION_LOG_PARAM(BOOL, binary);
+        FUNCTION_LOG_PARAM(SSIZE, size);
+    FUNCTION_LOG_END();
+
+    ASSERT(write != NULL);
+    ASSERT(size >= -1);
+
+    if (binary)
+        protocolFrameBlockWrite(write, size);
+    else
+    {
+        String *message = strNewFmt(PROTOCOL_BLOCK_HEADER "%zd", size);
+        ioWriteStrLine(write, message);
+        strFree(message);
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
@@ -29,6 +29,8 @@ Constants
     STRING_DECLARE(PROTOCOL_COMMAND_STORAGE_PATH_EXISTS_STR);
 #define PROTOCOL_COMMAND_STORAGE_REMOVE                             "storageRemove"
     STRING_DECLARE(PROTOCOL_COMMAND_STORAGE_REMOVE_STR);
+#define PROTOCOL_COMMAND_STORAGE_REMOVE_LIST                        "storageRemoveList"
+    STRING_DECLARE(PROTOCOL_COMMAND_STORAGE_REMOVE_LIST_STR);
 #define PROTOCOL_COMMAND_STORAGE_PATH_REMOVE                        "storagePathRemove"
     STRING_DECLARE(PROTOCOL_COMMAND_STORAGE_PATH_REMOVE_STR);
 #define PROTOCOL_COMMAND_STORAGE_PATH_SYNC                          "storagePathSync"
@@ -37,7 +39,9 @@ Constants
 /***********************************************************************************************************************************
 Functions
 ***********************************************************************************************************************************/
+ssize_t storageRemoteProtocolBlockRead(IoRead *read, bool binary);
 ssize_t storageRemoteProtocolBlockSize(const String *message);
+void storageRemoteProtocolBlockWrite(IoWrite *write, bool binary, ssize_t size);
 bool storageRemoteProtocol(const String *command, const VariantList *paramList, ProtocolServer *server);
 
 #endif
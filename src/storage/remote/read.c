@@ -118,7 +118,8 @@ storageReadRemote(THIS_VOID, Buffer *buffer, bool block)
             {
                 MEM_CONTEXT_TEMP_BEGIN()
                 {
-                    this->remaining = (size_t)storageRemoteProtocolBlockSize(ioReadLine(protocolClientIoRead(this->client)));
+                    this->remaining = (size_t)storageRemoteProtocolBlockRead(
+                        protocolClientIoRead(this->client), protocolClientBinary(this->client));
 
                     if (this->remaining == 0)
                     {
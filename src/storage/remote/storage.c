@@ -321,6 +321,36 @@ storageRemoteRemove(THIS_VOID, const String *file, bool errorOnMissing)
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Remove a list of files with a single request
+***********************************************************************************************************************************/
+static void
+storageRemoteRemoveList(THIS_VOID, const StringList *fileList, bool errorOnMissing)
+{
+    THIS(StorageRemote);
+
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE_REMOTE, this);
+        FUNCTION_LOG_PARAM(STRING_LIST, fileList);
+        FUNCTION_LOG_PARAM(BOOL, errorOnMissing);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(fileList != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        ProtocolCommand *command = protocolCommandNew(PROTOCOL_COMMAND_STORAGE_REMOVE_LIST_STR);
+        protocolCommandParamAdd(command, varNewVarLst(varLstNewStrLst(fileList)));
+        protocolCommandParamAdd(command, VARBOOL(errorOnMissing));
+
+        protocolClientExecute(this->client, command, false);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 New object
 ***********************************************************************************************************************************/
@@ -361,11 +391,15 @@ storageRemoteNew(
         }
         MEM_CONTEXT_TEMP_END();
 
+        // Files cannot be moved on the remote so the move feature does not apply
+        feature &= ~((uint64_t)1 << storageFeatureMove);
+
         this = storageNewP(
             STORAGE_REMOTE_TYPE_STR, NULL, modeFile, modePath, write, pathExpressionFunction, driver, .feature = feature,
             .exists = storageRemoteExists, .info = storageRemoteInfo, .list = storageRemoteList, .newRead = storageRemoteNewRead,
             .newWrite = storageRemoteNewWrite, .pathCreate = storageRemotePathCreate, .pathExists = storageRemotePathExists,
-            .pathRemove = storageRemotePathRemove, .pathSync = storageRemotePathSync, .remove = storageRemoteRemove);
+            .pathRemove = storageRemotePathRemove, .pathSync = storageRemotePathSync, .remove = storageRemoteRemove,
+            .removeList = storageRemoteRemoveList);
     }
     MEM_CONTEXT_NEW_END();
 
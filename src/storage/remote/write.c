@@ -46,7 +46,7 @@ Close file on the remote
 ***********************************************************************************************************************************/
 OBJECT_DEFINE_FREE_RESOURCE_BEGIN(STORAGE_WRITE_REMOTE, LOG, logLevelTrace)
 {
-    ioWriteLine(protocolClientIoWrite(this->client), BUFSTRDEF(PROTOCOL_BLOCK_HEADER "-1"));
+    storageRemoteProtocolBlockWrite(protocolClientIoWrite(this->client), protocolClientBinary(this->client), -1);
     ioWriteFlush(protocolClientIoWrite(this->client));
     protocolClientReadOutput(this->client, false);
 }
@@ -121,7 +121,8 @@ storageWriteRemote(THIS_VOID, const Buffer *buffer)
     ASSERT(this != NULL);
     ASSERT(buffer != NULL);
 
-    ioWriteStrLine(protocolClientIoWrite(this->client), strNewFmt(PROTOCOL_BLOCK_HEADER "%zu", bufUsed(buffer)));
+    storageRemoteProtocolBlockWrite(
+        protocolClientIoWrite(this->client), protocolClientBinary(this->client), (ssize_t)bufUsed(buffer));
     ioWrite(protocolClientIoWrite(this->client), buffer);
     ioWriteFlush(protocolClientIoWrite(this->client));
 
@@ -149,7 +150,7 @@ storageWriteRemoteClose(THIS_VOID)
     // Close if the file has not already been closed
     if (this->client != NULL)
     {
-        ioWriteLine(protocolClientIoWrite(this->client), BUFSTRDEF(PROTOCOL_BLOCK_HEADER "0"));
+        storageRemoteProtocolBlockWrite(protocolClientIoWrite(this->client), protocolClientBinary(this->client), 0);
         ioWriteFlush(protocolClientIoWrite(this->client));
         ioFilterGroupResultAllSet(ioWriteFilterGroup(storageWriteIo(this->write)), protocolClientReadOutput(this->client, true));
         this->client = NULL;
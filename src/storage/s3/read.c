@@ -12,22 +12,46 @@ S3 Storage Read
 #include "common/log.h"
 #include "common/memContext.h"
 #include "common/object.h"
+#include "common/type/convert.h"
+#include "common/type/list.h"
 #include "storage/s3/read.h"
 #include "storage/read.intern.h"
 
+/***********************************************************************************************************************************
+Number of times a read that makes no progress will be resumed before an error is thrown
+***********************************************************************************************************************************/
+#define STORAGE_READ_S3_RETRY_MAX                                   2
+
 /***********************************************************************************************************************************
 Object type
 ***********************************************************************************************************************************/
 #define STORAGE_READ_S3_TYPE                                        StorageReadS3
 #define STORAGE_READ_S3_PREFIX                                      storageReadS3
 
+typedef struct StorageReadS3Range
+{
+    uint64_t offset;                                                // Offset of the range in the file
+    uint64_t size;                                                  // Size of the range
+    HttpClient *httpClient;                                         // Client waiting on the response (NULL if the send failed)
+} StorageReadS3Range;
+
 typedef struct StorageReadS3
 {
     MemContext *memContext;                                         // Object mem context
     StorageReadInterface interface;                                 // Interface
     StorageS3 *storage;                                             // Storage that created this object
+    size_t rangeSize;                                               // Size of ranges when the file is read in ranges
+    unsigned int rangeMax;                                          // Maximum ranges to download at the same time
 
     HttpClient *httpClient;                                         // Http client for requests
+    String *eTag;                                                   // ETag of the file when it was opened
+    bool resumable;                                                 // Is the file size known so failed reads can be resumed?
+    uint64_t size;                                                  // Size of the file
+    uint64_t offset;                                                // Offset of the next byte to read
+    uint64_t rangeEnd;                                              // End of the range currently being read
+    uint64_t rangeNext;                                             // Offset of the next range to request
+    List *rangeList;                                                // Ranges that have been requested but not read
+    unsigned int retryRemaining;                                    // Resumes remaining before a read with no progress errors
 } StorageReadS3;
 
 /***********************************************************************************************************************************
@@ -39,14 +63,298 @@ Macros for function logging
     objToLog(value, "StorageReadS3", buffer, bufferSize)
 
 /***********************************************************************************************************************************
-Mark http client as done so it can be reused
+Mark http clients as done so they can be reused
 ***********************************************************************************************************************************/
 OBJECT_DEFINE_FREE_RESOURCE_BEGIN(STORAGE_READ_S3, LOG, logLevelTrace)
 {
-    httpClientDone(this->httpClient);
+    if (this->httpClient != NULL)
+        httpClientDone(this->httpClient);
+
+    for (unsigned int rangeIdx = 0; rangeIdx < lstSize(this->rangeList); rangeIdx++)
+    {
+        StorageReadS3Range *range = lstGet(this->rangeList, rangeIdx);
+
+        if (range->httpClient != NULL)
+            httpClientDone(range->httpClient);
+    }
 }
 OBJECT_DEFINE_FREE_RESOURCE_END(LOG);
 
+/***********************************************************************************************************************************
+Build the header for a range request (end is the offset after the last byte)
+
+Once the file has been opened the range is only returned if the file still has the same ETag so a file that is overwritten during
+the read cannot be assembled from different versions.
+***********************************************************************************************************************************/
+static HttpHeader *
+storageReadS3RangeHeader(const StorageReadS3 *this, uint64_t offset, uint64_t end)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_READ_S3, this);
+        FUNCTION_TEST_PARAM(UINT64, offset);
+        FUNCTION_TEST_PARAM(UINT64, end);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(offset < end);
+
+    HttpHeader *result = httpHeaderNew(NULL);
+    httpHeaderAdd(result, HTTP_HEADER_RANGE_STR, strNewFmt("bytes=%" PRIu64 "-%" PRIu64, offset, end - 1));
+
+    if (this->eTag != NULL)
+        httpHeaderAdd(result, HTTP_HEADER_IF_MATCH_STR, this->eTag);
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Error if the file has changed since it was opened
+
+S3 returns 412 (Precondition Failed) when the If-Match header does not match.  The ETag of a successful response is checked as well
+in case the server ignores If-Match.
+***********************************************************************************************************************************/
+static void
+storageReadS3RangeCheck(const StorageReadS3 *this, HttpClient *httpClient)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_READ_S3, this);
+        FUNCTION_LOG_PARAM(HTTP_CLIENT, httpClient);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(httpClient != NULL);
+
+    if (this->eTag != NULL)
+    {
+        unsigned int responseCode = httpClientResponseCode(httpClient);
+        const String *eTag = httpHeaderGet(httpClientReponseHeader(httpClient), HTTP_HEADER_ETAG_STR);
+
+        if (responseCode == HTTP_RESPONSE_CODE_PRECONDITION_FAILED ||
+            (responseCode == HTTP_RESPONSE_CODE_PARTIAL_CONTENT && (eTag == NULL || !strEq(eTag, this->eTag))))
+        {
+            httpClientDone(httpClient);
+
+            THROW_FMT(
+                FileReadError, "unable to read '%s' because it was changed after being opened", strPtr(this->interface.name));
+        }
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Request the remainder of the current range
+
+This is used when a range could not be requested in advance or when the read of a range failed, so only the part of the file that
+has not been read is requested again.  The request has the usual retries and error reporting, so a file that has changed since it
+was opened is reported as a failed request (412).
+***********************************************************************************************************************************/
+static void
+storageReadS3Resume(StorageReadS3 *this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_READ_S3, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->offset < this->rangeEnd);
+
+    // The connection cannot be reused since the content was not completely read
+    if (this->httpClient != NULL)
+    {
+        httpClientDone(this->httpClient);
+        this->httpClient = NULL;
+    }
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        HttpClient *httpClient = storageS3Request(
+            this->storage, HTTP_VERB_GET_STR, this->interface.name, NULL,
+            storageReadS3RangeHeader(this, this->offset, this->rangeEnd), NULL, false, false).httpClient;
+
+        // The server must return only the requested range of the same file or the file will be corrupted
+        storageReadS3RangeCheck(this, httpClient);
+
+        if (httpClientResponseCode(httpClient) != HTTP_RESPONSE_CODE_PARTIAL_CONTENT)
+        {
+            httpClientDone(httpClient);
+
+            THROW_FMT(
+                ProtocolError, "S3 range request for '%s' failed with %u: %s", strPtr(this->interface.name),
+                httpClientResponseCode(httpClient), strPtr(httpClientResponseMessage(httpClient)));
+        }
+
+        this->httpClient = httpClient;
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Request ranges until the maximum are in progress
+
+Ranges are sent without waiting for the response so the data for each range is transferred on a separate connection while the
+current range is being read.  If the send fails the range will be requested again when it is read.
+***********************************************************************************************************************************/
+static void
+storageReadS3RangeSend(StorageReadS3 *this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_READ_S3, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    // The range currently being read counts toward the maximum
+    while (lstSize(this->rangeList) + 1 < this->rangeMax && this->rangeNext < this->size)
+    {
+        StorageReadS3Range range =
+        {
+            .offset = this->rangeNext,
+            .size = this->size - this->rangeNext > this->rangeSize ? this->rangeSize : this->size - this->rangeNext,
+        };
+
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            TRY_BEGIN()
+            {
+                range.httpClient = storageS3RequestSend(
+                    this->storage, HTTP_VERB_GET_STR, this->interface.name, NULL,
+                    storageReadS3RangeHeader(this, range.offset, range.offset + range.size), NULL);
+            }
+            CATCH_ANY()
+            {
+                LOG_DEBUG("retry %s: %s", errorTypeName(errorType()), errorMessage());
+            }
+            TRY_END();
+        }
+        MEM_CONTEXT_TEMP_END();
+
+        lstAdd(this->rangeList, &range);
+        this->rangeNext += range.size;
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Start reading the next range
+***********************************************************************************************************************************/
+static void
+storageReadS3RangeNext(StorageReadS3 *this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_READ_S3, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(lstSize(this->rangeList) > 0);
+
+    // Done with the prior range.  The connection can be reused for another range since all the content has been read, unless the
+    // first range was read from a request for the entire file.  In that case the connection is closed rather than reading the rest
+    // of the file.
+    if (this->httpClient != NULL)
+    {
+        httpClientDone(this->httpClient);
+        this->httpClient = NULL;
+    }
+
+    StorageReadS3Range range = *(StorageReadS3Range *)lstGet(this->rangeList, 0);
+    lstRemove(this->rangeList, 0);
+
+    ASSERT(range.offset == this->offset);
+    this->rangeEnd = range.offset + range.size;
+
+    // Request another range to replace this one
+    storageReadS3RangeSend(this);
+
+    // Read the response for this range
+    if (range.httpClient != NULL)
+    {
+        bool response = false;
+
+        TRY_BEGIN()
+        {
+            httpClientResponse(range.httpClient, false);
+            response = true;
+        }
+        CATCH_ANY()
+        {
+            LOG_DEBUG("retry %s: %s", errorTypeName(errorType()), errorMessage());
+        }
+        TRY_END();
+
+        if (response)
+        {
+            // A file that has changed cannot be fixed by requesting the range again
+            storageReadS3RangeCheck(this, range.httpClient);
+
+            if (httpClientResponseCode(range.httpClient) == HTTP_RESPONSE_CODE_PARTIAL_CONTENT)
+                this->httpClient = range.httpClient;
+            else
+            {
+                LOG_DEBUG(
+                    "retry %u: %s", httpClientResponseCode(range.httpClient),
+                    strPtr(httpClientResponseMessage(range.httpClient)));
+                httpClientDone(range.httpClient);
+            }
+        }
+    }
+
+    // If the range could not be sent or the response was not successful then request it again
+    if (this->httpClient == NULL)
+        storageReadS3Resume(this);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Request the first range of the file
+
+The connection can then be reused for a later range once the first range has been read.  If the range cannot be returned (e.g. the
+file is empty) or the request fails then the http client is not set and the entire file should be requested instead.
+***********************************************************************************************************************************/
+static void
+storageReadS3OpenRange(StorageReadS3 *this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_READ_S3, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->httpClient == NULL);
+    ASSERT(this->eTag == NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        TRY_BEGIN()
+        {
+            HttpClient *httpClient = storageS3RequestSend(
+                this->storage, HTTP_VERB_GET_STR, this->interface.name, NULL, storageReadS3RangeHeader(this, 0, this->rangeSize),
+                NULL);
+            httpClientResponse(httpClient, false);
+
+            // A missing file is handled the same as for a request for the entire file
+            if (httpClientResponseCodeOk(httpClient) || httpClientResponseCode(httpClient) == HTTP_RESPONSE_CODE_NOT_FOUND)
+                this->httpClient = httpClient;
+            else
+            {
+                LOG_DEBUG("retry %u: %s", httpClientResponseCode(httpClient), strPtr(httpClientResponseMessage(httpClient)));
+                httpClientDone(httpClient);
+            }
+        }
+        CATCH_ANY()
+        {
+            LOG_DEBUG("retry %s: %s", errorTypeName(errorType()), errorMessage());
+        }
+        TRY_END();
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Open the file
 ***********************************************************************************************************************************/
@@ -64,17 +372,77 @@ storageReadS3Open(THIS_VOID)
 
     bool result = false;
 
-    // Request the file
-    this->httpClient = storageS3Request(this->storage, HTTP_VERB_GET_STR, this->interface.name, NULL, NULL, false, true).httpClient;
+    // Request only the first range if the file can be read in ranges
+    if (this->rangeMax > 1)
+        storageReadS3OpenRange(this);
+
+    // Else request the entire file
+    if (this->httpClient == NULL)
+    {
+        this->httpClient = storageS3Request(
+            this->storage, HTTP_VERB_GET_STR, this->interface.name, NULL, NULL, NULL, false, true).httpClient;
+    }
 
     if (httpClientResponseCodeOk(this->httpClient))
     {
-        memContextCallbackSet(this->memContext, storageReadS3FreeResource, this);
+        // Ranges must match the version of the file that was opened
+        const HttpHeader *responseHeader = httpClientReponseHeader(this->httpClient);
+
+        MEM_CONTEXT_BEGIN(this->memContext)
+        {
+            this->eTag = strDup(httpHeaderGet(responseHeader, HTTP_HEADER_ETAG_STR));
+        }
+        MEM_CONTEXT_END();
+
+        // If the file size is known then failed reads can be resumed and large files can be read in ranges
+        const String *contentLength = httpHeaderGet(responseHeader, HTTP_HEADER_CONTENT_LENGTH_STR);
+
+        if (contentLength != NULL)
+        {
+            this->resumable = true;
+            this->retryRemaining = STORAGE_READ_S3_RETRY_MAX;
+
+            // If only the first range was returned then the file size is after the / in the content range, e.g. bytes 0-15/40
+            if (httpClientResponseCode(this->httpClient) == HTTP_RESPONSE_CODE_PARTIAL_CONTENT)
+            {
+                const String *contentRange = httpHeaderGet(responseHeader, HTTP_HEADER_CONTENT_RANGE_STR);
+
+                if (contentRange == NULL || strChr(contentRange, '/') == -1)
+                {
+                    THROW_FMT(
+                        FormatError, "S3 range request for '%s' did not return the file size", strPtr(this->interface.name));
+                }
+
+                this->size = cvtZToUInt64(strPtr(contentRange) + strChr(contentRange, '/') + 1);
+                this->rangeEnd = cvtZToUInt64(strPtr(contentLength));
+            }
+            // Else the entire file was returned
+            else
+            {
+                this->size = cvtZToUInt64(strPtr(contentLength));
+                this->rangeEnd = this->size;
+
+                // Read the first range from this request
+                if (this->rangeMax > 1 && this->size > this->rangeSize)
+                    this->rangeEnd = this->rangeSize;
+            }
+
+            // Request the following ranges on separate connections
+            this->rangeNext = this->rangeEnd;
+            storageReadS3RangeSend(this);
+        }
+
         result = true;
     }
     // Else error unless ignore missing
-    else if (!this->interface.ignoreMissing)
-        THROW_FMT(FileMissingError, "unable to open '%s': No such file or directory", strPtr(this->interface.name));
+    else
+    {
+        // The client is not busy so it may be used by another request
+        this->httpClient = NULL;
+
+        if (!this->interface.ignoreMissing)
+            THROW_FMT(FileMissingError, "unable to open '%s': No such file or directory", strPtr(this->interface.name));
+    }
 
     FUNCTION_LOG_RETURN(BOOL, result);
 }
@@ -93,11 +461,68 @@ storageReadS3(THIS_VOID, Buffer *buffer, bool block)
         FUNCTION_LOG_PARAM(BOOL, block);
     FUNCTION_LOG_END();
 
-    ASSERT(this != NULL && this->httpClient != NULL);
-    ASSERT(httpClientIoRead(this->httpClient) != NULL);
+    ASSERT(this != NULL);
     ASSERT(buffer != NULL && !bufFull(buffer));
 
-    FUNCTION_LOG_RETURN(SIZE, ioRead(httpClientIoRead(this->httpClient), buffer));
+    size_t result = 0;
+
+    // If the file size is not known then read until the response is complete
+    if (!this->resumable)
+    {
+        ASSERT(this->httpClient != NULL && httpClientIoRead(this->httpClient) != NULL);
+
+        result = ioRead(httpClientIoRead(this->httpClient), buffer);
+    }
+    else
+    {
+        // Start reading the next range when the current range is complete
+        if (this->offset == this->rangeEnd)
+            storageReadS3RangeNext(this);
+
+        ASSERT(this->httpClient != NULL && httpClientIoRead(this->httpClient) != NULL);
+
+        // Limit the buffer so the read does not go past the end of the range
+        size_t bufferUsed = bufUsed(buffer);
+        bool resume = false;
+
+        if (bufRemains(buffer) > this->rangeEnd - this->offset)
+            bufLimitSet(buffer, bufSize(buffer) - (bufRemains(buffer) - (size_t)(this->rangeEnd - this->offset)));
+
+        TRY_BEGIN()
+        {
+            ioRead(httpClientIoRead(this->httpClient), buffer);
+        }
+        CATCH_ANY()
+        {
+            // Error if nothing has been read since the last time the read was resumed
+            if (bufUsed(buffer) == bufferUsed && this->retryRemaining == 0)
+            {
+                bufLimitClear(buffer);
+                RETHROW();
+            }
+
+            LOG_DEBUG("retry %s: %s", errorTypeName(errorType()), errorMessage());
+            resume = true;
+        }
+        TRY_END();
+
+        // Clear limit (this works even if the limit was not set and it is easier than checking)
+        bufLimitClear(buffer);
+
+        result = bufUsed(buffer) - bufferUsed;
+        this->offset += result;
+
+        // Only the remainder of the range needs to be requested again after an error
+        if (resume)
+        {
+            this->retryRemaining = result > 0 ? STORAGE_READ_S3_RETRY_MAX : this->retryRemaining - 1;
+
+            if (this->offset < this->rangeEnd)
+                storageReadS3Resume(this);
+        }
+    }
+
+    FUNCTION_LOG_RETURN(SIZE, result);
 }
 
 /***********************************************************************************************************************************
@@ -113,11 +538,11 @@ storageReadS3Close(THIS_VOID)
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
-    ASSERT(this->httpClient != NULL);
 
-    memContextCallbackClear(this->memContext);
+    // The free callback will have nothing left to do after this
     storageReadS3FreeResource(this);
     this->httpClient = NULL;
+    lstClear(this->rangeList);
 
     FUNCTION_LOG_RETURN_VOID();
 }
@@ -134,26 +559,41 @@ storageReadS3Eof(THIS_VOID)
         FUNCTION_TEST_PARAM(STORAGE_READ_S3, this);
     FUNCTION_TEST_END();
 
-    ASSERT(this != NULL && this->httpClient != NULL);
-    ASSERT(httpClientIoRead(this->httpClient) != NULL);
+    ASSERT(this != NULL);
+
+    bool result = false;
 
-    FUNCTION_TEST_RETURN(ioReadEof(httpClientIoRead(this->httpClient)));
+    // If the file size is known then eof is when all bytes have been read
+    if (this->resumable)
+        result = this->offset == this->size;
+    else
+    {
+        ASSERT(this->httpClient != NULL && httpClientIoRead(this->httpClient) != NULL);
+
+        result = ioReadEof(httpClientIoRead(this->httpClient));
+    }
+
+    FUNCTION_TEST_RETURN(result);
 }
 
 /***********************************************************************************************************************************
 Create a new file
 ***********************************************************************************************************************************/
 StorageRead *
-storageReadS3New(StorageS3 *storage, const String *name, bool ignoreMissing)
+storageReadS3New(StorageS3 *storage, const String *name, bool ignoreMissing, size_t rangeSize, unsigned int rangeMax)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(STORAGE_S3, storage);
         FUNCTION_LOG_PARAM(STRING, name);
         FUNCTION_LOG_PARAM(BOOL, ignoreMissing);
+        FUNCTION_LOG_PARAM(SIZE, rangeSize);
+        FUNCTION_LOG_PARAM(UINT, rangeMax);
     FUNCTION_LOG_END();
 
     ASSERT(storage != NULL);
     ASSERT(name != NULL);
+    ASSERT(rangeSize > 0);
+    ASSERT(rangeMax > 0);
 
     StorageRead *this = NULL;
 
@@ -162,6 +602,10 @@ storageReadS3New(StorageS3 *storage, const String *name, bool ignoreMissing)
         StorageReadS3 *driver = memNew(sizeof(StorageReadS3));
         driver->memContext = MEM_CONTEXT_NEW();
 
+        // Http clients are marked done when this context is freed.  It must be created before the range list so the list is not
+        // freed before the clients it holds.
+        memContextCallbackSet(memContextNew("StorageReadS3Guard"), storageReadS3FreeResource, driver);
+
         driver->interface = (StorageReadInterface)
         {
             .type = STORAGE_S3_TYPE_STR,
@@ -178,6 +622,9 @@ storageReadS3New(StorageS3 *storage, const String *name, bool ignoreMissing)
         };
 
         driver->storage = storage;
+        driver->rangeSize = rangeSize;
+        driver->rangeMax = rangeMax;
+        driver->rangeList = lstNew(sizeof(StorageReadS3Range));
 
         this = storageReadNew(driver, &driver->interface);
     }
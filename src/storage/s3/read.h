@@ -10,6 +10,6 @@ S3 Storage Read
 /***********************************************************************************************************************************
 Constructor
 ***********************************************************************************************************************************/
-StorageRead *storageReadS3New(StorageS3 *storage, const String *name, bool ignoreMissing);
+StorageRead *storageReadS3New(StorageS3 *storage, const String *name, bool ignoreMissing, size_t rangeSize, unsigned int rangeMax);
 
 #endif
@@ -30,7 +30,7 @@ S3 http headers
 ***********************************************************************************************************************************/
 STRING_STATIC(S3_HEADER_AUTHORIZATION_STR,                          "authorization");
 STRING_STATIC(S3_HEADER_HOST_STR,                                   "host");
-STRING_STATIC(S3_HEADER_CONTENT_SHA256_STR,                         "x-amz-content-sha256");
+STRING_EXTERN(S3_HEADER_CONTENT_SHA256_STR,                         S3_HEADER_CONTENT_SHA256);
 STRING_STATIC(S3_HEADER_DATE_STR,                                   "x-amz-date");
 STRING_STATIC(S3_HEADER_TOKEN_STR,                                  "x-amz-security-token");
 
@@ -95,7 +95,9 @@ struct StorageS3
     const String *accessKey;                                        // Access key
     const String *secretAccessKey;                                  // Secret access key
     const String *securityToken;                                    // Security token, if any
-    size_t partSize;                                                // Part size for multi-part upload
+    size_t partSize;                                                // Part size for multi-part upload and ranged download
+    unsigned int uploadMax;                                         // Maximum parts to upload at the same time for each file
+    unsigned int downloadMax;                                       // Maximum ranges to download at the same time for each file
     unsigned int deleteMax;                                         // Maximum objects that can be deleted in one request
     const String *bucketEndpoint;                                   // Set to {bucket}.{endpoint}
     unsigned int port;                                              // Host port
@@ -231,19 +233,96 @@ storageS3Auth(
     FUNCTION_TEST_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Format a binary md5 hash for the content-md5 header
+***********************************************************************************************************************************/
+String *
+storageS3ContentMd5(const Buffer *md5)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BUFFER, md5);
+    FUNCTION_TEST_END();
+
+    ASSERT(md5 != NULL);
+    ASSERT(bufUsed(md5) == HASH_TYPE_M5_SIZE);
+
+    char md5Hash[HASH_TYPE_MD5_SIZE_HEX];
+    encodeToStr(encodeBase64, bufPtr(md5), HASH_TYPE_M5_SIZE, md5Hash);
+
+    FUNCTION_TEST_RETURN(strNew(md5Hash));
+}
+
+/***********************************************************************************************************************************
+Generate request headers, including content length, content md5, and authorization
+
+Additional headers (e.g. range) may be passed in header and will be included in the signature.  If the content md5 and sha256
+headers are passed (e.g. because they were calculated as the body was filled) then they will not be calculated here.
+***********************************************************************************************************************************/
+static HttpHeader *
+storageS3RequestHeader(
+    StorageS3 *this, const String *verb, const String *uri, const HttpQuery *query, const HttpHeader *header, const Buffer *body)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_S3, this);
+        FUNCTION_TEST_PARAM(STRING, verb);
+        FUNCTION_TEST_PARAM(STRING, uri);
+        FUNCTION_TEST_PARAM(HTTP_QUERY, query);
+        FUNCTION_TEST_PARAM(HTTP_HEADER, header);
+        FUNCTION_TEST_PARAM(BUFFER, body);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(verb != NULL);
+    ASSERT(uri != NULL);
+
+    // Create header list (starting with additional headers, if any) and add content length
+    HttpHeader *result = header == NULL ?
+        httpHeaderNew(this->headerRedactList) : httpHeaderDup(header, this->headerRedactList);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Set content length
+        httpHeaderAdd(
+            result, HTTP_HEADER_CONTENT_LENGTH_STR,
+            body == NULL || bufUsed(body) == 0 ? ZERO_STR : strNewFmt("%zu", bufUsed(body)));
+
+        // Calculate content-md5 header and payload hash if there is content.  Both hashes are calculated in a single pass over the
+        // content.
+        const String *payloadHash = strDup(httpHeaderGet(result, S3_HEADER_CONTENT_SHA256_STR));
+
+        if (body != NULL && (payloadHash == NULL || httpHeaderGet(result, HTTP_HEADER_CONTENT_MD5_STR) == NULL))
+        {
+            CryptoHashMany *hash = cryptoHashManyNew(strLstAdd(strLstAdd(strLstNew(), HASH_TYPE_MD5_STR), HASH_TYPE_SHA256_STR));
+            cryptoHashManyProcess(hash, body);
+
+            httpHeaderPut(result, HTTP_HEADER_CONTENT_MD5_STR, storageS3ContentMd5(cryptoHashManyResult(hash, 0)));
+            payloadHash = bufHex(cryptoHashManyResult(hash, 1));
+        }
+
+        // Generate authorization header
+        storageS3Auth(
+            this, verb, httpUriEncode(uri, true), query, storageS3DateTime(time(NULL)), result,
+            payloadHash == NULL ? HASH_TYPE_SHA256_ZERO_STR : payloadHash);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(result);
+}
+
 /***********************************************************************************************************************************
 Process S3 request
 ***********************************************************************************************************************************/
 StorageS3RequestResult
 storageS3Request(
-    StorageS3 *this, const String *verb, const String *uri, const HttpQuery *query, const Buffer *body, bool returnContent,
-    bool allowMissing)
+    StorageS3 *this, const String *verb, const String *uri, const HttpQuery *query, const HttpHeader *header, const Buffer *body,
+    bool returnContent, bool allowMissing)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STORAGE_S3, this);
         FUNCTION_LOG_PARAM(STRING, verb);
         FUNCTION_LOG_PARAM(STRING, uri);
         FUNCTION_LOG_PARAM(HTTP_QUERY, query);
+        FUNCTION_LOG_PARAM(HTTP_HEADER, header);
         FUNCTION_LOG_PARAM(BUFFER, body);
         FUNCTION_LOG_PARAM(BOOL, returnContent);
         FUNCTION_LOG_PARAM(BOOL, allowMissing);
@@ -263,26 +342,8 @@ storageS3Request(
 
         MEM_CONTEXT_TEMP_BEGIN()
         {
-            // Create header list and add content length
-            HttpHeader *requestHeader = httpHeaderNew(this->headerRedactList);
-
-            // Set content length
-            httpHeaderAdd(
-                requestHeader, HTTP_HEADER_CONTENT_LENGTH_STR,
-                body == NULL || bufUsed(body) == 0 ? ZERO_STR : strNewFmt("%zu", bufUsed(body)));
-
-            // Calculate content-md5 header if there is content
-            if (body != NULL)
-            {
-                char md5Hash[HASH_TYPE_MD5_SIZE_HEX];
-                encodeToStr(encodeBase64, bufPtr(cryptoHashOne(HASH_TYPE_MD5_STR, body)), HASH_TYPE_M5_SIZE, md5Hash);
-                httpHeaderAdd(requestHeader, HTTP_HEADER_CONTENT_MD5_STR, STR(md5Hash));
-            }
-
-            // Generate authorization header
-            storageS3Auth(
-                this, verb, httpUriEncode(uri, true), query, storageS3DateTime(time(NULL)), requestHeader,
-                body == NULL || bufUsed(body) == 0 ? HASH_TYPE_SHA256_ZERO_STR : bufHex(cryptoHashOne(HASH_TYPE_SHA256_STR, body)));
+            // Generate request headers
+            HttpHeader *requestHeader = storageS3RequestHeader(this, verb, uri, query, header, body);
 
             // Get an http client
             HttpClient *httpClient = httpClientCacheGet(this->httpClientCache);
@@ -389,6 +450,45 @@ storageS3Request(
     FUNCTION_LOG_RETURN(STORAGE_S3_REQUEST_RESULT, result);
 }
 
+/***********************************************************************************************************************************
+Send an S3 request without waiting for the response
+
+The response must be read from the returned http client with httpClientResponse().  The body is written in a thread so it must not
+be modified or freed until the response has been read.  Errors are not retried or reported here so the caller should fall back to
+storageS3Request() if the request or response fails.
+***********************************************************************************************************************************/
+HttpClient *
+storageS3RequestSend(
+    StorageS3 *this, const String *verb, const String *uri, const HttpQuery *query, const HttpHeader *header, const Buffer *body)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE_S3, this);
+        FUNCTION_LOG_PARAM(STRING, verb);
+        FUNCTION_LOG_PARAM(STRING, uri);
+        FUNCTION_LOG_PARAM(HTTP_QUERY, query);
+        FUNCTION_LOG_PARAM(HTTP_HEADER, header);
+        FUNCTION_LOG_PARAM(BUFFER, body);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(verb != NULL);
+    ASSERT(uri != NULL);
+
+    HttpClient *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        HttpHeader *requestHeader = storageS3RequestHeader(this, verb, uri, query, header, body);
+
+        // Get an http client that is not busy and send the request
+        result = httpClientCacheGet(this->httpClientCache);
+        httpClientRequestSend(result, verb, uri, query, requestHeader, body);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(HTTP_CLIENT, result);
+}
+
 /***********************************************************************************************************************************
 General function for listing files to be used by other list routines
 ***********************************************************************************************************************************/
@@ -467,7 +567,7 @@ storageS3ListInternal(
 
                 XmlNode *xmlRoot = xmlDocumentRoot(
                     xmlDocumentNewBuf(
-                        storageS3Request(this, HTTP_VERB_GET_STR, FSLASH_STR, query, NULL, true, false).response));
+                        storageS3Request(this, HTTP_VERB_GET_STR, FSLASH_STR, query, NULL, NULL, true, false).response));
 
                 // Get subpath list
                 XmlNodeList *subPathList = xmlNodeChildList(xmlRoot, S3_XML_TAG_COMMON_PREFIXES_STR);
@@ -539,7 +639,8 @@ storageS3Exists(THIS_VOID, const String *file)
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        result = httpClientResponseCodeOk(storageS3Request(this, HTTP_VERB_HEAD_STR, file, NULL, NULL, true, true).httpClient);
+        result = httpClientResponseCodeOk(
+            storageS3Request(this, HTTP_VERB_HEAD_STR, file, NULL, NULL, NULL, true, true).httpClient);
     }
     MEM_CONTEXT_TEMP_END();
 
@@ -566,7 +667,7 @@ storageS3Info(THIS_VOID, const String *file, bool followLink)
     StorageInfo result = {0};
 
     // Attempt to get file info
-    StorageS3RequestResult httpResult = storageS3Request(this, HTTP_VERB_HEAD_STR, file, NULL, NULL, true, true);
+    StorageS3RequestResult httpResult = storageS3Request(this, HTTP_VERB_HEAD_STR, file, NULL, NULL, NULL, true, true);
 
     // On success load info into a structure
     if (httpClientResponseCodeOk(httpResult.httpClient))
@@ -715,7 +816,7 @@ storageS3NewRead(THIS_VOID, const String *file, bool ignoreMissing, bool compres
     ASSERT(this != NULL);
     ASSERT(file != NULL);
 
-    FUNCTION_LOG_RETURN(STORAGE_READ, storageReadS3New(this, file, ignoreMissing));
+    FUNCTION_LOG_RETURN(STORAGE_READ, storageReadS3New(this, file, ignoreMissing, this->partSize, this->downloadMax));
 }
 
 /***********************************************************************************************************************************
@@ -750,7 +851,7 @@ storageS3NewWrite(
     ASSERT(group == NULL);
     ASSERT(timeModified == 0);
 
-    FUNCTION_LOG_RETURN(STORAGE_WRITE, storageWriteS3New(this, file, this->partSize));
+    FUNCTION_LOG_RETURN(STORAGE_WRITE, storageWriteS3New(this, file, this->partSize, this->uploadMax));
 }
 
 /***********************************************************************************************************************************
@@ -775,7 +876,7 @@ storageS3PathRemoveInternal(StorageS3 *this, XmlDocument *request)
     ASSERT(request != NULL);
 
     Buffer *response = storageS3Request(
-        this, HTTP_VERB_POST_STR, FSLASH_STR, httpQueryAdd(httpQueryNew(), S3_QUERY_DELETE_STR, EMPTY_STR),
+        this, HTTP_VERB_POST_STR, FSLASH_STR, httpQueryAdd(httpQueryNew(), S3_QUERY_DELETE_STR, EMPTY_STR), NULL,
         xmlDocumentBuf(request), true, false).response;
 
     // Nothing is returned when there are no errors
@@ -798,6 +899,48 @@ storageS3PathRemoveInternal(StorageS3 *this, XmlDocument *request)
     FUNCTION_TEST_RETURN_VOID();
 }
 
+// Add a key to the delete request and send the request when it is full
+static void
+storageS3PathRemoveAdd(StorageS3 *this, StorageS3PathRemoveData *data, const String *key)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_S3, this);
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM(STRING, key);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(data != NULL);
+    ASSERT(key != NULL);
+
+    // If there is something to delete then create the request
+    if (data->xml == NULL)
+    {
+        MemContext *memContextOld = memContextSwitch(data->memContext);
+
+        data->xml = xmlDocumentNew(S3_XML_TAG_DELETE_STR);
+        xmlNodeContentSet(xmlNodeAdd(xmlDocumentRoot(data->xml), S3_XML_TAG_QUIET_STR), TRUE_STR);
+
+        memContextSwitch(memContextOld);
+    }
+
+    // Add to delete list
+    xmlNodeContentSet(xmlNodeAdd(xmlNodeAdd(xmlDocumentRoot(data->xml), S3_XML_TAG_OBJECT_STR), S3_XML_TAG_KEY_STR), key);
+    data->size++;
+
+    // Delete list when it is full
+    if (data->size == this->deleteMax)
+    {
+        storageS3PathRemoveInternal(this, data->xml);
+
+        xmlDocumentFree(data->xml);
+        data->xml = NULL;
+        data->size = 0;
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 static void
 storageS3PathRemoveCallback(StorageS3 *this, void *callbackData, const String *name, StorageType type, const XmlNode *xml)
 {
@@ -817,34 +960,8 @@ storageS3PathRemoveCallback(StorageS3 *this, void *callbackData, const String *n
     // Only delete files since paths don't really exist
     if (type == storageTypeFile)
     {
-        StorageS3PathRemoveData *data = (StorageS3PathRemoveData *)callbackData;
-
-        // If there is something to delete then create the request
-        if (data->xml == NULL)
-        {
-            MemContext *memContextOld = memContextSwitch(data->memContext);
-
-            data->xml = xmlDocumentNew(S3_XML_TAG_DELETE_STR);
-            xmlNodeContentSet(xmlNodeAdd(xmlDocumentRoot(data->xml), S3_XML_TAG_QUIET_STR), TRUE_STR);
-
-            memContextSwitch(memContextOld);
-        }
-
-        // Add to delete list
-        xmlNodeContentSet(
-            xmlNodeAdd(xmlNodeAdd(xmlDocumentRoot(data->xml), S3_XML_TAG_OBJECT_STR), S3_XML_TAG_KEY_STR),
-            xmlNodeContent(xmlNodeChild(xml, S3_XML_TAG_KEY_STR, true)));
-        data->size++;
-
-        // Delete list when it is full
-        if (data->size == this->deleteMax)
-        {
-            storageS3PathRemoveInternal(this, data->xml);
-
-            xmlDocumentFree(data->xml);
-            data->xml = NULL;
-            data->size = 0;
-        }
+        storageS3PathRemoveAdd(
+            this, (StorageS3PathRemoveData *)callbackData, xmlNodeContent(xmlNodeChild(xml, S3_XML_TAG_KEY_STR, true)));
     }
 
     FUNCTION_TEST_RETURN_VOID();
@@ -895,7 +1012,41 @@ storageS3Remove(THIS_VOID, const String *file, bool errorOnMissing)
     ASSERT(file != NULL);
     ASSERT(!errorOnMissing);
 
-    storageS3Request(this, HTTP_VERB_DELETE_STR, file, NULL, NULL, true, false);
+    storageS3Request(this, HTTP_VERB_DELETE_STR, file, NULL, NULL, NULL, true, false);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Remove a list of files using as few multi-object delete requests as possible
+***********************************************************************************************************************************/
+static void
+storageS3RemoveList(THIS_VOID, const StringList *fileList, bool errorOnMissing)
+{
+    THIS(StorageS3);
+
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE_S3, this);
+        FUNCTION_LOG_PARAM(STRING_LIST, fileList);
+        FUNCTION_LOG_PARAM(BOOL, errorOnMissing);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(fileList != NULL);
+    ASSERT(!errorOnMissing);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        StorageS3PathRemoveData data = {.memContext = memContextCurrent()};
+
+        // Keys do not have the leading / that files have
+        for (unsigned int fileIdx = 0; fileIdx < strLstSize(fileList); fileIdx++)
+            storageS3PathRemoveAdd(this, &data, strSub(strLstGet(fileList, fileIdx), 1));
+
+        if (data.xml != NULL)
+            storageS3PathRemoveInternal(this, data.xml);
+    }
+    MEM_CONTEXT_TEMP_END();
 
     FUNCTION_LOG_RETURN_VOID();
 }
@@ -907,8 +1058,8 @@ Storage *
 storageS3New(
     const String *path, bool write, StoragePathExpressionCallback pathExpressionFunction, const String *bucket,
     const String *endPoint, const String *region, const String *accessKey, const String *secretAccessKey,
-    const String *securityToken, size_t partSize, unsigned int deleteMax, const String *host, unsigned int port, TimeMSec timeout,
-    bool verifyPeer, const String *caFile, const String *caPath)
+    const String *securityToken, size_t partSize, unsigned int uploadMax, unsigned int downloadMax, unsigned int deleteMax,
+    const String *host, unsigned int port, TimeMSec timeout, bool verifyPeer, const String *caFile, const String *caPath)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, path);
@@ -921,6 +1072,8 @@ storageS3New(
         FUNCTION_TEST_PARAM(STRING, secretAccessKey);
         FUNCTION_TEST_PARAM(STRING, securityToken);
         FUNCTION_LOG_PARAM(SIZE, partSize);
+        FUNCTION_LOG_PARAM(UINT, uploadMax);
+        FUNCTION_LOG_PARAM(UINT, downloadMax);
         FUNCTION_LOG_PARAM(STRING, host);
         FUNCTION_LOG_PARAM(UINT, port);
         FUNCTION_LOG_PARAM(TIME_MSEC, timeout);
@@ -935,6 +1088,8 @@ storageS3New(
     ASSERT(region != NULL);
     ASSERT(accessKey != NULL);
     ASSERT(secretAccessKey != NULL);
+    ASSERT(uploadMax > 0);
+    ASSERT(downloadMax > 0);
 
     Storage *this = NULL;
 
@@ -949,6 +1104,8 @@ storageS3New(
         driver->secretAccessKey = strDup(secretAccessKey);
         driver->securityToken = strDup(securityToken);
         driver->partSize = partSize;
+        driver->uploadMax = uploadMax;
+        driver->downloadMax = downloadMax;
         driver->deleteMax = deleteMax;
         driver->bucketEndpoint = strNewFmt("%s.%s", strPtr(bucket), strPtr(endPoint));
         driver->port = port;
@@ -965,7 +1122,7 @@ storageS3New(
             STORAGE_S3_TYPE_STR, path, 0, 0, write, pathExpressionFunction, driver,
             .exists = storageS3Exists, .info = storageS3Info, .infoList = storageS3InfoList, .list = storageS3List,
             .newRead = storageS3NewRead, .newWrite = storageS3NewWrite, .pathRemove = storageS3PathRemove,
-            .remove = storageS3Remove);
+            .remove = storageS3Remove, .removeList = storageS3RemoveList);
     }
     MEM_CONTEXT_NEW_END();
 
@@ -12,6 +12,17 @@ typedef struct StorageS3 StorageS3;
 #include "common/io/http/client.h"
 #include "storage/s3/storage.h"
 
+/***********************************************************************************************************************************
+S3 http headers
+***********************************************************************************************************************************/
+#define S3_HEADER_CONTENT_SHA256                                    "x-amz-content-sha256"
+    STRING_DECLARE(S3_HEADER_CONTENT_SHA256_STR);
+
+/***********************************************************************************************************************************
+Format a binary md5 hash for the content-md5 header
+***********************************************************************************************************************************/
+String *storageS3ContentMd5(const Buffer *md5);
+
 /***********************************************************************************************************************************
 Perform an S3 Request
 ***********************************************************************************************************************************/
@@ -28,8 +39,10 @@ typedef struct StorageS3RequestResult
 } StorageS3RequestResult;
 
 StorageS3RequestResult storageS3Request(
-    StorageS3 *this, const String *verb, const String *uri, const HttpQuery *query, const Buffer *body, bool returnContent,
-    bool allowMissing);
+    StorageS3 *this, const String *verb, const String *uri, const HttpQuery *query, const HttpHeader *header, const Buffer *body,
+    bool returnContent, bool allowMissing);
+HttpClient *storageS3RequestSend(
+    StorageS3 *this, const String *verb, const String *uri, const HttpQuery *query, const HttpHeader *header, const Buffer *body);
 
 /***********************************************************************************************************************************
 Macros for function logging
@@ -3,12 +3,15 @@ S3 Storage File write
 ***********************************************************************************************************************************/
 #include "build.auto.h"
 
+#include "common/crypto/hash.h"
 #include "common/debug.h"
 #include "common/io/write.intern.h"
 #include "common/log.h"
 #include "common/memContext.h"
 #include "common/object.h"
+#include "common/type/list.h"
 #include "common/type/xml.h"
+#include "storage/s3/storage.intern.h"
 #include "storage/s3/write.h"
 #include "storage/write.intern.h"
 
@@ -31,6 +34,16 @@ STRING_STATIC(S3_XML_TAG_PART_NUMBER_STR,                           "PartNumber"
 /***********************************************************************************************************************************
 Object type
 ***********************************************************************************************************************************/
+#define STORAGE_WRITE_S3_TYPE                                       StorageWriteS3
+#define STORAGE_WRITE_S3_PREFIX                                     storageWriteS3
+
+typedef struct StorageWriteS3Upload
+{
+    unsigned int partNumber;                                        // Part number
+    Buffer *partBuffer;                                             // Part data, retained in case the upload must be retried
+    HttpClient *httpClient;                                         // Client waiting on the response (NULL if the send failed)
+} StorageWriteS3Upload;
+
 typedef struct StorageWriteS3
 {
     MemContext *memContext;                                         // Object mem context
@@ -38,9 +51,12 @@ typedef struct StorageWriteS3
     StorageS3 *storage;                                             // Storage that created this object
 
     size_t partSize;
+    unsigned int uploadMax;                                         // Maximum parts to upload at the same time
     Buffer *partBuffer;
+    CryptoHashMany *partHash;                                       // Md5 and sha256 of the part buffer, updated as it is filled
     const String *uploadId;
     StringList *uploadPartList;
+    List *uploadList;                                               // Parts that have been sent but not completed
 } StorageWriteS3;
 
 /***********************************************************************************************************************************
@@ -51,6 +67,24 @@ Macros for function logging
 #define FUNCTION_LOG_STORAGE_WRITE_S3_FORMAT(value, buffer, bufferSize)                                                     \
     objToLog(value, "StorageWriteS3", buffer, bufferSize)
 
+/***********************************************************************************************************************************
+Mark http clients with uploads in progress as done so they can be reused
+***********************************************************************************************************************************/
+OBJECT_DEFINE_FREE_RESOURCE_BEGIN(STORAGE_WRITE_S3, LOG, logLevelTrace)
+{
+    if (this->uploadList != NULL)
+    {
+        for (unsigned int uploadIdx = 0; uploadIdx < lstSize(this->uploadList); uploadIdx++)
+        {
+            StorageWriteS3Upload *upload = lstGet(this->uploadList, uploadIdx);
+
+            if (upload->httpClient != NULL)
+                httpClientDone(upload->httpClient);
+        }
+    }
+}
+OBJECT_DEFINE_FREE_RESOURCE_END(LOG);
+
 /***********************************************************************************************************************************
 Open the file
 ***********************************************************************************************************************************/
@@ -70,6 +104,7 @@ storageWriteS3Open(THIS_VOID)
     MEM_CONTEXT_BEGIN(this->memContext)
     {
         this->partBuffer = bufNew(this->partSize);
+        this->partHash = cryptoHashManyNew(strLstAdd(strLstAdd(strLstNew(), HASH_TYPE_MD5_STR), HASH_TYPE_SHA256_STR));
     }
     MEM_CONTEXT_END();
 
@@ -77,7 +112,123 @@ storageWriteS3Open(THIS_VOID)
 }
 
 /***********************************************************************************************************************************
-Flush bytes to upload part
+Build the content md5 and sha256 headers from the hashes calculated as the part buffer was filled
+
+The hash is reset so it is ready for the next part buffer.
+***********************************************************************************************************************************/
+static HttpHeader *
+storageWriteS3PartHeader(StorageWriteS3 *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_WRITE_S3, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->partHash != NULL);
+
+    HttpHeader *result = httpHeaderNew(NULL);
+    httpHeaderAdd(result, HTTP_HEADER_CONTENT_MD5_STR, storageS3ContentMd5(cryptoHashManyResult(this->partHash, 0)));
+    httpHeaderAdd(result, S3_HEADER_CONTENT_SHA256_STR, bufHex(cryptoHashManyResult(this->partHash, 1)));
+
+    cryptoHashManyFree(this->partHash);
+
+    MEM_CONTEXT_BEGIN(this->memContext)
+    {
+        this->partHash = cryptoHashManyNew(strLstAdd(strLstAdd(strLstNew(), HASH_TYPE_MD5_STR), HASH_TYPE_SHA256_STR));
+    }
+    MEM_CONTEXT_END();
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Build the query for a part upload
+***********************************************************************************************************************************/
+static HttpQuery *
+storageWriteS3PartQuery(const StorageWriteS3 *this, unsigned int partNumber)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_WRITE_S3, this);
+        FUNCTION_TEST_PARAM(UINT, partNumber);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->uploadId != NULL);
+
+    HttpQuery *result = httpQueryNew();
+    httpQueryAdd(result, S3_QUERY_UPLOAD_ID_STR, this->uploadId);
+    httpQueryAdd(result, S3_QUERY_PART_NUMBER_STR, strNewFmt("%u", partNumber));
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Complete the oldest part upload and add the etag to the part list
+
+The part buffer is returned so it can be reused for the next part.
+***********************************************************************************************************************************/
+static Buffer *
+storageWriteS3PartComplete(StorageWriteS3 *this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_WRITE_S3, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(lstSize(this->uploadList) > 0);
+
+    StorageWriteS3Upload upload = *(StorageWriteS3Upload *)lstGet(this->uploadList, 0);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const String *eTag = NULL;
+
+        // Read the response if the part was sent
+        if (upload.httpClient != NULL)
+        {
+            TRY_BEGIN()
+            {
+                httpClientResponse(upload.httpClient, true);
+
+                if (httpClientResponseCodeOk(upload.httpClient))
+                    eTag = httpHeaderGet(httpClientReponseHeader(upload.httpClient), HTTP_HEADER_ETAG_STR);
+            }
+            CATCH_ANY()
+            {
+                LOG_DEBUG("retry %s: %s", errorTypeName(errorType()), errorMessage());
+            }
+            TRY_END();
+        }
+
+        // If the part could not be sent or the response was not successful then upload it again.  This request has the usual
+        // retries and error reporting.
+        if (eTag == NULL)
+        {
+            eTag = httpHeaderGet(
+                storageS3Request(
+                    this->storage, HTTP_VERB_PUT_STR, this->interface.name, storageWriteS3PartQuery(this, upload.partNumber),
+                    NULL, upload.partBuffer, true, false).responseHeader,
+                HTTP_HEADER_ETAG_STR);
+        }
+
+        ASSERT(eTag != NULL);
+
+        // Parts are completed in order so the etag can be added to the end of the list
+        ASSERT(upload.partNumber == strLstSize(this->uploadPartList) + 1);
+        strLstAdd(this->uploadPartList, eTag);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    lstRemove(this->uploadList, 0);
+
+    FUNCTION_LOG_RETURN(BUFFER, upload.partBuffer);
+}
+
+/***********************************************************************************************************************************
+Start uploading the part buffer
+
+Up to uploadMax parts are sent before waiting for the oldest response.  The http client writes each part body in a thread, so parts
+on separate connections are transferred at the same time while the next part buffer is filled.
 ***********************************************************************************************************************************/
 static void
 storageWriteS3Part(StorageWriteS3 *this)
@@ -100,30 +251,61 @@ storageWriteS3Part(StorageWriteS3 *this)
                 xmlDocumentNewBuf(
                     storageS3Request(
                         this->storage, HTTP_VERB_POST_STR, this->interface.name,
-                        httpQueryAdd(httpQueryNew(), S3_QUERY_UPLOADS_STR, EMPTY_STR), NULL, true, false).response));
+                        httpQueryAdd(httpQueryNew(), S3_QUERY_UPLOADS_STR, EMPTY_STR), NULL, NULL, true, false).response));
 
             // Store the upload id
             MEM_CONTEXT_BEGIN(this->memContext)
             {
                 this->uploadId = xmlNodeContent(xmlNodeChild(xmlRoot, S3_XML_TAG_UPLOAD_ID_STR, true));
                 this->uploadPartList = strLstNew();
+                this->uploadList = lstNew(sizeof(StorageWriteS3Upload));
             }
             MEM_CONTEXT_END();
         }
 
-        // Upload the part and add etag to part list
-        HttpQuery *query = httpQueryNew();
-        httpQueryAdd(query, S3_QUERY_UPLOAD_ID_STR, this->uploadId);
-        httpQueryAdd(query, S3_QUERY_PART_NUMBER_STR, strNewFmt("%u", strLstSize(this->uploadPartList) + 1));
+        // Get the hashes calculated while the part buffer was filled
+        HttpHeader *partHeader = storageWriteS3PartHeader(this);
 
-        strLstAdd(
-            this->uploadPartList,
-            httpHeaderGet(
-                storageS3Request(
-                    this->storage, HTTP_VERB_PUT_STR, this->interface.name, query, this->partBuffer, true, false).responseHeader,
-                HTTP_HEADER_ETAG_STR));
+        // If the maximum parts are being uploaded then complete the oldest part and reuse the buffer
+        Buffer *partBufferNext = NULL;
+
+        if (lstSize(this->uploadList) == this->uploadMax)
+            partBufferNext = storageWriteS3PartComplete(this);
+
+        // Send the part without waiting for the response.  The part buffer is not reused until the part is completed since the
+        // body is still being written.  If the send fails the part will be uploaded again when it is completed.
+        StorageWriteS3Upload upload =
+        {
+            .partNumber = strLstSize(this->uploadPartList) + lstSize(this->uploadList) + 1,
+            .partBuffer = this->partBuffer,
+        };
+
+        TRY_BEGIN()
+        {
+            upload.httpClient = storageS3RequestSend(
+                this->storage, HTTP_VERB_PUT_STR, this->interface.name, storageWriteS3PartQuery(this, upload.partNumber),
+                partHeader, upload.partBuffer);
+        }
+        CATCH_ANY()
+        {
+            LOG_DEBUG("retry %s: %s", errorTypeName(errorType()), errorMessage());
+        }
+        TRY_END();
+
+        lstAdd(this->uploadList, &upload);
 
-        ASSERT(strLstGet(this->uploadPartList, strLstSize(this->uploadPartList) - 1) != NULL);
+        // Allocate a new part buffer if one was not freed by a completed part
+        if (partBufferNext == NULL)
+        {
+            MEM_CONTEXT_BEGIN(this->memContext)
+            {
+                partBufferNext = bufNew(this->partSize);
+            }
+            MEM_CONTEXT_END();
+        }
+
+        bufUsedZero(partBufferNext);
+        this->partBuffer = partBufferNext;
     }
     MEM_CONTEXT_TEMP_END();
 
@@ -155,14 +337,12 @@ storageWriteS3(THIS_VOID, const Buffer *buffer)
         size_t bytesNext = bufRemains(this->partBuffer) > bufUsed(buffer) - bytesTotal ?
             bufUsed(buffer) - bytesTotal : bufRemains(this->partBuffer);
         bufCatSub(this->partBuffer, buffer, bytesTotal, bytesNext);
+        cryptoHashManyProcess(this->partHash, BUF(bufPtr(buffer) + bytesTotal, bytesNext));
         bytesTotal += bytesNext;
 
         // If the part buffer is full then write it
         if (bufRemains(this->partBuffer) == 0)
-        {
             storageWriteS3Part(this);
-            bufUsedZero(this->partBuffer);
-        }
     }
     while (bytesTotal != bufUsed(buffer));
 
@@ -195,6 +375,10 @@ storageWriteS3Close(THIS_VOID)
                 if (bufUsed(this->partBuffer) > 0)
                     storageWriteS3Part(this);
 
+                // Complete all parts that are still being uploaded
+                while (lstSize(this->uploadList) > 0)
+                    bufFree(storageWriteS3PartComplete(this));
+
                 // Generate the xml part list
                 XmlDocument *partList = xmlDocumentNew(S3_XML_TAG_COMPLETE_MULTIPART_UPLOAD_STR);
 
@@ -208,17 +392,21 @@ storageWriteS3Close(THIS_VOID)
                 // Finalize the multi-part upload
                 storageS3Request(
                     this->storage, HTTP_VERB_POST_STR, this->interface.name,
-                    httpQueryAdd(httpQueryNew(), S3_QUERY_UPLOAD_ID_STR, this->uploadId), xmlDocumentBuf(partList), true, false);
+                    httpQueryAdd(httpQueryNew(), S3_QUERY_UPLOAD_ID_STR, this->uploadId), NULL, xmlDocumentBuf(partList), true,
+                    false);
             }
             // Else upload all the data in a single put
             else
             {
                 storageS3Request(
-                    this->storage, HTTP_VERB_PUT_STR, this->interface.name, NULL, this->partBuffer, true, false);
+                    this->storage, HTTP_VERB_PUT_STR, this->interface.name, NULL, storageWriteS3PartHeader(this), this->partBuffer,
+                    true, false);
             }
 
             bufFree(this->partBuffer);
             this->partBuffer = NULL;
+            cryptoHashManyFree(this->partHash);
+            this->partHash = NULL;
         }
         MEM_CONTEXT_TEMP_END();
     }
@@ -230,15 +418,18 @@ storageWriteS3Close(THIS_VOID)
 New object
 ***********************************************************************************************************************************/
 StorageWrite *
-storageWriteS3New(StorageS3 *storage, const String *name, size_t partSize)
+storageWriteS3New(StorageS3 *storage, const String *name, size_t partSize, unsigned int uploadMax)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(STORAGE_S3, storage);
         FUNCTION_LOG_PARAM(STRING, name);
+        FUNCTION_LOG_PARAM(SIZE, partSize);
+        FUNCTION_LOG_PARAM(UINT, uploadMax);
     FUNCTION_LOG_END();
 
     ASSERT(storage != NULL);
     ASSERT(name != NULL);
+    ASSERT(uploadMax > 0);
 
     StorageWrite *this = NULL;
 
@@ -247,6 +438,10 @@ storageWriteS3New(StorageS3 *storage, const String *name, size_t partSize)
         StorageWriteS3 *driver = memNew(sizeof(StorageWriteS3));
         driver->memContext = MEM_CONTEXT_NEW();
 
+        // Uploads in progress are completed when this context is freed.  It must be created before the upload list and part buffers
+        // so they are not freed while the http clients are still writing them.
+        memContextCallbackSet(memContextNew("StorageWriteS3Guard"), storageWriteS3FreeResource, driver);
+
         driver->interface = (StorageWriteInterface)
         {
             .type = STORAGE_S3_TYPE_STR,
@@ -266,6 +461,7 @@ storageWriteS3New(StorageS3 *storage, const String *name, size_t partSize)
 
         driver->storage = storage;
         driver->partSize = partSize;
+        driver->uploadMax = uploadMax;
 
         this = storageWriteNew(driver, &driver->interface);
     }
@@ -62,6 +62,7 @@ storageNew(
     ASSERT(interface.newWrite != NULL);
     ASSERT(interface.pathRemove != NULL);
     ASSERT(interface.remove != NULL);
+    ASSERT(!(interface.feature >> storageFeatureMove & 1) || interface.move != NULL);
 
     Storage *this = NULL;
     this = (Storage *)memNew(sizeof(Storage));
@@ -368,7 +369,7 @@ storageMove(const Storage *this, StorageRead *source, StorageWrite *destination)
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
-    ASSERT(this->interface.move != NULL);
+    ASSERT(this->interface.move != NULL && storageFeature(this, storageFeatureMove));
     ASSERT(source != NULL);
     ASSERT(destination != NULL);
     ASSERT(!storageReadIgnoreMissing(source));
@@ -733,6 +734,53 @@ storageRemove(const Storage *this, const String *fileExp, StorageRemoveParam par
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Remove a list of files
+
+Drivers that can remove many files in a single request (e.g. S3) or that have a high per-request latency (e.g. remote) should
+implement removeList() so the list is sent in as few requests as possible.  Otherwise each file is removed individually.
+***********************************************************************************************************************************/
+void
+storageRemoveList(const Storage *this, const StringList *fileExpList, StorageRemoveListParam param)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE, this);
+        FUNCTION_LOG_PARAM(STRING_LIST, fileExpList);
+        FUNCTION_LOG_PARAM(BOOL, param.errorOnMissing);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->write);
+    ASSERT(fileExpList != NULL);
+
+    if (strLstSize(fileExpList) > 0)
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            // Build the paths
+            StringList *fileList = strLstNew();
+
+            for (unsigned int fileIdx = 0; fileIdx < strLstSize(fileExpList); fileIdx++)
+                strLstAdd(fileList, storagePathNP(this, strLstGet(fileExpList, fileIdx)));
+
+            // Call driver function if it is implemented
+            if (this->interface.removeList != NULL)
+            {
+                this->interface.removeList(this->driver, fileList, param.errorOnMissing);
+            }
+            // Else remove each file individually
+            else
+            {
+                for (unsigned int fileIdx = 0; fileIdx < strLstSize(fileList); fileIdx++)
+                    this->interface.remove(this->driver, strLstGet(fileList, fileIdx), param.errorOnMissing);
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Get the storage driver
 ***********************************************************************************************************************************/
@@ -37,6 +37,10 @@ typedef enum
     // Is the storage able to do compression and therefore store the file more efficiently than what was written?  If so, the size
     // will need to checked after write to see if it is different.
     storageFeatureCompress,
+
+    // Can the storage move files?  If not, a file that needs a name that is not known until it has been written (e.g. a name that
+    // includes the checksum) must be read once to get the name and then again to write it.
+    storageFeatureMove,
 } StorageFeature;
 
 /***********************************************************************************************************************************
@@ -264,6 +268,21 @@ typedef struct StorageRemoveParam
 
 void storageRemove(const Storage *this, const String *fileExp, StorageRemoveParam param);
 
+/***********************************************************************************************************************************
+storageRemoveList
+***********************************************************************************************************************************/
+typedef struct StorageRemoveListParam
+{
+    bool errorOnMissing;
+} StorageRemoveListParam;
+
+#define storageRemoveListP(this, fileExpList, ...)                                                                                 \
+    storageRemoveList(this, fileExpList, (StorageRemoveListParam){__VA_ARGS__})
+#define storageRemoveListNP(this, fileExpList)                                                                                     \
+    storageRemoveList(this, fileExpList, (StorageRemoveListParam){0})
+
+void storageRemoveList(const Storage *this, const StringList *fileExpList, StorageRemoveListParam param);
+
 /***********************************************************************************************************************************
 Getters
 ***********************************************************************************************************************************/
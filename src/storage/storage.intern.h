@@ -72,6 +72,10 @@ typedef struct StorageInterface
     bool (*pathRemove)(void *driver, const String *path, bool recurse);
     void (*pathSync)(void *driver, const String *path);
     void (*remove)(void *driver, const String *file, bool errorOnMissing);
+
+    // Remove a list of files in as few requests as the driver allows.  This is optional -- if not implemented then remove() will be
+    // called for each file.
+    void (*removeList)(void *driver, const StringList *fileList, bool errorOnMissing);
 } StorageInterface;
 
 #define storageNewP(type, path, modeFile, modePath, write, pathExpressionFunction, driver, ...)                                    \
@@ -15,6 +15,12 @@ typedef struct StorageWrite StorageWrite;
 #include "common/io/write.h"
 #include "common/type/buffer.h"
 #include "common/type/string.h"
+#include "version.h"
+
+/***********************************************************************************************************************************
+Temporary file extension
+***********************************************************************************************************************************/
+#define STORAGE_FILE_TEMP_EXT                                       PROJECT_BIN ".tmp"
 
 /***********************************************************************************************************************************
 Functions
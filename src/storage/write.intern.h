@@ -6,12 +6,6 @@ Storage Write Interface Internal
 
 #include "common/io/write.intern.h"
 #include "storage/write.h"
-#include "version.h"
-
-/***********************************************************************************************************************************
-Temporary file extension
-***********************************************************************************************************************************/
-#define STORAGE_FILE_TEMP_EXT                                       PROJECT_BIN ".tmp"
 
 /***********************************************************************************************************************************
 Constructor
@@ -136,6 +136,8 @@ sub new
 
     # Set whether repo should be encrypted or not
     $self->{bRepoEncrypt} = defined($$oParam{bRepoEncrypt}) ? $$oParam{bRepoEncrypt} : false;
+    $self->{strRepoCipherType} =
+        defined($$oParam{strRepoCipherType}) ? $$oParam{strRepoCipherType} : CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_CBC;
 
     # Return from function and log return values if any
     return logDebugReturn
@@ -1050,8 +1052,7 @@ sub configCreate
     {
         if ($self->repoEncrypt())
         {
-            $oParamHash{&CFGDEF_SECTION_GLOBAL}{cfgOptionName(CFGOPT_REPO_CIPHER_TYPE)} =
-                CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_CBC;
+            $oParamHash{&CFGDEF_SECTION_GLOBAL}{cfgOptionName(CFGOPT_REPO_CIPHER_TYPE)} = $self->repoCipherType();
             $oParamHash{&CFGDEF_SECTION_GLOBAL}{cfgOptionName(CFGOPT_REPO_CIPHER_PASS)} = 'x';
         }
 
@@ -2077,6 +2078,7 @@ sub lockPath {return shift->{strLockPath}}
 sub logPath {return shift->{strLogPath}}
 sub repoPath {return shift->{strRepoPath}}
 sub repoEncrypt {return shift->{bRepoEncrypt}}
+sub repoCipherType {return shift->{strRepoCipherType}}
 sub stanza {return testRunGet()->stanza()}
 sub synthetic {return shift->{bSynthetic}}
 sub cipherPassManifest {return shift->{strCipherPassManifest}}
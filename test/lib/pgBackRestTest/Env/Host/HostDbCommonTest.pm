@@ -79,6 +79,7 @@ sub new
             bSynthetic => $$oParam{bSynthetic},
             bRepoLocal => $oParam->{bRepoLocal},
             bRepoEncrypt => $oParam->{bRepoEncrypt},
+            strRepoCipherType => $oParam->{strRepoCipherType},
         });
     bless $self, $class;
 
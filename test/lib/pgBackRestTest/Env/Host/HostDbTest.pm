@@ -67,6 +67,7 @@ sub new
             bStandby => $$oParam{bStandby},
             bRepoLocal => $oParam->{bRepoLocal},
             bRepoEncrypt => $oParam->{bRepoEncrypt},
+            strRepoCipherType => $oParam->{strRepoCipherType},
         });
     bless $self, $class;
 
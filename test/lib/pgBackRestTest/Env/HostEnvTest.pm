@@ -71,6 +71,8 @@ sub setup
     my $oHostBackup = undef;
 
     my $bRepoEncrypt = defined($$oConfigParam{bRepoEncrypt}) ? $$oConfigParam{bRepoEncrypt} : false;
+    my $strRepoCipherType =
+        defined($$oConfigParam{strRepoCipherType}) ? $$oConfigParam{strRepoCipherType} : CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_CBC;
 
     if ($bHostBackup)
     {
@@ -78,7 +80,7 @@ sub setup
 
         $oHostBackup = new pgBackRestTest::Env::Host::HostBackupTest(
             {strBackupDestination => $strBackupDestination, bSynthetic => $bSynthetic, oLogTest => $oLogTest,
-                bRepoLocal => !$oConfigParam->{bS3}, bRepoEncrypt => $bRepoEncrypt});
+                bRepoLocal => !$oConfigParam->{bS3}, bRepoEncrypt => $bRepoEncrypt, strRepoCipherType => $strRepoCipherType});
         $oHostGroup->hostAdd($oHostBackup);
     }
     else
@@ -94,13 +96,13 @@ sub setup
     {
         $oHostDbMaster = new pgBackRestTest::Env::Host::HostDbSyntheticTest(
             {strBackupDestination => $strBackupDestination, oLogTest => $oLogTest, bRepoLocal => !$oConfigParam->{bS3},
-                bRepoEncrypt => $bRepoEncrypt});
+                bRepoEncrypt => $bRepoEncrypt, strRepoCipherType => $strRepoCipherType});
     }
     else
     {
         $oHostDbMaster = new pgBackRestTest::Env::Host::HostDbTest(
             {strBackupDestination => $strBackupDestination, oLogTest => $oLogTest, bRepoLocal => !$oConfigParam->{bS3},
-                bRepoEncrypt => $bRepoEncrypt});
+                bRepoEncrypt => $bRepoEncrypt, strRepoCipherType => $strRepoCipherType});
     }
 
     $oHostGroup->hostAdd($oHostDbMaster);
@@ -164,7 +166,7 @@ sub setup
     # Configure the repo to be encrypted if required
     if ($bRepoEncrypt)
     {
-        $self->optionTestSet(CFGOPT_REPO_CIPHER_TYPE, CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_CBC);
+        $self->optionTestSet(CFGOPT_REPO_CIPHER_TYPE, $strRepoCipherType);
         $self->optionTestSet(CFGOPT_REPO_CIPHER_PASS, 'x');
     }
 
@@ -283,6 +283,10 @@ sub run
 
         #---------------------------------------------------------------------------------------------------------------------------
         # Has reference - Code path to ensure reference is removed
+        $oBackupManifest->set(MANIFEST_SECTION_TARGET_FILE, $strRepoFile, MANIFEST_SUBKEY_PAGE_DELTA_BASE, BOGUS);
+        $oBackupManifest->set(
+            MANIFEST_SECTION_TARGET_FILE, $strRepoFile, MANIFEST_SUBKEY_PAGE_DELTA_BASE_COMPRESS_TYPE, CFGOPTVAL_COMPRESS_TYPE_GZ);
+
         ($lSizeCurrent, $lManifestSaveCurrent) = backupManifestUpdate(
             $oBackupManifest,
             $strHost,
@@ -306,6 +310,10 @@ sub run
         $self->testResult(sub {$oBackupManifest->test(MANIFEST_SECTION_TARGET_FILE, MANIFEST_TARGET_PGDATA . "/$strFileName.",
             MANIFEST_SUBKEY_REFERENCE)},
             false, "reference to prior backup in manifest removed");
+        $self->testResult(
+            sub {$oBackupManifest->test(MANIFEST_SECTION_TARGET_FILE, $strRepoFile, MANIFEST_SUBKEY_PAGE_DELTA_BASE) ||
+                $oBackupManifest->test(MANIFEST_SECTION_TARGET_FILE, $strRepoFile, MANIFEST_SUBKEY_PAGE_DELTA_BASE_COMPRESS_TYPE)},
+            false, "page delta base in manifest removed");
 
         #---------------------------------------------------------------------------------------------------------------------------
         # BACKUP_FILE_NOOP
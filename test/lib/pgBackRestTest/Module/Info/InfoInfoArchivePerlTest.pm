@@ -243,6 +243,31 @@ sub run
 
         $self->testResult(sub {$oArchiveInfo->test(INI_SECTION_CIPHER, INI_KEY_CIPHER_PASS, undef, $strCipherPassSub)},
             true, '    generated passphrase stored');
+
+        # Remove the archive info files
+        executeTest('sudo rm ' . $oArchiveInfo->{strFileName} . '*');
+
+        # Create and load an archive.info file encrypted with the chunked cipher
+        #---------------------------------------------------------------------------------------------------------------------------
+        $self->configTestClear();
+        $self->optionTestSet(CFGOPT_REPO_CIPHER_TYPE, CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_GCM);
+        $self->optionTestSet(CFGOPT_REPO_CIPHER_PASS, $strCipherPass);
+        $self->optionTestSet(CFGOPT_STANZA, $self->stanza());
+        $self->optionTestSet(CFGOPT_REPO_PATH, $self->testPath() . '/repo');
+        $self->configTestLoad(CFGCMD_ARCHIVE_PUSH);
+
+        storageRepoCacheClear();
+
+        $oArchiveInfo = new pgBackRest::Archive::Info(storageRepo()->pathGet(STORAGE_REPO_ARCHIVE), false,
+            {bLoad => false, bIgnoreMissing => true, strCipherPassSub => $strCipherPassSub});
+        $oArchiveInfo->create(PG_VERSION_94, $self->dbSysId(PG_VERSION_94), true);
+
+        $self->testResult(sub {storageRepo()->encrypted(storageRepo()->pathGet(STORAGE_REPO_ARCHIVE) . '/'
+            . ARCHIVE_INFO_FILE)}, true, '    new archive info encrypted with aes-256-gcm');
+
+        $self->testResult(
+            sub {(new pgBackRest::Archive::Info(storageRepo()->pathGet(STORAGE_REPO_ARCHIVE)))->cipherPassSub()},
+            $strCipherPassSub, '    load archive info encrypted with aes-256-gcm');
     }
 }
 
@@ -1339,7 +1339,7 @@ sub run
         storageDb()->put(storageDb()->openWrite($self->{strDbPath} . '/' . $strTest,
             {strMode => MODE_0600, strUser => TEST_USER, strGroup => TEST_GROUP, lTimestamp => $lTime}), $strTest . 'more');
 
-        # Set a reference, checksum, repo size, master and page checksum in the last manifest
+        # Set a reference, checksum, repo size, master, page checksum and page delta base in the last manifest
         my $strCheckSum = '1234567890';
         my $lRepoSize = 10000;
         $oLastManifest->set(MANIFEST_SECTION_TARGET_FILE, MANIFEST_TARGET_PGDATA . '/' . $strTestNew,
@@ -1356,6 +1356,10 @@ sub run
             MANIFEST_SUBKEY_MASTER, false);
         $oLastManifest->boolSet(MANIFEST_SECTION_TARGET_FILE,  MANIFEST_TARGET_PGDATA . '/' . $strTestNew,
             MANIFEST_SUBKEY_CHECKSUM_PAGE, true);
+        $oLastManifest->set(MANIFEST_SECTION_TARGET_FILE, MANIFEST_TARGET_PGDATA . '/' . $strTestNew,
+            MANIFEST_SUBKEY_PAGE_DELTA_BASE, BOGUS);
+        $oLastManifest->set(MANIFEST_SECTION_TARGET_FILE, MANIFEST_TARGET_PGDATA . '/' . $strTestNew,
+            MANIFEST_SUBKEY_PAGE_DELTA_BASE_COMPRESS_TYPE, CFGOPTVAL_COMPRESS_TYPE_GZ);
         $oLastManifest->set(MANIFEST_SECTION_TARGET_FILE, MANIFEST_TARGET_PGDATA . '/' . $strZeroFile,
             MANIFEST_SUBKEY_SIZE, 0);
         $oLastManifest->numericSet(MANIFEST_SECTION_TARGET_FILE, MANIFEST_TARGET_PGDATA . '/' . $strZeroFile,
@@ -1378,6 +1382,10 @@ sub run
             MANIFEST_SUBKEY_REPO_SIZE, $lRepoSize);
         $oManifestExpected->boolSet(MANIFEST_SECTION_TARGET_FILE,  MANIFEST_TARGET_PGDATA . '/' . $strTestNew,
             MANIFEST_SUBKEY_CHECKSUM_PAGE, true);
+        $oManifestExpected->set(MANIFEST_SECTION_TARGET_FILE, MANIFEST_TARGET_PGDATA . '/' . $strTestNew,
+            MANIFEST_SUBKEY_PAGE_DELTA_BASE, BOGUS);
+        $oManifestExpected->set(MANIFEST_SECTION_TARGET_FILE, MANIFEST_TARGET_PGDATA . '/' . $strTestNew,
+            MANIFEST_SUBKEY_PAGE_DELTA_BASE_COMPRESS_TYPE, CFGOPTVAL_COMPRESS_TYPE_GZ);
         $oManifestExpected->set(MANIFEST_SECTION_TARGET_FILE, MANIFEST_TARGET_PGDATA . '/' . $strZeroFile,
             MANIFEST_SUBKEY_SIZE, 0);
         $oManifestExpected->set(MANIFEST_SECTION_TARGET_FILE, MANIFEST_TARGET_PGDATA . '/' . $strZeroFile,
@@ -1466,6 +1474,10 @@ sub run
             MANIFEST_SUBKEY_REPO_SIZE);
         $oManifestExpected->remove(MANIFEST_SECTION_TARGET_FILE,  MANIFEST_TARGET_PGDATA . '/' . $strTestNew,
             MANIFEST_SUBKEY_CHECKSUM_PAGE);
+        $oManifestExpected->remove(MANIFEST_SECTION_TARGET_FILE, MANIFEST_TARGET_PGDATA . '/' . $strTestNew,
+            MANIFEST_SUBKEY_PAGE_DELTA_BASE);
+        $oManifestExpected->remove(MANIFEST_SECTION_TARGET_FILE, MANIFEST_TARGET_PGDATA . '/' . $strTestNew,
+            MANIFEST_SUBKEY_PAGE_DELTA_BASE_COMPRESS_TYPE);
 
         # Update the size in the last manifest to match the current and add the reference to the expected manifest
         $oLastManifest->set(MANIFEST_SECTION_TARGET_FILE, MANIFEST_TARGET_PGDATA . '/' . $strTest,
@@ -1,7 +1,7 @@
 ####################################################################################################################################
 # Archive Performance Tests
 ####################################################################################################################################
-package pgBackRestTest::Module::Performance::PerformanceArchiveTest;
+package pgBackRestTest::Module::Performance::PerformanceArchivePerlTest;
 use parent 'pgBackRestTest::Common::RunTest';
 
 ####################################################################################################################################
@@ -46,12 +46,17 @@ sub run
 {
     my $self = shift;
 
-    foreach my $bS3 (false, true)
+    # The chunked cipher is tested last with a single encrypted backup host configuration so the earlier runs are not renumbered
+    foreach my $strRepoCipherType (CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_CBC, CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_GCM)
     {
-    foreach my $bHostBackup ($bS3 ? (true) : (false, true))
+    my $bCipherChunk = $strRepoCipherType eq CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_GCM;
+
+    foreach my $bS3 ($bCipherChunk ? (false) : (false, true))
+    {
+    foreach my $bHostBackup ($bS3 || $bCipherChunk ? (true) : (false, true))
     {
     # Standby should only be tested for pg versions that support it
-    foreach my $bHostStandby ($bS3 ? (false) : (false, true))
+    foreach my $bHostStandby ($bS3 || $bCipherChunk ? (false) : (false, true))
     {
     # Master and standby backup destinations on need to be tested on one db version since it is not version specific
     foreach my $strBackupDestination (
@@ -66,9 +71,9 @@ sub run
 
         next if (!$self->begin(
             "bkp ${bHostBackup}, sby ${bHostStandby}, dst ${strBackupDestination}, cmp ${bCompress}, s3 ${bS3}, " .
-                "enc ${bRepoEncrypt}",
-            # Use the most recent db version on the expect vm for expect testing
-            $self->vm() eq VM_EXPECT && $self->pgVersion() eq $strDbVersionMostRecent));
+                "enc ${bRepoEncrypt}" . ($bCipherChunk ? ", cipher ${strRepoCipherType}" : ''),
+            # Use the most recent db version on the expect vm for expect testing (the chunked cipher run has no expect log)
+            $self->vm() eq VM_EXPECT && $self->pgVersion() eq $strDbVersionMostRecent && !$bCipherChunk));
 
         # Skip when s3 and host backup tests when there is more than one version of pg being tested and this is not the last one
         if (($bS3 || $bHostBackup) && (@{$hyVm->{$self->vm()}{&VM_DB_TEST}} > 1 && $strDbVersionMostRecent ne $self->pgVersion()))
@@ -95,7 +100,8 @@ sub run
         my ($oHostDbMaster, $oHostDbStandby, $oHostBackup, $oHostS3) = $self->setup(
             false, $self->expect(),
             {bHostBackup => $bHostBackup, bStandby => $bHostStandby, strBackupDestination => $strBackupDestination,
-             bCompress => $bCompress, bArchiveAsync => false, bS3 => $bS3, bRepoEncrypt => $bRepoEncrypt});
+             bCompress => $bCompress, bArchiveAsync => false, bS3 => $bS3, bRepoEncrypt => $bRepoEncrypt,
+             strRepoCipherType => $strRepoCipherType});
 
         # Only perform extra tests on certain runs to save time
         my $bTestLocal = $self->runCurrent() == 1;
@@ -1011,6 +1017,7 @@ sub run
     }
     }
     }
+    }
 }
 
 1;
@@ -111,6 +111,20 @@ sub run
             sub {storageRepo()->pathGet(STORAGE_REPO_BACKUP . '/file')}, $self->testPath() . '/repo/backup/db/file',
             'check backup file');
     }
+
+    #-------------------------------------------------------------------------------------------------------------------------------
+    if ($self->begin("compressLevelDefault() and compressLevelValid()"))
+    {
+        $self->testResult(sub {compressLevelDefault('gz')}, 6, 'gz default level');
+        $self->testResult(sub {compressLevelDefault('lz4')}, 1, 'lz4 default level');
+        $self->testResult(sub {compressLevelDefault('zst')}, 3, 'zst default level');
+
+        $self->testResult(sub {compressLevelValid('gz', 9)}, true, 'gz level 9 is valid');
+        $self->testResult(sub {compressLevelValid('gz', 15)}, false, 'gz level 15 is not valid');
+        $self->testResult(sub {compressLevelValid('gz', -1)}, false, 'gz level -1 is not valid');
+        $self->testResult(sub {compressLevelValid('zst', 15)}, true, 'zst level 15 is valid');
+        $self->testResult(sub {compressLevelValid('lz4', 13)}, false, 'lz4 level 13 is not valid');
+    }
 }
 
 1;
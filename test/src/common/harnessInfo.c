@@ -1,6 +1,8 @@
 /***********************************************************************************************************************************
 Harness for Loading Test Configurations
 ***********************************************************************************************************************************/
+#include <string.h>
+
 #include "common/harnessDebug.h"
 #include "common/harnessInfo.h"
 
@@ -51,5 +53,5 @@ harnessInfoChecksumZ(const char *info)
         FUNCTION_HARNESS_PARAM(STRINGZ, info);
     FUNCTION_HARNESS_END();
 
-    FUNCTION_HARNESS_RESULT(BUFFER, harnessInfoChecksum(STRDEF(info)));
+    FUNCTION_HARNESS_RESULT(BUFFER, harnessInfoChecksum(STR(info)));
 }
@@ -21,6 +21,13 @@ static SSL_CTX *testServerContext = NULL;
 static int testClientSocket = 0;
 static SSL *testClientSSL = NULL;
 
+// Connections that have been accepted so the test can switch back to an earlier connection
+#define TEST_CONNECTION_MAX                                         64
+
+static int testClientSocketList[TEST_CONNECTION_MAX];
+static SSL *testClientSSLList[TEST_CONNECTION_MAX];
+static unsigned int testClientTotal = 0;
+
 /***********************************************************************************************************************************
 Initialize TLS and listen on the specified port for TLS connections
 ***********************************************************************************************************************************/
@@ -123,8 +130,10 @@ harnessTlsServerReply(const char *reply)
 
 /***********************************************************************************************************************************
 Accept a TLS connection from the client
+
+Connections are numbered in the order they are accepted starting at zero.
 ***********************************************************************************************************************************/
-void
+unsigned int
 harnessTlsServerAccept(void)
 {
     struct sockaddr_in addr;
@@ -139,6 +148,29 @@ harnessTlsServerAccept(void)
     SSL_set_fd(testClientSSL, testClientSocket);
 
     cryptoError(SSL_accept(testClientSSL) <= 0, "unable to accept TLS connection");
+
+    if (testClientTotal == TEST_CONNECTION_MAX)
+        THROW(AssertError, "too many test connections");
+
+    testClientSocketList[testClientTotal] = testClientSocket;
+    testClientSSLList[testClientTotal] = testClientSSL;
+
+    return testClientTotal++;
+}
+
+/***********************************************************************************************************************************
+Switch to a connection that was accepted earlier
+
+This allows the server to reply on a connection that the client is still using after another connection has been accepted.
+***********************************************************************************************************************************/
+void
+harnessTlsServerSwitch(unsigned int connectionIdx)
+{
+    if (connectionIdx >= testClientTotal)
+        THROW_FMT(AssertError, "test connection %u has not been accepted", connectionIdx);
+
+    testClientSocket = testClientSocketList[connectionIdx];
+    testClientSSL = testClientSSLList[connectionIdx];
 }
 
 /***********************************************************************************************************************************
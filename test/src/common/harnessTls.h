@@ -21,9 +21,10 @@ Functions
 ***********************************************************************************************************************************/
 void harnessTlsServerInit(int port, const char *serverCert, const char *serverKey);
 
-void harnessTlsServerAccept(void);
+unsigned int harnessTlsServerAccept(void);
 void harnessTlsServerExpect(const char *expected);
 void harnessTlsServerReply(const char *reply);
+void harnessTlsServerSwitch(unsigned int connectionIdx);
 void harnessTlsServerClose(void);
 
 #endif
@@ -187,7 +187,7 @@ testRun(void)
     }
 
     // *****************************************************************************************************************************
-    if (testBegin("walSegmentFind()"))
+    if (testBegin("walSegmentFind() and walSegmentIndex*()"))
     {
         // Load configuration to set repo-path and stanza
         StringList *argList = strLstNew();
@@ -248,6 +248,95 @@ testRun(void)
         TEST_RESULT_STR(
             walSegmentFind(storageRepo(), strNew("9.6-2"), strNew("123456781234567812345678.partial"), 0), NULL,
             "did not find partial segment");
+
+        // Find segments using the index
+        // -------------------------------------------------------------------------------------------------------------------------
+        storagePutNP(
+            storageNewWriteNP(
+                storageTest,
+                strNew(
+                    "archive/db/9.6-2/1234567812345678/123456781234567812345678.partial-"
+                        "cccccccccccccccccccccccccccccccccccccccc")),
+            NULL);
+        storagePutNP(
+            storageNewWriteNP(storageTest, strNew("archive/db/9.6-2/1234567812345678/123456781234567812345678.history")), NULL);
+
+        TEST_RESULT_VOID(walSegmentIndexEnable(archiveModePush), "enable index");
+        TEST_RESULT_VOID(walSegmentIndexEnable(archiveModePush), "enable index again");
+
+        TEST_RESULT_PTR(
+            walSegmentFind(storageRepo(), strNew("9.6-2"), strNew("123456781234567912345678"), 0), NULL, "no path in index");
+        TEST_ERROR(
+            walSegmentFind(storageRepo(), strNew("9.6-2"), strNew("123456781234567812345678"), 0),
+            ArchiveDuplicateError,
+            "duplicates found in archive for WAL segment 123456781234567812345678:"
+                " 123456781234567812345678-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+                ", 123456781234567812345678-bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb.gz"
+                "\nHINT: are multiple primaries archiving to this stanza?");
+        TEST_RESULT_STR(
+            strPtr(walSegmentFind(storageRepo(), strNew("9.6-2"), strNew("123456781234567812345678.partial"), 0)),
+            "123456781234567812345678.partial-cccccccccccccccccccccccccccccccccccccccc", "found partial segment in index");
+        TEST_RESULT_PTR(
+            walSegmentFind(storageRepo(), strNew("9.6-2"), strNew("123456781234567812345677"), 0), NULL, "no segment in index");
+
+        // Segments added to a loaded path are found without listing the repo
+        TEST_RESULT_VOID(
+            walSegmentIndexAdd(strNew("9.6-2"), strNew("123456781234567812345679-dddddddddddddddddddddddddddddddddddddddd.gz")),
+            "add segment to index");
+        TEST_RESULT_VOID(
+            walSegmentIndexAdd(strNew("9.6-2"), strNew("123456781234567812345679-dddddddddddddddddddddddddddddddddddddddd.gz")),
+            "add segment to index again");
+        TEST_RESULT_VOID(
+            walSegmentIndexAdd(strNew("9.6-2"), strNew("123456781234567812345600-eeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeee")),
+            "add segment to beginning of index");
+        TEST_RESULT_STR(
+            strPtr(walSegmentFind(storageRepo(), strNew("9.6-2"), strNew("123456781234567812345679"), 0)),
+            "123456781234567812345679-dddddddddddddddddddddddddddddddddddddddd.gz", "found added segment in index");
+        TEST_RESULT_STR(
+            strPtr(walSegmentFind(storageRepo(), strNew("9.6-2"), strNew("123456781234567812345600"), 0)),
+            "123456781234567812345600-eeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeee", "found added segment at beginning of index");
+
+        // Segments added to a path that has not been loaded are ignored
+        TEST_RESULT_VOID(
+            walSegmentIndexAdd(strNew("9.6-2"), strNew("123456781234568012345678-ffffffffffffffffffffffffffffffffffffffff")),
+            "add segment to unloaded path");
+        TEST_RESULT_PTR(
+            walSegmentFind(storageRepo(), strNew("9.6-2"), strNew("123456781234568012345678"), 0), NULL,
+            "segment in unloaded path not found");
+
+        // In push mode segments written by another process after the path was loaded are not found
+        storagePutNP(
+            storageNewWriteNP(
+                storageTest,
+                strNew("archive/db/9.6-2/1234567812345678/123456781234567812345670-1111111111111111111111111111111111111111")),
+            NULL);
+
+        TEST_RESULT_PTR(
+            walSegmentFind(storageRepo(), strNew("9.6-2"), strNew("123456781234567812345670"), 0), NULL,
+            "new segment not found in push mode");
+
+        // In get mode the path is reloaded when a segment is not found
+        TEST_RESULT_VOID(walSegmentIndexEnable(archiveModeGet), "enable index in get mode");
+        TEST_RESULT_STR(
+            strPtr(walSegmentFind(storageRepo(), strNew("9.6-2"), strNew("123456781234567812345670"), 0)),
+            "123456781234567812345670-1111111111111111111111111111111111111111", "new segment found after reload in get mode");
+        TEST_RESULT_PTR(
+            walSegmentFind(storageRepo(), strNew("9.6-2"), strNew("123456781234567812345671"), 0), NULL,
+            "missing segment not found after reload in get mode");
+
+        // A timeout bypasses the index
+        TEST_RESULT_PTR(
+            walSegmentFind(storageRepo(), strNew("9.6-2"), strNew("123456781234567812345679"), 100), NULL,
+            "index bypassed with timeout");
+
+        TEST_RESULT_VOID(walSegmentIndexDisable(), "disable index");
+        TEST_RESULT_VOID(walSegmentIndexDisable(), "disable index again");
+        TEST_RESULT_VOID(
+            walSegmentIndexAdd(strNew("9.6-2"), strNew("123456781234567812345679-dddddddddddddddddddddddddddddddddddddddd.gz")),
+            "add segment with index disabled");
+        TEST_RESULT_PTR(
+            walSegmentFind(storageRepo(), strNew("9.6-2"), strNew("123456781234567812345679"), 0), NULL,
+            "segment not found with index disabled");
     }
 
     // *****************************************************************************************************************************
@@ -2,6 +2,7 @@
 Test Archive Get Command
 ***********************************************************************************************************************************/
 #include "common/compress/gzip/compress.h"
+#include "common/crypto/cipherBlock.h"
 #include "common/harnessConfig.h"
 #include "common/harnessFork.h"
 #include "common/io/bufferRead.h"
@@ -120,6 +121,64 @@ testRun(void)
                 archiveGetCheck(
                     strNew("00000009.history"), cipherTypeNone, NULL).archiveFileActual), "10-4/00000009.history",
                     "history file found");
+
+        // Use the cache
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_VOID(archiveGetCacheEnable(), "enable cache");
+        TEST_RESULT_VOID(archiveGetCacheEnable(), "enable cache again");
+        TEST_RESULT_BOOL(archiveGetCacheValid(cipherTypeNone, NULL), false, "cache not loaded");
+
+        TEST_RESULT_STR(
+            strPtr(archiveGetCheck(strNew("876543218765432187654321"), cipherTypeNone, NULL).archiveFileActual),
+            "10-4/8765432187654321/876543218765432187654321-bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb", "segment found with cache");
+
+        TEST_RESULT_BOOL(archiveGetCacheValid(cipherTypeNone, NULL), true, "cache loaded");
+        TEST_RESULT_BOOL(archiveGetCacheValid(cipherTypeAes256Cbc, NULL), false, "cache loaded with different cipher type");
+        TEST_RESULT_BOOL(archiveGetCacheValid(cipherTypeNone, strNew("pass")), false, "cache loaded with different cipher pass");
+
+        // Upgrade the stanza so the cached archive info is stale
+        storagePutNP(
+            storageNewWriteNP(storageTest, strNew("repo/archive/test1/archive.info")),
+            harnessInfoChecksumZ(
+                "[db]\n"
+                "db-id=5\n"
+                "\n"
+                "[db:history]\n"
+                "1={\"db-id\":5555555555555555555,\"db-version\":\"9.4\"}\n"
+                "2={\"db-id\":18072658121562454734,\"db-version\":\"10\"}\n"
+                "3={\"db-id\":18072658121562454734,\"db-version\":\"9.6\"}\n"
+                "4={\"db-id\":18072658121562454734,\"db-version\":\"10\"}\n"
+                "5={\"db-id\":18072658121562454734,\"db-version\":\"10\"}"));
+
+        storagePutNP(
+            storageNewWriteNP(
+                storageTest,
+                strNew(
+                    "repo/archive/test1/10-5/8765432187654321/876543218765432187654322-cccccccccccccccccccccccccccccccccccccccc")),
+            NULL);
+
+        TEST_RESULT_STR(
+            strPtr(archiveGetCheck(strNew("876543218765432187654321"), cipherTypeNone, NULL).archiveFileActual),
+            "10-4/8765432187654321/876543218765432187654321-bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb", "segment found in stale cache");
+        TEST_RESULT_STR(
+            strPtr(archiveGetCheck(strNew("876543218765432187654322"), cipherTypeNone, NULL).archiveFileActual),
+            "10-5/8765432187654321/876543218765432187654322-cccccccccccccccccccccccccccccccccccccccc",
+            "segment found after cache reload");
+        TEST_RESULT_PTR(
+            archiveGetCheck(strNew("876543218765432187654323"), cipherTypeNone, NULL).archiveFileActual, NULL,
+            "no segment found with cache");
+
+        // Upgrade the cluster so the cached pg_control is stale
+        storagePutNP(
+            storageNewWriteNP(storageTest, strNew("db/" PG_PATH_GLOBAL "/" PG_FILE_PGCONTROL)),
+            pgControlTestToBuffer((PgControl){.version = PG_VERSION_11, .systemId = 0xFACEFACEFACEFACE}));
+
+        TEST_ERROR(
+            archiveGetCheck(strNew("876543218765432187654323"), cipherTypeNone, NULL), ArchiveMismatchError,
+            "unable to retrieve the archive id for database version '11' and system-id '18072658121562454734'");
+
+        TEST_RESULT_VOID(archiveGetCacheDisable(), "disable cache");
+        TEST_RESULT_VOID(archiveGetCacheDisable(), "disable cache again");
     }
 
     // *****************************************************************************************************************************
@@ -237,6 +296,7 @@ testRun(void)
 
         VariantList *paramList = varLstNew();
         varLstAdd(paramList, varNewStr(archiveFile));
+        varLstAdd(paramList, varNewUInt(1));
 
         TEST_RESULT_BOOL(
             archiveGetProtocol(PROTOCOL_COMMAND_ARCHIVE_GET_STR, paramList, server), true, "protocol archive get");
@@ -246,6 +306,21 @@ testRun(void)
 
         bufUsedSet(serverWrite, 0);
 
+        // The next batch sees that the segment was removed from the repo since the cached state is reset
+        // -------------------------------------------------------------------------------------------------------------------------
+        storagePathRemoveP(storageTest, strNew("repo/archive/test1/10-1"), .recurse = true);
+        storagePathCreateNP(storageTest, strNew("repo/archive/test1/10-1"));
+
+        paramList = varLstNew();
+        varLstAdd(paramList, varNewStr(archiveFile));
+        varLstAdd(paramList, varNewUInt(2));
+
+        TEST_RESULT_BOOL(
+            archiveGetProtocol(PROTOCOL_COMMAND_ARCHIVE_GET_STR, paramList, server), true, "protocol archive get next batch");
+        TEST_RESULT_STR(strPtr(strNewBuf(serverWrite)), "{\"out\":1}\n", "  segment not found");
+
+        bufUsedSet(serverWrite, 0);
+
         // Check invalid protocol function
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_RESULT_BOOL(archiveGetProtocol(strNew(BOGUS_STR), paramList, server), false, "invalid function");
@@ -323,6 +398,60 @@ testRun(void)
             "000000010000000A00000FFE|000000010000000A00000FFF", "check queue");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("queueWindow() and queueStreamNext()"))
+    {
+        TEST_RESULT_UINT(queueWindow(8, 0, 1000), 8, "replay time unknown");
+        TEST_RESULT_UINT(queueWindow(8, 1000, 500), 2, "replay slower than fetch");
+        TEST_RESULT_UINT(queueWindow(8, 100, 250), 6, "replay faster than fetch");
+        TEST_RESULT_UINT(queueWindow(8, 10, 1000), 8, "replay much faster than fetch");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        StringList *argList = strLstNew();
+        strLstAddZ(argList, "pgbackrest");
+        strLstAddZ(argList, "--stanza=test1");
+        strLstAddZ(argList, "--archive-timeout=0.2");
+        strLstAdd(argList, strNewFmt("--spool-path=%s/spool", testPath()));
+        strLstAddZ(argList, "archive-get-async");
+        harnessCfgLoad(strLstSize(argList), strLstPtr(argList));
+
+        storagePathCreateNP(storageSpoolWrite(), strNew(STORAGE_SPOOL_ARCHIVE_IN));
+        storagePutNP(storageNewWriteNP(storageSpoolWrite(), strNew(STORAGE_SPOOL_ARCHIVE_IN "/000000010000000100000002")), NULL);
+        storagePutNP(storageNewWriteNP(storageSpoolWrite(), strNew(STORAGE_SPOOL_ARCHIVE_IN "/000000010000000100000003")), NULL);
+        storagePutNP(storageNewWriteNP(storageSpoolWrite(), strNew(STORAGE_SPOOL_ARCHIVE_IN "/000000010000000100000003.ok")), NULL);
+
+        ArchiveGetStream stream =
+        {
+            .walSegmentSize = 16 * 1024 * 1024,
+            .pgVersion = PG_VERSION_11,
+            .windowMax = 4,
+            .queueList = strLstNew(),
+            .walSegmentLast = strNew("000000010000000100000003"),
+            .replayLast = timeMSec() - 1000,
+            .fetchTime = 3000,
+        };
+
+        strLstAddZ(stream.queueList, "000000010000000100000001");
+        strLstAddZ(stream.queueList, "000000010000000100000002");
+        strLstAddZ(stream.queueList, "000000010000000100000003");
+
+        TEST_RESULT_STR(
+            strPtr(strLstJoin(queueStreamNext(&stream), "|")), "000000010000000100000004|000000010000000100000005",
+            "refill half empty queue");
+        TEST_RESULT_STR(
+            strPtr(strLstJoin(stream.queueList, "|")), "000000010000000100000002|000000010000000100000003",
+            "check segments not replayed");
+        TEST_RESULT_BOOL(stream.replayTime >= 1000, true, "check replay time");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        stream.fetchTime = 0;
+
+        TEST_RESULT_UINT(strLstSize(queueStreamNext(&stream)), 0, "replay stalled");
+        TEST_RESULT_STR(
+            strPtr(strLstJoin(stream.queueList, "|")), "000000010000000100000002|000000010000000100000003",
+            "check segments not replayed");
+    }
+
 
     // *****************************************************************************************************************************
     if (testBegin("cmdArchiveGetAsync()"))
@@ -481,6 +610,65 @@ testRun(void)
             "102\nlocal-1 process terminated unexpectedly [102]: unable to execute 'pgbackrest-bogus': "
                 "[2] No such file or directory",
             "check global error");
+
+        protocolFree();
+
+        // Stream segments until a segment is not found
+        // -------------------------------------------------------------------------------------------------------------------------
+        storagePathRemoveP(storageSpoolWrite(), strNew(STORAGE_SPOOL_ARCHIVE_IN), .recurse = true);
+        storagePathCreateNP(storageSpoolWrite(), strNew(STORAGE_SPOOL_ARCHIVE_IN));
+
+        for (unsigned int walSegmentIdx = 1; walSegmentIdx <= 3; walSegmentIdx++)
+        {
+            storagePutNP(
+                storageNewWriteNP(
+                    storageTest,
+                    strNewFmt(
+                        "repo/archive/test2/10-1/0000000100000002/00000001000000020000000%u-"
+                            "abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd", walSegmentIdx)),
+                NULL);
+        }
+
+        argList = strLstDup(argCleanList);
+        strLstAddZ(argList, "--archive-get-stream");
+        strLstAddZ(argList, "--archive-get-queue-max=64MB");
+        strLstAddZ(argList, "000000010000000200000001");
+        harnessCfgLoad(strLstSize(argList), strLstPtr(argList));
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async stream");
+        harnessLogResult(
+            "P00   INFO: get 1 WAL file(s) from archive: 000000010000000200000001\n"
+            "P01 DETAIL: found 000000010000000200000001 in the archive\n"
+            "P00   INFO: get 3 WAL file(s) from archive: 000000010000000200000002...000000010000000200000004\n"
+            "P01 DETAIL: found 000000010000000200000002 in the archive\n"
+            "P01 DETAIL: found 000000010000000200000003 in the archive\n"
+            "P01 DETAIL: unable to find 000000010000000200000004 in the archive");
+
+        TEST_RESULT_STR(
+            strPtr(strLstJoin(strLstSort(storageListNP(storageSpool(), strNew(STORAGE_SPOOL_ARCHIVE_IN)), sortOrderAsc), "|")),
+            "000000010000000200000001|000000010000000200000002|000000010000000200000003|000000010000000200000004.ok",
+            "check queue");
+
+        // Stop streaming when replay stalls
+        // -------------------------------------------------------------------------------------------------------------------------
+        storagePathRemoveP(storageSpoolWrite(), strNew(STORAGE_SPOOL_ARCHIVE_IN), .recurse = true);
+        storagePathCreateNP(storageSpoolWrite(), strNew(STORAGE_SPOOL_ARCHIVE_IN));
+
+        argList = strLstDup(argCleanList);
+        strLstAddZ(argList, "--archive-get-stream");
+        strLstAddZ(argList, "--archive-get-queue-max=16MB");
+        strLstAddZ(argList, "--archive-timeout=0.2");
+        strLstAddZ(argList, "000000010000000200000001");
+        strLstAddZ(argList, "000000010000000200000002");
+        harnessCfgLoad(strLstSize(argList), strLstPtr(argList));
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async stream stalled");
+        harnessLogResult(
+            "P00   INFO: get 2 WAL file(s) from archive: 000000010000000200000001...000000010000000200000002\n"
+            "P01 DETAIL: found 000000010000000200000001 in the archive\n"
+            "P01 DETAIL: found 000000010000000200000002 in the archive");
+
+        protocolFree();
     }
 
     // *****************************************************************************************************************************
@@ -1,6 +1,7 @@
 /***********************************************************************************************************************************
 Test Archive Push Command
 ***********************************************************************************************************************************/
+#include "common/crypto/cipherBlock.h"
 #include "common/io/bufferRead.h"
 #include "common/io/bufferWrite.h"
 #include "common/io/handleRead.h"
@@ -350,8 +351,9 @@ testRun(void)
         varLstAdd(paramList, varNewStrZ("000000010000000100000002"));
         varLstAdd(paramList, varNewUInt64(cipherTypeNone));
         varLstAdd(paramList, NULL);
-        varLstAdd(paramList, varNewBool(false));
+        varLstAdd(paramList, varNewUInt(compressTypeNone));
         varLstAdd(paramList, varNewInt(6));
+        varLstAdd(paramList, varNewUInt(1));
 
         TEST_RESULT_BOOL(
             archivePushProtocol(PROTOCOL_COMMAND_ARCHIVE_PUSH_STR, paramList, server), true, "protocol archive put");
@@ -363,10 +365,43 @@ testRun(void)
 
         bufUsedSet(serverWrite, 0);
 
+        // A segment pushed by another process after the index was loaded is seen by the next batch
+        // -------------------------------------------------------------------------------------------------------------------------
+        storagePathRemoveP(storageTest, strNew("repo/archive/test/11-1/0000000100000001"), .recurse = true);
+        storagePutNP(
+            storageNewWriteNP(
+                storageTest,
+                strNew(
+                    "repo/archive/test/11-1/0000000100000001/"
+                        "000000010000000100000002-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa")),
+            BUFSTRDEF(BOGUS_STR));
+
+        varLstFree(paramList);
+        paramList = varLstNew();
+        varLstAdd(paramList, varNewStr(strNewFmt("%s/pg/pg_wal/000000010000000100000002", testPath())));
+        varLstAdd(paramList, varNewStrZ("11-1"));
+        varLstAdd(paramList, varNewUInt64(PG_VERSION_11));
+        varLstAdd(paramList, varNewUInt64(0xFACEFACEFACEFACE));
+        varLstAdd(paramList, varNewStrZ("000000010000000100000002"));
+        varLstAdd(paramList, varNewUInt64(cipherTypeNone));
+        varLstAdd(paramList, NULL);
+        varLstAdd(paramList, varNewUInt(compressTypeNone));
+        varLstAdd(paramList, varNewInt(6));
+        varLstAdd(paramList, varNewUInt(2));
+
+        TEST_ERROR(
+            archivePushProtocol(PROTOCOL_COMMAND_ARCHIVE_PUSH_STR, paramList, server), ArchiveDuplicateError,
+            "WAL file '000000010000000100000002' already exists in the archive");
+
+        storagePathRemoveP(storageTest, strNew("repo/archive/test/11-1/0000000100000001"), .recurse = true);
+
         // Check invalid protocol function
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_RESULT_BOOL(archivePushProtocol(strNew(BOGUS_STR), paramList, server), false, "invalid function");
 
+        // The protocol handler enables the WAL segment index so disable it before the repo is recreated below
+        walSegmentIndexDisable();
+
         // Create a new encrypted repo to test encryption
         // -------------------------------------------------------------------------------------------------------------------------
         storagePathRemoveP(storageTest, strNew("repo"), .errorOnMissing = true, .recurse = true);
@@ -687,7 +722,76 @@ testRun(void)
         TEST_RESULT_STR(
             strPtr(strLstJoin(strLstSort(storageListNP(storageSpool(), strNew(STORAGE_SPOOL_ARCHIVE_OUT)), sortOrderAsc), "|")),
             "000000010000000100000001.ok|000000010000000100000002.ok", "check status files");
+
+        // Stream WAL as it becomes ready
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_INT(archivePushWatchNew(strNew("bogus")), -1, "watch missing path");
+        TEST_RESULT_VOID(archivePushWatchWait(-1, 10), "wait without watch");
+
+        Buffer *walBuffer = bufNew((size_t)16 * 1024 * 1024);
+        bufUsedSet(walBuffer, bufSize(walBuffer));
+        memset(bufPtr(walBuffer), 0x0D, bufSize(walBuffer));
+        pgWalTestToBuffer((PgWal){.version = PG_VERSION_94, .systemId = 0xAAAABBBBCCCCDDDD}, walBuffer);
+
+        storagePutNP(storageNewWriteNP(storagePgWrite(), strNew("pg_xlog/000000010000000100000003")), walBuffer);
+        storagePutNP(storageNewWriteNP(storagePgWrite(), strNew("pg_xlog/000000010000000100000004")), walBuffer);
+        storagePutNP(storageNewWriteNP(storagePgWrite(), strNew("pg_xlog/archive_status/000000010000000100000003.ready")), NULL);
+
+        argListTemp = strLstDup(argList);
+        strLstAddZ(argListTemp, "--archive-push-stream");
+        strLstAddZ(argListTemp, "--archive-timeout=1");
+        harnessCfgLoad(strLstSize(argListTemp), strLstPtr(argListTemp));
+
+        HARNESS_FORK_BEGIN()
+        {
+            HARNESS_FORK_CHILD_BEGIN(0, false)
+            {
+                // Mark the next WAL segment ready while the async process is waiting
+                sleepMSec(250);
+
+                storagePutNP(
+                    storageNewWriteNP(storagePgWrite(), strNew("pg_xlog/archive_status/000000010000000100000004.ready")), NULL);
+            }
+            HARNESS_FORK_CHILD_END();
+
+            HARNESS_FORK_PARENT_BEGIN()
+            {
+                TEST_RESULT_VOID(cmdArchivePushAsync(), "push WAL segments as they are ready");
+            }
+            HARNESS_FORK_PARENT_END();
         }
+        HARNESS_FORK_END();
+
+        harnessLogResult(
+            "P00   INFO: push 1 WAL file(s) to archive: 000000010000000100000003\n"
+            "P01 DETAIL: pushed WAL file '000000010000000100000003' to the archive\n"
+            "P00   INFO: push 1 WAL file(s) to archive: 000000010000000100000004\n"
+            "P01 DETAIL: pushed WAL file '000000010000000100000004' to the archive");
+
+        TEST_RESULT_STR(
+            strPtr(strLstJoin(strLstSort(storageListNP(storageSpool(), strNew(STORAGE_SPOOL_ARCHIVE_OUT)), sortOrderAsc), "|")),
+            "000000010000000100000001.ok|000000010000000100000002.ok|000000010000000100000003.ok|000000010000000100000004.ok",
+            "check status files");
+
+        // Retry WAL that could not be pushed until archive-timeout
+        // -------------------------------------------------------------------------------------------------------------------------
+        storagePutNP(storageNewWriteNP(storagePgWrite(), strNew("pg_xlog/archive_status/000000010000000100000005.ready")), NULL);
+
+        TEST_RESULT_VOID(cmdArchivePushAsync(), "retry WAL segment");
+        harnessLogResult(
+            strPtr(
+                strNewFmt(
+                    "P00   INFO: push 1 WAL file(s) to archive: 000000010000000100000005\n"
+                    "P01   WARN: could not push WAL file '000000010000000100000005' to the archive (will be retried): "
+                        "[55] raised from local-1 protocol: " STORAGE_ERROR_READ_MISSING "\n"
+                    "P00   INFO: push 1 WAL file(s) to archive: 000000010000000100000005\n"
+                    "P01   WARN: could not push WAL file '000000010000000100000005' to the archive (will be retried): "
+                        "[55] raised from local-1 protocol: " STORAGE_ERROR_READ_MISSING,
+                    strPtr(strNewFmt("%s/pg/pg_xlog/000000010000000100000005", testPath())),
+                    strPtr(strNewFmt("%s/pg/pg_xlog/000000010000000100000005", testPath())))));
+
+        protocolFree();
+    }
 
     FUNCTION_HARNESS_RESULT_VOID();
 }
@@ -3,6 +3,7 @@ Test Common Functions and Definitions for Backup and Expire Commands
 ***********************************************************************************************************************************/
 #include "common/harnessConfig.h"
 #include "common/io/bufferWrite.h"
+#include "common/io/io.h"
 #include "common/regExp.h"
 #include "common/type/json.h"
 #include "postgres/interface.h"
@@ -254,6 +255,116 @@ testRun(void)
         TEST_ERROR(ioWrite(write, buffer), AssertError, "should not be possible to see two misaligned pages in a row");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("PageDelta"))
+    {
+        // Relation with two full maps of pages and a partial last page.  The base has one less page than the first two maps.
+        // -------------------------------------------------------------------------------------------------------------------------
+        Buffer *buffer = bufNew(PG_PAGE_SIZE_DEFAULT * (PAGE_DELTA_MAP_PAGE_MAX + 2) + 100);
+        bufUsedSet(buffer, bufSize(buffer));
+        memset(bufPtr(buffer), 0, bufSize(buffer));
+
+        for (unsigned int pageIdx = 0; pageIdx < PAGE_DELTA_MAP_PAGE_MAX + 2; pageIdx++)
+        {
+            ((PageHeaderData *)(bufPtr(buffer) + (PG_PAGE_SIZE_DEFAULT * pageIdx)))->pd_upper = 0x01;
+            ((PageHeaderData *)(bufPtr(buffer) + (PG_PAGE_SIZE_DEFAULT * pageIdx)))->pd_lsn.xrecoff = 0xFF;
+        }
+
+        // Page 1 has lsn at the limit
+        ((PageHeaderData *)(bufPtr(buffer) + (PG_PAGE_SIZE_DEFAULT * 0x01)))->pd_lsn.xrecoff = 0x100;
+
+        // Page 2 is new
+        ((PageHeaderData *)(bufPtr(buffer) + (PG_PAGE_SIZE_DEFAULT * 0x02)))->pd_upper = 0x00;
+
+        // Page 3 has lsn above the limit in the high bits
+        ((PageHeaderData *)(bufPtr(buffer) + (PG_PAGE_SIZE_DEFAULT * 0x03)))->pd_lsn.walid = 0x01;
+
+        Buffer *bufferOut = bufNew(0);
+        IoWrite *write = ioBufferWriteNew(bufferOut);
+        ioFilterGroupAdd(
+            ioWriteFilterGroup(write),
+            pageDeltaNewVar(
+                varVarLst(
+                    jsonToVar(
+                        strNewFmt(
+                            "[%u,%" PRIu64 ",%" PRIu64 "]", PG_PAGE_SIZE_DEFAULT, (uint64_t)0x100,
+                            (uint64_t)PG_PAGE_SIZE_DEFAULT * (PAGE_DELTA_MAP_PAGE_MAX + 1))))));
+
+        // Write the input unaligned and with a small output buffer so maps are output in pieces
+        ioBufferSizeSet(777);
+        ioWriteOpen(write);
+
+        for (size_t inputOffset = 0; inputOffset < bufUsed(buffer); inputOffset += 3000)
+        {
+            size_t inputSize = bufUsed(buffer) - inputOffset < 3000 ? bufUsed(buffer) - inputOffset : 3000;
+            ioWrite(write, BUF(bufPtr(buffer) + inputOffset, inputSize));
+        }
+
+        ioWriteClose(write);
+        ioBufferSizeSet(8192);
+
+        TEST_RESULT_UINT(
+            varUInt(ioFilterGroupResult(ioWriteFilterGroup(write), PAGE_DELTA_FILTER_TYPE_STR)), 5, "pages stored");
+        TEST_RESULT_SIZE(
+            bufUsed(bufferOut),
+            PAGE_DELTA_MAP_HEADER_SIZE + 16 + PG_PAGE_SIZE_DEFAULT * 3 + PAGE_DELTA_MAP_HEADER_SIZE + 1 + PG_PAGE_SIZE_DEFAULT +
+                100 + PAGE_DELTA_MAP_HEADER_SIZE,
+            "    check size");
+
+        // Check the first map header
+        TEST_RESULT_STR(
+            strPtr(bufHex(BUF(bufPtr(bufferOut), PAGE_DELTA_MAP_HEADER_SIZE + 16))),
+            "0010000070000000000000000000000000000000", "    check first map");
+        TEST_RESULT_BOOL(
+            memcmp(
+                bufPtr(bufferOut) + PAGE_DELTA_MAP_HEADER_SIZE + 16, bufPtr(buffer) + PG_PAGE_SIZE_DEFAULT,
+                PG_PAGE_SIZE_DEFAULT * 3) == 0,
+            true, "    check first map pages");
+
+        // Check the second map header and the end of delta
+        size_t mapOffset = PAGE_DELTA_MAP_HEADER_SIZE + 16 + PG_PAGE_SIZE_DEFAULT * 3;
+
+        TEST_RESULT_STR(
+            strPtr(bufHex(BUF(bufPtr(bufferOut) + mapOffset, PAGE_DELTA_MAP_HEADER_SIZE + 1))), "0000406460",
+            "    check second map");
+        TEST_RESULT_BOOL(
+            memcmp(
+                bufPtr(bufferOut) + mapOffset + PAGE_DELTA_MAP_HEADER_SIZE + 1,
+                bufPtr(buffer) + PG_PAGE_SIZE_DEFAULT * (PAGE_DELTA_MAP_PAGE_MAX + 1), PG_PAGE_SIZE_DEFAULT + 100) == 0,
+            true, "    check second map pages");
+        TEST_RESULT_STR(
+            strPtr(bufHex(BUF(bufPtr(bufferOut) + bufUsed(bufferOut) - PAGE_DELTA_MAP_HEADER_SIZE, PAGE_DELTA_MAP_HEADER_SIZE))),
+            "00000000", "    check end of delta");
+
+        // Relation with exactly one map of pages so the end of delta is output after the map
+        // -------------------------------------------------------------------------------------------------------------------------
+        bufUsedSet(buffer, PG_PAGE_SIZE_DEFAULT * PAGE_DELTA_MAP_PAGE_MAX);
+        bufferOut = bufNew(0);
+        write = ioBufferWriteNew(bufferOut);
+        ioFilterGroupAdd(ioWriteFilterGroup(write), pageDeltaNew(PG_PAGE_SIZE_DEFAULT, 0x100, bufUsed(buffer)));
+        ioWriteOpen(write);
+        ioWrite(write, buffer);
+        ioWriteClose(write);
+
+        TEST_RESULT_UINT(
+            varUInt(ioFilterGroupResult(ioWriteFilterGroup(write), PAGE_DELTA_FILTER_TYPE_STR)), 3, "pages stored");
+        TEST_RESULT_SIZE(
+            bufUsed(bufferOut), PAGE_DELTA_MAP_HEADER_SIZE + 16 + PG_PAGE_SIZE_DEFAULT * 3 + PAGE_DELTA_MAP_HEADER_SIZE,
+            "    check size");
+
+        // Empty relation
+        // -------------------------------------------------------------------------------------------------------------------------
+        bufferOut = bufNew(0);
+        write = ioBufferWriteNew(bufferOut);
+        ioFilterGroupAdd(ioWriteFilterGroup(write), pageDeltaNew(PG_PAGE_SIZE_DEFAULT, 0x100, 0));
+        ioWriteOpen(write);
+        ioWriteClose(write);
+
+        TEST_RESULT_UINT(
+            varUInt(ioFilterGroupResult(ioWriteFilterGroup(write), PAGE_DELTA_FILTER_TYPE_STR)), 0, "no pages stored");
+        TEST_RESULT_STR(strPtr(bufHex(bufferOut)), "00000000", "    check end of delta");
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("backupType() and backupTypeStr()"))
     {
@@ -1,6 +1,8 @@
 /***********************************************************************************************************************************
 Test Backup Command
 ***********************************************************************************************************************************/
+#include "common/compress/gzip/compressParallel.h"
+#include "common/compress/gzip/decompress.h"
 #include "common/io/bufferRead.h"
 #include "common/io/bufferWrite.h"
 #include "common/io/io.h"
@@ -60,7 +62,8 @@ testRun(void)
         TEST_ASSIGN(
             result,
             backupFile(
-                missingFile, true, 0, NULL, false, 0, missingFile, false, false, 1, backupLabel, false, cipherTypeNone, NULL),
+                missingFile, true, 0, NULL, false, 0, 0, 0, missingFile, false, compressTypeNone, 1, 1, backupLabel, false,
+                cipherTypeNone, NULL, 1),
             "pg file missing, ignoreMissing=true, no delta");
         TEST_RESULT_UINT(result.copySize + result.repoSize, 0, "    copy/repo size 0");
         TEST_RESULT_UINT(result.backupCopyResult, backupCopyResultSkip, "    skip file");
@@ -77,10 +80,13 @@ testRun(void)
         varLstAdd(paramList, varNewUInt64(0));              // pgFileChecksumPageLsnLimit 2
         varLstAdd(paramList, varNewStr(missingFile));       // repoFile
         varLstAdd(paramList, varNewBool(false));            // repoFileHasReference
-        varLstAdd(paramList, varNewBool(false));            // repoFileCompress
-        varLstAdd(paramList, varNewUInt(0));                // repoFileCompressLevel
+        varLstAdd(paramList, varNewStrZ("none"));           // repoFileCompress
+        varLstAdd(paramList, varNewInt(0));                 // repoFileCompressLevel
         varLstAdd(paramList, varNewStr(backupLabel));       // backupLabel
         varLstAdd(paramList, varNewBool(false));            // delta
+        varLstAdd(paramList, varNewUInt64(0));              // pgFilePageDeltaLsn 1
+        varLstAdd(paramList, varNewUInt64(0));              // pgFilePageDeltaLsn 2
+        varLstAdd(paramList, varNewUInt64(0));              // pgFilePageDeltaBaseSize
 
         TEST_RESULT_BOOL(
             backupProtocol(PROTOCOL_COMMAND_BACKUP_FILE_STR, paramList, server), true, "protocol backup file - skip");
@@ -91,7 +97,8 @@ testRun(void)
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_ERROR_FMT(
             backupFile(
-                missingFile, false, 0, NULL, false, 0, missingFile, false, false, 1, backupLabel, false, cipherTypeNone, NULL),
+                missingFile, false, 0, NULL, false, 0, 0, 0, missingFile, false, compressTypeNone, 1, 1, backupLabel, false,
+                cipherTypeNone, NULL, 1),
             FileMissingError, "unable to open missing file '%s/pg/missing' for read", testPath());
 
         // Create a pg file to backup
@@ -106,7 +113,9 @@ testRun(void)
 
         TEST_ASSIGN(
             result,
-            backupFile(pgFile, false, 9, NULL, false, 0, pgFile, false, false, 1, backupLabel, false, cipherTypeNone, NULL),
+            backupFile(
+                pgFile, false, 9, NULL, false, 0, 0, 0, pgFile, false, compressTypeNone, 1, 1, backupLabel, false, cipherTypeNone,
+                NULL, 1),
             "pg file exists, no repo file, no ignoreMissing, no pageChecksum, no delta, no hasReference");
 
         ((Storage *)storageRepo())->interface.feature = feature;
@@ -125,8 +134,8 @@ testRun(void)
         TEST_ASSIGN(
             result,
             backupFile(
-                pgFile, false, 9, NULL, true, 0xFFFFFFFFFFFFFFFF, pgFile, false, false, 1, backupLabel, false, cipherTypeNone,
-                NULL),
+                pgFile, false, 9, NULL, true, 0xFFFFFFFFFFFFFFFF, 0, 0, pgFile, false, compressTypeNone, 1, 1, backupLabel, false,
+                cipherTypeNone, NULL, 1),
             "file checksummed with pageChecksum enabled");
         TEST_RESULT_UINT(result.copySize + result.repoSize, 18, "    copy=repo=pgFile size");
         TEST_RESULT_UINT(result.backupCopyResult, backupCopyResultCopy, "    copy file");
@@ -139,6 +148,23 @@ testRun(void)
             varBool(kvGet(result.pageChecksumResult, VARSTRDEF("valid"))), false, "    pageChecksumResult valid=false");
         TEST_RESULT_VOID(storageRemoveNP(storageRepoWrite(), backupPathFile), "    remove repo file");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        // Test page delta
+        TEST_ASSIGN(
+            result,
+            backupFile(
+                pgFile, false, 9, NULL, false, 0, 0x100, 0, pgFile, false, compressTypeNone, 1, 1, backupLabel, false,
+                cipherTypeNone, NULL, 1),
+            "file stored as page delta");
+        TEST_RESULT_UINT(result.copySize, 9, "    copy=pgFile size");
+        TEST_RESULT_UINT(result.repoSize, 18, "    repo=page delta size");
+        TEST_RESULT_UINT(result.backupCopyResult, backupCopyResultCopy, "    copy file");
+        TEST_RESULT_STR(strPtr(result.copyChecksum), "9bc8ab2dda60ef4beed07d1e19ce0676d5edde67", "    checksum of pgFile");
+        TEST_RESULT_STR(
+            strPtr(bufHex(storageGetNP(storageNewReadNP(storageRepo(), backupPathFile)))), "0000000980617465737466696c6500000000",
+            "    check page delta");
+        TEST_RESULT_VOID(storageRemoveNP(storageRepoWrite(), backupPathFile), "    remove repo file");
+
         // Check protocol function directly
         // -------------------------------------------------------------------------------------------------------------------------
         // pgFileSize, ignoreMissing=false, backupLabel, pgFileChecksumPage, pgFileChecksumPageLsnLimit
@@ -152,10 +178,13 @@ testRun(void)
         varLstAdd(paramList, varNewUInt64(0xFFFFFFFF));     // pgFileChecksumPageLsnLimit 2
         varLstAdd(paramList, varNewStr(pgFile));            // repoFile
         varLstAdd(paramList, varNewBool(false));            // repoFileHasReference
-        varLstAdd(paramList, varNewBool(false));            // repoFileCompress
-        varLstAdd(paramList, varNewUInt(1));                // repoFileCompressLevel
+        varLstAdd(paramList, varNewStrZ("none"));           // repoFileCompress
+        varLstAdd(paramList, varNewInt(1));                 // repoFileCompressLevel
         varLstAdd(paramList, varNewStr(backupLabel));       // backupLabel
         varLstAdd(paramList, varNewBool(false));            // delta
+        varLstAdd(paramList, varNewUInt64(0));              // pgFilePageDeltaLsn 1
+        varLstAdd(paramList, varNewUInt64(0));              // pgFilePageDeltaLsn 2
+        varLstAdd(paramList, varNewUInt64(0));              // pgFilePageDeltaBaseSize
 
         TEST_RESULT_BOOL(
             backupProtocol(PROTOCOL_COMMAND_BACKUP_FILE_STR, paramList, server), true, "protocol backup file - pageChecksum");
@@ -170,8 +199,8 @@ testRun(void)
         TEST_ASSIGN(
             result,
             backupFile(
-                pgFile, false, 9, strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"), false, 0, pgFile, true, false, 1, backupLabel,
-                true, cipherTypeNone, NULL),
+                pgFile, false, 9, strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"), false, 0, 0, 0, pgFile, true,
+                compressTypeNone, 1, 1, backupLabel, true, cipherTypeNone, NULL, 1),
             "file in db and repo, checksum equal, no ignoreMissing, no pageChecksum, delta, hasReference");
         TEST_RESULT_UINT(result.copySize, 9, "    copy size set");
         TEST_RESULT_UINT(result.repoSize, 0, "    repo size not set since already exists in repo");
@@ -194,10 +223,13 @@ testRun(void)
         varLstAdd(paramList, varNewUInt64(0));              // pgFileChecksumPageLsnLimit 2
         varLstAdd(paramList, varNewStr(pgFile));            // repoFile
         varLstAdd(paramList, varNewBool(true));             // repoFileHasReference
-        varLstAdd(paramList, varNewBool(false));            // repoFileCompress
-        varLstAdd(paramList, varNewUInt(1));                // repoFileCompressLevel
+        varLstAdd(paramList, varNewStrZ("none"));           // repoFileCompress
+        varLstAdd(paramList, varNewInt(1));                 // repoFileCompressLevel
         varLstAdd(paramList, varNewStr(backupLabel));       // backupLabel
         varLstAdd(paramList, varNewBool(true));             // delta
+        varLstAdd(paramList, varNewUInt64(0));              // pgFilePageDeltaLsn 1
+        varLstAdd(paramList, varNewUInt64(0));              // pgFilePageDeltaLsn 2
+        varLstAdd(paramList, varNewUInt64(0));              // pgFilePageDeltaBaseSize
 
         TEST_RESULT_BOOL(
             backupProtocol(PROTOCOL_COMMAND_BACKUP_FILE_STR, paramList, server), true, "protocol backup file - noop");
@@ -211,8 +243,8 @@ testRun(void)
         TEST_ASSIGN(
             result,
             backupFile(
-                pgFile, false, 9, strNew("1234567890123456789012345678901234567890"), false, 0, pgFile, true, false, 1, backupLabel,
-                true, cipherTypeNone, NULL),
+                pgFile, false, 9, strNew("1234567890123456789012345678901234567890"), false, 0, 0, 0, pgFile, true,
+                compressTypeNone, 1, 1, backupLabel, true, cipherTypeNone, NULL, 1),
             "file in db and repo, pg checksum not equal, no ignoreMissing, no pageChecksum, delta, hasReference");
         TEST_RESULT_UINT(result.copySize + result.repoSize, 18, "    copy=repo=pgFile size");
         TEST_RESULT_UINT(result.backupCopyResult, backupCopyResultCopy, "    copy file");
@@ -226,8 +258,8 @@ testRun(void)
         TEST_ASSIGN(
             result,
             backupFile(
-                pgFile, false, 8, strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"), false, 0, pgFile, true, false, 1, backupLabel,
-                true, cipherTypeNone, NULL),
+                pgFile, false, 8, strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"), false, 0, 0, 0, pgFile, true,
+                compressTypeNone, 1, 1, backupLabel, true, cipherTypeNone, NULL, 1),
             "db & repo file, pg checksum same, pg size different, no ignoreMissing, no pageChecksum, delta, hasReference");
         TEST_RESULT_UINT(result.copySize + result.repoSize, 18, "    copy=repo=pgFile size");
         TEST_RESULT_UINT(result.backupCopyResult, backupCopyResultCopy, "    copy file");
@@ -244,8 +276,8 @@ testRun(void)
         TEST_ASSIGN(
             result,
             backupFile(
-                pgFile, false, 9, strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"), false, 0, pgFile, false, false, 1,
-                backupLabel, true, cipherTypeNone, NULL),
+                pgFile, false, 9, strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"), false, 0, 0, 0, pgFile, false,
+                compressTypeNone, 1, 1, backupLabel, true, cipherTypeNone, NULL, 1),
             "    db & repo file, pgFileMatch, repo checksum no match, no ignoreMissing, no pageChecksum, delta, no hasReference");
         TEST_RESULT_UINT(result.copySize + result.repoSize, 18, "    copy=repo=pgFile size");
         TEST_RESULT_UINT(result.backupCopyResult, backupCopyResultReCopy, "    recopy file");
@@ -262,8 +294,8 @@ testRun(void)
         TEST_ASSIGN(
             result,
             backupFile(
-                missingFile, true, 9, strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"), false, 0, pgFile, false, false, 1,
-                backupLabel, true, cipherTypeNone, NULL),
+                missingFile, true, 9, strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"), false, 0, 0, 0, pgFile, false,
+                compressTypeNone, 1, 1, backupLabel, true, cipherTypeNone, NULL, 1),
             "    file in repo only, checksum in repo equal, ignoreMissing=true, no pageChecksum, delta, no hasReference");
         TEST_RESULT_UINT(result.copySize + result.repoSize, 0, "    copy=repo=0 size");
         TEST_RESULT_UINT(result.backupCopyResult, backupCopyResultSkip, "    skip file");
@@ -275,7 +307,9 @@ testRun(void)
         // No prior checksum, compression, no page checksum, no pageChecksum, no delta, no hasReference
         TEST_ASSIGN(
             result,
-            backupFile(pgFile, false, 9, NULL, false, 0, pgFile, false, true, 3, backupLabel, false, cipherTypeNone, NULL),
+            backupFile(
+                pgFile, false, 9, NULL, false, 0, 0, 0, pgFile, false, compressTypeGzip, 3, 1, backupLabel, false, cipherTypeNone,
+                NULL, 1),
             "pg file exists, no checksum, no ignoreMissing, compression, no pageChecksum, no delta, no hasReference");
 
         TEST_RESULT_UINT(result.copySize, 9, "    copy=pgFile size");
@@ -292,8 +326,8 @@ testRun(void)
         TEST_ASSIGN(
             result,
             backupFile(
-                pgFile, false, 9, strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"), false, 0, pgFile, false, true, 3, backupLabel,
-                false, cipherTypeNone, NULL),
+                pgFile, false, 9, strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"), false, 0, 0, 0, pgFile, false,
+                compressTypeGzip, 3, 1, backupLabel, false, cipherTypeNone, NULL, 1),
             "pg file & repo exists, match, checksum, no ignoreMissing, compression, no pageChecksum, no delta, no hasReference");
 
         TEST_RESULT_UINT(result.copySize, 9, "    copy=pgFile size");
@@ -318,10 +352,13 @@ testRun(void)
         varLstAdd(paramList, varNewUInt64(0));              // pgFileChecksumPageLsnLimit 2
         varLstAdd(paramList, varNewStr(pgFile));            // repoFile
         varLstAdd(paramList, varNewBool(false));            // repoFileHasReference
-        varLstAdd(paramList, varNewBool(true));             // repoFileCompress
-        varLstAdd(paramList, varNewUInt(3));                // repoFileCompressLevel
+        varLstAdd(paramList, varNewStrZ("gz"));             // repoFileCompress
+        varLstAdd(paramList, varNewInt(3));                 // repoFileCompressLevel
         varLstAdd(paramList, varNewStr(backupLabel));       // backupLabel
         varLstAdd(paramList, varNewBool(false));            // delta
+        varLstAdd(paramList, varNewUInt64(0));              // pgFilePageDeltaLsn 1
+        varLstAdd(paramList, varNewUInt64(0));              // pgFilePageDeltaLsn 2
+        varLstAdd(paramList, varNewUInt64(0));              // pgFilePageDeltaBaseSize
 
         TEST_RESULT_BOOL(
             backupProtocol(PROTOCOL_COMMAND_BACKUP_FILE_STR, paramList, server), true, "protocol backup file - copy, compress");
@@ -338,8 +375,8 @@ testRun(void)
         TEST_ASSIGN(
             result,
             backupFile(
-                strNew("zerofile"), false, 0, NULL, false, 0, strNew("zerofile"), false, false, 1, backupLabel, false,
-                cipherTypeNone, NULL),
+                strNew("zerofile"), false, 0, NULL, false, 0, 0, 0, strNew("zerofile"), false, compressTypeNone, 1, 1,
+                backupLabel, false, cipherTypeNone, NULL, 1),
             "zero-sized pg file exists, no repo file, no ignoreMissing, no pageChecksum, no delta, no hasReference");
         TEST_RESULT_UINT(result.copySize + result.repoSize, 0, "    copy=repo=pgFile size 0");
         TEST_RESULT_UINT(result.backupCopyResult, backupCopyResultCopy, "    copy file");
@@ -349,6 +386,28 @@ testRun(void)
                 result.pageChecksumResult == NULL),
             true, "    copy zero file to repo success");
 
+        // Compress a large file in threads
+        // -------------------------------------------------------------------------------------------------------------------------
+        Buffer *largeFile = bufNew(GZIP_COMPRESS_PARALLEL_BLOCK_SIZE * 2 + 1);
+        memset(bufPtr(largeFile), 'X', bufSize(largeFile));
+        bufUsedSet(largeFile, bufSize(largeFile));
+        storagePutNP(storageNewWriteNP(storagePgWrite(), strNew("largefile")), largeFile);
+
+        TEST_ASSIGN(
+            result,
+            backupFile(
+                strNew("largefile"), false, bufUsed(largeFile), NULL, false, 0, 0, 0, strNew("largefile"), false,
+                compressTypeGzip, 3, 2, backupLabel, false, cipherTypeNone, NULL, 1),
+            "compress large file in threads");
+        TEST_RESULT_UINT(result.copySize, bufUsed(largeFile), "    copy size set");
+        TEST_RESULT_UINT(result.backupCopyResult, backupCopyResultCopy, "    copy file");
+
+        StorageRead *largeFileRead = storageNewReadNP(
+            storageRepo(), strNewFmt(STORAGE_REPO_BACKUP "/%s/largefile.gz", strPtr(backupLabel)));
+        ioFilterGroupAdd(ioReadFilterGroup(storageReadIo(largeFileRead)), gzipDecompressNew(false));
+
+        TEST_RESULT_BOOL(bufEq(storageGetNP(largeFileRead), largeFile), true, "    repo file decompresses to pg file");
+
         // Check invalid protocol function
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_RESULT_BOOL(backupProtocol(strNew(BOGUS_STR), paramList, server), false, "invalid function");
@@ -381,8 +440,8 @@ testRun(void)
         TEST_ASSIGN(
             result,
             backupFile(
-                pgFile, false, 9, NULL, false, 0, pgFile, false, false, 1, backupLabel, false, cipherTypeAes256Cbc,
-                strNew("12345678")),
+                pgFile, false, 9, NULL, false, 0, 0, 0, pgFile, false, compressTypeNone, 1, 1, backupLabel, false,
+                cipherTypeAes256Cbc, strNew("12345678"), 1),
             "pg file exists, no repo file, no ignoreMissing, no pageChecksum, no delta, no hasReference");
 
         TEST_RESULT_UINT(result.copySize, 9, "    copy size set");
@@ -398,8 +457,8 @@ testRun(void)
         TEST_ASSIGN(
             result,
             backupFile(
-                pgFile, false, 8, strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"), false, 0, pgFile, false, false, 1,
-                backupLabel, true, cipherTypeAes256Cbc, strNew("12345678")),
+                pgFile, false, 8, strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"), false, 0, 0, 0, pgFile, false,
+                compressTypeNone, 1, 1, backupLabel, true, cipherTypeAes256Cbc, strNew("12345678"), 1),
             "pg and repo file exists, pgFileMatch false, no ignoreMissing, no pageChecksum, delta, no hasReference");
         TEST_RESULT_UINT(result.copySize, 9, "    copy size set");
         TEST_RESULT_UINT(result.repoSize, 32, "    repo size set");
@@ -415,8 +474,8 @@ testRun(void)
         TEST_ASSIGN(
             result,
             backupFile(
-                pgFile, false, 9, strNew("1234567890123456789012345678901234567890"), false, 0, pgFile, false, false, 0,
-                backupLabel, false, cipherTypeAes256Cbc, strNew("12345678")),
+                pgFile, false, 9, strNew("1234567890123456789012345678901234567890"), false, 0, 0, 0, pgFile, false,
+                compressTypeNone, 0, 1, backupLabel, false, cipherTypeAes256Cbc, strNew("12345678"), 1),
             "pg and repo file exists, repo checksum no match, no ignoreMissing, no pageChecksum, no delta, no hasReference");
         TEST_RESULT_UINT(result.copySize, 9, "    copy size set");
         TEST_RESULT_UINT(result.repoSize, 32, "    repo size set");
@@ -426,6 +485,25 @@ testRun(void)
                 storageExistsNP(storageRepo(), backupPathFile) && result.pageChecksumResult == NULL),
             true, "    recopy file to encrypted repo success");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        // Compress and encrypt with filters in threads
+        size_t oldBufferSize = ioBufferSize();
+        ioBufferSizeSet(4);
+        ioFilterThreadSet(true);
+
+        TEST_ASSIGN(
+            result,
+            backupFile(
+                pgFile, false, 9, NULL, false, 0, 0, 0, pgFile, false, compressTypeGzip, 3, 1, backupLabel, false,
+                cipherTypeAes256Cbc, strNew("12345678"), 1),
+            "pg file exists, compress and encrypt in threads");
+        TEST_RESULT_UINT(result.copySize, 9, "    copy size set");
+        TEST_RESULT_UINT(result.backupCopyResult, backupCopyResultCopy, "    copy file");
+        TEST_RESULT_STR(strPtr(result.copyChecksum), "9bc8ab2dda60ef4beed07d1e19ce0676d5edde67", "    check checksum");
+
+        ioFilterThreadSet(false);
+        ioBufferSizeSet(oldBufferSize);
+
         // Check protocol function directly
         // -------------------------------------------------------------------------------------------------------------------------
         // cipherType, cipherPass
@@ -439,10 +517,13 @@ testRun(void)
         varLstAdd(paramList, varNewUInt64(0));                  // pgFileChecksumPageLsnLimit 2
         varLstAdd(paramList, varNewStr(pgFile));                // repoFile
         varLstAdd(paramList, varNewBool(false));                // repoFileHasReference
-        varLstAdd(paramList, varNewBool(false));                // repoFileCompress
-        varLstAdd(paramList, varNewUInt(0));                    // repoFileCompressLevel
+        varLstAdd(paramList, varNewStrZ("none"));               // repoFileCompress
+        varLstAdd(paramList, varNewInt(0));                     // repoFileCompressLevel
         varLstAdd(paramList, varNewStr(backupLabel));           // backupLabel
         varLstAdd(paramList, varNewBool(false));                // delta
+        varLstAdd(paramList, varNewUInt64(0));                  // pgFilePageDeltaLsn 1
+        varLstAdd(paramList, varNewUInt64(0));                  // pgFilePageDeltaLsn 2
+        varLstAdd(paramList, varNewUInt64(0));                  // pgFilePageDeltaBaseSize
         varLstAdd(paramList, varNewStrZ("12345678"));           // cipherPass
 
         TEST_RESULT_BOOL(
@@ -836,6 +836,104 @@ testRun(void)
             "P00 DETAIL: archive retention on backup 20181119-152900F, archiveId = 9.4-1, start = 000000010000000000000004\n"
             "P00 DETAIL: remove archive: archiveId = 9.4-1, start = 000000010000000000000003, stop = 000000010000000000000003");
 
+        //--------------------------------------------------------------------------------------------------------------------------
+        storagePutNP(storageNewWriteNP(storageTest, backupInfoFileName),
+            harnessInfoChecksumZ(
+                "[backup:current]\n"
+                "20181119-152100F={"
+                "\"backrest-format\":5,\"backrest-version\":\"2.08dev\","
+                "\"backup-archive-start\":\"000000010000000100000003\",\"backup-archive-stop\":\"000000010000000200000001\","
+                "\"backup-info-repo-size\":2369186,\"backup-info-repo-size-delta\":2369186,"
+                "\"backup-info-size\":20162900,\"backup-info-size-delta\":20162900,"
+                "\"backup-timestamp-start\":1542640898,\"backup-timestamp-stop\":1542640911,\"backup-type\":\"full\","
+                "\"db-id\":1,\"option-archive-check\":true,\"option-archive-copy\":false,\"option-backup-standby\":false,"
+                "\"option-checksum-page\":true,\"option-compress\":true,\"option-hardlink\":false,\"option-online\":true}\n"
+                "20181119-152138F={"
+                "\"backrest-format\":5,\"backrest-version\":\"2.08dev\","
+                "\"backup-archive-start\":\"000000010000000100000002\",\"backup-archive-stop\":\"000000010000000100000002\","
+                "\"backup-info-repo-size\":2369186,\"backup-info-repo-size-delta\":2369186,"
+                "\"backup-info-size\":20162900,\"backup-info-size-delta\":20162900,"
+                "\"backup-timestamp-start\":1542640898,\"backup-timestamp-stop\":1542640911,\"backup-type\":\"full\","
+                "\"db-id\":1,\"option-archive-check\":true,\"option-archive-copy\":false,\"option-backup-standby\":false,"
+                "\"option-checksum-page\":true,\"option-compress\":true,\"option-hardlink\":false,\"option-online\":true}\n"
+                "20181119-152800F={"
+                "\"backrest-format\":5,\"backrest-version\":\"2.08dev\","
+                "\"backup-archive-start\":\"000000010000000200000001\",\"backup-archive-stop\":\"000000010000000400000001\","
+                "\"backup-info-repo-size\":2369186,\"backup-info-repo-size-delta\":2369186,"
+                "\"backup-info-size\":20162900,\"backup-info-size-delta\":20162900,"
+                "\"backup-timestamp-start\":1542640898,\"backup-timestamp-stop\":1542640911,\"backup-type\":\"full\","
+                "\"db-id\":1,\"option-archive-check\":true,\"option-archive-copy\":false,\"option-backup-standby\":false,"
+                "\"option-checksum-page\":true,\"option-compress\":true,\"option-hardlink\":false,\"option-online\":true}\n"
+                "20181119-152900F={"
+                "\"backrest-format\":5,\"backrest-version\":\"2.08dev\","
+                "\"backup-archive-start\":\"000000010000000500000002\",\"backup-archive-stop\":\"000000010000000500000002\","
+                "\"backup-info-repo-size\":2369186,\"backup-info-repo-size-delta\":2369186,"
+                "\"backup-info-size\":20162900,\"backup-info-size-delta\":20162900,"
+                "\"backup-timestamp-start\":1542640898,\"backup-timestamp-stop\":1542640911,\"backup-type\":\"full\","
+                "\"db-id\":1,\"option-archive-check\":true,\"option-archive-copy\":false,\"option-backup-standby\":false,"
+                "\"option-checksum-page\":true,\"option-compress\":true,\"option-hardlink\":false,\"option-online\":true}\n"
+                "\n"
+                "[db]\n"
+                "db-catalog-version=201707211\n"
+                "db-control-version=1002\n"
+                "db-id=2\n"
+                "db-system-id=6626363367545678089\n"
+                "db-version=\"10\"\n"
+                "\n"
+                "[db:history]\n"
+                "1={\"db-catalog-version\":201409291,\"db-control-version\":942,\"db-system-id\":6625592122879095702,"
+                    "\"db-version\":\"9.4\"}\n"
+                "2={\"db-catalog-version\":201707211,\"db-control-version\":1002,\"db-system-id\":6626363367545678089,"
+                    "\"db-version\":\"10\"}\n"));
+
+        TEST_ASSIGN(infoBackup, infoBackupNewLoad(storageTest, backupInfoFileName, cipherTypeNone, NULL), "get backup.info");
+
+        storagePathRemoveP(storageTest, strNewFmt("%s/9.4-1", strPtr(archiveStanzaPath)), .recurse = true);
+
+        for (unsigned int majorIdx = 0; majorIdx <= 5; majorIdx++)
+            archiveGenerate(storageTest, archiveStanzaPath, 1, 5, "9.4-1", strPtr(strNewFmt("000000010000000%u", majorIdx)));
+
+        TEST_RESULT_VOID(removeExpiredArchive(infoBackup), "overlapping ranges across major paths");
+        harnessLogResult(
+            "P00 DETAIL: archive retention on backup 20181119-152100F, archiveId = 9.4-1, start = 000000010000000100000003,"
+            " stop = 000000010000000200000001\n"
+            "P00 DETAIL: archive retention on backup 20181119-152138F, archiveId = 9.4-1, start = 000000010000000100000002,"
+            " stop = 000000010000000100000002\n"
+            "P00 DETAIL: archive retention on backup 20181119-152800F, archiveId = 9.4-1, start = 000000010000000200000001,"
+            " stop = 000000010000000400000001\n"
+            "P00 DETAIL: archive retention on backup 20181119-152900F, archiveId = 9.4-1, start = 000000010000000500000002\n"
+            "P00 DETAIL: remove archive: archiveId = 9.4-1, start = 0000000100000000, stop = 000000010000000100000001\n"
+            "P00 DETAIL: remove archive: archiveId = 9.4-1, start = 000000010000000400000002, stop = 000000010000000500000001");
+
+        TEST_RESULT_BOOL(
+            storagePathExistsNP(storageTest, strNewFmt("%s/9.4-1/0000000100000000", strPtr(archiveStanzaPath))), false,
+            "  major path not in any range removed");
+        TEST_RESULT_STR(
+            strPtr(strLstJoin(strLstSort(storageListNP(
+                storageTest, strNewFmt("%s/%s/%s", strPtr(archiveStanzaPath), "9.4-1", "0000000100000001")), sortOrderAsc), ", ")),
+            strPtr(archiveExpectList(2, 5, "0000000100000001")),
+            "  archive before first range removed");
+        TEST_RESULT_STR(
+            strPtr(strLstJoin(strLstSort(storageListNP(
+                storageTest, strNewFmt("%s/%s/%s", strPtr(archiveStanzaPath), "9.4-1", "0000000100000002")), sortOrderAsc), ", ")),
+            strPtr(archiveExpectList(1, 5, "0000000100000002")),
+            "  major path included in merged range kept");
+        TEST_RESULT_STR(
+            strPtr(strLstJoin(strLstSort(storageListNP(
+                storageTest, strNewFmt("%s/%s/%s", strPtr(archiveStanzaPath), "9.4-1", "0000000100000003")), sortOrderAsc), ", ")),
+            strPtr(archiveExpectList(1, 5, "0000000100000003")),
+            "  major path included in merged range kept");
+        TEST_RESULT_STR(
+            strPtr(strLstJoin(strLstSort(storageListNP(
+                storageTest, strNewFmt("%s/%s/%s", strPtr(archiveStanzaPath), "9.4-1", "0000000100000004")), sortOrderAsc), ", ")),
+            strPtr(archiveExpectList(1, 1, "0000000100000004")),
+            "  archive after merged range removed");
+        TEST_RESULT_STR(
+            strPtr(strLstJoin(strLstSort(storageListNP(
+                storageTest, strNewFmt("%s/%s/%s", strPtr(archiveStanzaPath), "9.4-1", "0000000100000005")), sortOrderAsc), ", ")),
+            strPtr(archiveExpectList(2, 5, "0000000100000005")),
+            "  archive before retention backup removed");
+
         harnessLogLevelReset();
     }
     // *****************************************************************************************************************************
@@ -149,6 +149,8 @@ testRun(void)
             "\n"
             "  --buffer-size                    buffer size for file operations\n"
             "                                   [current=32768, default=4194304]\n"
+            "  --cipher-thread                  threads used to encrypt/decrypt each file\n"
+            "                                   [default=1]\n"
             "  --cmd-ssh                        path to ssh client executable [default=ssh]\n"
             "  --compress                       use gzip file compression [default=y]\n"
             "  --compress-level                 compression level for stored files\n"
@@ -162,6 +164,7 @@ testRun(void)
             "  --config-path                    base path of pgBackRest configuration files\n"
             "                                   [default=/etc/pgbackrest]\n"
             "  --delta                          restore or backup using checksums [default=n]\n"
+            "  --filter-thread                  run file filters in threads [default=n]\n"
             "  --lock-path                      path where lock files are stored\n"
             "                                   [default=/tmp/pgbackrest]\n"
             "  --neutral-umask                  use a neutral umask [default=y]\n"
@@ -204,6 +207,8 @@ testRun(void)
             "  --repo-s3-bucket                 s3 repository bucket\n"
             "  --repo-s3-ca-file                s3 SSL CA File\n"
             "  --repo-s3-ca-path                s3 SSL CA Path\n"
+            "  --repo-s3-download-max           max concurrent range downloads for each file\n"
+            "                                   [default=4]\n"
             "  --repo-s3-endpoint               s3 repository endpoint\n"
             "  --repo-s3-host                   s3 repository host\n"
             "  --repo-s3-key                    s3 repository access key\n"
@@ -211,6 +216,8 @@ testRun(void)
             "  --repo-s3-port                   s3 repository port [default=443]\n"
             "  --repo-s3-region                 s3 repository region\n"
             "  --repo-s3-token                  s3 repository security token\n"
+            "  --repo-s3-upload-max             max concurrent part uploads for each file\n"
+            "                                   [default=4]\n"
             "  --repo-s3-verify-tls             verify S3 server certificate [default=y]\n"
             "  --repo-type                      type of storage used for the repository\n"
             "                                   [default=posix]\n"
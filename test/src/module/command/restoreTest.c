@@ -41,23 +41,28 @@ testRun(void)
         strLstAddZ(argList, "--stanza=test1");
         strLstAdd(argList, strNewFmt("--repo1-path=%s/repo", testPath()));
         strLstAdd(argList, strNewFmt("--pg1-path=%s/pg", testPath()));
+        strLstAddZ(argList, "--repo1-cipher-type=aes-256-cbc");
         strLstAddZ(argList, "restore");
+        setenv("PGBACKREST_REPO1_CIPHER_PASS", "badpass", true);
         harnessCfgLoad(strLstSize(argList), strLstPtr(argList));
+        unsetenv("PGBACKREST_REPO1_CIPHER_PASS");
 
         // Create the pg path
         storagePathCreateP(storagePgWrite(), NULL, .mode = 0700);
 
         TEST_RESULT_BOOL(
             restoreFile(
-                repoFile1, repoFileReferenceFull, false, strNew("sparse-zero"), strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"),
-                true, 0x10000000000UL, 1557432154, 0600, strNew(testUser()), strNew(testGroup()), 0, true, false, NULL),
+                repoFile1, repoFileReferenceFull, compressTypeNone, NULL, compressTypeNone, strNew("sparse-zero"),
+                strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"), true, 0x10000000000UL, 1557432154, 0600, strNew(testUser()),
+                strNew(testGroup()), 0, true, false, cipherTypeNone, NULL, 1),
             false, "zero sparse 1TB file");
         TEST_RESULT_UINT(storageInfoNP(storagePg(), strNew("sparse-zero")).size, 0x10000000000UL, "    check size");
 
         TEST_RESULT_BOOL(
             restoreFile(
-                repoFile1, repoFileReferenceFull, false, strNew("normal-zero"), strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"),
-                false, 0, 1557432154, 0600, strNew(testUser()), strNew(testGroup()), 0, false, false, NULL),
+                repoFile1, repoFileReferenceFull, compressTypeNone, NULL, compressTypeNone, strNew("normal-zero"),
+                strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"), false, 0, 1557432154, 0600, strNew(testUser()),
+                strNew(testGroup()), 0, false, false, cipherTypeNone, NULL, 1),
             true, "zero-length file");
         TEST_RESULT_UINT(storageInfoNP(storagePg(), strNew("normal-zero")).size, 0, "    check size");
 
@@ -73,16 +78,18 @@ testRun(void)
 
         TEST_ERROR(
             restoreFile(
-                repoFile1, repoFileReferenceFull, true, strNew("normal"), strNew("ffffffffffffffffffffffffffffffffffffffff"),
-                false, 7, 1557432154, 0600, strNew(testUser()), strNew(testGroup()), 0, false, false, strNew("badpass")),
+                repoFile1, repoFileReferenceFull, compressTypeGzip, NULL, compressTypeNone, strNew("normal"),
+                strNew("ffffffffffffffffffffffffffffffffffffffff"), false, 7, 1557432154, 0600, strNew(testUser()),
+                strNew(testGroup()), 0, false, false, cipherTypeAes256Cbc, strNew("badpass"), 1),
             ChecksumError,
             "error restoring 'normal': actual checksum 'd1cd8a7d11daa26814b93eb604e1d49ab4b43770' does not match expected checksum"
                 " 'ffffffffffffffffffffffffffffffffffffffff'");
 
         TEST_RESULT_BOOL(
             restoreFile(
-                repoFile1, repoFileReferenceFull, true, strNew("normal"), strNew("d1cd8a7d11daa26814b93eb604e1d49ab4b43770"),
-                false, 7, 1557432154, 0600, strNew(testUser()), strNew(testGroup()), 0, false, false, strNew("badpass")),
+                repoFile1, repoFileReferenceFull, compressTypeGzip, NULL, compressTypeNone, strNew("normal"),
+                strNew("d1cd8a7d11daa26814b93eb604e1d49ab4b43770"), false, 7, 1557432154, 0600, strNew(testUser()),
+                strNew(testGroup()), 0, false, false, cipherTypeAes256Cbc, strNew("badpass"), 1),
             true, "copy file");
 
         StorageInfo info = storageInfoNP(storagePg(), strNew("normal"));
@@ -95,6 +102,72 @@ testRun(void)
         TEST_RESULT_STR(
             strPtr(strNewBuf(storageGetNP(storageNewReadNP(storagePg(), strNew("normal"))))), "acefile", "    check contents");
 
+        // Copy again with filters in threads
+        size_t oldBufferSize = ioBufferSize();
+        ioBufferSizeSet(4);
+        ioFilterThreadSet(true);
+
+        TEST_RESULT_BOOL(
+            restoreFile(
+                repoFile1, repoFileReferenceFull, compressTypeGzip, NULL, compressTypeNone, strNew("normal"),
+                strNew("d1cd8a7d11daa26814b93eb604e1d49ab4b43770"), false, 7, 1557432154, 0600, strNew(testUser()),
+                strNew(testGroup()), 0, false, false, cipherTypeAes256Cbc, strNew("badpass"), 1),
+            true, "copy file with filters in threads");
+        TEST_RESULT_STR(
+            strPtr(strNewBuf(storageGetNP(storageNewReadNP(storagePg(), strNew("normal"))))), "acefile", "    check contents");
+
+        ioFilterThreadSet(false);
+        ioBufferSizeSet(oldBufferSize);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        // Create an encrypted base and a compressed encrypted page delta.  The base is not compressed so restore must read it with
+        // its own compress type rather than the compress type of the delta.
+        Buffer *base = bufNew(PG_PAGE_SIZE_DEFAULT * 2);
+        memset(bufPtr(base), 'a', PG_PAGE_SIZE_DEFAULT);
+        memset(bufPtr(base) + PG_PAGE_SIZE_DEFAULT, 'b', PG_PAGE_SIZE_DEFAULT);
+        bufUsedSet(base, bufSize(base));
+
+        ceRepoFile = storageNewWriteNP(
+            storageRepoWrite(), strNewFmt(STORAGE_REPO_BACKUP "/%s/pg_data/relation", strPtr(repoFileReferenceFull)));
+        filterGroup = ioWriteFilterGroup(storageWriteIo(ceRepoFile));
+        ioFilterGroupAdd(filterGroup, cipherBlockNew(cipherModeEncrypt, cipherTypeAes256Cbc, BUFSTRDEF("badpass"), NULL));
+
+        storagePutNP(ceRepoFile, base);
+
+        // Page 1 has changed and a partial page has been added
+        Buffer *pageDelta = bufNew(0);
+        bufCat(pageDelta, BUFSTRDEF("\x00\x00\x40\x0A\x60"));
+
+        Buffer *page = bufNew(PG_PAGE_SIZE_DEFAULT);
+        memset(bufPtr(page), 'c', PG_PAGE_SIZE_DEFAULT);
+        bufUsedSet(page, bufSize(page));
+        bufCat(pageDelta, page);
+        bufCat(pageDelta, BUFSTRDEF("dddddddddd"));
+        bufCat(pageDelta, BUFSTRDEF("\x00\x00\x00\x00"));
+
+        ceRepoFile = storageNewWriteNP(storageRepoWrite(), strNew(STORAGE_REPO_BACKUP "/20190509F_20190510I/pg_data/relation.gz"));
+        filterGroup = ioWriteFilterGroup(storageWriteIo(ceRepoFile));
+        ioFilterGroupAdd(filterGroup, gzipCompressNew(3, false));
+        ioFilterGroupAdd(filterGroup, cipherBlockNew(cipherModeEncrypt, cipherTypeAes256Cbc, BUFSTRDEF("badpass"), NULL));
+
+        storagePutNP(ceRepoFile, pageDelta);
+
+        TEST_RESULT_BOOL(
+            restoreFile(
+                strNew("pg_data/relation"), strNew("20190509F_20190510I"), compressTypeGzip, repoFileReferenceFull,
+                compressTypeNone, strNew("relation"), strNew("8b363e98de10786a174031b4a7a38e08d16e631e"), false,
+                PG_PAGE_SIZE_DEFAULT * 2 + 10, 1557432154, 0600, strNew(testUser()), strNew(testGroup()), 0, false, false,
+                cipherTypeAes256Cbc, strNew("badpass"), 1),
+            true, "merge page delta with base");
+
+        Buffer *relation = storageGetNP(storageNewReadNP(storagePg(), strNew("relation")));
+        TEST_RESULT_SIZE(bufUsed(relation), PG_PAGE_SIZE_DEFAULT * 2 + 10, "    check size");
+        TEST_RESULT_BOOL(
+            memcmp(bufPtr(relation), bufPtr(base), PG_PAGE_SIZE_DEFAULT) == 0 &&
+                memcmp(bufPtr(relation) + PG_PAGE_SIZE_DEFAULT, bufPtr(page), PG_PAGE_SIZE_DEFAULT) == 0 &&
+                memcmp(bufPtr(relation) + PG_PAGE_SIZE_DEFAULT * 2, "dddddddddd", 10) == 0,
+            true, "    check contents");
+
         // -------------------------------------------------------------------------------------------------------------------------
         // Create a repo file
         storagePutNP(
@@ -104,27 +177,30 @@ testRun(void)
 
         TEST_RESULT_BOOL(
             restoreFile(
-                repoFile1, repoFileReferenceFull, false, strNew("delta"), strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"),
-                false, 9, 1557432154, 0600, strNew(testUser()), strNew(testGroup()), 0, true, false, NULL),
+                repoFile1, repoFileReferenceFull, compressTypeNone, NULL, compressTypeNone, strNew("delta"),
+                strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"), false, 9, 1557432154, 0600, strNew(testUser()),
+                strNew(testGroup()), 0, true, false, cipherTypeNone, NULL, 1),
             true, "sha1 delta missing");
         TEST_RESULT_STR(
             strPtr(strNewBuf(storageGetNP(storageNewReadNP(storagePg(), strNew("delta"))))), "atestfile", "    check contents");
 
-        size_t oldBufferSize = ioBufferSize();
+        oldBufferSize = ioBufferSize();
         ioBufferSizeSet(4);
 
         TEST_RESULT_BOOL(
             restoreFile(
-                repoFile1, repoFileReferenceFull, false, strNew("delta"), strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"),
-                false, 9, 1557432154, 0600, strNew(testUser()), strNew(testGroup()), 0, true, false, NULL),
+                repoFile1, repoFileReferenceFull, compressTypeNone, NULL, compressTypeNone, strNew("delta"),
+                strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"), false, 9, 1557432154, 0600, strNew(testUser()),
+                strNew(testGroup()), 0, true, false, cipherTypeNone, NULL, 1),
             false, "sha1 delta existing");
 
         ioBufferSizeSet(oldBufferSize);
 
         TEST_RESULT_BOOL(
             restoreFile(
-                repoFile1, repoFileReferenceFull, false, strNew("delta"), strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"),
-                false, 9, 1557432154, 0600, strNew(testUser()), strNew(testGroup()), 1557432155, true, true, NULL),
+                repoFile1, repoFileReferenceFull, compressTypeNone, NULL, compressTypeNone, strNew("delta"),
+                strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"), false, 9, 1557432154, 0600, strNew(testUser()),
+                strNew(testGroup()), 1557432155, true, true, cipherTypeNone, NULL, 1),
             false, "sha1 delta force existing");
 
         // Change the existing file so it no longer matches by size
@@ -132,8 +208,9 @@ testRun(void)
 
         TEST_RESULT_BOOL(
             restoreFile(
-                repoFile1, repoFileReferenceFull, false, strNew("delta"), strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"),
-                false, 9, 1557432154, 0600, strNew(testUser()), strNew(testGroup()), 0, true, false, NULL),
+                repoFile1, repoFileReferenceFull, compressTypeNone, NULL, compressTypeNone, strNew("delta"),
+                strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"), false, 9, 1557432154, 0600, strNew(testUser()),
+                strNew(testGroup()), 0, true, false, cipherTypeNone, NULL, 1),
             true, "sha1 delta existing, size differs");
         TEST_RESULT_STR(
             strPtr(strNewBuf(storageGetNP(storageNewReadNP(storagePg(), strNew("delta"))))), "atestfile", "    check contents");
@@ -142,8 +219,9 @@ testRun(void)
 
         TEST_RESULT_BOOL(
             restoreFile(
-                repoFile1, repoFileReferenceFull, false, strNew("delta"), strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"),
-                false, 9, 1557432154, 0600, strNew(testUser()), strNew(testGroup()), 1557432155, true, true, NULL),
+                repoFile1, repoFileReferenceFull, compressTypeNone, NULL, compressTypeNone, strNew("delta"),
+                strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"), false, 9, 1557432154, 0600, strNew(testUser()),
+                strNew(testGroup()), 1557432155, true, true, cipherTypeNone, NULL, 1),
             true, "delta force existing, size differs");
         TEST_RESULT_STR(
             strPtr(strNewBuf(storageGetNP(storageNewReadNP(storagePg(), strNew("delta"))))), "atestfile", "    check contents");
@@ -153,8 +231,9 @@ testRun(void)
 
         TEST_RESULT_BOOL(
             restoreFile(
-                repoFile1, repoFileReferenceFull, false, strNew("delta"), strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"),
-                false, 9, 1557432154, 0600, strNew(testUser()), strNew(testGroup()), 0, true, false, NULL),
+                repoFile1, repoFileReferenceFull, compressTypeNone, NULL, compressTypeNone, strNew("delta"),
+                strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"), false, 9, 1557432154, 0600, strNew(testUser()),
+                strNew(testGroup()), 0, true, false, cipherTypeNone, NULL, 1),
             true, "sha1 delta existing, content differs");
         TEST_RESULT_STR(
             strPtr(strNewBuf(storageGetNP(storageNewReadNP(storagePg(), strNew("delta"))))), "atestfile", "    check contents");
@@ -163,14 +242,16 @@ testRun(void)
 
         TEST_RESULT_BOOL(
             restoreFile(
-                repoFile1, repoFileReferenceFull, false, strNew("delta"), strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"),
-                false, 9, 1557432154, 0600, strNew(testUser()), strNew(testGroup()), 1557432155, true, true, NULL),
+                repoFile1, repoFileReferenceFull, compressTypeNone, NULL, compressTypeNone, strNew("delta"),
+                strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"), false, 9, 1557432154, 0600, strNew(testUser()),
+                strNew(testGroup()), 1557432155, true, true, cipherTypeNone, NULL, 1),
             true, "delta force existing, timestamp differs");
 
         TEST_RESULT_BOOL(
             restoreFile(
-                repoFile1, repoFileReferenceFull, false, strNew("delta"), strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"),
-                false, 9, 1557432154, 0600, strNew(testUser()), strNew(testGroup()), 1557432153, true, true, NULL),
+                repoFile1, repoFileReferenceFull, compressTypeNone, NULL, compressTypeNone, strNew("delta"),
+                strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"), false, 9, 1557432154, 0600, strNew(testUser()),
+                strNew(testGroup()), 1557432153, true, true, cipherTypeNone, NULL, 1),
             true, "delta force existing, timestamp after copy time");
 
         // Change the existing file to zero-length
@@ -178,8 +259,9 @@ testRun(void)
 
         TEST_RESULT_BOOL(
             restoreFile(
-                repoFile1, repoFileReferenceFull, false, strNew("delta"), strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"),
-                false, 0, 1557432154, 0600, strNew(testUser()), strNew(testGroup()), 0, true, false, NULL),
+                repoFile1, repoFileReferenceFull, compressTypeNone, NULL, compressTypeNone, strNew("delta"),
+                strNew("9bc8ab2dda60ef4beed07d1e19ce0676d5edde67"), false, 0, 1557432154, 0600, strNew(testUser()),
+                strNew(testGroup()), 0, true, false, cipherTypeNone, NULL, 1),
             false, "sha1 delta existing, content differs");
 
         // Check protocol function directly
@@ -199,7 +281,9 @@ testRun(void)
         varLstAdd(paramList, varNewUInt64(1557432200));
         varLstAdd(paramList, varNewBool(false));
         varLstAdd(paramList, varNewStr(repoFileReferenceFull));
-        varLstAdd(paramList, varNewBool(false));
+        varLstAdd(paramList, varNewStrZ("none"));
+        varLstAdd(paramList, NULL);
+        varLstAdd(paramList, varNewStrZ("none"));
 
         TEST_RESULT_BOOL(restoreProtocol(PROTOCOL_COMMAND_RESTORE_FILE_STR, paramList, server), true, "protocol restore file");
         TEST_RESULT_STR(strPtr(strNewBuf(serverWrite)), "{\"out\":true}\n", "    check result");
@@ -230,7 +314,9 @@ testRun(void)
         varLstAdd(paramList, varNewUInt64(1557432200));
         varLstAdd(paramList, varNewBool(true));
         varLstAdd(paramList, NULL);
-        varLstAdd(paramList, varNewBool(false));
+        varLstAdd(paramList, varNewStrZ("none"));
+        varLstAdd(paramList, NULL);
+        varLstAdd(paramList, varNewStrZ("none"));
         varLstAdd(paramList, NULL);
 
         TEST_RESULT_BOOL(restoreProtocol(PROTOCOL_COMMAND_RESTORE_FILE_STR, paramList, server), true, "protocol restore file");
@@ -242,5 +328,129 @@ testRun(void)
         TEST_RESULT_BOOL(restoreProtocol(strNew(BOGUS_STR), paramList, server), false, "invalid function");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("pageDeltaMergeNew()"))
+    {
+        // Generate a page delta with multiple maps and merge it with the base
+        // -------------------------------------------------------------------------------------------------------------------------
+        Buffer *relation = bufNew(PG_PAGE_SIZE_DEFAULT * (PAGE_DELTA_MAP_PAGE_MAX + 2) + 100);
+        memset(bufPtr(relation), 0, bufSize(relation));
+        bufUsedSet(relation, bufSize(relation));
+
+        Buffer *base = bufNew(PG_PAGE_SIZE_DEFAULT * (PAGE_DELTA_MAP_PAGE_MAX + 1));
+        memset(bufPtr(base), 0, bufSize(base));
+        bufUsedSet(base, bufSize(base));
+
+        // Every page has a unique byte after the header.  Pages that have changed have a high lsn and different data in the base.
+        for (unsigned int pageIdx = 0; pageIdx < PAGE_DELTA_MAP_PAGE_MAX + 2; pageIdx++)
+        {
+            unsigned char *page = bufPtr(relation) + PG_PAGE_SIZE_DEFAULT * pageIdx;
+
+            page[14] = 0x01;                                        // pd_upper is not zero so the page is not new
+            page[100] = (unsigned char)pageIdx;
+
+            if (pageIdx % 3 == 0)
+                page[5] = 0x01;                                     // lsn is at the limit
+
+            if (pageIdx < PAGE_DELTA_MAP_PAGE_MAX + 1)
+            {
+                memcpy(bufPtr(base) + PG_PAGE_SIZE_DEFAULT * pageIdx, page, PG_PAGE_SIZE_DEFAULT);
+
+                if (pageIdx % 3 == 0)
+                    bufPtr(base)[PG_PAGE_SIZE_DEFAULT * pageIdx + 100] = 0xFF;
+            }
+        }
+
+        Buffer *pageDelta = bufNew(0);
+        IoWrite *write = ioBufferWriteNew(pageDelta);
+        ioFilterGroupAdd(ioWriteFilterGroup(write), pageDeltaNew(PG_PAGE_SIZE_DEFAULT, 0x100, bufUsed(base)));
+        ioWriteOpen(write);
+        ioWrite(write, relation);
+        ioWriteClose(write);
+
+        // Merge with small buffers so map headers and pages are split across inputs
+        ioBufferSizeSet(777);
+
+        IoRead *baseRead = ioBufferReadNew(base);
+        ioReadOpen(baseRead);
+
+        Buffer *merge = bufNew(0);
+        write = ioBufferWriteNew(merge);
+        ioFilterGroupAdd(ioWriteFilterGroup(write), pageDeltaMergeNew(baseRead, PG_PAGE_SIZE_DEFAULT));
+        ioWriteOpen(write);
+
+        for (size_t deltaOffset = 0; deltaOffset < bufUsed(pageDelta); deltaOffset += 3)
+        {
+            size_t deltaSize = bufUsed(pageDelta) - deltaOffset < 3 ? bufUsed(pageDelta) - deltaOffset : 3;
+            ioWrite(write, BUF(bufPtr(pageDelta) + deltaOffset, deltaSize));
+        }
+
+        ioWriteClose(write);
+        ioBufferSizeSet(8192);
+
+        TEST_RESULT_SIZE(bufUsed(merge), bufUsed(relation), "check size");
+        TEST_RESULT_BOOL(bufEq(merge, relation), true, "check contents");
+
+        // Page that is not stored is missing from the base
+        // -------------------------------------------------------------------------------------------------------------------------
+        baseRead = ioBufferReadNew(BUFSTRDEF(""));
+        ioReadOpen(baseRead);
+
+        write = ioBufferWriteNew(bufNew(0));
+        ioFilterGroupAdd(ioWriteFilterGroup(write), pageDeltaMergeNew(baseRead, PG_PAGE_SIZE_DEFAULT));
+        ioWriteOpen(write);
+
+        TEST_ERROR(
+            ioWrite(write, BUFSTRDEF("\x00\x00\x00\x0A\x00")), FormatError,
+            "page 0 is not stored in page delta and is missing from base");
+
+        // Delta ends before a stored page
+        // -------------------------------------------------------------------------------------------------------------------------
+        baseRead = ioBufferReadNew(BUFSTRDEF(""));
+        ioReadOpen(baseRead);
+
+        write = ioBufferWriteNew(bufNew(0));
+        ioFilterGroupAdd(ioWriteFilterGroup(write), pageDeltaMergeNew(baseRead, PG_PAGE_SIZE_DEFAULT));
+        ioWriteOpen(write);
+        ioWrite(write, BUFSTRDEF("\x00\x00\x00\x0A\x80" "abc"));
+
+        TEST_ERROR(ioWriteClose(write), FormatError, "unexpected end of page delta");
+
+        // Delta ends before the end marker
+        // -------------------------------------------------------------------------------------------------------------------------
+        baseRead = ioBufferReadNew(BUFSTRDEF(""));
+        ioReadOpen(baseRead);
+
+        write = ioBufferWriteNew(bufNew(0));
+        ioFilterGroupAdd(ioWriteFilterGroup(write), pageDeltaMergeNew(baseRead, PG_PAGE_SIZE_DEFAULT));
+        ioWriteOpen(write);
+        ioWrite(write, BUFSTRDEF("\x00\x00\x00\x03\x80" "abc\x00\x00"));
+
+        TEST_ERROR(ioWriteClose(write), FormatError, "unexpected end of page delta");
+
+        // Data after the end marker
+        // -------------------------------------------------------------------------------------------------------------------------
+        baseRead = ioBufferReadNew(BUFSTRDEF(""));
+        ioReadOpen(baseRead);
+
+        write = ioBufferWriteNew(bufNew(0));
+        ioFilterGroupAdd(ioWriteFilterGroup(write), pageDeltaMergeNew(baseRead, PG_PAGE_SIZE_DEFAULT));
+        ioWriteOpen(write);
+
+        TEST_ERROR(ioWrite(write, BUFSTRDEF("\x00\x00\x00\x00" "X")), FormatError, "unexpected data after end of page delta");
+
+        // Map covers too many pages
+        // -------------------------------------------------------------------------------------------------------------------------
+        baseRead = ioBufferReadNew(BUFSTRDEF(""));
+        ioReadOpen(baseRead);
+
+        write = ioBufferWriteNew(bufNew(0));
+        ioFilterGroupAdd(ioWriteFilterGroup(write), pageDeltaMergeNew(baseRead, PG_PAGE_SIZE_DEFAULT));
+        ioWriteOpen(write);
+
+        TEST_ERROR(
+            ioWrite(write, BUFSTRDEF("\x00\x10\x00\x01")), FormatError, "page delta map at page 0 covers more than 128 pages");
+    }
+
     FUNCTION_HARNESS_RESULT_VOID();
 }
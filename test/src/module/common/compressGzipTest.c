@@ -35,7 +35,11 @@ testCompress(IoFilter *compress, Buffer *decompressed, size_t inputSize, size_t
     }
 
     ioWriteClose(write);
-    memContextFree(((GzipCompress *)ioFilterDriver(compress))->memContext);
+
+    if (strEq(ioFilterType(compress), GZIP_COMPRESS_PARALLEL_FILTER_TYPE_STR))
+        memContextFree(((GzipCompressParallel *)ioFilterDriver(compress))->memContext);
+    else
+        memContextFree(((GzipCompress *)ioFilterDriver(compress))->memContext);
 
     return compressed;
 }
@@ -161,7 +165,78 @@ testRun(void)
     }
 
     // *****************************************************************************************************************************
-    if (testBegin("gzipDecompressToLog() and gzipCompressToLog()"))
+    if (testBegin("GzipCompressParallel"))
+    {
+        // Generate data that spans several blocks and is compressible but not trivially so
+        Buffer *decompressed = bufNew(GZIP_COMPRESS_PARALLEL_BLOCK_SIZE * 5 + 777);
+
+        for (size_t byteIdx = 0; byteIdx < bufSize(decompressed); byteIdx++)
+        {
+            bufPtr(decompressed)[byteIdx] = (unsigned char)(
+                (byteIdx * 7 + byteIdx / 1000) % 61 + (byteIdx % 13 == 0 ? byteIdx / 97 : 0));
+        }
+
+        bufUsedSet(decompressed, bufSize(decompressed));
+
+        VariantList *compressParamList = varLstNew();
+        varLstAdd(compressParamList, varNewInt(6));
+        varLstAdd(compressParamList, varNewUInt(4));
+
+        Buffer *compressed = NULL;
+
+        TEST_ASSIGN(
+            compressed, testCompress(gzipCompressParallelNewVar(compressParamList), decompressed, 65536, 65536),
+            "compress in threads");
+        TEST_RESULT_BOOL(bufUsed(compressed) < bufUsed(decompressed) / 4, true, "    data is compressed");
+        TEST_RESULT_BOOL(
+            bufEq(decompressed, testDecompress(gzipDecompressNew(false), compressed, 65536, 65536)), true,
+            "    decompress with gzip");
+
+        TEST_RESULT_BOOL(
+            bufEq(compressed, testCompress(gzipCompressParallelNew(6, 1), decompressed, 65536, 65536)), true,
+            "compress with one thread matches");
+        TEST_RESULT_BOOL(
+            bufEq(compressed, testCompress(gzipCompressParallelNew(6, 3), decompressed, 100000, 7)), true,
+            "compress large in/small out buffer matches");
+        TEST_RESULT_BOOL(
+            bufEq(compressed, testCompress(gzipCompressParallelNew(6, 2), decompressed, 1000, 300000)), true,
+            "compress small in/large out buffer matches");
+
+        // Check the header flags for the fastest and best levels
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_ASSIGN(compressed, testCompress(gzipCompressParallelNew(1, 2), decompressed, 65536, 65536), "compress level 1");
+        TEST_RESULT_UINT(bufPtr(compressed)[8], 4, "    fastest flag");
+        TEST_RESULT_BOOL(
+            bufEq(decompressed, testDecompress(gzipDecompressNew(false), compressed, 65536, 65536)), true, "    decompress");
+
+        TEST_ASSIGN(compressed, testCompress(gzipCompressParallelNew(9, 2), decompressed, 65536, 65536), "compress level 9");
+        TEST_RESULT_UINT(bufPtr(compressed)[8], 2, "    best flag");
+        TEST_RESULT_BOOL(
+            bufEq(decompressed, testDecompress(gzipDecompressNew(false), compressed, 65536, 65536)), true, "    decompress");
+
+        // Compress data that exactly fills a block and empty data
+        // -------------------------------------------------------------------------------------------------------------------------
+        decompressed = bufNewC(bufPtr(decompressed), GZIP_COMPRESS_PARALLEL_BLOCK_SIZE);
+
+        TEST_ASSIGN(compressed, testCompress(gzipCompressParallelNew(6, 2), decompressed, 65536, 65536), "compress one block");
+        TEST_RESULT_BOOL(
+            bufEq(decompressed, testDecompress(gzipDecompressNew(false), compressed, 65536, 65536)), true, "    decompress");
+
+        decompressed = bufNew(0);
+
+        TEST_ASSIGN(compressed, testCompress(gzipCompressParallelNew(6, 2), decompressed, 1024, 1024), "compress empty");
+        TEST_RESULT_BOOL(
+            bufEq(decompressed, testDecompress(gzipDecompressNew(false), compressed, 1024, 1024)), true, "    decompress");
+
+        // Free a filter with threads that were never started
+        // -------------------------------------------------------------------------------------------------------------------------
+        IoFilter *compress = gzipCompressParallelNew(6, 2);
+        TEST_RESULT_VOID(
+            memContextFree(((GzipCompressParallel *)ioFilterDriver(compress))->memContext), "free filter without threads");
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("gzipDecompressToLog(), gzipCompressToLog(), and gzipCompressParallelToLog()"))
     {
         GzipDecompress *decompress = (GzipDecompress *)ioFilterDriver(gzipDecompressNew(false));
 
@@ -170,6 +245,14 @@ testRun(void)
         decompress->inputSame = true;
         decompress->done = true;
         TEST_RESULT_STR(strPtr(gzipDecompressToLog(decompress)), "{inputSame: true, done: true, availIn: 0}", "format object");
+
+        GzipCompressParallel *compressParallel = (GzipCompressParallel *)ioFilterDriver(gzipCompressParallelNew(6, 1));
+        compressParallel->jobPut = 3;
+        compressParallel->jobOutput = 2;
+
+        TEST_RESULT_STR(
+            strPtr(gzipCompressParallelToLog(compressParallel)),
+            "{inputSame: false, done: false, flushing: false, jobPut: 3, jobOutput: 2}", "format object");
     }
 
     FUNCTION_HARNESS_RESULT_VOID();
@@ -0,0 +1,324 @@
+/***********************************************************************************************************************************
+Test Compression Helper and Optional Compression Types
+***********************************************************************************************************************************/
+#include "common/io/filter/group.h"
+#include "common/io/bufferRead.h"
+#include "common/io/bufferWrite.h"
+#include "common/io/io.h"
+#include "common/regExp.h"
+
+/***********************************************************************************************************************************
+Free the filter driver so the free resource callback is run
+***********************************************************************************************************************************/
+static void
+testFilterFree(IoFilter *filter)
+{
+    const String *type = ioFilterType(filter);
+
+    if (strEq(type, LZ4_COMPRESS_FILTER_TYPE_STR))
+        memContextFree(((Lz4Compress *)ioFilterDriver(filter))->memContext);
+    else if (strEq(type, LZ4_DECOMPRESS_FILTER_TYPE_STR))
+        memContextFree(((Lz4Decompress *)ioFilterDriver(filter))->memContext);
+    else if (strEq(type, ZST_COMPRESS_FILTER_TYPE_STR))
+        memContextFree(((ZstCompress *)ioFilterDriver(filter))->memContext);
+    else if (strEq(type, ZST_DECOMPRESS_FILTER_TYPE_STR))
+        memContextFree(((ZstDecompress *)ioFilterDriver(filter))->memContext);
+}
+
+/***********************************************************************************************************************************
+Compress data
+***********************************************************************************************************************************/
+static Buffer *
+testCompress(IoFilter *compress, Buffer *decompressed, size_t inputSize, size_t outputSize)
+{
+    Buffer *compressed = bufNew(1024 * 1024);
+    size_t inputTotal = 0;
+    ioBufferSizeSet(outputSize);
+
+    IoWrite *write = ioBufferWriteNew(compressed);
+    ioFilterGroupAdd(ioWriteFilterGroup(write), compress);
+    ioWriteOpen(write);
+
+    // Compress input data
+    while (inputTotal < bufSize(decompressed))
+    {
+        // Generate the input buffer based on input size.  This breaks the data up into chunks as it would be in a real scenario.
+        Buffer *input = bufNewC(
+            bufPtr(decompressed) + inputTotal,
+            inputSize > bufSize(decompressed) - inputTotal ? bufSize(decompressed) - inputTotal : inputSize);
+
+        ioWrite(write, input);
+
+        inputTotal += bufUsed(input);
+        bufFree(input);
+    }
+
+    ioWriteClose(write);
+    testFilterFree(compress);
+
+    return compressed;
+}
+
+/***********************************************************************************************************************************
+Decompress data
+***********************************************************************************************************************************/
+static Buffer *
+testDecompress(IoFilter *decompress, Buffer *compressed, size_t inputSize, size_t outputSize)
+{
+    Buffer *decompressed = bufNew(1024 * 1024);
+    Buffer *output = bufNew(outputSize);
+    ioBufferSizeSet(inputSize);
+
+    IoRead *read = ioBufferReadNew(compressed);
+    ioFilterGroupAdd(ioReadFilterGroup(read), decompress);
+    ioReadOpen(read);
+
+    while (!ioReadEof(read))
+    {
+        ioRead(read, output);
+        bufCat(decompressed, output);
+        bufUsedZero(output);
+    }
+
+    ioReadClose(read);
+    bufFree(output);
+    testFilterFree(decompress);
+
+    return decompressed;
+}
+
+/***********************************************************************************************************************************
+Run the standard compress/decompress tests for a compression type
+***********************************************************************************************************************************/
+static void
+testSuite(CompressType type, int level)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(ENUM, type);
+        FUNCTION_HARNESS_PARAM(INT, level);
+    FUNCTION_HARNESS_END();
+
+    const char *simpleData = "A simple string";
+    Buffer *compressed = NULL;
+    Buffer *decompressed = bufNewC(simpleData, strlen(simpleData));
+
+    TEST_ASSIGN(
+        compressed, testCompress(compressFilter(type, level, 1), decompressed, 1024, 1024),
+        "simple data - compress large in/large out buffer");
+
+    TEST_RESULT_BOOL(
+        bufEq(compressed, testCompress(compressFilter(type, level, 1), decompressed, 1024, 1)), true,
+        "simple data - compress large in/small out buffer");
+
+    TEST_RESULT_BOOL(
+        bufEq(compressed, testCompress(compressFilter(type, level, 1), decompressed, 1, 1024)), true,
+        "simple data - compress small in/large out buffer");
+
+    TEST_RESULT_BOOL(
+        bufEq(compressed, testCompress(compressFilter(type, level, 1), decompressed, 1, 1)), true,
+        "simple data - compress small in/small out buffer");
+
+    TEST_RESULT_BOOL(
+        bufEq(decompressed, testDecompress(decompressFilter(type), compressed, 1024, 1024)), true,
+        "simple data - decompress large in/large out buffer");
+
+    TEST_RESULT_BOOL(
+        bufEq(decompressed, testDecompress(decompressFilter(type), compressed, 1024, 1)), true,
+        "simple data - decompress large in/small out buffer");
+
+    TEST_RESULT_BOOL(
+        bufEq(decompressed, testDecompress(decompressFilter(type), compressed, 1, 1024)), true,
+        "simple data - decompress small in/large out buffer");
+
+    TEST_RESULT_BOOL(
+        bufEq(decompressed, testDecompress(decompressFilter(type), compressed, 1, 1)), true,
+        "simple data - decompress small in/small out buffer");
+
+    // Compressed data is truncated
+    // -----------------------------------------------------------------------------------------------------------------------------
+    bufUsedSet(compressed, bufUsed(compressed) - 1);
+
+    TEST_ERROR(
+        testDecompress(decompressFilter(type), compressed, 1024, 1024), FormatError, "unexpected eof in compressed data");
+
+    // Compress a large zero input buffer into small output buffer
+    // -----------------------------------------------------------------------------------------------------------------------------
+    decompressed = bufNew(1024 * 1024 - 1);
+    memset(bufPtr(decompressed), 0, bufSize(decompressed));
+    bufUsedSet(decompressed, bufSize(decompressed));
+
+    TEST_ASSIGN(
+        compressed, testCompress(compressFilter(type, level, 1), decompressed, bufSize(decompressed), 1024),
+        "zero data - compress large in/small out buffer");
+
+    TEST_RESULT_BOOL(
+        bufEq(decompressed, testDecompress(decompressFilter(type), compressed, bufSize(compressed), 1024 * 256)), true,
+        "zero data - decompress large in/small out buffer");
+
+    FUNCTION_HARNESS_RESULT_VOID();
+}
+
+/***********************************************************************************************************************************
+Test Run
+***********************************************************************************************************************************/
+void
+testRun(void)
+{
+    FUNCTION_HARNESS_VOID();
+
+    // *****************************************************************************************************************************
+    if (testBegin("compressType*(), compressExt*(), compressLevel*()"))
+    {
+        TEST_RESULT_UINT(compressType(STRDEF("none")), compressTypeNone, "none type");
+        TEST_RESULT_UINT(compressType(STRDEF("gz")), compressTypeGzip, "gz type");
+        TEST_RESULT_UINT(compressType(STRDEF("lz4")), compressTypeLz4, "lz4 type");
+        TEST_RESULT_UINT(compressType(STRDEF("zst")), compressTypeZst, "zst type");
+        TEST_ERROR(compressType(STRDEF("bogus")), AssertError, "invalid compression type 'bogus'");
+
+        TEST_RESULT_STR(strPtr(compressTypeName(compressTypeNone)), "none", "none name");
+        TEST_RESULT_STR(strPtr(compressTypeName(compressTypeZst)), "zst", "zst name");
+
+        TEST_RESULT_VOID(compressTypePresent(compressTypeNone), "none is always present");
+        TEST_RESULT_VOID(compressTypePresent(compressTypeGzip), "gz is always present");
+
+        TEST_RESULT_UINT(compressTypeFromName(STRDEF("file")), compressTypeNone, "no extension");
+        TEST_RESULT_UINT(compressTypeFromName(STRDEF("file.gz")), compressTypeGzip, "gz extension");
+        TEST_RESULT_UINT(compressTypeFromName(STRDEF("file.lz4")), compressTypeLz4, "lz4 extension");
+        TEST_RESULT_UINT(compressTypeFromName(STRDEF("file.zst")), compressTypeZst, "zst extension");
+        TEST_RESULT_UINT(compressTypeFromName(STRDEF("filezst")), compressTypeNone, "extension without period");
+
+        TEST_RESULT_STR(strPtr(compressExtStr(compressTypeNone)), "", "none ext");
+        TEST_RESULT_STR(strPtr(compressExtStr(compressTypeLz4)), ".lz4", "lz4 ext");
+
+        String *file = strNew("file");
+        TEST_RESULT_VOID(compressExtCat(file, compressTypeNone), "cat none ext");
+        TEST_RESULT_STR(strPtr(file), "file", "    check file");
+        TEST_RESULT_VOID(compressExtCat(file, compressTypeGzip), "cat gz ext");
+        TEST_RESULT_STR(strPtr(file), "file.gz", "    check file");
+
+        TEST_RESULT_STR(strPtr(compressExtStrip(file, compressTypeGzip)), "file", "strip gz ext");
+        TEST_ERROR(compressExtStrip(file, compressTypeZst), FormatError, "'file.gz' must have '.zst' extension");
+
+        TEST_RESULT_INT(compressLevelMin(compressTypeGzip), 0, "gz min level");
+        TEST_RESULT_INT(compressLevelMax(compressTypeGzip), 9, "gz max level");
+        TEST_RESULT_INT(compressLevelMin(compressTypeZst), -5, "zst min level");
+        TEST_RESULT_INT(compressLevelMax(compressTypeZst), 22, "zst max level");
+        TEST_RESULT_INT(compressLevelDefault(compressTypeGzip), 6, "gz default level");
+        TEST_RESULT_INT(compressLevelDefault(compressTypeLz4), 1, "lz4 default level");
+        TEST_RESULT_INT(compressLevelDefault(compressTypeZst), 3, "zst default level");
+
+        // Check that the extension regular expression matches all types
+        // -------------------------------------------------------------------------------------------------------------------------
+        RegExp *regExp = regExpNew(STRDEF("^file" COMPRESS_EXT_REGEXP "$"));
+
+        TEST_RESULT_BOOL(regExpMatch(regExp, STRDEF("file")), true, "regexp matches no extension");
+        TEST_RESULT_BOOL(regExpMatch(regExp, STRDEF("file.gz")), true, "regexp matches gz");
+        TEST_RESULT_BOOL(regExpMatch(regExp, STRDEF("file.lz4")), true, "regexp matches lz4");
+        TEST_RESULT_BOOL(regExpMatch(regExp, STRDEF("file.zst")), true, "regexp matches zst");
+        TEST_RESULT_BOOL(regExpMatch(regExp, STRDEF("file.bz2")), false, "regexp does not match bz2");
+
+        // Filters
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_ERROR(
+            compressFilter(compressTypeGzip, 10, 1), OptionInvalidValueError,
+            "compress level 10 is not valid for gz compression (valid levels are 0-9)");
+        TEST_ERROR(
+            compressFilter(compressTypeLz4, -6, 1), OptionInvalidValueError,
+            "compress level -6 is not valid for lz4 compression (valid levels are -5-12)");
+
+        TEST_RESULT_STR(
+            strPtr(ioFilterType(compressFilter(compressTypeGzip, 6, 1))), "gzipCompress", "gz compress filter");
+        TEST_RESULT_STR(
+            strPtr(ioFilterType(compressFilter(compressTypeGzip, 6, 2))), "gzipCompressParallel", "gz compress filter in threads");
+        TEST_RESULT_STR(strPtr(ioFilterType(decompressFilter(compressTypeGzip))), "gzipDecompress", "gz decompress filter");
+        TEST_RESULT_STR(
+            strPtr(ioFilterType(compressFilter(compressTypeLz4, 1, 4))), "lz4Compress", "lz4 compress filter ignores threads");
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("Lz4Compress and Lz4Decompress"))
+    {
+        TEST_RESULT_UINT(lz4Error(0), 0, "no error");
+        TEST_ERROR(lz4Error((size_t)-1), FormatError, "lz4 error: ERROR_GENERIC");
+
+        testSuite(compressTypeLz4, 1);
+
+        // Check NewVar constructors
+        // -------------------------------------------------------------------------------------------------------------------------
+        const char *simpleData = "A simple string";
+        Buffer *decompressed = bufNewC(simpleData, strlen(simpleData));
+
+        VariantList *compressParamList = varLstNew();
+        varLstAdd(compressParamList, varNewInt(-5));
+
+        Buffer *compressed = NULL;
+
+        TEST_ASSIGN(compressed, testCompress(lz4CompressNewVar(compressParamList), decompressed, 1024, 1024), "compress var");
+        TEST_RESULT_BOOL(
+            bufEq(decompressed, testDecompress(lz4DecompressNewVar(NULL), compressed, 1024, 1024)), true, "decompress var");
+
+        // Corrupt data
+        // -------------------------------------------------------------------------------------------------------------------------
+        bufPtr(compressed)[bufUsed(compressed) - 1] ^= 0xFF;
+
+        TEST_ERROR(
+            testDecompress(lz4DecompressNew(), compressed, 1024, 1024), FormatError, "lz4 error: ERROR_contentChecksum_invalid");
+
+        // Check log
+        // -------------------------------------------------------------------------------------------------------------------------
+        IoFilter *compress = lz4CompressNew(1);
+
+        TEST_RESULT_STR(
+            strPtr(lz4CompressToLog(ioFilterDriver(compress))), "{inputSame: false, done: false, flushing: false, buffered: 0}",
+            "compress log");
+        TEST_RESULT_STR(
+            strPtr(lz4DecompressToLog(ioFilterDriver(lz4DecompressNew()))), "{inputSame: false, done: false}", "decompress log");
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("ZstCompress and ZstDecompress"))
+    {
+        TEST_RESULT_UINT(zstError(0), 0, "no error");
+        TEST_ERROR(zstError((size_t)-1), FormatError, "zst error: Error (generic)");
+
+        testSuite(compressTypeZst, 3);
+
+        // Compress in threads
+        // -------------------------------------------------------------------------------------------------------------------------
+        Buffer *decompressed = bufNew(1024 * 1024 - 1);
+
+        for (size_t byteIdx = 0; byteIdx < bufSize(decompressed); byteIdx++)
+            bufPtr(decompressed)[byteIdx] = (unsigned char)((byteIdx * 7 + byteIdx / 1000) % 61);
+
+        bufUsedSet(decompressed, bufSize(decompressed));
+
+        VariantList *compressParamList = varLstNew();
+        varLstAdd(compressParamList, varNewInt(-5));
+        varLstAdd(compressParamList, varNewUInt(2));
+
+        Buffer *compressed = NULL;
+
+        TEST_ASSIGN(
+            compressed, testCompress(zstCompressNewVar(compressParamList), decompressed, 65536, 65536), "compress in threads");
+        TEST_RESULT_BOOL(
+            bufEq(decompressed, testDecompress(zstDecompressNewVar(NULL), compressed, 65536, 65536)), true, "decompress var");
+
+        // Corrupt data
+        // -------------------------------------------------------------------------------------------------------------------------
+        bufPtr(compressed)[bufUsed(compressed) - 1] ^= 0xFF;
+
+        TEST_ERROR(
+            testDecompress(zstDecompressNew(), compressed, 65536, 65536), FormatError,
+            "zst error: Restored data doesn't match checksum");
+
+        // Check log
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_STR(
+            strPtr(zstCompressToLog(ioFilterDriver(zstCompressNew(1, 1)))), "{inputSame: false, done: false, flushing: false}",
+            "compress log");
+        TEST_RESULT_STR(
+            strPtr(zstDecompressToLog(ioFilterDriver(zstDecompressNew()))), "{inputSame: false, done: false}", "decompress log");
+    }
+
+    FUNCTION_HARNESS_RESULT_VOID();
+}
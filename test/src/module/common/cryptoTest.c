@@ -1,7 +1,10 @@
 /***********************************************************************************************************************************
 Test Block Cipher
 ***********************************************************************************************************************************/
+#include "common/io/bufferRead.h"
+#include "common/io/bufferWrite.h"
 #include "common/io/filter/filter.intern.h"
+#include "common/io/filter/group.h"
 #include "common/io/io.h"
 #include "common/type/json.h"
 
@@ -13,6 +16,36 @@ Data for testing
 #define TEST_PLAINTEXT                                              "plaintext"
 #define TEST_BUFFER_SIZE                                            256
 
+/***********************************************************************************************************************************
+Encrypt/decrypt data with a filter using the specified input and output sizes
+***********************************************************************************************************************************/
+static Buffer *
+testCipher(IoFilter *filter, const Buffer *input, size_t inputSize, size_t outputSize)
+{
+    Buffer *result = bufNew(0);
+    Buffer *output = bufNew(outputSize);
+    ioBufferSizeSet(inputSize);
+
+    IoRead *read = ioBufferReadNew(input);
+    ioFilterGroupAdd(ioReadFilterGroup(read), filter);
+    ioReadOpen(read);
+
+    while (!ioReadEof(read))
+    {
+        ioRead(read, output);
+        bufCat(result, output);
+        bufUsedZero(output);
+    }
+
+    ioReadClose(read);
+    bufFree(output);
+
+    // Free the filter so threads are stopped
+    ioFilterFree(filter);
+
+    return result;
+}
+
 /***********************************************************************************************************************************
 Test Run
 ***********************************************************************************************************************************/
@@ -49,10 +82,12 @@ testRun(void)
         TEST_ERROR(cipherType(strNew(BOGUS_STR)), AssertError, "invalid cipher name 'BOGUS'");
         TEST_RESULT_UINT(cipherType(strNew("none")), cipherTypeNone, "none type");
         TEST_RESULT_UINT(cipherType(strNew("aes-256-cbc")), cipherTypeAes256Cbc, "aes-256-cbc type");
+        TEST_RESULT_UINT(cipherType(strNew("aes-256-gcm")), cipherTypeAes256Gcm, "aes-256-gcm type");
 
-        TEST_ERROR(cipherTypeName((CipherType)2), AssertError, "invalid cipher type 2");
+        TEST_ERROR(cipherTypeName((CipherType)3), AssertError, "invalid cipher type 3");
         TEST_RESULT_STR(strPtr(cipherTypeName(cipherTypeNone)), "none", "none name");
         TEST_RESULT_STR(strPtr(cipherTypeName(cipherTypeAes256Cbc)), "aes-256-cbc", "aes-256-cbc name");
+        TEST_RESULT_STR(strPtr(cipherTypeName(cipherTypeAes256Gcm)), "aes-256-gcm", "aes-256-gcm name");
 
         // Test if the buffer was overrun
         // -------------------------------------------------------------------------------------------------------------------------
@@ -287,6 +322,250 @@ testRun(void)
         ioFilterFree(blockDecryptFilter);
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("CipherChunk"))
+    {
+        // Plaintext that is several chunks and does not end on a chunk boundary
+        Buffer *plainText = bufNew(CIPHER_CHUNK_SIZE_DEFAULT * 3 + 1000);
+
+        for (size_t plainIdx = 0; plainIdx < bufSize(plainText); plainIdx++)
+            bufPtr(plainText)[plainIdx] = (unsigned char)(plainIdx % 241);
+
+        bufUsedSet(plainText, bufSize(plainText));
+
+        // Encrypt/decrypt with one thread
+        // -------------------------------------------------------------------------------------------------------------------------
+        Buffer *encrypt = NULL;
+        IoFilter *filter = NULL;
+
+        TEST_ASSIGN(filter, cipherChunkNew(cipherModeEncrypt, testPass, 1), "new encrypt filter");
+        TEST_ASSIGN(filter, cipherChunkNewVar(ioFilterParamList(filter)), "new encrypt filter from params");
+        TEST_ASSIGN(encrypt, testCipher(filter, plainText, 65536, 65536), "encrypt");
+        TEST_RESULT_UINT(
+            bufUsed(encrypt), CIPHER_CHUNK_HEADER_SIZE + bufUsed(plainText) + CIPHER_CHUNK_TAG_SIZE * 4, "check encrypt size");
+        TEST_RESULT_BOOL(
+            memcmp(bufPtr(encrypt), "PGBRCHK1", 8) == 0 && bufPtr(encrypt)[CIPHER_CHUNK_HEADER_SIZE - 3] == 1, true,
+            "check header");
+
+        TEST_RESULT_BOOL(
+            bufEq(testCipher(cipherChunkNew(cipherModeDecrypt, testPass, 1), encrypt, 65536, 65536), plainText), true,
+            "decrypt large in/large out buffer");
+        TEST_RESULT_BOOL(
+            bufEq(testCipher(cipherChunkNew(cipherModeDecrypt, testPass, 1), encrypt, 7, 65536), plainText), true,
+            "decrypt small in/large out buffer");
+        TEST_RESULT_BOOL(
+            bufEq(testCipher(cipherChunkNew(cipherModeDecrypt, testPass, 1), encrypt, 65536, 7), plainText), true,
+            "decrypt large in/small out buffer");
+
+        // Encrypt/decrypt with threads
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_ASSIGN(encrypt, testCipher(cipherChunkNew(cipherModeEncrypt, testPass, 3), plainText, 1000, 3), "encrypt in threads");
+        TEST_RESULT_UINT(
+            bufUsed(encrypt), CIPHER_CHUNK_HEADER_SIZE + bufUsed(plainText) + CIPHER_CHUNK_TAG_SIZE * 4, "check encrypt size");
+
+        TEST_RESULT_BOOL(
+            bufEq(testCipher(cipherChunkNew(cipherModeDecrypt, testPass, 1), encrypt, 65536, 65536), plainText), true,
+            "decrypt with one thread");
+        TEST_RESULT_BOOL(
+            bufEq(testCipher(cipherChunkNew(cipherModeDecrypt, testPass, 4), encrypt, 13, 65536), plainText), true,
+            "decrypt in threads small in/large out buffer");
+        TEST_RESULT_BOOL(
+            bufEq(testCipher(cipherChunkNew(cipherModeDecrypt, testPass, 4), encrypt, 65536, 13), plainText), true,
+            "decrypt in threads large in/small out buffer");
+
+        // Plaintext that ends on a chunk boundary
+        // -------------------------------------------------------------------------------------------------------------------------
+        Buffer *plainChunk = bufNewC(bufPtr(plainText), CIPHER_CHUNK_SIZE_DEFAULT);
+
+        TEST_ASSIGN(encrypt, testCipher(cipherChunkNew(cipherModeEncrypt, testPass, 2), plainChunk, 65536, 65536), "encrypt");
+        TEST_RESULT_UINT(
+            bufUsed(encrypt), CIPHER_CHUNK_HEADER_SIZE + CIPHER_CHUNK_SIZE_DEFAULT + CIPHER_CHUNK_TAG_SIZE, "check encrypt size");
+        TEST_RESULT_BOOL(
+            bufEq(testCipher(cipherChunkNew(cipherModeDecrypt, testPass, 2), encrypt, 65536, 65536), plainChunk), true,
+            "decrypt");
+
+        // Empty plaintext
+        // -------------------------------------------------------------------------------------------------------------------------
+        Buffer *encryptEmpty = NULL;
+
+        TEST_ASSIGN(
+            encryptEmpty, testCipher(cipherChunkNew(cipherModeEncrypt, testPass, 1), bufNew(0), 1024, 1024), "encrypt empty");
+        TEST_RESULT_UINT(bufUsed(encryptEmpty), CIPHER_CHUNK_HEADER_SIZE + CIPHER_CHUNK_TAG_SIZE, "check encrypt size");
+        TEST_RESULT_UINT(
+            bufUsed(testCipher(cipherChunkNew(cipherModeDecrypt, testPass, 1), encryptEmpty, 1024, 1024)), 0, "decrypt empty");
+
+        // Errors
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_ERROR(
+            testCipher(cipherChunkNew(cipherModeDecrypt, testPass, 1), bufNew(0), 1024, 1024), CryptoError,
+            "cipher header missing");
+        TEST_ERROR(
+            testCipher(cipherChunkNew(cipherModeDecrypt, testPass, 1), BUFSTRDEF("PGBRCHK1"), 1024, 1024), CryptoError,
+            "cipher header missing");
+        TEST_ERROR(
+            testCipher(cipherChunkNew(cipherModeDecrypt, testPass, 1), BUFSTRDEF("1234567890123456789012345678"), 1024, 1024),
+            CryptoError, "cipher header invalid");
+
+        Buffer *header = bufNewC(bufPtr(encrypt), CIPHER_CHUNK_HEADER_SIZE);
+        bufPtr(header)[CIPHER_CHUNK_HEADER_SIZE - 4] = 0x01;
+        TEST_ERROR(cipherChunkSize(header), CryptoError, "cipher header invalid");
+
+        bufPtr(header)[CIPHER_CHUNK_HEADER_SIZE - 4] = 0;
+        bufPtr(header)[CIPHER_CHUNK_HEADER_SIZE - 3] = 0;
+        bufPtr(header)[CIPHER_CHUNK_HEADER_SIZE - 2] = 0;
+        TEST_ERROR(cipherChunkSize(header), CryptoError, "cipher header invalid");
+
+        TEST_ERROR(
+            testCipher(
+                cipherChunkNew(cipherModeDecrypt, testPass, 1), bufNewC(bufPtr(encryptEmpty), CIPHER_CHUNK_HEADER_SIZE + 1), 1024,
+                1024),
+            CryptoError, "unexpected eof in encrypted data");
+        TEST_ERROR(
+            testCipher(cipherChunkNew(cipherModeDecrypt, BUFSTRDEF("bogus"), 1), encrypt, 1024, 1024), CryptoError,
+            "unable to authenticate chunk 0 of encrypted data");
+        TEST_ERROR(
+            testCipher(cipherChunkNew(cipherModeDecrypt, BUFSTRDEF("bogus"), 2), encrypt, 1024, 1024), CryptoError,
+            "unable to authenticate chunk 0 of encrypted data");
+
+        // Truncating the file on a chunk boundary is detected since the last chunk is authenticated
+        TEST_ASSIGN(encrypt, testCipher(cipherChunkNew(cipherModeEncrypt, testPass, 1), plainText, 65536, 65536), "encrypt");
+        TEST_ERROR(
+            testCipher(
+                cipherChunkNew(cipherModeDecrypt, testPass, 1),
+                bufNewC(bufPtr(encrypt), cipherChunkOffset(CIPHER_CHUNK_SIZE_DEFAULT, 2)), 65536, 65536),
+            CryptoError, "unable to authenticate chunk 1 of encrypted data");
+
+        // Altered data is detected
+        Buffer *encryptBad = bufDup(encrypt);
+        bufPtr(encryptBad)[cipherChunkOffset(CIPHER_CHUNK_SIZE_DEFAULT, 2) + 100] ^= 0xFF;
+
+        TEST_ERROR(
+            testCipher(cipherChunkNew(cipherModeDecrypt, testPass, 3), encryptBad, 65536, 65536), CryptoError,
+            "unable to authenticate chunk 2 of encrypted data");
+
+        // Random access
+        // -------------------------------------------------------------------------------------------------------------------------
+        header = bufNewC(bufPtr(encrypt), CIPHER_CHUNK_HEADER_SIZE);
+        TEST_RESULT_UINT(cipherChunkSize(header), CIPHER_CHUNK_SIZE_DEFAULT, "chunk size");
+
+        uint64_t offset = cipherChunkOffset(CIPHER_CHUNK_SIZE_DEFAULT, 1);
+        TEST_RESULT_UINT(offset, CIPHER_CHUNK_HEADER_SIZE + CIPHER_CHUNK_SIZE_DEFAULT + CIPHER_CHUNK_TAG_SIZE, "chunk 1 offset");
+
+        TEST_RESULT_BOOL(
+            bufEq(
+                cipherChunkDecrypt(
+                    testPass, header, 1, false,
+                    bufNewC(bufPtr(encrypt) + offset, CIPHER_CHUNK_SIZE_DEFAULT + CIPHER_CHUNK_TAG_SIZE)),
+                bufNewC(bufPtr(plainText) + CIPHER_CHUNK_SIZE_DEFAULT, CIPHER_CHUNK_SIZE_DEFAULT)),
+            true, "decrypt chunk 1");
+
+        offset = cipherChunkOffset(CIPHER_CHUNK_SIZE_DEFAULT, 3);
+
+        TEST_RESULT_BOOL(
+            bufEq(
+                cipherChunkDecrypt(testPass, header, 3, true, bufNewC(bufPtr(encrypt) + offset, bufUsed(encrypt) - offset)),
+                bufNewC(bufPtr(plainText) + CIPHER_CHUNK_SIZE_DEFAULT * 3, 1000)),
+            true, "decrypt last chunk");
+
+        TEST_ERROR(
+            cipherChunkDecrypt(testPass, header, 3, false, bufNewC(bufPtr(encrypt) + offset, bufUsed(encrypt) - offset)),
+            CryptoError, "unable to authenticate chunk 3 of encrypted data");
+        Buffer *chunkLarge = bufNew(CIPHER_CHUNK_SIZE_DEFAULT + CIPHER_CHUNK_TAG_SIZE + 1);
+        bufUsedSet(chunkLarge, bufSize(chunkLarge));
+
+        TEST_ERROR(
+            cipherChunkDecrypt(testPass, header, 0, false, chunkLarge), CryptoError, "chunk is larger than the chunk size");
+
+        // Log
+        // -------------------------------------------------------------------------------------------------------------------------
+        filter = cipherChunkNew(cipherModeEncrypt, testPass, 1);
+
+        TEST_RESULT_STR(
+            strPtr(cipherChunkToLog(ioFilterDriver(filter))),
+            "{inputSame: false, done: false, flushing: false, jobPut: 0, jobOutput: 0}", "check log");
+
+        ioFilterFree(filter);
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("CipherDetect"))
+    {
+        Buffer *plainText = bufNew(CIPHER_CHUNK_SIZE_DEFAULT + 1000);
+
+        for (size_t plainIdx = 0; plainIdx < bufSize(plainText); plainIdx++)
+            bufPtr(plainText)[plainIdx] = (unsigned char)(plainIdx % 241);
+
+        bufUsedSet(plainText, bufSize(plainText));
+
+        // Decrypt block cipher
+        // -------------------------------------------------------------------------------------------------------------------------
+        Buffer *encrypt = NULL;
+        IoFilter *filter = NULL;
+
+        TEST_ASSIGN(
+            encrypt, testCipher(cipherBlockNew(cipherModeEncrypt, cipherTypeAes256Cbc, testPass, NULL), plainText, 65536, 65536),
+            "block encrypt");
+
+        TEST_ASSIGN(filter, cipherDetectNew(testPass, 2), "new decrypt filter");
+        TEST_ASSIGN(filter, cipherDetectNewVar(ioFilterParamList(filter)), "new decrypt filter from params");
+        TEST_RESULT_STR(strPtr(cipherDetectToLog(ioFilterDriver(filter))), "{headerSize: 0, cipher: null}", "check log");
+        TEST_RESULT_BOOL(bufEq(testCipher(filter, encrypt, 65536, 65536), plainText), true, "decrypt");
+        TEST_RESULT_BOOL(
+            bufEq(testCipher(cipherDetectNew(testPass, 2), encrypt, 3, 65536), plainText), true,
+            "decrypt with magic split across inputs");
+        TEST_RESULT_BOOL(
+            bufEq(testCipher(cipherDetectNew(testPass, 2), encrypt, 65536, 7), plainText), true, "decrypt small out buffer");
+
+        // Decrypt chunk cipher
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_ASSIGN(encrypt, testCipher(cipherChunkNew(cipherModeEncrypt, testPass, 1), plainText, 65536, 65536), "chunk encrypt");
+
+        TEST_RESULT_BOOL(
+            bufEq(testCipher(cipherDetectNew(testPass, 2), encrypt, 65536, 65536), plainText), true, "decrypt in threads");
+        TEST_RESULT_BOOL(
+            bufEq(testCipher(cipherDetectNew(testPass, 1), encrypt, 5, 65536), plainText), true,
+            "decrypt with magic split across inputs");
+        TEST_RESULT_BOOL(
+            bufEq(testCipher(cipherDetectNew(testPass, 1), encrypt, 65536, 13), plainText), true, "decrypt small out buffer");
+
+        filter = cipherDetectNew(testPass, 1);
+        Buffer *output = bufNew(65536);
+
+        ioFilterProcessInOut(filter, encrypt, output);
+        TEST_RESULT_STR(strPtr(cipherDetectToLog(ioFilterDriver(filter))), "{headerSize: 8, cipher: cipherChunk}", "check log");
+        ioFilterFree(filter);
+
+        // Errors
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_ERROR(testCipher(cipherDetectNew(testPass, 1), bufNew(0), 1024, 1024), CryptoError, "cipher header missing");
+        TEST_ERROR(testCipher(cipherDetectNew(testPass, 1), BUFSTRDEF("PGBR"), 1024, 1024), CryptoError, "cipher header missing");
+        TEST_ERROR(
+            testCipher(cipherDetectNew(testPass, 1), BUFSTRDEF("PGBRCHK1"), 1024, 1024), CryptoError, "cipher header missing");
+        TEST_ERROR(
+            testCipher(cipherDetectNew(testPass, 1), BUFSTRDEF("1234567890123456"), 1024, 1024), CryptoError,
+            "cipher header invalid");
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("cipherFilter()"))
+    {
+        IoFilter *filter = NULL;
+
+        TEST_ASSIGN(filter, cipherFilter(cipherModeEncrypt, cipherTypeAes256Cbc, testPass, 4), "block cipher");
+        TEST_RESULT_STR(strPtr(ioFilterType(filter)), CIPHER_BLOCK_FILTER_TYPE, "    check type");
+        ioFilterFree(filter);
+
+        TEST_ASSIGN(filter, cipherFilter(cipherModeEncrypt, cipherTypeAes256Gcm, testPass, 4), "chunk cipher");
+        TEST_RESULT_STR(strPtr(ioFilterType(filter)), CIPHER_CHUNK_FILTER_TYPE, "    check type");
+        TEST_RESULT_UINT(((CipherChunk *)ioFilterDriver(filter))->threadTotal, 4, "    check threads");
+        ioFilterFree(filter);
+
+        TEST_ASSIGN(filter, cipherFilter(cipherModeDecrypt, cipherTypeAes256Cbc, testPass, 4), "detect cipher");
+        TEST_RESULT_STR(strPtr(ioFilterType(filter)), CIPHER_DETECT_FILTER_TYPE, "    check type");
+        TEST_RESULT_UINT(((CipherDetect *)ioFilterDriver(filter))->threadTotal, 4, "    check threads");
+        ioFilterFree(filter);
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("CryptoHash"))
     {
@@ -345,6 +624,39 @@ testRun(void)
                         BUFSTRDEF("20170412")))),
             "8b05c497afe9e1f42c8ada4cb88392e118649db1e5c98f0f0fb0a158bdd2dd76",
             "    check hmac");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        CryptoHashMany *hashMany = NULL;
+        StringList *typeList = strLstAdd(strLstAdd(strLstNew(), HASH_TYPE_MD5_STR), HASH_TYPE_SHA256_STR);
+
+        TEST_ASSIGN(hashMany, cryptoHashManyNew(typeList), "create md5/sha256 hash");
+        TEST_RESULT_STR(strPtr(bufHex(cryptoHashManyResult(hashMany, 0))), HASH_TYPE_MD5_ZERO, "    check empty md5 hash");
+        TEST_RESULT_STR(strPtr(bufHex(cryptoHashManyResult(hashMany, 1))), HASH_TYPE_SHA256_ZERO, "    check empty sha256 hash");
+        TEST_RESULT_VOID(cryptoHashManyFree(hashMany), "    free hash");
+        TEST_RESULT_VOID(cryptoHashManyFree(NULL), "    free null hash");
+
+        // Message is larger than the chunk size and is added in pieces that do not align with chunks
+        Buffer *message = bufNew(40 * 1024);
+
+        for (size_t messageIdx = 0; messageIdx < bufSize(message); messageIdx++)
+            bufPtr(message)[messageIdx] = (unsigned char)(messageIdx % 251);
+
+        bufUsedSet(message, bufSize(message));
+
+        TEST_ASSIGN(hashMany, cryptoHashManyNew(typeList), "create md5/sha256 hash");
+        TEST_RESULT_VOID(cryptoHashManyProcess(hashMany, BUF(bufPtr(message), 10)), "    add first piece");
+        TEST_RESULT_VOID(cryptoHashManyProcess(hashMany, BUF(bufPtr(message) + 10, 0)), "    add empty piece");
+        TEST_RESULT_VOID(
+            cryptoHashManyProcess(hashMany, BUF(bufPtr(message) + 10, bufUsed(message) - 10)), "    add remaining pieces");
+        TEST_RESULT_STR(
+            strPtr(bufHex(cryptoHashManyResult(hashMany, 0))), strPtr(bufHex(cryptoHashOne(HASH_TYPE_MD5_STR, message))),
+            "    check md5 hash");
+        TEST_RESULT_STR(
+            strPtr(bufHex(cryptoHashManyResult(hashMany, 1))), strPtr(bufHex(cryptoHashOne(HASH_TYPE_SHA256_STR, message))),
+            "    check sha256 hash");
+        TEST_RESULT_STR(
+            strPtr(bufHex(cryptoHashManyResult(hashMany, 1))), strPtr(bufHex(cryptoHashOne(HASH_TYPE_SHA256_STR, message))),
+            "    check sha256 hash again");
     }
 
     FUNCTION_HARNESS_RESULT_VOID();
@@ -1,8 +1,18 @@
 /***********************************************************************************************************************************
 Test Ini
 ***********************************************************************************************************************************/
+#include "common/io/bufferRead.h"
 #include "storage/posix/storage.h"
 
+/***********************************************************************************************************************************
+Callback that records key/values loaded by iniLoad()
+***********************************************************************************************************************************/
+static void
+testIniLoadCallback(void *data, const String *section, const String *key, const String *value)
+{
+    strCatFmt((String *)data, "%s:%s=%s\n", strPtr(section), strPtr(key), strPtr(value));
+}
+
 /***********************************************************************************************************************************
 Test Run
 ***********************************************************************************************************************************/
@@ -80,7 +90,7 @@ testRun(void)
             iniParse(iniNew(), strNew("compress=y\n")), FormatError, "key/value found outside of section at line 1: compress=y");
         TEST_ERROR(iniParse(iniNew(), strNew("[section\n")), FormatError, "ini section should end with ] at line 1: [section");
         TEST_ERROR(iniParse(iniNew(), strNew("[section]\nkey")), FormatError, "missing '=' in key/value at line 2: key");
-        TEST_ERROR(iniParse(iniNew(), strNew("[section]\n =value")), FormatError, "key is zero-length at line 1: =value");
+        TEST_ERROR(iniParse(iniNew(), strNew("[section]\n =value")), FormatError, "key is zero-length at line 2: =value");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_ASSIGN(ini, iniNew(), "new ini");
@@ -101,6 +111,69 @@ testRun(void)
         TEST_RESULT_STR(strPtr(iniGet(ini, strNew("db"), strNew("pg1-path"))), "/path/to/pg", "get pg1-path");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("iniLoad()"))
+    {
+        // Use a small buffer so lines are split across reads and long lines grow the buffer
+        size_t bufferSizeOld = ioBufferSize();
+        ioBufferSizeSet(16);
+
+        String *result = strNew("");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_VOID(iniLoad(ioBufferReadNew(BUFSTRDEF("")), testIniLoadCallback, result), "load empty content");
+        TEST_RESULT_STR(strPtr(result), "", "    check callbacks");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        const Buffer *content = BUFSTRDEF
+        (
+            "# Comment that is longer than the buffer\n"
+            "[global]\r\n"
+            "compress = y\n"
+            "\n"
+            "[section-with-a-long-name]\n"
+            "key-that-is-longer-than-the-buffer=value that is also longer than the buffer\n"
+            "key=\n"
+            "key=1234567890"
+        );
+
+        TEST_RESULT_VOID(iniLoad(ioBufferReadNew(content), testIniLoadCallback, result), "load content");
+        TEST_RESULT_STR(
+            strPtr(result),
+            "global:compress=y\n"
+                "section-with-a-long-name:key-that-is-longer-than-the-buffer=value that is also longer than the buffer\n"
+                "section-with-a-long-name:key=\n"
+                "section-with-a-long-name:key=1234567890\n",
+            "    check callbacks");
+
+        // Last line without a linefeed exactly fills the buffer
+        // -------------------------------------------------------------------------------------------------------------------------
+        strTrunc(result, 0);
+
+        TEST_RESULT_VOID(
+            iniLoad(ioBufferReadNew(BUFSTRDEF("[s]\n0123456789ab=cde")), testIniLoadCallback, result), "load content");
+        TEST_RESULT_STR(strPtr(result), "s:0123456789ab=cde\n", "    check callbacks");
+
+        // Errors report the line number
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_ERROR(
+            iniLoad(ioBufferReadNew(BUFSTRDEF("[section]\n\n# comment\nkey-without-equal\n")), testIniLoadCallback, result),
+            FormatError, "missing '=' in key/value at line 4: key-without-equal");
+
+        // Missing file is ignored when allowed
+        // -------------------------------------------------------------------------------------------------------------------------
+        strTrunc(result, 0);
+
+        TEST_RESULT_VOID(
+            iniLoad(
+                storageReadIo(storageNewReadP(storageTest, strNew("missing.ini"), .ignoreMissing = true)), testIniLoadCallback,
+                result),
+            "load missing file");
+        TEST_RESULT_STR(strPtr(result), "", "    check callbacks");
+
+        ioBufferSizeSet(bufferSizeOld);
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("iniSave()"))
     {
@@ -291,6 +291,50 @@ testHttpServer(void)
 
         harnessTlsServerClose();
 
+        // Request sent without waiting for the response
+        harnessTlsServerAccept();
+
+        harnessTlsServerExpect(
+            "PUT /part HTTP/1.1\r\n"
+            "content-length:4\r\n"
+            "\r\n"
+            "ABCD");
+
+        harnessTlsServerReply(
+            "HTTP/1.1 200 OK\r\n"
+            "etag:E1\r\n"
+            "\r\n");
+
+        // 5xx response is not retried
+        harnessTlsServerExpect(
+            "PUT /part HTTP/1.1\r\n"
+            "\r\n");
+
+        harnessTlsServerReply(
+            "HTTP/1.1 503 Slow Down\r\n"
+            "content-length:4\r\n"
+            "\r\n"
+            "SLOW");
+
+        // Invalid response
+        harnessTlsServerExpect(
+            "HEAD / HTTP/1.1\r\n"
+            "\r\n");
+
+        harnessTlsServerReply(
+            "HTTP/1.0 200 OK\r\n");
+
+        harnessTlsServerClose();
+
+        // Response is never read
+        harnessTlsServerAccept();
+
+        harnessTlsServerExpect(
+            "GET / HTTP/1.1\r\n"
+            "\r\n");
+
+        harnessTlsServerClose();
+
         exit(0);
     }
 }
@@ -409,6 +453,10 @@ testRun(void)
         TEST_ERROR(
             httpClientRequest(client, strNew("GET"), strNew("/"), NULL, NULL, NULL, false), HostConnectError,
             "unable to connect to 'localhost:9443': [111] Connection refused");
+        TEST_ERROR(
+            httpClientRequestSend(client, strNew("GET"), strNew("/"), NULL, NULL, NULL), HostConnectError,
+            "unable to connect to 'localhost:9443': [111] Connection refused");
+        TEST_RESULT_BOOL(httpClientBusy(client), false, "    client is not busy");
 
         // Start http test server
         testHttpServer();
@@ -558,6 +606,33 @@ testRun(void)
         TEST_RESULT_VOID(ioRead(httpClientIoRead(client), buffer),  "    read response");
         TEST_RESULT_STR(strPtr(strNewBuf(buffer)),  "01234567890123456789012345678901012", "    check response");
 
+        // Request sent without waiting for the response
+        TEST_ASSIGN(client, httpClientNew(strNew(TLS_TEST_HOST), TLS_TEST_PORT, 500, true, NULL, NULL), "new client");
+
+        TEST_RESULT_VOID(
+            httpClientRequestSend(
+                client, strNew("PUT"), strNew("/part"), NULL,
+                httpHeaderAdd(httpHeaderNew(NULL), strNew("content-length"), strNew("4")), BUFSTRDEF("ABCD")),
+            "send request");
+        TEST_RESULT_BOOL(httpClientBusy(client), true, "    client is busy");
+        TEST_RESULT_PTR(httpClientResponse(client, true), NULL, "    read response");
+        TEST_RESULT_BOOL(httpClientBusy(client), false, "    client is not busy");
+        TEST_RESULT_STR(
+            strPtr(httpHeaderToLog(httpClientReponseHeader(client))),  "{etag: 'E1'}", "    check response headers");
+
+        TEST_RESULT_VOID(httpClientRequestSend(client, strNew("PUT"), strNew("/part"), NULL, NULL, NULL), "send request");
+        TEST_RESULT_STR(strPtr(strNewBuf(httpClientResponse(client, false))), "SLOW", "    read 5xx response without retry");
+        TEST_RESULT_UINT(httpClientResponseCode(client), 503, "    check response code");
+
+        TEST_RESULT_VOID(httpClientRequestSend(client, strNew("HEAD"), strNew("/"), NULL, NULL, NULL), "send request");
+        TEST_ERROR(
+            httpClientResponse(client, true), FormatError, "http version of response 'HTTP/1.0 200 OK' must be HTTP/1.1");
+        TEST_RESULT_BOOL(httpClientBusy(client), false, "    client is not busy");
+
+        TEST_RESULT_VOID(httpClientRequestSend(client, strNew("GET"), strNew("/"), NULL, NULL, NULL), "send request");
+        TEST_RESULT_VOID(httpClientDone(client), "    response is never read");
+        TEST_RESULT_BOOL(httpClientBusy(client), false, "    client is not busy");
+
         TEST_RESULT_BOOL(httpClientStatStr() != NULL, true, "check statistics exist");
 
         TEST_RESULT_VOID(httpClientFree(client), "free client");
@@ -2,6 +2,7 @@
 Test IO
 ***********************************************************************************************************************************/
 #include <fcntl.h>
+#include <unistd.h>
 
 #include "common/type/json.h"
 
@@ -232,6 +233,53 @@ ioTestFilterMultiplyNew(const char *type, unsigned int multiplier, unsigned int
     return this;
 }
 
+/***********************************************************************************************************************************
+Test filter that throws an error after a number of bytes have been processed
+***********************************************************************************************************************************/
+typedef struct IoTestFilterError
+{
+    MemContext *memContext;
+    size_t size;
+    size_t sizeMax;
+} IoTestFilterError;
+
+static void
+ioTestFilterErrorProcess(THIS_VOID, const Buffer *buffer)
+{
+    THIS(IoTestFilterError);
+
+    this->size += bufUsed(buffer);
+
+    if (this->size > this->sizeMax)
+        THROW_FMT(FormatError, "more than %zu bytes", this->sizeMax);
+}
+
+static Variant *
+ioTestFilterErrorResult(THIS_VOID)
+{
+    THIS(IoTestFilterError);
+
+    return varNewUInt64(this->size);
+}
+
+static IoFilter *
+ioTestFilterErrorNew(size_t sizeMax)
+{
+    IoFilter *this = NULL;
+
+    MEM_CONTEXT_NEW_BEGIN("IoTestFilterError")
+    {
+        IoTestFilterError *driver = memNew(sizeof(IoTestFilterError));
+        driver->memContext = MEM_CONTEXT_NEW();
+        driver->sizeMax = sizeMax;
+
+        this = ioFilterNewP(strNew("error"), driver, NULL, .in = ioTestFilterErrorProcess, .result = ioTestFilterErrorResult);
+    }
+    MEM_CONTEXT_NEW_END();
+
+    return this;
+}
+
 /***********************************************************************************************************************************
 Test Run
 ***********************************************************************************************************************************/
@@ -391,11 +439,14 @@ testRun(void)
         // Start with a buffer read
         TEST_RESULT_INT(ioRead(read, buffer), 3, "read buffer");
         TEST_RESULT_STR(strPtr(strNewBuf(buffer)), "AAA", "    check buffer");
+        TEST_RESULT_BOOL(ioReadLineReady(read), false, "    no line buffered");
 
         // Do line reads of various lengths
         TEST_RESULT_STR(strPtr(ioReadLine(read)), "123", "read line");
+        TEST_RESULT_BOOL(ioReadLineReady(read), false, "    partial line buffered");
         TEST_RESULT_STR(strPtr(ioReadLine(read)), "1234", "read line");
         TEST_RESULT_STR(strPtr(ioReadLine(read)), "", "read line");
+        TEST_RESULT_BOOL(ioReadLineReady(read), true, "    line buffered");
         TEST_RESULT_STR(strPtr(ioReadLine(read)), "12", "read line");
 
         // Read what was left in the line buffer
@@ -510,6 +561,100 @@ testRun(void)
         TEST_RESULT_UINT(varUInt64(ioFilterGroupResult(filterGroup, strNew("size2"))), 22, "    check filter result");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("IoFilterGroup in threads"))
+    {
+        ioBufferSizeSet(3);
+
+        const Buffer *source = BUFSTRDEF("ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+
+        // Read through filters in threads and compare with the same filters run without threads
+        // -------------------------------------------------------------------------------------------------------------------------
+        Buffer *expect = bufNew(0);
+        IoRead *read = NULL;
+
+        for (unsigned int threadIdx = 0; threadIdx < 2; threadIdx++)
+        {
+            read = ioBufferReadNew(source);
+            IoFilterGroup *filterGroup = ioReadFilterGroup(read);
+
+            ioFilterGroupAdd(filterGroup, ioSizeNew());
+            ioFilterGroupAdd(filterGroup, ioTestFilterMultiplyNew("double", 2, 3, 'X'));
+            ioFilterGroupAdd(filterGroup, ioTestFilterSizeNew("size2"));
+            ioFilterGroupAdd(filterGroup, ioTestFilterMultiplyNew("triple", 3, 2, 'Y'));
+            ioFilterGroupThreadSet(filterGroup, threadIdx == 1);
+            ioReadOpen(read);
+
+            Buffer *buffer = ioReadBuf(read);
+            ioReadClose(read);
+
+            if (threadIdx == 0)
+                bufCat(expect, buffer);
+            else
+            {
+                TEST_RESULT_STR(strPtr(strNewBuf(buffer)), strPtr(strNewBuf(expect)), "read in threads");
+                TEST_RESULT_UINT(varUInt64(ioFilterGroupResult(filterGroup, SIZE_FILTER_TYPE_STR)), 26, "    check size");
+                TEST_RESULT_UINT(varUInt64(ioFilterGroupResult(filterGroup, strNew("size2"))), 55, "    check size2");
+            }
+        }
+
+        TEST_RESULT_UINT(bufUsed(expect), 167, "    check size of output");
+
+        // Read an empty source in threads
+        // -------------------------------------------------------------------------------------------------------------------------
+        read = ioBufferReadNew(bufNew(0));
+        ioFilterGroupAdd(ioReadFilterGroup(read), ioTestFilterMultiplyNew("double", 2, 2, 'X'));
+        ioFilterGroupAdd(ioReadFilterGroup(read), ioSizeNew());
+        ioFilterGroupThreadSet(ioReadFilterGroup(read), true);
+        ioReadOpen(read);
+
+        TEST_RESULT_STR(strPtr(strNewBuf(ioReadBuf(read))), "XX", "read empty source in threads");
+        TEST_RESULT_VOID(ioReadClose(read), "    close");
+        TEST_RESULT_UINT(varUInt64(ioFilterGroupResult(ioReadFilterGroup(read), SIZE_FILTER_TYPE_STR)), 2, "    check size");
+
+        // Write through filters in threads
+        // -------------------------------------------------------------------------------------------------------------------------
+        Buffer *buffer = bufNew(0);
+        IoWrite *write = ioBufferWriteNew(buffer);
+
+        ioFilterGroupAdd(ioWriteFilterGroup(write), ioTestFilterMultiplyNew("double", 2, 3, 'X'));
+        ioFilterGroupAdd(ioWriteFilterGroup(write), ioTestFilterMultiplyNew("single", 1, 1, 'Y'));
+        ioFilterGroupAdd(ioWriteFilterGroup(write), ioSizeNew());
+        ioFilterGroupThreadSet(ioWriteFilterGroup(write), true);
+
+        TEST_RESULT_VOID(ioWriteOpen(write), "open write in threads");
+        TEST_RESULT_VOID(ioWrite(write, BUFSTRDEF("AB")), "    write");
+        TEST_RESULT_VOID(ioWrite(write, BUFSTRDEF("CDEFG")), "    write");
+        TEST_RESULT_VOID(ioWriteClose(write), "    close");
+        TEST_RESULT_STR(strPtr(strNewBuf(buffer)), "AABBCCDDEEFFGGXXXY", "    check write");
+        TEST_RESULT_UINT(varUInt64(ioFilterGroupResult(ioWriteFilterGroup(write), SIZE_FILTER_TYPE_STR)), 18, "    check size");
+
+        // Error in a thread is thrown by the caller
+        // -------------------------------------------------------------------------------------------------------------------------
+        read = ioBufferReadNew(source);
+        ioFilterGroupAdd(ioReadFilterGroup(read), ioTestFilterMultiplyNew("double", 2, 1, 'X'));
+        ioFilterGroupAdd(ioReadFilterGroup(read), ioTestFilterErrorNew(10));
+        ioFilterGroupThreadSet(ioReadFilterGroup(read), true);
+        ioReadOpen(read);
+
+        TEST_ERROR(ioReadBuf(read), FormatError, "more than 10 bytes");
+        TEST_RESULT_VOID(ioReadFree(read), "    free read");
+
+        // Free while threads are waiting for input
+        // -------------------------------------------------------------------------------------------------------------------------
+        read = ioBufferReadNew(source);
+        ioFilterGroupAdd(ioReadFilterGroup(read), ioTestFilterMultiplyNew("double", 2, 1, 'X'));
+        ioFilterGroupAdd(ioReadFilterGroup(read), ioSizeNew());
+        ioFilterGroupThreadSet(ioReadFilterGroup(read), true);
+        ioReadOpen(read);
+
+        buffer = bufNew(4);
+
+        TEST_RESULT_UINT(ioRead(read, buffer), 4, "read part");
+        TEST_RESULT_STR(strPtr(strNewBuf(buffer)), "AABB", "    check read");
+        TEST_RESULT_VOID(ioReadFree(read), "    free read");
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("IoHandleRead, IoHandleWrite, and ioHandleWriteOneStr()"))
     {
@@ -595,5 +740,61 @@ testRun(void)
         TEST_RESULT_VOID(ioHandleWriteOneStr(fileHandle, strNew("test1\ntest2")), "write string to file");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("IoEvent"))
+    {
+        int pipe1[2];
+        int pipe2[2];
+        THROW_ON_SYS_ERROR(pipe(pipe1) == -1, KernelError, "unable to create pipe");
+        THROW_ON_SYS_ERROR(pipe(pipe2) == -1, KernelError, "unable to create pipe");
+
+        IoEvent *event = NULL;
+        TEST_ASSIGN(event, ioEventNew(), "new event");
+
+        int data1 = 1;
+        int data2 = 2;
+
+        TEST_RESULT_VOID(ioEventAdd(event, pipe1[0], &data1), "add handle 1");
+        TEST_RESULT_VOID(ioEventAdd(event, pipe2[0], &data2), "add handle 2");
+        TEST_RESULT_UINT(ioEventSize(event), 2, "check size");
+        TEST_RESULT_STR(strPtr(ioEventToLog(event)), "{handleTotal: 2}", "check log");
+
+        TEST_ERROR_FMT(
+            ioEventAdd(event, pipe1[0], &data1), KernelError, "unable to add handle %d to event: [17] File exists", pipe1[0]);
+        TEST_ERROR_FMT(
+            ioEventRemove(event, pipe1[1]), KernelError, "unable to remove handle %d from event: [2] No such file or directory",
+            pipe1[1]);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_UINT(ioEventWait(event, 100), 0, "no handles ready");
+
+        TEST_RESULT_VOID(ioHandleWriteOneStr(pipe2[1], strNew("2")), "write to handle 2");
+        TEST_RESULT_UINT(ioEventWait(event, 100), 1, "one handle ready");
+        TEST_RESULT_PTR(ioEventReady(event, 0), &data2, "    check handle 2 data");
+
+        TEST_RESULT_VOID(ioHandleWriteOneStr(pipe1[1], strNew("1")), "write to handle 1");
+        TEST_RESULT_UINT(ioEventWait(event, 100), 2, "two handles ready");
+        TEST_RESULT_INT(
+            *(int *)ioEventReady(event, 0) + *(int *)ioEventReady(event, 1), 3, "    check handle 1 and 2 data");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_VOID(ioEventRemove(event, pipe2[0]), "remove handle 2");
+        TEST_RESULT_UINT(ioEventSize(event), 1, "check size");
+        TEST_RESULT_UINT(ioEventWait(event, 100), 1, "one handle ready");
+        TEST_RESULT_PTR(ioEventReady(event, 0), &data1, "    check handle 1 data");
+
+        // Grow the event list when more handles are added
+        TEST_RESULT_VOID(ioEventAdd(event, pipe2[0], &data2), "add handle 2");
+        TEST_RESULT_VOID(ioEventAdd(event, pipe2[1], &data2), "add handle 3 (pipe write end)");
+        TEST_RESULT_UINT(ioEventWait(event, 100), 2, "two handles ready");
+
+        TEST_RESULT_VOID(ioEventFree(event), "free event");
+
+        close(pipe1[0]);
+        close(pipe1[1]);
+        close(pipe2[0]);
+        close(pipe2[1]);
+    }
+
     FUNCTION_HARNESS_RESULT_VOID();
 }
@@ -216,23 +216,47 @@ testRun(void)
         // Free memory
         TEST_RESULT_UINT(memContextCurrent()->allocFreeIdx, MEM_CONTEXT_ALLOC_INITIAL_SIZE + 2, "check alloc free idx");
         TEST_RESULT_VOID(memFree(memContextCurrent()->allocList[0].buffer), "free allocation");
-        TEST_ERROR(memFree(memContextCurrent()->allocList[0].buffer), AssertError, "unable to find allocation");
         TEST_RESULT_UINT(memContextCurrent()->allocFreeIdx, 0, "check alloc free idx");
+        TEST_RESULT_PTR(memContextCurrent()->allocList[0].buffer, NULL, "check buffer is cleared");
 
         TEST_RESULT_VOID(memFree(memContextCurrent()->allocList[1].buffer), "free allocation");
-        TEST_RESULT_UINT(memContextCurrent()->allocFreeIdx, 0, "check alloc free idx");
+        TEST_RESULT_UINT(memContextCurrent()->allocFreeIdx, 1, "check alloc free idx");
 
+        // Free allocations are reused from the top of the free stack
         TEST_RESULT_VOID(memNew(3), "new allocation");
-        TEST_RESULT_UINT(memContextCurrent()->allocFreeIdx, 1, "check alloc free idx");
+        TEST_RESULT_UINT(memContextCurrent()->allocFreeIdx, 0, "check alloc free idx");
 
         TEST_RESULT_VOID(memNew(3), "new allocation");
-        TEST_RESULT_UINT(memContextCurrent()->allocFreeIdx, 2, "check alloc free idx");
+        TEST_RESULT_UINT(memContextCurrent()->allocFreeIdx, MEM_CONTEXT_ALLOC_INITIAL_SIZE + 2, "check alloc free idx");
 
         TEST_RESULT_VOID(memNew(3), "new allocation");
         TEST_RESULT_UINT(memContextCurrent()->allocFreeIdx, MEM_CONTEXT_ALLOC_INITIAL_SIZE + 3, "check alloc free idx");
 
+        // Fill the list so the free stack is empty and then grow it
+        for (unsigned int allocIdx = MEM_CONTEXT_ALLOC_INITIAL_SIZE + 3; allocIdx < MEM_CONTEXT_ALLOC_INITIAL_SIZE * 2; allocIdx++)
+            memNew(3);
+
+        TEST_RESULT_BOOL(
+            memContextCurrent()->allocFreeIdx >= memContextCurrent()->allocListSize, true, "free stack is empty");
+        TEST_RESULT_VOID(memNew(3), "new allocation");
+        TEST_RESULT_UINT(memContextCurrent()->allocListSize, MEM_CONTEXT_ALLOC_INITIAL_SIZE * 4, "allocation list size");
+        TEST_RESULT_UINT(memContextCurrent()->allocFreeIdx, MEM_CONTEXT_ALLOC_INITIAL_SIZE * 2 + 1, "check alloc free idx");
+
+        // Allocations from other contexts cannot be freed
         TEST_ERROR(memFree(NULL), AssertError, "assertion 'buffer != NULL' failed");
-        TEST_ERROR(memFree((void *)0x01), AssertError, "unable to find allocation");
+
+        void *bufferOther = NULL;
+        MemContext *memContextOther = memContextNew("test-alloc-other");
+
+        MEM_CONTEXT_BEGIN(memContextOther)
+        {
+            memNew(3);
+            bufferOther = memNew(3);
+        }
+        MEM_CONTEXT_END();
+
+        TEST_ERROR(memFree(bufferOther), AssertError, "unable to find allocation");
+        memContextFree(memContextOther);
         memFree(buffer);
 
         memContextSwitch(memContextTop());
@@ -411,6 +435,171 @@ testRun(void)
         MEM_CONTEXT_NEW_END();
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("memContextNewArena() and memContextReset()"))
+    {
+        memContextSwitch(memContextTop());
+        MemContext *memContext = memContextNewArena("test-arena");
+
+        MEM_CONTEXT_BEGIN(memContext)
+        {
+            // Small allocations are made from the arena
+            // ---------------------------------------------------------------------------------------------------------------------
+            unsigned char *buffer1 = memNew(3);
+            TEST_RESULT_BOOL(memContext->arenaChunk != NULL, true, "chunk allocated");
+            TEST_RESULT_BOOL(memContext->allocList[0].active, false, "not in alloc list");
+            TEST_RESULT_UINT(
+                memContext->arenaChunk->used, MEM_CONTEXT_ARENA_CHUNK_HEADER_SIZE + sizeof(MemContextAllocHeader) * 2,
+                "chunk used");
+            TEST_RESULT_UINT((uintptr_t)buffer1 % sizeof(MemContextAllocHeader), 0, "buffer is aligned");
+            TEST_RESULT_UINT(buffer1[0] + buffer1[1] + buffer1[2], 0, "buffer is zeroed");
+
+            // Grow the last allocation in place
+            buffer1[0] = 0xFE;
+            TEST_RESULT_PTR(memGrowRaw(buffer1, 64), buffer1, "grow in place");
+            TEST_RESULT_UINT(
+                memContext->arenaChunk->used, MEM_CONTEXT_ARENA_CHUNK_HEADER_SIZE + sizeof(MemContextAllocHeader) + 64,
+                "chunk used");
+
+            // Grow an allocation that is not last by copying it
+            unsigned char *buffer2 = memNewRaw(16);
+            unsigned char *buffer3 = NULL;
+            TEST_ASSIGN(buffer3, memGrowRaw(buffer1, 128), "grow by copy");
+            TEST_RESULT_BOOL(buffer3 != buffer1, true, "buffer moved");
+            TEST_RESULT_UINT(buffer3[0], 0xFE, "buffer copied");
+
+            // Free the last allocation and reuse the space
+            size_t used = memContext->arenaChunk->used;
+            TEST_RESULT_VOID(memFree(buffer3), "free last allocation");
+            TEST_RESULT_UINT(memContext->arenaChunk->used, used - sizeof(MemContextAllocHeader) - 128, "space returned");
+            TEST_RESULT_PTR(memNewRaw(128), buffer3, "space reused");
+
+            // Freeing an allocation that is not last is a noop
+            used = memContext->arenaChunk->used;
+            TEST_RESULT_VOID(memFree(buffer2), "free allocation");
+            TEST_RESULT_UINT(memContext->arenaChunk->used, used, "space not returned");
+
+            // Large allocations are in the alloc list
+            // ---------------------------------------------------------------------------------------------------------------------
+            void *bufferLarge = NULL;
+            TEST_ASSIGN(bufferLarge, memNew(MEM_CONTEXT_ARENA_ALLOC_MAX + 1), "large allocation");
+            TEST_RESULT_PTR(memContext->allocList[0].buffer, bufferLarge, "in alloc list");
+            TEST_RESULT_UINT(memContext->arenaChunk->used, used, "arena not used");
+
+            // Grow an arena allocation so it is too large for the arena
+            TEST_ASSIGN(buffer3, memGrowRaw(buffer3, MEM_CONTEXT_ARENA_ALLOC_MAX * 2), "grow by copy");
+            TEST_RESULT_PTR(memContext->allocList[1].buffer, buffer3, "in alloc list");
+            TEST_RESULT_VOID(memFree(buffer3), "free large allocation");
+            TEST_RESULT_VOID(memFree(bufferLarge), "free large allocation");
+
+            // Fill the chunk so a new chunk is added
+            // ---------------------------------------------------------------------------------------------------------------------
+            MemContextArenaChunk *chunk = memContext->arenaChunk;
+
+            while (memContext->arenaChunk == chunk)
+                buffer1 = memNewRaw(MEM_CONTEXT_ARENA_ALLOC_MAX);
+
+            TEST_RESULT_PTR(memContext->arenaChunk->next, chunk, "new chunk added");
+            TEST_RESULT_VOID(memFree(buffer1), "free allocation in new chunk");
+            TEST_RESULT_UINT(memContext->arenaChunk->used, MEM_CONTEXT_ARENA_CHUNK_HEADER_SIZE, "new chunk is empty");
+
+            // An allocation in an older chunk cannot be grown in place
+            TEST_ASSIGN(buffer1, memGrowRaw(buffer2, 32), "grow by copy");
+            TEST_RESULT_BOOL(buffer1 != buffer2, true, "buffer moved");
+
+            // Allocation cannot be grown in place if the chunk is full
+            while (memContext->arenaChunk->used + sizeof(MemContextAllocHeader) + 32 <= MEM_CONTEXT_ARENA_CHUNK_SIZE)
+                buffer1 = memNewRaw(32);
+
+            TEST_RESULT_BOOL(memGrowRaw(buffer1, 64) != buffer1, true, "grow by copy when chunk is full");
+        }
+        MEM_CONTEXT_END();
+
+        // Allocations that are not in the current context cannot be found
+        // -------------------------------------------------------------------------------------------------------------------------
+        MemContext *memContextOther = memContextNewArena("test-arena-other");
+        void *bufferOther = NULL;
+
+        MEM_CONTEXT_BEGIN(memContextOther)
+        {
+            bufferOther = memNew(3);
+        }
+        MEM_CONTEXT_END();
+
+        TEST_ERROR(memFree(bufferOther), AssertError, "unable to find allocation");
+
+        MEM_CONTEXT_BEGIN(memContext)
+        {
+            TEST_ERROR(memFree(bufferOther), AssertError, "unable to find allocation");
+        }
+        MEM_CONTEXT_END();
+
+        memContextFree(memContextOther);
+
+        // Reset frees allocations and child contexts but keeps the newest chunk
+        // -------------------------------------------------------------------------------------------------------------------------
+        MemContextArenaChunk *chunk = memContext->arenaChunk;
+        MemContext *memContextChild = NULL;
+
+        MEM_CONTEXT_BEGIN(memContext)
+        {
+            memNew(MEM_CONTEXT_ARENA_ALLOC_MAX + 1);
+            memContextChild = memContextNew("test-arena-child");
+        }
+        MEM_CONTEXT_END();
+
+        TEST_RESULT_VOID(memContextReset(memContext), "reset context");
+        TEST_RESULT_PTR(memContext->arenaChunk, chunk, "newest chunk kept");
+        TEST_RESULT_PTR(memContext->arenaChunk->next, NULL, "older chunks freed");
+        TEST_RESULT_UINT(memContext->arenaChunk->used, MEM_CONTEXT_ARENA_CHUNK_HEADER_SIZE, "chunk is empty");
+        TEST_RESULT_BOOL(memContext->allocList[0].active, false, "large allocation freed");
+        TEST_RESULT_UINT(memContext->allocFreeIdx, 0, "check alloc free idx");
+        TEST_RESULT_UINT(memContextChild->state, memContextStateFree, "child context freed");
+        TEST_RESULT_UINT(memContext->state, memContextStateActive, "context is active");
+
+        // Reset a context that is not an arena
+        MemContext *memContextStd = memContextNew("test-reset");
+
+        MEM_CONTEXT_BEGIN(memContextStd)
+        {
+            memNew(3);
+        }
+        MEM_CONTEXT_END();
+
+        TEST_RESULT_VOID(memContextReset(memContextStd), "reset context");
+        TEST_RESULT_BOOL(memContextStd->allocList[0].active, false, "allocation freed");
+
+        TEST_RESULT_VOID(memContextCallbackSet(memContextStd, testFree, memContextStd), "set callback");
+        TEST_ERROR(memContextReset(memContextStd), AssertError, "cannot reset context 'test-reset' with callback");
+        memContextCallbackClear(memContextStd);
+
+        memContextFree(memContextStd);
+        TEST_ERROR(memContextReset(memContextStd), AssertError, "cannot reset inactive context");
+
+        TEST_RESULT_VOID(memContextFree(memContext), "free context");
+        TEST_RESULT_PTR(memContext->arenaChunk, NULL, "chunks freed");
+
+        // Reset temp arena context after a single iteration
+        // -------------------------------------------------------------------------------------------------------------------------
+        MEM_CONTEXT_TEMP_RESET_ARENA_BEGIN()
+        {
+            memNew(99);
+            TEST_RESULT_UINT(
+                MEM_CONTEXT_TEMP()->arenaChunk->used,
+                MEM_CONTEXT_ARENA_CHUNK_HEADER_SIZE + sizeof(MemContextAllocHeader) + MEM_CONTEXT_ALIGN(99), "1 allocation");
+
+            MEM_CONTEXT_TEMP_RESET(1);
+            TEST_RESULT_UINT(MEM_CONTEXT_TEMP()->arenaChunk->used, MEM_CONTEXT_ARENA_CHUNK_HEADER_SIZE, "nothing allocated");
+        }
+        MEM_CONTEXT_TEMP_END();
+
+        MEM_CONTEXT_TEMP_ARENA_BEGIN()
+        {
+            TEST_RESULT_BOOL(MEM_CONTEXT_TEMP()->arena, true, "temp context is an arena");
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+
     memContextFree(memContextTop());
 
     FUNCTION_HARNESS_RESULT_VOID();
@@ -110,5 +110,71 @@ testRun(void)
         TEST_RESULT_VOID(kvFree(store), "free store");
     }
 
+    // -----------------------------------------------------------------------------------------------------------------------------
+    if (testBegin("hash index"))
+    {
+        KeyValue *store = kvNew();
+
+        // Keys that cannot be hashed are found by searching the list
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_PTR(kvPut(store, varNewBool(true), varNewInt(1)), store, "put bool/int");
+        TEST_RESULT_PTR(kvPut(store, varNewStr(NULL), varNewInt(2)), store, "put null string/int");
+
+        // Add enough keys of each type to build the index and then grow it
+        // -------------------------------------------------------------------------------------------------------------------------
+        for (unsigned int keyIdx = 0; keyIdx < 100; keyIdx++)
+        {
+            kvPut(store, varNewStrZ(strPtr(strNewFmt("key%u", keyIdx))), varNewUInt(keyIdx));
+            kvPut(store, varNewInt((int)keyIdx), varNewUInt(keyIdx + 1000));
+            kvPut(store, varNewInt64((int64_t)keyIdx), varNewUInt(keyIdx + 2000));
+            kvPut(store, varNewUInt(keyIdx), varNewUInt(keyIdx + 3000));
+            kvPut(store, varNewUInt64(keyIdx), varNewUInt(keyIdx + 4000));
+        }
+
+        TEST_RESULT_BOOL(store->hashList != NULL, true, "hash index built");
+        TEST_RESULT_UINT(store->hashSize, 1024, "hash index grown");
+        TEST_RESULT_UINT(lstSize(store->list), 502, "check key total");
+
+        // Update a value and add to a value with the index
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_PTR(kvPut(store, varNewStrZ("key50"), varNewUInt(777)), store, "update string/int");
+        TEST_RESULT_PTR(kvAdd(store, varNewUInt64(50), varNewUInt(888)), store, "add uint64/int");
+        TEST_RESULT_UINT(lstSize(store->list), 502, "check key total did not change");
+
+        // Get keys of each type
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_UINT(varUInt(kvGet(store, varNewStrZ("key99"))), 99, "get string key");
+        TEST_RESULT_UINT(varUInt(kvGet(store, varNewStrZ("key50"))), 777, "get updated string key");
+        TEST_RESULT_UINT(varUInt(kvGet(store, varNewInt(99))), 1099, "get int key");
+        TEST_RESULT_UINT(varUInt(kvGet(store, varNewInt64(99))), 2099, "get int64 key");
+        TEST_RESULT_UINT(varUInt(kvGet(store, varNewUInt(99))), 3099, "get uint key");
+        TEST_RESULT_UINT(varUInt(kvGet(store, varNewUInt64(99))), 4099, "get uint64 key");
+        TEST_RESULT_UINT(varLstSize(kvGetList(store, varNewUInt64(50))), 2, "get added uint64 key");
+        TEST_RESULT_INT(varInt(kvGet(store, varNewBool(true))), 1, "get bool key");
+        TEST_RESULT_INT(varInt(kvGet(store, varNewStr(NULL))), 2, "get null string key");
+        TEST_RESULT_BOOL(kvKeyExists(store, varNewStrZ(BOGUS_STR)), false, "missing string key");
+        TEST_RESULT_BOOL(kvKeyExists(store, varNewInt(100)), false, "missing int key");
+        TEST_RESULT_BOOL(kvKeyExists(store, varNewBool(false)), false, "missing bool key");
+
+        // Keys are still listed in the order they were added
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_BOOL(varBool(varLstGet(kvKeyList(store), 0)), true, "first key");
+        TEST_RESULT_STR(strPtr(varStr(varLstGet(kvKeyList(store), 2))), "key0", "third key");
+        TEST_RESULT_UINT(varUInt64(varLstGet(kvKeyList(store), 501)), 99, "last key");
+
+        // The index is built for a duplicate
+        // -------------------------------------------------------------------------------------------------------------------------
+        KeyValue *storeDup = kvDup(store);
+
+        TEST_RESULT_UINT(storeDup->hashSize, 2048, "dup hash index built");
+        TEST_RESULT_UINT(varUInt(kvGet(storeDup, varNewStrZ("key98"))), 98, "get string key from dup");
+        TEST_RESULT_UINT(varUInt(kvGet(storeDup, varNewUInt(98))), 3098, "get uint key from dup");
+
+        TEST_RESULT_PTR(kvDup(kvNew())->hashList, NULL, "no hash index for small dup");
+
+        TEST_RESULT_VOID(kvFree(storeDup), "free dup store");
+        TEST_RESULT_VOID(kvFree(store), "free store");
+    }
+
     FUNCTION_HARNESS_RESULT_VOID();
 }
@@ -262,6 +262,40 @@ testRun(void)
 
         TEST_RESULT_VOID(harnessCfgLoad(strLstSize(argList), strLstPtr(argList)), "load config with success");
 
+        // Compress level must be valid for the compress type
+        // -------------------------------------------------------------------------------------------------------------------------
+        argList = strLstNew();
+        strLstAdd(argList, strNew("pgbackrest"));
+        strLstAdd(argList, strNew("--stanza=db"));
+        strLstAdd(argList, strNew("--compress-type=gz"));
+        strLstAdd(argList, strNew("--compress-level=10"));
+        strLstAdd(argList, strNew("archive-push"));
+
+        TEST_ERROR(
+            harnessCfgLoad(strLstSize(argList), strLstPtr(argList)), OptionInvalidValueError,
+            "'10' is not valid for 'compress-level' option\n"
+                "HINT: 'compress-type=gz' allows levels 0-9.");
+
+        argList = strLstNew();
+        strLstAdd(argList, strNew("pgbackrest"));
+        strLstAdd(argList, strNew("--stanza=db"));
+        strLstAdd(argList, strNew("--compress-type=gz"));
+        strLstAdd(argList, strNew("--compress-level=10"));
+        strLstAdd(argList, strNew("--no-compress"));
+        strLstAdd(argList, strNew("archive-push"));
+
+        TEST_RESULT_VOID(harnessCfgLoad(strLstSize(argList), strLstPtr(argList)), "compress level not checked when not compressing");
+
+        argList = strLstNew();
+        strLstAdd(argList, strNew("pgbackrest"));
+        strLstAdd(argList, strNew("--stanza=db"));
+        strLstAdd(argList, strNew("--compress-type=zst"));
+        strLstAdd(argList, strNew("archive-push"));
+
+        TEST_RESULT_VOID(harnessCfgLoad(strLstSize(argList), strLstPtr(argList)), "load config with zst compression");
+        TEST_RESULT_INT(cfgOptionInt(cfgOptCompressLevel), 3, "    default level for zst");
+        TEST_RESULT_INT(cfgOptionSource(cfgOptCompressLevel), cfgSourceDefault, "    level source is default");
+
         // -------------------------------------------------------------------------------------------------------------------------
         setenv("PGBACKREST_REPO1_S3_KEY", "mykey", true);
         setenv("PGBACKREST_REPO1_S3_KEY_SECRET", "mysecretkey", true);
@@ -419,10 +453,14 @@ testRun(void)
         strLstAdd(argList, strNew("--log-level-console=off"));
         strLstAdd(argList, strNew("--log-level-stderr=off"));
         strLstAdd(argList, strNew("--log-level-file=warn"));
+        strLstAdd(argList, strNew("--filter-thread"));
         strLstAdd(argList, strNew("backup"));
 
         TEST_RESULT_VOID(cfgLoad(strLstSize(argList), strLstPtr(argList)), "lock and open log file");
         TEST_RESULT_INT(lstat(strPtr(strNewFmt("%s/db-backup.log", testPath())), &statLog), 0, "   check log file exists");
+        TEST_RESULT_BOOL(ioFilterThread(), true, "   filter thread set");
+
+        ioFilterThreadSet(false);
 
         // Local command opens log file with special filename
         // -------------------------------------------------------------------------------------------------------------------------
@@ -1,6 +1,7 @@
 /***********************************************************************************************************************************
 Test Info Handler
 ***********************************************************************************************************************************/
+#include "common/crypto/cipherBlock.h"
 #include "storage/posix/storage.h"
 
 /***********************************************************************************************************************************
@@ -257,6 +258,74 @@ testRun(void)
 
         storageRemoveNP(storageLocalWrite(), fileNameCopy);
 
+        // Checksum is calculated in small chunks
+        //--------------------------------------------------------------------------------------------------------------------------
+        content = strNew
+        (
+            "[backrest]\n"
+            "backrest-checksum=\"1efa53e0611604ad7d833c5547eb60ff716e758c\"\n"
+            "backrest-format=5\n"
+            "backrest-version=\"2.04\"\n"
+            "\n"
+            "[db]\n"
+            "db-id=1\n"
+            "db-system-id=6569239123849665679\n"
+            "db-version=\"9.4\"\n"
+            "\n"
+            "[db:history]\n"
+            "1={\"db-id\":6569239123849665679,\"db-version\":\"9.4\"}\n"
+        );
+
+        TEST_RESULT_VOID(storagePutNP(storageNewWriteNP(storageLocalWrite(), fileName), BUFSTR(content)), "put info to file");
+
+        ioBufferSizeSet(16);
+        TEST_ASSIGN(info, infoNewLoad(storageLocal(), fileName, cipherTypeNone, NULL, NULL), "load file with small buffer");
+        ioBufferSizeSet(65536);
+
+        // Checksum is recalculated when sections are not sorted
+        //--------------------------------------------------------------------------------------------------------------------------
+        content = strNew
+        (
+            "[db:history]\n"
+            "1={\"db-id\":6569239123849665679,\"db-version\":\"9.4\"}\n"
+            "\n"
+            "[backrest]\n"
+            "backrest-checksum=\"1efa53e0611604ad7d833c5547eb60ff716e758c\"\n"
+            "backrest-format=5\n"
+            "backrest-version=\"2.04\"\n"
+            "\n"
+            "[db]\n"
+            "db-id=1\n"
+            "db-system-id=6569239123849665679\n"
+            "db-version=\"9.4\"\n"
+        );
+
+        TEST_RESULT_VOID(storagePutNP(storageNewWriteNP(storageLocalWrite(), fileName), BUFSTR(content)), "put unsorted sections");
+        TEST_ASSIGN(info, infoNewLoad(storageLocal(), fileName, cipherTypeNone, NULL, NULL), "load file");
+
+        // Checksum is recalculated when keys are not sorted
+        //--------------------------------------------------------------------------------------------------------------------------
+        content = strNew
+        (
+            "[backrest]\n"
+            "backrest-version=\"2.04\"\n"
+            "backrest-format=5\n"
+            "backrest-checksum=\"1efa53e0611604ad7d833c5547eb60ff716e758c\"\n"
+            "\n"
+            "[db]\n"
+            "db-id=1\n"
+            "db-system-id=6569239123849665679\n"
+            "db-version=\"9.4\"\n"
+            "\n"
+            "[db:history]\n"
+            "1={\"db-id\":6569239123849665679,\"db-version\":\"9.4\"}\n"
+        );
+
+        TEST_RESULT_VOID(storagePutNP(storageNewWriteNP(storageLocalWrite(), fileName), BUFSTR(content)), "put unsorted keys");
+        TEST_ASSIGN(info, infoNewLoad(storageLocal(), fileName, cipherTypeNone, NULL, NULL), "load file");
+
+        storageRemoveNP(storageLocalWrite(), fileName);
+
         // infoFree()
         //--------------------------------------------------------------------------------------------------------------------------
         TEST_RESULT_VOID(infoFree(info), "infoFree() - free info memory context");
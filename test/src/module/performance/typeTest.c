@@ -0,0 +1,147 @@
+/***********************************************************************************************************************************
+Test Type Performance
+
+Test the performance of various types and data structures.  Generally speaking, the starting values should be high enough to "blow
+up" in an unacceptable way if the implementation is not efficient.
+***********************************************************************************************************************************/
+#include "common/ini.h"
+#include "common/time.h"
+
+/***********************************************************************************************************************************
+Test Run
+***********************************************************************************************************************************/
+void
+testRun(void)
+{
+    FUNCTION_HARNESS_VOID();
+
+    // *****************************************************************************************************************************
+    if (testBegin("iniParse() with a large manifest"))
+    {
+        // Generate a manifest with a file section large enough that a linear key search would take minutes to load
+        unsigned int fileTotal = 500000;
+        String *manifest = strNew("[backup]\nbackup-label=\"20190818-084502F\"\n\n[target:file]\n");
+
+        for (unsigned int fileIdx = 0; fileIdx < fileTotal; fileIdx++)
+        {
+            strCatFmt(
+                manifest,
+                "pg_data/base/16384/%u={\"checksum\":\"184473f470864e067ee3a22e64b47b0a1c356f29\",\"size\":8192"
+                    ",\"timestamp\":1565282114}\n",
+                16384 + fileIdx);
+        }
+
+        TEST_LOG_FMT("manifest size is %zu bytes", strSize(manifest));
+
+        // Parse the manifest
+        Ini *ini = iniNew();
+        TimeMSec timeBegin = timeMSec();
+
+        TEST_RESULT_VOID(iniParse(ini, manifest), "parse manifest");
+        TEST_LOG_FMT("parsed %u files in %" PRIu64 "ms", fileTotal, timeMSec() - timeBegin);
+
+        // Get every file (an error is thrown if a file is missing)
+        const String *section = strNew("target:file");
+        timeBegin = timeMSec();
+
+        for (unsigned int fileIdx = 0; fileIdx < fileTotal; fileIdx++)
+        {
+            String *key = strNewFmt("pg_data/base/16384/%u", 16384 + fileIdx);
+            iniGet(ini, section, key);
+            strFree(key);
+        }
+
+        TEST_LOG_FMT("got %u files in %" PRIu64 "ms", fileTotal, timeMSec() - timeBegin);
+
+        TEST_RESULT_UINT(strLstSize(iniSectionKeyList(ini, strNew("target:file"))), fileTotal, "check file total");
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("memNew(), memGrowRaw(), and memFree() churn in a context with many allocations"))
+    {
+        // Allocate enough buffers that a linear search for the allocation on free or resize would take minutes
+        unsigned int allocTotal = 1000000;
+        unsigned int churnTotal = 1000000;
+        void **bufferList = NULL;
+
+        MemContext *memContext = memContextNew("churn");
+
+        MEM_CONTEXT_BEGIN(memContext)
+        {
+            bufferList = memNew(sizeof(void *) * allocTotal);
+            TimeMSec timeBegin = timeMSec();
+
+            for (unsigned int allocIdx = 0; allocIdx < allocTotal; allocIdx++)
+                bufferList[allocIdx] = memNew(16);
+
+            TEST_LOG_FMT("allocated %u buffers in %" PRIu64 "ms", allocTotal, timeMSec() - timeBegin);
+
+            // Free, grow, and allocate buffers scattered through the list.  The stride is prime so every buffer is visited before
+            // any is visited twice.
+            timeBegin = timeMSec();
+            unsigned int allocIdx = 0;
+
+            for (unsigned int churnIdx = 0; churnIdx < churnTotal; churnIdx++)
+            {
+                allocIdx = (allocIdx + 7919) % allocTotal;
+
+                memFree(bufferList[allocIdx]);
+                bufferList[allocIdx] = memNew(16);
+                bufferList[allocIdx] = memGrowRaw(bufferList[allocIdx], 32);
+            }
+
+            TEST_LOG_FMT("churned %u buffers in %" PRIu64 "ms", churnTotal, timeMSec() - timeBegin);
+
+            // Free all buffers in the reverse order they were allocated
+            timeBegin = timeMSec();
+
+            for (unsigned int freeIdx = allocTotal; freeIdx > 0; freeIdx--)
+                memFree(bufferList[freeIdx - 1]);
+
+            TEST_LOG_FMT("freed %u buffers in %" PRIu64 "ms", allocTotal, timeMSec() - timeBegin);
+        }
+        MEM_CONTEXT_END();
+
+        TEST_RESULT_VOID(memContextFree(memContext), "free context");
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("MEM_CONTEXT_TEMP_RESET_BEGIN() with and without an arena"))
+    {
+        // Simulate the temporary allocations made for each file while listing a path
+        unsigned int fileTotal = 1000000;
+        TimeMSec timeBegin = timeMSec();
+
+        MEM_CONTEXT_TEMP_RESET_BEGIN()
+        {
+            for (unsigned int fileIdx = 0; fileIdx < fileTotal; fileIdx++)
+            {
+                String *file = strNewFmt("pg_data/base/16384/%u", fileIdx);
+                varNewStr(strNewFmt("%s.1", strPtr(file)));
+
+                MEM_CONTEXT_TEMP_RESET(1000);
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+
+        TEST_LOG_FMT("standard context processed %u files in %" PRIu64 "ms", fileTotal, timeMSec() - timeBegin);
+
+        timeBegin = timeMSec();
+
+        MEM_CONTEXT_TEMP_RESET_ARENA_BEGIN()
+        {
+            for (unsigned int fileIdx = 0; fileIdx < fileTotal; fileIdx++)
+            {
+                String *file = strNewFmt("pg_data/base/16384/%u", fileIdx);
+                varNewStr(strNewFmt("%s.1", strPtr(file)));
+
+                MEM_CONTEXT_TEMP_RESET(1000);
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+
+        TEST_LOG_FMT("arena context processed %u files in %" PRIu64 "ms", fileTotal, timeMSec() - timeBegin);
+    }
+
+    FUNCTION_HARNESS_RESULT_VOID();
+}
@@ -42,7 +42,7 @@ testRun(void)
     }
 
     // *****************************************************************************************************************************
-    if (testBegin("pageChecksumTest() and pageLsn()"))
+    if (testBegin("pageChecksumTest(), pageLsn(), and pageNew()"))
     {
         // Zero the pages
         memset(testPage(0), 0, TEST_PAGE_TOTAL * TEST_PAGE_SIZE);
@@ -50,11 +50,13 @@ testRun(void)
         // Pages with pd_upper = 0 should always return true no matter the block no
         TEST_RESULT_BOOL(pageChecksumTest(testPage(0), 0, TEST_PAGE_SIZE, 0, 0), true, "pd_upper is 0, block 0");
         TEST_RESULT_BOOL(pageChecksumTest(testPage(1), 999, TEST_PAGE_SIZE, 0, 0), true, "pd_upper is 0, block 999");
+        TEST_RESULT_BOOL(pageNew(testPage(0)), true, "pd_upper is 0, new page");
 
         // Partial pages are always invalid
         ((PageHeader)testPage(0))->pd_upper = 0x00FF;
         ((PageHeader)testPage(0))->pd_checksum = pageChecksum(testPage(0), 0, TEST_PAGE_SIZE);
         TEST_RESULT_BOOL(pageChecksumTest(testPage(0), 0, TEST_PAGE_SIZE, 1, 1), true, "valid page");
+        TEST_RESULT_BOOL(pageNew(testPage(0)), false, "pd_upper is not 0, not a new page");
         TEST_RESULT_BOOL(pageChecksumTest(testPage(0), 0, TEST_PAGE_SIZE / 2, 1, 1), false, "invalid partial page");
 
         // Update pd_upper and check for failure no matter the block no
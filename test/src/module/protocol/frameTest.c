@@ -0,0 +1,162 @@
+/***********************************************************************************************************************************
+Test Protocol Binary Frame
+***********************************************************************************************************************************/
+#include "common/io/bufferRead.h"
+#include "common/io/bufferWrite.h"
+#include "common/type/json.h"
+
+/***********************************************************************************************************************************
+Test Run
+***********************************************************************************************************************************/
+void
+testRun(void)
+{
+    FUNCTION_HARNESS_VOID();
+
+    // *****************************************************************************************************************************
+    if (testBegin("protocolFramePut() and protocolFrameGet()"))
+    {
+        Buffer *frame = NULL;
+        size_t position = 4;
+
+        TEST_ASSIGN(frame, protocolFrameNew(), "new frame");
+        TEST_RESULT_SIZE(bufUsed(frame), 4, "    header is reserved");
+
+        TEST_RESULT_VOID(protocolFramePut(frame, NULL), "put null");
+        TEST_RESULT_VOID(protocolFramePut(frame, BOOL_TRUE_VAR), "put bool");
+        TEST_RESULT_VOID(protocolFramePut(frame, VARINT(-1)), "put negative int");
+        TEST_RESULT_VOID(protocolFramePut(frame, VARINT(1)), "put positive int");
+        TEST_RESULT_VOID(protocolFramePut(frame, VARINT64(-5000000000)), "put negative int64");
+        TEST_RESULT_VOID(protocolFramePut(frame, VARUINT(77)), "put uint");
+        TEST_RESULT_VOID(protocolFramePut(frame, VARUINT64(UINT64_MAX)), "put uint64");
+        TEST_RESULT_VOID(protocolFramePut(frame, VARSTRDEF("a \"string\"\nwith\\escapes")), "put string");
+        TEST_RESULT_VOID(protocolFramePut(frame, VARSTRDEF("")), "put empty string");
+        TEST_RESULT_VOID(protocolFramePut(frame, VARSTR(NULL)), "put null string");
+        TEST_RESULT_VOID(protocolFramePut(frame, varNewVarLst(NULL)), "put null list");
+
+        VariantList *list = varLstNew();
+        varLstAdd(list, varNewStrZ("value1"));
+        varLstAdd(list, NULL);
+        varLstAdd(list, varNewBool(false));
+
+        TEST_RESULT_VOID(protocolFramePut(frame, varNewVarLst(list)), "put list");
+
+        KeyValue *kv = kvNew();
+        kvPut(kv, VARSTRDEF("key1"), VARUINT(1));
+        kvPut(kv, VARUINT(2), varNewVarLst(list));
+        kvPutKv(kv, VARSTRDEF("key3"));
+
+        TEST_RESULT_VOID(protocolFramePut(frame, varNewKv(kv)), "put kv");
+        TEST_ERROR(protocolFramePut(frame, varNewDbl(1.1)), AssertError, "unable to encode double in frame");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_PTR(protocolFrameGet(frame, &position), NULL, "get null");
+        TEST_RESULT_BOOL(varBool(protocolFrameGet(frame, &position)), true, "get bool");
+        TEST_RESULT_INT(varInt64(protocolFrameGet(frame, &position)), -1, "get negative int as int64");
+        TEST_RESULT_UINT(varUInt64(protocolFrameGet(frame, &position)), 1, "get positive int as uint64");
+        TEST_RESULT_INT(varInt64(protocolFrameGet(frame, &position)), -5000000000, "get negative int64");
+        TEST_RESULT_UINT(varUInt64(protocolFrameGet(frame, &position)), 77, "get uint as uint64");
+        TEST_RESULT_UINT(varUInt64(protocolFrameGet(frame, &position)), UINT64_MAX, "get uint64");
+        TEST_RESULT_STR(strPtr(varStr(protocolFrameGet(frame, &position))), "a \"string\"\nwith\\escapes", "get string");
+        TEST_RESULT_STR(strPtr(varStr(protocolFrameGet(frame, &position))), "", "get empty string");
+        TEST_RESULT_PTR(protocolFrameGet(frame, &position), NULL, "get null string");
+        TEST_RESULT_PTR(protocolFrameGet(frame, &position), NULL, "get null list");
+        TEST_RESULT_STR(
+            strPtr(jsonFromVar(protocolFrameGet(frame, &position), 0)), "[\"value1\",null,false]", "get list");
+        TEST_RESULT_STR(
+            strPtr(jsonFromVar(protocolFrameGet(frame, &position), 0)),
+            "{\"2\":[\"value1\",null,false],\"key1\":1,\"key3\":{}}", "get kv");
+        TEST_RESULT_SIZE(position, bufUsed(frame), "end of frame");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_ERROR(protocolFrameGet(frame, &position), ProtocolError, "frame is truncated at position 165");
+
+        position = 0;
+        TEST_ERROR(protocolFrameGet(BUFSTRDEF("\x07"), &position), ProtocolError, "invalid frame value type 7 at position 0");
+
+        position = 0;
+        TEST_ERROR(
+            protocolFrameGet(BUFSTRDEF("\x04\x00\x00\x00\x05" "abc"), &position), ProtocolError,
+            "frame is truncated at position 5");
+
+        // Grow a frame by doubling the size
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_ASSIGN(frame, protocolFrameNew(), "new frame");
+
+        for (unsigned int boolIdx = 0; boolIdx < 200; boolIdx++)
+            protocolFramePut(frame, BOOL_FALSE_VAR);
+
+        TEST_RESULT_SIZE(bufSize(frame), 512, "    check size doubled");
+
+        // Grow a frame past double the size in one value
+        // -------------------------------------------------------------------------------------------------------------------------
+        String *large = strNew("");
+
+        for (unsigned int largeIdx = 0; largeIdx < 1024; largeIdx++)
+            strCat(large, "X");
+
+        TEST_ASSIGN(frame, protocolFrameNew(), "new frame");
+        TEST_RESULT_VOID(protocolFramePut(frame, VARSTR(large)), "put large string");
+        TEST_RESULT_SIZE(bufUsed(frame), 4 + 1 + 4 + 1024, "    check size");
+
+        position = 4;
+        TEST_RESULT_UINT(strSize(varStr(protocolFrameGet(frame, &position))), 1024, "get large string");
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("protocolFrameRead(), protocolFrameWrite(), protocolFrameBlockRead(), and protocolFrameBlockWrite()"))
+    {
+        Buffer *buffer = bufNew(0);
+        IoWrite *write = ioBufferWriteNew(buffer);
+        ioWriteOpen(write);
+
+        Buffer *frame = protocolFrameNew();
+        protocolFramePut(frame, VARSTRDEF("test"));
+
+        TEST_RESULT_VOID(protocolFrameWrite(write, frame), "write frame");
+        TEST_RESULT_VOID(protocolFrameWrite(write, protocolFrameNew()), "write empty frame");
+        TEST_RESULT_VOID(protocolFrameBlockWrite(write, 3), "write block header");
+        TEST_RESULT_VOID(ioWrite(write, BUFSTRDEF("ABC")), "write block");
+        TEST_RESULT_VOID(protocolFrameBlockWrite(write, 0), "write end block header");
+        TEST_RESULT_VOID(protocolFrameBlockWrite(write, -1), "write abort block header");
+        TEST_RESULT_VOID(ioWriteClose(write), "close write");
+
+        TEST_RESULT_STR(
+            strPtr(bufHex(buffer)), "00000009040000000474657374000000000000000341424300000000ffffffff", "check frames");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        IoRead *read = ioBufferReadNew(buffer);
+        ioReadOpen(read);
+
+        size_t position = 0;
+
+        TEST_ASSIGN(frame, protocolFrameRead(read), "read frame");
+        TEST_RESULT_STR(strPtr(varStr(protocolFrameGet(frame, &position))), "test", "    check value");
+        TEST_RESULT_SIZE(position, bufUsed(frame), "    check end of frame");
+        TEST_RESULT_SIZE(bufUsed(protocolFrameRead(read)), 0, "read empty frame");
+        TEST_RESULT_INT(protocolFrameBlockRead(read), 3, "read block header");
+
+        Buffer *block = bufNew(3);
+        TEST_RESULT_SIZE(ioRead(read, block), 3, "read block");
+        TEST_RESULT_STR(strPtr(strNewBuf(block)), "ABC", "    check block");
+
+        TEST_RESULT_INT(protocolFrameBlockRead(read), 0, "read end block header");
+        TEST_RESULT_INT(protocolFrameBlockRead(read), -1, "read abort block header");
+
+        TEST_ERROR(protocolFrameRead(read), ProtocolError, "unexpected eof while reading frame header");
+        TEST_ERROR(protocolFrameBlockRead(read), ProtocolError, "unexpected eof while reading block header");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        read = ioBufferReadNew(BUFSTRDEF("\x00\x00\x00\x05" "abc"));
+        ioReadOpen(read);
+
+        TEST_ERROR(protocolFrameRead(read), ProtocolError, "unexpected eof while reading 5 byte frame");
+
+        read = ioBufferReadNew(BUFSTRDEF("\xff\xff\xff\xfe"));
+        ioReadOpen(read);
+
+        TEST_ERROR(protocolFrameBlockRead(read), ProtocolError, "'-2' is not a valid block size");
+    }
+
+    FUNCTION_HARNESS_RESULT_VOID();
+}
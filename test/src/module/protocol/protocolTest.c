@@ -310,11 +310,27 @@ testRun(void)
         TEST_RESULT_STR(
             strPtr(protocolCommandJson(command)), "{\"cmd\":\"command1\",\"param\":[\"param1\",\"param2\"]}", "check json");
 
+        Buffer *frame = NULL;
+        size_t position = 4;
+
+        TEST_ASSIGN(frame, protocolCommandFrame(command), "get frame");
+        TEST_RESULT_STR(strPtr(varStr(protocolFrameGet(frame, &position))), "command1", "    check command");
+        TEST_RESULT_STR(
+            strPtr(strLstJoin(strLstNewVarLst(varVarLst(protocolFrameGet(frame, &position))), ",")), "param1,param2",
+            "    check params");
+        TEST_RESULT_SIZE(position, bufUsed(frame), "    check end of frame");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_ASSIGN(command, protocolCommandNew(strNew("command2")), "create command");
         TEST_RESULT_STR(strPtr(protocolCommandToLog(command)), "{command: command2}", "check log");
         TEST_RESULT_STR(strPtr(protocolCommandJson(command)), "{\"cmd\":\"command2\"}", "check json");
 
+        position = 4;
+
+        TEST_ASSIGN(frame, protocolCommandFrame(command), "get frame");
+        TEST_RESULT_STR(strPtr(varStr(protocolFrameGet(frame, &position))), "command2", "    check command");
+        TEST_RESULT_PTR(protocolFrameGet(frame, &position), NULL, "    check null params");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_RESULT_VOID(protocolCommandFree(command), "free command");
     }
@@ -374,6 +390,54 @@ testRun(void)
 
                 // Wait for exit
                 TEST_RESULT_STR(strPtr(ioReadLine(read)), "{\"cmd\":\"exit\"}", "exit command");
+
+                // Greeting that advertises binary frames
+                ioWriteStrLine(
+                    write,
+                    strNew("{\"binary\":true,\"name\":\"pgBackRest\",\"service\":\"test\",\"version\":\"" PROJECT_VERSION "\"}"));
+                ioWriteFlush(write);
+
+                TEST_RESULT_STR(strPtr(ioReadLine(read)), "{\"cmd\":\"noop\"}", "noop");
+                ioWriteStrLine(write, strNew("{}"));
+                ioWriteFlush(write);
+
+                TEST_RESULT_STR(strPtr(ioReadLine(read)), "{\"cmd\":\"binary\"}", "binary");
+                ioWriteStrLine(write, strNew("{}"));
+                ioWriteFlush(write);
+
+                // Send output
+                Buffer *frame = NULL;
+                size_t position = 0;
+
+                TEST_ASSIGN(frame, protocolFrameRead(read), "read test command");
+                TEST_RESULT_STR(strPtr(varStr(protocolFrameGet(frame, &position))), "test", "    check command");
+                TEST_RESULT_UINT(
+                    varUInt64(varLstGet(varVarLst(protocolFrameGet(frame, &position)), 0)), 77, "    check param");
+
+                frame = protocolFrameNew();
+                protocolFramePut(frame, NULL);
+                protocolFramePut(frame, varNewStrZ("value1"));
+                protocolFrameWrite(write, frame);
+                ioWriteFlush(write);
+
+                // Throw errors
+                position = 0;
+
+                TEST_ASSIGN(frame, protocolFrameRead(read), "read noop");
+                TEST_RESULT_STR(strPtr(varStr(protocolFrameGet(frame, &position))), "noop", "    check command");
+
+                frame = protocolFrameNew();
+                protocolFramePut(frame, VARINT(25));
+                protocolFramePut(frame, VARSTRDEF("sample error message"));
+                protocolFramePut(frame, VARSTRDEF("stack data"));
+                protocolFrameWrite(write, frame);
+                ioWriteFlush(write);
+
+                // Wait for exit
+                position = 0;
+
+                TEST_ASSIGN(frame, protocolFrameRead(read), "read exit");
+                TEST_RESULT_STR(strPtr(varStr(protocolFrameGet(frame, &position))), "exit", "    check command");
             }
             HARNESS_FORK_CHILD_END();
 
@@ -420,6 +484,7 @@ testRun(void)
 
                 TEST_RESULT_PTR(protocolClientIoRead(client), client->read, "get read io");
                 TEST_RESULT_PTR(protocolClientIoWrite(client), client->write, "get write io");
+                TEST_RESULT_BOOL(protocolClientBinary(client), false, "binary frames not advertised");
 
                 // Throw errors
                 TEST_ERROR(
@@ -448,6 +513,23 @@ testRun(void)
 
                 // Free client
                 TEST_RESULT_VOID(protocolClientFree(client), "free client");
+
+                // Binary frames
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_ASSIGN(client, protocolClientNew(strNew("test client"), strNew("test"), read, write), "create binary client");
+                TEST_RESULT_BOOL(protocolClientBinary(client), true, "binary frames negotiated");
+
+                TEST_RESULT_STR(
+                    strPtr(
+                        varStr(
+                            protocolClientExecute(
+                                client, protocolCommandParamAdd(protocolCommandNew(strNew("test")), VARUINT(77)), true))),
+                    "value1", "execute command with output");
+
+                TEST_ERROR(
+                    protocolClientNoOp(client), AssertError, "raised from test client: sample error message\nstack data");
+
+                TEST_RESULT_VOID(protocolClientFree(client), "free client");
             }
             HARNESS_FORK_PARENT_END();
         }
@@ -468,7 +550,8 @@ testRun(void)
 
                 // Check greeting
                 TEST_RESULT_STR(
-                    strPtr(ioReadLine(read)), "{\"name\":\"pgBackRest\",\"service\":\"test\",\"version\":\"" PROJECT_VERSION "\"}",
+                    strPtr(ioReadLine(read)),
+                    "{\"binary\":true,\"name\":\"pgBackRest\",\"service\":\"test\",\"version\":\"" PROJECT_VERSION "\"}",
                     "check greeting");
 
                 // Noop
@@ -505,8 +588,37 @@ testRun(void)
                 TEST_RESULT_STR(strPtr(ioReadLine(read)), "{\"out\":false}", "complex request result");
                 TEST_RESULT_STR(strPtr(ioReadLine(read)), "LINEOFTEXT", "complex request result");
 
+                // Switch to binary frames
+                TEST_RESULT_VOID(ioWriteStrLine(write, strNew("{\"cmd\":\"binary\"}")), "write binary");
+                TEST_RESULT_VOID(ioWriteFlush(write), "flush binary");
+                TEST_RESULT_STR(strPtr(ioReadLine(read)), "{}", "binary result");
+
+                // Simple request
+                Buffer *frame = NULL;
+                size_t position = 0;
+
+                TEST_RESULT_VOID(
+                    protocolFrameWrite(write, protocolCommandFrame(protocolCommandNew(strNew("request-simple")))),
+                    "write simple request");
+                TEST_RESULT_VOID(ioWriteFlush(write), "flush simple request");
+                TEST_ASSIGN(frame, protocolFrameRead(read), "read simple request result");
+                TEST_RESULT_PTR(protocolFrameGet(frame, &position), NULL, "    check no error");
+                TEST_RESULT_BOOL(varBool(protocolFrameGet(frame, &position)), true, "    check output");
+
+                // Invalid command
+                position = 0;
+
+                TEST_RESULT_VOID(
+                    protocolFrameWrite(write, protocolCommandFrame(protocolCommandNew(strNew("bogus")))), "write bogus");
+                TEST_RESULT_VOID(ioWriteFlush(write), "flush bogus");
+                TEST_ASSIGN(frame, protocolFrameRead(read), "read error result");
+                TEST_RESULT_UINT(varUInt64(protocolFrameGet(frame, &position)), 39, "    check code");
+                TEST_RESULT_STR(strPtr(varStr(protocolFrameGet(frame, &position))), "invalid command 'bogus'", "    check message");
+                TEST_RESULT_BOOL(protocolFrameGet(frame, &position) != NULL, true, "    check stack exists");
+
                 // Exit
-                TEST_RESULT_VOID(ioWriteStrLine(write, strNew("{\"cmd\":\"exit\"}")), "write exit");
+                TEST_RESULT_VOID(
+                    protocolFrameWrite(write, protocolCommandFrame(protocolCommandNew(strNew("exit")))), "write exit");
                 TEST_RESULT_VOID(ioWriteFlush(write), "flush exit");
             }
             HARNESS_FORK_CHILD_END();
@@ -537,7 +649,9 @@ testRun(void)
 
                 TEST_RESULT_VOID(protocolServerHandlerAdd(server, testServerProtocol), "add handler");
 
+                TEST_RESULT_BOOL(protocolServerBinary(server), false, "binary frames not negotiated");
                 TEST_RESULT_VOID(protocolServerProcess(server), "run process loop");
+                TEST_RESULT_BOOL(protocolServerBinary(server), true, "binary frames negotiated");
 
                 TEST_RESULT_VOID(protocolServerFree(server), "free server");
             }
@@ -633,8 +747,9 @@ testRun(void)
             HARNESS_FORK_PARENT_BEGIN()
             {
                 // -----------------------------------------------------------------------------------------------------------------
+                // The pipeline allows two jobs per client but the last job is not queued behind the slow job on the first client
                 ProtocolParallel *parallel = NULL;
-                TEST_ASSIGN(parallel, protocolParallelNew(2000), "create parallel");
+                TEST_ASSIGN(parallel, protocolParallelNew(2000, 2), "create parallel");
                 TEST_RESULT_STR(
                     strPtr(protocolParallelToLog(parallel)), "{state: pending, clientTotal: 0, jobTotal: 0}", "check log");
 
@@ -732,6 +847,8 @@ testRun(void)
                 TEST_RESULT_INT(varIntForce(protocolParallelJobResult(job)), 1, "check result is 1");
 
                 TEST_RESULT_BOOL(protocolParallelDone(parallel), true, "check done");
+                TEST_RESULT_STR(
+                    strPtr(protocolParallelToLog(parallel)), "{state: done, clientTotal: 2, jobTotal: 0}", "check log");
 
                 // Free client
                 for (unsigned int clientIdx = 0; clientIdx < clientTotal; clientIdx++)
@@ -743,6 +860,222 @@ testRun(void)
             HARNESS_FORK_PARENT_END();
         }
         HARNESS_FORK_END();
+
+        // Pipeline jobs on a single client
+        // -------------------------------------------------------------------------------------------------------------------------
+        HARNESS_FORK_BEGIN()
+        {
+            HARNESS_FORK_CHILD_BEGIN(0, true)
+            {
+                IoRead *read = ioHandleReadNew(strNew("server read"), HARNESS_FORK_CHILD_READ(), 10000);
+                ioReadOpen(read);
+                IoWrite *write = ioHandleWriteNew(strNew("server write"), HARNESS_FORK_CHILD_WRITE());
+                ioWriteOpen(write);
+
+                // Greeting with noop
+                ioWriteStrLine(write, strNew("{\"name\":\"pgBackRest\",\"service\":\"test\",\"version\":\"" PROJECT_VERSION "\"}"));
+                ioWriteFlush(write);
+
+                TEST_RESULT_STR(strPtr(ioReadLine(read)), "{\"cmd\":\"noop\"}", "noop");
+                ioWriteStrLine(write, strNew("{}"));
+                ioWriteFlush(write);
+
+                // All commands are queued before any result is sent
+                TEST_RESULT_STR(strPtr(ioReadLine(read)), "{\"cmd\":\"command1\"}", "command1");
+                TEST_RESULT_STR(strPtr(ioReadLine(read)), "{\"cmd\":\"command2\"}", "command2");
+                TEST_RESULT_STR(strPtr(ioReadLine(read)), "{\"cmd\":\"command3\"}", "command3");
+
+                // Send two results together so the second is buffered when the first is read
+                ioWriteStrLine(write, strNew("{\"out\":1}"));
+                ioWriteStrLine(write, strNew("{\"err\":39,\"out\":\"very serious error\"}"));
+                ioWriteFlush(write);
+
+                sleepMSec(250);
+                ioWriteStrLine(write, strNew("{\"out\":3}"));
+                ioWriteFlush(write);
+
+                // Wait for exit
+                TEST_RESULT_STR(strPtr(ioReadLine(read)), "{\"cmd\":\"exit\"}", "exit command");
+            }
+            HARNESS_FORK_CHILD_END();
+
+            HARNESS_FORK_PARENT_BEGIN()
+            {
+                ProtocolParallel *parallel = NULL;
+                TEST_ASSIGN(parallel, protocolParallelNew(2000, 3), "create parallel");
+
+                IoRead *read = ioHandleReadNew(strNew("client read"), HARNESS_FORK_PARENT_READ_PROCESS(0), 2000);
+                ioReadOpen(read);
+                IoWrite *write = ioHandleWriteNew(strNew("client write"), HARNESS_FORK_PARENT_WRITE_PROCESS(0));
+                ioWriteOpen(write);
+
+                ProtocolClient *client = NULL;
+                TEST_ASSIGN(client, protocolClientNew(strNew("test client"), strNew("test"), read, write), "create client");
+                TEST_RESULT_VOID(protocolParallelClientAdd(parallel, client), "add client");
+
+                for (unsigned int jobIdx = 1; jobIdx <= 3; jobIdx++)
+                {
+                    TEST_RESULT_VOID(
+                        protocolParallelJobAdd(
+                            parallel,
+                            protocolParallelJobNew(
+                                varNewStr(strNewFmt("job%u", jobIdx)), protocolCommandNew(strNewFmt("command%u", jobIdx)))),
+                        "add job %u", jobIdx);
+                }
+
+                // All jobs are started on the client
+                TEST_RESULT_INT(protocolParallelProcess(parallel), 0, "process jobs");
+                TEST_RESULT_STR(
+                    strPtr(protocolParallelToLog(parallel)), "{state: running, clientTotal: 1, jobTotal: 3}", "check log");
+
+                // Two results are read in one pass
+                TEST_RESULT_INT(protocolParallelProcess(parallel), 2, "process jobs");
+                TEST_RESULT_BOOL(protocolClientReadReady(client), false, "no results buffered");
+
+                TEST_ASSIGN(job, protocolParallelResult(parallel), "get result");
+                TEST_RESULT_STR(strPtr(varStr(protocolParallelJobKey(job))), "job1", "check key is job1");
+                TEST_RESULT_INT(varIntForce(protocolParallelJobResult(job)), 1, "check result is 1");
+
+                TEST_ASSIGN(job, protocolParallelResult(parallel), "get result");
+                TEST_RESULT_STR(strPtr(varStr(protocolParallelJobKey(job))), "job2", "check key is job2");
+                TEST_RESULT_INT(protocolParallelJobErrorCode(job), 39, "check error code");
+
+                TEST_RESULT_PTR(protocolParallelResult(parallel), NULL, "check no more results");
+
+                TEST_RESULT_INT(protocolParallelProcess(parallel), 1, "process jobs");
+
+                TEST_ASSIGN(job, protocolParallelResult(parallel), "get result");
+                TEST_RESULT_STR(strPtr(varStr(protocolParallelJobKey(job))), "job3", "check key is job3");
+                TEST_RESULT_INT(varIntForce(protocolParallelJobResult(job)), 3, "check result is 3");
+
+                TEST_RESULT_BOOL(protocolParallelDone(parallel), true, "check done");
+
+                TEST_RESULT_VOID(protocolClientFree(client), "free client");
+                TEST_RESULT_VOID(protocolParallelFree(parallel), "free parallel");
+            }
+            HARNESS_FORK_PARENT_END();
+        }
+        HARNESS_FORK_END();
+
+        // Pipeline jobs on a single client with binary frames
+        // -------------------------------------------------------------------------------------------------------------------------
+        HARNESS_FORK_BEGIN()
+        {
+            HARNESS_FORK_CHILD_BEGIN(0, true)
+            {
+                IoRead *read = ioHandleReadNew(strNew("server read"), HARNESS_FORK_CHILD_READ(), 10000);
+                ioReadOpen(read);
+                IoWrite *write = ioHandleWriteNew(strNew("server write"), HARNESS_FORK_CHILD_WRITE());
+                ioWriteOpen(write);
+
+                // Greeting with noop and switch to binary frames
+                ioWriteStrLine(
+                    write,
+                    strNew("{\"binary\":true,\"name\":\"pgBackRest\",\"service\":\"test\",\"version\":\"" PROJECT_VERSION "\"}"));
+                ioWriteFlush(write);
+
+                TEST_RESULT_STR(strPtr(ioReadLine(read)), "{\"cmd\":\"noop\"}", "noop");
+                ioWriteStrLine(write, strNew("{}"));
+                ioWriteFlush(write);
+
+                TEST_RESULT_STR(strPtr(ioReadLine(read)), "{\"cmd\":\"binary\"}", "binary");
+                ioWriteStrLine(write, strNew("{}"));
+                ioWriteFlush(write);
+
+                // All commands are queued before any result is sent
+                for (unsigned int jobIdx = 1; jobIdx <= 3; jobIdx++)
+                {
+                    size_t position = 0;
+
+                    TEST_RESULT_STR(
+                        strPtr(varStr(protocolFrameGet(protocolFrameRead(read), &position))),
+                        strPtr(strNewFmt("command%u", jobIdx)), "command%u", jobIdx);
+                }
+
+                // Send two results together so the second is in the pipe when the first is read
+                Buffer *frame = protocolFrameNew();
+                protocolFramePut(frame, NULL);
+                protocolFramePut(frame, VARINT(1));
+                protocolFrameWrite(write, frame);
+
+                frame = protocolFrameNew();
+                protocolFramePut(frame, VARINT(39));
+                protocolFramePut(frame, VARSTRDEF("very serious error"));
+                protocolFramePut(frame, VARSTRDEF("stack data"));
+                protocolFrameWrite(write, frame);
+                ioWriteFlush(write);
+
+                sleepMSec(250);
+
+                frame = protocolFrameNew();
+                protocolFramePut(frame, NULL);
+                protocolFramePut(frame, VARINT(3));
+                protocolFrameWrite(write, frame);
+                ioWriteFlush(write);
+
+                // Wait for exit
+                size_t position = 0;
+                TEST_RESULT_STR(strPtr(varStr(protocolFrameGet(protocolFrameRead(read), &position))), "exit", "exit command");
+            }
+            HARNESS_FORK_CHILD_END();
+
+            HARNESS_FORK_PARENT_BEGIN()
+            {
+                ProtocolParallel *parallel = NULL;
+                TEST_ASSIGN(parallel, protocolParallelNew(2000, 3), "create parallel");
+
+                IoRead *read = ioHandleReadNew(strNew("client read"), HARNESS_FORK_PARENT_READ_PROCESS(0), 2000);
+                ioReadOpen(read);
+                IoWrite *write = ioHandleWriteNew(strNew("client write"), HARNESS_FORK_PARENT_WRITE_PROCESS(0));
+                ioWriteOpen(write);
+
+                ProtocolClient *client = NULL;
+                TEST_ASSIGN(client, protocolClientNew(strNew("test client"), strNew("test"), read, write), "create client");
+                TEST_RESULT_BOOL(protocolClientBinary(client), true, "binary frames negotiated");
+                TEST_RESULT_VOID(protocolParallelClientAdd(parallel, client), "add client");
+
+                for (unsigned int jobIdx = 1; jobIdx <= 3; jobIdx++)
+                {
+                    TEST_RESULT_VOID(
+                        protocolParallelJobAdd(
+                            parallel,
+                            protocolParallelJobNew(
+                                varNewStr(strNewFmt("job%u", jobIdx)), protocolCommandNew(strNewFmt("command%u", jobIdx)))),
+                        "add job %u", jobIdx);
+                }
+
+                // All jobs are started on the client
+                TEST_RESULT_INT(protocolParallelProcess(parallel), 0, "process jobs");
+
+                // Frames are read with their exact size so the second result is left in the pipe and reported by the next wait
+                TEST_RESULT_INT(protocolParallelProcess(parallel), 1, "process jobs");
+                TEST_RESULT_BOOL(protocolClientReadReady(client), false, "no results buffered");
+                TEST_RESULT_INT(protocolParallelProcess(parallel), 1, "process jobs");
+
+                TEST_ASSIGN(job, protocolParallelResult(parallel), "get result");
+                TEST_RESULT_STR(strPtr(varStr(protocolParallelJobKey(job))), "job1", "check key is job1");
+                TEST_RESULT_INT(varIntForce(protocolParallelJobResult(job)), 1, "check result is 1");
+
+                TEST_ASSIGN(job, protocolParallelResult(parallel), "get result");
+                TEST_RESULT_STR(strPtr(varStr(protocolParallelJobKey(job))), "job2", "check key is job2");
+                TEST_RESULT_INT(protocolParallelJobErrorCode(job), 39, "check error code");
+
+                TEST_RESULT_PTR(protocolParallelResult(parallel), NULL, "check no more results");
+
+                TEST_RESULT_INT(protocolParallelProcess(parallel), 1, "process jobs");
+
+                TEST_ASSIGN(job, protocolParallelResult(parallel), "get result");
+                TEST_RESULT_STR(strPtr(varStr(protocolParallelJobKey(job))), "job3", "check key is job3");
+                TEST_RESULT_INT(varIntForce(protocolParallelJobResult(job)), 3, "check result is 3");
+
+                TEST_RESULT_BOOL(protocolParallelDone(parallel), true, "check done");
+
+                TEST_RESULT_VOID(protocolClientFree(client), "free client");
+                TEST_RESULT_VOID(protocolParallelFree(parallel), "free parallel");
+            }
+            HARNESS_FORK_PARENT_END();
+        }
+        HARNESS_FORK_END();
     }
 
     // *****************************************************************************************************************************
@@ -861,5 +1194,88 @@ testRun(void)
         TEST_RESULT_VOID(protocolFree(), "free local and remote protocol objects");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("JSON and binary frame performance"))
+    {
+        // Enough messages to measure without slowing down the test run
+        const unsigned int messageTotal = 10000;
+
+        HARNESS_FORK_BEGIN()
+        {
+            HARNESS_FORK_CHILD_BEGIN(0, true)
+            {
+                IoRead *read = ioHandleReadNew(strNew("server read"), HARNESS_FORK_CHILD_READ(), 10000);
+                ioReadOpen(read);
+                IoWrite *write = ioHandleWriteNew(strNew("server write"), HARNESS_FORK_CHILD_WRITE());
+                ioWriteOpen(write);
+
+                // Send the greeting of the JSON server to a buffer and replace it with one that does not advertise binary frames
+                IoWrite *greetingWrite = ioBufferWriteNew(bufNew(0));
+                ioWriteOpen(greetingWrite);
+
+                ProtocolServer *server = protocolServerNew(strNew("json server"), strNew("test"), read, greetingWrite);
+                server->write = write;
+
+                ioWriteStrLine(write, strNew("{\"name\":\"pgBackRest\",\"service\":\"test\",\"version\":\"" PROJECT_VERSION "\"}"));
+                ioWriteFlush(write);
+
+                protocolServerHandlerAdd(server, testServerProtocol);
+                protocolServerProcess(server);
+
+                // Binary frames are negotiated by default
+                server = protocolServerNew(strNew("binary server"), strNew("test"), read, write);
+                protocolServerHandlerAdd(server, testServerProtocol);
+                protocolServerProcess(server);
+            }
+            HARNESS_FORK_CHILD_END();
+
+            HARNESS_FORK_PARENT_BEGIN()
+            {
+                IoRead *read = ioHandleReadNew(strNew("client read"), HARNESS_FORK_PARENT_READ_PROCESS(0), 10000);
+                ioReadOpen(read);
+                IoWrite *write = ioHandleWriteNew(strNew("client write"), HARNESS_FORK_PARENT_WRITE_PROCESS(0));
+                ioWriteOpen(write);
+
+                // Parameters similar to a typical storage command
+                ProtocolCommand *command = protocolCommandNew(strNew("request-simple"));
+                protocolCommandParamAdd(
+                    command, VARSTRDEF("archive/db/9.6-1/0000000100000001/000000010000000100000001-0ad6de8d0eb9b5a2f4e1b9d2c3.gz"));
+                protocolCommandParamAdd(command, BOOL_TRUE_VAR);
+                protocolCommandParamAdd(command, VARUINT64(16777216));
+
+                for (unsigned int binary = 0; binary <= 1; binary++)
+                {
+                    const char *name = binary ? "binary" : "json";
+                    ProtocolClient *client = NULL;
+
+                    TEST_ASSIGN(
+                        client, protocolClientNew(strNewFmt("%s client", name), strNew("test"), read, write), "create client");
+                    TEST_RESULT_BOOL(protocolClientBinary(client), binary, "    check binary frames");
+
+                    TimeUSec timeBegin = timeUSec();
+
+                    for (unsigned int messageIdx = 0; messageIdx < messageTotal; messageIdx++)
+                    {
+                        MEM_CONTEXT_TEMP_BEGIN()
+                        {
+                            protocolClientExecute(client, command, true);
+                        }
+                        MEM_CONTEXT_TEMP_END();
+                    }
+
+                    TimeUSec timeElapsed = timeUSec() - timeBegin;
+
+                    TEST_LOG_FMT(
+                        "%s: %u messages in %" PRIu64 "ms (%" PRIu64 " messages/sec)", name, messageTotal, timeElapsed / 1000,
+                        (uint64_t)messageTotal * 1000000 / (timeElapsed == 0 ? 1 : timeElapsed));
+
+                    TEST_RESULT_VOID(protocolClientFree(client), "    free client");
+                }
+            }
+            HARNESS_FORK_PARENT_END();
+        }
+        HARNESS_FORK_END();
+    }
+
     FUNCTION_HARNESS_RESULT_VOID();
 }
@@ -56,6 +56,32 @@ testStorageInfoListCallback(void *callbackData, const StorageInfo *info)
     MEM_CONTEXT_END();
 }
 
+/***********************************************************************************************************************************
+Test callback that describes each entry found by storagePosixWalk()
+***********************************************************************************************************************************/
+void
+testStorageWalkCallback(void *callbackData, const StorageInfo *info)
+{
+    StringList *list = (StringList *)callbackData;
+
+    MEM_CONTEXT_BEGIN(lstMemContext((List *)list))
+    {
+        String *entry = strNewFmt(
+            "%s {%s, %s, %s, %04o", strPtr(info->name),
+            info->type == storageTypeFile ? "file" :
+                (info->type == storageTypePath ? "path" : (info->type == storageTypeLink ? "link" : "special")),
+            strEq(info->user, STR(testUser())) ? "user" : "?", strEq(info->group, STR(testGroup())) ? "group" : "?", info->mode);
+
+        if (info->type == storageTypeFile)
+            strCatFmt(entry, ", %" PRIu64, info->size);
+        else if (info->type == storageTypeLink)
+            strCatFmt(entry, ", %s", strPtr(info->linkDestination));
+
+        strLstAdd(list, strCat(entry, "}"));
+    }
+    MEM_CONTEXT_END();
+}
+
 /***********************************************************************************************************************************
 Test Run
 ***********************************************************************************************************************************/
@@ -103,6 +129,7 @@ testRun(void)
         TEST_RESULT_PTR(storageType(storageTest), storageTest->type, "    check type");
         TEST_RESULT_BOOL(storageFeature(storageTest, storageFeaturePath), true, "    check path feature");
         TEST_RESULT_BOOL(storageFeature(storageTest, storageFeatureCompress), true, "    check compress feature");
+        TEST_RESULT_BOOL(storageFeature(storageTest, storageFeatureMove), true, "    check move feature");
 
         TEST_RESULT_VOID(storageFree(storageTest), "free storage");
     }
@@ -298,6 +325,77 @@ testRun(void)
         TEST_RESULT_STR(strPtr(testStorageInfoList[0].name), ".", "    check name");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("storagePosixWalk()"))
+    {
+        String *path = strNewFmt("%s/walk", testPath());
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_BOOL(storagePosixWalk(path, NULL, 1, testStorageWalkCallback, strLstNew()), false, "missing path");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        StoragePosixWalk walk = {.path = path};
+        StoragePosixWalkThread thread = {.walk = &walk, .entryList = lstNew(sizeof(StoragePosixWalkEntry))};
+
+        TEST_RESULT_BOOL(storagePosixWalkEntry(&thread, AT_FDCWD, "missing", path, strNew("missing")), false, "missing entry");
+        TEST_RESULT_UINT(lstSize(thread.entryList), 0, "    no entry stored");
+
+        TEST_ERROR_FMT(
+            storagePosixWalkEntry(&thread, -1, "file", path, strNew("file")), FileOpenError,
+            STORAGE_ERROR_INFO ": [9] Bad file descriptor", strPtr(strNewFmt("%s/file", strPtr(path))));
+        TEST_ERROR_FMT(
+            storagePosixWalkEntry(&thread, -1, "file", NULL, strNew(".")), FileOpenError,
+            STORAGE_ERROR_INFO ": [9] Bad file descriptor", "file");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_INT(
+            system(
+                strPtr(
+                    strNewFmt(
+                        "cd %s && mkdir -p walk/sub1/sub2 walk/sub3 && cd walk && echo -n 1 > file && echo -n 22 > sub1/file &&"
+                            " echo -n 333 > sub1/sub2/file && ln -s sub1 link && mkfifo sub3/fifo &&"
+                            " chmod 640 file sub1/file sub1/sub2/file sub3/fifo && chmod 750 . sub1 sub1/sub2 sub3",
+                        testPath()))),
+            0, "create tree");
+
+        TEST_ERROR_FMT(
+            storagePosixWalk(strNewFmt("%s/file", strPtr(path)), NULL, 2, testStorageWalkCallback, strLstNew()), PathOpenError,
+            STORAGE_ERROR_LIST_INFO ": [20] Not a directory", strPtr(strNewFmt("%s/file", strPtr(path))));
+
+        for (unsigned int threadTotal = 1; threadTotal <= 4; threadTotal *= 2)
+        {
+            StringList *list = strLstNew();
+            TEST_RESULT_BOOL(storagePosixWalk(path, NULL, threadTotal, testStorageWalkCallback, list), true, "walk path");
+            TEST_RESULT_STR(
+                strPtr(strLstJoin(strLstSort(list, sortOrderAsc), "\n")),
+                ". {path, user, group, 0750}\n"
+                "file {file, user, group, 0640, 1}\n"
+                "link {link, user, group, 0777, sub1}\n"
+                "sub1 {path, user, group, 0750}\n"
+                "sub1/file {file, user, group, 0640, 2}\n"
+                "sub1/sub2 {path, user, group, 0750}\n"
+                "sub1/sub2/file {file, user, group, 0640, 3}\n"
+                "sub3 {path, user, group, 0750}\n"
+                "sub3/fifo {special, user, group, 0640}",
+                "    check entries");
+        }
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        StringList *list = strLstNew();
+        TEST_RESULT_BOOL(storagePosixWalk(path, strNew("sub1"), 3, testStorageWalkCallback, list), true, "walk path with filter");
+        TEST_RESULT_STR(
+            strPtr(strLstJoin(strLstSort(list, sortOrderAsc), "\n")),
+            ". {path, user, group, 0750}\n"
+            "sub1 {path, user, group, 0750}\n"
+            "sub1/file {file, user, group, 0640, 2}\n"
+            "sub1/sub2 {path, user, group, 0750}\n"
+            "sub1/sub2/file {file, user, group, 0640, 3}",
+            "    check entries");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_INT(system(strPtr(strNewFmt("rm -rf %s", strPtr(path)))), 0, "remove tree");
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("storageList()"))
     {
@@ -751,6 +849,23 @@ testRun(void)
 
         TEST_RESULT_VOID(storageRemoveNP(storageTest, fileExists), "remove exists file");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        StringList *fileList = strLstNew();
+        TEST_RESULT_VOID(storageRemoveListNP(storageTest, fileList), "remove empty file list");
+
+        strLstAdd(fileList, fileExists);
+        strLstAddZ(fileList, "exists2");
+        strLstAddZ(fileList, "missing");
+
+        TEST_RESULT_INT(system(strPtr(strNewFmt("touch %s %s/exists2", strPtr(fileExists), testPath()))), 0, "create files");
+        TEST_RESULT_VOID(storageRemoveListNP(storageTest, fileList), "remove file list");
+        TEST_RESULT_BOOL(storageExistsNP(storageTest, fileExists), false, "    check exists removed");
+        TEST_RESULT_BOOL(storageExistsNP(storageTest, strNew("exists2")), false, "    check exists2 removed");
+
+        TEST_ERROR_FMT(
+            storageRemoveListP(storageTest, fileList, .errorOnMissing = true), FileRemoveError,
+            "unable to remove '%s': [2] No such file or directory", strPtr(fileExists));
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_ERROR_FMT(
             storageRemoveNP(storageTest, fileNoPerm), FileRemoveError,
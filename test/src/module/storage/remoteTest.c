@@ -2,13 +2,46 @@
 Test Remote Storage
 ***********************************************************************************************************************************/
 #include "command/backup/pageChecksum.h"
+#include "command/backup/pageDelta.h"
 #include "common/crypto/cipherBlock.h"
 #include "common/io/bufferRead.h"
 #include "common/io/bufferWrite.h"
+#include "common/type/json.h"
 #include "postgres/interface.h"
+#include "protocol/frame.h"
 
 #include "common/harnessConfig.h"
 
+/***********************************************************************************************************************************
+Create a protocol server that has switched to binary frames
+
+The server processes the command to switch to binary frames and an exit command, so any remaining input is available to be read by
+protocol functions called directly.
+***********************************************************************************************************************************/
+static ProtocolServer *
+testServerBinary(const Buffer *input, Buffer *output)
+{
+    Buffer *command = bufNew(0);
+    IoWrite *commandWrite = ioBufferWriteNew(command);
+    ioWriteOpen(commandWrite);
+
+    ioWriteStrLine(commandWrite, strNew("{\"cmd\":\"binary\"}"));
+    protocolFrameWrite(commandWrite, protocolCommandFrame(protocolCommandNew(PROTOCOL_COMMAND_EXIT_STR)));
+    ioWrite(commandWrite, input);
+    ioWriteClose(commandWrite);
+
+    IoRead *read = ioBufferReadNew(command);
+    ioReadOpen(read);
+    IoWrite *write = ioBufferWriteNew(output);
+    ioWriteOpen(write);
+
+    ProtocolServer *result = protocolServerNew(strNew("test"), strNew("test"), read, write);
+    protocolServerProcess(result);
+    bufUsedSet(output, 0);
+
+    return result;
+}
+
 /***********************************************************************************************************************************
 Test Run
 ***********************************************************************************************************************************/
@@ -59,9 +92,12 @@ testRun(void)
     {
         Storage *storageRemote = NULL;
         TEST_ASSIGN(storageRemote, storageRepoGet(strNew(STORAGE_TYPE_POSIX), false), "get remote repo storage");
-        TEST_RESULT_UINT(storageInterface(storageRemote).feature, storageInterface(storageTest).feature, "    check features");
+        TEST_RESULT_UINT(
+            storageInterface(storageRemote).feature, storageInterface(storageTest).feature & ~((uint64_t)1 << storageFeatureMove),
+            "    check features");
         TEST_RESULT_BOOL(storageFeature(storageRemote, storageFeaturePath), true, "    check path feature");
         TEST_RESULT_BOOL(storageFeature(storageRemote, storageFeatureCompress), true, "    check compress feature");
+        TEST_RESULT_BOOL(storageFeature(storageRemote, storageFeatureMove), false, "    check move feature");
 
         // Check protocol function directly
         // -------------------------------------------------------------------------------------------------------------------------
@@ -253,6 +289,7 @@ testRun(void)
         filterGroup = ioFilterGroupNew();
         ioFilterGroupAdd(filterGroup, ioSizeNew());
         ioFilterGroupAdd(filterGroup, cryptoHashNew(HASH_TYPE_SHA1_STR));
+        ioFilterGroupAdd(filterGroup, pageDeltaNew(PG_PAGE_SIZE_DEFAULT, 1, 0));
         ioFilterGroupAdd(filterGroup, ioSinkNew());
         varLstAdd(paramList, ioFilterGroupParamAll(filterGroup));
 
@@ -262,7 +299,8 @@ testRun(void)
             strPtr(strNewBuf(serverWrite)),
             "{\"out\":true}\n"
                 "BRBLOCK0\n"
-                "{\"out\":{\"buffer\":null,\"hash\":\"bbbcf2c59433f68f22376cd2439d6cd309378df6\",\"sink\":null,\"size\":8}}\n",
+                "{\"out\":{\"buffer\":null,\"hash\":\"bbbcf2c59433f68f22376cd2439d6cd309378df6\",\"pageDelta\":1,\"sink\":null"
+                    ",\"size\":8}}\n",
             "check result");
 
         bufUsedSet(serverWrite, 0);
@@ -277,6 +315,46 @@ testRun(void)
         TEST_ERROR(
             storageRemoteProtocol(
                 PROTOCOL_COMMAND_STORAGE_OPEN_READ_STR, paramList, server), AssertError, "unable to add filter 'bogus'");
+
+        // Check protocol function directly with binary frames
+        // -------------------------------------------------------------------------------------------------------------------------
+        Buffer *binaryWrite = bufNew(0);
+        ProtocolServer *serverBinary = NULL;
+
+        TEST_ASSIGN(serverBinary, testServerBinary(bufNew(0), binaryWrite), "binary server");
+        TEST_RESULT_BOOL(protocolServerBinary(serverBinary), true, "    check binary frames");
+
+        paramList = varLstNew();
+        varLstAdd(paramList, varNewStr(strNew("test.txt")));
+        varLstAdd(paramList, varNewBool(false));
+        varLstAdd(paramList, ioFilterGroupParamAll(ioFilterGroupAdd(ioFilterGroupNew(), ioSizeNew())));
+
+        TEST_RESULT_BOOL(
+            storageRemoteProtocol(PROTOCOL_COMMAND_STORAGE_OPEN_READ_STR, paramList, serverBinary), true,
+            "protocol open read (binary)");
+
+        IoRead *binaryRead = ioBufferReadNew(binaryWrite);
+        ioReadOpen(binaryRead);
+        size_t position = 0;
+        Buffer *frame = NULL;
+
+        TEST_ASSIGN(frame, protocolFrameRead(binaryRead), "read open result");
+        TEST_RESULT_PTR(protocolFrameGet(frame, &position), NULL, "    check no error");
+        TEST_RESULT_BOOL(varBool(protocolFrameGet(frame, &position)), true, "    check exists");
+
+        TEST_RESULT_INT(storageRemoteProtocolBlockRead(binaryRead, true), 8, "read block size");
+
+        Buffer *block = bufNew(8);
+        TEST_RESULT_SIZE(ioRead(binaryRead, block), 8, "read block");
+        TEST_RESULT_STR(strPtr(strNewBuf(block)), "TESTDATA", "    check block");
+        TEST_RESULT_INT(storageRemoteProtocolBlockRead(binaryRead, true), 0, "read end block");
+
+        position = 0;
+
+        TEST_ASSIGN(frame, protocolFrameRead(binaryRead), "read filter result");
+        TEST_RESULT_PTR(protocolFrameGet(frame, &position), NULL, "    check no error");
+        TEST_RESULT_STR(
+            strPtr(jsonFromVar(protocolFrameGet(frame, &position), 0)), "{\"buffer\":null,\"size\":8}", "    check result");
     }
 
     // *****************************************************************************************************************************
@@ -418,6 +496,68 @@ testRun(void)
         TEST_RESULT_STR(
             strPtr(strNewBuf(storageGetNP(storageNewReadNP(storageTest, strNew("repo/test4.txt.pgbackrest.tmp"))))), "",
             "check file");
+
+        // Check protocol function directly with binary frames
+        // -------------------------------------------------------------------------------------------------------------------------
+        Buffer *binaryInput = bufNew(0);
+        IoWrite *binaryInputWrite = ioBufferWriteNew(binaryInput);
+        ioWriteOpen(binaryInputWrite);
+
+        storageRemoteProtocolBlockWrite(binaryInputWrite, true, 3);
+        ioWrite(binaryInputWrite, BUFSTRDEF("ABC"));
+        storageRemoteProtocolBlockWrite(binaryInputWrite, true, 0);
+        ioWriteClose(binaryInputWrite);
+
+        Buffer *binaryWrite = bufNew(0);
+        ProtocolServer *serverBinary = NULL;
+
+        TEST_ASSIGN(serverBinary, testServerBinary(binaryInput, binaryWrite), "binary server");
+
+        paramList = varLstNew();
+        varLstAdd(paramList, varNewStr(strNew("test5.txt")));
+        varLstAdd(paramList, varNewUInt64(0640));
+        varLstAdd(paramList, varNewUInt64(0750));
+        varLstAdd(paramList, NULL);
+        varLstAdd(paramList, NULL);
+        varLstAdd(paramList, varNewInt(0));
+        varLstAdd(paramList, varNewBool(true));
+        varLstAdd(paramList, varNewBool(true));
+        varLstAdd(paramList, varNewBool(true));
+        varLstAdd(paramList, varNewBool(true));
+        varLstAdd(paramList, ioFilterGroupParamAll(ioFilterGroupAdd(ioFilterGroupNew(), ioSizeNew())));
+
+        TEST_RESULT_BOOL(
+            storageRemoteProtocol(PROTOCOL_COMMAND_STORAGE_OPEN_WRITE_STR, paramList, serverBinary), true,
+            "protocol open write (binary)");
+
+        IoRead *binaryRead = ioBufferReadNew(binaryWrite);
+        ioReadOpen(binaryRead);
+        size_t position = 0;
+        Buffer *frame = NULL;
+
+        TEST_ASSIGN(frame, protocolFrameRead(binaryRead), "read open result");
+        TEST_RESULT_PTR(protocolFrameGet(frame, &position), NULL, "    check no error");
+        TEST_RESULT_PTR(protocolFrameGet(frame, &position), NULL, "    check no output");
+
+        position = 0;
+
+        TEST_ASSIGN(frame, protocolFrameRead(binaryRead), "read filter result");
+        TEST_RESULT_PTR(protocolFrameGet(frame, &position), NULL, "    check no error");
+        TEST_RESULT_STR(
+            strPtr(jsonFromVar(protocolFrameGet(frame, &position), 0)), "{\"buffer\":null,\"size\":3}", "    check result");
+
+        TEST_RESULT_STR(
+            strPtr(strNewBuf(storageGetNP(storageNewReadNP(storageTest, strNew("repo/test5.txt"))))), "ABC", "check file");
+
+        // Text block headers are still written when binary frames are not used
+        // -------------------------------------------------------------------------------------------------------------------------
+        bufUsedSet(serverWrite, 0);
+
+        TEST_RESULT_VOID(storageRemoteProtocolBlockWrite(serverWriteIo, false, -1), "write abort block");
+        TEST_RESULT_VOID(ioWriteFlush(serverWriteIo), "    flush");
+        TEST_RESULT_STR(strPtr(strNewBuf(serverWrite)), "BRBLOCK-1\n", "    check block");
+
+        bufUsedSet(serverWrite, 0);
     }
 
     // *****************************************************************************************************************************
@@ -590,6 +730,41 @@ testRun(void)
         TEST_RESULT_BOOL(storageExistsNP(storageTest, strNewFmt("repo/%s", strPtr(file))), false, "  confirm file removed");
         TEST_RESULT_STR(strPtr(strNewBuf(serverWrite)), "{}\n", "  check result");
         bufUsedSet(serverWrite, 0);
+
+        // Remove a list of files via the remote
+        // -------------------------------------------------------------------------------------------------------------------------
+        String *file2 = strNew("file2.txt");
+
+        TEST_RESULT_VOID(storagePutNP(storageNewWriteNP(storageRemote, file), BUFSTRDEF("TEST")), "new file");
+        TEST_RESULT_VOID(storagePutNP(storageNewWriteNP(storageRemote, file2), BUFSTRDEF("TEST")), "new file2");
+
+        StringList *fileList = strLstNew();
+        strLstAdd(fileList, file);
+        strLstAdd(fileList, file2);
+        strLstAddZ(fileList, "missing.txt");
+
+        TEST_RESULT_VOID(storageRemoveListNP(storageRemote, fileList), "remote remove file list");
+        TEST_RESULT_BOOL(storageExistsNP(storageTest, strNewFmt("repo/%s", strPtr(file))), false, "  file removed");
+        TEST_RESULT_BOOL(storageExistsNP(storageTest, strNewFmt("repo/%s", strPtr(file2))), false, "  file2 removed");
+
+        // Check protocol function directly
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_VOID(storagePutNP(storageNewWriteNP(storageRemote, file), BUFSTRDEF("TEST")), "new file");
+
+        paramList = varLstNew();
+        varLstAdd(paramList, varNewVarLst(varLstNewStrLst(strLstAdd(strLstNew(), file))));
+        varLstAdd(paramList, varNewBool(true));
+
+        TEST_RESULT_BOOL(
+            storageRemoteProtocol(PROTOCOL_COMMAND_STORAGE_REMOVE_LIST_STR, paramList, server), true, "protocol file list remove");
+        TEST_RESULT_BOOL(storageExistsNP(storageTest, strNewFmt("repo/%s", strPtr(file))), false, "  confirm file removed");
+        TEST_RESULT_STR(strPtr(strNewBuf(serverWrite)), "{}\n", "  check result");
+        bufUsedSet(serverWrite, 0);
+
+        TEST_ERROR_FMT(
+            storageRemoteProtocol(PROTOCOL_COMMAND_STORAGE_REMOVE_LIST_STR, paramList, server), FileRemoveError,
+            "raised from remote-0 protocol on 'localhost': unable to remove '%s/repo/file.txt': "
+            "[2] No such file or directory", testPath());
     }
 
     // *****************************************************************************************************************************
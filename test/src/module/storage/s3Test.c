@@ -16,7 +16,7 @@ Test server
     "????????????????????????????????????????????????????????????????"
 
 static const char *
-testS3ServerRequest(const char *verb, const char *uri, const char *content)
+testS3ServerRequestRange(const char *verb, const char *uri, const char *range, const char *ifMatch, const char *content)
 {
     String *request = strNewFmt(
         "%s %s HTTP/1.1\r\n"
@@ -29,9 +29,9 @@ testS3ServerRequest(const char *verb, const char *uri, const char *content)
 
     strCatFmt(
         request,
-        "host;x-amz-content-sha256;x-amz-date,Signature=" SHA256_REPLACE "\r\n"
+        "host;%s%sx-amz-content-sha256;x-amz-date,Signature=" SHA256_REPLACE "\r\n"
         "content-length:%zu\r\n",
-        content == NULL ? 0 : strlen(content));
+        ifMatch == NULL ? "" : "if-match;", range == NULL ? "" : "range;", content == NULL ? 0 : strlen(content));
 
     if (content != NULL)
     {
@@ -40,9 +40,16 @@ testS3ServerRequest(const char *verb, const char *uri, const char *content)
         strCatFmt(request, "content-md5:%s\r\n", md5Hash);
     }
 
+    strCat(request, "host:" S3_TEST_HOST "\r\n");
+
+    if (ifMatch != NULL)
+        strCatFmt(request, "if-match:%s\r\n", ifMatch);
+
+    if (range != NULL)
+        strCatFmt(request, "range:bytes=%s\r\n", range);
+
     strCatFmt(
         request,
-        "host:" S3_TEST_HOST "\r\n"
         "x-amz-content-sha256:%s\r\n"
         "x-amz-date:" DATETIME_REPLACE "\r\n"
         "\r\n",
@@ -54,6 +61,12 @@ testS3ServerRequest(const char *verb, const char *uri, const char *content)
     return strPtr(request);
 }
 
+static const char *
+testS3ServerRequest(const char *verb, const char *uri, const char *content)
+{
+    return testS3ServerRequestRange(verb, uri, NULL, NULL, content);
+}
+
 static const char *
 testS3ServerResponse(unsigned int code, const char *message, const char *header, const char *content)
 {
@@ -473,6 +486,182 @@ testS3Server(void)
         harnessTlsServerExpect(testS3ServerRequest(HTTP_VERB_DELETE, "/path/to/test.txt", NULL));
         harnessTlsServerReply(testS3ServerResponse(204, "No Content", NULL, NULL));
 
+        // storageDriverRemoveList()
+        // -------------------------------------------------------------------------------------------------------------------------
+        // remove file list in batches
+        harnessTlsServerExpect(
+            testS3ServerRequest(HTTP_VERB_POST, "/?delete=",
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                "<Delete><Quiet>true</Quiet>"
+                "<Object><Key>path/to/test1.txt</Key></Object>"
+                "<Object><Key>path/to/test2.txt</Key></Object>"
+                "</Delete>\n"));
+        harnessTlsServerReply(testS3ServerResponse(200, "OK", NULL, NULL));
+
+        harnessTlsServerExpect(
+            testS3ServerRequest(HTTP_VERB_POST, "/?delete=",
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                "<Delete><Quiet>true</Quiet>"
+                "<Object><Key>path/to/test3.txt</Key></Object>"
+                "</Delete>\n"));
+        harnessTlsServerReply(testS3ServerResponse(200, "OK", NULL, NULL));
+
+        // Concurrent part uploads
+        // -------------------------------------------------------------------------------------------------------------------------
+        harnessTlsServerAccept();
+
+        harnessTlsServerExpect(testS3ServerRequest(HTTP_VERB_POST, "/file.txt?uploads=", NULL));
+        harnessTlsServerReply(testS3ServerResponse(
+            200, "OK", NULL,
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<InitiateMultipartUploadResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                "<Bucket>bucket</Bucket>"
+                "<Key>file.txt</Key>"
+                "<UploadId>CC33</UploadId>"
+                "</InitiateMultipartUploadResult>"));
+
+        harnessTlsServerExpect(testS3ServerRequest(HTTP_VERB_PUT, "/file.txt?partNumber=1&uploadId=CC33", "1234567890123456"));
+        harnessTlsServerReply(testS3ServerResponse(200, "OK", "etag:CC331", NULL));
+
+        // Second part is sent on a new connection while the first part is still pending
+        harnessTlsServerAccept();
+
+        harnessTlsServerExpect(testS3ServerRequest(HTTP_VERB_PUT, "/file.txt?partNumber=2&uploadId=CC33", "7890123456789012"));
+        harnessTlsServerReply(testS3ServerResponse(503, "Slow Down", NULL, NULL));
+
+        // Second part is uploaded again after the error
+        harnessTlsServerExpect(testS3ServerRequest(HTTP_VERB_PUT, "/file.txt?partNumber=2&uploadId=CC33", "7890123456789012"));
+        harnessTlsServerReply(testS3ServerResponse(200, "OK", "etag:CC332", NULL));
+
+        // Third part is sent on the first connection which is no longer served so it is uploaded again after the timeout
+        harnessTlsServerExpect(testS3ServerRequest(HTTP_VERB_PUT, "/file.txt?partNumber=3&uploadId=CC33", "3456"));
+        harnessTlsServerReply(testS3ServerResponse(200, "OK", "etag:CC333", NULL));
+
+        harnessTlsServerExpect(testS3ServerRequest(
+            HTTP_VERB_POST, "/file.txt?uploadId=CC33",
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                "<CompleteMultipartUpload>"
+                "<Part><PartNumber>1</PartNumber><ETag>CC331</ETag></Part>"
+                "<Part><PartNumber>2</PartNumber><ETag>CC332</ETag></Part>"
+                "<Part><PartNumber>3</PartNumber><ETag>CC333</ETag></Part>"
+                "</CompleteMultipartUpload>\n"));
+        harnessTlsServerReply(testS3ServerResponse(200, "OK", NULL, NULL));
+
+        // Write is freed while a part is being uploaded
+        harnessTlsServerExpect(testS3ServerRequest(HTTP_VERB_POST, "/file.txt?uploads=", NULL));
+        harnessTlsServerReply(testS3ServerResponse(
+            200, "OK", NULL,
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<InitiateMultipartUploadResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                "<Bucket>bucket</Bucket>"
+                "<Key>file.txt</Key>"
+                "<UploadId>DD44</UploadId>"
+                "</InitiateMultipartUploadResult>"));
+
+        harnessTlsServerExpect(testS3ServerRequest(HTTP_VERB_PUT, "/file.txt?partNumber=1&uploadId=DD44", "1234567890123456"));
+
+        // Ranged reads
+        // -------------------------------------------------------------------------------------------------------------------------
+        // Only the first range is requested when the file is opened
+        unsigned int connectionFirst = harnessTlsServerAccept();
+
+        harnessTlsServerExpect(testS3ServerRequestRange(HTTP_VERB_GET, "/file.txt", "0-15", NULL, NULL));
+        harnessTlsServerReply(
+            testS3ServerResponse(206, "Partial Content", "content-range:bytes 0-15/40\r\netag:E1", "1234567890123456"));
+
+        // Second range is requested on a new connection while the first range is read.  Only part of the content is sent so the
+        // read will time out.
+        harnessTlsServerAccept();
+
+        harnessTlsServerExpect(testS3ServerRequestRange(HTTP_VERB_GET, "/file.txt", "16-31", "E1", NULL));
+        harnessTlsServerReply("HTTP/1.1 206 Partial Content\r\ncontent-length:16\r\netag:E1\r\n\r\n7890");
+
+        // Second range is requested again after the timeout
+        unsigned int connectionResume = harnessTlsServerAccept();
+
+        harnessTlsServerExpect(testS3ServerRequestRange(HTTP_VERB_GET, "/file.txt", "16-31", "E1", NULL));
+        harnessTlsServerReply(testS3ServerResponse(206, "Partial Content", "etag:E1", "7890123456789012"));
+
+        // Third range was requested on the first connection after the first range was read
+        harnessTlsServerSwitch(connectionFirst);
+
+        harnessTlsServerExpect(testS3ServerRequestRange(HTTP_VERB_GET, "/file.txt", "32-39", "E1", NULL));
+        harnessTlsServerReply(testS3ServerResponse(206, "Partial Content", "etag:E1", "34567890"));
+
+        // Read is freed while a range is being downloaded
+        harnessTlsServerSwitch(connectionResume);
+
+        harnessTlsServerExpect(testS3ServerRequestRange(HTTP_VERB_GET, "/file.txt", "0-15", NULL, NULL));
+        harnessTlsServerReply(
+            testS3ServerResponse(206, "Partial Content", "content-range:bytes 0-15/40\r\netag:E1", "1234567890123456"));
+
+        harnessTlsServerSwitch(connectionFirst);
+
+        harnessTlsServerExpect(testS3ServerRequestRange(HTTP_VERB_GET, "/file.txt", "16-31", "E1", NULL));
+
+        // File is changed after the first range is read so the second range fails with precondition failed
+        unsigned int connectionChanged = harnessTlsServerAccept();
+
+        harnessTlsServerExpect(testS3ServerRequestRange(HTTP_VERB_GET, "/file.txt", "0-15", NULL, NULL));
+        harnessTlsServerReply(
+            testS3ServerResponse(206, "Partial Content", "content-range:bytes 0-15/40\r\netag:E1", "1234567890123456"));
+
+        unsigned int connectionPrecondition = harnessTlsServerAccept();
+
+        harnessTlsServerExpect(testS3ServerRequestRange(HTTP_VERB_GET, "/file.txt", "16-31", "E1", NULL));
+        harnessTlsServerReply(testS3ServerResponse(412, "Precondition Failed", NULL, NULL));
+
+        harnessTlsServerSwitch(connectionChanged);
+
+        harnessTlsServerExpect(testS3ServerRequestRange(HTTP_VERB_GET, "/file.txt", "32-39", "E1", NULL));
+
+        // Range request does not return partial content.  The server ignores the range for the first request so the entire file is
+        // returned.
+        unsigned int connectionEntire = harnessTlsServerAccept();
+
+        harnessTlsServerExpect(testS3ServerRequestRange(HTTP_VERB_GET, "/file.txt", "0-15", NULL, NULL));
+        harnessTlsServerReply(testS3ServerResponse(200, "OK", "etag:E1", "1234567890123456789012345678901234567890"));
+
+        harnessTlsServerSwitch(connectionPrecondition);
+
+        harnessTlsServerExpect(testS3ServerRequestRange(HTTP_VERB_GET, "/file.txt", "16-31", "E1", NULL));
+        harnessTlsServerReply(testS3ServerResponse(404, "Not Found", NULL, NULL));
+
+        // The entire file was small enough to be buffered so the connection can be reused
+        harnessTlsServerSwitch(connectionEntire);
+
+        harnessTlsServerExpect(testS3ServerRequestRange(HTTP_VERB_GET, "/file.txt", "32-39", "E1", NULL));
+
+        harnessTlsServerSwitch(connectionPrecondition);
+
+        harnessTlsServerExpect(testS3ServerRequestRange(HTTP_VERB_GET, "/file.txt", "16-31", "E1", NULL));
+        harnessTlsServerReply(testS3ServerResponse(200, "OK", "etag:E1", "1234567890123456789012345678901234567890"));
+
+        // Server ignores if-match and returns a range from a different version of the file
+        unsigned int connectionVersion = harnessTlsServerAccept();
+
+        harnessTlsServerExpect(testS3ServerRequestRange(HTTP_VERB_GET, "/file.txt", "0-15", NULL, NULL));
+        harnessTlsServerReply(
+            testS3ServerResponse(206, "Partial Content", "content-range:bytes 0-15/40\r\netag:E1", "1234567890123456"));
+
+        harnessTlsServerAccept();
+
+        harnessTlsServerExpect(testS3ServerRequestRange(HTTP_VERB_GET, "/file.txt", "16-31", "E1", NULL));
+        harnessTlsServerReply(testS3ServerResponse(206, "Partial Content", "etag:E2", "ABCDEFGHIJKLMNOP"));
+
+        harnessTlsServerSwitch(connectionVersion);
+
+        harnessTlsServerExpect(testS3ServerRequestRange(HTTP_VERB_GET, "/file.txt", "32-39", "E1", NULL));
+
+        // Range cannot be returned for a zero-length file so the entire file is requested
+        harnessTlsServerAccept();
+
+        harnessTlsServerExpect(testS3ServerRequestRange(HTTP_VERB_GET, "/file0.txt", "0-15", NULL, NULL));
+        harnessTlsServerReply(testS3ServerResponse(416, "Requested Range Not Satisfiable", NULL, NULL));
+
+        harnessTlsServerExpect(testS3ServerRequest(HTTP_VERB_GET, "/file0.txt", NULL));
+        harnessTlsServerReply(testS3ServerResponse(200, "OK", NULL, NULL));
+
         harnessTlsServerClose();
         exit(0);
     }
@@ -550,6 +739,7 @@ testRun(void)
         TEST_RESULT_PTR(((StorageS3 *)storage->driver)->securityToken, NULL, "    check security token");
         TEST_RESULT_BOOL(storageFeature(storage, storageFeaturePath), false, "    check path feature");
         TEST_RESULT_BOOL(storageFeature(storage, storageFeatureCompress), false, "    check compress feature");
+        TEST_RESULT_BOOL(storageFeature(storage, storageFeatureMove), false, "    check move feature");
 
         // Add default options
         // -------------------------------------------------------------------------------------------------------------------------
@@ -688,7 +878,8 @@ testRun(void)
         // -------------------------------------------------------------------------------------------------------------------------
         StorageS3 *driver = (StorageS3 *)storageDriver(
             storageS3New(
-                path, true, NULL, bucket, endPoint, region, accessKey, secretAccessKey, NULL, 16, 2, NULL, 0, 0, true, NULL, NULL));
+                path, true, NULL, bucket, endPoint, region, accessKey, secretAccessKey, NULL, 16, 1, 1, 2, NULL, 0, 0, true, NULL,
+                NULL));
 
         HttpHeader *header = httpHeaderNew(NULL);
 
@@ -735,8 +926,8 @@ testRun(void)
         // -------------------------------------------------------------------------------------------------------------------------
         driver = (StorageS3 *)storageDriver(
             storageS3New(
-                path, true, NULL, bucket, endPoint, region, accessKey, secretAccessKey, securityToken, 16, 2, NULL, 0, 0, true,
-                NULL, NULL));
+                path, true, NULL, bucket, endPoint, region, accessKey, secretAccessKey, securityToken, 16, 1, 1, 2, NULL, 0, 0,
+                true, NULL, NULL));
 
         TEST_RESULT_VOID(
             storageS3Auth(driver, strNew("GET"), strNew("/"), query, strNew("20170606T121212Z"), header, HASH_TYPE_SHA256_ZERO_STR),
@@ -755,7 +946,7 @@ testRun(void)
         testS3Server();
 
         Storage *s3 = storageS3New(
-            path, true, NULL, bucket, endPoint, region, accessKey, secretAccessKey, NULL, 16, 2, host, port, 1000, true, NULL,
+            path, true, NULL, bucket, endPoint, region, accessKey, secretAccessKey, NULL, 16, 1, 1, 2, host, port, 1000, true, NULL,
             NULL);
 
         // Coverage for noop functions
@@ -931,6 +1122,65 @@ testRun(void)
         // storageDriverRemove()
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_RESULT_VOID(storageRemoveNP(s3, strNew("/path/to/test.txt")), "remove file");
+
+        // storageDriverRemoveList()
+        // -------------------------------------------------------------------------------------------------------------------------
+        StringList *removeList = strLstNew();
+        strLstAddZ(removeList, "/path/to/test1.txt");
+        strLstAddZ(removeList, "/path/to/test2.txt");
+        strLstAddZ(removeList, "/path/to/test3.txt");
+
+        TEST_ERROR(
+            storageRemoveListP(s3, removeList, .errorOnMissing = true), AssertError, "assertion '!errorOnMissing' failed");
+        TEST_RESULT_VOID(storageRemoveListNP(s3, strLstNew()), "remove empty file list");
+        TEST_RESULT_VOID(storageRemoveListNP(s3, removeList), "remove file list in batches");
+
+        // Concurrent part uploads
+        // -------------------------------------------------------------------------------------------------------------------------
+        Storage *s3Upload = storageS3New(
+            path, true, NULL, bucket, endPoint, region, accessKey, secretAccessKey, NULL, 16, 2, 1, 2, host, port, 1000, true, NULL,
+            NULL);
+
+        TEST_ASSIGN(write, storageNewWriteNP(s3Upload, strNew("file.txt")), "new write file");
+        TEST_RESULT_VOID(
+            storagePutNP(write, BUFSTRDEF("123456789012345678901234567890123456")), "write file with concurrent part uploads");
+
+        TEST_ASSIGN(write, storageNewWriteNP(s3Upload, strNew("file.txt")), "new write file");
+        TEST_RESULT_VOID(ioWriteOpen(storageWriteIo(write)), "    open file");
+        TEST_RESULT_VOID(ioWrite(storageWriteIo(write), BUFSTRDEF("1234567890123456")), "    write part");
+        TEST_RESULT_VOID(ioWriteFlush(storageWriteIo(write)), "    flush part to start upload");
+        TEST_RESULT_VOID(storageWriteFree(write), "    free file with part upload in progress");
+
+        // Ranged reads
+        // -------------------------------------------------------------------------------------------------------------------------
+        Storage *s3Download = storageS3New(
+            path, true, NULL, bucket, endPoint, region, accessKey, secretAccessKey, NULL, 16, 1, 2, 2, host, port, 1000, true, NULL,
+            NULL);
+
+        TEST_RESULT_STR(
+            strPtr(strNewBuf(storageGetNP(storageNewReadNP(s3Download, strNew("file.txt"))))),
+            "1234567890123456789012345678901234567890", "get file in ranges");
+
+        TEST_ASSIGN(read, storageNewReadNP(s3Download, strNew("file.txt")), "new read file");
+        TEST_RESULT_BOOL(ioReadOpen(storageReadIo(read)), true, "    open file");
+        TEST_RESULT_VOID(storageReadFree(read), "    free file with range download in progress");
+
+        TEST_ASSIGN(read, storageNewReadNP(s3Download, strNew("file.txt")), "new read file");
+        TEST_ERROR(
+            storageGetNP(read), FileReadError, "unable to read '/file.txt' because it was changed after being opened");
+        TEST_RESULT_VOID(storageReadFree(read), "    free file");
+
+        TEST_ASSIGN(read, storageNewReadNP(s3Download, strNew("file.txt")), "new read file");
+        TEST_ERROR(storageGetNP(read), ProtocolError, "S3 range request for '/file.txt' failed with 200: OK");
+        TEST_RESULT_VOID(storageReadFree(read), "    free file");
+
+        TEST_ASSIGN(read, storageNewReadNP(s3Download, strNew("file.txt")), "new read file");
+        TEST_ERROR(
+            storageGetNP(read), FileReadError, "unable to read '/file.txt' because it was changed after being opened");
+        TEST_RESULT_VOID(storageReadFree(read), "    free file");
+
+        TEST_RESULT_STR(
+            strPtr(strNewBuf(storageGetNP(storageNewReadNP(s3Download, strNew("file0.txt"))))), "", "get zero-length file");
     }
 
     FUNCTION_HARNESS_RESULT_VOID();